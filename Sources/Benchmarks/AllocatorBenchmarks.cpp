@@ -0,0 +1,100 @@
+#if defined(WITH_ALLOCATORS)
+
+#include "BenchmarkHarness.h"
+#include "../nCine/Base/AllocManager.h"
+#include "../nCine/Base/PoolAllocator.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#include <Containers/SmallVector.h>
+
+using namespace Death::Containers;
+using namespace nCine;
+
+// `RenderCommand` can't be constructed here, because its material requires the GL backend, so only the allocation
+// of blocks with the same size and alignment is measured, the same way as `RenderCommandPool` allocates them
+
+namespace
+{
+	// Number of render commands in a frame of a busy level
+	constexpr int32_t CommandCount = 512;
+	// Value of `sizeof(RenderCommand)` on x86-64 Linux with GCC 12
+	constexpr std::size_t CommandSize = 3416;
+	constexpr std::size_t CommandAlignment = alignof(std::max_align_t);
+
+	/// Allocates and releases all commands, as when a viewport or a level is recreated
+	template<class TAllocate, class TDeallocate>
+	void RunCommandChurn(Benchmarks::State& state, TAllocate&& allocate, TDeallocate&& deallocate)
+	{
+		SmallVector<void*, 0> commands;
+		commands.reserve(CommandCount);
+		state.ResetTimer();
+
+		for (int64_t i = 0; i < state.GetIterations(); i++) {
+			for (int32_t j = 0; j < CommandCount; j++) {
+				commands.push_back(allocate());
+			}
+			Benchmarks::DoNotOptimize(commands.back());
+			for (void* command : commands) {
+				deallocate(command);
+			}
+			commands.clear();
+		}
+		state.StopTimer();
+	}
+}
+
+/// Each command is allocated on the heap, as `RenderCommandPool` does without `WITH_ALLOCATORS`
+BENCHMARK(Allocator, CommandsHeap)
+{
+	RunCommandChurn(state, []() {
+		return ::operator new(CommandSize);
+	}, [](void* ptr) {
+		::operator delete(ptr);
+	});
+}
+
+/// Commands are allocated from `PoolAllocator` with pages from the tracked allocator of graphics, as `RenderCommandPool` does
+BENCHMARK(Allocator, CommandsPool)
+{
+	PoolAllocator allocator("RenderCommands", CommandSize, CommandAlignment, CommandCount, AllocManager::proxy(AllocTag::Graphics));
+	RunCommandChurn(state, [&allocator]() {
+		return allocator.allocate(CommandSize, CommandAlignment);
+	}, [&allocator](void* ptr) {
+		allocator.deallocate(ptr, CommandSize, CommandAlignment);
+	});
+}
+
+/// Blocks of the pool are aligned, they don't overlap and released blocks are reused without new pages
+SELF_TEST(Allocator, PoolBlocks)
+{
+	PoolAllocator allocator("RenderCommands", CommandSize, CommandAlignment, 64, AllocManager::proxy(AllocTag::Graphics));
+	SmallVector<std::uintptr_t, 0> blocks;
+	for (int32_t i = 0; i < CommandCount; i++) {
+		void* ptr = allocator.allocate(CommandSize, CommandAlignment);
+		if (ptr == nullptr || ((std::uintptr_t)ptr % CommandAlignment) != 0) {
+			return false;
+		}
+		blocks.push_back((std::uintptr_t)ptr);
+	}
+	std::sort(blocks.begin(), blocks.end());
+	for (std::size_t i = 1; i < blocks.size(); i++) {
+		if (blocks[i] - blocks[i - 1] < CommandSize) {
+			return false;
+		}
+	}
+
+	std::size_t pageCount = allocator.numPages();
+	for (std::uintptr_t block : blocks) {
+		allocator.deallocate((void*)block, CommandSize, CommandAlignment);
+	}
+	for (int32_t i = 0; i < CommandCount; i++) {
+		allocator.allocate(CommandSize, CommandAlignment);
+	}
+	return (allocator.usedBlocks() == (std::size_t)CommandCount && allocator.numPages() == pageCount);
+}
+
+#endif
@@ -0,0 +1,111 @@
+#include "BenchmarkHarness.h"
+#include "../Jazz2/ContentResolver.h"
+
+#include <cstdio>
+
+#include <Containers/SmallVector.h>
+
+using namespace Death::Containers;
+using namespace Jazz2;
+using namespace nCine;
+
+namespace
+{
+	// The same values as `ContentResolver` uses for its atlas pages
+	constexpr int32_t PageSize = 2048;
+	constexpr int32_t MaxSheetSize = 512;
+	constexpr int32_t Padding = 1;
+
+	struct AtlasRegion
+	{
+		int32_t Page;
+		Vector2i Offset;
+		Vector2i Size;
+	};
+
+	/// Sprite sheets of a level, mostly small ones with a few large ones
+	SmallVector<Vector2i, 0> CreateSheetSizes(Benchmarks::Random& random, int32_t count)
+	{
+		SmallVector<Vector2i, 0> sizes;
+		for (int32_t i = 0; i < count; i++) {
+			int32_t maxSize = (random.Next(10) == 0 ? MaxSheetSize : 128);
+			sizes.push_back(Vector2i(1 + (int32_t)random.Next(maxSize), 1 + (int32_t)random.Next(maxSize)));
+		}
+		return sizes;
+	}
+
+	/// Packs sheets the same way as `ContentResolver::AllocateAtlasRegion()`, a new page is added if no page has enough space
+	void PackSheets(const SmallVector<Vector2i, 0>& sizes, SmallVector<AtlasShelfPacker, 0>& pages, SmallVector<AtlasRegion, 0>& regions)
+	{
+		for (const Vector2i& size : sizes) {
+			AtlasRegion region { -1, Vector2i(), size };
+			for (int32_t i = 0; i < (int32_t)pages.size(); i++) {
+				if (pages[i].TryAllocate(size.X, size.Y, PageSize, Padding, region.Offset)) {
+					region.Page = i;
+					break;
+				}
+			}
+			if (region.Page < 0) {
+				region.Page = (int32_t)pages.size();
+				pages.emplace_back().TryAllocate(size.X, size.Y, PageSize, Padding, region.Offset);
+			}
+			regions.push_back(region);
+		}
+	}
+}
+
+/// Sprite sheets of a level are packed into atlas pages, as they are loaded by `ContentResolver`
+BENCHMARK(Atlas, PackSheets)
+{
+	Benchmarks::Random random;
+	SmallVector<Vector2i, 0> sizes = CreateSheetSizes(random, 450);
+	SmallVector<AtlasShelfPacker, 0> pages;
+	SmallVector<AtlasRegion, 0> regions;
+	state.ResetTimer();
+
+	for (int64_t i = 0; i < state.GetIterations(); i++) {
+		pages.clear();
+		regions.clear();
+		PackSheets(sizes, pages, regions);
+		Benchmarks::DoNotOptimize(regions.back());
+	}
+	state.StopTimer();
+}
+
+/// Every region must be inside of its page and padded regions on the same page must never overlap
+SELF_TEST(Atlas, RegionsDontOverlap)
+{
+	Benchmarks::Random random;
+	SmallVector<AtlasShelfPacker, 0> pages;
+	SmallVector<AtlasRegion, 0> regions;
+	for (int32_t run = 0; run < 200; run++) {
+		SmallVector<Vector2i, 0> sizes = CreateSheetSizes(random, 50 + (int32_t)random.Next(400));
+		pages.clear();
+		regions.clear();
+		PackSheets(sizes, pages, regions);
+
+		for (int32_t i = 0; i < (int32_t)regions.size(); i++) {
+			const AtlasRegion& a = regions[i];
+			if (a.Offset.X < Padding || a.Offset.Y < Padding ||
+				a.Offset.X + a.Size.X + Padding > PageSize || a.Offset.Y + a.Size.Y + Padding > PageSize) {
+				std::fprintf(stderr, "Atlas/RegionsDontOverlap: Region %ix%i at [%i, %i] is outside of the page\n", a.Size.X, a.Size.Y, a.Offset.X, a.Offset.Y);
+				return false;
+			}
+			for (int32_t j = i + 1; j < (int32_t)regions.size(); j++) {
+				const AtlasRegion& b = regions[j];
+				// Padding of both regions has to be transparent, so at least one pixel has to be between them
+				if (a.Page == b.Page &&
+					a.Offset.X < b.Offset.X + b.Size.X + Padding && b.Offset.X < a.Offset.X + a.Size.X + Padding &&
+					a.Offset.Y < b.Offset.Y + b.Size.Y + Padding && b.Offset.Y < a.Offset.Y + a.Size.Y + Padding) {
+					std::fprintf(stderr, "Atlas/RegionsDontOverlap: Regions at [%i, %i] and [%i, %i] overlap\n", a.Offset.X, a.Offset.Y, b.Offset.X, b.Offset.Y);
+					return false;
+				}
+			}
+		}
+	}
+
+	// Sheet larger than the page never fits
+	AtlasShelfPacker packer;
+	Vector2i offset;
+	return !packer.TryAllocate(PageSize, 1, PageSize, Padding, offset);
+}
@@ -0,0 +1,144 @@
+#include "BenchmarkHarness.h"
+#include "../nCine/Base/Atom.h"
+
+#if defined(WITH_THREADS)
+#	include "../nCine/Threading/Thread.h"
+#	include <atomic>
+#endif
+
+#include <cstdio>
+
+#include <Containers/SmallVector.h>
+#include <Containers/String.h>
+
+using namespace Death::Containers;
+using namespace Death::Containers::Literals;
+using namespace nCine;
+
+namespace
+{
+	// Number of graphics and sounds of all metadata loaded in a level, it's more than the initial capacity of the table
+	constexpr std::int32_t InternedCount = 5000;
+
+	// Different strings with the same FNV-1a hash 0xd42128b8
+	constexpr StringView CollidingFirst = "Anim68459"_s;
+	constexpr StringView CollidingSecond = "Anim444624"_s;
+
+	SmallVector<String, 0> CreateNames(const char* prefix, std::int32_t count)
+	{
+		SmallVector<String, 0> names;
+		char buffer[32];
+		for (std::int32_t i = 0; i < count; i++) {
+			std::int32_t length = std::snprintf(buffer, sizeof(buffer), "%s%i", prefix, (int)i);
+			names.push_back(String(StringView(buffer, (std::size_t)length)));
+		}
+		return names;
+	}
+
+	bool ExpectAtom(const char* what, StringView name, Atom expected)
+	{
+		Atom found = Atom::find(name);
+		if (found.empty() || found != expected || found.str() != name) {
+			std::fprintf(stderr, "Atom/InternAndFind: %s \"%.*s\" was found as 0x%08x \"%.*s\" instead of 0x%08x\n", what, (int)name.size(), name.data(),
+				found.hash(), (int)found.str().size(), found.str().data() != nullptr ? found.str().data() : "", expected.hash());
+			return false;
+		}
+		return true;
+	}
+
+#if defined(WITH_THREADS)
+	struct ConcurrentLookup
+	{
+		const SmallVector<String, 0>* Names;
+		const SmallVector<Atom, 0>* Atoms;
+		std::atomic<bool> Finished;
+		bool Failed;
+	};
+
+	/// Looks up already interned strings while the main thread interns new ones
+	void LookupWhileInterning(void* arg)
+	{
+		ConcurrentLookup* lookup = static_cast<ConcurrentLookup*>(arg);
+		while (!lookup->Finished.load(std::memory_order_acquire)) {
+			for (std::size_t i = 0; i < lookup->Names->size(); i++) {
+				if (Atom::find((*lookup->Names)[i]) != (*lookup->Atoms)[i]) {
+					lookup->Failed = true;
+					return;
+				}
+			}
+		}
+	}
+#endif
+}
+
+/// Run-time strings are converted to atoms, as name-based lookups of graphics and sounds do
+BENCHMARK(Atom, Find)
+{
+	SmallVector<String, 0> names = CreateNames("Graphics", 500);
+	for (const String& name : names) {
+		Atom::intern(name);
+	}
+	state.ResetTimer();
+
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		hash_t sum = 0;
+		for (const String& name : names) {
+			sum += Atom::find(name).hash();
+		}
+		Benchmarks::DoNotOptimize(sum);
+	}
+	state.StopTimer();
+}
+
+/// Interned strings are found by their string even after the table grows, colliding strings get different atoms
+SELF_TEST(Atom, InternAndFind)
+{
+	SmallVector<String, 0> names = CreateNames("Interned", InternedCount);
+	SmallVector<Atom, 0> atoms;
+	for (std::int32_t i = 0; i < InternedCount / 2; i++) {
+		atoms.push_back(Atom::intern(names[i]));
+	}
+
+#if defined(WITH_THREADS)
+	SmallVector<String, 0> readNames(names.begin(), names.begin() + atoms.size());
+	SmallVector<Atom, 0> readAtoms(atoms.begin(), atoms.end());
+	ConcurrentLookup lookup { &readNames, &readAtoms, false, false };
+	Thread thread(LookupWhileInterning, &lookup);
+#endif
+
+	// The second half grows the table, while the other thread reads it
+	for (std::int32_t i = InternedCount / 2; i < InternedCount; i++) {
+		atoms.push_back(Atom::intern(names[i]));
+	}
+
+#if defined(WITH_THREADS)
+	lookup.Finished.store(true, std::memory_order_release);
+	thread.Join();
+	if (lookup.Failed) {
+		std::fprintf(stderr, "Atom/InternAndFind: Lookup failed while other strings were interned\n");
+		return false;
+	}
+#endif
+
+	for (std::int32_t i = 0; i < InternedCount; i++) {
+		if (atoms[i] != Atom(names[i]) || Atom::intern(names[i]) != atoms[i] || !ExpectAtom("String", names[i], atoms[i])) {
+			return false;
+		}
+	}
+
+	if (!Atom::find("NeverInterned"_s).empty() || !Atom::find(""_s).empty()) {
+		std::fprintf(stderr, "Atom/InternAndFind: String that was never interned was found\n");
+		return false;
+	}
+
+	// The first string keeps its hash, the second one is still usable, but it gets another hash
+	Atom first = Atom::intern(CollidingFirst);
+	Atom second = Atom::intern(CollidingSecond);
+	if (Atom(CollidingFirst) != Atom(CollidingSecond) || first != Atom(CollidingFirst) || second.empty() || second == first) {
+		std::fprintf(stderr, "Atom/InternAndFind: Colliding strings were interned as 0x%08x and 0x%08x\n", first.hash(), second.hash());
+		return false;
+	}
+	return ExpectAtom("First colliding string", CollidingFirst, first) &&
+		ExpectAtom("Second colliding string", CollidingSecond, second) &&
+		Atom::intern(CollidingSecond) == second;
+}
@@ -0,0 +1,406 @@
+#include "BenchmarkHarness.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include <Containers/SmallVector.h>
+
+using namespace Death::Containers;
+
+namespace
+{
+	std::atomic<std::uint64_t> _allocationCount{0};
+	std::atomic<std::uint64_t> _allocatedBytes{0};
+
+	DEATH_ALWAYS_INLINE void TrackAllocation(std::size_t size)
+	{
+		_allocationCount.fetch_add(1, std::memory_order_relaxed);
+		_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+	}
+}
+
+// Replacing `malloc()` is possible only with glibc, which exports the original implementation, sanitizers replace it on their own
+#if defined(__GLIBC__) && !defined(__SANITIZE_ADDRESS__) && !defined(__SANITIZE_THREAD__)
+#	if defined(__has_feature)
+#		if !__has_feature(address_sanitizer) && !__has_feature(thread_sanitizer) && !__has_feature(memory_sanitizer)
+#			define BENCHMARK_TRACK_MALLOC
+#		endif
+#	else
+#		define BENCHMARK_TRACK_MALLOC
+#	endif
+#endif
+
+#if defined(BENCHMARK_TRACK_MALLOC)
+extern "C"
+{
+	void* __libc_malloc(std::size_t size);
+	void* __libc_calloc(std::size_t count, std::size_t size);
+	void* __libc_realloc(void* ptr, std::size_t size);
+	void __libc_free(void* ptr);
+
+	void* malloc(std::size_t size) noexcept
+	{
+		TrackAllocation(size);
+		return __libc_malloc(size);
+	}
+
+	void* calloc(std::size_t count, std::size_t size) noexcept
+	{
+		TrackAllocation(count * size);
+		return __libc_calloc(count, size);
+	}
+
+	void* realloc(void* ptr, std::size_t size) noexcept
+	{
+		if (size > 0) {
+			TrackAllocation(size);
+		}
+		return __libc_realloc(ptr, size);
+	}
+
+	void free(void* ptr) noexcept
+	{
+		__libc_free(ptr);
+	}
+}
+#endif
+
+namespace
+{
+	DEATH_ALWAYS_INLINE void* AllocateTracked(std::size_t size)
+	{
+#if !defined(BENCHMARK_TRACK_MALLOC)
+		TrackAllocation(size);
+#endif
+		void* ptr = std::malloc(size != 0 ? size : 1);
+		if (ptr == nullptr) {
+			// Benchmarks are not expected to recover from out-of-memory condition
+			std::fputs("Out of memory\n", stderr);
+			std::abort();
+		}
+		return ptr;
+	}
+}
+
+void* operator new(std::size_t size)
+{
+	return AllocateTracked(size);
+}
+
+void* operator new[](std::size_t size)
+{
+	return AllocateTracked(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	return AllocateTracked(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+	return AllocateTracked(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+	std::free(ptr);
+}
+
+namespace Benchmarks
+{
+	namespace
+	{
+		struct Entry
+		{
+			const char* Group;
+			const char* Name;
+			BenchmarkFunction Function;
+			SelfTestFunction SelfTest;
+		};
+
+		struct Registry
+		{
+			static constexpr std::int32_t Capacity = 256;
+
+			Entry Entries[Capacity];
+			std::int32_t Count;
+			bool IsSorted;
+		};
+
+		// Registrations are static objects in multiple translation units, so the registry must be initialized on first use
+		Registry& GetRegistry()
+		{
+			static Registry registry { };
+			return registry;
+		}
+
+		Registry& GetSelfTestRegistry()
+		{
+			static Registry registry { };
+			return registry;
+		}
+
+		void SortRegistry(Registry& registry)
+		{
+			// Registration order depends on the linker, so benchmarks are sorted to produce comparable outputs
+			if (!registry.IsSorted) {
+				std::sort(registry.Entries, registry.Entries + registry.Count, [](const Entry& a, const Entry& b) {
+					std::int32_t result = std::strcmp(a.Group, b.Group);
+					return (result != 0 ? result < 0 : std::strcmp(a.Name, b.Name) < 0);
+				});
+				registry.IsSorted = true;
+			}
+		}
+
+		bool MatchesFilter(const Entry& entry, const char* filter)
+		{
+			if (filter == nullptr || filter[0] == '\0') {
+				return true;
+			}
+
+			char fullName[256];
+			std::snprintf(fullName, sizeof(fullName), "%s/%s", entry.Group, entry.Name);
+			return (std::strstr(fullName, filter) != nullptr);
+		}
+
+		std::int64_t GetTimestampNs()
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+		constexpr std::int64_t MaxIterations = 1000000000000LL;
+	}
+
+	namespace Implementation
+	{
+		void UseCharPointer(const volatile char* ptr)
+		{
+			(void)ptr;
+		}
+	}
+
+	AllocationCounters GetAllocationCounters()
+	{
+		return { _allocationCount.load(std::memory_order_relaxed), _allocatedBytes.load(std::memory_order_relaxed) };
+	}
+
+	bool IsMallocTracked()
+	{
+#if defined(BENCHMARK_TRACK_MALLOC)
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	State::State(std::int64_t iterations)
+		: _iterations(iterations), _bytesPerIteration(0), _startTime(0), _elapsedNs(0), _startAllocations { }, _allocations { }, _isRunning(false)
+	{
+	}
+
+	void State::ResetTimer()
+	{
+		_elapsedNs = 0;
+		_allocations = { };
+		_startAllocations = GetAllocationCounters();
+		_isRunning = true;
+		// Timestamp is taken as the last thing, so the overhead of the method is not measured
+		_startTime = GetTimestampNs();
+	}
+
+	void State::StopTimer()
+	{
+		if (_isRunning) {
+			// Timestamp is taken as the first thing, so the overhead of the method is not measured
+			_elapsedNs = GetTimestampNs() - _startTime;
+			AllocationCounters current = GetAllocationCounters();
+			_allocations.Count = current.Count - _startAllocations.Count;
+			_allocations.Bytes = current.Bytes - _startAllocations.Bytes;
+			_isRunning = false;
+		}
+	}
+
+	void State::Finish()
+	{
+		StopTimer();
+		if (_elapsedNs <= 0) {
+			_elapsedNs = 1;
+		}
+	}
+
+	Registration::Registration(const char* group, const char* name, BenchmarkFunction function)
+	{
+		Registry& registry = GetRegistry();
+		if (registry.Count >= Registry::Capacity) {
+			std::fprintf(stderr, "Too many benchmarks registered, \"%s/%s\" is skipped\n", group, name);
+			return;
+		}
+
+		registry.Entries[registry.Count++] = { group, name, function, nullptr };
+		registry.IsSorted = false;
+	}
+
+	SelfTestRegistration::SelfTestRegistration(const char* group, const char* name, SelfTestFunction function)
+	{
+		Registry& registry = GetSelfTestRegistry();
+		if (registry.Count >= Registry::Capacity) {
+			std::fprintf(stderr, "Too many self-tests registered, \"%s/%s\" is skipped\n", group, name);
+			return;
+		}
+
+		registry.Entries[registry.Count++] = { group, name, nullptr, function };
+		registry.IsSorted = false;
+	}
+
+	void Runner::ForEach(const char* filter, void(*callback)(const char* group, const char* name))
+	{
+		Registry& registry = GetRegistry();
+		SortRegistry(registry);
+
+		for (std::int32_t i = 0; i < registry.Count; i++) {
+			if (MatchesFilter(registry.Entries[i], filter)) {
+				callback(registry.Entries[i].Group, registry.Entries[i].Name);
+			}
+		}
+	}
+
+	std::int32_t Runner::Run(const RunnerOptions& options, Result* results, std::int32_t capacity, void(*callback)(const Result& result))
+	{
+		Registry& registry = GetRegistry();
+		SortRegistry(registry);
+
+		const std::int64_t warmupNs = (std::int64_t)options.WarmupMs * 1000000;
+		const std::int64_t minTimeNs = std::max((std::int64_t)options.MinTimeMs * 1000000, (std::int64_t)1);
+		const std::int32_t repetitions = std::max(options.Repetitions, 1);
+
+		std::int32_t resultCount = 0;
+		SmallVector<double, 16> samples;
+
+		for (std::int32_t i = 0; i < registry.Count && resultCount < capacity; i++) {
+			const Entry& entry = registry.Entries[i];
+			if (!MatchesFilter(entry, options.Filter)) {
+				continue;
+			}
+
+			Result& result = results[resultCount++];
+			result = { };
+			result.Group = entry.Group;
+			result.Name = entry.Name;
+
+			// Number of iterations grows until the warmup time is reached, the last run is used to estimate the duration of one iteration
+			std::int64_t iterations = 1;
+			double estimatedNsPerOp;
+			while (true) {
+				State state(iterations);
+				RunOnce(entry.Function, iterations, state);
+				result.WarmupIterations += iterations;
+				result.WarmupNs += state._elapsedNs;
+				estimatedNsPerOp = (double)state._elapsedNs / (double)iterations;
+
+				if (result.WarmupNs >= warmupNs || iterations >= MaxIterations) {
+					break;
+				}
+				iterations = std::min(iterations * (state._elapsedNs < 100000 ? 10 : 2), MaxIterations);
+			}
+
+			result.Iterations = std::clamp((std::int64_t)((double)minTimeNs / estimatedNsPerOp), (std::int64_t)1, MaxIterations);
+			result.Repetitions = repetitions;
+
+			samples.clear();
+			std::uint64_t totalAllocations = 0;
+			std::uint64_t totalAllocatedBytes = 0;
+			std::int64_t totalElapsedNs = 0;
+			std::int64_t bytesPerIteration = 0;
+			for (std::int32_t j = 0; j < repetitions; j++) {
+				State state(result.Iterations);
+				RunOnce(entry.Function, result.Iterations, state);
+				samples.push_back((double)state._elapsedNs / (double)result.Iterations);
+				totalAllocations += state._allocations.Count;
+				totalAllocatedBytes += state._allocations.Bytes;
+				totalElapsedNs += state._elapsedNs;
+				bytesPerIteration = state._bytesPerIteration;
+			}
+
+			std::sort(samples.begin(), samples.end());
+			const std::size_t middle = samples.size() / 2;
+			result.NsPerOp = (samples.size() % 2 != 0 ? samples[middle] : (samples[middle - 1] + samples[middle]) * 0.5);
+			result.MinNsPerOp = samples.front();
+			result.MaxNsPerOp = samples.back();
+
+			const double totalIterations = (double)result.Iterations * repetitions;
+			result.AllocationsPerOp = (double)totalAllocations / totalIterations;
+			result.AllocatedBytesPerOp = (double)totalAllocatedBytes / totalIterations;
+			if (bytesPerIteration > 0) {
+				result.MegabytesPerSecond = ((double)bytesPerIteration * totalIterations / (1024.0 * 1024.0)) / ((double)totalElapsedNs / 1000000000.0);
+			}
+
+			if (callback != nullptr) {
+				callback(result);
+			}
+		}
+
+		return resultCount;
+	}
+
+	std::int32_t Runner::RunSelfTests(const char* filter, void(*callback)(const char* group, const char* name, bool passed))
+	{
+		Registry& registry = GetSelfTestRegistry();
+		SortRegistry(registry);
+
+		std::int32_t failedCount = 0;
+		for (std::int32_t i = 0; i < registry.Count; i++) {
+			const Entry& entry = registry.Entries[i];
+			if (!MatchesFilter(entry, filter)) {
+				continue;
+			}
+
+			const bool passed = entry.SelfTest();
+			if (!passed) {
+				failedCount++;
+			}
+			if (callback != nullptr) {
+				callback(entry.Group, entry.Name, passed);
+			}
+		}
+		return failedCount;
+	}
+
+	void Runner::RunOnce(BenchmarkFunction function, std::int64_t iterations, State& state)
+	{
+		state._iterations = iterations;
+		state.ResetTimer();
+		function(state);
+		state.Finish();
+	}
+}
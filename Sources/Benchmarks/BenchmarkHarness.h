@@ -0,0 +1,191 @@
+#pragma once
+
+#include <CommonBase.h>
+
+#include <cstdint>
+
+#if defined(DEATH_TARGET_MSVC) && !defined(DEATH_TARGET_CLANG_CL)
+#	include <intrin.h>
+#endif
+
+namespace Benchmarks
+{
+	class State;
+
+	/// Benchmark function, it must run the measured operation `State::GetIterations()` times
+	using BenchmarkFunction = void(*)(State& state);
+	/// Self-test function, it returns `false` if the tested code doesn't produce the expected results
+	using SelfTestFunction = bool(*)();
+
+	/// Counters of heap allocations made by the current process
+	struct AllocationCounters
+	{
+		std::uint64_t Count;
+		std::uint64_t Bytes;
+	};
+
+	/// Returns counters of all heap allocations since the start of the process
+	AllocationCounters GetAllocationCounters();
+	/// Returns `true` if `malloc()` is tracked too, otherwise only `operator new` is tracked
+	bool IsMallocTracked();
+
+	/// State of a single benchmark run, it controls the measured region
+	class State
+	{
+		friend class Runner;
+
+	public:
+		explicit State(std::int64_t iterations);
+
+		/// Returns number of iterations that should be run
+		std::int64_t GetIterations() const {
+			return _iterations;
+		}
+
+		/// Restarts the timer and allocation counters, it's used to exclude setup from the measurement
+		void ResetTimer();
+		/// Stops the timer and allocation counters, it's used to exclude teardown from the measurement
+		void StopTimer();
+
+		/// Sets number of bytes processed by a single iteration to report throughput
+		void SetBytesPerIteration(std::int64_t bytes) {
+			_bytesPerIteration = bytes;
+		}
+
+	private:
+		std::int64_t _iterations;
+		std::int64_t _bytesPerIteration;
+		std::int64_t _startTime;
+		std::int64_t _elapsedNs;
+		AllocationCounters _startAllocations;
+		AllocationCounters _allocations;
+		bool _isRunning;
+
+		void Finish();
+	};
+
+	/// Registers a benchmark function in the global list, it's used by `BENCHMARK()` macro
+	class Registration
+	{
+	public:
+		Registration(const char* group, const char* name, BenchmarkFunction function);
+	};
+
+	/// Registers a self-test function in the global list, it's used by `SELF_TEST()` macro
+	class SelfTestRegistration
+	{
+	public:
+		SelfTestRegistration(const char* group, const char* name, SelfTestFunction function);
+	};
+
+	namespace Implementation
+	{
+		void UseCharPointer(const volatile char* ptr);
+	}
+
+	/// Prevents the compiler from optimizing out computation of the specified value
+	template<class T>
+	DEATH_ALWAYS_INLINE void DoNotOptimize(const T& value)
+	{
+#if defined(DEATH_TARGET_MSVC) && !defined(DEATH_TARGET_CLANG_CL)
+		Implementation::UseCharPointer(&reinterpret_cast<const volatile char&>(value));
+		_ReadWriteBarrier();
+#else
+		asm volatile("" : : "r,m"(value) : "memory");
+#endif
+	}
+
+	/// Forces all pending writes to memory to be performed
+	DEATH_ALWAYS_INLINE void ClobberMemory()
+	{
+#if defined(DEATH_TARGET_MSVC) && !defined(DEATH_TARGET_CLANG_CL)
+		_ReadWriteBarrier();
+#else
+		asm volatile("" : : : "memory");
+#endif
+	}
+
+	/// Deterministic pseudo-random generator, so all runs process the same data
+	class Random
+	{
+	public:
+		explicit Random(std::uint32_t seed = 0x9E3779B9u)
+			: _state(seed != 0 ? seed : 1) {}
+
+		std::uint32_t Next() {
+			_state ^= _state << 13;
+			_state ^= _state >> 17;
+			_state ^= _state << 5;
+			return _state;
+		}
+
+		/// Returns a value in range [0, max)
+		std::uint32_t Next(std::uint32_t max) {
+			return (std::uint32_t)(((std::uint64_t)Next() * max) >> 32);
+		}
+
+	private:
+		std::uint32_t _state;
+	};
+
+	/// Result of a benchmark
+	struct Result
+	{
+		const char* Group;
+		const char* Name;
+		/// Number of iterations run before the measurement
+		std::int64_t WarmupIterations;
+		/// Total time of the warmup in nanoseconds
+		std::int64_t WarmupNs;
+		/// Number of iterations of each repetition
+		std::int64_t Iterations;
+		std::int32_t Repetitions;
+		/// Median of all repetitions
+		double NsPerOp;
+		double MinNsPerOp;
+		double MaxNsPerOp;
+		double AllocationsPerOp;
+		double AllocatedBytesPerOp;
+		/// Throughput in MB/s, or zero if the benchmark doesn't report processed bytes
+		double MegabytesPerSecond;
+	};
+
+	/// Options of the benchmark runner
+	struct RunnerOptions
+	{
+		/// Only benchmarks with `Group/Name` containing this string are run, or all if empty
+		const char* Filter;
+		/// Minimal duration of the warmup in milliseconds
+		std::int32_t WarmupMs;
+		/// Target duration of each repetition in milliseconds
+		std::int32_t MinTimeMs;
+		std::int32_t Repetitions;
+	};
+
+	/// Runs registered benchmarks
+	class Runner
+	{
+	public:
+		/// Calls the callback for each registered benchmark matching the filter
+		static void ForEach(const char* filter, void(*callback)(const char* group, const char* name));
+		/// Runs all registered benchmarks matching the filter, returns number of written results
+		static std::int32_t Run(const RunnerOptions& options, Result* results, std::int32_t capacity, void(*callback)(const Result& result));
+		/// Runs all registered self-tests matching the filter, returns number of failed ones
+		static std::int32_t RunSelfTests(const char* filter, void(*callback)(const char* group, const char* name, bool passed));
+
+	private:
+		static void RunOnce(BenchmarkFunction function, std::int64_t iterations, State& state);
+	};
+}
+
+/// Defines and registers a benchmark, the function body has access to `state` variable
+#define BENCHMARK(group, name)																	\
+	static void group##_##name##_Benchmark(Benchmarks::State& state);								\
+	static Benchmarks::Registration group##_##name##_Registration(#group, #name, group##_##name##_Benchmark);	\
+	static void group##_##name##_Benchmark(Benchmarks::State& state)
+
+/// Defines and registers a self-test, the function body returns `false` on failure
+#define SELF_TEST(group, name)																	\
+	static bool group##_##name##_SelfTest();														\
+	static Benchmarks::SelfTestRegistration group##_##name##_SelfTestRegistration(#group, #name, group##_##name##_SelfTest);	\
+	static bool group##_##name##_SelfTest()
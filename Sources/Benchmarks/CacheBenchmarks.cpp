@@ -0,0 +1,192 @@
+#include "BenchmarkHarness.h"
+#include "../Jazz2/Compatibility/CacheManifest.h"
+#include "../nCine/IO/FileSystem.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+#include <Containers/SmallVector.h>
+#include <Containers/String.h>
+
+using namespace Death::Containers;
+using namespace Death::Containers::Literals;
+using namespace Jazz2::Compatibility;
+using namespace nCine;
+
+namespace
+{
+	// Number of entries of a cache with the original game, a few episodes and their levels and tilesets
+	constexpr std::int32_t ManifestEntryCount = 400;
+
+	String GetTempCachePath()
+	{
+		const char* tempDir = std::getenv("TMPDIR");
+		if (tempDir == nullptr || tempDir[0] == '\0') {
+			tempDir = std::getenv("TEMP");
+		}
+		if (tempDir == nullptr || tempDir[0] == '\0') {
+			tempDir = ".";
+		}
+		return fs::JoinPath(tempDir, "jazz2-benchmark-cache"_s);
+	}
+
+	/// Temporary cache directory that is deleted when the test ends
+	class TempCache
+	{
+	public:
+		TempCache()
+			: _path(GetTempCachePath())
+		{
+			fs::RemoveDirectoryRecursive(_path);
+			fs::CreateDirectories(fs::JoinPath(_path, "Levels"_s));
+		}
+
+		~TempCache()
+		{
+			fs::RemoveDirectoryRecursive(_path);
+		}
+
+		const String& GetPath() const {
+			return _path;
+		}
+
+		String GetFilePath(const StringView& name) const {
+			return fs::JoinPath(_path, name);
+		}
+
+	private:
+		String _path;
+	};
+
+	void CreateEmptyFile(const StringView& path)
+	{
+		fs::Open(path, FileAccessMode::Write)->Close();
+	}
+
+	void FillManifest(CacheManifest& manifest, const TempCache& cache, std::int32_t count)
+	{
+		char key[64], fileName[64];
+		for (std::int32_t i = 0; i < count; i++) {
+			std::snprintf(key, sizeof(key), "Levels:level%i", (int)i);
+			std::snprintf(fileName, sizeof(fileName), "level%i.j2l", (int)i);
+			manifest.NeedsConversion(key, (std::uint64_t)i * 0x9E3779B97F4A7C15ULL, 1);
+			manifest.AddOutput(key, fs::JoinPath({ cache.GetPath(), "Levels"_s, fileName }));
+			manifest.AddDependency(key, "castle1"_s);
+		}
+	}
+
+	SmallVector<std::uint8_t, 0> ReadFile(const StringView& path)
+	{
+		auto s = fs::Open(path, FileAccessMode::Read);
+		SmallVector<std::uint8_t, 0> data(s->GetSize());
+		s->Read(data.data(), (std::uint32_t)data.size());
+		return data;
+	}
+
+	void WriteFile(const StringView& path, const std::uint8_t* data, std::int32_t size)
+	{
+		auto s = fs::Open(path, FileAccessMode::Write);
+		s->Write(data, size);
+	}
+}
+
+/// Whole cache manifest is loaded, as `RefreshCache()` does on every start
+BENCHMARK(Cache, ManifestLoad)
+{
+	TempCache cache;
+	String indexPath = cache.GetFilePath("cache.index"_s);
+	{
+		CacheManifest manifest(cache.GetPath());
+		FillManifest(manifest, cache, ManifestEntryCount);
+		manifest.Save(indexPath);
+	}
+	state.ResetTimer();
+
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		CacheManifest manifest(cache.GetPath());
+		bool loaded = manifest.Load(indexPath);
+		Benchmarks::DoNotOptimize(loaded);
+	}
+	state.StopTimer();
+}
+
+/// Saved manifest is loaded with the same entries, and a forced refresh converts unchanged entries again
+SELF_TEST(Cache, ManifestRoundTrip)
+{
+	TempCache cache;
+	String indexPath = cache.GetFilePath("cache.index"_s);
+	{
+		CacheManifest manifest(cache.GetPath());
+		FillManifest(manifest, cache, 3);
+		if (!manifest.Save(indexPath) || fs::IsReadableFile(indexPath + ".tmp"_s)) {
+			return false;
+		}
+	}
+
+	CacheManifest manifest(cache.GetPath());
+	if (!manifest.Load(indexPath) || manifest.GetOutputs("Levels:level1"_s).size() != 1 ||
+		manifest.GetOutputs("Levels:level1"_s)[0] != fs::JoinPath({ cache.GetPath(), "Levels"_s, "level1.j2l"_s }) ||
+		manifest.GetDependencies("Levels:level1"_s).size() != 1 || manifest.GetDependencies("Levels:level1"_s)[0] != "castle1"_s) {
+		return false;
+	}
+
+	// Outputs don't exist, so they have to be created first to make the entry up-to-date
+	CreateEmptyFile(manifest.GetOutputs("Levels:level1"_s)[0]);
+	if (manifest.NeedsConversion("Levels:level1"_s, 0x9E3779B97F4A7C15ULL, 1)) {
+		return false;
+	}
+	manifest.InvalidateAll("Levels:"_s);
+	return manifest.NeedsConversion("Levels:level1"_s, 0x9E3779B97F4A7C15ULL, 1);
+}
+
+/// Every truncated or bit-flipped manifest must be rejected or loaded without reading outside of the file
+SELF_TEST(Cache, ManifestCorrupted)
+{
+	TempCache cache;
+	String indexPath = cache.GetFilePath("cache.index"_s);
+	String corruptedPath = cache.GetFilePath("corrupted.index"_s);
+	String outsidePath = fs::JoinPath(fs::GetDirectoryName(cache.GetPath()), "jazz2-benchmark-outside.tmp"_s);
+	CreateEmptyFile(outsidePath);
+	{
+		CacheManifest manifest(cache.GetPath());
+		FillManifest(manifest, cache, 2);
+		// Entries that point outside of the cache directory, their files must never be removed
+		manifest.NeedsConversion("Levels:outside"_s, 1, 1);
+		manifest.AddOutput("Levels:outside"_s, outsidePath);
+		manifest.NeedsConversion("Levels:relative"_s, 2, 1);
+		manifest.AddOutput("Levels:relative"_s, fs::JoinPath({ cache.GetPath(), ".."_s, "jazz2-benchmark-outside.tmp"_s }));
+		manifest.Save(indexPath);
+	}
+
+	SmallVector<std::uint8_t, 0> data = ReadFile(indexPath);
+	bool success = true;
+	for (std::int32_t size = 0; size < (std::int32_t)data.size(); size++) {
+		WriteFile(corruptedPath, data.data(), size);
+		CacheManifest manifest(cache.GetPath());
+		if (manifest.Load(corruptedPath)) {
+			std::fprintf(stderr, "Cache/ManifestCorrupted: Manifest truncated to %i bytes was loaded\n", (int)size);
+			success = false;
+		}
+	}
+	for (std::int32_t i = 0; i < (std::int32_t)data.size(); i++) {
+		for (std::int32_t bit = 0; bit < 8; bit++) {
+			data[i] ^= (std::uint8_t)(1 << bit);
+			WriteFile(corruptedPath, data.data(), (std::int32_t)data.size());
+			data[i] ^= (std::uint8_t)(1 << bit);
+
+			// Lengths are checked against the remaining bytes, it's detected by sanitizers otherwise
+			CacheManifest manifest(cache.GetPath());
+			manifest.Load(corruptedPath);
+		}
+	}
+
+	CacheManifest manifest(cache.GetPath());
+	manifest.Load(indexPath);
+	manifest.RemoveUnvisited("Levels:"_s);
+	if (!fs::IsReadableFile(outsidePath)) {
+		std::fprintf(stderr, "Cache/ManifestCorrupted: File outside of the cache directory was removed\n");
+		success = false;
+	}
+	fs::RemoveFile(outsidePath);
+	return success;
+}
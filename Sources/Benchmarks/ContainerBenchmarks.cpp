@@ -0,0 +1,214 @@
+#include "BenchmarkHarness.h"
+#include "../nCine/Base/BitArray.h"
+
+#include <cstring>
+
+#include <Containers/SmallVector.h>
+#include <Containers/String.h>
+#include <Containers/StringView.h>
+
+using namespace Death::Containers;
+using namespace Death::Containers::Literals;
+using namespace nCine;
+
+namespace
+{
+	String CreateText(std::size_t size, char needle)
+	{
+		// Lowercase text without the searched character, it's placed only at the end
+		String text{NoInit, size};
+		Benchmarks::Random random;
+		for (std::size_t i = 0; i < size; i++) {
+			char c = (char)('a' + random.Next(26));
+			text[i] = (c != needle ? c : 'a');
+		}
+		text[size - 1] = needle;
+		return text;
+	}
+}
+
+BENCHMARK(SmallVector, PushBackInline)
+{
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		SmallVector<std::int32_t, 16> vector;
+		for (std::int32_t j = 0; j < 16; j++) {
+			vector.push_back(j);
+		}
+		Benchmarks::DoNotOptimize(vector.data());
+	}
+}
+
+BENCHMARK(SmallVector, PushBackGrow)
+{
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		SmallVector<std::int32_t, 0> vector;
+		for (std::int32_t j = 0; j < 1024; j++) {
+			vector.push_back(j);
+		}
+		Benchmarks::DoNotOptimize(vector.data());
+	}
+}
+
+BENCHMARK(SmallVector, PushBackReserved)
+{
+	SmallVector<std::int32_t, 0> vector;
+	vector.reserve(1024);
+	state.ResetTimer();
+
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		vector.clear();
+		for (std::int32_t j = 0; j < 1024; j++) {
+			vector.push_back(j);
+		}
+		Benchmarks::DoNotOptimize(vector.data());
+	}
+}
+
+BENCHMARK(SmallVector, Iterate)
+{
+	SmallVector<std::int32_t, 0> vector;
+	for (std::int32_t j = 0; j < 4096; j++) {
+		vector.push_back(j);
+	}
+	state.SetBytesPerIteration((std::int64_t)(vector.size() * sizeof(std::int32_t)));
+	state.ResetTimer();
+
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		std::int32_t sum = 0;
+		for (std::int32_t value : vector) {
+			sum += value;
+		}
+		Benchmarks::DoNotOptimize(sum);
+	}
+}
+
+BENCHMARK(String, ConstructSmall)
+{
+	// Fits into the small string optimization buffer
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		String string = "Jazz2/Content"_s;
+		Benchmarks::DoNotOptimize(string.data());
+	}
+}
+
+BENCHMARK(String, ConstructLarge)
+{
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		String string = "Jazz2/Content/Animations/Jazz/Idle.aura"_s;
+		Benchmarks::DoNotOptimize(string.data());
+	}
+}
+
+BENCHMARK(String, Concatenate)
+{
+	StringView directory = "Content/Animations"_s;
+	StringView file = "Jazz/Idle.aura"_s;
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		String path = directory + "/"_s + file;
+		Benchmarks::DoNotOptimize(path.data());
+	}
+}
+
+BENCHMARK(String, Compare)
+{
+	String a = "Content/Animations/Jazz/Idle.aura"_s;
+	String b = "Content/Animations/Jazz/Idle.aurb"_s;
+	state.ResetTimer();
+
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		Benchmarks::DoNotOptimize(a);
+		bool equal = (a == b);
+		Benchmarks::DoNotOptimize(equal);
+	}
+}
+
+BENCHMARK(StringView, FindCharacterShort)
+{
+	String text = CreateText(24, '/');
+	StringView view = text;
+	state.ResetTimer();
+
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		Benchmarks::DoNotOptimize(view);
+		StringView found = view.find('/');
+		Benchmarks::DoNotOptimize(found);
+	}
+}
+
+BENCHMARK(StringView, FindCharacterLong)
+{
+	String text = CreateText(4096, '/');
+	StringView view = text;
+	state.SetBytesPerIteration((std::int64_t)view.size());
+	state.ResetTimer();
+
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		Benchmarks::DoNotOptimize(view);
+		StringView found = view.find('/');
+		Benchmarks::DoNotOptimize(found);
+	}
+}
+
+BENCHMARK(StringView, FindSubstringLong)
+{
+	String text = CreateText(4096, '/');
+	StringView view = text;
+	state.SetBytesPerIteration((std::int64_t)view.size());
+	state.ResetTimer();
+
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		Benchmarks::DoNotOptimize(view);
+		StringView found = view.find("z/"_s);
+		Benchmarks::DoNotOptimize(found);
+	}
+}
+
+BENCHMARK(BitArray, SetRandom)
+{
+	constexpr std::uint32_t Size = 4096;
+	BitArray bits(Size);
+	Benchmarks::Random random;
+	state.ResetTimer();
+
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		bits.Set(random.Next(Size));
+	}
+	Benchmarks::DoNotOptimize(bits);
+}
+
+BENCHMARK(BitArray, TestAll)
+{
+	constexpr std::uint32_t Size = 4096;
+	BitArray bits(Size);
+	Benchmarks::Random random;
+	for (std::uint32_t j = 0; j < Size / 4; j++) {
+		bits.Set(random.Next(Size));
+	}
+	state.ResetTimer();
+
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		std::uint32_t count = 0;
+		for (std::uint32_t j = 0; j < Size; j++) {
+			count += (bits[j] ? 1 : 0);
+		}
+		Benchmarks::DoNotOptimize(count);
+	}
+}
+
+BENCHMARK(BitArray, BitwiseOr)
+{
+	constexpr std::uint32_t Size = 4096;
+	BitArray a(Size);
+	BitArray b(Size);
+	Benchmarks::Random random;
+	for (std::uint32_t j = 0; j < Size / 4; j++) {
+		a.Set(random.Next(Size));
+		b.Set(random.Next(Size));
+	}
+	state.ResetTimer();
+
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		a |= b;
+		Benchmarks::DoNotOptimize(a);
+	}
+}
@@ -0,0 +1,259 @@
+#include "BenchmarkHarness.h"
+#include "../Jazz2/Compatibility/JJ2Anims.h"
+#include "../nCine/Base/HashFunctions.h"
+#include "../nCine/IO/CompressionUtils.h"
+#include "../nCine/IO/FileSystem.h"
+#include "../nCine/IO/GrowableMemoryFile.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+#include <Containers/SmallVector.h>
+#include <Containers/String.h>
+
+using namespace Death::Containers;
+using namespace Death::Containers::Literals;
+using namespace Jazz2::Compatibility;
+using namespace nCine;
+
+namespace
+{
+	// Number of sets of the original game, so the version is detected as v1.20/1.23 and the sets are mapped
+	constexpr std::int32_t SetCount = 109;
+	// Size of the header with addresses of all sets
+	constexpr std::int32_t HeaderSize = 28 + 4 * SetCount;
+	// Number of threads of the parallel conversion, it's fixed, so the work is split even on machines with fewer processors
+	constexpr std::int32_t ParallelThreadCount = 8;
+
+	String GetTempPath(const StringView& name)
+	{
+		const char* tempDir = std::getenv("TMPDIR");
+		if (tempDir == nullptr || tempDir[0] == '\0') {
+			tempDir = std::getenv("TEMP");
+		}
+		if (tempDir == nullptr || tempDir[0] == '\0') {
+			tempDir = ".";
+		}
+		return fs::JoinPath(tempDir, name);
+	}
+
+	/// Compresses the block the same way as the original files, a zlib header followed by a raw deflate stream
+	void WriteBlock(GrowableMemoryFile& blocks, GrowableMemoryFile& block, std::int32_t& compressedSize, std::int32_t& uncompressedSize)
+	{
+		uncompressedSize = block.GetSize();
+		SmallVector<std::uint8_t, 0> compressed(2 + CompressionUtils::GetMaxDeflatedSize(uncompressedSize));
+		compressed[0] = 0x78;
+		compressed[1] = 0xDA;
+		compressedSize = 2 + CompressionUtils::Deflate(block.GetBuffer(), uncompressedSize, compressed.data() + 2, (std::int32_t)compressed.size() - 2);
+		blocks.Write(compressed.data(), compressedSize);
+	}
+
+	/// Creates `Anims.j2a` with random animations and samples in all sets, only the structure matches the original file
+	bool CreateAnimsFile(const StringView& path, std::uint32_t seed)
+	{
+		Benchmarks::Random random(seed);
+		auto nextInRange = [&random](std::int32_t min, std::int32_t max) {
+			return min + (std::int32_t)random.Next((std::uint32_t)(max - min + 1));
+		};
+
+		GrowableMemoryFile sets(1024 * 1024);
+		SmallVector<std::uint32_t, 0> setAddresses;
+
+		for (std::int32_t i = 0; i < SetCount; i++) {
+			std::int32_t animCount = nextInRange(1, 12);
+			std::int32_t sampleCount = nextInRange(0, 3);
+			GrowableMemoryFile info(256), frames(1024), images(16384), samples(4096);
+			std::int32_t totalFrameCount = 0;
+
+			for (std::int32_t j = 0; j < animCount; j++) {
+				constexpr std::int32_t FrameCounts[] = { 0, 1, 1, 2, 5, 8, 13 };
+				std::int32_t frameCount = FrameCounts[random.Next((std::uint32_t)arraySize(FrameCounts))];
+				info.WriteValue<std::uint16_t>((std::uint16_t)frameCount);
+				info.WriteValue<std::uint16_t>((std::uint16_t)nextInRange(1, 20));
+				info.WriteValue<std::uint32_t>(0);
+
+				for (std::int32_t k = 0; k < frameCount; k++) {
+					std::int32_t width = nextInRange(2, 48);
+					std::int32_t height = nextInRange(2, 48);
+					const std::int16_t frameHeader[8] = { (std::int16_t)width, (std::int16_t)height, 0, 0,
+						(std::int16_t)-nextInRange(0, width), (std::int16_t)-nextInRange(0, height), 0, 0 };
+					frames.Write(frameHeader, sizeof(frameHeader));
+					frames.WriteValue<std::int32_t>(images.GetSize());
+					frames.WriteValue<std::int32_t>(-1);
+
+					// RLE-encoded image, each row starts with a few transparent pixels
+					images.WriteValue<std::uint16_t>((std::uint16_t)(width | (random.Next(10) < 3 ? 0x8000 : 0)));
+					images.WriteValue<std::uint16_t>((std::uint16_t)height);
+					for (std::int32_t y = 0; y < height; y++) {
+						std::int32_t skip = nextInRange(0, width - 1);
+						if (skip > 0) {
+							images.WriteValue<std::uint8_t>((std::uint8_t)skip);
+						}
+						images.WriteValue<std::uint8_t>((std::uint8_t)(0x80 | (width - skip)));
+						for (std::int32_t x = skip; x < width; x++) {
+							images.WriteValue<std::uint8_t>((std::uint8_t)random.Next(256));
+						}
+						images.WriteValue<std::uint8_t>(0x80);
+					}
+					totalFrameCount++;
+				}
+			}
+
+			for (std::int32_t j = 0; j < sampleCount; j++) {
+				constexpr std::uint16_t Multipliers[] = { 0, 0x40, 0x80 };
+				constexpr std::uint32_t SampleRates[] = { 11025, 22050, 44100 };
+				std::int32_t sampleSize = nextInRange(16, 2000);
+				std::int32_t chunkSize = sampleSize + 76;
+				// RIFF-like header, only the fields that are read by the converter are filled
+				samples.WriteValue<std::int32_t>(chunkSize + 12);
+				samples.WriteValue<std::uint32_t>(0x46464952);
+				samples.WriteValue<std::int32_t>(chunkSize);
+				samples.WriteValue<std::uint32_t>(0x20205341);
+				samples.WriteValue<std::uint32_t>(0x504D4153);
+				samples.WriteValue<std::uint32_t>(0);
+				for (std::int32_t k = 0; k < 40; k++) {
+					samples.WriteValue<std::uint8_t>(0);
+				}
+				samples.WriteValue<std::uint16_t>(Multipliers[random.Next((std::uint32_t)arraySize(Multipliers))]);
+				samples.WriteValue<std::uint16_t>(0);
+				samples.WriteValue<std::uint32_t>((std::uint32_t)sampleSize);
+				samples.WriteValue<std::uint64_t>(0);
+				samples.WriteValue<std::uint32_t>(SampleRates[random.Next((std::uint32_t)arraySize(SampleRates))]);
+				for (std::int32_t k = 0; k < sampleSize; k++) {
+					samples.WriteValue<std::uint8_t>((std::uint8_t)random.Next(256));
+				}
+				samples.WriteValue<std::uint32_t>(0);
+			}
+
+			GrowableMemoryFile blocks(32768);
+			std::int32_t blockSizes[8];
+			WriteBlock(blocks, info, blockSizes[0], blockSizes[1]);
+			WriteBlock(blocks, frames, blockSizes[2], blockSizes[3]);
+			WriteBlock(blocks, images, blockSizes[4], blockSizes[5]);
+			WriteBlock(blocks, samples, blockSizes[6], blockSizes[7]);
+
+			setAddresses.push_back((std::uint32_t)(HeaderSize + sets.GetSize()));
+			sets.WriteValue<std::uint32_t>(0x4D494E41);
+			sets.WriteValue<std::uint8_t>((std::uint8_t)animCount);
+			sets.WriteValue<std::uint8_t>((std::uint8_t)sampleCount);
+			sets.WriteValue<std::uint16_t>((std::uint16_t)totalFrameCount);
+			sets.WriteValue<std::uint32_t>(0);
+			sets.Write(blockSizes, sizeof(blockSizes));
+			sets.Write(blocks.GetBuffer(), blocks.GetSize());
+		}
+
+		auto so = fs::Open(path, FileAccessMode::Write);
+		if (!so->IsOpened()) {
+			return false;
+		}
+		so->WriteValue<std::uint32_t>(0x42494C41);
+		so->WriteValue<std::uint32_t>(0x00BEBA00);
+		so->WriteValue<std::uint32_t>(HeaderSize);
+		so->WriteValue<std::uint32_t>(0x18080200);
+		so->WriteValue<std::uint32_t>((std::uint32_t)(HeaderSize + sets.GetSize()));
+		so->WriteValue<std::uint32_t>(0);
+		so->WriteValue<std::int32_t>(SetCount);
+		so->Write(setAddresses.data(), (std::uint32_t)(setAddresses.size() * sizeof(std::uint32_t)));
+		so->Write(sets.GetBuffer(), sets.GetSize());
+		return true;
+	}
+
+	/// Hashes relative paths and contents of all files in the directory tree
+	void HashDirectory(const StringView& rootPath, const StringView& path, SmallVector<Pair<String, std::uint64_t>, 0>& hashes)
+	{
+		fs::Directory dir(path);
+		while (const char* item = dir.GetNext()) {
+			String itemPath = item;
+			if (fs::IsDirectory(itemPath)) {
+				HashDirectory(rootPath, itemPath, hashes);
+				continue;
+			}
+
+			auto s = fs::Open(itemPath, FileAccessMode::Read);
+			SmallVector<std::uint8_t, 0> data(s->GetSize());
+			s->Read(data.data(), (std::uint32_t)data.size());
+			hashes.emplace_back(itemPath.exceptPrefix(rootPath.size()), fasthash64(data.data(), data.size(), 0));
+		}
+	}
+
+	/// Converts the file and returns hashes of the converted files sorted by their paths
+	SmallVector<Pair<String, std::uint64_t>, 0> ConvertAndHash(const StringView& animsPath, const StringView& targetPath, std::int32_t threadCount)
+	{
+		fs::RemoveDirectoryRecursive(targetPath);
+		SmallVector<Pair<String, std::uint64_t>, 0> hashes;
+		if (JJ2Anims::Convert(animsPath, targetPath, false, nullptr, threadCount)) {
+			HashDirectory(targetPath, targetPath, hashes);
+			std::sort(hashes.begin(), hashes.end(), [](const Pair<String, std::uint64_t>& a, const Pair<String, std::uint64_t>& b) {
+				return a.first() < b.first();
+			});
+		}
+		fs::RemoveDirectoryRecursive(targetPath);
+		return hashes;
+	}
+
+	void RunAnimsConversion(Benchmarks::State& state, std::int32_t threadCount)
+	{
+		String animsPath = GetTempPath("jazz2-benchmark-anims.j2a"_s);
+		String targetPath = GetTempPath("jazz2-benchmark-anims"_s);
+		if (!CreateAnimsFile(animsPath, 1)) {
+			std::fprintf(stderr, "Converter: Cannot create \"%s\"\n", animsPath.data());
+			return;
+		}
+		state.ResetTimer();
+
+		for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+			bool converted = JJ2Anims::Convert(animsPath, targetPath, false, nullptr, threadCount);
+			Benchmarks::DoNotOptimize(converted);
+		}
+		state.StopTimer();
+
+		fs::RemoveDirectoryRecursive(targetPath);
+		fs::RemoveFile(animsPath);
+	}
+}
+
+/// Animations and samples are imported on a single thread
+BENCHMARK(Converter, AnimsSingleThread)
+{
+	RunAnimsConversion(state, 1);
+}
+
+/// Animations and samples are imported on all processors, as `RefreshCache()` does
+BENCHMARK(Converter, AnimsAllThreads)
+{
+	RunAnimsConversion(state, 0);
+}
+
+/// Cache tree converted on multiple threads must be byte-identical to the one converted on a single thread
+SELF_TEST(Converter, AnimsParallelMatchesSerial)
+{
+	String animsPath = GetTempPath("jazz2-benchmark-anims.j2a"_s);
+	String targetPath = GetTempPath("jazz2-benchmark-anims"_s);
+	bool success = true;
+
+	for (std::uint32_t seed = 1; seed <= 3 && success; seed++) {
+		if (!CreateAnimsFile(animsPath, seed)) {
+			std::fprintf(stderr, "Converter/AnimsParallelMatchesSerial: Cannot create \"%s\"\n", animsPath.data());
+			return false;
+		}
+
+		auto serial = ConvertAndHash(animsPath, targetPath, 1);
+		auto parallel = ConvertAndHash(animsPath, targetPath, ParallelThreadCount);
+		if (serial.empty() || serial.size() != parallel.size()) {
+			std::fprintf(stderr, "Converter/AnimsParallelMatchesSerial: Seed %u produced %u files on a single thread and %u files on %i threads\n",
+				seed, (std::uint32_t)serial.size(), (std::uint32_t)parallel.size(), (int)ParallelThreadCount);
+			success = false;
+			break;
+		}
+		for (std::size_t i = 0; i < serial.size(); i++) {
+			if (serial[i].first() != parallel[i].first() || serial[i].second() != parallel[i].second()) {
+				std::fprintf(stderr, "Converter/AnimsParallelMatchesSerial: Seed %u produced different \"%s\"\n", seed, serial[i].first().data());
+				success = false;
+			}
+		}
+	}
+
+	fs::RemoveFile(animsPath);
+	return success;
+}
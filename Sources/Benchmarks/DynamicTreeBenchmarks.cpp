@@ -0,0 +1,170 @@
+#include "BenchmarkHarness.h"
+#include "../Jazz2/Collisions/DynamicTree.h"
+#include "../nCine/Base/FunctionRef.h"
+
+#include <Containers/SmallVector.h>
+
+#include <functional>
+
+using namespace Death::Containers;
+using namespace Jazz2::Collisions;
+using namespace nCine;
+
+namespace
+{
+	constexpr std::int32_t ProxyCount = 2048;
+	constexpr float WorldSize = 8192.0f;
+
+	AABBf CreateRandomAABB(Benchmarks::Random& random, float minSize, float maxSize)
+	{
+		float x = (float)random.Next((std::uint32_t)WorldSize);
+		float y = (float)random.Next((std::uint32_t)WorldSize);
+		float width = minSize + (float)random.Next((std::uint32_t)(maxSize - minSize));
+		float height = minSize + (float)random.Next((std::uint32_t)(maxSize - minSize));
+		return AABBf(x, y, x + width, y + height);
+	}
+
+	void FillTree(DynamicTree& tree, SmallVector<std::int32_t, 0>& proxies, SmallVector<AABBf, 0>& aabbs)
+	{
+		// Objects of various sizes spread over a large level
+		Benchmarks::Random random;
+		for (std::int32_t i = 0; i < ProxyCount; i++) {
+			AABBf aabb = CreateRandomAABB(random, 16.0f, 64.0f);
+			proxies.push_back(tree.CreateProxy(aabb, nullptr));
+			aabbs.push_back(aabb);
+		}
+	}
+
+	struct QueryCounter
+	{
+		std::int32_t Count = 0;
+
+		bool OnCollisionQuery(std::int32_t proxyId)
+		{
+			Count++;
+			return true;
+		}
+	};
+
+	// Mirrors the helper of LevelHandler::FindCollisionActorsByAABB(), which forwards hits to a caller-provided callback
+	template<class TCallback>
+	struct CallbackQueryHelper
+	{
+		const DynamicTree& Tree;
+		const TCallback& Callback;
+
+		bool OnCollisionQuery(std::int32_t proxyId)
+		{
+			return Callback(Tree.GetUserData(proxyId));
+		}
+	};
+
+	template<class TCallback>
+	void QueryWithCallback(const DynamicTree& tree, const AABBf& aabb, const TCallback& callback)
+	{
+		CallbackQueryHelper<TCallback> helper = { tree, callback };
+		tree.Query(&helper, aabb);
+	}
+
+	template<class TCallback>
+	void RunCallbackQueries(Benchmarks::State& state)
+	{
+		DynamicTree tree;
+		SmallVector<std::int32_t, 0> proxies;
+		SmallVector<AABBf, 0> aabbs;
+		FillTree(tree, proxies, aabbs);
+		Benchmarks::Random random(1);
+		state.ResetTimer();
+
+		for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+			// The lambda captures as much state as the solid object check in LevelHandler::IsPositionEmpty()
+			AABBf aabb = CreateRandomAABB(random, 16.0f, 64.0f);
+			void* found = nullptr;
+			std::int32_t count = 0;
+			QueryWithCallback(tree, aabb, TCallback([&aabb, &found, &count](void* userData) -> bool {
+				count++;
+				if (aabb.L < 0.0f) {
+					found = userData;
+					return false;
+				}
+				return true;
+			}));
+			Benchmarks::DoNotOptimize(count);
+			Benchmarks::DoNotOptimize(found);
+		}
+
+		state.StopTimer();
+	}
+}
+
+BENCHMARK(DynamicTree, QuerySmall)
+{
+	DynamicTree tree;
+	SmallVector<std::int32_t, 0> proxies;
+	SmallVector<AABBf, 0> aabbs;
+	FillTree(tree, proxies, aabbs);
+	Benchmarks::Random random(1);
+	state.ResetTimer();
+
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		QueryCounter counter;
+		tree.Query(&counter, CreateRandomAABB(random, 16.0f, 64.0f));
+		Benchmarks::DoNotOptimize(counter.Count);
+	}
+
+	state.StopTimer();
+}
+
+BENCHMARK(DynamicTree, QueryViewport)
+{
+	// Query of the area similar to the visible part of the level
+	DynamicTree tree;
+	SmallVector<std::int32_t, 0> proxies;
+	SmallVector<AABBf, 0> aabbs;
+	FillTree(tree, proxies, aabbs);
+	Benchmarks::Random random(1);
+	state.ResetTimer();
+
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		QueryCounter counter;
+		tree.Query(&counter, CreateRandomAABB(random, 720.0f, 1280.0f));
+		Benchmarks::DoNotOptimize(counter.Count);
+	}
+
+	state.StopTimer();
+}
+
+BENCHMARK(DynamicTree, MoveProxy)
+{
+	DynamicTree tree;
+	SmallVector<std::int32_t, 0> proxies;
+	SmallVector<AABBf, 0> aabbs;
+	FillTree(tree, proxies, aabbs);
+	Benchmarks::Random random(1);
+	state.ResetTimer();
+
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		// Displacement is larger than the fat margin, so some proxies have to be reinserted
+		std::uint32_t index = random.Next(ProxyCount);
+		Vector2f displacement((float)random.Next(16) - 8.0f, (float)random.Next(16) - 8.0f);
+		AABBf& aabb = aabbs[index];
+		aabb.L += displacement.X;
+		aabb.T += displacement.Y;
+		aabb.R += displacement.X;
+		aabb.B += displacement.Y;
+		bool moved = tree.MoveProxy(proxies[index], aabb, displacement);
+		Benchmarks::DoNotOptimize(moved);
+	}
+
+	state.StopTimer();
+}
+
+BENCHMARK(DynamicTree, QueryCallbackStdFunction)
+{
+	RunCallbackQueries<std::function<bool(void*)>>(state);
+}
+
+BENCHMARK(DynamicTree, QueryCallbackFunctionRef)
+{
+	RunCallbackQueries<FunctionRef<bool(void*)>>(state);
+}
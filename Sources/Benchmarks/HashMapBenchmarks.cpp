@@ -0,0 +1,164 @@
+#include "BenchmarkHarness.h"
+#include "../nCine/Base/HashMap.h"
+#include "../nCine/Base/StaticHashMap.h"
+
+#include <cstdio>
+
+#include <Containers/SmallVector.h>
+#include <Containers/String.h>
+
+using namespace Death::Containers;
+using namespace nCine;
+
+namespace
+{
+	constexpr std::uint32_t KeyCount = 1024;
+
+	SmallVector<std::uint32_t, 0> CreateKeys(std::uint32_t count)
+	{
+		SmallVector<std::uint32_t, 0> keys;
+		keys.reserve(count);
+		Benchmarks::Random random;
+		for (std::uint32_t i = 0; i < count; i++) {
+			keys.push_back(random.Next());
+		}
+		return keys;
+	}
+
+	SmallVector<String, 0> CreateStringKeys(std::uint32_t count)
+	{
+		// Keys similar to resource paths, long enough to not fit into the small string optimization buffer
+		SmallVector<String, 0> keys;
+		keys.reserve(count);
+		Benchmarks::Random random;
+		for (std::uint32_t i = 0; i < count; i++) {
+			char buffer[64];
+			std::int32_t length = std::snprintf(buffer, sizeof(buffer), "Content/Animations/Object%u/Frame%u.aura", random.Next(64), i);
+			keys.emplace_back(buffer, (std::size_t)length);
+		}
+		return keys;
+	}
+}
+
+BENCHMARK(HashMap, InsertInteger)
+{
+	SmallVector<std::uint32_t, 0> keys = CreateKeys(KeyCount);
+	state.ResetTimer();
+
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		HashMap<std::uint32_t, std::uint32_t> map;
+		for (std::uint32_t j = 0; j < KeyCount; j++) {
+			map.emplace(keys[j], j);
+		}
+		Benchmarks::DoNotOptimize(map);
+	}
+}
+
+BENCHMARK(HashMap, FindInteger)
+{
+	SmallVector<std::uint32_t, 0> keys = CreateKeys(KeyCount);
+	HashMap<std::uint32_t, std::uint32_t> map;
+	for (std::uint32_t j = 0; j < KeyCount; j++) {
+		map.emplace(keys[j], j);
+	}
+	Benchmarks::Random random(1);
+	state.ResetTimer();
+
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		auto it = map.find(keys[random.Next(KeyCount)]);
+		Benchmarks::DoNotOptimize(it);
+	}
+}
+
+BENCHMARK(HashMap, FindIntegerMissing)
+{
+	SmallVector<std::uint32_t, 0> keys = CreateKeys(KeyCount * 2);
+	HashMap<std::uint32_t, std::uint32_t> map;
+	for (std::uint32_t j = 0; j < KeyCount; j++) {
+		map.emplace(keys[j], j);
+	}
+	Benchmarks::Random random(1);
+	state.ResetTimer();
+
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		auto it = map.find(keys[KeyCount + random.Next(KeyCount)]);
+		Benchmarks::DoNotOptimize(it);
+	}
+}
+
+BENCHMARK(HashMap, InsertString)
+{
+	SmallVector<String, 0> keys = CreateStringKeys(KeyCount);
+	state.ResetTimer();
+
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		HashMap<String, std::uint32_t> map;
+		for (std::uint32_t j = 0; j < KeyCount; j++) {
+			map.emplace(keys[j], j);
+		}
+		Benchmarks::DoNotOptimize(map);
+	}
+}
+
+BENCHMARK(HashMap, FindString)
+{
+	SmallVector<String, 0> keys = CreateStringKeys(KeyCount);
+	HashMap<String, std::uint32_t> map;
+	for (std::uint32_t j = 0; j < KeyCount; j++) {
+		map.emplace(keys[j], j);
+	}
+	Benchmarks::Random random(1);
+	state.ResetTimer();
+
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		auto it = map.find(keys[random.Next(KeyCount)]);
+		Benchmarks::DoNotOptimize(it);
+	}
+}
+
+BENCHMARK(StaticHashMap, InsertInteger)
+{
+	SmallVector<std::uint32_t, 0> keys = CreateKeys(KeyCount / 2);
+	state.ResetTimer();
+
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		// Capacity is twice the number of keys to keep the load factor the same as in `HashMap` benchmarks
+		StaticHashMap<std::uint32_t, std::uint32_t, KeyCount> map;
+		for (std::uint32_t j = 0; j < KeyCount / 2; j++) {
+			map.insert(keys[j], j);
+		}
+		Benchmarks::DoNotOptimize(map);
+	}
+}
+
+BENCHMARK(StaticHashMap, FindInteger)
+{
+	SmallVector<std::uint32_t, 0> keys = CreateKeys(KeyCount / 2);
+	StaticHashMap<std::uint32_t, std::uint32_t, KeyCount> map;
+	for (std::uint32_t j = 0; j < KeyCount / 2; j++) {
+		map.insert(keys[j], j);
+	}
+	Benchmarks::Random random(1);
+	state.ResetTimer();
+
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		std::uint32_t* value = map.find(keys[random.Next(KeyCount / 2)]);
+		Benchmarks::DoNotOptimize(value);
+	}
+}
+
+BENCHMARK(StaticHashMap, FindIntegerMissing)
+{
+	SmallVector<std::uint32_t, 0> keys = CreateKeys(KeyCount);
+	StaticHashMap<std::uint32_t, std::uint32_t, KeyCount> map;
+	for (std::uint32_t j = 0; j < KeyCount / 2; j++) {
+		map.insert(keys[j], j);
+	}
+	Benchmarks::Random random(1);
+	state.ResetTimer();
+
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		std::uint32_t* value = map.find(keys[KeyCount / 2 + random.Next(KeyCount / 2)]);
+		Benchmarks::DoNotOptimize(value);
+	}
+}
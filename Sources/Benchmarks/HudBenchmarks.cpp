@@ -0,0 +1,161 @@
+#include "BenchmarkHarness.h"
+#include "../Jazz2/ContentResolver.h"
+
+#include <cstdio>
+
+#include <Containers/SmallVector.h>
+#include <Containers/String.h>
+
+using namespace Death::Containers;
+using namespace Death::Containers::Literals;
+using namespace Jazz2;
+using namespace nCine;
+
+// These benchmarks measure only the lookup of HUD elements in the metadata of the HUD, the same lookup as `HUD::ResolveElement()` does.
+// Drawing itself (`HUD::DrawElement()`) is not measured, because it requires the renderer and the level, so it's not HUD draw time.
+
+namespace
+{
+	// Number of other graphics in HUD metadata, so the map has a realistic size
+	constexpr int32_t OtherElementCount = 200;
+
+	constexpr StringView WeaponNames[] = {
+		"WeaponBlaster"_s, "WeaponBouncer"_s, "WeaponFreezer"_s, "WeaponSeeker"_s, "WeaponRF"_s,
+		"WeaponToaster"_s, "WeaponTNT"_s, "WeaponPepper"_s, "WeaponElectro"_s, "WeaponThunderbolt"_s
+	};
+
+	/// Elements drawn in a single frame with the weapon wheel open, the boss health bar, counters and full health
+	/*! Each entry is a single lookup, most elements are drawn twice because of the shadow pass. */
+	SmallVector<StringView, 0> CreateStressFrame()
+	{
+		SmallVector<StringView, 0> frame;
+		frame.push_back("WeaponWheel"_s);
+		frame.push_back("WeaponWheelInner"_s);
+		for (StringView weapon : WeaponNames) {
+			// Size of the icon is checked first, then the icon is drawn with its shadow
+			frame.push_back(weapon);
+			frame.push_back(weapon);
+			frame.push_back(weapon);
+		}
+		// Current weapon in the bottom right corner
+		frame.push_back("WeaponBlaster"_s);
+		frame.push_back("WeaponBlaster"_s);
+		frame.push_back("WeaponBlaster"_s);
+		frame.push_back("BossHealthBar"_s);
+		frame.push_back("BossHealthBar"_s);
+		frame.push_back("BossHealthBar"_s);
+		for (int32_t i = 0; i < 2; i++) {
+			frame.push_back("PickupCoin"_s);
+			frame.push_back("PickupGem"_s);
+			frame.push_back("CharacterJazz"_s);
+		}
+		for (int32_t i = 0; i < 10; i++) {
+			frame.push_back("Heart"_s);
+		}
+		return frame;
+	}
+
+	template<class TKey>
+	void FillGraphics(HashMap<TKey, GraphicResource>& graphics, GenericGraphicResource& base, const SmallVector<StringView, 0>& frame, TKey(*createKey)(StringView))
+	{
+		Benchmarks::Random random;
+		auto addElement = [&](TKey key) {
+			GraphicResource& element = graphics.emplace(std::move(key), GraphicResource()).first->second;
+			element.Base = &base;
+			element.AnimDuration = 1.0f;
+			element.FrameCount = 1 + (int32_t)random.Next(16);
+			element.FrameOffset = (int32_t)random.Next(16);
+			element.LoopMode = AnimationLoopMode::Loop;
+		};
+
+		for (int32_t i = 0; i < OtherElementCount; i++) {
+			char buffer[32];
+			int32_t length = std::snprintf(buffer, sizeof(buffer), "Element%i", (int)i);
+			addElement(createKey(StringView(buffer, (std::size_t)length)));
+		}
+		for (StringView name : frame) {
+			if (graphics.find(createKey(name)) == graphics.end()) {
+				addElement(createKey(name));
+			}
+		}
+	}
+
+	GenericGraphicResource CreateBase()
+	{
+		GenericGraphicResource base { };
+		base.FrameDimensions = Vector2i(32, 32);
+		base.FrameConfiguration = Vector2i(16, 1);
+		return base;
+	}
+
+	DEATH_ALWAYS_INLINE int32_t ReadElement(const GraphicResource* element)
+	{
+		// Only the fields needed to compute the frame and the size are read
+		return (element != nullptr ? element->FrameOffset + element->FrameCount + element->Base->FrameDimensions.Y : 0);
+	}
+}
+
+/// Lookup by a string key per draw, as HUD did before `Metadata::Graphics` was keyed by atoms
+BENCHMARK(HudLookup, StressFrameByName)
+{
+	SmallVector<StringView, 0> frame = CreateStressFrame();
+	GenericGraphicResource base = CreateBase();
+	HashMap<String, GraphicResource> graphics;
+	FillGraphics<String>(graphics, base, frame, [](StringView name) { return String(name); });
+	state.ResetTimer();
+
+	for (int64_t i = 0; i < state.GetIterations(); i++) {
+		int32_t sum = 0;
+		for (StringView name : frame) {
+			auto it = graphics.find(String::nullTerminatedView(name));
+			sum += ReadElement(it != graphics.end() ? &it->second : nullptr);
+		}
+		Benchmarks::DoNotOptimize(sum);
+	}
+	state.StopTimer();
+}
+
+/// Lookup of `Metadata::Graphics` by atom per draw, as `HUD::ResolveElement()` and name-based `DrawElement()` overloads of menus do
+BENCHMARK(HudLookup, StressFrameByAtom)
+{
+	SmallVector<StringView, 0> frame = CreateStressFrame();
+	GenericGraphicResource base = CreateBase();
+	Metadata metadata;
+	FillGraphics<Atom>(metadata.Graphics, base, frame, [](StringView name) { return Atom::intern(name); });
+	state.ResetTimer();
+
+	for (int64_t i = 0; i < state.GetIterations(); i++) {
+		int32_t sum = 0;
+		for (StringView name : frame) {
+			auto it = metadata.Graphics.find(Atom::find(name));
+			sum += ReadElement(it != metadata.Graphics.end() ? &it->second : nullptr);
+		}
+		Benchmarks::DoNotOptimize(sum);
+	}
+	state.StopTimer();
+}
+
+/// Elements resolved once when the metadata is bound, as HUD does now, so only the pointers are read per draw
+BENCHMARK(HudLookup, StressFrameResolved)
+{
+	SmallVector<StringView, 0> frame = CreateStressFrame();
+	GenericGraphicResource base = CreateBase();
+	Metadata metadata;
+	FillGraphics<Atom>(metadata.Graphics, base, frame, [](StringView name) { return Atom::intern(name); });
+
+	SmallVector<const GraphicResource*, 0> resolved;
+	for (StringView name : frame) {
+		auto it = metadata.Graphics.find(Atom::find(name));
+		resolved.push_back(it != metadata.Graphics.end() ? &it->second : nullptr);
+	}
+	state.ResetTimer();
+
+	for (int64_t i = 0; i < state.GetIterations(); i++) {
+		int32_t sum = 0;
+		for (const GraphicResource* element : resolved) {
+			sum += ReadElement(element);
+		}
+		Benchmarks::DoNotOptimize(sum);
+	}
+	state.StopTimer();
+}
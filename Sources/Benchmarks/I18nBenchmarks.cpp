@@ -0,0 +1,194 @@
+#include "BenchmarkHarness.h"
+#include "../nCine/I18n.h"
+#include "../nCine/IO/MemoryFile.h"
+
+#include <cstdio>
+#include <cstring>
+
+#include <Containers/SmallVector.h>
+#include <Containers/String.h>
+
+using namespace Death::Containers;
+using namespace Death::Containers::Literals;
+using namespace nCine;
+
+namespace
+{
+	// Number of messages of a translation of the game
+	constexpr std::int32_t MessageCount = 500;
+
+	constexpr char Header[] = "Content-Type: text/plain; charset=UTF-8\n"
+		"Plural-Forms: nplurals=3; plural=(n==1 ? 0 : n%10>=2 && n%10<=4 && (n%100<10 || n%100>=20) ? 1 : 2);\n";
+
+	std::int32_t GetExpectedPluralForm(std::int32_t n)
+	{
+		return (n == 1 ? 0 : n % 10 >= 2 && n % 10 <= 4 && (n % 100 < 10 || n % 100 >= 20) ? 1 : 2);
+	}
+
+	struct CatalogMessage
+	{
+		String Original;
+		String Translated;
+	};
+
+	SmallVector<CatalogMessage, 0> CreateMessages()
+	{
+		SmallVector<CatalogMessage, 0> messages;
+		messages.push_back({ ""_s, String(Header) });
+		messages.push_back({ "Hello"_s, "Ahoj"_s });
+		// Plural forms and context are separated by NULL and EOT characters in the file
+		messages.push_back({ String("apple\0apples"_s), String("jablko\0jablka\0jablek"_s) });
+		messages.push_back({ String("menu\x04Open"_s), "Otevřít"_s });
+		messages.push_back({ "%i lives left"_s, "Zbývá %i životů"_s });
+
+		char original[32], translated[32];
+		for (std::int32_t i = 0; i < MessageCount; i++) {
+			std::snprintf(original, sizeof(original), "Message %i", (int)i);
+			std::snprintf(translated, sizeof(translated), "Zpráva %i", (int)i);
+			messages.push_back({ String(original), String(translated) });
+		}
+		return messages;
+	}
+
+	void AppendValue(SmallVector<std::uint8_t, 0>& data, std::uint32_t value)
+	{
+		data.push_back((std::uint8_t)(value & 0xff));
+		data.push_back((std::uint8_t)((value >> 8) & 0xff));
+		data.push_back((std::uint8_t)((value >> 16) & 0xff));
+		data.push_back((std::uint8_t)((value >> 24) & 0xff));
+	}
+
+	/// Writes little-endian ".mo" file without the hash table, as `msgfmt --no-hash` does
+	SmallVector<std::uint8_t, 0> CreateMoFile(const SmallVector<CatalogMessage, 0>& messages)
+	{
+		constexpr std::uint32_t HeaderSize = 28;
+		const std::uint32_t count = (std::uint32_t)messages.size();
+		const std::uint32_t origTableOffset = HeaderSize;
+		const std::uint32_t transTableOffset = origTableOffset + count * 8;
+		std::uint32_t stringOffset = transTableOffset + count * 8;
+
+		SmallVector<std::uint8_t, 0> data;
+		AppendValue(data, 0x950412de);
+		AppendValue(data, 0);
+		AppendValue(data, count);
+		AppendValue(data, origTableOffset);
+		AppendValue(data, transTableOffset);
+		AppendValue(data, 0);
+		AppendValue(data, stringOffset);
+
+		for (const CatalogMessage& message : messages) {
+			AppendValue(data, (std::uint32_t)message.Original.size());
+			AppendValue(data, stringOffset);
+			stringOffset += (std::uint32_t)message.Original.size() + 1;
+		}
+		for (const CatalogMessage& message : messages) {
+			AppendValue(data, (std::uint32_t)message.Translated.size());
+			AppendValue(data, stringOffset);
+			stringOffset += (std::uint32_t)message.Translated.size() + 1;
+		}
+		for (const CatalogMessage& message : messages) {
+			data.append(message.Original.begin(), message.Original.end());
+			data.push_back(0);
+		}
+		for (const CatalogMessage& message : messages) {
+			data.append(message.Translated.begin(), message.Translated.end());
+			data.push_back(0);
+		}
+		return data;
+	}
+
+	bool LoadCatalog(I18n& i18n, const SmallVector<std::uint8_t, 0>& data, std::int32_t size)
+	{
+		std::unique_ptr<IFileStream> s = std::make_unique<MemoryFile>(data.data(), (std::uint32_t)size);
+		return i18n.LoadFromFile(s);
+	}
+
+	bool ExpectTranslation(const char* what, StringView actual, StringView expected)
+	{
+		// Missing translations are returned as `nullptr` views, which must not be compared by content
+		bool isNull = (actual.data() == nullptr);
+		if (isNull != (expected.data() == nullptr) || (!isNull && actual != expected)) {
+			std::fprintf(stderr, "I18n/CatalogRoundTrip: %s returned \"%.*s\" instead of \"%.*s\"\n", what,
+				(int)actual.size(), actual.data() != nullptr ? actual.data() : "", (int)expected.size(), expected.data() != nullptr ? expected.data() : "");
+			return false;
+		}
+		return true;
+	}
+}
+
+/// Every message of a loaded catalog is looked up, as menus do when they are drawn
+BENCHMARK(I18n, LookupTranslation)
+{
+	SmallVector<CatalogMessage, 0> messages = CreateMessages();
+	SmallVector<std::uint8_t, 0> data = CreateMoFile(messages);
+	I18n i18n;
+	LoadCatalog(i18n, data, (std::int32_t)data.size());
+
+	// Message IDs of literals are hashed at compile-time, so the hash is not part of the measured lookup
+	SmallVector<MessageId, 0> ids;
+	for (const CatalogMessage& message : messages) {
+		// Only the singular form is the identifier of plural messages
+		ids.push_back(MessageId(message.Original.data()));
+	}
+	state.ResetTimer();
+
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		std::size_t length = 0;
+		for (const MessageId& id : ids) {
+			length += i18n.LookupTranslation(id).size();
+		}
+		Benchmarks::DoNotOptimize(length);
+	}
+	state.StopTimer();
+}
+
+/// Messages, plural forms and contexts of a written ".mo" file are read back, truncated files are rejected
+SELF_TEST(I18n, CatalogRoundTrip)
+{
+	SmallVector<CatalogMessage, 0> messages = CreateMessages();
+	SmallVector<std::uint8_t, 0> data = CreateMoFile(messages);
+
+	I18n i18n;
+	if (!LoadCatalog(i18n, data, (std::int32_t)data.size())) {
+		std::fprintf(stderr, "I18n/CatalogRoundTrip: Catalog was not loaded\n");
+		return false;
+	}
+
+	bool success = ExpectTranslation("Header", i18n.LookupTranslation(""), StringView(Header)) &&
+		ExpectTranslation("Singular", i18n.LookupTranslation("Hello"), "Ahoj"_s) &&
+		ExpectTranslation("Context", i18n.LookupTranslation(MessageId(String("menu\x04Open"_s))), "Otevřít"_s) &&
+		ExpectTranslation("Missing context", i18n.LookupTranslation("Open"), nullptr) &&
+		ExpectTranslation("Missing", i18n.LookupTranslation("Goodbye"), nullptr) &&
+		ExpectTranslation("Prefix", i18n.LookupTranslation("Hell"), nullptr) &&
+		ExpectTranslation("Plural ID", i18n.LookupTranslation("apples"), nullptr) &&
+		ExpectTranslation("Plural form of singular", i18n.LookupPlural("Hello", 5), "Ahoj"_s) &&
+		ExpectTranslation("Format", FormatTranslation(i18n.LookupTranslation("%i lives left").data(), 3), "Zbývá 3 životů"_s);
+
+	char original[32], translated[32];
+	for (std::int32_t i = 0; i < MessageCount && success; i++) {
+		std::snprintf(original, sizeof(original), "Message %i", (int)i);
+		std::snprintf(translated, sizeof(translated), "Zpráva %i", (int)i);
+		success = ExpectTranslation("Message", i18n.LookupTranslation(MessageId(StringView(original))), translated);
+	}
+
+	// Counts above `I18n::PluralLookupSize` and negative counts are evaluated by the expression
+	constexpr StringView PluralForms[] = { "jablko"_s, "jablka"_s, "jablek"_s };
+	for (std::int32_t n = -30; n < 1000 && success; n++) {
+		success = ExpectTranslation("Plural", i18n.LookupPlural("apple", n), PluralForms[GetExpectedPluralForm(n)]);
+	}
+
+	// Catalog can be replaced by another one
+	if (!LoadCatalog(i18n, data, (std::int32_t)data.size()) || i18n.LookupTranslation("Hello") != "Ahoj"_s) {
+		std::fprintf(stderr, "I18n/CatalogRoundTrip: Catalog was not reloaded\n");
+		success = false;
+	}
+
+	for (std::int32_t size = 0; size < (std::int32_t)data.size(); size++) {
+		I18n truncated;
+		if (LoadCatalog(truncated, data, size)) {
+			std::fprintf(stderr, "I18n/CatalogRoundTrip: Catalog truncated to %i bytes was loaded\n", (int)size);
+			success = false;
+		}
+	}
+	return success;
+}
@@ -0,0 +1,335 @@
+#include "BenchmarkHarness.h"
+#include "../nCine/IO/CompressionUtils.h"
+#include "../nCine/IO/MemoryFile.h"
+#include "../nCine/IO/StandardFile.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+#include <Containers/String.h>
+
+using namespace Death::Containers;
+using namespace nCine;
+
+namespace
+{
+	constexpr std::int32_t DataSize = 256 * 1024;
+	constexpr std::int32_t FileSize = 1024 * 1024;
+	constexpr std::int32_t BlockSize = 4096;
+
+	std::unique_ptr<std::uint8_t[]> CreateData(std::int32_t size)
+	{
+		// Runs of repeated bytes mixed with noise, similar to tile sets and animations
+		std::unique_ptr<std::uint8_t[]> data = std::make_unique<std::uint8_t[]>(size);
+		Benchmarks::Random random;
+		std::int32_t i = 0;
+		while (i < size) {
+			std::uint32_t value = random.Next();
+			std::int32_t length = (value & 0x80000000u) != 0 ? (std::int32_t)(value & 0x3F) + 1 : 1;
+			for (std::int32_t j = 0; j < length && i < size; j++, i++) {
+				data[i] = (std::uint8_t)(value >> 8);
+			}
+		}
+		return data;
+	}
+
+	/// Creates data that are compressed to all kinds of blocks, the last one repeats at long distances to use the whole window
+	std::unique_ptr<std::uint8_t[]> CreateRoundTripData(std::int32_t kind, std::int32_t size, std::uint32_t seed)
+	{
+		std::unique_ptr<std::uint8_t[]> data = std::make_unique<std::uint8_t[]>(size);
+		Benchmarks::Random random(seed);
+		for (std::int32_t i = 0; i < size; i++) {
+			switch (kind) {
+				case 0: data[i] = (std::uint8_t)random.Next(4); break;
+				case 1: data[i] = (std::uint8_t)random.Next(); break;
+				default: data[i] = (i < 20000 ? (std::uint8_t)random.Next() : data[i - 20000 - (i / 20000 - 1) * 1000]); break;
+			}
+		}
+		return data;
+	}
+
+	/// Decompresses the whole stream using blocks of specified size
+	std::int32_t InflateInBlocks(const std::uint8_t* compressed, std::int32_t compressedSize, std::uint8_t* dest, std::int32_t destSize, std::int32_t blockSize)
+	{
+		InflateStream stream;
+		if (!stream.Open(compressed, compressedSize)) {
+			return -1;
+		}
+		std::int32_t totalSize = 0;
+		while (totalSize < destSize) {
+			std::int32_t bytesRead = stream.Read(dest + totalSize, std::min(blockSize, destSize - totalSize));
+			if (bytesRead <= 0) {
+				break;
+			}
+			totalSize += bytesRead;
+		}
+		return totalSize;
+	}
+
+	String GetTempFilePath()
+	{
+		const char* tempDir = std::getenv("TMPDIR");
+		if (tempDir == nullptr || tempDir[0] == '\0') {
+			tempDir = std::getenv("TEMP");
+		}
+		if (tempDir == nullptr || tempDir[0] == '\0') {
+			tempDir = ".";
+		}
+
+		char path[1024];
+		std::snprintf(path, sizeof(path), "%s/jazz2-benchmark.tmp", tempDir);
+		return String(path);
+	}
+
+	/// Temporary file that is deleted when the benchmark ends
+	class TempFile
+	{
+	public:
+		explicit TempFile(std::int32_t size)
+			: _path(GetTempFilePath())
+		{
+			std::unique_ptr<std::uint8_t[]> data = CreateData(size);
+			StandardFile file(_path);
+			file.Open(FileAccessMode::Write);
+			file.Write(data.get(), (std::uint32_t)size);
+		}
+
+		~TempFile()
+		{
+			std::remove(_path.data());
+		}
+
+		const String& GetPath() const {
+			return _path;
+		}
+
+	private:
+		String _path;
+	};
+}
+
+BENCHMARK(CompressionUtils, Inflate)
+{
+	std::unique_ptr<std::uint8_t[]> data = CreateData(DataSize);
+	std::int32_t compressedSize = CompressionUtils::GetMaxDeflatedSize(DataSize);
+	std::unique_ptr<std::uint8_t[]> compressed = std::make_unique<std::uint8_t[]>(compressedSize);
+	compressedSize = CompressionUtils::Deflate(data.get(), DataSize, compressed.get(), compressedSize);
+	std::unique_ptr<std::uint8_t[]> decompressed = std::make_unique<std::uint8_t[]>(DataSize);
+	state.SetBytesPerIteration(DataSize);
+	state.ResetTimer();
+
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		std::int32_t srcSize = compressedSize;
+		std::int32_t destSize = DataSize;
+		DecompressionResult result = CompressionUtils::Inflate(compressed.get(), srcSize, decompressed.get(), destSize);
+		Benchmarks::DoNotOptimize(result);
+		Benchmarks::ClobberMemory();
+	}
+}
+
+BENCHMARK(CompressionUtils, InflateStream)
+{
+	std::unique_ptr<std::uint8_t[]> data = CreateData(DataSize);
+	std::int32_t compressedSize = CompressionUtils::GetMaxDeflatedSize(DataSize);
+	std::unique_ptr<std::uint8_t[]> compressed = std::make_unique<std::uint8_t[]>(compressedSize);
+	compressedSize = CompressionUtils::Deflate(data.get(), DataSize, compressed.get(), compressedSize);
+	std::uint8_t buffer[BlockSize];
+	state.SetBytesPerIteration(DataSize);
+	state.ResetTimer();
+
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		InflateStream stream;
+		stream.Open(compressed.get(), compressedSize);
+		while (stream.Read(buffer, BlockSize) > 0) {
+			Benchmarks::ClobberMemory();
+		}
+	}
+}
+
+BENCHMARK(MemoryFile, ReadValueUint8)
+{
+	std::unique_ptr<std::uint8_t[]> data = CreateData(DataSize);
+	MemoryFile file(static_cast<const std::uint8_t*>(data.get()), DataSize);
+	file.Open(FileAccessMode::Read);
+	state.SetBytesPerIteration(DataSize);
+	state.ResetTimer();
+
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		file.Seek(0, SeekOrigin::Begin);
+		std::uint32_t sum = 0;
+		for (std::int32_t j = 0; j < DataSize; j++) {
+			sum += file.ReadValue<std::uint8_t>();
+		}
+		Benchmarks::DoNotOptimize(sum);
+	}
+}
+
+BENCHMARK(MemoryFile, ReadValueUint32)
+{
+	std::unique_ptr<std::uint8_t[]> data = CreateData(DataSize);
+	MemoryFile file(static_cast<const std::uint8_t*>(data.get()), DataSize);
+	file.Open(FileAccessMode::Read);
+	state.SetBytesPerIteration(DataSize);
+	state.ResetTimer();
+
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		file.Seek(0, SeekOrigin::Begin);
+		std::uint32_t sum = 0;
+		for (std::int32_t j = 0; j < DataSize / 4; j++) {
+			sum += file.ReadValue<std::uint32_t>();
+		}
+		Benchmarks::DoNotOptimize(sum);
+	}
+}
+
+BENCHMARK(MemoryFile, ReadBlock)
+{
+	std::unique_ptr<std::uint8_t[]> data = CreateData(DataSize);
+	MemoryFile file(static_cast<const std::uint8_t*>(data.get()), DataSize);
+	file.Open(FileAccessMode::Read);
+	std::uint8_t buffer[BlockSize];
+	state.SetBytesPerIteration(DataSize);
+	state.ResetTimer();
+
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		file.Seek(0, SeekOrigin::Begin);
+		while (file.Read(buffer, BlockSize) > 0) {
+			Benchmarks::ClobberMemory();
+		}
+	}
+}
+
+BENCHMARK(StandardFile, ReadValueUint32)
+{
+	TempFile tempFile(FileSize);
+	StandardFile file(tempFile.GetPath());
+	file.Open(FileAccessMode::Read);
+	state.SetBytesPerIteration(FileSize);
+	state.ResetTimer();
+
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		file.Seek(0, SeekOrigin::Begin);
+		std::uint32_t sum = 0;
+		for (std::int32_t j = 0; j < FileSize / 4; j++) {
+			sum += file.ReadValue<std::uint32_t>();
+		}
+		Benchmarks::DoNotOptimize(sum);
+	}
+
+	state.StopTimer();
+}
+
+BENCHMARK(StandardFile, ReadBlock)
+{
+	TempFile tempFile(FileSize);
+	StandardFile file(tempFile.GetPath());
+	file.Open(FileAccessMode::Read);
+	std::uint8_t buffer[BlockSize];
+	state.SetBytesPerIteration(FileSize);
+	state.ResetTimer();
+
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		file.Seek(0, SeekOrigin::Begin);
+		while (file.Read(buffer, BlockSize) > 0) {
+			Benchmarks::ClobberMemory();
+		}
+	}
+
+	state.StopTimer();
+}
+
+#if !(defined(DEATH_TARGET_WINDOWS) && !defined(DEATH_TARGET_MINGW))
+BENCHMARK(StandardFile, ReadBlockDescriptor)
+{
+	TempFile tempFile(FileSize);
+	StandardFile file(tempFile.GetPath());
+	file.Open(FileAccessMode::FileDescriptor | FileAccessMode::Read);
+	std::uint8_t buffer[BlockSize];
+	state.SetBytesPerIteration(FileSize);
+	state.ResetTimer();
+
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		file.Seek(0, SeekOrigin::Begin);
+		while (file.Read(buffer, BlockSize) > 0) {
+			Benchmarks::ClobberMemory();
+		}
+	}
+
+	state.StopTimer();
+}
+#endif
+
+/// Deflated data are decompressed by `InflateStream` using blocks of any size, so the built-in decoder is covered if libdeflate is used
+SELF_TEST(CompressionUtils, InflateStreamRoundTrip)
+{
+	constexpr std::int32_t Sizes[] = { 0, 1, 300, 100000 };
+	constexpr std::int32_t BlockSizes[] = { 1, 13, 4096, 200000 };
+
+	bool success = true;
+	for (std::int32_t kind = 0; kind < 3; kind++) {
+		for (std::int32_t size : Sizes) {
+			std::unique_ptr<std::uint8_t[]> data = CreateRoundTripData(kind, size, (std::uint32_t)(kind * 7919 + size + 1));
+			std::int32_t compressedSize = CompressionUtils::GetMaxDeflatedSize(size);
+			std::unique_ptr<std::uint8_t[]> compressed = std::make_unique<std::uint8_t[]>(compressedSize);
+			compressedSize = CompressionUtils::Deflate(data.get(), size, compressed.get(), compressedSize);
+			// One more byte is requested to check that the stream ends at the right position
+			std::unique_ptr<std::uint8_t[]> decompressed = std::make_unique<std::uint8_t[]>(size + 1);
+
+			for (std::int32_t blockSize : BlockSizes) {
+				std::int32_t decompressedSize = InflateInBlocks(compressed.get(), compressedSize, decompressed.get(), size + 1, blockSize);
+				if (decompressedSize != size || std::memcmp(data.get(), decompressed.get(), size) != 0) {
+					std::fprintf(stderr, "CompressionUtils/InflateStreamRoundTrip: Data of kind %i and size %i read in blocks of %i bytes don't match\n", (int)kind, (int)size, (int)blockSize);
+					success = false;
+				}
+			}
+
+			std::int32_t srcSize = compressedSize;
+			std::int32_t destSize = size + 1;
+			if (CompressionUtils::Inflate(compressed.get(), srcSize, decompressed.get(), destSize) != DecompressionResult::Success ||
+				destSize != size || std::memcmp(data.get(), decompressed.get(), size) != 0) {
+				std::fprintf(stderr, "CompressionUtils/InflateStreamRoundTrip: Data of kind %i and size %i don't match after Inflate()\n", (int)kind, (int)size);
+				success = false;
+			}
+		}
+	}
+	return success;
+}
+
+/// Truncated stream is decompressed only partially, any corrupted stream must not be read or written outside of its buffers
+SELF_TEST(CompressionUtils, InflateStreamCorrupted)
+{
+	constexpr std::int32_t Size = 3000;
+	constexpr std::int32_t MaxSize = 256 * 1024;
+
+	bool success = true;
+	for (std::int32_t kind = 0; kind < 3; kind++) {
+		std::unique_ptr<std::uint8_t[]> data = CreateRoundTripData(kind, Size, (std::uint32_t)(kind + 1));
+		std::int32_t compressedSize = CompressionUtils::GetMaxDeflatedSize(Size);
+		std::unique_ptr<std::uint8_t[]> compressed = std::make_unique<std::uint8_t[]>(compressedSize);
+		compressedSize = CompressionUtils::Deflate(data.get(), Size, compressed.get(), compressedSize);
+		std::unique_ptr<std::uint8_t[]> decompressed = std::make_unique<std::uint8_t[]>(MaxSize);
+
+		for (std::int32_t size = 0; size < compressedSize; size++) {
+			// Copy of the truncated stream, so reading past its end is detected by sanitizers
+			std::unique_ptr<std::uint8_t[]> truncated = std::make_unique<std::uint8_t[]>(size);
+			std::memcpy(truncated.get(), compressed.get(), size);
+			std::int32_t decompressedSize = InflateInBlocks(truncated.get(), size, decompressed.get(), MaxSize, 4096);
+			if (decompressedSize < 0 || decompressedSize > Size || std::memcmp(data.get(), decompressed.get(), decompressedSize) != 0) {
+				std::fprintf(stderr, "CompressionUtils/InflateStreamCorrupted: Stream of kind %i truncated to %i bytes produced different data\n", (int)kind, (int)size);
+				success = false;
+			}
+		}
+
+		for (std::int32_t i = 0; i < compressedSize; i++) {
+			for (std::int32_t bit = 0; bit < 8; bit++) {
+				compressed[i] ^= (std::uint8_t)(1 << bit);
+				InflateInBlocks(compressed.get(), compressedSize, decompressed.get(), MaxSize, 4096);
+				compressed[i] ^= (std::uint8_t)(1 << bit);
+			}
+		}
+	}
+	return success;
+}
@@ -0,0 +1,113 @@
+#include "BenchmarkHarness.h"
+#include "../nCine/Base/CpuDispatch.h"
+
+#include <cstring>
+
+#include <Containers/SmallVector.h>
+
+using namespace Death::Containers;
+using namespace nCine;
+
+namespace
+{
+	// Size of a larger sprite sheet page, the size is intentionally not a multiple of any vector width
+	constexpr std::int32_t PixelCount = 512 * 512 - 3;
+	// Size of a longer 8-bit sample of the original game
+	constexpr std::int32_t SampleSize = 64 * 1024 - 5;
+
+	SmallVector<std::uint32_t, 0> CreatePalette()
+	{
+		Benchmarks::Random random;
+		SmallVector<std::uint32_t, 0> palette(256);
+		for (std::int32_t i = 0; i < 256; i++) {
+			palette[i] = (std::uint32_t)random.Next(0x01000000) | ((std::uint32_t)random.Next(256) << 24);
+		}
+		return palette;
+	}
+
+	SmallVector<std::uint32_t, 0> CreateIndexedPixels()
+	{
+		Benchmarks::Random random;
+		SmallVector<std::uint32_t, 0> pixels(PixelCount);
+		for (std::int32_t i = 0; i < PixelCount; i++) {
+			// Palette index in the red channel and alpha in the alpha channel, as sprites are stored before the palette is applied
+			pixels[i] = (std::uint32_t)random.Next(256) | ((std::uint32_t)random.Next(256) << 24);
+		}
+		return pixels;
+	}
+}
+
+/// Palette is applied to a whole sprite sheet, as `ContentResolver` does for each loaded sprite
+BENCHMARK(Kernel, ExpandPaletteInPlace)
+{
+	SmallVector<std::uint32_t, 0> palette = CreatePalette();
+	SmallVector<std::uint32_t, 0> source = CreateIndexedPixels();
+	SmallVector<std::uint32_t, 0> pixels(PixelCount);
+	state.SetBytesPerIteration((std::int64_t)PixelCount * sizeof(std::uint32_t));
+	state.ResetTimer();
+
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		// The kernel works in-place, so the indexed pixels have to be restored, the copy is included in the measurement
+		std::memcpy(pixels.data(), source.data(), PixelCount * sizeof(std::uint32_t));
+		CpuDispatch::ExpandPaletteInPlace(pixels.data(), PixelCount, palette.data());
+		Benchmarks::ClobberMemory();
+	}
+	state.StopTimer();
+}
+
+/// Whole mask is scanned, because it's fully non-zero, as the worst case of `TileSet` tile classification
+BENCHMARK(Kernel, ClassifyMask)
+{
+	SmallVector<std::uint8_t, 0> mask(PixelCount);
+	std::memset(mask.data(), 1, PixelCount);
+	state.SetBytesPerIteration(PixelCount);
+	state.ResetTimer();
+
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		MaskFlags flags = CpuDispatch::ClassifyMask(mask.data(), PixelCount);
+		Benchmarks::DoNotOptimize(flags);
+	}
+	state.StopTimer();
+}
+
+/// Whole image is scanned, because it's fully opaque, as the worst case of `TileSet` opacity test
+BENCHMARK(Kernel, IsOpaque)
+{
+	SmallVector<std::uint32_t, 0> pixels(PixelCount);
+	for (std::int32_t i = 0; i < PixelCount; i++) {
+		pixels[i] = 0xff000000u | (std::uint32_t)i;
+	}
+	state.SetBytesPerIteration((std::int64_t)PixelCount * sizeof(std::uint32_t));
+	state.ResetTimer();
+
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		bool isOpaque = CpuDispatch::IsOpaque(pixels.data(), PixelCount);
+		Benchmarks::DoNotOptimize(isOpaque);
+	}
+	state.StopTimer();
+}
+
+/// Signed 8-bit sample is converted, as the JJ2 sample import does
+BENCHMARK(Kernel, ConvertS8ToU8)
+{
+	Benchmarks::Random random;
+	SmallVector<std::uint8_t, 0> source(SampleSize);
+	SmallVector<std::uint8_t, 0> dest(SampleSize);
+	for (std::int32_t i = 0; i < SampleSize; i++) {
+		source[i] = (std::uint8_t)random.Next(256);
+	}
+	state.SetBytesPerIteration(SampleSize);
+	state.ResetTimer();
+
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		CpuDispatch::ConvertS8ToU8(dest.data(), source.data(), SampleSize);
+		Benchmarks::ClobberMemory();
+	}
+	state.StopTimer();
+}
+
+/// All implementations supported by the current CPU must produce exactly the same results as the scalar ones
+SELF_TEST(Kernel, MatchScalar)
+{
+	return CpuDispatch::RunSelfTest();
+}
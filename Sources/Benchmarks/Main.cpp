@@ -0,0 +1,371 @@
+#include "BenchmarkHarness.h"
+#include "../nCine/Base/CpuDispatch.h"
+#if defined(WITH_ALLOCATORS)
+#	include "../nCine/Base/AllocManager.h"
+#endif
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+#include <Containers/SmallVector.h>
+#include <Containers/String.h>
+
+using namespace Death::Containers;
+using namespace nCine;
+
+namespace
+{
+	struct BaselineEntry
+	{
+		String Name;
+		double NsPerOp;
+		double AllocationsPerOp;
+	};
+
+	SmallVector<BaselineEntry, 0> _baseline;
+	double _maxRegression = -1.0;
+	std::int32_t _regressionCount = 0;
+	std::int32_t _matchCount = 0;
+
+	void PrintUsage(const char* executable)
+	{
+		std::printf(
+			"Usage: %s [options]\n"
+			"\n"
+			"Options:\n"
+			"  --filter <text>          Run only benchmarks with \"Group/Name\" containing the text\n"
+			"  --list                   List benchmarks and exit\n"
+			"  --self-test              Run self-tests matching the filter instead of benchmarks and exit\n"
+			"  --cpu-features <list>    Use only the listed instruction sets for dispatched kernels (e.g. \"scalar\" or \"sse2\")\n"
+			"  --warmup <ms>            Minimal warmup time of each benchmark (default: 100)\n"
+			"  --min-time <ms>          Target time of each repetition (default: 250)\n"
+			"  --repetitions <count>    Number of measured repetitions, the median is reported (default: 5)\n"
+			"  --json <path>            Write results to a JSON file\n"
+			"  --csv <path>             Write results to a CSV file\n"
+			"  --compare <path>         Compare results with a CSV file written by a previous run\n"
+			"  --max-regression <pct>   Exit with non-zero code if ns/op of any benchmark regressed more than that\n",
+			executable);
+	}
+
+	bool ParseInt(const char* value, std::int32_t& result)
+	{
+		char* end;
+		long parsed = std::strtol(value, &end, 10);
+		if (end == value || *end != '\0' || parsed < 0 || parsed > INT32_MAX) {
+			return false;
+		}
+		result = (std::int32_t)parsed;
+		return true;
+	}
+
+	bool LoadBaseline(const char* path)
+	{
+		FILE* file = std::fopen(path, "r");
+		if (file == nullptr) {
+			std::fprintf(stderr, "Cannot open baseline file \"%s\"\n", path);
+			return false;
+		}
+
+		char line[1024];
+		bool isHeader = true;
+		while (std::fgets(line, sizeof(line), file) != nullptr) {
+			if (isHeader) {
+				isHeader = false;
+				continue;
+			}
+
+			// Only the name, ns/op and allocations/op columns are needed, see `WriteCsv()` for the format
+			const char* separator = std::strchr(line, ',');
+			if (separator == nullptr) {
+				continue;
+			}
+
+			long long warmupIterations, warmupNs, iterations;
+			int repetitions;
+			double nsPerOp, minNsPerOp, maxNsPerOp, allocationsPerOp;
+			if (std::sscanf(separator + 1, "%lld,%lld,%lld,%d,%lf,%lf,%lf,%lf", &warmupIterations, &warmupNs, &iterations,
+				&repetitions, &nsPerOp, &minNsPerOp, &maxNsPerOp, &allocationsPerOp) == 8) {
+				_baseline.push_back({ String(line, (std::size_t)(separator - line)), nsPerOp, allocationsPerOp });
+			}
+		}
+
+		std::fclose(file);
+		return true;
+	}
+
+	const BaselineEntry* FindBaseline(const Benchmarks::Result& result)
+	{
+		char fullName[256];
+		std::snprintf(fullName, sizeof(fullName), "%s/%s", result.Group, result.Name);
+		for (const BaselineEntry& entry : _baseline) {
+			if (entry.Name == fullName) {
+				return &entry;
+			}
+		}
+		return nullptr;
+	}
+
+	void PrintHeader()
+	{
+		std::printf("%-40s %14s %18s %12s %9s %11s %11s %10s", "Benchmark", "Warmup", "Iterations", "ns/op", "Spread", "Allocs/op", "Bytes/op", "MB/s");
+		if (!_baseline.empty()) {
+			std::printf(" %10s", "Baseline");
+		}
+		std::printf("\n");
+	}
+
+	void PrintResult(const Benchmarks::Result& result)
+	{
+		char fullName[256];
+		std::snprintf(fullName, sizeof(fullName), "%s/%s", result.Group, result.Name);
+		char iterations[32];
+		std::snprintf(iterations, sizeof(iterations), "%lldx%d", (long long)result.Iterations, (int)result.Repetitions);
+		const double spread = (result.NsPerOp > 0.0 ? (result.MaxNsPerOp - result.MinNsPerOp) / result.NsPerOp * 100.0 : 0.0);
+
+		std::printf("%-40s %14lld %18s %12.2f %8.1f%% %11.2f %11.1f", fullName, (long long)result.WarmupIterations, iterations,
+			result.NsPerOp, spread, result.AllocationsPerOp, result.AllocatedBytesPerOp);
+		if (result.MegabytesPerSecond > 0.0) {
+			std::printf(" %10.1f", result.MegabytesPerSecond);
+		} else {
+			std::printf(" %10s", "-");
+		}
+
+		if (!_baseline.empty()) {
+			if (const BaselineEntry* entry = FindBaseline(result)) {
+				const double change = (entry->NsPerOp > 0.0 ? (result.NsPerOp / entry->NsPerOp - 1.0) * 100.0 : 0.0);
+				std::printf(" %+9.1f%%", change);
+				if (_maxRegression >= 0.0 && change > _maxRegression) {
+					_regressionCount++;
+				}
+			} else {
+				std::printf(" %10s", "new");
+			}
+		}
+		std::printf("\n");
+		std::fflush(stdout);
+	}
+
+	void PrintListEntry(const char* group, const char* name)
+	{
+		std::printf("%s/%s\n", group, name);
+	}
+
+	void CountMatch(const char* group, const char* name)
+	{
+		_matchCount++;
+	}
+
+	void PrintSelfTestResult(const char* group, const char* name, bool passed)
+	{
+		_matchCount++;
+		char fullName[256];
+		std::snprintf(fullName, sizeof(fullName), "%s/%s", group, name);
+		std::printf("%-40s %s\n", fullName, passed ? "passed" : "FAILED");
+		std::fflush(stdout);
+	}
+
+	bool WriteJson(const char* path, const Benchmarks::RunnerOptions& options, const Benchmarks::Result* results, std::int32_t count)
+	{
+		FILE* file = std::fopen(path, "w");
+		if (file == nullptr) {
+			std::fprintf(stderr, "Cannot write results to \"%s\"\n", path);
+			return false;
+		}
+
+		// Names are C++ identifiers, so no escaping is needed
+		std::fprintf(file, "{\n");
+		std::fprintf(file, "\t\"version\": 1,\n");
+		std::fprintf(file, "\t\"cpu\": \"%s\",\n", CpuDispatch::GetFeatureName(CpuDispatch::GetFeatures()));
+		std::fprintf(file, "\t\"mallocTracked\": %s,\n", Benchmarks::IsMallocTracked() ? "true" : "false");
+		std::fprintf(file, "\t\"warmupMs\": %d,\n", (int)options.WarmupMs);
+		std::fprintf(file, "\t\"minTimeMs\": %d,\n", (int)options.MinTimeMs);
+		std::fprintf(file, "\t\"repetitions\": %d,\n", (int)options.Repetitions);
+		std::fprintf(file, "\t\"benchmarks\": [");
+		for (std::int32_t i = 0; i < count; i++) {
+			const Benchmarks::Result& result = results[i];
+			std::fprintf(file, "%s\n\t\t{ \"name\": \"%s/%s\", \"warmupIterations\": %lld, \"warmupNs\": %lld, \"iterations\": %lld, \"repetitions\": %d, "
+				"\"nsPerOp\": %.3f, \"minNsPerOp\": %.3f, \"maxNsPerOp\": %.3f, \"allocationsPerOp\": %.4f, \"allocatedBytesPerOp\": %.2f, \"megabytesPerSecond\": %.2f }",
+				i > 0 ? "," : "", result.Group, result.Name, (long long)result.WarmupIterations, (long long)result.WarmupNs, (long long)result.Iterations,
+				(int)result.Repetitions, result.NsPerOp, result.MinNsPerOp, result.MaxNsPerOp, result.AllocationsPerOp, result.AllocatedBytesPerOp,
+				result.MegabytesPerSecond);
+		}
+		std::fprintf(file, "\n\t]\n}\n");
+
+		std::fclose(file);
+		return true;
+	}
+
+	bool WriteCsv(const char* path, const Benchmarks::Result* results, std::int32_t count)
+	{
+		FILE* file = std::fopen(path, "w");
+		if (file == nullptr) {
+			std::fprintf(stderr, "Cannot write results to \"%s\"\n", path);
+			return false;
+		}
+
+		std::fprintf(file, "name,warmupIterations,warmupNs,iterations,repetitions,nsPerOp,minNsPerOp,maxNsPerOp,allocationsPerOp,allocatedBytesPerOp,megabytesPerSecond\n");
+		for (std::int32_t i = 0; i < count; i++) {
+			const Benchmarks::Result& result = results[i];
+			std::fprintf(file, "%s/%s,%lld,%lld,%lld,%d,%.3f,%.3f,%.3f,%.4f,%.2f,%.2f\n", result.Group, result.Name,
+				(long long)result.WarmupIterations, (long long)result.WarmupNs, (long long)result.Iterations, (int)result.Repetitions,
+				result.NsPerOp, result.MinNsPerOp, result.MaxNsPerOp, result.AllocationsPerOp, result.AllocatedBytesPerOp, result.MegabytesPerSecond);
+		}
+
+		std::fclose(file);
+		return true;
+	}
+
+#if defined(WITH_ALLOCATORS)
+	void PrintAllocatorStatistics()
+	{
+		std::printf("\n%-40s %14s %14s %18s\n", "Allocator", "Used bytes", "Peak bytes", "Total allocations");
+		for (std::size_t i = 0; i < std::size_t(AllocTag::Count); i++) {
+			const ProxyAllocator& allocator = AllocManager::proxy(AllocTag(i));
+			const ProxyAllocator::Statistics stats = allocator.statistics();
+			std::printf("%-40s %14zu %14zu %18zu\n", allocator.name(), stats.usedMemory, stats.peakMemory, stats.totalAllocations);
+		}
+	}
+#endif
+}
+
+int main(int argc, char** argv)
+{
+	Benchmarks::RunnerOptions options;
+	options.Filter = nullptr;
+	options.WarmupMs = 100;
+	options.MinTimeMs = 250;
+	options.Repetitions = 5;
+
+	const char* jsonPath = nullptr;
+	const char* csvPath = nullptr;
+	const char* comparePath = nullptr;
+	bool listOnly = false;
+	bool selfTestOnly = false;
+
+	for (int i = 1; i < argc; i++) {
+		const char* arg = argv[i];
+		const char* value = (i + 1 < argc ? argv[i + 1] : nullptr);
+		bool isValid = true;
+		bool usesValue = true;
+
+		if (std::strcmp(arg, "--filter") == 0) {
+			options.Filter = value;
+		} else if (std::strcmp(arg, "--warmup") == 0) {
+			isValid = (value != nullptr && ParseInt(value, options.WarmupMs));
+		} else if (std::strcmp(arg, "--min-time") == 0) {
+			isValid = (value != nullptr && ParseInt(value, options.MinTimeMs));
+		} else if (std::strcmp(arg, "--repetitions") == 0) {
+			isValid = (value != nullptr && ParseInt(value, options.Repetitions) && options.Repetitions > 0);
+		} else if (std::strcmp(arg, "--json") == 0) {
+			jsonPath = value;
+		} else if (std::strcmp(arg, "--csv") == 0) {
+			csvPath = value;
+		} else if (std::strcmp(arg, "--compare") == 0) {
+			comparePath = value;
+		} else if (std::strcmp(arg, "--max-regression") == 0) {
+			isValid = (value != nullptr);
+			if (isValid) {
+				_maxRegression = std::atof(value);
+			}
+		} else if (std::strcmp(arg, "--list") == 0) {
+			listOnly = true;
+			usesValue = false;
+		} else if (std::strcmp(arg, "--cpu-features") == 0) {
+			// Kernel variants can be compared with each other by running the same benchmarks with different lists,
+			// so the list must be used exactly as specified, otherwise results of other kernels would be reported
+			Cpu::Features features;
+			if (value != nullptr) {
+				if (!CpuDispatch::ParseFeatures(value, features)) {
+					std::fprintf(stderr, "Invalid value \"%s\" of \"--cpu-features\", expected a comma-separated list of instruction sets\n", value);
+					return EXIT_FAILURE;
+				}
+				const Cpu::Features supportedFeatures = Cpu::runtimeFeatures();
+				if (!(supportedFeatures >= features)) {
+					for (StringView name : StringView(value).splitWithoutEmptyParts(',')) {
+						Cpu::Features feature;
+						if (CpuDispatch::ParseFeatures(name, feature) && !(supportedFeatures >= feature)) {
+							std::fprintf(stderr, "Instruction set \"%.*s\" of \"--cpu-features\" is not supported by this CPU\n", (int)name.trimmed().size(), name.trimmed().data());
+						}
+					}
+					return EXIT_FAILURE;
+				}
+				CpuDispatch::OverrideFeatures(features);
+			}
+		} else if (std::strcmp(arg, "--self-test") == 0) {
+			selfTestOnly = true;
+			usesValue = false;
+		} else if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0) {
+			PrintUsage(argv[0]);
+			return EXIT_SUCCESS;
+		} else {
+			std::fprintf(stderr, "Unknown option \"%s\"\n", arg);
+			isValid = false;
+			usesValue = false;
+		}
+
+		if (usesValue && value == nullptr) {
+			isValid = false;
+		}
+		if (!isValid) {
+			PrintUsage(argv[0]);
+			return EXIT_FAILURE;
+		}
+		if (usesValue) {
+			i++;
+		}
+	}
+
+	if (listOnly) {
+		Benchmarks::Runner::ForEach(options.Filter, PrintListEntry);
+		return EXIT_SUCCESS;
+	}
+
+	if (selfTestOnly) {
+		// Benchmarks are meaningful only if the measured code computes the expected results
+		const std::int32_t failedCount = Benchmarks::Runner::RunSelfTests(options.Filter, PrintSelfTestResult);
+		if (_matchCount == 0) {
+			std::fprintf(stderr, "No self-test matches the filter\n");
+			return EXIT_FAILURE;
+		}
+		std::printf("Self-test %s\n", failedCount == 0 ? "passed" : "failed");
+		return (failedCount == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+	}
+
+	Benchmarks::Runner::ForEach(options.Filter, CountMatch);
+	if (_matchCount == 0) {
+		std::fprintf(stderr, "No benchmark matches the filter\n");
+		return EXIT_FAILURE;
+	}
+
+	if (comparePath != nullptr && !LoadBaseline(comparePath)) {
+		return EXIT_FAILURE;
+	}
+
+	std::printf("CPU: %s, allocations tracked: %s, warmup: %d ms, repetitions: %d x %d ms\n\n",
+		CpuDispatch::GetFeatureName(CpuDispatch::GetFeatures()), Benchmarks::IsMallocTracked() ? "malloc + new" : "new only",
+		(int)options.WarmupMs, (int)options.Repetitions, (int)options.MinTimeMs);
+	PrintHeader();
+
+	std::unique_ptr<Benchmarks::Result[]> results = std::make_unique<Benchmarks::Result[]>(_matchCount);
+	const std::int32_t count = Benchmarks::Runner::Run(options, results.get(), _matchCount, PrintResult);
+#if defined(WITH_ALLOCATORS)
+	PrintAllocatorStatistics();
+#endif
+
+	bool success = true;
+	if (jsonPath != nullptr) {
+		success &= WriteJson(jsonPath, options, results.get(), count);
+	}
+	if (csvPath != nullptr) {
+		success &= WriteCsv(csvPath, results.get(), count);
+	}
+
+	if (_regressionCount > 0) {
+		std::fprintf(stderr, "%d benchmark(s) regressed more than %.1f%%\n", (int)_regressionCount, _maxRegression);
+		success = false;
+	}
+
+	return (success ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,77 @@
+#include "BenchmarkHarness.h"
+#include "../nCine/Primitives/Matrix4x4.h"
+
+using namespace nCine;
+
+namespace
+{
+	constexpr std::int32_t MatrixCount = 64;
+
+	struct MatrixData
+	{
+		Matrix4x4f A[MatrixCount];
+		Matrix4x4f B[MatrixCount];
+		Vector4f V[MatrixCount];
+
+		MatrixData()
+		{
+			// Transformations similar to the ones of scene nodes, so values stay in a realistic range
+			Benchmarks::Random random;
+			for (std::int32_t i = 0; i < MatrixCount; i++) {
+				A[i] = Matrix4x4f::Translation((float)random.Next(8192), (float)random.Next(8192), 0.0f);
+				A[i].RotateZ((float)random.Next(628) * 0.01f);
+				B[i] = Matrix4x4f::Translation((float)random.Next(64), (float)random.Next(64), 0.0f);
+				B[i].Scale(1.0f + (float)random.Next(100) * 0.01f, 1.0f + (float)random.Next(100) * 0.01f, 1.0f);
+				V[i] = Vector4f((float)random.Next(256), (float)random.Next(256), 0.0f, 1.0f);
+			}
+		}
+	};
+
+	template<class TTag>
+	void RunMultiplyMatrices(Benchmarks::State& state, TTag tag)
+	{
+		MatrixData data;
+		Matrix4x4f result;
+		state.ResetTimer();
+		for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+			const std::int32_t index = (std::int32_t)(i & (MatrixCount - 1));
+			SimdMath::MultiplyMatrices(tag, data.A[index].Data(), data.B[(index * 7) & (MatrixCount - 1)].Data(), result.Data());
+			Benchmarks::DoNotOptimize(result);
+		}
+		state.StopTimer();
+	}
+
+	template<class TTag>
+	void RunMultiplyMatrixVector(Benchmarks::State& state, TTag tag)
+	{
+		MatrixData data;
+		Vector4f result;
+		state.ResetTimer();
+		for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+			const std::int32_t index = (std::int32_t)(i & (MatrixCount - 1));
+			SimdMath::MultiplyMatrixVector(tag, data.A[index].Data(), data.V[(index * 7) & (MatrixCount - 1)].Data(), result.Data());
+			Benchmarks::DoNotOptimize(result);
+		}
+		state.StopTimer();
+	}
+}
+
+BENCHMARK(Matrix, MultiplyScalar)
+{
+	RunMultiplyMatrices(state, Death::Cpu::Scalar);
+}
+
+BENCHMARK(Matrix, MultiplyDefault)
+{
+	RunMultiplyMatrices(state, Death::Cpu::DefaultBase);
+}
+
+BENCHMARK(Matrix, MultiplyVectorScalar)
+{
+	RunMultiplyMatrixVector(state, Death::Cpu::Scalar);
+}
+
+BENCHMARK(Matrix, MultiplyVectorDefault)
+{
+	RunMultiplyMatrixVector(state, Death::Cpu::DefaultBase);
+}
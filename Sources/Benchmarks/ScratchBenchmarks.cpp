@@ -0,0 +1,113 @@
+#include "BenchmarkHarness.h"
+#include "../nCine/Base/ScratchArena.h"
+
+#include <cstdio>
+#include <cstring>
+
+using namespace Death::Containers;
+using namespace Death::Containers::Literals;
+using namespace nCine;
+
+namespace
+{
+	// The same size as `AppConfiguration::scratchArenaSize`
+	constexpr std::size_t ArenaSize = 512 * 1024;
+
+	// Label of the main menu when a newer version is available, it's longer than a small string
+	constexpr StringView VersionPrefix = "v1.0.0  › \f[c:0x9e7056]v"_s;
+	constexpr char NewestVersion[] = "1.0.1";
+
+	bool ExpectContents(const char* what, const ScratchString& actual, StringView expected)
+	{
+		if (actual.view() != expected || actual.data()[actual.size()] != '\0') {
+			std::fprintf(stderr, "Scratch/StringVectorMarker: %s contains \"%s\" instead of \"%.*s\"\n", what, actual.data(), (int)expected.size(), expected.data());
+			return false;
+		}
+		return true;
+	}
+}
+
+/// Label is concatenated to a heap string every frame, as the main menu did before
+BENCHMARK(Scratch, VersionLabelHeap)
+{
+	state.ResetTimer();
+
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		String label = VersionPrefix + NewestVersion;
+		Benchmarks::DoNotOptimize(label.data());
+	}
+	state.StopTimer();
+}
+
+/// Label is built in the scratch arena, which is reset at the end of each frame, as the main menu does now
+BENCHMARK(Scratch, VersionLabelArena)
+{
+	ScratchArena arena(ArenaSize);
+	state.ResetTimer();
+
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		ScratchString label(arena);
+		label += VersionPrefix;
+		label += NewestVersion;
+		Benchmarks::DoNotOptimize(label.data());
+		arena.reset();
+	}
+	state.StopTimer();
+}
+
+/// Contents of strings and vectors in the arena survive growth and overflow to the heap, markers release everything allocated after them
+SELF_TEST(Scratch, StringVectorMarker)
+{
+	// Small buffer, so growth of the containers overflows to the parent allocator
+	ScratchArena arena(256);
+
+	ScratchString empty(arena);
+	ScratchString label(arena, 4);
+	label += VersionPrefix;
+	label += NewestVersion;
+	if (!ExpectContents("Empty string", empty, ""_s) || !ExpectContents("Label", label, "v1.0.0  › \f[c:0x9e7056]v1.0.1"_s)) {
+		return false;
+	}
+
+	ScratchArena::Marker start = arena.marker();
+	{
+		ScopedScratchMarker scratchMarker(arena);
+
+		ScratchString formatted(arena);
+		char expected[1024];
+		std::size_t expectedLength = 0;
+		for (std::int32_t i = 0; i < 100; i++) {
+			formatted.appendFormat("%i:%s;", (int)i, NewestVersion);
+			expectedLength += (std::size_t)std::snprintf(expected + expectedLength, sizeof(expected) - expectedLength, "%i:%s;", (int)i, NewestVersion);
+		}
+		if (!ExpectContents("Formatted string", formatted, StringView(expected, expectedLength))) {
+			return false;
+		}
+
+		ScratchVector<std::int32_t> values(arena);
+		for (std::int32_t i = 0; i < 1000; i++) {
+			values.push_back(i * 3);
+		}
+		for (std::int32_t i = 0; i < 1000; i++) {
+			if (values[i] != i * 3) {
+				std::fprintf(stderr, "Scratch/StringVectorMarker: Vector item %i contains %i\n", (int)i, (int)values[i]);
+				return false;
+			}
+		}
+
+		if (arena.statistics().numOverflows == 0) {
+			std::fprintf(stderr, "Scratch/StringVectorMarker: Containers didn't overflow the buffer\n");
+			return false;
+		}
+	}
+
+	ScratchArena::Marker end = arena.marker();
+	if (end.offset != start.offset || end.overflowCount != start.overflowCount) {
+		std::fprintf(stderr, "Scratch/StringVectorMarker: Arena was rewound to %zu bytes and %zu overflows instead of %zu bytes and %zu overflows\n",
+			end.offset, end.overflowCount, start.offset, start.overflowCount);
+		return false;
+	}
+
+	// Allocations made before the marker are still valid
+	return ExpectContents("Label after rewind", label, "v1.0.0  › \f[c:0x9e7056]v1.0.1"_s);
+}
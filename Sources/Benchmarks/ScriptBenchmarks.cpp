@@ -0,0 +1,262 @@
+#if defined(WITH_ANGELSCRIPT)
+
+#include "BenchmarkHarness.h"
+#include "../nCine/Base/HashFunctions.h"
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+#include <angelscript.h>
+
+#include <Containers/SmallVector.h>
+
+using namespace Death::Containers;
+using namespace nCine;
+
+namespace
+{
+	// Number of generated classes and callbacks, the source has a size of a larger level script
+	constexpr std::int32_t ScriptFunctionCount = 128;
+	// Number of `onFunction` callbacks triggered by actors in a single frame of the level scenario
+	constexpr std::int32_t CallbacksPerFrame = 16;
+
+	/// Stream of bytecode in memory, so only (de)serialization is measured and not the file system
+	class MemoryBinaryStream : public asIBinaryStream
+	{
+	public:
+		MemoryBinaryStream()
+			: _position(0)
+		{
+		}
+
+		int Read(void* ptr, asUINT size) override
+		{
+			if (_position + size > _data.size()) {
+				return -1;
+			}
+			std::memcpy(ptr, _data.data() + _position, size);
+			_position += size;
+			return 0;
+		}
+
+		int Write(const void* ptr, asUINT size) override
+		{
+			const std::uint8_t* bytes = static_cast<const std::uint8_t*>(ptr);
+			_data.append(bytes, bytes + size);
+			return 0;
+		}
+
+		void Rewind()
+		{
+			_position = 0;
+		}
+
+		std::size_t GetSize() const
+		{
+			return _data.size();
+		}
+
+	private:
+		SmallVector<std::uint8_t, 0> _data;
+		std::size_t _position;
+	};
+
+	void AppendFormat(SmallVector<char, 0>& source, const char* format, ...)
+	{
+		char buffer[1024];
+		va_list args;
+		va_start(args, format);
+		std::int32_t length = std::vsnprintf(buffer, sizeof(buffer), format, args);
+		va_end(args);
+		if (length > 0) {
+			source.append(buffer, buffer + std::min(length, (std::int32_t)sizeof(buffer) - 1));
+		}
+	}
+
+	/// Creates a script with classes and `onFunction` callbacks, it uses only built-in types, because nothing is registered
+	SmallVector<char, 0> CreateScriptSource()
+	{
+		SmallVector<char, 0> source;
+		AppendFormat(source, "int counter = 0;\nvoid onMain() {\n\tcounter++;\n}\n");
+		for (std::int32_t i = 0; i < ScriptFunctionCount; i++) {
+			AppendFormat(source,
+				"class Actor%i {\n"
+				"\tfloat x, y, speedX, speedY;\n"
+				"\tint health = %i;\n"
+				"\tActor%i(float px, float py) { x = px; y = py; speedX = 0.5f; speedY = 0.0f; }\n"
+				"\tvoid update(float timeMult) {\n"
+				"\t\tspeedY += 0.25f * timeMult;\n"
+				"\t\tif (speedY > 4.0f) { speedY = 4.0f; }\n"
+				"\t\tx += speedX * timeMult;\n"
+				"\t\ty += speedY * timeMult;\n"
+				"\t\tfor (int j = 0; j < 4; j++) { if (health > j) { health--; } }\n"
+				"\t}\n"
+				"}\n"
+				"void onFunction%i(uint8 param) {\n"
+				"\tActor%i a(float(param), 0.0f);\n"
+				"\ta.update(1.0f);\n"
+				"\tcounter += a.health;\n"
+				"}\n", i, 1 + (i % 8), i, i, i);
+		}
+		return source;
+	}
+
+	asIScriptEngine* CreateEngine()
+	{
+		asIScriptEngine* engine = asCreateScriptEngine();
+		// Same as `ScriptLoader`, so the compiler takes the same paths
+		engine->SetEngineProperty(asEP_PROPERTY_ACCESSOR_MODE, 2);
+		engine->SetEngineProperty(asEP_COMPILER_WARNINGS, true);
+		engine->SetEngineProperty(asEP_BUILD_WITHOUT_LINE_CUES, true);
+		return engine;
+	}
+
+	asIScriptModule* BuildModule(asIScriptEngine* engine, const SmallVector<char, 0>& source)
+	{
+		asIScriptModule* module = engine->GetModule("Benchmark", asGM_ALWAYS_CREATE);
+		module->AddScriptSection("Benchmark.j2as", source.data(), source.size(), 0);
+		return (module->Build() >= 0 ? module : nullptr);
+	}
+
+	/// Callback with its optional byte parameter, as `LevelScriptLoader` stores it
+	struct LevelCallback
+	{
+		asIScriptFunction* Func;
+		std::int32_t ByteParamIdx;
+	};
+
+	std::int32_t FindByteParam(asIScriptFunction* func)
+	{
+		int typeId = 0;
+		if (func->GetParam(0, &typeId) >= 0 && (typeId == asTYPEID_BOOL || typeId == asTYPEID_INT8 || typeId == asTYPEID_UINT8)) {
+			return 0;
+		}
+		return -1;
+	}
+
+	void ExecuteCallback(asIScriptEngine* engine, const LevelCallback& callback, std::uint8_t param)
+	{
+		asIScriptContext* ctx = engine->RequestContext();
+		ctx->Prepare(callback.Func);
+		if (callback.ByteParamIdx >= 0) {
+			ctx->SetArgByte(callback.ByteParamIdx, param);
+		}
+		ctx->Execute();
+		engine->ReturnContext(ctx);
+	}
+
+	/// Level scenario, `onMain()` is called and then a few triggers are stepped on by actors, every frame
+	/*! The setup function is called once after the module is built, it's not included in the measurement. */
+	template<class TSetup, class TResolve>
+	void RunLevelFrames(Benchmarks::State& state, TSetup&& setup, TResolve&& resolve)
+	{
+		SmallVector<char, 0> source = CreateScriptSource();
+		asIScriptEngine* engine = CreateEngine();
+		asIScriptModule* module = BuildModule(engine, source);
+		if (module == nullptr) {
+			std::fprintf(stderr, "Script: Cannot build the script\n");
+			engine->ShutDownAndRelease();
+			return;
+		}
+
+		setup(module);
+		LevelCallback onMain = { module->GetFunctionByDecl("void onMain()"), -1 };
+		Benchmarks::Random random;
+		std::uint8_t triggers[CallbacksPerFrame];
+		for (std::int32_t i = 0; i < CallbacksPerFrame; i++) {
+			triggers[i] = (std::uint8_t)random.Next(ScriptFunctionCount);
+		}
+		state.ResetTimer();
+
+		for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+			ExecuteCallback(engine, onMain, 0);
+			for (std::int32_t j = 0; j < CallbacksPerFrame; j++) {
+				const LevelCallback& callback = resolve(module, triggers[j]);
+				if (callback.Func != nullptr) {
+					ExecuteCallback(engine, callback, (std::uint8_t)j);
+				}
+			}
+		}
+		state.StopTimer();
+
+		engine->ShutDownAndRelease();
+	}
+}
+
+/// Script is compiled from its (already preprocessed) source, as `ScriptLoader::Build()` does without a cached bytecode
+BENCHMARK(Script, LoadCold)
+{
+	SmallVector<char, 0> source = CreateScriptSource();
+	asIScriptEngine* engine = CreateEngine();
+	state.ResetTimer();
+
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		asIScriptModule* module = BuildModule(engine, source);
+		Benchmarks::DoNotOptimize(module);
+	}
+	state.StopTimer();
+
+	engine->ShutDownAndRelease();
+}
+
+/// Cache key is computed from the source and the module is loaded from bytecode, as `ScriptLoader::Build()` does with a cache hit
+BENCHMARK(Script, LoadWarm)
+{
+	SmallVector<char, 0> source = CreateScriptSource();
+	asIScriptEngine* engine = CreateEngine();
+	MemoryBinaryStream stream;
+	asIScriptModule* module = BuildModule(engine, source);
+	if (module == nullptr || module->SaveByteCode(&stream, false) < 0) {
+		std::fprintf(stderr, "Script/LoadWarm: Cannot build the script\n");
+		engine->ShutDownAndRelease();
+		return;
+	}
+	state.SetBytesPerIteration((std::int64_t)stream.GetSize());
+	state.ResetTimer();
+
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		std::uint64_t hash = fasthash64(source.data(), source.size(), 0);
+		Benchmarks::DoNotOptimize(hash);
+
+		stream.Rewind();
+		module = engine->GetModule("Benchmark", asGM_ALWAYS_CREATE);
+		std::int32_t r = module->LoadByteCode(&stream);
+		Benchmarks::DoNotOptimize(r);
+	}
+	state.StopTimer();
+
+	engine->ShutDownAndRelease();
+}
+
+/// Callbacks are looked up by name and their parameters are inspected on every call, as `LevelScriptLoader` did before
+BENCHMARK(Script, LevelFrameByName)
+{
+	LevelCallback callback;
+	RunLevelFrames(state, [](asIScriptModule* module) {}, [&callback](asIScriptModule* module, std::uint8_t index) -> const LevelCallback& {
+		char funcName[32];
+		std::snprintf(funcName, sizeof(funcName), "onFunction%i", (int)index);
+		callback.Func = module->GetFunctionByName(funcName);
+		callback.ByteParamIdx = (callback.Func != nullptr ? FindByteParam(callback.Func) : -1);
+		return callback;
+	});
+}
+
+/// Callbacks are resolved into a table once after the module is built, as `LevelScriptLoader::ResolveEntryPoints()` does
+BENCHMARK(Script, LevelFrameResolved)
+{
+	LevelCallback callbacks[ScriptFunctionCount];
+	RunLevelFrames(state, [&callbacks](asIScriptModule* module) {
+		char funcName[32];
+		for (std::int32_t i = 0; i < ScriptFunctionCount; i++) {
+			std::snprintf(funcName, sizeof(funcName), "onFunction%i", (int)i);
+			callbacks[i].Func = module->GetFunctionByName(funcName);
+			callbacks[i].ByteParamIdx = (callbacks[i].Func != nullptr ? FindByteParam(callbacks[i].Func) : -1);
+		}
+	}, [&callbacks](asIScriptModule* module, std::uint8_t index) -> const LevelCallback& {
+		return callbacks[index];
+	});
+}
+
+#endif
@@ -0,0 +1,116 @@
+#include "BenchmarkHarness.h"
+#include "../Jazz2/Tiles/TileSet.h"
+
+#include <cstdio>
+
+#include <Containers/SmallVector.h>
+
+using namespace Death::Containers;
+using namespace Jazz2::Tiles;
+using namespace nCine;
+
+namespace
+{
+	// Size of a larger tile set of the original game, 10 tiles per row
+	constexpr std::int32_t TilesPerRow = 10;
+	constexpr std::int32_t TileRows = 100;
+	constexpr std::int32_t Width = TilesPerRow * TileSet::DefaultTileSize;
+
+	enum class TileKind
+	{
+		Opaque,
+		OneTransparentPixel,
+		OneTranslucentPixel,
+		Empty,
+
+		Count
+	};
+
+	/// Tile set with palette indices in the red channel and alpha in the alpha channel, as `ContentResolver::RequestTileSet()` reads it
+	SmallVector<std::uint32_t, 0> CreateTileSet(Benchmarks::Random& random, std::int32_t rows, SmallVector<TileKind, 0>& kinds)
+	{
+		SmallVector<std::uint32_t, 0> pixels(Width * rows * TileSet::DefaultTileSize);
+		for (std::int32_t tile = 0; tile < TilesPerRow * rows; tile++) {
+			TileKind kind = (TileKind)random.Next((std::uint32_t)TileKind::Count);
+			kinds.push_back(kind);
+
+			std::uint32_t* tilePixels = &pixels[(tile / TilesPerRow) * TileSet::DefaultTileSize * Width + (tile % TilesPerRow) * TileSet::DefaultTileSize];
+			for (std::int32_t y = 0; y < TileSet::DefaultTileSize; y++) {
+				for (std::int32_t x = 0; x < TileSet::DefaultTileSize; x++) {
+					// Index 0 is always transparent, other indices are opaque
+					tilePixels[y * Width + x] = (kind == TileKind::Empty ? 0 : (1 + random.Next(255)) | 0xff000000u);
+				}
+			}
+
+			// Corners and edges are chosen more often, so a wrong stride or row count is detected
+			std::int32_t x = (random.Next(2) == 0 ? (std::int32_t)random.Next(2) * (TileSet::DefaultTileSize - 1) : (std::int32_t)random.Next(TileSet::DefaultTileSize));
+			std::int32_t y = (random.Next(2) == 0 ? (std::int32_t)random.Next(2) * (TileSet::DefaultTileSize - 1) : (std::int32_t)random.Next(TileSet::DefaultTileSize));
+			if (kind == TileKind::OneTransparentPixel) {
+				tilePixels[y * Width + x] = 0;
+			} else if (kind == TileKind::OneTranslucentPixel) {
+				tilePixels[y * Width + x] = (tilePixels[y * Width + x] & 0xff) | 0xfe000000u;
+			}
+		}
+		return pixels;
+	}
+
+	void CreateOpaquePalette(std::uint32_t* palette)
+	{
+		Benchmarks::Random random;
+		for (std::int32_t i = 0; i < 256; i++) {
+			palette[i] = (std::uint32_t)random.Next(0x01000000) | 0xff000000u;
+		}
+	}
+}
+
+/// Tiles of a whole tile set are classified, as `TileSet` does when a level is loaded
+BENCHMARK(TileSet, ClassifyOpaque)
+{
+	Benchmarks::Random random;
+	SmallVector<TileKind, 0> kinds;
+	SmallVector<std::uint32_t, 0> pixels = CreateTileSet(random, TileRows, kinds);
+	std::uint32_t palette[256];
+	CreateOpaquePalette(palette);
+	CpuDispatch::ExpandPaletteInPlace(pixels.data(), (std::int32_t)pixels.size(), palette);
+	state.SetBytesPerIteration((std::int64_t)pixels.size() * sizeof(std::uint32_t));
+	state.ResetTimer();
+
+	for (std::int64_t i = 0; i < state.GetIterations(); i++) {
+		std::int32_t opaqueCount = 0;
+		for (std::int32_t tile = 0; tile < TilesPerRow * TileRows; tile++) {
+			const std::uint32_t* tilePixels = &pixels[(tile / TilesPerRow) * TileSet::DefaultTileSize * Width + (tile % TilesPerRow) * TileSet::DefaultTileSize];
+			opaqueCount += (TileSet::AreAllPixelsOpaque(tilePixels, Width) ? 1 : 0);
+		}
+		Benchmarks::DoNotOptimize(opaqueCount);
+	}
+	state.StopTimer();
+}
+
+/// Only tiles without any transparent or translucent pixel are classified as opaque after the palette is applied
+SELF_TEST(TileSet, OpaqueClassification)
+{
+	Benchmarks::Random random;
+	std::uint32_t palette[256];
+	CreateOpaquePalette(palette);
+
+	for (std::int32_t run = 0; run < 20; run++) {
+		SmallVector<TileKind, 0> kinds;
+		SmallVector<std::uint32_t, 0> pixels = CreateTileSet(random, 4, kinds);
+		CpuDispatch::ExpandPaletteInPlace(pixels.data(), (std::int32_t)pixels.size(), palette);
+
+		for (std::int32_t tile = 0; tile < (std::int32_t)kinds.size(); tile++) {
+			const std::uint32_t* tilePixels = &pixels[(tile / TilesPerRow) * TileSet::DefaultTileSize * Width + (tile % TilesPerRow) * TileSet::DefaultTileSize];
+			bool isOpaque = TileSet::AreAllPixelsOpaque(tilePixels, Width);
+			if (isOpaque != (kinds[tile] == TileKind::Opaque)) {
+				std::fprintf(stderr, "TileSet/OpaqueClassification: Tile %i of kind %i was classified as %s\n", (int)tile, (int)kinds[tile], isOpaque ? "opaque" : "not opaque");
+				return false;
+			}
+		}
+	}
+
+	// Opaque pixels with a translucent palette entry make the tile translucent too
+	SmallVector<std::uint32_t, 0> pixels(Width * TileSet::DefaultTileSize, 5 | 0xff000000u);
+	palette[5] &= 0x80ffffffu;
+	CpuDispatch::ExpandPaletteInPlace(pixels.data(), (std::int32_t)pixels.size(), palette);
+	return !TileSet::AreAllPixelsOpaque(pixels.data(), Width);
+}
@@ -413,20 +413,25 @@ namespace Jazz2::Actors
 		}
 	}
 
-	void ActorBase::CreateSpriteDebris(const StringView& identifier, int count)
+	void ActorBase::CreateSpriteDebris(Atom identifier, int count)
 	{
 		auto tilemap = _levelHandler->TileMap();
 		if (tilemap != nullptr && _metadata != nullptr) {
-			auto it = _metadata->Graphics.find(String::nullTerminatedView(identifier));
+			auto it = _metadata->Graphics.find(identifier);
 			if (it != _metadata->Graphics.end()) {
 				tilemap->CreateSpriteDebris(&it->second, Vector3f(_pos.X, _pos.Y, (float)_renderer.layer()), count);
 			}
 		}
 	}
 
-	std::shared_ptr<AudioBufferPlayer> ActorBase::PlaySfx(const StringView& identifier, float gain, float pitch)
+	void ActorBase::CreateSpriteDebris(const StringView& identifier, int count)
 	{
-		auto it = _metadata->Sounds.find(String::nullTerminatedView(identifier));
+		CreateSpriteDebris(Atom::find(identifier), count);
+	}
+
+	std::shared_ptr<AudioBufferPlayer> ActorBase::PlaySfx(Atom identifier, float gain, float pitch)
+	{
+		auto it = _metadata->Sounds.find(identifier);
 		if (it != _metadata->Sounds.end()) {
 			int idx = (it->second.Buffers.size() > 1 ? Random().Next(0, (int)it->second.Buffers.size()) : 0);
 			return _levelHandler->PlaySfx(it->second.Buffers[idx].get(), Vector3f(_pos.X, _pos.Y, 0.0f), false, gain, pitch);
@@ -435,16 +440,21 @@ namespace Jazz2::Actors
 		}
 	}
 
-	void ActorBase::SetAnimation(const StringView& identifier)
+	std::shared_ptr<AudioBufferPlayer> ActorBase::PlaySfx(const StringView& identifier, float gain, float pitch)
+	{
+		return PlaySfx(Atom::find(identifier), gain, pitch);
+	}
+
+	void ActorBase::SetAnimation(Atom identifier)
 	{
 		if (_metadata == nullptr) {
 			LOGE("No metadata loaded");
 			return;
 		}
 
-		auto it = _metadata->Graphics.find(String::nullTerminatedView(identifier));
+		auto it = _metadata->Graphics.find(identifier);
 		if (it == _metadata->Graphics.end()) {
-			LOGE_X("No animation found for \"%s\"", identifier.data());
+			LOGE_X("No animation found for \"%s\" (0x%08x)", String::nullTerminatedView(identifier.str()).data(), identifier.hash());
 			return;
 		}
 
@@ -454,6 +464,22 @@ namespace Jazz2::Actors
 		RefreshAnimation();
 	}
 
+	void ActorBase::SetAnimation(const StringView& identifier)
+	{
+		if (_metadata == nullptr) {
+			LOGE("No metadata loaded");
+			return;
+		}
+
+		Atom atom = Atom::find(identifier);
+		if (atom.empty()) {
+			LOGE_X("No animation found for \"%s\"", String::nullTerminatedView(identifier).data());
+			return;
+		}
+
+		SetAnimation(atom);
+	}
+
 	bool ActorBase::SetAnimation(AnimState state)
 	{
 		if (_metadata == nullptr) {
@@ -496,13 +522,13 @@ namespace Jazz2::Actors
 		return true;
 	}
 
-	bool ActorBase::SetTransition(const StringView& identifier, bool cancellable, const std::function<void()>& callback)
+	bool ActorBase::SetTransition(Atom identifier, bool cancellable, const std::function<void()>& callback)
 	{
 		if (_metadata == nullptr) {
 			return false;
 		}
 
-		auto it = _metadata->Graphics.find(String::nullTerminatedView(identifier));
+		auto it = _metadata->Graphics.find(identifier);
 		if (it == _metadata->Graphics.end()) {
 			if (callback != nullptr) {
 				callback();
@@ -526,6 +552,11 @@ namespace Jazz2::Actors
 		return true;
 	}
 
+	bool ActorBase::SetTransition(const StringView& identifier, bool cancellable, const std::function<void()>& callback)
+	{
+		return SetTransition(Atom::find(identifier), cancellable, callback);
+	}
+
 	bool ActorBase::SetTransition(AnimState state, bool cancellable, const std::function<void()>& callback)
 	{
 		AnimationCandidate candidates[AnimationCandidatesCount];
@@ -1059,6 +1090,7 @@ namespace Jazz2::Actors
 			return;
 		}
 
+		_renderer.TextureOffset = res->Base->TextureOffset;
 		_renderer.FrameConfiguration = res->Base->FrameConfiguration;
 		_renderer.FrameDimensions = res->Base->FrameDimensions;
 		if (res->AnimDuration < 0.0f) {
@@ -1107,7 +1139,7 @@ namespace Jazz2::Actors
 			}
 
 			if (it->second.HasState(state)) {
-				candidates[i].Identifier = &it->first;
+				candidates[i].Identifier = it->first;
 				candidates[i].Resource = &it->second;
 				i++;
 			}
@@ -1366,7 +1398,7 @@ namespace Jazz2::Actors
 		// Set current animation frame rectangle
 		int col = CurrentFrame % FrameConfiguration.X;
 		int row = CurrentFrame / FrameConfiguration.X;
-		setTexRect(Recti(FrameDimensions.X * col, FrameDimensions.Y * row, FrameDimensions.X, FrameDimensions.Y));
+		setTexRect(Recti(TextureOffset.X + FrameDimensions.X * col, TextureOffset.Y + FrameDimensions.Y * row, FrameDimensions.X, FrameDimensions.Y));
 		setAbsAnchorPoint((float)Hotspot.X, (float)Hotspot.Y);
 	}
 
@@ -172,7 +172,7 @@ namespace Jazz2::Actors
 
 	protected:
 		struct AnimationCandidate {
-			const String* Identifier;
+			Atom Identifier;
 			GraphicResource* Resource;
 		};
 
@@ -184,7 +184,7 @@ namespace Jazz2::Actors
 			ActorRenderer(ActorBase* owner)
 				:
 				BaseSprite(nullptr, nullptr, 0.0f, 0.0f), AnimPaused(false),
-				FrameConfiguration(), FrameDimensions(), LoopMode(AnimationLoopMode::Loop),
+				TextureOffset(), FrameConfiguration(), FrameDimensions(), LoopMode(AnimationLoopMode::Loop),
 				FirstFrame(0), FrameCount(0), AnimDuration(0.0f), AnimTime(0.0f), CurrentFrame(0), Hotspot(),
 				_owner(owner), _rendererType((ActorRendererType)-1), _rendererTransition(0.0f)
 			{
@@ -194,6 +194,7 @@ namespace Jazz2::Actors
 
 			bool AnimPaused;
 
+			Vector2i TextureOffset;
 			Vector2i FrameConfiguration;
 			Vector2i FrameDimensions;
 			AnimationLoopMode LoopMode;
@@ -275,11 +276,15 @@ namespace Jazz2::Actors
 		void HandleFrozenStateChange(ActorBase* shot);
 
 		void CreateParticleDebris();
+		void CreateSpriteDebris(Atom identifier, int count);
 		void CreateSpriteDebris(const StringView& identifier, int count);
 
+		std::shared_ptr<AudioBufferPlayer> PlaySfx(Atom identifier, float gain = 1.0f, float pitch = 1.0f);
 		std::shared_ptr<AudioBufferPlayer> PlaySfx(const StringView& identifier, float gain = 1.0f, float pitch = 1.0f);
+		void SetAnimation(Atom identifier);
 		void SetAnimation(const StringView& identifier);
 		bool SetAnimation(AnimState state);
+		bool SetTransition(Atom identifier, bool cancellable, const std::function<void()>& callback = []() { });
 		bool SetTransition(const StringView& identifier, bool cancellable, const std::function<void()>& callback = []() { });
 		bool SetTransition(AnimState state, bool cancellable, const std::function<void()>& callback = []() { });
 		void CancelTransition();
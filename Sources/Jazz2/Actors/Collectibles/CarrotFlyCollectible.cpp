@@ -15,7 +15,7 @@ namespace Jazz2::Actors::Collectibles
 
 		async_await RequestMetadataAsync("Collectible/CarrotFly"_s);
 
-		SetAnimation("Carrot"_s);
+		SetAnimation("Carrot"_atom);
 		SetFacingDirection();
 
 		async_return true;
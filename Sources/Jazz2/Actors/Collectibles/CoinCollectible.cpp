@@ -22,12 +22,12 @@ namespace Jazz2::Actors::Collectibles
 			case 0: // Silver
 				_coinValue = 1;
 				_scoreValue = 500;
-				SetAnimation("CoinSilver"_s);
+				SetAnimation("CoinSilver"_atom);
 				break;
 			case 1: // Gold
 				_coinValue = 5;
 				_scoreValue = 1000;
-				SetAnimation("CoinGold"_s);
+				SetAnimation("CoinGold"_atom);
 				break;
 		}
 
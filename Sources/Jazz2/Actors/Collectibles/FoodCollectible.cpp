@@ -109,7 +109,7 @@ namespace Jazz2::Actors::Collectibles
 				break;
 		}
 
-		SetAnimation("Food"_s);
+		SetAnimation("Food"_atom);
 		SetFacingDirection();
 
 		async_return true;
@@ -21,19 +21,19 @@ namespace Jazz2::Actors::Collectibles
 			default:
 			case 0: // Red (+1)
 				_scoreValue = 100;
-				SetAnimation("GemRed"_s);
+				SetAnimation("GemRed"_atom);
 				break;
 			case 1: // Green (+5)
 				_scoreValue = 500;
-				SetAnimation("GemGreen"_s);
+				SetAnimation("GemGreen"_atom);
 				break;
 			case 2: // Blue (+10)
 				_scoreValue = 1000;
-				SetAnimation("GemBlue"_s);
+				SetAnimation("GemBlue"_atom);
 				break;
 			case 3: // Purple
 				_scoreValue = 100;
-				SetAnimation("GemPurple"_s);
+				SetAnimation("GemPurple"_atom);
 				break;
 		}
 
@@ -25,7 +25,7 @@ namespace Jazz2::Actors::Collectibles
 
 		async_await RequestMetadataAsync("Object/GemGiant"_s);
 
-		SetAnimation("GemGiant"_s);
+		SetAnimation("GemGiant"_atom);
 
 		_renderer.setAlphaF(0.7f);
 
@@ -57,7 +57,7 @@ namespace Jazz2::Actors::Collectibles
 	{
 		CreateParticleDebris();
 
-		PlaySfx("Break"_s);
+		PlaySfx("Break"_atom);
 
 		for (int i = 0; i < 10; i++) {
 			float fx = Random().NextFloat(-16.0f, 16.0f);
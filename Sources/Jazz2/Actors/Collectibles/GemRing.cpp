@@ -93,7 +93,7 @@ namespace Jazz2::Actors::Collectibles
 	bool GemRing::OnDraw(RenderQueue& renderQueue)
 	{
 		if (!_pieces.empty()) {
-			auto it = _metadata->Graphics.find(String::nullTerminatedView("GemRed"_s));
+			auto it = _metadata->Graphics.find("GemRed"_atom);
 			if (it != _metadata->Graphics.end()) {
 				auto& chainAnim = it->second;
 				Vector2i texSize = chainAnim.Base->TextureDiffuse->size();
@@ -105,14 +105,13 @@ namespace Jazz2::Actors::Collectibles
 					int col = curAnimFrame % chainAnim.Base->FrameConfiguration.X;
 					int row = curAnimFrame / chainAnim.Base->FrameConfiguration.X;
 					float texScaleX = (float(chainAnim.Base->FrameDimensions.X) / float(texSize.X));
-					float texBiasX = (float(chainAnim.Base->FrameDimensions.X * col) / float(texSize.X));
+					float texBiasX = (float(chainAnim.Base->TextureOffset.X + chainAnim.Base->FrameDimensions.X * col) / float(texSize.X));
 					float texScaleY = (float(chainAnim.Base->FrameDimensions.Y) / float(texSize.Y));
-					float texBiasY = (float(chainAnim.Base->FrameDimensions.Y * row) / float(texSize.Y));
+					float texBiasY = (float(chainAnim.Base->TextureOffset.Y + chainAnim.Base->FrameDimensions.Y * row) / float(texSize.Y));
 
-					auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-					instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(texScaleX, texBiasX, texScaleY, texBiasY);
-					instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(chainAnim.Base->FrameDimensions.X * _pieces[i].Scale, chainAnim.Base->FrameDimensions.Y * _pieces[i].Scale);
-					instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf(1.0f, 1.0f, 1.0f, 0.7f).Data());
+					command->material().setInstanceTexRect(texScaleX, texBiasX, texScaleY, texBiasY);
+					command->material().setInstanceSpriteSize(chainAnim.Base->FrameDimensions.X * _pieces[i].Scale, chainAnim.Base->FrameDimensions.Y * _pieces[i].Scale);
+					command->material().setInstanceColor(Colorf(1.0f, 1.0f, 1.0f, 0.7f).Data());
 
 					auto& pos = _pieces[i].Pos;
 					command->setTransformation(Matrix4x4f::Translation(pos.X, pos.Y, 0.0f).RotateZ(_pieces[i].Angle));
@@ -13,7 +13,7 @@ namespace Jazz2::Actors::Collectibles
 
 		async_await RequestMetadataAsync("Collectible/Stopwatch"_s);
 
-		SetAnimation("Stopwatch"_s);
+		SetAnimation("Stopwatch"_atom);
 		SetFacingDirection();
 
 		async_return true;
@@ -66,7 +66,7 @@ namespace Jazz2::Actors::Enemies
 					_noiseCooldown -= timeMult;
 				} else {
 					_noiseCooldown = 60.0f;
-					PlaySfx("Noise"_s);
+					PlaySfx("Noise"_atom);
 				}
 			} else {
 				if (_currentTransitionState != AnimState::Idle) {
@@ -77,7 +77,7 @@ namespace Jazz2::Actors::Bosses
 				if (_stateTime <= 0.0f) {
 					_state = StateTransition;
 					SetTransition((AnimState)1073741826, false, [this]() {
-						PlaySfx("ThrowFireball"_s);
+						PlaySfx("ThrowFireball"_atom);
 
 						std::shared_ptr<Fireball> fireball = std::make_shared<Fireball>();
 						uint8_t fireballParams[2] = { _theme, (uint8_t)(IsFacingLeft() ? 1 : 0) };
@@ -100,7 +100,7 @@ namespace Jazz2::Actors::Bosses
 				if (_stateTime <= 0.0f) {
 					SetState(ActorState::CanBeFrozen, false);
 
-					PlaySfx("Disappear"_s, 0.8f);
+					PlaySfx("Disappear"_atom, 0.8f);
 
 					_state = StateTransition;
 					SetTransition((AnimState)1073741825, false, [this]() {
@@ -175,7 +175,7 @@ namespace Jazz2::Actors::Bosses
 			_stateTime = 30.0f;
 		});
 
-		PlaySfx("Appear"_s, 0.8f);
+		PlaySfx("Appear"_atom, 0.8f);
 	}
 
 	Task<bool> Bilsy::Fireball::OnActivatedAsync(const ActorActivationDetails& details)
@@ -205,7 +205,7 @@ namespace Jazz2::Actors::Bosses
 
 		SetAnimation((AnimState)1073741828);
 
-		PlaySfx("FireStart"_s);
+		PlaySfx("FireStart"_atom);
 
 		async_return true;
 	}
@@ -131,7 +131,7 @@ namespace Jazz2::Actors::Bosses
 					_stateTime = 20.0f;
 					_rocketsLeft = 5;
 
-					PlaySfx("PreAttack"_s);
+					PlaySfx("PreAttack"_atom);
 				}
 				break;
 			}
@@ -144,12 +144,12 @@ namespace Jazz2::Actors::Bosses
 						FireRocket();
 						_rocketsLeft--;
 
-						PlaySfx("Attack"_s);
+						PlaySfx("Attack"_atom);
 					} else {
 						_state = StateNewDirection;
 						_stateTime = 100.0f;
 
-						PlaySfx("PostAttack"_s);
+						PlaySfx("PostAttack"_atom);
 					}
 				}
 				break;
@@ -180,7 +180,7 @@ namespace Jazz2::Actors::Bosses
 			_noiseCooldown -= timeMult;
 		} else {
 			_noiseCooldown = 120.0f;
-			PlaySfx("Noise"_s, 0.2f);
+			PlaySfx("Noise"_atom, 0.2f);
 		}
 
 		_stateTime -= timeMult;
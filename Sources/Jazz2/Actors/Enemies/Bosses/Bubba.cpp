@@ -78,7 +78,7 @@ namespace Jazz2::Actors::Bosses
 						bool spewFileball = (rand < 0.35f);
 						bool tornado = (rand < 0.65f);
 						if (spewFileball) {
-							PlaySfx("Sneeze"_s);
+							PlaySfx("Sneeze"_atom);
 
 							SetTransition(AnimState::Shoot, false, [this]() {
 								float x = (IsFacingLeft() ? -16.0f : 16.0f);
@@ -195,7 +195,7 @@ namespace Jazz2::Actors::Bosses
 
 			_internalForceY = -1.27f;
 
-			PlaySfx("Jump"_s);
+			PlaySfx("Jump"_atom);
 
 			SetTransition((AnimState)1073741825, false);
 			SetAnimation(AnimState::Jump);
@@ -224,7 +224,7 @@ namespace Jazz2::Actors::Bosses
 
 			Vector2f diff = (targetPos - _pos);
 
-			_tornadoNoise = PlaySfx("Tornado"_s);
+			_tornadoNoise = PlaySfx("Tornado"_atom);
 			SetTransition((AnimState)1073741830, false, [this, diff]() {
 				_speed.X = (diff.X / _stateTime);
 				_speed.Y = (diff.Y / _stateTime);
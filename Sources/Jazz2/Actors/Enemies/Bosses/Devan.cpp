@@ -181,7 +181,7 @@ namespace Jazz2::Actors::Bosses
 			case StateDemonSpewingFireball: {
 				_state = StateTransition;
 				SetTransition((AnimState)673, false, [this]() {
-					PlaySfx("SpitFireball"_s);
+					PlaySfx("SpitFireball"_atom);
 
 					std::shared_ptr<Fireball> fireball = std::make_shared<Fireball>();
 					uint8_t fireballParams[1] = { (uint8_t)(IsFacingLeft() ? 1 : 0) };
@@ -318,7 +318,7 @@ namespace Jazz2::Actors::Bosses
 
 	void Devan::Shoot()
 	{
-		PlaySfx("Shoot"_s);
+		PlaySfx("Shoot"_atom);
 
 		SetTransition((AnimState)16, false, [this]() {
 			std::shared_ptr<Bullet> bullet = std::make_shared<Bullet>();
@@ -390,19 +390,19 @@ namespace Jazz2::Actors::Bosses
 
 	void Devan::Bullet::OnHitFloor(float timeMult)
 	{
-		PlaySfx("WallPoof"_s);
+		PlaySfx("WallPoof"_atom);
 		DecreaseHealth(INT32_MAX);
 	}
 
 	void Devan::Bullet::OnHitWall(float timeMult)
 	{
-		PlaySfx("WallPoof"_s);
+		PlaySfx("WallPoof"_atom);
 		DecreaseHealth(INT32_MAX);
 	}
 
 	void Devan::Bullet::OnHitCeiling(float timeMult)
 	{
-		PlaySfx("WallPoof"_s);
+		PlaySfx("WallPoof"_atom);
 		DecreaseHealth(INT32_MAX);
 	}
 
@@ -443,7 +443,7 @@ namespace Jazz2::Actors::Bosses
 	{
 		Explosion::Create(_levelHandler, Vector3i((int)(_pos.X + _speed.X), (int)(_pos.Y + _speed.Y), _renderer.layer() + 2), Explosion::Type::SmallDark);
 
-		PlaySfx("Flap"_s);
+		PlaySfx("Flap"_atom);
 
 		return EnemyBase::OnPerish(collider);
 	}
@@ -89,7 +89,7 @@ namespace Jazz2::Actors::Bosses
 				StringView text = _levelHandler->GetLevelText(_endText, -1, '|');
 				_levelHandler->ShowLevelText(text);
 
-				PlaySfx("WarpOut"_s);
+				PlaySfx("WarpOut"_atom);
 				SetTransition(AnimState::TransitionWarpOut, false, [this]() {
 					_renderer.setDrawEnabled(false);
 					DecreaseHealth(INT32_MAX);
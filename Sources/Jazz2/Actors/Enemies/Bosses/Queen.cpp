@@ -108,7 +108,7 @@ namespace Jazz2::Actors::Bosses
 					SetState(ActorState::IsInvulnerable, false);
 
 					_state = StateScreaming;
-					PlaySfx("Scream"_s);
+					PlaySfx("Scream"_atom);
 					SetTransition((AnimState)1073741824, false, [this]() {
 						_state = (Random().NextFloat() < 0.8f ? StateIdleToStomp : StateIdleToBackstep);
 						_stateTime = Random().NextFloat(65.0f, 85.0f);
@@ -127,7 +127,7 @@ namespace Jazz2::Actors::Bosses
 				if (_stateTime <= 0.0f) {
 					_state = StateTransition;
 					SetTransition((AnimState)1073741825, false, [this]() {
-						PlaySfx("Stomp"_s);
+						PlaySfx("Stomp"_atom);
 
 						SetTransition((AnimState)1073741830, false, [this]() {
 							_state = StateIdleToBackstep;
@@ -247,7 +247,7 @@ namespace Jazz2::Actors::Bosses
 				SetState(ActorState::CanJump, false);
 
 				SetAnimation(AnimState::Fall);
-				PlaySfx("Spring"_s);
+				PlaySfx("Spring"_atom);
 
 				if (_state != StateDead) {
 					StringView text = _levelHandler->GetLevelText(_endText);
@@ -272,7 +272,7 @@ namespace Jazz2::Actors::Bosses
 		async_await RequestMetadataAsync("Boss/Queen"_s);
 		SetAnimation((AnimState)1073741829);
 
-		PlaySfx("BrickFalling"_s, 0.3f);
+		PlaySfx("BrickFalling"_atom, 0.3f);
 
 		async_return true;
 	}
@@ -91,7 +91,7 @@ namespace Jazz2::Actors::Bosses
 					_speed.X = 0.0f;
 
 					_state = StateTransition;
-					PlaySfx("AttackStart"_s);
+					PlaySfx("AttackStart"_atom);
 					SetAnimation(AnimState::Idle);
 					SetTransition((AnimState)1073741824, false, [this]() {
 						_shots = Random().Next(1, 4);
@@ -116,27 +116,27 @@ namespace Jazz2::Actors::Bosses
 	{
 		EnemyBase::OnHealthChanged(collider);
 
-		constexpr StringView Shrapnels[] = {
-			"Shrapnel1"_s, "Shrapnel2"_s, "Shrapnel3"_s,
-			"Shrapnel4"_s, "Shrapnel5"_s, "Shrapnel6"_s,
-			"Shrapnel7"_s, "Shrapnel8"_s, "Shrapnel9"_s
+		constexpr Atom Shrapnels[] = {
+			"Shrapnel1"_atom, "Shrapnel2"_atom, "Shrapnel3"_atom,
+			"Shrapnel4"_atom, "Shrapnel5"_atom, "Shrapnel6"_atom,
+			"Shrapnel7"_atom, "Shrapnel8"_atom, "Shrapnel9"_atom
 		};
 		int n = Random().Next(1, 4);
 		for (int i = 0; i < n; i++) {
 			CreateSpriteDebris(Shrapnels[Random().Fast(0, countof(Shrapnels))], 1);
 		}
 
-		PlaySfx("Shrapnel"_s);
+		PlaySfx("Shrapnel"_atom);
 	}
 
 	bool Robot::OnPerish(ActorBase* collider)
 	{
 		CreateParticleDebris();
 
-		constexpr StringView Shrapnels[] = {
-			"Shrapnel1"_s, "Shrapnel2"_s, "Shrapnel3"_s,
-			"Shrapnel4"_s, "Shrapnel5"_s, "Shrapnel6"_s,
-			"Shrapnel7"_s, "Shrapnel8"_s, "Shrapnel9"_s
+		constexpr Atom Shrapnels[] = {
+			"Shrapnel1"_atom, "Shrapnel2"_atom, "Shrapnel3"_atom,
+			"Shrapnel4"_atom, "Shrapnel5"_atom, "Shrapnel6"_atom,
+			"Shrapnel7"_atom, "Shrapnel8"_atom, "Shrapnel9"_atom
 		};
 		for (int i = 0; i < 8; i++) {
 			CreateSpriteDebris(Shrapnels[Random().Fast(0, countof(Shrapnels))], 1);
@@ -171,7 +171,7 @@ namespace Jazz2::Actors::Bosses
 			_speed.X = (IsFacingLeft() ? -3.0f : 3.0f) * mult;
 			_renderer.AnimDuration = _currentAnimation->AnimDuration / mult;
 
-			PlaySfx("Run"_s);
+			PlaySfx("Run"_atom);
 			SetAnimation(AnimState::Run);
 		}
 	}
@@ -193,10 +193,10 @@ namespace Jazz2::Actors::Bosses
 
 		_shots--;
 
-		PlaySfx("Attack"_s);
+		PlaySfx("Attack"_atom);
 		SetTransition((AnimState)1073741825, false, [this]() {
 			if (_shots > 0) {
-				PlaySfx("AttackShutter"_s);
+				PlaySfx("AttackShutter"_atom);
 				Shoot();
 			} else {
 				Run();
@@ -210,7 +210,7 @@ namespace Jazz2::Actors::Bosses
 			return;
 		}
 
-		PlaySfx("AttackEnd"_s);
+		PlaySfx("AttackEnd"_atom);
 		SetTransition((AnimState)1073741826, false, [this]() {
 			_state = StatePreparingToRun;
 			_stateTime = 10.0f;
@@ -88,7 +88,7 @@ namespace Jazz2::Actors::Bosses
 		switch (_state) {
 			case StateOpen: {
 				if (_stateTime <= 0.0f) {
-					PlaySfx("Closing"_s);
+					PlaySfx("Closing"_atom);
 
 					_state = StateTransition;
 					SetAnimation((AnimState)1073741825);
@@ -121,7 +121,7 @@ namespace Jazz2::Actors::Bosses
 
 			case StateClosed: {
 				if (_stateTime <= 0.0f) {
-					PlaySfx("Opening"_s);
+					PlaySfx("Opening"_atom);
 
 					_state = StateTransition;
 					SetAnimation(AnimState::Idle);
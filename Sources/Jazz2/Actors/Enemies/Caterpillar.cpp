@@ -129,7 +129,7 @@ namespace Jazz2::Actors::Enemies
 		_time = 500.0f;
 
 		async_await RequestMetadataAsync("Enemy/Caterpillar"_s);
-		SetAnimation("Smoke"_s);
+		SetAnimation("Smoke"_atom);
 
 		async_return true;
 	}
@@ -154,7 +154,7 @@ namespace Jazz2::Actors::Enemies
 		if (auto player = dynamic_cast<Player*>(other.get())) {
 			if (player->SetDizzyTime(180.0f)) {
 				// TODO: Add fade-out
-				PlaySfx("Dizzy"_s);
+				PlaySfx("Dizzy"_atom);
 			}
 		}
 
@@ -68,14 +68,14 @@ namespace Jazz2::Actors::Enemies
 
 			if (_noiseCooldown <= 0.0f) {
 				_noiseCooldown = Random().NextFloat(60, 160);
-				PlaySfx("Noise"_s, 0.3f);
+				PlaySfx("Noise"_atom, 0.3f);
 			} else {
 				_noiseCooldown -= timeMult;
 			}
 
 			if (_stepCooldown <= 0.0f) {
 				_stepCooldown = Random().NextFloat(7, 10);
-				PlaySfx("Step"_s, 0.08f);
+				PlaySfx("Step"_atom, 0.08f);
 			} else {
 				_stepCooldown -= timeMult;
 			}
@@ -75,7 +75,7 @@ namespace Jazz2::Actors::Enemies
 
 			if (_noiseCooldown <= 0.0f) {
 				_noiseCooldown = Random().NextFloat(100, 300);
-				PlaySfx("Noise"_s, 0.4f);
+				PlaySfx("Noise"_atom, 0.4f);
 			} else {
 				_noiseCooldown -= timeMult;
 			}
@@ -84,7 +84,7 @@ namespace Jazz2::Actors::Enemies
 
 			if (_noiseCooldown <= 0.0f) {
 				_noiseCooldown = Random().NextFloat(25, 40);
-				PlaySfx("Woof"_s);
+				PlaySfx("Woof"_atom);
 			} else {
 				_noiseCooldown -= timeMult;
 			}
@@ -123,7 +123,7 @@ namespace Jazz2::Actors::Enemies
 
 			if (dynamic_cast<Weapons::FreezerShot*>(shotBase) == nullptr) {
 				if (_attackTime <= 0.0f) {
-					PlaySfx("Attack");
+					PlaySfx("Attack"_atom);
 					_speed.X = (IsFacingLeft() ? -1.0f : 1.0f) * _attackSpeed;
 					SetAnimation(AnimState::TransitionAttack);
 				}
@@ -77,7 +77,7 @@ namespace Jazz2::Actors::Enemies
 					_idleTime = Random().NextFloat(40.0f, 60.0f);
 					_attackCooldown = Random().NextFloat(130.0f, 200.0f);
 
-					_noise = PlaySfx("Noise"_s, 0.6f);
+					_noise = PlaySfx("Noise"_atom, 0.6f);
 					break;
 				}
 			}
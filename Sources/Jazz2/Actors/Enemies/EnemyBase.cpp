@@ -223,6 +223,7 @@ namespace Jazz2::Actors::Enemies
 
 		GraphicResource* res = (_currentTransitionState != AnimState::Idle ? _currentTransition : _currentAnimation);
 		Texture* texture = res->Base->TextureDiffuse.get();
+		Recti frameRect = res->Base->GetFrameRect(_renderer.CurrentFrame);
 		float x = _pos.X - res->Base->Hotspot.X;
 		float y = _pos.Y - res->Base->Hotspot.Y;
 
@@ -250,9 +251,9 @@ namespace Jazz2::Actors::Enemies
 					debris.Time = 320.0f;
 
 					debris.TexScaleX = (currentSize / float(texSize.X));
-					debris.TexBiasX = (((float)(_renderer.CurrentFrame % res->Base->FrameConfiguration.X) / res->Base->FrameConfiguration.X) + ((float)fx / float(texSize.X)));
+					debris.TexBiasX = (float(frameRect.X + fx) / float(texSize.X));
 					debris.TexScaleY = (currentSize / float(texSize.Y));
-					debris.TexBiasY = (((float)(_renderer.CurrentFrame / res->Base->FrameConfiguration.X) / res->Base->FrameConfiguration.Y) + ((float)fy / float(texSize.Y)));
+					debris.TexBiasY = (float(frameRect.Y + fy) / float(texSize.Y));
 
 					debris.DiffuseTexture = texture;
 					debris.Flags = Tiles::TileMap::DebrisFlags::Bounce;
@@ -288,9 +289,9 @@ namespace Jazz2::Actors::Enemies
 					debris.Time = Random().FastFloat(10.0f, 50.0f);
 
 					debris.TexScaleX = (currentSize / float(texSize.X));
-					debris.TexBiasX = (((float)(_renderer.CurrentFrame % res->Base->FrameConfiguration.X) / res->Base->FrameConfiguration.X) + ((float)fx / float(texSize.X)));
+					debris.TexBiasX = (float(frameRect.X + fx) / float(texSize.X));
 					debris.TexScaleY = (currentSize / float(texSize.Y));
-					debris.TexBiasY = (((float)(_renderer.CurrentFrame / res->Base->FrameConfiguration.X) / res->Base->FrameConfiguration.Y) + ((float)fy / float(texSize.Y)));
+					debris.TexBiasY = (float(frameRect.Y + fy) / float(texSize.Y));
 
 					debris.DiffuseTexture = texture;
 					debris.Flags = Tiles::TileMap::DebrisFlags::Disappear;
@@ -325,9 +326,9 @@ namespace Jazz2::Actors::Enemies
 					debris.Time = Random().FastFloat(300.0f, 340.0f);;
 
 					debris.TexScaleX = (currentSize / float(texSize.X));
-					debris.TexBiasX = (((float)(_renderer.CurrentFrame % res->Base->FrameConfiguration.X) / res->Base->FrameConfiguration.X) + ((float)fx / float(texSize.X)));
+					debris.TexBiasX = (float(frameRect.X + fx) / float(texSize.X));
 					debris.TexScaleY = (currentSize / float(texSize.Y));
-					debris.TexBiasY = (((float)(_renderer.CurrentFrame / res->Base->FrameConfiguration.X) / res->Base->FrameConfiguration.Y) + ((float)fy / float(texSize.Y)));
+					debris.TexBiasY = (float(frameRect.Y + fy) / float(texSize.Y));
 
 					debris.DiffuseTexture = texture;
 					debris.Flags = Tiles::TileMap::DebrisFlags::Disappear;
@@ -52,7 +52,7 @@ namespace Jazz2::Actors::Enemies
 				}
 				_speed.Y = -4.5f;
 
-				PlaySfx("Attack"_s);
+				PlaySfx("Attack"_atom);
 
 				SetTransition(AnimState::TransitionAttack, false, [this]() {
 					_speed.X = 0.0f;
@@ -90,7 +90,7 @@ namespace Jazz2::Actors::Enemies
 			_stateTime -= timeMult;
 
 			if (Random().NextFloat() < 0.008f * timeMult) {
-				PlaySfx("Idle"_s, 0.2f);
+				PlaySfx("Idle"_atom, 0.2f);
 			}
 		}
 	}
@@ -143,7 +143,7 @@ namespace Jazz2::Actors::Enemies
 			}
 
 			if (Random().NextFloat() < 0.004f * timeMult) {
-				PlaySfx("Noise"_s, 0.2f);
+				PlaySfx("Noise"_atom, 0.2f);
 			}
 
 			if (_canIdle) {
@@ -183,6 +183,6 @@ namespace Jazz2::Actors::Enemies
 		_isAttacking = true;
 		SetState(ActorState::CanJump, false);
 
-		PlaySfx("Attack"_s);
+		PlaySfx("Attack"_atom);
 	}
 }
\ No newline at end of file
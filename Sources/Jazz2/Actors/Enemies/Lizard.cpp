@@ -103,7 +103,7 @@ namespace Jazz2::Actors::Enemies
 		}
 
 		if (Random().NextFloat() < 0.002f * timeMult) {
-			PlaySfx("Noise"_s, 0.4f);
+			PlaySfx("Noise"_atom, 0.4f);
 		}
 	}
 
@@ -56,7 +56,7 @@ namespace Jazz2::Actors::Enemies
 
 						SetAnimation((AnimState)1073741824);
 						SetTransition((AnimState)1073741824, false, [this]() {
-							PlaySfx("Spit"_s);
+							PlaySfx("Spit"_atom);
 
 							std::shared_ptr<BulletSpit> bulletSpit = std::make_shared<BulletSpit>();
 							uint8_t bulletSpitParams[1];
@@ -108,8 +108,8 @@ namespace Jazz2::Actors::Enemies
 		_levelHandler->PlayCommonSfx("Splat"_s, Vector3f(_pos.X, _pos.Y, 0.0f));
 
 		if (_frozenTimeLeft <= 0.0f) {
-			CreateSpriteDebris("Cup"_s, 1);
-			CreateSpriteDebris("Hat"_s, 1);
+			CreateSpriteDebris("Cup"_atom, 1);
+			CreateSpriteDebris("Hat"_atom, 1);
 		}
 
 		TryGenerateRandomDrop();
@@ -159,7 +159,7 @@ namespace Jazz2::Actors::Enemies
 		async_await RequestMetadataAsync("Enemy/Monkey"_s);
 		SetAnimation((AnimState)1073741828);
 
-		_soundThrow = PlaySfx("BananaThrow"_s);
+		_soundThrow = PlaySfx("BananaThrow"_atom);
 
 		async_return true;
 	}
@@ -182,7 +182,7 @@ namespace Jazz2::Actors::Enemies
 			EnemyBase::OnPerish(collider);
 		});
 
-		PlaySfx("BananaSplat"_s, 0.6f);
+		PlaySfx("BananaSplat"_atom, 0.6f);
 
 		return false;
 	}
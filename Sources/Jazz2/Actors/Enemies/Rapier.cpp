@@ -72,7 +72,7 @@ namespace Jazz2::Actors::Enemies
 				_noiseCooldown = Random().FastFloat(300.0f, 600.0f);
 
 				if (Random().NextFloat() < 0.5f) {
-					PlaySfx("Noise"_s, 0.7f);
+					PlaySfx("Noise"_atom, 0.7f);
 				}
 			}
 		}
@@ -103,6 +103,7 @@ namespace Jazz2::Actors::Enemies
 
 			GraphicResource* res = (_currentTransitionState != AnimState::Idle ? _currentTransition : _currentAnimation);
 			Vector2i texSize = res->Base->TextureDiffuse->size();
+			Recti frameRect = res->Base->GetFrameRect(_renderer.CurrentFrame);
 
 			float x = _pos.X - res->Base->Hotspot.X;
 			float y = _pos.Y - res->Base->Hotspot.Y;
@@ -127,9 +128,9 @@ namespace Jazz2::Actors::Enemies
 					debris.Time = 280.0f;
 
 					debris.TexScaleX = (currentSize / float(texSize.X));
-					debris.TexBiasX = (((float)(_renderer.CurrentFrame % res->Base->FrameConfiguration.X) / res->Base->FrameConfiguration.X) + ((float)fx / float(texSize.X)));
+					debris.TexBiasX = (float(frameRect.X + fx) / float(texSize.X));
 					debris.TexScaleY = (currentSize / float(texSize.Y));
-					debris.TexBiasY = (((float)(_renderer.CurrentFrame / res->Base->FrameConfiguration.X) / res->Base->FrameConfiguration.Y) + ((float)fy / float(texSize.Y)));
+					debris.TexBiasY = (float(frameRect.Y + fy) / float(texSize.Y));
 
 					debris.DiffuseTexture = res->Base->TextureDiffuse.get();
 					debris.Flags = Tiles::TileMap::DebrisFlags::Disappear;
@@ -139,7 +140,7 @@ namespace Jazz2::Actors::Enemies
 			}
 		}
 
-		PlaySfx("Die"_s);
+		PlaySfx("Die"_atom);
 		TryGenerateRandomDrop();
 
 		return EnemyBase::OnPerish(collider);
@@ -168,7 +169,7 @@ namespace Jazz2::Actors::Enemies
 				_attackTime = 80.0f;
 				_attacking = true;
 
-				PlaySfx("Attack"_s, 0.7f);
+				PlaySfx("Attack"_atom, 0.7f);
 			});
 		}
 	}
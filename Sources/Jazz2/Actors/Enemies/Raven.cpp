@@ -123,7 +123,7 @@ namespace Jazz2::Actors::Enemies
 			_attackTime = 80.0f;
 			_attacking = true;
 
-			PlaySfx("Attack"_s, 0.7f, Random().NextFloat(1.4f, 1.8f));
+			PlaySfx("Attack"_atom, 0.7f, Random().NextFloat(1.4f, 1.8f));
 		}
 	}
 }
\ No newline at end of file
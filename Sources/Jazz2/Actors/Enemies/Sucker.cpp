@@ -44,7 +44,7 @@ namespace Jazz2::Actors::Enemies
 			if (parentLastHitDir == LastHitDirection::Left || parentLastHitDir == LastHitDirection::Right) {
 				_speed.X = 3 * (parentLastHitDir == LastHitDirection::Left ? -1 : 1);
 			}
-			PlaySfx("Deflate"_s);
+			PlaySfx("Deflate"_atom);
 		} else {
 			SetAnimation(AnimState::Walk);
 
@@ -85,11 +85,11 @@ namespace Jazz2::Actors::Enemies
 				}
 
 				if (_cycle == 0) {
-					PlaySfx("Walk1"_s, 0.2f);
+					PlaySfx("Walk1"_atom, 0.2f);
 				} else if (_cycle == 6) {
-					PlaySfx("Walk2"_s, 0.2f);
+					PlaySfx("Walk2"_atom, 0.2f);
 				} else if (_cycle == 2 || _cycle == 7) {
-					PlaySfx("Walk3"_s, 0.2f);
+					PlaySfx("Walk3"_atom, 0.2f);
 				}
 
 				if ((_cycle >= 4 && _cycle < 7) || _cycle >= 9) {
@@ -78,7 +78,7 @@ namespace Jazz2::Actors::Enemies
 				_isTurning = true;
 				_canHurtPlayer = false;
 				_speed.X = 0;
-				PlaySfx("Withdraw"_s, 0.2f);
+				PlaySfx("Withdraw"_atom, 0.2f);
 			}
 		}
 
@@ -163,7 +163,7 @@ namespace Jazz2::Actors::Enemies
 				SetTransition(AnimState::TransitionWithdrawEnd, false, [this]() {
 				   HandleTurn(false);
 				});
-				PlaySfx("WithdrawEnd"_s, 0.2f);
+				PlaySfx("WithdrawEnd"_atom, 0.2f);
 				_isWithdrawn = true;
 			} else {
 				_canHurtPlayer = true;
@@ -178,14 +178,14 @@ namespace Jazz2::Actors::Enemies
 	{
 		_speed.X = 0;
 		_isAttacking = true;
-		PlaySfx("Attack"_s);
+		PlaySfx("Attack"_atom);
 
 		SetTransition(AnimState::TransitionAttack, false, [this]() {
 			_speed.X = (IsFacingLeft() ? -1 : 1) * DefaultSpeed;
 			_isAttacking = false;
 
 			// TODO: Bad timing
-			PlaySfx("Attack2"_s);
+			PlaySfx("Attack2"_atom);
 		});
 	}
 }
\ No newline at end of file
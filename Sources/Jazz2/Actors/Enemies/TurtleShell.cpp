@@ -70,7 +70,7 @@ namespace Jazz2::Actors::Enemies
 		_health = 8;
 
 		if (std::abs(_speed.X) > 0.0f || std::abs(_externalForce.Y) > 0.0f) {
-			PlaySfx("Fly"_s);
+			PlaySfx("Fly"_atom);
 			StartBlinking();
 		}
 
@@ -137,7 +137,7 @@ namespace Jazz2::Actors::Enemies
 
 				_speed.X = std::max(4.0f, std::abs(shotSpeed)) * (shotSpeed < 0.0f ? -0.5f : 0.5f);
 
-				PlaySfx("Fly"_s);
+				PlaySfx("Fly"_atom);
 			}
 		} else if (auto shell = dynamic_cast<TurtleShell*>(other.get())) {
 			auto otherSpeed = shell->GetSpeed();
@@ -152,7 +152,7 @@ namespace Jazz2::Actors::Enemies
 				_speed.X = totalSpeed / 2.0f * (_speed.X < 0.0f ? 1.0f : -1.0f);
 
 				shell->DecreaseHealth(1, this);
-				PlaySfx("ImpactShell"_s, 0.8f);
+				PlaySfx("ImpactShell"_atom, 0.8f);
 				return true;
 			}
 		} else if (auto enemyBase = dynamic_cast<EnemyBase*>(other.get())) {
@@ -195,7 +195,7 @@ namespace Jazz2::Actors::Enemies
 	void TurtleShell::OnHitFloor(float timeMult)
 	{
 		if (std::abs(_speed.Y) > 1.0f) {
-			PlaySfx("ImpactGround"_s);
+			PlaySfx("ImpactGround"_atom);
 		}
 	}
 }
\ No newline at end of file
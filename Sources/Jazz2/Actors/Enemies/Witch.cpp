@@ -73,7 +73,7 @@ namespace Jazz2::Actors::Enemies
 			if (_attackTime <= 0.0f && length < 260.0f) {
 				_attackTime = 450.0f;
 
-				PlaySfx("MagicFire"_s);
+				PlaySfx("MagicFire"_atom);
 
 				SetTransition(AnimState::TransitionAttack, true, [this]() {
 					Vector2f bulletPos = Vector2f(_pos.X + (IsFacingLeft() ? -24.0f : 24.0f), _pos.Y);
@@ -136,7 +136,7 @@ namespace Jazz2::Actors::Enemies
 		_speed.X = (IsFacingLeft() ? -9.0f : 9.0f);
 		_speed.Y = -0.8f;
 
-		PlaySfx("Laugh"_s);
+		PlaySfx("Laugh"_atom);
 	}
 
 	Task<bool> Witch::MagicBullet::OnActivatedAsync(const ActorActivationDetails& details)
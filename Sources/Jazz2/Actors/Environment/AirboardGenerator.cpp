@@ -21,7 +21,7 @@ namespace Jazz2::Actors::Environment
 
 		async_await RequestMetadataAsync("Object/Airboard"_s);
 
-		SetAnimation("Airboard"_s);
+		SetAnimation("Airboard"_atom);
 
 		async_return true;
 	}
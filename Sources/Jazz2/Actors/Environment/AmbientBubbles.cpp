@@ -56,11 +56,10 @@ namespace Jazz2::Actors::Environment
 
 		auto tilemap = _levelHandler->TileMap();
 		if (tilemap != nullptr) {
-			auto it = _metadata->Graphics.find(String::nullTerminatedView("AmbientBubbles"_s));
+			auto it = _metadata->Graphics.find("AmbientBubbles"_atom);
 			if (it != _metadata->Graphics.end()) {
 				Vector2i texSize = it->second.Base->TextureDiffuse->size();
 				Vector2i size = it->second.Base->FrameDimensions;
-				Vector2i frameConf = it->second.Base->FrameConfiguration;
 
 				for (int i = 0; i < count; i++) {
 					float scale = Random().NextFloat(0.3f, 1.0f);
@@ -68,6 +67,7 @@ namespace Jazz2::Actors::Environment
 					float speedY = Random().NextFloat(-3.0f, -2.0f) * scale;
 					float accel = Random().NextFloat(-0.008f, -0.001f) * scale;
 					int frame = it->second.FrameOffset + Random().Next(0, it->second.FrameCount);
+					Recti frameRect = it->second.Base->GetFrameRect(frame);
 
 					Tiles::TileMap::DestructibleDebris debris = { };
 					debris.Pos = _pos;
@@ -83,9 +83,9 @@ namespace Jazz2::Actors::Environment
 					debris.Time = 110.0f;
 
 					debris.TexScaleX = (size.X / float(texSize.X));
-					debris.TexBiasX = ((float)(frame % frameConf.X) / frameConf.X);
+					debris.TexBiasX = (frameRect.X / float(texSize.X));
 					debris.TexScaleY = (size.Y / float(texSize.Y));
-					debris.TexBiasY = ((float)(frame / frameConf.X) / frameConf.Y);
+					debris.TexBiasY = (frameRect.Y / float(texSize.Y));
 
 					debris.DiffuseTexture = it->second.Base->TextureDiffuse.get();
 
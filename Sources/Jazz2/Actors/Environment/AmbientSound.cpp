@@ -30,9 +30,9 @@ namespace Jazz2::Actors::Environment
 		async_await RequestMetadataAsync("Common/AmbientSound"_s);
 		
 		switch (_sfx) {
-			case 0: _sound = PlaySfx("AmbientWind"_s, _gain); break;
-			case 1: _sound = PlaySfx("AmbientFire"_s, _gain); break;
-			case 2: _sound = PlaySfx("AmbientScienceNoise"_s, _gain); break;
+			case 0: _sound = PlaySfx("AmbientWind"_atom, _gain); break;
+			case 1: _sound = PlaySfx("AmbientFire"_atom, _gain); break;
+			case 2: _sound = PlaySfx("AmbientScienceNoise"_atom, _gain); break;
 		}
 
 		// TODO: Fade-in
@@ -30,20 +30,20 @@ namespace Jazz2::Actors::Environment
 
 		switch (_cost) {
 			case 10:
-				SetAnimation("Bonus10"_s);
+				SetAnimation("Bonus10"_atom);
 				break;
 			case 20:
-				SetAnimation("Bonus20"_s);
+				SetAnimation("Bonus20"_atom);
 				break;
 			case 50:
-				SetAnimation("Bonus50"_s);
+				SetAnimation("Bonus50"_atom);
 				break;
 			case 100:
-				SetAnimation("Bonus100"_s);
+				SetAnimation("Bonus100"_atom);
 				break;
 			default:
 				// TODO: Show rabbit + coins needed, if (showAnim)
-				SetAnimation("BonusGeneric"_s);
+				SetAnimation("BonusGeneric"_atom);
 				break;
 		}
 
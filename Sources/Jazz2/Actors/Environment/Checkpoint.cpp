@@ -43,7 +43,7 @@ namespace Jazz2::Actors::Environment
 				break;
 		}
 
-		SetAnimation(_activated ? "Opened"_s : "Closed"_s);
+		SetAnimation(_activated ? "Opened"_atom : "Closed"_atom);
 
 		if (GetState(ActorState::ApplyGravitation)) {
 			OnUpdateHitbox();
@@ -75,10 +75,10 @@ namespace Jazz2::Actors::Environment
 		if (auto player = dynamic_cast<Player*>(other.get())) {
 			_activated = true;
 
-			SetAnimation("Opened"_s);
+			SetAnimation("Opened"_atom);
 			SetTransition(AnimState::TransitionActivate, false);
 
-			PlaySfx("TransitionActivate"_s);
+			PlaySfx("TransitionActivate"_atom);
 
 			// Deactivate event in map
 			uint8_t playerParams[16] = { _theme, 1 };
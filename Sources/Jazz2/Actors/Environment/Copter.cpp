@@ -27,7 +27,7 @@ namespace Jazz2::Actors::Environment
 
 		async_await RequestMetadataAsync("Enemy/LizardFloat"_s);
 
-		SetAnimation("Copter"_s);
+		SetAnimation("Copter"_atom);
 
 		_originPos = _pos;
 
@@ -76,7 +76,7 @@ namespace Jazz2::Actors::Environment
 					_state = State::Mounted;
 					_renderer.setAlphaF(1.0f);
 
-					PlaySfx("CopterPre"_s);
+					PlaySfx("CopterPre"_atom);
 					return true;
 				}
 			}
@@ -91,7 +91,7 @@ namespace Jazz2::Actors::Environment
 			_state = State::Unmounted;
 			_phase = timeLeft;
 
-			_noise = PlaySfx("Copter"_s, 0.8f, 0.8f);
+			_noise = PlaySfx("Copter"_atom, 0.8f, 0.8f);
 			if (_noise != nullptr) {
 				_noise->setLooping(true);
 				_noiseDec = _noise->gain() * 0.005f;
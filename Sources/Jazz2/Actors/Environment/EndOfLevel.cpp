@@ -18,7 +18,7 @@ namespace Jazz2::Actors::Environment
 
 		async_await RequestMetadataAsync("Object/SignEol"_s);
 
-		SetAnimation("SignEol"_s);
+		SetAnimation("SignEol"_atom);
 
 		async_return true;
 	}
@@ -44,7 +44,7 @@ namespace Jazz2::Actors::Environment
 				SetTransition(AnimState::TransitionAttack, false, [this, player]() {
 					player->MorphRevert();
 
-					PlaySfx("Kiss"_s, 0.8f);
+					PlaySfx("Kiss"_atom, 0.8f);
 					SetTransition(AnimState::TransitionAttackEnd, false);
 				});
 			}
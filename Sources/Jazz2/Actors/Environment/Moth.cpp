@@ -25,10 +25,10 @@ namespace Jazz2::Actors::Environment
 
 		switch (theme) {
 			default:
-			case 0: SetAnimation("Pink"_s); break;
-			case 1: SetAnimation("Gray"_s); break;
-			case 2: SetAnimation("Green"_s); break;
-			case 3: SetAnimation("Purple"_s); break;
+			case 0: SetAnimation("Pink"_atom); break;
+			case 1: SetAnimation("Gray"_atom); break;
+			case 2: SetAnimation("Green"_atom); break;
+			case 3: SetAnimation("Purple"_atom); break;
 		}
 
 		_renderer.AnimPaused = true;
@@ -70,7 +70,7 @@ namespace Jazz2::Actors::Environment
 				// Bounce on X
 				if (_soundCooldown <= 0.0f && std::abs(_speed.X) > 2.0f) {
 					_soundCooldown = 140.0f;
-					PlaySfx("Hit"_s, 0.6f, 0.4f);
+					PlaySfx("Hit"_atom, 0.6f, 0.4f);
 				}
 
 				_speed.X = _speed.X * -0.5f;
@@ -81,7 +81,7 @@ namespace Jazz2::Actors::Environment
 				// Bounce on Y
 				if (_soundCooldown <= 0.0f && std::abs(_speed.Y) > 2.0f) {
 					_soundCooldown = 140.0f;
-					PlaySfx("Hit"_s, 0.6f, 0.4f);
+					PlaySfx("Hit"_atom, 0.6f, 0.4f);
 				}
 
 				_speed.Y = _speed.Y * -0.5f;
@@ -114,7 +114,7 @@ namespace Jazz2::Actors::Environment
 
 				if (_soundCooldown <= 0.0f) {
 					_soundCooldown = 140.0f;
-					PlaySfx("Hit"_s, 0.6f, 0.4f);
+					PlaySfx("Hit"_atom, 0.6f, 0.4f);
 				}
 			}
 		}
@@ -22,14 +22,14 @@ namespace Jazz2::Actors::Environment
 		SetTransition(_currentAnimationState | (AnimState)0x200, false);
 		switch (_orientation) {
 			case Orientation::Bottom:
-				PlaySfx("Vertical"_s);
+				PlaySfx("Vertical"_atom);
 				return Vector2f(0, -_strength);
 			case Orientation::Top:
-				PlaySfx("VerticalReversed"_s);
+				PlaySfx("VerticalReversed"_atom);
 				return Vector2f(0, _strength);
 			case Orientation::Right:
 			case Orientation::Left:
-				PlaySfx("Horizontal"_s);
+				PlaySfx("Horizontal"_atom);
 				return Vector2f(_strength * (_orientation == Orientation::Right ? 1 : -1), 0);
 			default:
 				return Vector2f::Zero;
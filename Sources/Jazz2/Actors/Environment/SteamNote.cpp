@@ -19,9 +19,9 @@ namespace Jazz2::Actors::Environment
 
 		async_await RequestMetadataAsync("Object/SteamNote"_s);
 
-		SetAnimation("SteamNote"_s);
+		SetAnimation("SteamNote"_atom);
 
-		PlaySfx("Appear"_s, 0.4f);
+		PlaySfx("Appear"_atom, 0.4f);
 
 		// It's incorrectly positioned one tile up in "share2.j2l", so move it to correct position
 		OnUpdateHitbox();
@@ -49,7 +49,7 @@ namespace Jazz2::Actors::Environment
 				_renderer.AnimPaused = false;
 				_renderer.setDrawEnabled(true);
 
-				PlaySfx("Appear"_s, 0.4f);
+				PlaySfx("Appear"_atom, 0.4f);
 			}
 		}
 	}
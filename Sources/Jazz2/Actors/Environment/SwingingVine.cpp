@@ -32,11 +32,12 @@ namespace Jazz2::Actors::Environment
 
 		async_await RequestMetadataAsync("Object/SwingingVine"_s);
 
-		SetAnimation("Vine"_s);
+		SetAnimation("Vine"_atom);
 
 		_renderer.AnimPaused = true;
 
-		if (_currentAnimation != nullptr) {
+		// Shared atlas pages must keep the default wrapping
+		if (_currentAnimation != nullptr && (_currentAnimation->Base->Flags & GenericGraphicResourceFlags::Atlas) != GenericGraphicResourceFlags::Atlas) {
 			_currentAnimation->Base->TextureDiffuse->setWrap(SamplerWrapping::Repeat);
 		}
 
@@ -114,6 +115,9 @@ namespace Jazz2::Actors::Environment
 		if (_currentAnimation != nullptr) {
 			auto& resBase = _currentAnimation->Base;
 			Vector2i texSize = resBase->TextureDiffuse->size();
+			Vector2i sheetSize = resBase->FrameDimensions * resBase->FrameConfiguration;
+			float texBiasX = float(resBase->TextureOffset.X) / texSize.X;
+			float texBiasY = float(resBase->TextureOffset.Y) / texSize.Y;
 
 			for (int i = 0; i < ChunkCount; i++) {
 				auto command = _chunks[i].get();
@@ -121,10 +125,9 @@ namespace Jazz2::Actors::Environment
 				float chunkTexSize = ChunkSize / texSize.Y;
 				float chunkAngle = sinf(_phase - i * 0.08f) * 1.2f;
 
-				auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-				instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(1.0f, 0.0f, chunkTexSize, chunkTexSize * i);
-				instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(texSize.X, ChunkSize);
-				instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf::White.Data());
+				command->material().setInstanceTexRect(float(sheetSize.X) / texSize.X, texBiasX, chunkTexSize, texBiasY + chunkTexSize * i);
+				command->material().setInstanceSpriteSize(sheetSize.X, ChunkSize);
+				command->material().setInstanceColor(Colorf::White.Data());
 
 				Matrix4x4f worldMatrix = Matrix4x4f::Translation(_chunkPos[i].X, _chunkPos[i].Y, 0.0f);
 				worldMatrix.RotateZ(chunkAngle);
@@ -38,13 +38,13 @@ namespace Jazz2::Actors
 
 		switch (_type) {
 			default:
-			case Type::Tiny: SetAnimation("Tiny"_s); break;
-			case Type::TinyBlue: SetAnimation("TinyBlue"_s); break;
-			case Type::TinyDark: SetAnimation("TinyDark"_s); break;
-			case Type::Small: SetAnimation("Small"_s); break;
-			case Type::SmallDark: SetAnimation("SmallDark"_s); break;
+			case Type::Tiny: SetAnimation("Tiny"_atom); break;
+			case Type::TinyBlue: SetAnimation("TinyBlue"_atom); break;
+			case Type::TinyDark: SetAnimation("TinyDark"_atom); break;
+			case Type::Small: SetAnimation("Small"_atom); break;
+			case Type::SmallDark: SetAnimation("SmallDark"_atom); break;
 			case Type::Large: {
-				SetAnimation("Large"_s);
+				SetAnimation("Large"_atom);
 
 				_lightIntensity = 0.8f;
 				_lightBrightness = 0.9f;
@@ -52,15 +52,15 @@ namespace Jazz2::Actors
 				break;
 			}
 
-			case Type::SmokeBrown: SetAnimation("SmokeBrown"_s); break;
-			case Type::SmokeGray: SetAnimation("SmokeGray"_s); break;
-			case Type::SmokeWhite: SetAnimation("SmokeWhite"_s); break;
-			case Type::SmokePoof: SetAnimation("SmokePoof"_s); break;
+			case Type::SmokeBrown: SetAnimation("SmokeBrown"_atom); break;
+			case Type::SmokeGray: SetAnimation("SmokeGray"_atom); break;
+			case Type::SmokeWhite: SetAnimation("SmokeWhite"_atom); break;
+			case Type::SmokePoof: SetAnimation("SmokePoof"_atom); break;
 
-			case Type::WaterSplash: SetAnimation("WaterSplash"_s); break;
+			case Type::WaterSplash: SetAnimation("WaterSplash"_atom); break;
 
 			case Type::Pepper: {
-				SetAnimation("Pepper"_s);
+				SetAnimation("Pepper"_atom);
 
 				_lightIntensity = 0.5f;
 				_lightBrightness = 0.2f;
@@ -69,7 +69,7 @@ namespace Jazz2::Actors
 				break;
 			}
 			case Type::RF: {
-				SetAnimation("RF"_s);
+				SetAnimation("RF"_atom);
 
 				_lightIntensity = 0.8f;
 				_lightBrightness = 0.9f;
@@ -77,8 +77,8 @@ namespace Jazz2::Actors
 				break;
 			}
 			case Type::IceShrapnel: {
-				constexpr StringView IceShrapnels[] = {
-					"IceShrapnel1"_s, "IceShrapnel2"_s, "IceShrapnel3"_s, "IceShrapnel4"_s
+				constexpr Atom IceShrapnels[] = {
+					"IceShrapnel1"_atom, "IceShrapnel2"_atom, "IceShrapnel3"_atom, "IceShrapnel4"_atom
 				};
 				SetAnimation(IceShrapnels[Random().Fast(0, countof(IceShrapnels))]);
 
@@ -95,7 +95,7 @@ namespace Jazz2::Actors
 			}
 
 			case Type::Generator: {
-				SetAnimation("Generator"_s);
+				SetAnimation("Generator"_atom);
 
 				// Apply random orientation
 				_renderer.setRotation(Random().NextFloat(0.0f, 4.0f * fPiOver2));
@@ -194,7 +194,7 @@ namespace Jazz2::Actors
 			});
 
 			_renderer.setDrawEnabled(true);
-			PlayPlayerSfx("WarpOut"_s);
+			PlayPlayerSfx("WarpOut"_atom);
 
 			_lastExitType = ExitType::None;
 		}
@@ -283,10 +283,11 @@ namespace Jazz2::Actors
 
 					auto tilemap = _levelHandler->TileMap();
 					if (tilemap != nullptr) {
-						auto it = _metadata->Graphics.find(String::nullTerminatedView("Shield"_s));
+						auto it = _metadata->Graphics.find("Shield"_atom);
 						if (it != _metadata->Graphics.end()) {
 							Vector2i texSize = it->second.Base->TextureDiffuse->size();
 							Vector2i size = it->second.Base->FrameDimensions;
+							Vector2i offset = it->second.Base->TextureOffset;
 
 							Tiles::TileMap::DestructibleDebris debris = { };
 							debris.Pos = _pos;
@@ -303,9 +304,9 @@ namespace Jazz2::Actors
 							debris.Time = 160.0f;
 
 							debris.TexScaleX = (size.X / float(texSize.X));
-							debris.TexBiasX = 0.0f;
+							debris.TexBiasX = (offset.X / float(texSize.X));
 							debris.TexScaleY = (size.Y / float(texSize.Y));
-							debris.TexBiasY = 0.0f;
+							debris.TexBiasY = (offset.Y / float(texSize.Y));
 
 							debris.DiffuseTexture = it->second.Base->TextureDiffuse.get();
 							debris.Flags = Tiles::TileMap::DebrisFlags::AdditiveBlending;
@@ -422,12 +423,12 @@ namespace Jazz2::Actors
 
 					auto tilemap = _levelHandler->TileMap();
 					if (tilemap != nullptr) {
-						auto it = _metadata->Graphics.find(String::nullTerminatedView("SugarRush"_s));
+						auto it = _metadata->Graphics.find("SugarRush"_atom);
 						if (it != _metadata->Graphics.end()) {
 							Vector2i texSize = it->second.Base->TextureDiffuse->size();
 							Vector2i size = it->second.Base->FrameDimensions;
-							Vector2i frameConf = it->second.Base->FrameConfiguration;
 							int frame = it->second.FrameOffset + Random().Next(0, it->second.FrameCount);
+							Recti frameRect = it->second.Base->GetFrameRect(frame);
 							float speedX = Random().FastFloat(-4.0f, 4.0f);
 
 							Tiles::TileMap::DestructibleDebris debris = { };
@@ -447,9 +448,9 @@ namespace Jazz2::Actors
 							debris.Time = 160.0f;
 
 							debris.TexScaleX = (size.X / float(texSize.X));
-							debris.TexBiasX = ((float)(frame % frameConf.X) / frameConf.X);
+							debris.TexBiasX = (frameRect.X / float(texSize.X));
 							debris.TexScaleY = (size.Y / float(texSize.Y));
-							debris.TexBiasY = ((float)(frame / frameConf.X) / frameConf.Y);
+							debris.TexBiasY = (frameRect.Y / float(texSize.Y));
 
 							debris.DiffuseTexture = it->second.Base->TextureDiffuse.get();
 
@@ -712,8 +713,8 @@ namespace Jazz2::Actors
 							_speed.Y = 9.0f;
 							SetState(ActorState::ApplyGravitation, true);
 							SetAnimation(AnimState::Buttstomp);
-							PlaySfx("Buttstomp"_s, 1.0f, 0.8f);
-							PlaySfx("Buttstomp2"_s);
+							PlaySfx("Buttstomp"_atom, 1.0f, 0.8f);
+							PlaySfx("Buttstomp2"_atom);
 						});
 					}
 				}
@@ -732,7 +733,7 @@ namespace Jazz2::Actors
 						if (_isLifting && GetState(ActorState::CanJump) && _currentSpecialMove == SpecialMoveType::None) {
 							SetState(ActorState::CanJump, false);
 							SetAnimation(_currentAnimationState & (~AnimState::Lookup & ~AnimState::Crouch));
-							PlaySfx("Jump"_s);
+							PlaySfx("Jump"_atom);
 							_carryingObject = nullptr;
 
 							SetState(ActorState::IsSolidObject | ActorState::CollideWithSolidObjects, false);
@@ -770,7 +771,7 @@ namespace Jazz2::Actors
 											_copterFramesLeft = 70.0f;
 
 											if (_copterSound == nullptr) {
-												_copterSound = PlaySfx("Copter"_s, 0.6f, 1.5f);
+												_copterSound = PlaySfx("Copter"_atom, 0.6f, 1.5f);
 												if (_copterSound != nullptr) {
 													_copterSound->setLooping(true);
 												}
@@ -790,7 +791,7 @@ namespace Jazz2::Actors
 											SetPlayerTransition(AnimState::TransitionUppercutB, true, true, SpecialMoveType::Sidekick);
 										});
 
-										PlayPlayerSfx("Sidekick"_s);
+										PlayPlayerSfx("Sidekick"_atom);
 									} else {
 										if (!GetState(ActorState::CanJump) && _canDoubleJump) {
 											_canDoubleJump = false;
@@ -800,7 +801,7 @@ namespace Jazz2::Actors
 											_speed.Y = -0.6f - std::max(0.0f, (std::abs(_speed.X) - 4.0f) * 0.3f);
 											_speed.X *= 0.4f;
 
-											PlaySfx("DoubleJump"_s);
+											PlaySfx("DoubleJump"_atom);
 
 											SetTransition(AnimState::Spring, false);
 										}
@@ -826,7 +827,7 @@ namespace Jazz2::Actors
 											_copterFramesLeft = 70.0f;
 
 											if (_copterSound == nullptr) {
-												_copterSound = PlaySfx("Copter"_s, 0.6f, 1.5f);
+												_copterSound = PlaySfx("Copter"_atom, 0.6f, 1.5f);
 												if (_copterSound != nullptr) {
 													_copterSound->setLooping(true);
 												}
@@ -858,7 +859,7 @@ namespace Jazz2::Actors
 						_isFreefall = false;
 						SetAnimation(_currentAnimationState & (~AnimState::Lookup & ~AnimState::Crouch));
 						if (_jumpTime <= 0.0f) {
-							PlaySfx("Jump"_s);
+							PlaySfx("Jump"_atom);
 						}
 						_jumpTime = 12.0f;
 						_carryingObject = nullptr;
@@ -897,7 +898,7 @@ namespace Jazz2::Actors
 			if (!_isLifting && _suspendType != SuspendType::SwingingVine && (_currentAnimationState & AnimState::Push) != AnimState::Push && _pushFramesLeft <= 0.0f) {
 				if (_playerType == PlayerType::Frog) {
 					if (_currentTransitionState == AnimState::Idle && std::abs(_speed.X) < 0.1f && std::abs(_speed.Y) < 0.1f && std::abs(_externalForce.X) < 0.1f && std::abs(_externalForce.Y) < 0.1f) {
-						PlaySfx("Tongue"_s, 0.8f);
+						PlaySfx("Tongue"_atom, 0.8f);
 
 						_controllable = false;
 						_controllableTimeout = 120.0f;
@@ -1145,7 +1146,7 @@ namespace Jazz2::Actors
 						_isSpring = true;
 					}
 
-					PlaySfx("Spring"_s);
+					PlaySfx("Spring"_atom);
 				}
 			}
 
@@ -1162,7 +1163,7 @@ namespace Jazz2::Actors
 					_coins = 0;
 				} else if (_bonusWarpTimer <= 0.0f) {
 					_levelHandler->ShowCoins(_coins);
-					PlaySfx("BonusWarpNotEnoughCoins"_s);
+					PlaySfx("BonusWarpNotEnoughCoins"_atom);
 
 					_bonusWarpTimer = 400.0f;
 				}
@@ -1185,7 +1186,7 @@ namespace Jazz2::Actors
 			TakeDamage(1, _speed.X * 0.25f);
 		} else if (!_inWater && _activeModifier == Modifier::None) {
 			if (!GetState(ActorState::CanJump)) {
-				PlaySfx("Land"_s, 0.8f);
+				PlaySfx("Land"_atom, 0.8f);
 
 				if (Random().NextFloat() < 0.6f) {
 					Explosion::Create(_levelHandler, Vector3i((int)_pos.X, (int)_pos.Y + 20.0f, _renderer.layer() - 2), Explosion::Type::TinyDark);
@@ -1399,8 +1400,8 @@ namespace Jazz2::Actors
 				_idleTime = 0.0f;
 
 				if (_currentTransitionState == AnimState::Idle) {
-					constexpr StringView IdleBored[] = {
-						"IdleBored1"_s, "IdleBored2"_s, "IdleBored3"_s, "IdleBored4"_s, "IdleBored5"_s
+					constexpr Atom IdleBored[] = {
+						"IdleBored1"_atom, "IdleBored2"_atom, "IdleBored3"_atom, "IdleBored4"_atom, "IdleBored5"_atom
 					};
 					int maxIdx;
 					switch (_playerType) {
@@ -1480,7 +1481,7 @@ namespace Jazz2::Actors
 							SetTransition(AnimState::TransitionLedge, true);
 						}
 
-						PlaySfx("Ledge"_s);
+						PlaySfx("Ledge"_atom);
 					}
 				}
 				break;
@@ -1667,7 +1668,7 @@ namespace Jazz2::Actors
 				SetState(ActorState::ApplyGravitation, false);
 
 				if (_speed.Y > 0.0f && newSuspendState == SuspendType::Vine) {
-					PlaySfx("HookAttach"_s, 0.8f, 1.2f);
+					PlaySfx("HookAttach"_atom, 0.8f, 1.2f);
 				}
 
 				_speed.Y = 0.0f;
@@ -1877,7 +1878,7 @@ namespace Jazz2::Actors
 						_levelHandler->BeginLevelChange(exitType, nextLevel);
 					} else if (_bonusWarpTimer <= 0.0f) {
 						_levelHandler->ShowCoins(_coins);
-						PlaySfx("BonusWarpNotEnoughCoins"_s);
+						PlaySfx("BonusWarpNotEnoughCoins"_atom);
 
 						_bonusWarpTimer = 400.0f;
 					}
@@ -2015,9 +2016,9 @@ namespace Jazz2::Actors
 		}
 	}
 
-	std::shared_ptr<AudioBufferPlayer> Player::PlayPlayerSfx(const StringView& identifier, float gain, float pitch)
+	std::shared_ptr<AudioBufferPlayer> Player::PlayPlayerSfx(Atom identifier, float gain, float pitch)
 	{
-		auto it = _metadata->Sounds.find(String::nullTerminatedView(identifier));
+		auto it = _metadata->Sounds.find(identifier);
 		if (it != _metadata->Sounds.end()) {
 			int idx = (it->second.Buffers.size() > 1 ? Random().Next(0, (int)it->second.Buffers.size()) : 0);
 			return _levelHandler->PlaySfx(it->second.Buffers[idx].get(), Vector3f(0.0f, 0.0f, 0.0f), true, gain, pitch);
@@ -2026,6 +2027,11 @@ namespace Jazz2::Actors
 		}
 	}
 
+	std::shared_ptr<AudioBufferPlayer> Player::PlayPlayerSfx(const StringView& identifier, float gain, float pitch)
+	{
+		return PlayPlayerSfx(Atom::find(identifier), gain, pitch);
+	}
+
 	bool Player::SetPlayerTransition(AnimState state, bool cancellable, bool removeControl, SpecialMoveType specialMove, const std::function<void()>& callback)
 	{
 		if (removeControl) {
@@ -2134,7 +2140,7 @@ namespace Jazz2::Actors
 			}
 		});
 
-		PlayPlayerSfx("Die"_s, 1.3f);
+		PlayPlayerSfx("Die"_atom, 1.3f);
 	}
 
 	void Player::SwitchToNextWeapon()
@@ -2157,7 +2163,7 @@ namespace Jazz2::Actors
 	void Player::SwitchToWeaponByIndex(uint32_t weaponIndex)
 	{
 		if (weaponIndex >= (uint32_t)WeaponType::Count || _weaponAmmo[weaponIndex] == 0) {
-			PlaySfx("ChangeWeapon"_s);
+			PlaySfx("ChangeWeapon"_atom);
 			return;
 		}
 
@@ -2322,7 +2328,7 @@ namespace Jazz2::Actors
 		}
 
 		if (_weaponSound == nullptr) {
-			_weaponSound = PlaySfx("WeaponThunderbolt"_s, 1.0f);
+			_weaponSound = PlaySfx("WeaponThunderbolt"_atom, 1.0f);
 			if (_weaponSound != nullptr) {
 				_weaponSound->setLooping(true);
 				_weaponSound->setPitch(Random().FastFloat(1.05f, 1.2f));
@@ -2344,7 +2350,7 @@ namespace Jazz2::Actors
 		switch (weaponType) {
 			case WeaponType::Blaster:
 				FireWeapon<Weapons::BlasterShot, WeaponType::Blaster>(40.0f, 1.0f);
-				PlaySfx("WeaponBlaster"_s);
+				PlaySfx("WeaponBlaster"_atom);
 				ammoDecrease = 0;
 				break;
 
@@ -2362,7 +2368,7 @@ namespace Jazz2::Actors
 					}
 					FireWeapon<Weapons::ToasterShot, WeaponType::Toaster>(6.0f, 0.0f);
 					if (_weaponSound == nullptr) {
-						_weaponSound = PlaySfx("WeaponToaster"_s, 0.6f);
+						_weaponSound = PlaySfx("WeaponToaster"_atom, 0.6f);
 						if (_weaponSound != nullptr) {
 							_weaponSound->setLooping(true);
 						}
@@ -2399,7 +2405,7 @@ namespace Jazz2::Actors
 			_weaponUpgrades[(int)weaponType] &= ~0x01;
 
 			SwitchToNextWeapon();
-			PlaySfx("ChangeWeapon"_s);
+			PlaySfx("ChangeWeapon"_atom);
 			_weaponCooldown = 20.0f;
 		}
 
@@ -2455,7 +2461,7 @@ namespace Jazz2::Actors
 						_renderer.setDrawEnabled(false);
 						_levelExiting = LevelExitingState::Ready;
 					});
-					PlayPlayerSfx("EndOfLevel1"_s);
+					PlayPlayerSfx("EndOfLevel1"_atom);
 
 					SetState(ActorState::ApplyGravitation, false);
 					_speed.X = 0.0f;
@@ -2473,7 +2479,7 @@ namespace Jazz2::Actors
 						_renderer.setDrawEnabled(false);
 						_levelExiting = LevelExitingState::Ready;
 					});
-					PlayPlayerSfx("WarpIn"_s);
+					PlayPlayerSfx("WarpIn"_atom);
 
 					SetState(ActorState::ApplyGravitation, false);
 					_speed.X = 0.0f;
@@ -2513,7 +2519,7 @@ namespace Jazz2::Actors
 						_renderer.setDrawEnabled(false);
 						_levelExiting = LevelExitingState::Ready;
 					});
-					PlayPlayerSfx("WarpIn"_s);
+					PlayPlayerSfx("WarpIn"_atom);
 
 					SetState(ActorState::ApplyGravitation, false);
 					_speed.X = 0.0f;
@@ -2582,7 +2588,7 @@ namespace Jazz2::Actors
 				return true;
 			}
 		} else {
-			PlayPlayerSfx("EndOfLevel"_s);
+			PlayPlayerSfx("EndOfLevel"_atom);
 
 			if (exitTypeMasked == ExitType::Warp || exitTypeMasked == ExitType::Bonus || exitTypeMasked == ExitType::Boss || _inWater) {
 				_levelExiting = LevelExitingState::WaitingForWarp;
@@ -2682,13 +2688,13 @@ namespace Jazz2::Actors
 			// For warping from the water
 			_renderer.setRotation(0.0f);
 
-			PlayPlayerSfx("WarpIn"_s);
+			PlayPlayerSfx("WarpIn"_atom);
 
 			SetPlayerTransition(_isFreefall ? AnimState::TransitionWarpInFreefall : AnimState::TransitionWarpIn, false, true, SpecialMoveType::None, [this, pos]() {
 				Vector2f posOld = _pos;
 				MoveInstantly(pos, MoveType::Absolute | MoveType::Force);
 				_trailLastPos = _pos;
-				PlayPlayerSfx("WarpOut"_s);
+				PlayPlayerSfx("WarpOut"_atom);
 
 				if (Vector2f(posOld.X - pos.X, posOld.Y - pos.Y).Length() > 250) {
 					_levelHandler->WarpCameraToTarget(shared_from_this());
@@ -2777,7 +2783,7 @@ namespace Jazz2::Actors
 
 		_controllableTimeout = 80.0f;
 
-		PlaySfx("Pole"_s, 0.8f, 0.6f);
+		PlaySfx("Pole"_atom, 0.8f, 0.6f);
 	}
 
 	void Player::NextPoleStage(bool horizontal, bool positive, int stagesLeft, float lastSpeed)
@@ -2795,7 +2801,7 @@ namespace Jazz2::Actors
 
 			_controllableTimeout = 80.0f;
 
-			PlaySfx("Pole"_s, 1.0f, 0.6f);
+			PlaySfx("Pole"_atom, 1.0f, 0.6f);
 		} else {
 			int sign = (positive ? 1 : -1);
 			if (horizontal) {
@@ -2827,7 +2833,7 @@ namespace Jazz2::Actors
 			_controllableTimeout = 4.0f;
 			_lastPoleTime = 10.0f;
 
-			PlaySfx("HookAttach"_s, 0.8f, 1.2f);
+			PlaySfx("HookAttach"_atom, 0.8f, 1.2f);
 		}
 	}
 
@@ -2871,7 +2877,7 @@ namespace Jazz2::Actors
 				_copterFramesLeft = 10.0f * FrameTimer::FramesPerSecond;
 
 				if (_copterSound == nullptr) {
-					_copterSound = PlaySfx("Copter"_s, 0.6f, 1.5f);
+					_copterSound = PlaySfx("Copter"_atom, 0.6f, 1.5f);
 					if (_copterSound != nullptr) {
 						_copterSound->setLooping(true);
 					}
@@ -2958,12 +2964,12 @@ namespace Jazz2::Actors
 				SetInvulnerability(180.0f, false);
 			}
 
-			PlaySfx("Hurt"_s);
+			PlaySfx("Hurt"_atom);
 		} else {
 			_externalForce.X = 0.0f;
 			_speed.Y = 0.0f;
 
-			PlayPlayerSfx("Die"_s, 1.3f);
+			PlayPlayerSfx("Die"_atom, 1.3f);
 		}
 
 		return true;
@@ -3031,13 +3037,13 @@ namespace Jazz2::Actors
 
 		if (amount < 0) {
 			_health = std::max(_maxHealth, HealthLimit);
-			PlaySfx("PickupMaxCarrot"_s);
+			PlaySfx("PickupMaxCarrot"_atom);
 		} else {
 			_health = std::min(_health + amount, HealthLimit);
 			if (_maxHealth < _health) {
 				_maxHealth = _health;
 			}
-			PlaySfx("PickupFood"_s);
+			PlaySfx("PickupFood"_atom);
 		}
 
 		return true;
@@ -3047,21 +3053,21 @@ namespace Jazz2::Actors
 	{
 		_lives += count;
 
-		PlaySfx("PickupOneUp"_s);
+		PlaySfx("PickupOneUp"_atom);
 	}
 
 	void Player::AddCoins(int count)
 	{
 		_coins += count;
 		_levelHandler->ShowCoins(_coins);
-		PlaySfx("PickupCoin"_s);
+		PlaySfx("PickupCoin"_atom);
 	}
 
 	void Player::AddGems(int count)
 	{
 		_gems += count;
 		_levelHandler->ShowGems(_gems);
-		PlaySfx("PickupGem"_s, 1.0f, std::min(0.7f + _gemsPitch * 0.05f, 1.3f));
+		PlaySfx("PickupGem"_atom, 1.0f, std::min(0.7f + _gemsPitch * 0.05f, 1.3f));
 
 		_gemsTimer = 120.0f;
 		_gemsPitch++;
@@ -3070,9 +3076,9 @@ namespace Jazz2::Actors
 	void Player::ConsumeFood(bool isDrinkable)
 	{
 		if (isDrinkable) {
-			PlaySfx("PickupDrink"_s);
+			PlaySfx("PickupDrink"_atom);
 		} else {
-			PlaySfx("PickupFood"_s);
+			PlaySfx("PickupFood"_atom);
 		}
 
 		_foodEaten++;
@@ -3127,7 +3133,7 @@ namespace Jazz2::Actors
 			}
 		}
 
-		PlaySfx("PickupAmmo"_s);
+		PlaySfx("PickupAmmo"_atom);
 		return true;
 	}
 
@@ -3149,7 +3155,7 @@ namespace Jazz2::Actors
 
 		_weaponUpgrades[(int)WeaponType::Blaster] = (uint8_t)((_weaponUpgrades[(int)WeaponType::Blaster] & 0x1) | (current << 1));
 
-		PlaySfx("PickupAmmo"_s);
+		PlaySfx("PickupAmmo"_atom);
 
 		return true;
 	}
@@ -3201,7 +3207,7 @@ namespace Jazz2::Actors
 
 		// Set transition
 		if (type == PlayerType::Frog) {
-			PlaySfx("Transform");
+			PlaySfx("Transform"_atom);
 
 			_controllable = false;
 			_controllableTimeout = 120.0f;
@@ -242,6 +242,7 @@ namespace Jazz2::Actors
 		void OnHandleWater();
 		void OnHandleAreaEvents(float timeMult, bool& areaWeaponAllowed, int& areaWaterBlock);
 
+		std::shared_ptr<AudioBufferPlayer> PlayPlayerSfx(Atom identifier, float gain = 1.0f, float pitch = 1.0f);
 		std::shared_ptr<AudioBufferPlayer> PlayPlayerSfx(const StringView& identifier, float gain = 1.0f, float pitch = 1.0f);
 		bool SetPlayerTransition(AnimState state, bool cancellable, bool removeControl, SpecialMoveType specialMove, const std::function<void()>& callback = nullptr);
 		void InitialPoleStage(bool horizontal);
@@ -28,7 +28,7 @@ namespace Jazz2::Actors
 				break;
 		}
 
-		SetAnimation("Corpse"_s);
+		SetAnimation("Corpse"_atom);
 
 		async_return true;
 	}
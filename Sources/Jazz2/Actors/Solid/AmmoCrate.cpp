@@ -30,15 +30,15 @@ namespace Jazz2::Actors::Solid
 		async_await RequestMetadataAsync("Object/CrateContainer"_s);
 
 		switch (weaponType) {
-			case WeaponType::Bouncer: SetAnimation("CrateAmmoBouncer"_s); break;
-			case WeaponType::Freezer: SetAnimation("CrateAmmoFreezer"_s); break;
-			case WeaponType::Seeker:SetAnimation("CrateAmmoSeeker"_s); break;
-			case WeaponType::RF: SetAnimation("CrateAmmoRF"_s); break;
-			case WeaponType::Toaster: SetAnimation("CrateAmmoToaster"_s); break;
-			case WeaponType::TNT:SetAnimation("CrateAmmoTNT"_s); break;
-			case WeaponType::Pepper: SetAnimation("CrateAmmoPepper"_s); break;
-			case WeaponType::Electro: SetAnimation("CrateAmmoElectro"_s); break;
-			case WeaponType::Thunderbolt: SetAnimation("CrateAmmoThunderbolt"_s); break;
+			case WeaponType::Bouncer: SetAnimation("CrateAmmoBouncer"_atom); break;
+			case WeaponType::Freezer: SetAnimation("CrateAmmoFreezer"_atom); break;
+			case WeaponType::Seeker:SetAnimation("CrateAmmoSeeker"_atom); break;
+			case WeaponType::RF: SetAnimation("CrateAmmoRF"_atom); break;
+			case WeaponType::Toaster: SetAnimation("CrateAmmoToaster"_atom); break;
+			case WeaponType::TNT:SetAnimation("CrateAmmoTNT"_atom); break;
+			case WeaponType::Pepper: SetAnimation("CrateAmmoPepper"_atom); break;
+			case WeaponType::Electro: SetAnimation("CrateAmmoElectro"_atom); break;
+			case WeaponType::Thunderbolt: SetAnimation("CrateAmmoThunderbolt"_atom); break;
 			default: SetAnimation(AnimState::Idle); break;
 		}
 
@@ -76,7 +76,7 @@ namespace Jazz2::Actors::Solid
 
 		CreateParticleDebris();
 
-		PlaySfx("Break"_s);
+		PlaySfx("Break"_atom);
 
 		if (_content.empty()) {
 			// Random Ammo create
@@ -101,8 +101,8 @@ namespace Jazz2::Actors::Solid
 				AddContent(EventType::Ammo, 1, &weaponType, sizeof(weaponType));
 			}
 
-			CreateSpriteDebris("CrateShrapnel1"_s, 3);
-			CreateSpriteDebris("CrateShrapnel2"_s, 2);
+			CreateSpriteDebris("CrateShrapnel1"_atom, 3);
+			CreateSpriteDebris("CrateShrapnel2"_atom, 2);
 
 			_frozenTimeLeft = std::min(1.0f, _frozenTimeLeft);
 			SetTransition(AnimState::TransitionDeath, false, [this, collider]() {
@@ -111,8 +111,8 @@ namespace Jazz2::Actors::Solid
 			SpawnContent();
 			return true;
 		} else {
-			CreateSpriteDebris("CrateAmmoShrapnel1"_s, 3);
-			CreateSpriteDebris("CrateAmmoShrapnel2"_s, 2);
+			CreateSpriteDebris("CrateAmmoShrapnel1"_atom, 3);
+			CreateSpriteDebris("CrateAmmoShrapnel2"_atom, 2);
 
 			return GenericContainer::OnPerish(collider);
 		}
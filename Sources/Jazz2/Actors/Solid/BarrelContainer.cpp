@@ -64,14 +64,14 @@ namespace Jazz2::Actors::Solid
 
 	bool BarrelContainer::OnPerish(ActorBase* collider)
 	{
-		PlaySfx("Break"_s);
+		PlaySfx("Break"_atom);
 
 		CreateParticleDebris();
 
-		CreateSpriteDebris("BarrelShrapnel1"_s, 3);
-		CreateSpriteDebris("BarrelShrapnel2"_s, 3);
-		CreateSpriteDebris("BarrelShrapnel3"_s, 2);
-		CreateSpriteDebris("BarrelShrapnel4"_s, 1);
+		CreateSpriteDebris("BarrelShrapnel1"_atom, 3);
+		CreateSpriteDebris("BarrelShrapnel2"_atom, 3);
+		CreateSpriteDebris("BarrelShrapnel3"_atom, 2);
+		CreateSpriteDebris("BarrelShrapnel4"_atom, 1);
 
 		return GenericContainer::OnPerish(collider);
 	}
@@ -65,7 +65,7 @@ namespace Jazz2::Actors::Solid
 			case BridgeType::Lab: async_await RequestMetadataAsync("Bridge/Lab"_s); _widths = PieceWidthsLab; _widthsCount = countof(PieceWidthsLab); _widthOffset = 12; break;
 		}
 
-		SetAnimation("Piece"_s);
+		SetAnimation("Piece"_atom);
 
 		int widthCovered = _widths[0] / 2 - _widthOffset;
 		for (int i = 0; widthCovered <= _bridgeWidth + 4; i++) {
@@ -170,14 +170,13 @@ namespace Jazz2::Actors::Solid
 				int col = curAnimFrame % _currentAnimation->Base->FrameConfiguration.X;
 				int row = curAnimFrame / _currentAnimation->Base->FrameConfiguration.X;
 				float texScaleX = (float(_currentAnimation->Base->FrameDimensions.X) / float(texSize.X));
-				float texBiasX = (float(_currentAnimation->Base->FrameDimensions.X * col) / float(texSize.X));
+				float texBiasX = (float(_currentAnimation->Base->TextureOffset.X + _currentAnimation->Base->FrameDimensions.X * col) / float(texSize.X));
 				float texScaleY = (float(_currentAnimation->Base->FrameDimensions.Y) / float(texSize.Y));
-				float texBiasY = (float(_currentAnimation->Base->FrameDimensions.Y * row) / float(texSize.Y));
+				float texBiasY = (float(_currentAnimation->Base->TextureOffset.Y + _currentAnimation->Base->FrameDimensions.Y * row) / float(texSize.Y));
 
-				auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-				instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(texScaleX, texBiasX, texScaleY, texBiasY);
-				instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(_currentAnimation->Base->FrameDimensions.X, _currentAnimation->Base->FrameDimensions.Y);
-				instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf::White.Data());
+				command->material().setInstanceTexRect(texScaleX, texBiasX, texScaleY, texBiasY);
+				command->material().setInstanceSpriteSize(_currentAnimation->Base->FrameDimensions.X, _currentAnimation->Base->FrameDimensions.Y);
+				command->material().setInstanceColor(Colorf::White.Data());
 
 				auto& pos = _pieces[i].Pos;
 				command->setTransformation(Matrix4x4f::Translation(pos.X, pos.Y, 0.0f));
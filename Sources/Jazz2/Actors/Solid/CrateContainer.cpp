@@ -64,10 +64,10 @@ namespace Jazz2::Actors::Solid
 
 		CreateParticleDebris();
 
-		PlaySfx("Break"_s);
+		PlaySfx("Break"_atom);
 
-		CreateSpriteDebris("CrateShrapnel1"_s, 3);
-		CreateSpriteDebris("CrateShrapnel2"_s, 2);
+		CreateSpriteDebris("CrateShrapnel1"_atom, 3);
+		CreateSpriteDebris("CrateShrapnel2"_atom, 2);
 
 		_frozenTimeLeft = std::min(1.0f, _frozenTimeLeft);
 		SetTransition(AnimState::TransitionDeath, false, [this, collider]() {
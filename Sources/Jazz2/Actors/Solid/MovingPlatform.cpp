@@ -63,7 +63,7 @@ namespace Jazz2::Actors::Solid
 			case PlatformType::SpikeBall: async_await RequestMetadataAsync("MovingPlatform/SpikeBall"_s); break;
 		}
 
-		SetAnimation("Platform"_s);
+		SetAnimation("Platform"_atom);
 
 		for (int i = 0; i < length; i++) {
 			ChainPiece& piece = _pieces.emplace_back();
@@ -209,7 +209,7 @@ namespace Jazz2::Actors::Solid
 	bool MovingPlatform::OnDraw(RenderQueue& renderQueue)
 	{
 		if (!_pieces.empty()) {
-			auto it = _metadata->Graphics.find(String::nullTerminatedView("Chain"_s));
+			auto it = _metadata->Graphics.find("Chain"_atom);
 			if (it != _metadata->Graphics.end()) {
 				auto& chainAnim = it->second;
 				Vector2i texSize = chainAnim.Base->TextureDiffuse->size();
@@ -221,14 +221,13 @@ namespace Jazz2::Actors::Solid
 					int col = curAnimFrame % chainAnim.Base->FrameConfiguration.X;
 					int row = curAnimFrame / chainAnim.Base->FrameConfiguration.X;
 					float texScaleX = (float(chainAnim.Base->FrameDimensions.X) / float(texSize.X));
-					float texBiasX = (float(chainAnim.Base->FrameDimensions.X * col) / float(texSize.X));
+					float texBiasX = (float(chainAnim.Base->TextureOffset.X + chainAnim.Base->FrameDimensions.X * col) / float(texSize.X));
 					float texScaleY = (float(chainAnim.Base->FrameDimensions.Y) / float(texSize.Y));
-					float texBiasY = (float(chainAnim.Base->FrameDimensions.Y * row) / float(texSize.Y));
+					float texBiasY = (float(chainAnim.Base->TextureOffset.Y + chainAnim.Base->FrameDimensions.Y * row) / float(texSize.Y));
 
-					auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-					instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(texScaleX, texBiasX, texScaleY, texBiasY);
-					instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(chainAnim.Base->FrameDimensions.X, chainAnim.Base->FrameDimensions.Y);
-					instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf::White.Data());
+					command->material().setInstanceTexRect(texScaleX, texBiasX, texScaleY, texBiasY);
+					command->material().setInstanceSpriteSize(chainAnim.Base->FrameDimensions.X, chainAnim.Base->FrameDimensions.Y);
+					command->material().setInstanceColor(Colorf::White.Data());
 
 					auto& pos = _pieces[i].Pos;
 					command->setTransformation(Matrix4x4f::Translation(pos.X, pos.Y, 0.0f));
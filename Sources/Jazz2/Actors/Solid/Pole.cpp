@@ -57,7 +57,7 @@ namespace Jazz2::Actors::Solid
 			SetState(ActorState::IsSolidObject, true);
 		}
 
-		SetAnimation("Pole"_s);
+		SetAnimation("Pole"_atom);
 
 		async_return true;
 	}
@@ -80,7 +80,7 @@ namespace Jazz2::Actors::Solid
 				if (_bouncesLeft > 0) {
 					if (_bouncesLeft == BouncesMax) {
 						_angleVelLast = _angleVel;
-						PlaySfx("FallEnd"_s, 0.8f);
+						PlaySfx("FallEnd"_atom, 0.8f);
 					}
 
 					_bouncesLeft--;
@@ -101,7 +101,7 @@ namespace Jazz2::Actors::Solid
 				if (_bouncesLeft > 0) {
 					if (_bouncesLeft == BouncesMax) {
 						_angleVelLast = _angleVel;
-						PlaySfx("FallEnd"_s, 0.8f);
+						PlaySfx("FallEnd"_atom, 0.8f);
 					}
 
 					_bouncesLeft--;
@@ -153,7 +153,7 @@ namespace Jazz2::Actors::Solid
 
 		_fall = dir;
 		SetState(ActorState::IsInvulnerable | ActorState::IsSolidObject, true);
-		PlaySfx("FallStart"_s, 0.6f);
+		PlaySfx("FallStart"_atom, 0.6f);
 	}
 
 	bool Pole::IsPositionBlocked()
@@ -28,9 +28,9 @@ namespace Jazz2::Actors::Solid
 		async_await RequestMetadataAsync("Object/PowerUpMonitor"_s);
 
 		switch (_morphType) {
-			case MorphType::Swap2: SetAnimation("Swap2"_s); break;
-			case MorphType::Swap3: SetAnimation("Swap3"_s); break;
-			case MorphType::ToBird: SetAnimation("Bird"_s); break;
+			case MorphType::Swap2: SetAnimation("Swap2"_atom); break;
+			case MorphType::Swap3: SetAnimation("Swap3"_atom); break;
+			case MorphType::ToBird: SetAnimation("Bird"_atom); break;
 		}
 
 		auto& players = _levelHandler->GetPlayers();
@@ -96,7 +96,7 @@ namespace Jazz2::Actors::Solid
 			player->MorphTo(playerType.value());
 
 			DecreaseHealth(INT32_MAX, player);
-			PlaySfx("Break"_s);
+			PlaySfx("Break"_atom);
 		}
 	}
 
@@ -26,12 +26,12 @@ namespace Jazz2::Actors::Solid
 		async_await RequestMetadataAsync("Object/PowerUpMonitorShield"_s);
 
 		switch (_shieldType) {
-			case ShieldType::Fire: SetAnimation("ShieldFire"_s); break;
-			case ShieldType::Water: SetAnimation("ShieldWater"_s); break;
-			case ShieldType::Laser: SetAnimation("ShieldLaser"_s); break;
-			case ShieldType::Lightning: SetAnimation("ShieldLightning"_s); break;
+			case ShieldType::Fire: SetAnimation("ShieldFire"_atom); break;
+			case ShieldType::Water: SetAnimation("ShieldWater"_atom); break;
+			case ShieldType::Laser: SetAnimation("ShieldLaser"_atom); break;
+			case ShieldType::Lightning: SetAnimation("ShieldLightning"_atom); break;
 
-			default: SetAnimation("Empty"_s); break;
+			default: SetAnimation("Empty"_atom); break;
 		}
 
 		async_return true;
@@ -84,6 +84,6 @@ namespace Jazz2::Actors::Solid
 		//player->SetShield(_shieldType, 30.0f);
 
 		DecreaseHealth(INT32_MAX, player);
-		PlaySfx("Break"_s);
+		PlaySfx("Break"_atom);
 	}
 }
\ No newline at end of file
@@ -34,21 +34,21 @@ namespace Jazz2::Actors::Solid
 				PlayerType playerType = (!players.empty() ? players[0]->GetPlayerType() : PlayerType::Jazz);
 				switch (playerType) {
 					default:
-					case PlayerType::Jazz: SetAnimation("BlasterJazz"_s); break;
-					case PlayerType::Spaz: SetAnimation("BlasterSpaz"_s); break;
-					case PlayerType::Lori: SetAnimation("BlasterLori"_s); break;
+					case PlayerType::Jazz: SetAnimation("BlasterJazz"_atom); break;
+					case PlayerType::Spaz: SetAnimation("BlasterSpaz"_atom); break;
+					case PlayerType::Lori: SetAnimation("BlasterLori"_atom); break;
 				}
 				break;
 			}
-			case WeaponType::Bouncer: SetAnimation("Bouncer"_s); break;
-			case WeaponType::Freezer: SetAnimation("Freezer"_s); break;
-			case WeaponType::Seeker:SetAnimation("Seeker"_s); break;
-			case WeaponType::RF: SetAnimation("RF"_s); break;
-			case WeaponType::Toaster: SetAnimation("Toaster"_s); break;
-			case WeaponType::TNT:SetAnimation("TNT"_s); break;
-			case WeaponType::Pepper: SetAnimation("Pepper"_s); break;
-			case WeaponType::Electro: SetAnimation("Electro"_s); break;
-			case WeaponType::Thunderbolt: SetAnimation("Thunderbolt"_s); break;
+			case WeaponType::Bouncer: SetAnimation("Bouncer"_atom); break;
+			case WeaponType::Freezer: SetAnimation("Freezer"_atom); break;
+			case WeaponType::Seeker:SetAnimation("Seeker"_atom); break;
+			case WeaponType::RF: SetAnimation("RF"_atom); break;
+			case WeaponType::Toaster: SetAnimation("Toaster"_atom); break;
+			case WeaponType::TNT:SetAnimation("TNT"_atom); break;
+			case WeaponType::Pepper: SetAnimation("Pepper"_atom); break;
+			case WeaponType::Electro: SetAnimation("Electro"_atom); break;
+			case WeaponType::Thunderbolt: SetAnimation("Thunderbolt"_atom); break;
 		}
 
 		async_return true;
@@ -101,6 +101,6 @@ namespace Jazz2::Actors::Solid
 		player->AddAmmo(_weaponType, 25);
 
 		DecreaseHealth(INT32_MAX, player);
-		PlaySfx("Break"_s);
+		PlaySfx("Break"_atom);
 	}
 }
\ No newline at end of file
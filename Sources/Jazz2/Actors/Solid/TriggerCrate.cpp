@@ -31,7 +31,7 @@ namespace Jazz2::Actors::Solid
 
 		async_await RequestMetadataAsync("Object/TriggerCrate"_s);
 
-		SetAnimation("Crate"_s);
+		SetAnimation("Crate"_atom);
 
 		async_return true;
 	}
@@ -78,7 +78,7 @@ namespace Jazz2::Actors::Solid
 			}
 		}
 
-		PlaySfx("Break"_s);
+		PlaySfx("Break"_atom);
 
 		CreateParticleDebris();
 
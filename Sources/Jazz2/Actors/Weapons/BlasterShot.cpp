@@ -80,7 +80,7 @@ namespace Jazz2::Actors::Weapons
 		ShotBase::OnUpdate(timeMult);
 
 		if (_timeLeft <= 0.0f) {
-			PlaySfx("WallPoof"_s);
+			PlaySfx("WallPoof"_atom);
 		}
 
 		_fired++;
@@ -128,7 +128,7 @@ namespace Jazz2::Actors::Weapons
 
 		DecreaseHealth(INT32_MAX);
 
-		PlaySfx("WallPoof"_s);
+		PlaySfx("WallPoof"_atom);
 	}
 
 	void BlasterShot::OnRicochet()
@@ -137,6 +137,6 @@ namespace Jazz2::Actors::Weapons
 
 		_renderer.setRotation(atan2f(_speed.Y, _speed.X));
 
-		PlaySfx("Ricochet"_s);
+		PlaySfx("Ricochet"_atom);
 	}
 }
\ No newline at end of file
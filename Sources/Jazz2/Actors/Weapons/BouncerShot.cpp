@@ -29,10 +29,10 @@ namespace Jazz2::Actors::Weapons
 		if ((_upgrades & 0x1) != 0) {
 			_timeLeft = 130;
 			state |= (AnimState)1;
-			PlaySfx("FireUpgraded"_s, 1.0f, 0.5f);
+			PlaySfx("FireUpgraded"_atom, 1.0f, 0.5f);
 		} else {
 			_timeLeft = 90;
-			PlaySfx("Fire"_s, 1.0f, 0.5f);
+			PlaySfx("Fire"_atom, 1.0f, 0.5f);
 		}
 
 		SetAnimation(state);
@@ -122,7 +122,7 @@ namespace Jazz2::Actors::Weapons
 		}
 
 		_hitLimit += 2.0f;
-		PlaySfx("Bounce"_s, 0.5f);
+		PlaySfx("Bounce"_atom, 0.5f);
 	}
 
 	void BouncerShot::OnHitFloor(float timeMult)
@@ -133,7 +133,7 @@ namespace Jazz2::Actors::Weapons
 		}
 
 		_hitLimit += 2.0f;
-		PlaySfx("Bounce"_s, 0.5f);
+		PlaySfx("Bounce"_atom, 0.5f);
 	}
 
 	void BouncerShot::OnHitCeiling(float timeMult)
@@ -144,7 +144,7 @@ namespace Jazz2::Actors::Weapons
 		}
 
 		_hitLimit += 2.0f;
-		PlaySfx("Bounce"_s, 0.5f);
+		PlaySfx("Bounce"_atom, 0.5f);
 	}
 
 	void BouncerShot::OnRicochet()
@@ -30,7 +30,7 @@ namespace Jazz2::Actors::Weapons
 
 		async_await RequestMetadataAsync("Weapon/Electro"_s);
 		SetAnimation(AnimState::Idle);
-		PlaySfx("Fire"_s);
+		PlaySfx("Fire"_atom);
 
 		_renderer.setDrawEnabled(false);
 
@@ -79,7 +79,7 @@ namespace Jazz2::Actors::Weapons
 
 				auto tilemap = _levelHandler->TileMap();
 				if (tilemap != nullptr) {
-					auto it = _metadata->Graphics.find(String::nullTerminatedView("Particle"_s));
+					auto it = _metadata->Graphics.find("Particle"_atom);
 					if (it != _metadata->Graphics.end()) {
 						auto& resBase = it->second.Base;
 						Vector2i texSize = resBase->TextureDiffuse->size();
@@ -112,9 +112,9 @@ namespace Jazz2::Actors::Weapons
 							int col = curAnimFrame % resBase->FrameConfiguration.X;
 							int row = curAnimFrame / resBase->FrameConfiguration.X;
 							debris.TexScaleX = (float(resBase->FrameDimensions.X) / float(texSize.X));
-							debris.TexBiasX = (float(resBase->FrameDimensions.X * col) / float(texSize.X));
+							debris.TexBiasX = (float(resBase->TextureOffset.X + resBase->FrameDimensions.X * col) / float(texSize.X));
 							debris.TexScaleY = (float(resBase->FrameDimensions.Y) / float(texSize.Y));
-							debris.TexBiasY = (float(resBase->FrameDimensions.Y * row) / float(texSize.Y));
+							debris.TexBiasY = (float(resBase->TextureOffset.Y + resBase->FrameDimensions.Y * row) / float(texSize.Y));
 
 							debris.DiffuseTexture = resBase->TextureDiffuse.get();
 
@@ -34,13 +34,13 @@ namespace Jazz2::Actors::Weapons
 		if ((_upgrades & 0x01) != 0) {
 			_timeLeft = 38;
 			state |= (AnimState)1;
-			PlaySfx("FireUpgraded"_s);
+			PlaySfx("FireUpgraded"_atom);
 
 			// TODO: Add better upgraded effect
 			_renderer.setScale(1.2f);
 		} else {
 			_timeLeft = 44;
-			PlaySfx("Fire"_s);
+			PlaySfx("Fire"_atom);
 		}
 
 		SetAnimation(state);
@@ -82,7 +82,7 @@ namespace Jazz2::Actors::Weapons
 		// TODO: Add particles
 
 		if (_timeLeft <= 0.0f) {
-			PlaySfx("WallPoof"_s);
+			PlaySfx("WallPoof"_atom);
 		}
 
 		_fired++;
@@ -103,7 +103,7 @@ namespace Jazz2::Actors::Weapons
 				float dy = Random().FastFloat(-3.0f, 3.0f);
 
 				constexpr float currentSize = 1.0f;
-				int currentFrame = _renderer.CurrentFrame;
+				Recti frameRect = resBase->GetFrameRect(_renderer.CurrentFrame);
 
 				Tiles::TileMap::DestructibleDebris debris = { };
 				debris.Pos = Vector2f(_pos.X + dx, _pos.Y + dy);
@@ -117,9 +117,9 @@ namespace Jazz2::Actors::Weapons
 				debris.Time = 300.0f;
 
 				debris.TexScaleX = (currentSize / float(texSize.X));
-				debris.TexBiasX = (((float)(_renderer.CurrentFrame % resBase->FrameConfiguration.X) / resBase->FrameConfiguration.X) + (((resBase->FrameDimensions.X * 0.5f) + dx) / float(texSize.X)));
+				debris.TexBiasX = ((frameRect.X + (frameRect.W * 0.5f) + dx) / float(texSize.X));
 				debris.TexScaleY = (currentSize / float(texSize.Y));
-				debris.TexBiasY = (((float)(_renderer.CurrentFrame / resBase->FrameConfiguration.X) / resBase->FrameConfiguration.Y) + (((resBase->FrameDimensions.Y * 0.5f) + dy) / float(texSize.Y)));
+				debris.TexBiasY = ((frameRect.Y + (frameRect.H * 0.5f) + dy) / float(texSize.Y));
 
 				debris.DiffuseTexture = resBase->TextureDiffuse.get();
 				debris.Flags = Tiles::TileMap::DebrisFlags::Disappear;
@@ -163,13 +163,13 @@ namespace Jazz2::Actors::Weapons
 	{
 		DecreaseHealth(INT32_MAX);
 
-		PlaySfx("WallPoof"_s);
+		PlaySfx("WallPoof"_atom);
 	}
 
 	void FreezerShot::OnRicochet()
 	{
 		DecreaseHealth(INT32_MAX);
 
-		PlaySfx("WallPoof"_s);
+		PlaySfx("WallPoof"_atom);
 	}
 }
\ No newline at end of file
@@ -34,7 +34,7 @@ namespace Jazz2::Actors::Weapons
 		}
 
 		SetAnimation(state);
-		PlaySfx("Fire"_s);
+		PlaySfx("Fire"_atom);
 
 		_renderer.setBlendingPreset(DrawableNode::BlendingPreset::ADDITIVE);
 
@@ -33,7 +33,7 @@ namespace Jazz2::Actors::Weapons
 		}
 
 		SetAnimation(state);
-		PlaySfx("Fire"_s, 0.4f);
+		PlaySfx("Fire"_atom, 0.4f);
 
 		async_return true;
 	}
@@ -115,7 +115,7 @@ namespace Jazz2::Actors::Weapons
 
 		Explosion::Create(_levelHandler, Vector3i((int)(_pos.X + _speed.X), (int)(_pos.Y + _speed.Y), _renderer.layer() + 2), Explosion::Type::RF);
 
-		PlaySfx("Explode"_s, 0.6f);
+		PlaySfx("Explode"_atom, 0.6f);
 
 		return ShotBase::OnPerish(collider);
 	}
@@ -43,7 +43,7 @@ namespace Jazz2::Actors::Weapons
 		}
 
 		SetAnimation(state);
-		PlaySfx("Fire"_s);
+		PlaySfx("Fire"_atom);
 
 		async_return true;
 	}
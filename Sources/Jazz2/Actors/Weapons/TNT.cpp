@@ -80,7 +80,7 @@ namespace Jazz2::Actors::Weapons
 
 					_renderer.setScale(5.0f);
 					if (_noise == nullptr) {
-						_noise = PlaySfx(Random().NextBool() ? "Bell1"_s : "Bell2"_s);
+						_noise = PlaySfx(Random().NextBool() ? "Bell1"_atom : "Bell2"_atom);
 					} else if (!_noise->isPlaying()) {
 						_noise->play();
 					}
@@ -97,7 +97,7 @@ namespace Jazz2::Actors::Weapons
 			});
 
 			_renderer.setScale(1.0f);
-			PlaySfx("Explosion"_s);
+			PlaySfx("Explosion"_atom);
 
 			_levelHandler->FindCollisionActorsByRadius(_pos.X, _pos.Y, 50.0f, [this](ActorBase* actor) {
 				actor->OnHandleCollision(shared_from_this());
@@ -0,0 +1,359 @@
+﻿#include "CacheManifest.h"
+#include "../ContentResolver.h"
+
+#include "../../nCine/Base/HashFunctions.h"
+#include "../../nCine/IO/GrowableMemoryFile.h"
+
+#include <cstring>
+
+namespace Jazz2::Compatibility
+{
+	CacheManifest::CacheManifest(const StringView& cachePath)
+		: _cachePath(cachePath.trimmedSuffix("/\\"_s)), _flags(0)
+	{
+	}
+
+	bool CacheManifest::Load(const StringView& path)
+	{
+		_entries.clear();
+		_flags = 0;
+
+		auto s = fs::Open(path, FileAccessMode::Read);
+		int64_t fileSize = s->GetSize();
+		if (fileSize < 16 || fileSize > 64 * 1024 * 1024) {
+			return false;
+		}
+
+		// Whole file is loaded with a single read, every length and count is then checked against remaining bytes
+		auto buffer = std::make_unique<uint8_t[]>(fileSize);
+		if (s->Read(buffer.get(), (uint32_t)fileSize) != (uint32_t)fileSize) {
+			return false;
+		}
+		s->Close();
+
+		const uint8_t* data = buffer.get();
+		const int32_t size = (int32_t)fileSize;
+		int32_t offset = 0;
+		auto read = [&](auto& value) {
+			if (size - offset < (int32_t)sizeof(value)) {
+				return false;
+			}
+			std::memcpy(&value, data + offset, sizeof(value));
+			offset += sizeof(value);
+			return true;
+		};
+		auto readString = [&](String& value) {
+			uint16_t length;
+			if (!read(length) || length > size - offset) {
+				return false;
+			}
+			value = String(reinterpret_cast<const char*>(data + offset), length);
+			offset += length;
+			return true;
+		};
+
+		// Header always fits, because of the minimal file size
+		uint64_t signature;
+		uint8_t fileType;
+		uint16_t version;
+		read(signature);
+		read(fileType);
+		read(version);
+		if (signature != 0x2095A59FF0BFBBEF || fileType != ContentResolver::CacheIndexFile) {
+			return false;
+		}
+
+		// Protection flag is respected even if the manifest itself is incompatible
+		read(_flags);
+		if (version != FormatVersion) {
+			return false;
+		}
+
+		// Key length, source modification time, size, input hash, converter version, output and dependency count
+		constexpr int32_t MinEntrySize = sizeof(uint16_t) + 3 * sizeof(uint64_t) + sizeof(uint32_t) + 2 * sizeof(uint16_t);
+
+		uint32_t entryCount;
+		if (!read(entryCount) || entryCount > (uint32_t)((size - offset) / MinEntrySize)) {
+			LOGW_X("Cache manifest \"%s\" is corrupted", String::nullTerminatedView(path).data());
+			return false;
+		}
+		_entries.reserve(entryCount);
+
+		for (uint32_t i = 0; i < entryCount; i++) {
+			String key;
+			Entry entry;
+			entry.IsVisited = false;
+
+			uint16_t outputCount, dependencyCount;
+			bool isValid = (readString(key) && read(entry.SourceModified) && read(entry.SourceSize) &&
+				read(entry.InputHash) && read(entry.ConverterVersion) && read(outputCount));
+			for (uint32_t j = 0; j < outputCount && isValid; j++) {
+				isValid = readString(entry.Outputs.emplace_back());
+			}
+			isValid = (isValid && read(dependencyCount));
+			for (uint32_t j = 0; j < dependencyCount && isValid; j++) {
+				isValid = readString(entry.Dependencies.emplace_back());
+			}
+
+			if (!isValid) {
+				// File is truncated or corrupted, so nothing from it can be trusted
+				LOGW_X("Cache manifest \"%s\" is corrupted", String::nullTerminatedView(path).data());
+				_entries.clear();
+				return false;
+			}
+
+			_entries.emplace(std::move(key), std::move(entry));
+		}
+
+		return true;
+	}
+
+	bool CacheManifest::Save(const StringView& path)
+	{
+		GrowableMemoryFile so(4096);
+		so.WriteValue<uint64_t>(0x2095A59FF0BFBBEF);	// Signature
+		so.WriteValue<uint8_t>(ContentResolver::CacheIndexFile);
+		so.WriteValue<uint16_t>(FormatVersion);
+		so.WriteValue<uint8_t>(_flags);
+		so.WriteValue<uint32_t>((uint32_t)_entries.size());
+
+		for (auto& [key, entry] : _entries) {
+			so.WriteValue<uint16_t>((uint16_t)key.size());
+			so.Write(key.data(), (uint32_t)key.size());
+
+			so.WriteValue<uint64_t>(entry.SourceModified);
+			so.WriteValue<int64_t>(entry.SourceSize);
+			so.WriteValue<uint64_t>(entry.InputHash);
+			so.WriteValue<uint32_t>(entry.ConverterVersion);
+
+			so.WriteValue<uint16_t>((uint16_t)entry.Outputs.size());
+			for (auto& outputPath : entry.Outputs) {
+				so.WriteValue<uint16_t>((uint16_t)outputPath.size());
+				so.Write(outputPath.data(), (uint32_t)outputPath.size());
+			}
+
+			so.WriteValue<uint16_t>((uint16_t)entry.Dependencies.size());
+			for (auto& dependency : entry.Dependencies) {
+				so.WriteValue<uint16_t>((uint16_t)dependency.size());
+				so.Write(dependency.data(), (uint32_t)dependency.size());
+			}
+		}
+
+		String tempPath = path + ".tmp"_s;
+		auto s = fs::Open(tempPath, FileAccessMode::Write);
+		bool isWritten = (s->IsOpened() && s->Write(so.GetBuffer(), (uint32_t)so.GetSize()) == (uint32_t)so.GetSize());
+		s->Close();
+		if (!isWritten || !fs::Rename(tempPath, path)) {
+			fs::RemoveFile(tempPath);
+			return false;
+		}
+		return true;
+	}
+
+	bool CacheManifest::NeedsConversion(const StringView& key, const StringView& sourcePath, uint32_t converterVersion)
+	{
+		uint64_t sourceModified = fs::LastModificationTime(sourcePath).Ticks;
+		int64_t sourceSize = fs::FileSize(sourcePath);
+
+		auto it = _entries.find(String::nullTerminatedView(key));
+		if (it != _entries.end()) {
+			Entry& entry = it->second;
+			entry.IsVisited = true;
+
+			if (entry.ConverterVersion == converterVersion && HasAllOutputs(entry)) {
+				if (entry.SourceModified == sourceModified && entry.SourceSize == sourceSize) {
+					// Source file wasn't touched, so the content hash doesn't have to be computed
+					return false;
+				}
+
+				uint64_t inputHash = HashFile(sourcePath);
+				if (entry.InputHash == inputHash) {
+					// Only modification time was changed
+					entry.SourceModified = sourceModified;
+					entry.SourceSize = sourceSize;
+					return false;
+				}
+
+				entry.InputHash = inputHash;
+			} else {
+				entry.InputHash = HashFile(sourcePath);
+			}
+
+			entry.SourceModified = sourceModified;
+			entry.SourceSize = sourceSize;
+			entry.ConverterVersion = converterVersion;
+			entry.Outputs.clear();
+			entry.Dependencies.clear();
+			return true;
+		}
+
+		Entry entry;
+		entry.SourceModified = sourceModified;
+		entry.SourceSize = sourceSize;
+		entry.InputHash = HashFile(sourcePath);
+		entry.ConverterVersion = converterVersion;
+		entry.IsVisited = true;
+		_entries.emplace(key, std::move(entry));
+		return true;
+	}
+
+	bool CacheManifest::NeedsConversion(const StringView& key, uint64_t inputHash, uint32_t converterVersion)
+	{
+		auto it = _entries.find(String::nullTerminatedView(key));
+		if (it != _entries.end()) {
+			Entry& entry = it->second;
+			entry.IsVisited = true;
+
+			if (entry.InputHash == inputHash && entry.ConverterVersion == converterVersion && HasAllOutputs(entry)) {
+				return false;
+			}
+
+			entry.InputHash = inputHash;
+			entry.ConverterVersion = converterVersion;
+			entry.Outputs.clear();
+			entry.Dependencies.clear();
+			return true;
+		}
+
+		Entry entry;
+		entry.SourceModified = 0;
+		entry.SourceSize = 0;
+		entry.InputHash = inputHash;
+		entry.ConverterVersion = converterVersion;
+		entry.IsVisited = true;
+		_entries.emplace(key, std::move(entry));
+		return true;
+	}
+
+	void CacheManifest::Reset(const StringView& key, const StringView& sourcePath, uint32_t converterVersion)
+	{
+		Entry entry;
+		entry.SourceModified = fs::LastModificationTime(sourcePath).Ticks;
+		entry.SourceSize = fs::FileSize(sourcePath);
+		entry.InputHash = HashFile(sourcePath);
+		entry.ConverterVersion = converterVersion;
+		entry.IsVisited = true;
+
+		auto it = _entries.find(String::nullTerminatedView(key));
+		if (it != _entries.end()) {
+			it->second = std::move(entry);
+		} else {
+			_entries.emplace(key, std::move(entry));
+		}
+	}
+
+	void CacheManifest::AddOutput(const StringView& key, const StringView& outputPath)
+	{
+		auto it = _entries.find(String::nullTerminatedView(key));
+		if (it != _entries.end()) {
+			it->second.Outputs.emplace_back(outputPath);
+		}
+	}
+
+	void CacheManifest::AddDependency(const StringView& key, const StringView& dependency)
+	{
+		auto it = _entries.find(String::nullTerminatedView(key));
+		if (it != _entries.end()) {
+			for (auto& current : it->second.Dependencies) {
+				if (current == dependency) {
+					return;
+				}
+			}
+			it->second.Dependencies.emplace_back(dependency);
+		}
+	}
+
+	void CacheManifest::Invalidate(const StringView& key)
+	{
+		auto it = _entries.find(String::nullTerminatedView(key));
+		if (it != _entries.end()) {
+			it->second.ConverterVersion = 0;
+			it->second.InputHash = 0;
+		}
+	}
+
+	void CacheManifest::InvalidateAll(const StringView& keyPrefix)
+	{
+		for (auto& [key, entry] : _entries) {
+			if (key.hasPrefix(keyPrefix)) {
+				entry.ConverterVersion = 0;
+				entry.InputHash = 0;
+			}
+		}
+	}
+
+	ArrayView<const String> CacheManifest::GetOutputs(const StringView& key) const
+	{
+		auto it = _entries.find(String::nullTerminatedView(key));
+		if (it == _entries.end()) {
+			return { };
+		}
+		return arrayView(it->second.Outputs.data(), it->second.Outputs.size());
+	}
+
+	ArrayView<const String> CacheManifest::GetDependencies(const StringView& key) const
+	{
+		auto it = _entries.find(String::nullTerminatedView(key));
+		if (it == _entries.end()) {
+			return { };
+		}
+		return arrayView(it->second.Dependencies.data(), it->second.Dependencies.size());
+	}
+
+	void CacheManifest::RemoveUnvisited(const StringView& keyPrefix)
+	{
+		auto it = _entries.begin();
+		while (it != _entries.end()) {
+			if (!it->second.IsVisited && it->first.hasPrefix(keyPrefix)) {
+				for (auto& outputPath : it->second.Outputs) {
+					if (IsInCacheDirectory(outputPath)) {
+						fs::RemoveFile(outputPath);
+					} else {
+						LOGW_X("Output \"%s\" isn't in the cache directory, so it won't be removed", outputPath.data());
+					}
+				}
+				it = _entries.erase(it);
+			} else {
+				++it;
+			}
+		}
+	}
+
+	uint64_t CacheManifest::HashFile(const StringView& path)
+	{
+		auto s = fs::Open(path, FileAccessMode::Read);
+		int64_t fileSize = s->GetSize();
+		if (fileSize <= 0) {
+			return 0;
+		}
+
+		std::unique_ptr<uint8_t[]> buffer = std::make_unique<uint8_t[]>(fileSize);
+		s->Read(buffer.get(), (uint32_t)fileSize);
+		return fasthash64(buffer.get(), (size_t)fileSize, 0x01000193811C9DC5);
+	}
+
+	bool CacheManifest::HasAllOutputs(const Entry& entry) const
+	{
+		for (auto& outputPath : entry.Outputs) {
+			if (!fs::IsReadableFile(outputPath)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool CacheManifest::IsInCacheDirectory(const StringView& path) const
+	{
+		if (_cachePath.empty() || path.size() <= _cachePath.size() + 1 || !path.hasPrefix(_cachePath) ||
+			(path[_cachePath.size()] != '/' && path[_cachePath.size()] != '\\')) {
+			return false;
+		}
+		// Relative components could point outside of the directory
+		for (StringView part : path.exceptPrefix(_cachePath.size()).splitOnAnyWithoutEmptyParts("/\\"_s)) {
+			if (part == ".."_s) {
+				return false;
+			}
+		}
+		return true;
+	}
+}
\ No newline at end of file
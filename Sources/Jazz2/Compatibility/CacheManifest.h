@@ -0,0 +1,90 @@
+﻿#pragma once
+
+#include "../../Common.h"
+
+#include "../../nCine/Base/HashMap.h"
+#include "../../nCine/IO/FileSystem.h"
+
+#include <Containers/SmallVector.h>
+#include <Containers/String.h>
+#include <Containers/StringView.h>
+
+using namespace Death::Containers;
+using namespace nCine;
+
+namespace Jazz2::Compatibility
+{
+	/// Tracks converted artifacts in cache, so only changed inputs need to be converted again
+	class CacheManifest
+	{
+	public:
+		static constexpr uint16_t FormatVersion = 1;
+
+		/// Creates an empty manifest, only output files inside specified cache directory can be removed
+		explicit CacheManifest(const StringView& cachePath);
+
+		/// Loads the manifest, returns `false` if it doesn't exist, it's not compatible or it's corrupted
+		bool Load(const StringView& path);
+		/// Saves the manifest, unvisited entries are included too
+		/*! The file is written under a temporary name first, so an interrupted write never leaves a truncated file in place */
+		bool Save(const StringView& path);
+
+		/// Returns `true` if the cache shouldn't be overwritten
+		bool IsProtected() const {
+			return (_flags & 0x01) == 0x01;
+		}
+
+		/// Checks whether specified source file must be converted (again)
+		/*! Source file is hashed only if its size or modification time differs from the recorded one. If conversion
+			is needed, the entry is reset and new outputs have to be added using `AddOutput()` */
+		bool NeedsConversion(const StringView& key, const StringView& sourcePath, uint32_t converterVersion);
+		/// Checks whether an artifact with specified input hash must be converted (again)
+		bool NeedsConversion(const StringView& key, uint64_t inputHash, uint32_t converterVersion);
+		/// Registers the entry of specified source file as if it needs conversion, regardless of its current state
+		/*! Existing outputs and dependencies are forgotten and new ones have to be added using `AddOutput()` */
+		void Reset(const StringView& key, const StringView& sourcePath, uint32_t converterVersion);
+
+		/// Records an output file of the entry
+		void AddOutput(const StringView& key, const StringView& outputPath);
+		/// Records a dependency of the entry, e.g. tileset used by a level
+		void AddDependency(const StringView& key, const StringView& dependency);
+		/// Marks the entry as failed, so it will be converted again next time
+		void Invalidate(const StringView& key);
+		/// Marks all entries with specified key prefix as failed, so they will be converted again
+		void InvalidateAll(const StringView& keyPrefix);
+
+		/// Returns all output files of the entry
+		ArrayView<const String> GetOutputs(const StringView& key) const;
+		/// Returns all dependencies of the entry
+		ArrayView<const String> GetDependencies(const StringView& key) const;
+
+		/// Removes all entries with specified key prefix that weren't visited, including their output files
+		/*! Output files outside of the cache directory are never removed, even if they were recorded in the manifest */
+		void RemoveUnvisited(const StringView& keyPrefix);
+
+		static uint64_t HashFile(const StringView& path);
+
+	private:
+		struct Entry {
+			uint64_t SourceModified;
+			int64_t SourceSize;
+			uint64_t InputHash;
+			uint32_t ConverterVersion;
+			SmallVector<String, 1> Outputs;
+			SmallVector<String, 0> Dependencies;
+			bool IsVisited;
+		};
+
+		/// Deleted copy constructor
+		CacheManifest(const CacheManifest&) = delete;
+		/// Deleted assignment operator
+		CacheManifest& operator=(const CacheManifest&) = delete;
+
+		bool HasAllOutputs(const Entry& entry) const;
+		bool IsInCacheDirectory(const StringView& path) const;
+
+		String _cachePath;
+		HashMap<String, Entry> _entries;
+		uint8_t _flags;
+	};
+}
\ No newline at end of file
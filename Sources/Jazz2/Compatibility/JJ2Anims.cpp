@@ -2,13 +2,81 @@
 #include "JJ2Anims.Palettes.h"
 #include "JJ2Block.h"
 #include "AnimSetMapping.h"
+#include "CacheManifest.h"
 
+#include "../../nCine/Base/Algorithms.h"
+#include "../../nCine/Base/CpuDispatch.h"
+#include "../../nCine/Base/HashMap.h"
+#include "../../nCine/Base/HashFunctions.h"
 #include "../../nCine/IO/FileSystem.h"
+#include "../../nCine/Threading/Atomic.h"
+#include "../../nCine/tracy.h"
+
+#if defined(WITH_THREADS)
+#	include "../../nCine/Threading/Thread.h"
+#endif
 
 namespace Jazz2::Compatibility
 {
-	bool JJ2Anims::Convert(const StringView& path, const StringView& targetPath, bool isPlus)
+	namespace
 	{
+		/// Calls the function for all indices in range [0, count), work is distributed to all available processors
+		/*! Number of threads can be specified by `threadCount`, `0` means the number of processors. */
+		template<typename TFunc>
+		void ParallelFor(int32_t count, int32_t threadCount, TFunc&& func)
+		{
+			struct ParallelForContext {
+				Atomic32 NextIndex;
+				int32_t Count;
+				TFunc* Func;
+				void (*Worker)(void*);
+			};
+
+			auto worker = [](void* arg) {
+				auto* context = static_cast<ParallelForContext*>(arg);
+				while (true) {
+					int32_t i = context->NextIndex.fetchAdd(1);
+					if (i >= context->Count) {
+						break;
+					}
+					(*context->Func)(i);
+				}
+			};
+
+			ParallelForContext context;
+			context.Count = count;
+			context.Func = &func;
+			context.Worker = worker;
+
+#if defined(WITH_THREADS) && !defined(DEATH_TARGET_EMSCRIPTEN)
+			// The calling thread participates too, so one thread less is needed
+			if (threadCount <= 0) {
+				threadCount = (int32_t)Thread::GetProcessorCount();
+			}
+			threadCount = std::min(threadCount, count) - 1;
+			if (threadCount > 0) {
+				std::unique_ptr<Thread[]> threads = std::make_unique<Thread[]>(threadCount);
+				for (int32_t i = 0; i < threadCount; i++) {
+					threads[i].Run([](void* arg) {
+						Thread::SetSelfName("Converter");
+						ZoneScopedN("Converter");
+						static_cast<ParallelForContext*>(arg)->Worker(arg);
+					}, &context);
+				}
+				worker(&context);
+				for (int32_t i = 0; i < threadCount; i++) {
+					threads[i].Join();
+				}
+				return;
+			}
+#endif
+			worker(&context);
+		}
+	}
+
+	bool JJ2Anims::Convert(const StringView& path, const StringView& targetPath, bool isPlus, CacheManifest* manifest, int32_t threadCount)
+	{
+		ZoneScoped;
 		JJ2Version version;
 		SmallVector<AnimSection, 0> anims;
 		SmallVector<SampleSection, 0> samples;
@@ -40,8 +108,10 @@ namespace Jazz2::Compatibility
 
 		ASSERT(headerLen == s->GetPosition());
 
-		// Read content
+		// Read content, only headers are parsed here, blocks are decompressed later in parallel
 		bool isStreamComplete = true;
+		SmallVector<SetSection, 0> sets;
+		sets.reserve(setCount);
 
 		for (int32_t i = 0; i < setCount; i++) {
 			if (s->GetPosition() >= s->GetSize()) {
@@ -63,201 +133,37 @@ namespace Jazz2::Compatibility
 			int32_t imageDataBlockLenU = s->ReadValue<int32_t>();
 			int32_t sampleDataBlockLenC = s->ReadValue<int32_t>();
 			int32_t sampleDataBlockLenU = s->ReadValue<int32_t>();
-
-			JJ2Block infoBlock(s, infoBlockLenC, infoBlockLenU);
-			JJ2Block frameDataBlock(s, frameDataBlockLenC, frameDataBlockLenU);
-			JJ2Block imageDataBlock(s, imageDataBlockLenC, imageDataBlockLenU);
-			JJ2Block sampleDataBlock(s, sampleDataBlockLenC, sampleDataBlockLenU);
+			int32_t setDataLength = infoBlockLenC + frameDataBlockLenC + imageDataBlockLenC + sampleDataBlockLenC;
 
 			if (magicANIM != 0x4D494E41) {
 				LOGD_X("Header for set %i is incorrect (bad magic value), skipping", i);
+				s->Seek(setDataLength, SeekOrigin::Current);
 				continue;
 			}
 
-			for (uint16_t j = 0; j < animCount; j++) {
-				AnimSection& anim = anims.emplace_back();
-				anim.Set = i;
-				anim.Anim = j;
-				anim.FrameCount = infoBlock.ReadUInt16();
-				anim.FrameRate = infoBlock.ReadUInt16();
-				anim.Frames.resize(anim.FrameCount);
-
-				// Skip the rest, seems to be 0x00000000 for all headers
-				infoBlock.DiscardBytes(4);
-
-				if (anim.FrameCount > 0) {
-					/*if (setAnims.Count == 0) {
-						throw new InvalidDataException("Set has frames but no anims");
-					}*/
-
-					//int16_t lastColdspotX = 0, lastColdspotY = 0;
-					//int16_t lastHotspotX = 0, lastHotspotY = 0;
-					//int16_t lastGunspotX = 0, lastGunspotY = 0;
-
-					for (uint16_t j = 0; j < anim.FrameCount; j++) {
-						AnimFrameSection& frame = anim.Frames[j];
-
-						frame.SizeX = frameDataBlock.ReadInt16();
-						frame.SizeY = frameDataBlock.ReadInt16();
-						frame.ColdspotX = frameDataBlock.ReadInt16();
-						frame.ColdspotY = frameDataBlock.ReadInt16();
-						frame.HotspotX = frameDataBlock.ReadInt16();
-						frame.HotspotY = frameDataBlock.ReadInt16();
-						frame.GunspotX = frameDataBlock.ReadInt16();
-						frame.GunspotY = frameDataBlock.ReadInt16();
-
-						frame.ImageAddr = frameDataBlock.ReadInt32();
-						frame.MaskAddr = frameDataBlock.ReadInt32();
-
-						// Adjust normalized position
-						// In the output images, we want to make the hotspot and image size constant.
-						anim.NormalizedHotspotX = std::max((int16_t)-frame.HotspotX, anim.NormalizedHotspotX);
-						anim.NormalizedHotspotY = std::max((int16_t)-frame.HotspotY, anim.NormalizedHotspotY);
-
-						anim.LargestOffsetX = std::max((int16_t)(frame.SizeX + frame.HotspotX), anim.LargestOffsetX);
-						anim.LargestOffsetY = std::max((int16_t)(frame.SizeY + frame.HotspotY), anim.LargestOffsetY);
-
-						anim.AdjustedSizeX = std::max(
-							(int16_t)(anim.NormalizedHotspotX + anim.LargestOffsetX),
-							anim.AdjustedSizeX
-						);
-						anim.AdjustedSizeY = std::max(
-							(int16_t)(anim.NormalizedHotspotY + anim.LargestOffsetY),
-							anim.AdjustedSizeY
-						);
-
-						//lastColdspotX = frame.ColdspotX; lastColdspotY = frame.ColdspotY;
-						//lastHotspotX = frame.HotspotX; lastHotspotY = frame.HotspotY;
-						//lastGunspotX = frame.GunspotX; lastGunspotY = frame.GunspotY;
-
-						int32_t dpos = (frame.ImageAddr + 4);
-
-						imageDataBlock.SeekTo(dpos - 4);
-						uint16_t width2 = imageDataBlock.ReadUInt16();
-						imageDataBlock.SeekTo(dpos - 2);
-						/*uint16_t height2 =*/ imageDataBlock.ReadUInt16();
-
-						frame.DrawTransparent = (width2 & 0x8000) > 0;
-
-						int32_t pxRead = 0;
-						int32_t pxTotal = (frame.SizeX * frame.SizeY);
-						bool lastOpEmpty = true;
-
-						frame.ImageData = std::make_unique<uint8_t[]>(pxTotal);
-
-						imageDataBlock.SeekTo(dpos);
-
-						while (pxRead < pxTotal) {
-							uint8_t op = imageDataBlock.ReadByte();
-							//if (op == 0) {
-							//    Console.WriteLine("[" + i + ":" + j + "] Next image operation should probably not be 0x00.");
-							//}
-
-							if (op < 0x80) {
-								// Skip the given number of pixels, writing them with the transparent color 0, array should be already zeroed
-								pxRead += op;
-							} else if (op == 0x80) {
-								// Skip until the end of the line, array should be already zeroed
-								uint16_t linePxLeft = (uint16_t)(frame.SizeX - pxRead % frame.SizeX);
-								if (pxRead % frame.SizeX == 0 && !lastOpEmpty) {
-									linePxLeft = 0;
-								}
-
-								pxRead += linePxLeft;
-							} else {
-								// Copy specified amount of pixels (ignoring the high bit)
-								uint16_t bytesToRead = (uint16_t)(op & 0x7F);
-								imageDataBlock.ReadRawBytes(frame.ImageData.get() + pxRead, bytesToRead);
-								pxRead += bytesToRead;
-							}
-
-							lastOpEmpty = (op == 0x80);
-						}
-
-						// TODO: Sprite mask
-						/*frame.MaskData = std::make_unique<uint8_t[]>(pxTotal);
-
-						if (frame.MaskAddr != 0xFFFFFFFF) {
-							imageDataBlock.SeekTo(frame.MaskAddr);
-							pxRead = 0;
-							while (pxRead < pxTotal) {
-								uint8_t b = imageDataBlock.ReadByte();
-								for (uint8_t bit = 0; bit < 8 && (pxRead + bit) < pxTotal; ++bit) {
-									frame.MaskData[pxRead + bit] = ((b & (1 << (7 - bit))) != 0);
-								}
-								pxRead += 8;
-							}
-						}*/
-					}
-				}
+			SetSection& set = sets.emplace_back();
+			set.Index = i;
+			set.AnimCount = animCount;
+			set.SndCount = sndCount;
+			set.InfoBlockLenC = infoBlockLenC;
+			set.InfoBlockLenU = infoBlockLenU;
+			set.FrameDataBlockLenC = frameDataBlockLenC;
+			set.FrameDataBlockLenU = frameDataBlockLenU;
+			set.ImageDataBlockLenC = imageDataBlockLenC;
+			set.ImageDataBlockLenU = imageDataBlockLenU;
+			set.SampleDataBlockLenC = sampleDataBlockLenC;
+			set.SampleDataBlockLenU = sampleDataBlockLenU;
+			set.Data = std::make_unique<uint8_t[]>(setDataLength);
+			s->Read(set.Data.get(), setDataLength);
+
+			if (manifest != nullptr) {
+				// Compute content hash of the whole set, so unchanged sets don't have to be imported again
+				set.Hash = fasthash64(set.Data.get(), setDataLength, ((uint64_t)animCount << 8) | sndCount);
 			}
 
 			if (i == 65 && animCount > 5) {
 				seemsLikeCC = true;
 			}
-
-			for (uint16_t j = 0; j < sndCount; ++j) {
-				SampleSection& sample = samples.emplace_back();
-				sample.IdInSet = j;
-				sample.Set = i;
-
-				int32_t totalSize = sampleDataBlock.ReadInt32();
-				uint32_t magicRIFF = sampleDataBlock.ReadUInt32();
-				int32_t chunkSize = sampleDataBlock.ReadInt32();
-				// "ASFF" for 1.20, "AS  " for 1.24
-				uint32_t format = sampleDataBlock.ReadUInt32();
-				ASSERT(format == 0x46465341 || format == 0x20205341);
-				bool isASFF = (format == 0x46465341);
-
-				uint32_t magicSAMP = sampleDataBlock.ReadUInt32();
-				/*uint32_t sampSize =*/ sampleDataBlock.ReadUInt32();
-				ASSERT_MSG(magicRIFF == 0x46464952 && magicSAMP == 0x504D4153, "Sample has invalid header");
-
-				// Padding/unknown data #1
-				// For set 0 sample 0:
-				//       1.20                           1.24
-				//  +00  00 00 00 00 00 00 00 00   +00  40 00 00 00 00 00 00 00
-				//  +08  00 00 00 00 00 00 00 00   +08  00 00 00 00 00 00 00 00
-				//  +10  00 00 00 00 00 00 00 00   +10  00 00 00 00 00 00 00 00
-				//  +18  00 00 00 00               +18  00 00 00 00 00 00 00 00
-				//                                 +20  00 00 00 00 00 40 FF 7F
-				sampleDataBlock.DiscardBytes(40 - (isASFF ? 12 : 0));
-				if (isASFF) {
-					// All 1.20 samples seem to be 8-bit. Some of them are among those
-					// for which 1.24 reads as 24-bit but that might just be a mistake.
-					sampleDataBlock.DiscardBytes(2);
-					sample.Multiplier = 0;
-				} else {
-					// for 1.24. 1.20 has "20 40" instead in s0s0 which makes no sense
-					sample.Multiplier = sampleDataBlock.ReadUInt16();
-				}
-				// Unknown. s0s0 1.20: 00 80, 1.24: 80 00
-				sampleDataBlock.DiscardBytes(2);
-
-				/*uint32_t payloadSize =*/ sampleDataBlock.ReadUInt32();
-				// Padding #2, all zeroes in both
-				sampleDataBlock.DiscardBytes(8);
-
-				sample.SampleRate = sampleDataBlock.ReadUInt32();
-				sample.DataSize = chunkSize - 76 + (isASFF ? 12 : 0);
-
-				sample.Data = std::make_unique<uint8_t[]>(sample.DataSize);
-				sampleDataBlock.ReadRawBytes(sample.Data.get(), sample.DataSize);
-				// Padding #3
-				sampleDataBlock.DiscardBytes(4);
-
-				/*if (sample.Data.Length < actualDataSize) {
-					Log.Write(LogType.Warning, "Sample " + j + " in set " + i + " was shorter than expected! Expected "
-						+ actualDataSize + " bytes, but read " + sample.Data.Length + " instead.");
-				}*/
-
-				if (totalSize > chunkSize + 12) {
-					// Sample data is probably aligned to X bytes since the next sample doesn't always appear right after the first ends.
-					LOGW_X("Adjusting read offset of sample %i in set %i by %i bytes.", j, i, (totalSize - chunkSize - 12));
-
-					sampleDataBlock.DiscardBytes(totalSize - chunkSize - 12);
-				}
-			}
 		}
 
 		// Detect version to import
@@ -296,12 +202,238 @@ namespace Jazz2::Compatibility
 			LOGE_X("Could not determine the version, header size: %u bytes", headerLen);
 		}
 
-		ImportAnimations(targetPath, version, anims);
-		ImportAudioSamples(targetPath, version, samples);
+		if (manifest != nullptr) {
+			// Import only sets that were changed, the mapping depends on detected version, so it's part of the hash too
+			for (std::size_t i = sets.size(); i > 0; i--) {
+				SetSection& set = sets[i - 1];
+				if (!manifest->NeedsConversion(GetSetKey(set.Index), set.Hash ^ ((uint64_t)version * 0x9E3779B97F4A7C15ULL), CacheVersion)) {
+					sets.erase(sets.begin() + (i - 1));
+				}
+			}
+		}
+
+		// Decompress and parse all sets in parallel, then merge them in the original order
+		ParallelFor((int32_t)sets.size(), threadCount, [&sets](int32_t i) {
+			ReadSet(sets[i]);
+		});
+
+		for (auto& set : sets) {
+			for (auto& anim : set.Anims) {
+				anims.emplace_back(std::move(anim));
+			}
+			for (auto& sample : set.Samples) {
+				samples.emplace_back(std::move(sample));
+			}
+		}
+		sets.clear();
+
+		ImportAnimations(targetPath, version, anims, manifest, threadCount);
+		ImportAudioSamples(targetPath, version, samples, manifest, threadCount);
 		return true;
 	}
 
-	void JJ2Anims::ImportAnimations(const StringView& targetPath, JJ2Version version, SmallVectorImpl<AnimSection>& anims)
+	String JJ2Anims::GetSetKey(int32_t set)
+	{
+		char key[32];
+		formatString(key, sizeof(key), "Animations:%i", set);
+		return key;
+	}
+
+	void JJ2Anims::ReadSet(SetSection& set)
+	{
+		const uint8_t* data = set.Data.get();
+		JJ2Block infoBlock(data, set.InfoBlockLenC, set.InfoBlockLenU);
+		data += set.InfoBlockLenC;
+		JJ2Block frameDataBlock(data, set.FrameDataBlockLenC, set.FrameDataBlockLenU);
+		data += set.FrameDataBlockLenC;
+		JJ2Block imageDataBlock(data, set.ImageDataBlockLenC, set.ImageDataBlockLenU);
+		data += set.ImageDataBlockLenC;
+		JJ2Block sampleDataBlock(data, set.SampleDataBlockLenC, set.SampleDataBlockLenU);
+		set.Data = nullptr;
+
+		for (uint16_t j = 0; j < set.AnimCount; j++) {
+			AnimSection& anim = set.Anims.emplace_back();
+			anim.Set = set.Index;
+			anim.Anim = j;
+			anim.FrameCount = infoBlock.ReadUInt16();
+			anim.FrameRate = infoBlock.ReadUInt16();
+			anim.Frames.resize(anim.FrameCount);
+
+			// Skip the rest, seems to be 0x00000000 for all headers
+			infoBlock.DiscardBytes(4);
+
+			if (anim.FrameCount > 0) {
+				/*if (setAnims.Count == 0) {
+					throw new InvalidDataException("Set has frames but no anims");
+				}*/
+
+				//int16_t lastColdspotX = 0, lastColdspotY = 0;
+				//int16_t lastHotspotX = 0, lastHotspotY = 0;
+				//int16_t lastGunspotX = 0, lastGunspotY = 0;
+
+				for (uint16_t j = 0; j < anim.FrameCount; j++) {
+					AnimFrameSection& frame = anim.Frames[j];
+
+					frame.SizeX = frameDataBlock.ReadInt16();
+					frame.SizeY = frameDataBlock.ReadInt16();
+					frame.ColdspotX = frameDataBlock.ReadInt16();
+					frame.ColdspotY = frameDataBlock.ReadInt16();
+					frame.HotspotX = frameDataBlock.ReadInt16();
+					frame.HotspotY = frameDataBlock.ReadInt16();
+					frame.GunspotX = frameDataBlock.ReadInt16();
+					frame.GunspotY = frameDataBlock.ReadInt16();
+
+					frame.ImageAddr = frameDataBlock.ReadInt32();
+					frame.MaskAddr = frameDataBlock.ReadInt32();
+
+					// Adjust normalized position
+					// In the output images, we want to make the hotspot and image size constant.
+					anim.NormalizedHotspotX = std::max((int16_t)-frame.HotspotX, anim.NormalizedHotspotX);
+					anim.NormalizedHotspotY = std::max((int16_t)-frame.HotspotY, anim.NormalizedHotspotY);
+
+					anim.LargestOffsetX = std::max((int16_t)(frame.SizeX + frame.HotspotX), anim.LargestOffsetX);
+					anim.LargestOffsetY = std::max((int16_t)(frame.SizeY + frame.HotspotY), anim.LargestOffsetY);
+
+					anim.AdjustedSizeX = std::max(
+						(int16_t)(anim.NormalizedHotspotX + anim.LargestOffsetX),
+						anim.AdjustedSizeX
+					);
+					anim.AdjustedSizeY = std::max(
+						(int16_t)(anim.NormalizedHotspotY + anim.LargestOffsetY),
+						anim.AdjustedSizeY
+					);
+
+					//lastColdspotX = frame.ColdspotX; lastColdspotY = frame.ColdspotY;
+					//lastHotspotX = frame.HotspotX; lastHotspotY = frame.HotspotY;
+					//lastGunspotX = frame.GunspotX; lastGunspotY = frame.GunspotY;
+
+					int32_t dpos = (frame.ImageAddr + 4);
+
+					imageDataBlock.SeekTo(dpos - 4);
+					uint16_t width2 = imageDataBlock.ReadUInt16();
+					imageDataBlock.SeekTo(dpos - 2);
+					/*uint16_t height2 =*/ imageDataBlock.ReadUInt16();
+
+					frame.DrawTransparent = (width2 & 0x8000) > 0;
+
+					int32_t pxRead = 0;
+					int32_t pxTotal = (frame.SizeX * frame.SizeY);
+					bool lastOpEmpty = true;
+
+					frame.ImageData = std::make_unique<uint8_t[]>(pxTotal);
+
+					imageDataBlock.SeekTo(dpos);
+
+					while (pxRead < pxTotal) {
+						uint8_t op = imageDataBlock.ReadByte();
+						//if (op == 0) {
+						//    Console.WriteLine("[" + i + ":" + j + "] Next image operation should probably not be 0x00.");
+						//}
+
+						if (op < 0x80) {
+							// Skip the given number of pixels, writing them with the transparent color 0, array should be already zeroed
+							pxRead += op;
+						} else if (op == 0x80) {
+							// Skip until the end of the line, array should be already zeroed
+							uint16_t linePxLeft = (uint16_t)(frame.SizeX - pxRead % frame.SizeX);
+							if (pxRead % frame.SizeX == 0 && !lastOpEmpty) {
+								linePxLeft = 0;
+							}
+
+							pxRead += linePxLeft;
+						} else {
+							// Copy specified amount of pixels (ignoring the high bit)
+							uint16_t bytesToRead = (uint16_t)(op & 0x7F);
+							imageDataBlock.ReadRawBytes(frame.ImageData.get() + pxRead, bytesToRead);
+							pxRead += bytesToRead;
+						}
+
+						lastOpEmpty = (op == 0x80);
+					}
+
+					// TODO: Sprite mask
+					/*frame.MaskData = std::make_unique<uint8_t[]>(pxTotal);
+
+					if (frame.MaskAddr != 0xFFFFFFFF) {
+						imageDataBlock.SeekTo(frame.MaskAddr);
+						pxRead = 0;
+						while (pxRead < pxTotal) {
+							uint8_t b = imageDataBlock.ReadByte();
+							for (uint8_t bit = 0; bit < 8 && (pxRead + bit) < pxTotal; ++bit) {
+								frame.MaskData[pxRead + bit] = ((b & (1 << (7 - bit))) != 0);
+							}
+							pxRead += 8;
+						}
+					}*/
+				}
+			}
+		}
+
+		for (uint16_t j = 0; j < set.SndCount; ++j) {
+			SampleSection& sample = set.Samples.emplace_back();
+			sample.IdInSet = j;
+			sample.Set = set.Index;
+
+			int32_t totalSize = sampleDataBlock.ReadInt32();
+			uint32_t magicRIFF = sampleDataBlock.ReadUInt32();
+			int32_t chunkSize = sampleDataBlock.ReadInt32();
+			// "ASFF" for 1.20, "AS  " for 1.24
+			uint32_t format = sampleDataBlock.ReadUInt32();
+			ASSERT(format == 0x46465341 || format == 0x20205341);
+			bool isASFF = (format == 0x46465341);
+
+			uint32_t magicSAMP = sampleDataBlock.ReadUInt32();
+			/*uint32_t sampSize =*/ sampleDataBlock.ReadUInt32();
+			ASSERT_MSG(magicRIFF == 0x46464952 && magicSAMP == 0x504D4153, "Sample has invalid header");
+
+			// Padding/unknown data #1
+			// For set 0 sample 0:
+			//       1.20                           1.24
+			//  +00  00 00 00 00 00 00 00 00   +00  40 00 00 00 00 00 00 00
+			//  +08  00 00 00 00 00 00 00 00   +08  00 00 00 00 00 00 00 00
+			//  +10  00 00 00 00 00 00 00 00   +10  00 00 00 00 00 00 00 00
+			//  +18  00 00 00 00               +18  00 00 00 00 00 00 00 00
+			//                                 +20  00 00 00 00 00 40 FF 7F
+			sampleDataBlock.DiscardBytes(40 - (isASFF ? 12 : 0));
+			if (isASFF) {
+				// All 1.20 samples seem to be 8-bit. Some of them are among those
+				// for which 1.24 reads as 24-bit but that might just be a mistake.
+				sampleDataBlock.DiscardBytes(2);
+				sample.Multiplier = 0;
+			} else {
+				// for 1.24. 1.20 has "20 40" instead in s0s0 which makes no sense
+				sample.Multiplier = sampleDataBlock.ReadUInt16();
+			}
+			// Unknown. s0s0 1.20: 00 80, 1.24: 80 00
+			sampleDataBlock.DiscardBytes(2);
+
+			/*uint32_t payloadSize =*/ sampleDataBlock.ReadUInt32();
+			// Padding #2, all zeroes in both
+			sampleDataBlock.DiscardBytes(8);
+
+			sample.SampleRate = sampleDataBlock.ReadUInt32();
+			sample.DataSize = chunkSize - 76 + (isASFF ? 12 : 0);
+
+			sample.Data = std::make_unique<uint8_t[]>(sample.DataSize);
+			sampleDataBlock.ReadRawBytes(sample.Data.get(), sample.DataSize);
+			// Padding #3
+			sampleDataBlock.DiscardBytes(4);
+
+			/*if (sample.Data.Length < actualDataSize) {
+				Log.Write(LogType.Warning, "Sample " + j + " in set " + i + " was shorter than expected! Expected "
+					+ actualDataSize + " bytes, but read " + sample.Data.Length + " instead.");
+			}*/
+
+			if (totalSize > chunkSize + 12) {
+				// Sample data is probably aligned to X bytes since the next sample doesn't always appear right after the first ends.
+				LOGW_X("Adjusting read offset of sample %i in set %i by %i bytes.", j, set.Index, (totalSize - chunkSize - 12));
+
+				sampleDataBlock.DiscardBytes(totalSize - chunkSize - 12);
+			}
+		}
+	}
+
+	void JJ2Anims::ImportAnimations(const StringView& targetPath, JJ2Version version, SmallVectorImpl<AnimSection>& anims, CacheManifest* manifest, int32_t threadCount)
 	{
 		if (anims.empty()) {
 			return;
@@ -311,7 +443,14 @@ namespace Jazz2::Compatibility
 
 		AnimSetMapping animMapping = AnimSetMapping::GetAnimMapping(version);
 
-		for (auto& anim : anims) {
+		// Resolve target files serially, so directories are created only once and the last animation wins if
+		// more of them are mapped to the same file, the same as if they were written one by one
+		SmallVector<AnimSetMapping::Entry*, 0> entries(anims.size(), nullptr);
+		SmallVector<String, 0> fullPaths(anims.size());
+		HashMap<String, std::size_t> pathToIndex;
+
+		for (std::size_t i = 0; i < anims.size(); i++) {
+			auto& anim = anims[i];
 			if (anim.FrameCount == 0) {
 				continue;
 			}
@@ -321,39 +460,6 @@ namespace Jazz2::Compatibility
 				continue;
 			}
 
-			int sizeX = (anim.AdjustedSizeX + AddBorder * 2);
-			int sizeY = (anim.AdjustedSizeY + AddBorder * 2);
-			// Determine the frame configuration to use.
-			// Each asset must fit into a 4096 by 4096 texture,
-			// as that is the smallest texture size we have decided to support.
-			if (anim.FrameCount > 1) {
-				int rows = std::max(1, (int)std::ceil(sqrt(anim.FrameCount * sizeX / sizeY)));
-				int columns = std::max(1, (int)std::ceil(anim.FrameCount * 1.0 / rows));
-
-				// Do a bit of optimization, as the above algorithm ends occasionally with some extra space
-				// (it is careful with not underestimating the required space)
-				while (columns * (rows - 1) >= anim.FrameCount) {
-					rows--;
-				}
-
-				anim.FrameConfigurationX = (uint8_t)columns;
-				anim.FrameConfigurationY = (uint8_t)rows;
-			} else {
-				anim.FrameConfigurationX = (uint8_t)anim.FrameCount;
-				anim.FrameConfigurationY = 1;
-			}
-
-			// TODO: Hardcoded name
-			bool applyToasterPowerUpFix = (entry->Category == "Object"_s && entry->Name == "powerup_upgrade_toaster"_s);
-			if (applyToasterPowerUpFix) {
-				LOGI("Applying \"Toaster PowerUp\" palette fix.");
-			}
-
-			bool applyVineFix = (entry->Category == "Object" && entry->Name == "vine");
-			if (applyVineFix) {
-				LOGI("Applying \"Vine\" palette fix.");
-			}
-
 			String filename;
 			if (entry->Name.empty()) {
 				/*filename = "s" + sample.Set + "_s" + sample.IdInSet + ".jri";
@@ -368,81 +474,141 @@ namespace Jazz2::Compatibility
 				filename = fs::JoinPath(entry->Category, entry->Name + ".aura"_s);
 			}
 
-			int stride = sizeX * anim.FrameConfigurationX;
-			std::unique_ptr<uint8_t[]> pixels = std::make_unique<uint8_t[]>(stride * sizeY * anim.FrameConfigurationY * 4);
+			fullPaths[i] = fs::JoinPath(targetPath, filename);
+			auto it = pathToIndex.find(fullPaths[i]);
+			if (it != pathToIndex.end()) {
+				entries[it->second] = nullptr;
+				it->second = i;
+			} else {
+				pathToIndex.emplace(fullPaths[i], i);
+			}
+			entries[i] = entry;
+		}
 
-			for (int j = 0; j < anim.Frames.size(); j++) {
-				auto& frame = anim.Frames[j];
+		// Sprite sheets are independent of each other, so they can be encoded in parallel
+		ParallelFor((int32_t)anims.size(), threadCount, [&anims, &entries, &fullPaths](int32_t i) {
+			if (entries[i] != nullptr) {
+				ImportAnimation(anims[i], entries[i], fullPaths[i]);
+			}
+		});
 
-				int offsetX = anim.NormalizedHotspotX + frame.HotspotX;
-				int offsetY = anim.NormalizedHotspotY + frame.HotspotY;
+		if (manifest != nullptr) {
+			for (std::size_t i = 0; i < anims.size(); i++) {
+				if (entries[i] != nullptr) {
+					manifest->AddOutput(GetSetKey(anims[i].Set), fullPaths[i]);
+				}
+			}
+		}
+	}
 
-				for (int y = 0; y < frame.SizeY; y++) {
-					for (int x = 0; x < frame.SizeX; x++) {
-						int targetX = (j % anim.FrameConfigurationX) * sizeX + offsetX + x + AddBorder;
-						int targetY = (j / anim.FrameConfigurationX) * sizeY + offsetY + y + AddBorder;
-						uint8_t colorIdx = frame.ImageData[frame.SizeX * y + x];
+	void JJ2Anims::ImportAnimation(AnimSection& anim, AnimSetMapping::Entry* entry, const StringView& fullPath)
+	{
+		int sizeX = (anim.AdjustedSizeX + AddBorder * 2);
+		int sizeY = (anim.AdjustedSizeY + AddBorder * 2);
+		// Determine the frame configuration to use.
+		// Each asset must fit into a 4096 by 4096 texture,
+		// as that is the smallest texture size we have decided to support.
+		if (anim.FrameCount > 1) {
+			int rows = std::max(1, (int)std::ceil(sqrt(anim.FrameCount * sizeX / sizeY)));
+			int columns = std::max(1, (int)std::ceil(anim.FrameCount * 1.0 / rows));
+
+			// Do a bit of optimization, as the above algorithm ends occasionally with some extra space
+			// (it is careful with not underestimating the required space)
+			while (columns * (rows - 1) >= anim.FrameCount) {
+				rows--;
+			}
 
-						// Apply palette fixes
-						if (applyToasterPowerUpFix) {
-							if ((x >= 3 && y >= 4 && x <= 15 && y <= 20) || (x >= 2 && y >= 7 && x <= 15 && y <= 19)) {
-								colorIdx = ToasterPowerUpFix[colorIdx];
-							}
-						} else if (applyVineFix) {
-							if (colorIdx == 128) {
-								colorIdx = 0;
-							}
-						}
+			anim.FrameConfigurationX = (uint8_t)columns;
+			anim.FrameConfigurationY = (uint8_t)rows;
+		} else {
+			anim.FrameConfigurationX = (uint8_t)anim.FrameCount;
+			anim.FrameConfigurationY = 1;
+		}
 
-						if (entry->Palette == JJ2DefaultPalette::Menu) {
-							const Color& src = MenuPalette[colorIdx];
-							uint8_t a;
-							if (colorIdx == 0) {
-								a = 0;
-							} else if (frame.DrawTransparent) {
-								a = 140 * src.A() / 255;
-							} else {
-								a = src.A();
-							}
+		// TODO: Hardcoded name
+		bool applyToasterPowerUpFix = (entry->Category == "Object"_s && entry->Name == "powerup_upgrade_toaster"_s);
+		if (applyToasterPowerUpFix) {
+			LOGI("Applying \"Toaster PowerUp\" palette fix.");
+		}
+
+		bool applyVineFix = (entry->Category == "Object" && entry->Name == "vine");
+		if (applyVineFix) {
+			LOGI("Applying \"Vine\" palette fix.");
+		}
+
+		int stride = sizeX * anim.FrameConfigurationX;
+		std::unique_ptr<uint8_t[]> pixels = std::make_unique<uint8_t[]>(stride * sizeY * anim.FrameConfigurationY * 4);
+
+		for (int j = 0; j < anim.Frames.size(); j++) {
+			auto& frame = anim.Frames[j];
+
+			int offsetX = anim.NormalizedHotspotX + frame.HotspotX;
+			int offsetY = anim.NormalizedHotspotY + frame.HotspotY;
+
+			for (int y = 0; y < frame.SizeY; y++) {
+				for (int x = 0; x < frame.SizeX; x++) {
+					int targetX = (j % anim.FrameConfigurationX) * sizeX + offsetX + x + AddBorder;
+					int targetY = (j / anim.FrameConfigurationX) * sizeY + offsetY + y + AddBorder;
+					uint8_t colorIdx = frame.ImageData[frame.SizeX * y + x];
 
-							pixels[(stride * targetY + targetX) * 4] = src.R();
-							pixels[(stride * targetY + targetX) * 4 + 1] = src.G();
-							pixels[(stride * targetY + targetX) * 4 + 2] = src.B();
-							pixels[(stride * targetY + targetX) * 4 + 3] = a;
+					// Apply palette fixes
+					if (applyToasterPowerUpFix) {
+						if ((x >= 3 && y >= 4 && x <= 15 && y <= 20) || (x >= 2 && y >= 7 && x <= 15 && y <= 19)) {
+							colorIdx = ToasterPowerUpFix[colorIdx];
+						}
+					} else if (applyVineFix) {
+						if (colorIdx == 128) {
+							colorIdx = 0;
+						}
+					}
+
+					if (entry->Palette == JJ2DefaultPalette::Menu) {
+						const Color& src = MenuPalette[colorIdx];
+						uint8_t a;
+						if (colorIdx == 0) {
+							a = 0;
+						} else if (frame.DrawTransparent) {
+							a = 140 * src.A() / 255;
 						} else {
-							uint8_t a;
-							if (colorIdx == 0) {
-								a = 0;
-							} else if (frame.DrawTransparent) {
-								a = 140;
-							} else {
-								a = 255;
-							}
+							a = src.A();
+						}
 
-							pixels[(stride * targetY + targetX) * 4] = colorIdx;
-							pixels[(stride * targetY + targetX) * 4 + 1] = colorIdx;
-							pixels[(stride * targetY + targetX) * 4 + 2] = colorIdx;
-							pixels[(stride * targetY + targetX) * 4 + 3] = a;
+						pixels[(stride * targetY + targetX) * 4] = src.R();
+						pixels[(stride * targetY + targetX) * 4 + 1] = src.G();
+						pixels[(stride * targetY + targetX) * 4 + 2] = src.B();
+						pixels[(stride * targetY + targetX) * 4 + 3] = a;
+					} else {
+						uint8_t a;
+						if (colorIdx == 0) {
+							a = 0;
+						} else if (frame.DrawTransparent) {
+							a = 140;
+						} else {
+							a = 255;
 						}
+
+						pixels[(stride * targetY + targetX) * 4] = colorIdx;
+						pixels[(stride * targetY + targetX) * 4 + 1] = colorIdx;
+						pixels[(stride * targetY + targetX) * 4 + 2] = colorIdx;
+						pixels[(stride * targetY + targetX) * 4 + 3] = a;
 					}
 				}
 			}
+		}
 
-			// TODO: Use single channel instead
-			String fullPath = fs::JoinPath(targetPath, filename);
-			WriteImageToFile(fullPath, pixels.get(), sizeX, sizeY, 4, &anim, entry);
+		// TODO: Use single channel instead
+		WriteImageToFile(fullPath, pixels.get(), sizeX, sizeY, 4, &anim, entry);
 
-			/*if (!string.IsNullOrEmpty(data.Name) && !data.SkipNormalMap) {
-				PngWriter normalMap = NormalMapGenerator.FromSprite(img,
-						new Point(currentAnim.FrameConfigurationX, currentAnim.FrameConfigurationY),
-						!data.AllowRealtimePalette && data.Palette == JJ2DefaultPalette.ByIndex ? JJ2DefaultPalette.Sprite : null);
+		/*if (!string.IsNullOrEmpty(data.Name) && !data.SkipNormalMap) {
+			PngWriter normalMap = NormalMapGenerator.FromSprite(img,
+					new Point(currentAnim.FrameConfigurationX, currentAnim.FrameConfigurationY),
+					!data.AllowRealtimePalette && data.Palette == JJ2DefaultPalette.ByIndex ? JJ2DefaultPalette.Sprite : null);
 
-				normalMap.Save(filename.Replace(".png", ".n.png"));
-			}*/
-		}
+			normalMap.Save(filename.Replace(".png", ".n.png"));
+		}*/
 	}
 
-	void JJ2Anims::ImportAudioSamples(const StringView& targetPath, JJ2Version version, SmallVectorImpl<SampleSection>& samples)
+	void JJ2Anims::ImportAudioSamples(const StringView& targetPath, JJ2Version version, SmallVectorImpl<SampleSection>& samples, CacheManifest* manifest, int32_t threadCount)
 	{
 		if (samples.empty()) {
 			return;
@@ -452,7 +618,11 @@ namespace Jazz2::Compatibility
 
 		AnimSetMapping mapping = AnimSetMapping::GetSampleMapping(version);
 
-		for (auto& sample : samples) {
+		SmallVector<String, 0> fullPaths(samples.size());
+		HashMap<String, std::size_t> pathToIndex;
+
+		for (std::size_t i = 0; i < samples.size(); i++) {
+			auto& sample = samples[i];
 			AnimSetMapping::Entry* entry = mapping.Get(sample.Set, sample.IdInSet);
 			if (entry == nullptr || entry->Category == AnimSetMapping::Discard) {
 				continue;
@@ -472,47 +642,76 @@ namespace Jazz2::Compatibility
 				filename = fs::JoinPath(entry->Category, entry->Name + ".wav"_s);
 			}
 
-			auto so = fs::Open(fs::JoinPath(targetPath, filename), FileAccessMode::Write);
-			ASSERT_MSG(so->IsOpened(), "Cannot open file for writing");
-
-			// TODO: The modulo here essentially clips the sample to 8- or 16-bit.
-			// There are some samples (at least the Rapier random noise) that at least get reported as 24-bit
-			// by the read header data. It is not clear if they actually are or if the header data is just
-			// read incorrectly, though - one would think the data would need to be reshaped between 24 and 8
-			// but it works just fine as is.
-			int bytesPerSample = (sample.Multiplier / 4) % 2 + 1;
-			int dataOffset = 0;
-			if (sample.Data[0] == 0x00 && sample.Data[1] == 0x00 && sample.Data[2] == 0x00 && sample.Data[3] == 0x00 &&
-				(sample.Data[4] != 0x00 || sample.Data[5] != 0x00 || sample.Data[6] != 0x00 || sample.Data[7] != 0x00) &&
-				(sample.Data[7] == 0x00 || sample.Data[8] == 0x00)) {
-				// Trim first 8 samples (bytes) to prevent popping
-				dataOffset = 8;
-			}
-
-			// Create PCM wave file
-			// Main header
-			so->Write("RIFF", 4);
-			so->WriteValue<uint32_t>(36 + sample.DataSize - dataOffset); // File size
-			so->Write("WAVE", 4);
-
-			// Format header
-			so->Write("fmt ", 4);
-			so->WriteValue<uint32_t>(16); // Header remainder length
-			so->WriteValue<uint16_t>(1); // Format = PCM
-			so->WriteValue<uint16_t>(1); // Channels
-			so->WriteValue<uint32_t>(sample.SampleRate); // Sample rate
-			so->WriteValue<uint32_t>(sample.SampleRate * bytesPerSample); // Bytes per second
-			so->WriteValue<uint32_t>(bytesPerSample * 0x00080001);
-
-			// Payload
-			so->Write("data", 4);
-			so->WriteValue<uint32_t>(sample.DataSize - dataOffset); // Payload size
-			for (uint32_t k = dataOffset; k < sample.DataSize; k++) {
-				so->WriteValue<uint8_t>((bytesPerSample << 7) ^ sample.Data[k]);
+			String fullPath = fs::JoinPath(targetPath, filename);
+			auto it = pathToIndex.find(fullPath);
+			if (it != pathToIndex.end()) {
+				fullPaths[it->second] = { };
+				it->second = i;
+			} else {
+				pathToIndex.emplace(fullPath, i);
+			}
+			fullPaths[i] = std::move(fullPath);
+		}
+
+		ParallelFor((int32_t)samples.size(), threadCount, [&samples, &fullPaths](int32_t i) {
+			if (!fullPaths[i].empty()) {
+				ImportAudioSample(samples[i], fullPaths[i]);
+			}
+		});
+
+		if (manifest != nullptr) {
+			for (std::size_t i = 0; i < samples.size(); i++) {
+				if (!fullPaths[i].empty()) {
+					manifest->AddOutput(GetSetKey(samples[i].Set), fullPaths[i]);
+				}
 			}
 		}
 	}
 
+	void JJ2Anims::ImportAudioSample(SampleSection& sample, const StringView& fullPath)
+	{
+		auto so = fs::Open(fullPath, FileAccessMode::Write);
+		ASSERT_MSG(so->IsOpened(), "Cannot open file for writing");
+
+		// TODO: The modulo here essentially clips the sample to 8- or 16-bit.
+		// There are some samples (at least the Rapier random noise) that at least get reported as 24-bit
+		// by the read header data. It is not clear if they actually are or if the header data is just
+		// read incorrectly, though - one would think the data would need to be reshaped between 24 and 8
+		// but it works just fine as is.
+		int bytesPerSample = (sample.Multiplier / 4) % 2 + 1;
+		int dataOffset = 0;
+		if (sample.Data[0] == 0x00 && sample.Data[1] == 0x00 && sample.Data[2] == 0x00 && sample.Data[3] == 0x00 &&
+			(sample.Data[4] != 0x00 || sample.Data[5] != 0x00 || sample.Data[6] != 0x00 || sample.Data[7] != 0x00) &&
+			(sample.Data[7] == 0x00 || sample.Data[8] == 0x00)) {
+			// Trim first 8 samples (bytes) to prevent popping
+			dataOffset = 8;
+		}
+
+		// Create PCM wave file
+		// Main header
+		so->Write("RIFF", 4);
+		so->WriteValue<uint32_t>(36 + sample.DataSize - dataOffset); // File size
+		so->Write("WAVE", 4);
+
+		// Format header
+		so->Write("fmt ", 4);
+		so->WriteValue<uint32_t>(16); // Header remainder length
+		so->WriteValue<uint16_t>(1); // Format = PCM
+		so->WriteValue<uint16_t>(1); // Channels
+		so->WriteValue<uint32_t>(sample.SampleRate); // Sample rate
+		so->WriteValue<uint32_t>(sample.SampleRate * bytesPerSample); // Bytes per second
+		so->WriteValue<uint32_t>(bytesPerSample * 0x00080001);
+
+		// Payload
+		so->Write("data", 4);
+		so->WriteValue<uint32_t>(sample.DataSize - dataOffset); // Payload size
+		if (bytesPerSample == 1) {
+			// 8-bit samples are stored as signed, but WAV requires unsigned, the sample is not needed afterwards
+			CpuDispatch::ConvertS8ToU8(&sample.Data[dataOffset], &sample.Data[dataOffset], (int32_t)(sample.DataSize - dataOffset));
+		}
+		so->Write(&sample.Data[dataOffset], sample.DataSize - dataOffset);
+	}
+
 	void JJ2Anims::WriteImageToFile(const StringView& targetPath, const uint8_t* data, int32_t width, int32_t height, int32_t channelCount, AnimSection* anim, AnimSetMapping::Entry* entry)
 	{
 		auto so = fs::Open(targetPath, FileAccessMode::Write);
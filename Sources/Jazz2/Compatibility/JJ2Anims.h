@@ -16,12 +16,14 @@ using namespace nCine;
 
 namespace Jazz2::Compatibility
 {
+	class CacheManifest;
+
 	class JJ2Anims // .j2a
 	{
 	public:
 		static constexpr uint16_t CacheVersion = 7;
 
-		static bool Convert(const StringView& path, const StringView& targetPath, bool isPlus);
+		static bool Convert(const StringView& path, const StringView& targetPath, bool isPlus, CacheManifest* manifest = nullptr, int32_t threadCount = 0);
 
 		static void WriteImageToFileInternal(std::unique_ptr<IFileStream>& so, const uint8_t* data, int32_t width, int32_t height, int32_t channelCount);
 
@@ -64,10 +66,28 @@ namespace Jazz2::Compatibility
 			uint16_t Multiplier;
 		};
 
+		struct SetSection {
+			int32_t Index;
+			uint8_t AnimCount;
+			uint8_t SndCount;
+			int32_t InfoBlockLenC, InfoBlockLenU;
+			int32_t FrameDataBlockLenC, FrameDataBlockLenU;
+			int32_t ImageDataBlockLenC, ImageDataBlockLenU;
+			int32_t SampleDataBlockLenC, SampleDataBlockLenU;
+			std::unique_ptr<uint8_t[]> Data;
+			uint64_t Hash;
+			SmallVector<AnimSection, 0> Anims;
+			SmallVector<SampleSection, 0> Samples;
+		};
+
 		JJ2Anims();
 
-		static void ImportAnimations(const StringView& targetPath, JJ2Version version, SmallVectorImpl<AnimSection>& anims);
-		static void ImportAudioSamples(const StringView& targetPath, JJ2Version version, SmallVectorImpl<SampleSection>& samples);
+		static void ReadSet(SetSection& set);
+		static void ImportAnimations(const StringView& targetPath, JJ2Version version, SmallVectorImpl<AnimSection>& anims, CacheManifest* manifest, int32_t threadCount);
+		static void ImportAnimation(AnimSection& anim, AnimSetMapping::Entry* entry, const StringView& fullPath);
+		static void ImportAudioSamples(const StringView& targetPath, JJ2Version version, SmallVectorImpl<SampleSection>& samples, CacheManifest* manifest, int32_t threadCount);
+		static void ImportAudioSample(SampleSection& sample, const StringView& fullPath);
+		static String GetSetKey(int32_t set);
 
 		static void WriteImageToFile(const StringView& targetPath, const uint8_t* data, int32_t width, int32_t height, int32_t channelCount, AnimSection* anim, AnimSetMapping::Entry* entry);
 	};
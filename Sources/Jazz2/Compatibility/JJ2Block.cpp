@@ -23,6 +23,22 @@ namespace Jazz2::Compatibility
 		}
 	}
 
+	JJ2Block::JJ2Block(const uint8_t* data, int32_t length, int32_t uncompressedLength)
+		: _length(0), _offset(0)
+	{
+		if (uncompressedLength > 0) {
+			// Skip 2-byte zlib header
+			int32_t compressedLength = length - 2;
+			_buffer = std::make_unique<uint8_t[]>(uncompressedLength);
+			auto result = CompressionUtils::Inflate(data + 2, compressedLength, _buffer.get(), uncompressedLength);
+			_length = (result == DecompressionResult::Success ? uncompressedLength : 0);
+		} else {
+			_buffer = std::make_unique<uint8_t[]>(length);
+			std::memcpy(_buffer.get(), data, length);
+			_length = length;
+		}
+	}
+
 	void JJ2Block::SeekTo(int32_t offset)
 	{
 		_offset = offset;
@@ -60,7 +76,7 @@ namespace Jazz2::Compatibility
 			return false;
 		}
 
-		int16_t result = *(int16_t*)&_buffer[_offset];
+		int16_t result = (int16_t)(_buffer[_offset] | (_buffer[_offset + 1] << 8));
 		_offset += 2;
 		return result;
 	}
@@ -72,7 +88,7 @@ namespace Jazz2::Compatibility
 			return false;
 		}
 
-		uint16_t result = *(uint16_t*)&_buffer[_offset];
+		uint16_t result = (uint16_t)(_buffer[_offset] | (_buffer[_offset + 1] << 8));
 		_offset += 2;
 		return result;
 	}
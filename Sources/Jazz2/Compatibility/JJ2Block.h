@@ -11,6 +11,7 @@ namespace Jazz2::Compatibility
 	{
 	public:
 		JJ2Block(const std::unique_ptr<IFileStream>& s, int32_t length, int32_t uncompressedLength = 0);
+		JJ2Block(const uint8_t* data, int32_t length, int32_t uncompressedLength = 0);
 
 		void SeekTo(int32_t offset);
 		void DiscardBytes(int32_t length);
@@ -17,6 +17,8 @@ namespace Jazz2::Compatibility
 	class JJ2Episode // .j2e / .j2pe
 	{
 	public:
+		static constexpr uint16_t CacheVersion = 1;
+
 		int32_t Position;
 		String Name;
 		String DisplayName;
@@ -39,6 +39,7 @@ namespace Jazz2::Compatibility
 			uint8_t PaletteRemapping[256];
 		};
 
+		static constexpr uint16_t CacheVersion = 1;
 		static constexpr int JJ2LayerCount = 8;
 		static constexpr int TextEventStringsCount = 16;
 
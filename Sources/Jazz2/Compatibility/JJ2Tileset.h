@@ -16,6 +16,7 @@ namespace Jazz2::Compatibility
     class JJ2Tileset // .j2t
     {
     public:
+        static constexpr uint16_t CacheVersion = 1;
         static constexpr int BlockSize = 32;
 
         JJ2Tileset() : _version(JJ2Version::Unknown), _tileCount(0) { }
@@ -695,6 +695,46 @@ void main() {
 	vec3 tinted = mix(original.rgb, vColor.rgb, 0.45);
 	fragColor = vec4(tinted.r, tinted.g, tinted.b, original.a * vColor.a);
 }
+)";
+
+	constexpr char PaletteFs[] = R"(
+#ifdef GL_ES
+precision mediump float;
+#endif
+
+uniform sampler2D uTexture;
+uniform sampler2D uTexturePalette;
+
+in vec2 vTexCoords;
+in vec4 vColor;
+out vec4 fragColor;
+
+void main() {
+	// Red channel contains palette index, green channel contains alpha of the pixel
+	vec2 indexed = texture(uTexture, vTexCoords).rg;
+	vec4 color = texelFetch(uTexturePalette, ivec2(int(indexed.r * 255.0 + 0.5), 0), 0);
+	fragColor = vec4(color.rgb, color.a * indexed.g) * vColor;
+}
+)";
+
+	constexpr char TintedPaletteFs[] = R"(
+#ifdef GL_ES
+precision mediump float;
+#endif
+
+uniform sampler2D uTexture;
+uniform sampler2D uTexturePalette;
+
+in vec2 vTexCoords;
+in vec4 vColor;
+out vec4 fragColor;
+
+void main() {
+	vec2 indexed = texture(uTexture, vTexCoords).rg;
+	vec4 original = texelFetch(uTexturePalette, ivec2(int(indexed.r * 255.0 + 0.5), 0), 0);
+	vec3 tinted = mix(original.rgb, vColor.rgb, 0.45);
+	fragColor = vec4(tinted.r, tinted.g, tinted.b, original.a * indexed.g * vColor.a);
+}
 )";
 
 	constexpr char OutlineFs[] = R"(
@@ -10,12 +10,15 @@
 #include "../nCine/Application.h"
 #include "../nCine/AppConfiguration.h"
 #include "../nCine/ServiceLocator.h"
+#include "../nCine/Base/CpuDispatch.h"
 #include "../nCine/IO/CompressionUtils.h"
 #include "../nCine/IO/IFileStream.h"
+#include "../nCine/IO/GrowableMemoryFile.h"
 #include "../nCine/IO/MemoryFile.h"
 #include "../nCine/Graphics/ITextureLoader.h"
 #include "../nCine/Graphics/RenderResources.h"
 #include "../nCine/Base/Random.h"
+#include "../nCine/tracy.h"
 
 #if defined(DEATH_TARGET_ANDROID)
 #	include "../nCine/Backends/Android/AndroidApplication.h"
@@ -171,6 +174,7 @@ namespace Jazz2
 	{
 		_cachedMetadata.clear();
 		_cachedGraphics.clear();
+		_atlasPages.clear();
 
 		for (int32_t i = 0; i < (int32_t)FontType::Count; i++) {
 			_fonts[i] = nullptr;
@@ -220,6 +224,13 @@ namespace Jazz2
 			}
 		}
 
+		// Release atlas pages that are no longer used by any graphics
+		for (int32_t i = (int32_t)_atlasPages.size() - 1; i >= 0; i--) {
+			if (_atlasPages[i].Page.use_count() == 1) {
+				_atlasPages.erase(&_atlasPages[i]);
+			}
+		}
+
 		_isLoading = false;
 	}
 
@@ -231,6 +242,7 @@ namespace Jazz2
 
 	Metadata* ContentResolver::RequestMetadata(const StringView& path)
 	{
+		ZoneScoped;
 		auto pathNormalized = fs::ToNativeSeparators(path);
 		auto it = _cachedMetadata.find(String::nullTerminatedView(pathNormalized));
 		if (it != _cachedMetadata.end()) {
@@ -244,8 +256,42 @@ namespace Jazz2
 			return it->second.get();
 		}
 
-		// Try to load it
-		auto s = fs::Open(fs::JoinPath({ GetContentPath(), "Metadata"_s, pathNormalized + ".res"_s }), FileAccessMode::Read);
+		// Try to load it, compiled metadata from "Cache" directory are preferred if they are up-to-date
+		String sourcePath = fs::JoinPath({ GetContentPath(), "Metadata"_s, pathNormalized + ".res"_s });
+		uint64_t sourceModified = fs::LastModificationTime(sourcePath).Ticks;
+#if !defined(DEATH_TARGET_EMSCRIPTEN)
+		String compiledPath = fs::JoinPath({ GetCachePath(), "Metadata"_s, pathNormalized + ".res"_s });
+		if (sourceModified != 0) {
+			auto s = fs::Open(compiledPath, FileAccessMode::Read);
+			auto fileSize = s->GetSize();
+			if (fileSize > CompiledMetadataHeaderSize && fileSize <= 64 * 1024 * 1024) {
+				// Whole file is loaded with a single read
+				auto buffer = std::make_unique<uint8_t[]>(fileSize);
+				uint32_t bytesRead = s->Read(buffer.get(), fileSize);
+				s->Close();
+
+				MemoryFile uc(buffer.get(), fileSize);
+				uint64_t signature = uc.ReadValue<uint64_t>();
+				uint8_t fileType = uc.ReadValue<uint8_t>();
+				uint16_t version = uc.ReadValue<uint16_t>();
+				uint64_t compiledModified = uc.ReadValue<uint64_t>();
+				if (bytesRead == (uint32_t)fileSize && signature == 0x2095A59FF0BFBBEF && fileType == CompiledMetadataFile &&
+					version == CompiledMetadataVersion && compiledModified == sourceModified) {
+					// Structure is validated first, corrupted or truncated files are compiled again from source
+					if (ValidateCompiledMetadata(buffer.get() + CompiledMetadataHeaderSize, fileSize - CompiledMetadataHeaderSize)) {
+						std::unique_ptr<Metadata> metadata = std::make_unique<Metadata>();
+						metadata->Flags |= MetadataFlags::Referenced;
+						ReadCompiledMetadata(uc, metadata.get());
+						return _cachedMetadata.emplace(pathNormalized, std::move(metadata)).first->second.get();
+					}
+
+					LOGW_X("Compiled metadata \"%s\" are corrupted, recompiling", compiledPath.data());
+				}
+			}
+		}
+#endif
+
+		auto s = fs::Open(sourcePath, FileAccessMode::Read);
 		auto fileSize = s->GetSize();
 		if (fileSize < 4 || fileSize > 64 * 1024 * 1024) {
 			// 64 MB file size limit
@@ -254,141 +300,347 @@ namespace Jazz2
 
 		auto buffer = std::make_unique<char[]>(fileSize + simdjson::SIMDJSON_PADDING);
 		s->Read(buffer.get(), fileSize);
+		s->Close();
 		buffer[fileSize] = '\0';
 
+		// JSON is only the authoring format, it's always compiled to binary representation first
+		GrowableMemoryFile co(4096);
+		co.WriteValue<uint64_t>(0x2095A59FF0BFBBEF);
+		co.WriteValue<uint8_t>(CompiledMetadataFile);
+		co.WriteValue<uint16_t>(CompiledMetadataVersion);
+		co.WriteValue<uint64_t>(sourceModified);
+		if (!CompileMetadata(buffer.get(), fileSize, co)) {
+			return nullptr;
+		}
+
+		int32_t compiledSize = co.GetSize();
+#if !defined(DEATH_TARGET_EMSCRIPTEN)
+		if (sourceModified != 0) {
+			// File is written under a temporary name first, so an interrupted write never leaves a truncated file in place
+			fs::CreateDirectories(fs::GetDirectoryName(compiledPath));
+			String tempPath = compiledPath + ".tmp"_s;
+			auto so = fs::Open(tempPath, FileAccessMode::Write);
+			bool isWritten = (so->IsOpened() && so->Write(co.GetBuffer(), compiledSize) == (uint32_t)compiledSize);
+			so->Close();
+			if (!isWritten || !fs::Rename(tempPath, compiledPath)) {
+				fs::RemoveFile(tempPath);
+			}
+		}
+#endif
+
+		MemoryFile uc(co.GetBuffer(), compiledSize);
+		uc.Seek(CompiledMetadataHeaderSize, SeekOrigin::Begin);
+
 		std::unique_ptr<Metadata> metadata = std::make_unique<Metadata>();
 		metadata->Flags |= MetadataFlags::Referenced;
+		ReadCompiledMetadata(uc, metadata.get());
+		return _cachedMetadata.emplace(pathNormalized, std::move(metadata)).first->second.get();
+	}
 
+	bool ContentResolver::CompileMetadata(const char* json, uint32_t length, IFileStream& so)
+	{
 		ondemand::parser parser;
 		ondemand::document doc;
-		if (parser.iterate(buffer.get(), fileSize, fileSize + simdjson::SIMDJSON_PADDING).get(doc) == SUCCESS) {
-			metadata->BoundingBox = GetVector2iFromJson(doc["BoundingBox"], Vector2i(InvalidValue, InvalidValue));
+		if (parser.iterate(json, length, length + simdjson::SIMDJSON_PADDING).get(doc) != SUCCESS) {
+			return false;
+		}
 
-			ondemand::object animations;
-			if (doc["Animations"].get(animations) == SUCCESS) {
-				size_t count;
-				if (animations.count_fields().get(count) == SUCCESS) {
-					metadata->Graphics.reserve(count);
+		Vector2i boundingBox = GetVector2iFromJson(doc["BoundingBox"], Vector2i(InvalidValue, InvalidValue));
+		so.WriteValue<int32_t>(boundingBox.X);
+		so.WriteValue<int32_t>(boundingBox.Y);
+
+		// Animations
+		ondemand::object animations;
+		if (doc["Animations"].get(animations) == SUCCESS) {
+			int32_t countPosition = so.GetPosition();
+			uint16_t count = 0;
+			so.WriteValue<uint16_t>(count);
+
+			for (auto it : animations) {
+				std::string_view key, assetPath;
+				ondemand::object value;
+				if (it.unescaped_key().get(key) != SUCCESS || it.value().get(value) != SUCCESS || key.empty() || key.size() > UINT8_MAX ||
+					value["Path"].get(assetPath) != SUCCESS || assetPath.empty() || assetPath.size() > UINT16_MAX) {
+					continue;
 				}
 
-				for (auto it : animations) {
-					std::string_view key, assetPath;
-					ondemand::object value;
-					if (it.unescaped_key().get(key) != SUCCESS || it.value().get(value) != SUCCESS || key.empty() ||
-						value["Path"].get(assetPath) != SUCCESS || assetPath.empty()) {
-						continue;
-					}
+				uint8_t flags = 0;
+				uint64_t rawFlags;
+				if (value["Flags"].get(rawFlags) == SUCCESS && (rawFlags & 0x01) == 0x01) {
+					flags |= 0x01;
+				}
 
-					GraphicResource graphics;
-					graphics.LoopMode = AnimationLoopMode::Loop;
+				// TODO: Implement true indexed sprites
+				uint64_t paletteOffset;
+				if (value["PaletteOffset"].get(paletteOffset) != SUCCESS) {
+					paletteOffset = 0;
+				}
 
-					//bool keepIndexed = false;
+				int64_t frameOffset;
+				if (value["FrameOffset"].get(frameOffset) != SUCCESS) {
+					frameOffset = 0;
+				}
+
+				int64_t frameCount;
+				if (value["FrameCount"].get(frameCount) == SUCCESS) {
+					flags |= 0x02;
+				} else {
+					frameCount = 0;
+				}
+
+				// TODO: Use AnimDuration instead
+				float animDuration = 0.0f;
+				double frameRate;
+				if (value["FrameRate"].get(frameRate) == SUCCESS) {
+					flags |= 0x04;
+					animDuration = (frameRate <= 0 ? -1.0f : (1.0f / (float)frameRate) * 5.0f);
+				}
 
-					uint64_t flags;
-					if (value["Flags"].get(flags) == SUCCESS) {
-						if ((flags & 0x01) == 0x01) {
-							graphics.LoopMode = AnimationLoopMode::Once;
+				SmallVector<int32_t, 4> states;
+				ondemand::array statesArray;
+				if (value["States"].get(statesArray) == SUCCESS) {
+					for (auto stateItem : statesArray) {
+						int64_t state;
+						if (stateItem.get(state) == SUCCESS) {
+							states.push_back((int32_t)state);
 						}
-						//if ((flags & 0x02) == 0x02) {
-						//	keepIndexed = true;
-						//}
 					}
+				}
 
-					// TODO: Implement true indexed sprites
-					uint64_t paletteOffset;
-					if (value["PaletteOffset"].get(paletteOffset) != SUCCESS) {
-						paletteOffset = 0;
-					}
+				so.WriteValue<uint8_t>((uint8_t)key.size());
+				so.Write(key.data(), (uint32_t)key.size());
+				so.WriteValue<uint16_t>((uint16_t)assetPath.size());
+				so.Write(assetPath.data(), (uint32_t)assetPath.size());
+				so.WriteValue<uint8_t>(flags);
+				so.WriteValue<uint16_t>((uint16_t)paletteOffset);
+				so.WriteValue<int32_t>((int32_t)frameOffset);
+				so.WriteValue<int32_t>((int32_t)frameCount);
+				so.WriteValue<float>(animDuration);
+				so.WriteValue<uint8_t>((uint8_t)states.size());
+				for (int32_t state : states) {
+					so.WriteValue<int32_t>(state);
+				}
+				count++;
+			}
 
-					graphics.Base = RequestGraphics(assetPath, (uint16_t)paletteOffset);
-					if (graphics.Base == nullptr) {
-						continue;
-					}
+			int32_t endPosition = so.GetPosition();
+			so.Seek(countPosition, SeekOrigin::Begin);
+			so.WriteValue<uint16_t>(count);
+			so.Seek(endPosition, SeekOrigin::Begin);
+		} else {
+			so.WriteValue<uint16_t>(0);
+		}
+
+		// Sounds
+		ondemand::object sounds;
+		if (doc["Sounds"].get(sounds) == SUCCESS) {
+			int32_t countPosition = so.GetPosition();
+			uint16_t count = 0;
+			so.WriteValue<uint16_t>(count);
+
+			for (auto it : sounds) {
+				std::string_view key;
+				ondemand::object value;
+				ondemand::array assetPaths;
+				bool isEmpty;
+				if (it.unescaped_key().get(key) != SUCCESS || it.value().get(value) != SUCCESS || key.empty() || key.size() > UINT8_MAX ||
+					value["Paths"].get(assetPaths) != SUCCESS || assetPaths.is_empty().get(isEmpty) != SUCCESS || isEmpty) {
+					continue;
+				}
 
-					int64_t frameOffset;
-					if (value["FrameOffset"].get(frameOffset) != SUCCESS) {
-						frameOffset = 0;
+				SmallVector<std::string_view, 4> paths;
+				for (auto assetPathItem : assetPaths) {
+					std::string_view assetPath;
+					if (assetPathItem.get(assetPath) == SUCCESS && !assetPath.empty() && assetPath.size() <= UINT16_MAX) {
+						paths.push_back(assetPath);
 					}
-					graphics.FrameOffset = (int32_t)frameOffset;
+				}
+				if (paths.empty()) {
+					continue;
+				}
 
-					graphics.AnimDuration = graphics.Base->AnimDuration;
-					graphics.FrameCount = graphics.Base->FrameCount;
+				so.WriteValue<uint8_t>((uint8_t)key.size());
+				so.Write(key.data(), (uint32_t)key.size());
+				so.WriteValue<uint8_t>((uint8_t)paths.size());
+				for (auto& assetPath : paths) {
+					so.WriteValue<uint16_t>((uint16_t)assetPath.size());
+					so.Write(assetPath.data(), (uint32_t)assetPath.size());
+				}
+				count++;
+			}
 
-					int64_t frameCount;
-					if (value["FrameCount"].get(frameCount) == SUCCESS) {
-						graphics.FrameCount = (int32_t)frameCount;
-					} else {
-						graphics.FrameCount -= graphics.FrameOffset;
-					}
+			int32_t endPosition = so.GetPosition();
+			so.Seek(countPosition, SeekOrigin::Begin);
+			so.WriteValue<uint16_t>(count);
+			so.Seek(endPosition, SeekOrigin::Begin);
+		} else {
+			so.WriteValue<uint16_t>(0);
+		}
 
-					// TODO: Use AnimDuration instead
-					double frameRate;
-					if (value["FrameRate"].get(frameRate) == SUCCESS) {
-						graphics.AnimDuration = (frameRate <= 0 ? -1.0f : (1.0f / (float)frameRate) * 5.0f);
-					}
+		return true;
+	}
 
-					ondemand::array states;
-					if (value["States"].get(states) == SUCCESS) {
-						for (auto stateItem : states) {
-							int64_t state;
-							if (stateItem.get(state) == SUCCESS) {
-								graphics.State.push_back((AnimState)state);
-							}
-						}
-					}
+	bool ContentResolver::ValidateCompiledMetadata(const uint8_t* data, int32_t size)
+	{
+		// Walks the same structure as ReadCompiledMetadata(), every length and count is checked against remaining bytes
+		int32_t offset = 0;
+		auto skip = [&](int32_t bytes) {
+			if (bytes > size - offset) {
+				return false;
+			}
+			offset += bytes;
+			return true;
+		};
+		auto readUint8 = [&](uint8_t& value) {
+			if (size - offset < (int32_t)sizeof(uint8_t)) {
+				return false;
+			}
+			value = data[offset];
+			offset += sizeof(uint8_t);
+			return true;
+		};
+		auto readUint16 = [&](uint16_t& value) {
+			if (size - offset < (int32_t)sizeof(uint16_t)) {
+				return false;
+			}
+			std::memcpy(&value, data + offset, sizeof(uint16_t));
+			offset += sizeof(uint16_t);
+			return true;
+		};
 
-					// If no bounding box is provided, use the first sprite
-					if (metadata->BoundingBox == Vector2i(InvalidValue, InvalidValue)) {
-						// TODO: Remove this bounding box reduction
-						metadata->BoundingBox = graphics.Base->FrameDimensions - Vector2i(2, 2);
-					}
+		// Bounding box
+		if (!skip(2 * sizeof(int32_t))) {
+			return false;
+		}
 
-					metadata->Graphics.emplace(key, std::move(graphics));
-				}
+		uint16_t animationCount;
+		if (!readUint16(animationCount)) {
+			return false;
+		}
+		for (uint32_t i = 0; i < animationCount; i++) {
+			uint8_t keyLength, flags, stateCount;
+			uint16_t pathLength;
+			if (!readUint8(keyLength) || keyLength == 0 || !skip(keyLength) ||
+				!readUint16(pathLength) || pathLength == 0 || !skip(pathLength) ||
+				!readUint8(flags) || !skip(sizeof(uint16_t) + 2 * sizeof(int32_t) + sizeof(float)) ||
+				!readUint8(stateCount) || !skip(stateCount * (int32_t)sizeof(int32_t))) {
+				return false;
 			}
+		}
 
-			ondemand::object sounds;
-			if (doc["Sounds"].get(sounds) == SUCCESS) {
-				size_t count;
-				if (sounds.count_fields().get(count) == SUCCESS) {
-					metadata->Sounds.reserve(count);
+		uint16_t soundCount;
+		if (!readUint16(soundCount)) {
+			return false;
+		}
+		for (uint32_t i = 0; i < soundCount; i++) {
+			uint8_t keyLength, pathCount;
+			if (!readUint8(keyLength) || keyLength == 0 || !skip(keyLength) || !readUint8(pathCount)) {
+				return false;
+			}
+			for (uint32_t j = 0; j < pathCount; j++) {
+				uint16_t pathLength;
+				if (!readUint16(pathLength) || pathLength == 0 || !skip(pathLength)) {
+					return false;
 				}
+			}
+		}
 
-				for (auto it : sounds) {
-					std::string_view key;
-					ondemand::object value;
-					ondemand::array assetPaths;
-					bool isEmpty;
-					if (it.unescaped_key().get(key) != SUCCESS || it.value().get(value) != SUCCESS || key.empty() ||
-						value["Paths"].get(assetPaths) != SUCCESS || assetPaths.is_empty().get(isEmpty) != SUCCESS || isEmpty) {
-						continue;
-					}
+		// Trailing bytes mean that the file doesn't match the expected structure
+		return (offset == size);
+	}
 
-					SoundResource sound;
-
-					for (auto assetPathItem : assetPaths) {
-						std::string_view assetPath;
-						if (assetPathItem.get(assetPath) == SUCCESS && !assetPath.empty()) {
-							auto assetPathNormalized = fs::ToNativeSeparators(assetPath);
-							String fullPath = fs::JoinPath({ GetContentPath(), "Animations"_s, assetPathNormalized });
-							if (!fs::IsReadableFile(fullPath)) {
-								fullPath = fs::JoinPath({ GetCachePath(), "Animations"_s, assetPathNormalized });
-								if (!fs::IsReadableFile(fullPath)) {
-									continue;
-								}
-							}
-							sound.Buffers.emplace_back(std::make_unique<AudioBuffer>(fullPath));
-						}
-					}
+	void ContentResolver::ReadCompiledMetadata(IFileStream& s, Metadata* metadata)
+	{
+		int32_t boundingBoxX = s.ReadValue<int32_t>();
+		int32_t boundingBoxY = s.ReadValue<int32_t>();
+		metadata->BoundingBox = Vector2i(boundingBoxX, boundingBoxY);
+
+		// Animations
+		uint16_t animationCount = s.ReadValue<uint16_t>();
+		metadata->Graphics.reserve(animationCount);
+
+		for (uint32_t i = 0; i < animationCount; i++) {
+			uint8_t keyLength = s.ReadValue<uint8_t>();
+			String key(NoInit, keyLength);
+			s.Read(key.data(), keyLength);
+
+			uint16_t pathLength = s.ReadValue<uint16_t>();
+			String assetPath(NoInit, pathLength);
+			s.Read(assetPath.data(), pathLength);
+
+			uint8_t flags = s.ReadValue<uint8_t>();
+			uint16_t paletteOffset = s.ReadValue<uint16_t>();
+			int32_t frameOffset = s.ReadValue<int32_t>();
+			int32_t frameCount = s.ReadValue<int32_t>();
+			float animDuration = s.ReadValue<float>();
+
+			GraphicResource graphics;
+			graphics.LoopMode = ((flags & 0x01) == 0x01 ? AnimationLoopMode::Once : AnimationLoopMode::Loop);
+
+			uint8_t stateCount = s.ReadValue<uint8_t>();
+			for (uint32_t j = 0; j < stateCount; j++) {
+				graphics.State.push_back((AnimState)s.ReadValue<int32_t>());
+			}
+
+			// Empty keys can't be looked up
+			Atom keyAtom = Atom::intern(key);
+			if (keyAtom.empty()) {
+				continue;
+			}
+
+			graphics.Base = RequestGraphics(assetPath, paletteOffset);
+			if (graphics.Base == nullptr) {
+				continue;
+			}
+
+			graphics.FrameOffset = frameOffset;
+			graphics.FrameCount = ((flags & 0x02) == 0x02 ? frameCount : graphics.Base->FrameCount - frameOffset);
+			graphics.AnimDuration = ((flags & 0x04) == 0x04 ? animDuration : graphics.Base->AnimDuration);
+
+			// If no bounding box is provided, use the first sprite
+			if (metadata->BoundingBox == Vector2i(InvalidValue, InvalidValue)) {
+				// TODO: Remove this bounding box reduction
+				metadata->BoundingBox = graphics.Base->FrameDimensions - Vector2i(2, 2);
+			}
+
+			metadata->Graphics.emplace(keyAtom, std::move(graphics));
+		}
+
+		// Sounds
+		uint16_t soundCount = s.ReadValue<uint16_t>();
+		metadata->Sounds.reserve(soundCount);
 
-					if (!sound.Buffers.empty()) {
-						metadata->Sounds.emplace(key, std::move(sound));
+		for (uint32_t i = 0; i < soundCount; i++) {
+			uint8_t keyLength = s.ReadValue<uint8_t>();
+			String key(NoInit, keyLength);
+			s.Read(key.data(), keyLength);
+
+			SoundResource sound;
+
+			uint8_t pathCount = s.ReadValue<uint8_t>();
+			for (uint32_t j = 0; j < pathCount; j++) {
+				uint16_t pathLength = s.ReadValue<uint16_t>();
+				String assetPath(NoInit, pathLength);
+				s.Read(assetPath.data(), pathLength);
+
+				auto assetPathNormalized = fs::ToNativeSeparators(assetPath);
+				String fullPath = fs::JoinPath({ GetContentPath(), "Animations"_s, assetPathNormalized });
+				if (!fs::IsReadableFile(fullPath)) {
+					fullPath = fs::JoinPath({ GetCachePath(), "Animations"_s, assetPathNormalized });
+					if (!fs::IsReadableFile(fullPath)) {
+						continue;
 					}
 				}
+				sound.Buffers.emplace_back(std::make_unique<AudioBuffer>(fullPath));
 			}
-		}
 
-		return _cachedMetadata.emplace(pathNormalized, std::move(metadata)).first->second.get();
+			if (!sound.Buffers.empty()) {
+				Atom keyAtom = Atom::intern(key);
+				if (!keyAtom.empty()) {
+					metadata->Sounds.emplace(keyAtom, std::move(sound));
+				}
+			}
+		}
 	}
 
 	GenericGraphicResource* ContentResolver::RequestGraphics(const StringView& path, uint16_t paletteOffset)
@@ -463,22 +715,13 @@ namespace Jazz2
 					for (int32_t i = 0; i < w * h; i++) {
 						// Save original alpha value for collision checking
 						graphics->Mask[i] = ((pixels[i] >> 24) & 0xff);
-						if (palette != nullptr) {
-							uint32_t color = palette[pixels[i] & 0xff];
-							pixels[i] = (color & 0xffffff) | ((((color >> 24) & 0xff) * ((pixels[i] >> 24) & 0xff) / 255) << 24);
-						}
-					}
-				} else if (palette != nullptr) {
-					for (int32_t i = 0; i < w * h; i++) {
-						uint32_t color = palette[pixels[i] & 0xff];
-						pixels[i] = (color & 0xffffff) | ((((color >> 24) & 0xff) * ((pixels[i] >> 24) & 0xff) / 255) << 24);
 					}
 				}
+				if (palette != nullptr) {
+					CpuDispatch::ExpandPaletteInPlace(pixels, w * h, palette);
+				}
 
-				graphics->TextureDiffuse = std::make_unique<Texture>(fullPath.data(), Texture::Format::RGBA8, w, h);
-				graphics->TextureDiffuse->loadFromTexels((unsigned char*)pixels, 0, 0, w, h);
-				graphics->TextureDiffuse->setMinFiltering(linearSampling ? SamplerFilter::Linear : SamplerFilter::Nearest);
-				graphics->TextureDiffuse->setMagFiltering(linearSampling ? SamplerFilter::Linear : SamplerFilter::Nearest);
+				CreateGraphicsTexture(graphics.get(), fullPath.data(), pixels, w, h, linearSampling);
 
 				// TODO: Use FrameDuration instead
 				double animDuration;
@@ -579,22 +822,13 @@ namespace Jazz2
 			for (uint32_t i = 0; i < width * height; i++) {
 				// Save original alpha value for collision checking
 				graphics->Mask[i] = ((pixels[i] >> 24) & 0xff);
-				if (palette != nullptr) {
-					uint32_t color = palette[pixels[i] & 0xff];
-					pixels[i] = (color & 0xffffff) | ((((color >> 24) & 0xff) * ((pixels[i] >> 24) & 0xff) / 255) << 24);
-				}
-			}
-		} else if (palette != nullptr) {
-			for (uint32_t i = 0; i < width * height; i++) {
-				uint32_t color = palette[pixels[i] & 0xff];
-				pixels[i] = (color & 0xffffff) | ((((color >> 24) & 0xff) * ((pixels[i] >> 24) & 0xff) / 255) << 24);
 			}
 		}
+		if (palette != nullptr) {
+			CpuDispatch::ExpandPaletteInPlace(pixels.get(), (int32_t)(width * height), palette);
+		}
 
-		graphics->TextureDiffuse = std::make_unique<Texture>(fullPath.data(), Texture::Format::RGBA8, width, height);
-		graphics->TextureDiffuse->loadFromTexels((unsigned char*)pixels.get(), 0, 0, width, height);
-		graphics->TextureDiffuse->setMinFiltering(linearSampling ? SamplerFilter::Linear : SamplerFilter::Nearest);
-		graphics->TextureDiffuse->setMagFiltering(linearSampling ? SamplerFilter::Linear : SamplerFilter::Nearest);
+		CreateGraphicsTexture(graphics.get(), fullPath.data(), pixels.get(), width, height, linearSampling);
 
 		// AnimDuration is multiplied by 256 before saving, so divide it here back
 		graphics->AnimDuration = animDuration / 256.0f;
@@ -623,6 +857,54 @@ namespace Jazz2
 		return _cachedGraphics.emplace(Pair(String(path), paletteOffset), std::move(graphics)).first->second.get();
 	}
 
+	void ContentResolver::CreateGraphicsTexture(GenericGraphicResource* graphics, const char* name, const uint32_t* pixels, int32_t width, int32_t height, bool linearSampling)
+	{
+		// Small sprite sheets are packed into shared atlas pages, so different actors can be drawn in the same batch
+		if (!linearSampling && width <= AtlasMaxSheetSize && height <= AtlasMaxSheetSize &&
+			AllocateAtlasRegion(width, height, graphics->TextureDiffuse, graphics->TextureOffset)) {
+			graphics->TextureDiffuse->loadFromTexels((const unsigned char*)pixels, graphics->TextureOffset.X, graphics->TextureOffset.Y, width, height);
+			graphics->Flags |= GenericGraphicResourceFlags::Atlas;
+			return;
+		}
+
+		graphics->TextureDiffuse = std::make_shared<Texture>(name, Texture::Format::RGBA8, width, height);
+		graphics->TextureDiffuse->loadFromTexels((const unsigned char*)pixels, 0, 0, width, height);
+		graphics->TextureDiffuse->setMinFiltering(linearSampling ? SamplerFilter::Linear : SamplerFilter::Nearest);
+		graphics->TextureDiffuse->setMagFiltering(linearSampling ? SamplerFilter::Linear : SamplerFilter::Nearest);
+		graphics->TextureOffset = Vector2i::Zero;
+	}
+
+	bool ContentResolver::AllocateAtlasRegion(int32_t width, int32_t height, std::shared_ptr<Texture>& texture, Vector2i& offset)
+	{
+		for (auto& page : _atlasPages) {
+			if (page.Packer.TryAllocate(width, height, AtlasPageSize, AtlasPadding, offset)) {
+				texture = page.Page;
+				return true;
+			}
+		}
+
+		const IGfxCapabilities& gfxCaps = theServiceLocator().gfxCapabilities();
+		if (gfxCaps.value(IGfxCapabilities::GLIntValues::MAX_TEXTURE_SIZE) < AtlasPageSize) {
+			return false;
+		}
+
+		auto& page = _atlasPages.emplace_back();
+		page.Page = std::make_shared<Texture>("Atlas", Texture::Format::RGBA8, AtlasPageSize, AtlasPageSize);
+		// Padding between sprite sheets has to be transparent
+		std::unique_ptr<uint32_t[]> emptyPixels = std::make_unique<uint32_t[]>(AtlasPageSize * AtlasPageSize);
+		page.Page->loadFromTexels((const unsigned char*)emptyPixels.get(), 0, 0, AtlasPageSize, AtlasPageSize);
+		page.Page->setMinFiltering(SamplerFilter::Nearest);
+		page.Page->setMagFiltering(SamplerFilter::Nearest);
+		if (!page.Packer.TryAllocate(width, height, AtlasPageSize, AtlasPadding, offset)) {
+			return false;
+		}
+
+		LOGI_X("Created texture atlas page %i", (int32_t)_atlasPages.size());
+
+		texture = page.Page;
+		return true;
+	}
+
 	void ContentResolver::ReadImageFromFile(std::unique_ptr<IFileStream>& s, uint8_t* data, int32_t width, int32_t height, int32_t channelCount)
 	{
 		typedef union {
@@ -693,6 +975,7 @@ namespace Jazz2
 
 	std::unique_ptr<Tiles::TileSet> ContentResolver::RequestTileSet(const StringView& path, uint16_t captionTileId, bool applyPalette, const uint8_t* paletteRemapping)
 	{
+		ZoneScoped;
 		// Try "Content" directory first, then "Cache" directory
 		String fullPath = fs::JoinPath({ GetContentPath(), "Tilesets"_s, path + ".j2t"_s });
 		if (!fs::IsReadableFile(fullPath)) {
@@ -738,6 +1021,7 @@ namespace Jazz2
 				if (_isLoading) {
 					_cachedMetadata.clear();
 					_cachedGraphics.clear();
+					_atlasPages.clear();
 
 					for (int32_t i = 0; i < (int32_t)FontType::Count; i++) {
 						_fonts[i] = nullptr;
@@ -753,35 +1037,44 @@ namespace Jazz2
 
 		// Mask
 		uint32_t maskSize = uc.ReadValue<uint32_t>();
+		std::unique_ptr<uint8_t[]> packedMask = std::make_unique<uint8_t[]>(maskSize);
+		uc.Read(packedMask.get(), maskSize);
 		std::unique_ptr<uint8_t[]> mask = std::make_unique<uint8_t[]>(maskSize * 8);
-		for (uint32_t j = 0; j < maskSize; j++) {
-			uint8_t idx = uc.ReadValue<uint8_t>();
-			for (uint32_t k = 0; k < 8; k++) {
-				uint32_t pixelIdx = 8 * j + k;
-				mask[pixelIdx] = (((idx >> k) & 0x01) != 0);
-			}
-		}
+		CpuDispatch::UnpackBits(mask.get(), packedMask.get(), (int32_t)maskSize);
 
 		// Image
 		std::unique_ptr<uint32_t[]> pixels = std::make_unique<uint32_t[]>(width * height);
 		ReadImageFromFile(s, (uint8_t*)pixels.get(), width, height, channelCount);
 
+		// Only palette indices and alpha are uploaded, the palette is applied in shader, so the texture has half the size
+		std::unique_ptr<uint8_t[]> indexedPixels = std::make_unique<uint8_t[]>(width * height * 2);
+		for (uint32_t i = 0; i < width * height; i++) {
+			indexedPixels[i * 2] = (uint8_t)(pixels[i] & 0xff);
+			indexedPixels[i * 2 + 1] = (uint8_t)(pixels[i] >> 24);
+		}
+
+		std::unique_ptr<Texture> textureDiffuse = std::make_unique<Texture>(fullPath.data(), Texture::Format::RG8, width, height);
+		textureDiffuse->loadFromTexels(indexedPixels.get(), 0, 0, width, height);
+		textureDiffuse->setMinFiltering(SamplerFilter::Nearest);
+		textureDiffuse->setMagFiltering(SamplerFilter::Nearest);
+
+		// Remapping is applied to the palette, so all tile sets can be drawn by the same shader
+		uint32_t palette[ColorsPerPalette];
 		if (paletteRemapping != nullptr) {
-			for (uint32_t i = 0; i < width * height; i++) {
-				uint32_t color = _palettes[paletteRemapping[pixels[i] & 0xff]];
-				pixels[i] = (color & 0xffffff) | ((((color >> 24) & 0xff) * ((pixels[i] >> 24) & 0xff) / 255) << 24);
+			for (int32_t i = 0; i < ColorsPerPalette; i++) {
+				palette[i] = _palettes[paletteRemapping[i]];
 			}
 		} else {
-			for (uint32_t i = 0; i < width * height; i++) {
-				uint32_t color = _palettes[pixels[i] & 0xff];
-				pixels[i] = (color & 0xffffff) | ((((color >> 24) & 0xff) * ((pixels[i] >> 24) & 0xff) / 255) << 24);
-			}
+			std::memcpy(palette, _palettes, ColorsPerPalette * sizeof(uint32_t));
 		}
 
-		std::unique_ptr<Texture> textureDiffuse = std::make_unique<Texture>(fullPath.data(), Texture::Format::RGBA8, width, height);
-		textureDiffuse->loadFromTexels((unsigned char*)pixels.get(), 0, 0, width, height);
-		textureDiffuse->setMinFiltering(SamplerFilter::Nearest);
-		textureDiffuse->setMagFiltering(SamplerFilter::Nearest);
+		std::unique_ptr<Texture> texturePalette = std::make_unique<Texture>(nullptr, Texture::Format::RGBA8, ColorsPerPalette, 1);
+		texturePalette->loadFromTexels((unsigned char*)palette, 0, 0, ColorsPerPalette, 1);
+		texturePalette->setMinFiltering(SamplerFilter::Nearest);
+		texturePalette->setMagFiltering(SamplerFilter::Nearest);
+
+		// Expanded pixels are still needed for classification of tiles and for the caption tile
+		CpuDispatch::ExpandPaletteInPlace(pixels.get(), (int32_t)(width * height), palette);
 
 		// Caption Tile
 		std::unique_ptr<Color[]> captionTile = nullptr;
@@ -802,7 +1095,7 @@ namespace Jazz2
 			}
 		}
 
-		return std::make_unique<Tiles::TileSet>(std::move(textureDiffuse), std::move(mask), maskSize * 8, std::move(captionTile));
+		return std::make_unique<Tiles::TileSet>(std::move(textureDiffuse), std::move(texturePalette), std::move(mask), maskSize * 8, std::move(captionTile), pixels.get());
 	}
 
 	bool ContentResolver::LevelExists(const StringView& episodeName, const StringView& levelName)
@@ -814,6 +1107,7 @@ namespace Jazz2
 
 	bool ContentResolver::LoadLevel(LevelHandler* levelHandler, const StringView& path, GameDifficulty difficulty)
 	{
+		ZoneScoped;
 		// Try "Content" directory first, then "Cache" directory
 		auto pathNormalized = fs::ToNativeSeparators(path);
 		String fullPath = fs::JoinPath({ GetContentPath(), "Episodes"_s, pathNormalized + ".j2l"_s });
@@ -897,6 +1191,7 @@ namespace Jazz2
 				if (_isLoading) {
 					_cachedMetadata.clear();
 					_cachedGraphics.clear();
+					_atlasPages.clear();
 
 					for (int32_t i = 0; i < (int32_t)FontType::Count; i++) {
 						_fonts[i] = nullptr;
@@ -970,6 +1265,7 @@ namespace Jazz2
 			if (_isLoading) {
 				_cachedMetadata.clear();
 				_cachedGraphics.clear();
+				_atlasPages.clear();
 
 				for (int32_t i = 0; i < (int32_t)FontType::Count; i++) {
 					_fonts[i] = nullptr;
@@ -1071,6 +1367,7 @@ namespace Jazz2
 
 	void ContentResolver::CompileShaders()
 	{
+		ZoneScoped;
 		_precompiledShaders[(int32_t)PrecompiledShader::Lighting] = CompileShader("Lighting", Shaders::LightingVs, Shaders::LightingFs);
 		_precompiledShaders[(int32_t)PrecompiledShader::BatchedLighting] = CompileShader("BatchedLighting", Shaders::BatchedLightingVs, Shaders::LightingFs, Shader::Introspection::NoUniformsInBlocks);
 		_precompiledShaders[(int32_t)PrecompiledShader::Lighting]->registerBatchedShader(*_precompiledShaders[(int32_t)PrecompiledShader::BatchedLighting]);
@@ -1087,26 +1384,53 @@ namespace Jazz2
 		_precompiledShaders[(int32_t)PrecompiledShader::Colorized] = CompileShader("Colorized", Shader::DefaultVertex::SPRITE, Shaders::ColorizedFs);
 		_precompiledShaders[(int32_t)PrecompiledShader::BatchedColorized] = CompileShader("BatchedColorized", Shader::DefaultVertex::BATCHED_SPRITES, Shaders::ColorizedFs, Shader::Introspection::NoUniformsInBlocks);
 		_precompiledShaders[(int32_t)PrecompiledShader::Colorized]->registerBatchedShader(*_precompiledShaders[(int32_t)PrecompiledShader::BatchedColorized]);
+		_precompiledShaders[(int32_t)PrecompiledShader::InstancedColorized] = CompileShader("InstancedColorized", Shader::DefaultVertex::INSTANCED_SPRITES, Shaders::ColorizedFs);
+		_precompiledShaders[(int32_t)PrecompiledShader::Colorized]->registerInstancedShader(*_precompiledShaders[(int32_t)PrecompiledShader::InstancedColorized]);
+		_precompiledShaders[(int32_t)PrecompiledShader::MeshColorized] = CompileShader("MeshColorized", Shader::DefaultVertex::MESHSPRITE, Shaders::ColorizedFs);
+		_precompiledShaders[(int32_t)PrecompiledShader::BatchedMeshColorized] = CompileShader("BatchedMeshColorized", Shader::DefaultVertex::BATCHED_MESHSPRITES, Shaders::ColorizedFs, Shader::Introspection::NoUniformsInBlocks);
+		_precompiledShaders[(int32_t)PrecompiledShader::MeshColorized]->registerBatchedShader(*_precompiledShaders[(int32_t)PrecompiledShader::BatchedMeshColorized]);
 
 		_precompiledShaders[(int32_t)PrecompiledShader::Tinted] = CompileShader("Tinted", Shader::DefaultVertex::SPRITE, Shaders::TintedFs);
 		_precompiledShaders[(int32_t)PrecompiledShader::BatchedTinted] = CompileShader("BatchedTinted", Shader::DefaultVertex::BATCHED_SPRITES, Shaders::TintedFs, Shader::Introspection::NoUniformsInBlocks);
 		_precompiledShaders[(int32_t)PrecompiledShader::Tinted]->registerBatchedShader(*_precompiledShaders[(int32_t)PrecompiledShader::BatchedTinted]);
+		_precompiledShaders[(int32_t)PrecompiledShader::InstancedTinted] = CompileShader("InstancedTinted", Shader::DefaultVertex::INSTANCED_SPRITES, Shaders::TintedFs);
+		_precompiledShaders[(int32_t)PrecompiledShader::Tinted]->registerInstancedShader(*_precompiledShaders[(int32_t)PrecompiledShader::InstancedTinted]);
+
+		_precompiledShaders[(int32_t)PrecompiledShader::Palette] = CompileShader("Palette", Shader::DefaultVertex::SPRITE, Shaders::PaletteFs);
+		_precompiledShaders[(int32_t)PrecompiledShader::BatchedPalette] = CompileShader("BatchedPalette", Shader::DefaultVertex::BATCHED_SPRITES, Shaders::PaletteFs, Shader::Introspection::NoUniformsInBlocks);
+		_precompiledShaders[(int32_t)PrecompiledShader::Palette]->registerBatchedShader(*_precompiledShaders[(int32_t)PrecompiledShader::BatchedPalette]);
+		_precompiledShaders[(int32_t)PrecompiledShader::InstancedPalette] = CompileShader("InstancedPalette", Shader::DefaultVertex::INSTANCED_SPRITES, Shaders::PaletteFs);
+		_precompiledShaders[(int32_t)PrecompiledShader::Palette]->registerInstancedShader(*_precompiledShaders[(int32_t)PrecompiledShader::InstancedPalette]);
+
+		_precompiledShaders[(int32_t)PrecompiledShader::TintedPalette] = CompileShader("TintedPalette", Shader::DefaultVertex::SPRITE, Shaders::TintedPaletteFs);
+		_precompiledShaders[(int32_t)PrecompiledShader::BatchedTintedPalette] = CompileShader("BatchedTintedPalette", Shader::DefaultVertex::BATCHED_SPRITES, Shaders::TintedPaletteFs, Shader::Introspection::NoUniformsInBlocks);
+		_precompiledShaders[(int32_t)PrecompiledShader::TintedPalette]->registerBatchedShader(*_precompiledShaders[(int32_t)PrecompiledShader::BatchedTintedPalette]);
+		_precompiledShaders[(int32_t)PrecompiledShader::InstancedTintedPalette] = CompileShader("InstancedTintedPalette", Shader::DefaultVertex::INSTANCED_SPRITES, Shaders::TintedPaletteFs);
+		_precompiledShaders[(int32_t)PrecompiledShader::TintedPalette]->registerInstancedShader(*_precompiledShaders[(int32_t)PrecompiledShader::InstancedTintedPalette]);
 
 		_precompiledShaders[(int32_t)PrecompiledShader::Outline] = CompileShader("Outline", Shader::DefaultVertex::SPRITE, Shaders::OutlineFs);
 		_precompiledShaders[(int32_t)PrecompiledShader::BatchedOutline] = CompileShader("BatchedOutline", Shader::DefaultVertex::BATCHED_SPRITES, Shaders::OutlineFs, Shader::Introspection::NoUniformsInBlocks);
 		_precompiledShaders[(int32_t)PrecompiledShader::Outline]->registerBatchedShader(*_precompiledShaders[(int32_t)PrecompiledShader::BatchedOutline]);
+		_precompiledShaders[(int32_t)PrecompiledShader::InstancedOutline] = CompileShader("InstancedOutline", Shader::DefaultVertex::INSTANCED_SPRITES, Shaders::OutlineFs);
+		_precompiledShaders[(int32_t)PrecompiledShader::Outline]->registerInstancedShader(*_precompiledShaders[(int32_t)PrecompiledShader::InstancedOutline]);
 
 		_precompiledShaders[(int32_t)PrecompiledShader::WhiteMask] = CompileShader("WhiteMask", Shader::DefaultVertex::SPRITE, Shaders::WhiteMaskFs);
 		_precompiledShaders[(int32_t)PrecompiledShader::BatchedWhiteMask] = CompileShader("BatchedWhiteMask", Shader::DefaultVertex::BATCHED_SPRITES, Shaders::WhiteMaskFs, Shader::Introspection::NoUniformsInBlocks);
 		_precompiledShaders[(int32_t)PrecompiledShader::WhiteMask]->registerBatchedShader(*_precompiledShaders[(int32_t)PrecompiledShader::BatchedWhiteMask]);
+		_precompiledShaders[(int32_t)PrecompiledShader::InstancedWhiteMask] = CompileShader("InstancedWhiteMask", Shader::DefaultVertex::INSTANCED_SPRITES, Shaders::WhiteMaskFs);
+		_precompiledShaders[(int32_t)PrecompiledShader::WhiteMask]->registerInstancedShader(*_precompiledShaders[(int32_t)PrecompiledShader::InstancedWhiteMask]);
 
 		_precompiledShaders[(int32_t)PrecompiledShader::PartialWhiteMask] = CompileShader("PartialWhiteMask", Shader::DefaultVertex::SPRITE, Shaders::PartialWhiteMaskFs);
 		_precompiledShaders[(int32_t)PrecompiledShader::BatchedPartialWhiteMask] = CompileShader("BatchedPartialWhiteMask", Shader::DefaultVertex::BATCHED_SPRITES, Shaders::PartialWhiteMaskFs, Shader::Introspection::NoUniformsInBlocks);
 		_precompiledShaders[(int32_t)PrecompiledShader::PartialWhiteMask]->registerBatchedShader(*_precompiledShaders[(int32_t)PrecompiledShader::BatchedPartialWhiteMask]);
+		_precompiledShaders[(int32_t)PrecompiledShader::InstancedPartialWhiteMask] = CompileShader("InstancedPartialWhiteMask", Shader::DefaultVertex::INSTANCED_SPRITES, Shaders::PartialWhiteMaskFs);
+		_precompiledShaders[(int32_t)PrecompiledShader::PartialWhiteMask]->registerInstancedShader(*_precompiledShaders[(int32_t)PrecompiledShader::InstancedPartialWhiteMask]);
 
 		_precompiledShaders[(int32_t)PrecompiledShader::FrozenMask] = CompileShader("FrozenMask", Shader::DefaultVertex::SPRITE, Shaders::FrozenMaskFs);
 		_precompiledShaders[(int32_t)PrecompiledShader::BatchedFrozenMask] = CompileShader("BatchedFrozenMask", Shader::DefaultVertex::BATCHED_SPRITES, Shaders::FrozenMaskFs, Shader::Introspection::NoUniformsInBlocks);
 		_precompiledShaders[(int32_t)PrecompiledShader::FrozenMask]->registerBatchedShader(*_precompiledShaders[(int32_t)PrecompiledShader::BatchedFrozenMask]);
+		_precompiledShaders[(int32_t)PrecompiledShader::InstancedFrozenMask] = CompileShader("InstancedFrozenMask", Shader::DefaultVertex::INSTANCED_SPRITES, Shaders::FrozenMaskFs);
+		_precompiledShaders[(int32_t)PrecompiledShader::FrozenMask]->registerInstancedShader(*_precompiledShaders[(int32_t)PrecompiledShader::InstancedFrozenMask]);
 
 #if defined(ALLOW_RESCALE_SHADERS)
 		_precompiledShaders[(int32_t)PrecompiledShader::ResizeHQ2x] = CompileShader("ResizeHQ2x", Shaders::ResizeHQ2xVs, Shaders::ResizeHQ2xFs);
@@ -14,8 +14,11 @@
 #include "../nCine/Graphics/Viewport.h"
 #include "../nCine/IO/FileSystem.h"
 #include "../nCine/IO/IFileStream.h"
+#include "../nCine/Base/Atom.h"
 #include "../nCine/Base/HashMap.h"
 
+#include <algorithm>
+
 #include <Containers/Pair.h>
 #include <Containers/SmallVector.h>
 
@@ -45,7 +48,8 @@ namespace Jazz2
 	enum class GenericGraphicResourceFlags {
 		None = 0x00,
 
-		Referenced = 0x01
+		Referenced = 0x01,
+		Atlas = 0x02
 	};
 
 	DEFINE_ENUM_OPERATORS(GenericGraphicResourceFlags);
@@ -56,9 +60,12 @@ namespace Jazz2
 		GenericGraphicResourceFlags Flags;
 		//GenericGraphicResourceAsyncFinalize AsyncFinalize;
 
-		std::unique_ptr<Texture> TextureDiffuse;
+		/// Texture containing the sprite sheet, it can be a shared atlas page if `GenericGraphicResourceFlags::Atlas` is set
+		std::shared_ptr<Texture> TextureDiffuse;
 		std::unique_ptr<Texture> TextureNormal;
 		std::unique_ptr<uint8_t[]> Mask;
+		/// Position of the sprite sheet in `TextureDiffuse`
+		Vector2i TextureOffset;
 		Vector2i FrameDimensions;
 		Vector2i FrameConfiguration;
 		float AnimDuration;
@@ -66,6 +73,14 @@ namespace Jazz2
 		Vector2i Hotspot;
 		Vector2i Coldspot;
 		Vector2i Gunspot;
+
+		/// Returns rectangle of the specified frame in `TextureDiffuse` (in pixels)
+		Recti GetFrameRect(int32_t frame) const
+		{
+			int32_t col = frame % FrameConfiguration.X;
+			int32_t row = frame / FrameConfiguration.X;
+			return Recti(TextureOffset.X + FrameDimensions.X * col, TextureOffset.Y + FrameDimensions.Y * row, FrameDimensions.X, FrameDimensions.Y);
+		}
 	};
 
 	class GraphicResource
@@ -92,6 +107,46 @@ namespace Jazz2
 		}
 	};
 
+	/// Packs rectangles into shelves of a square page, each rectangle is surrounded by padding
+	class AtlasShelfPacker
+	{
+	public:
+		Vector2i Cursor;
+		int32_t ShelfHeight;
+
+		AtlasShelfPacker()
+			: Cursor(0, 0), ShelfHeight(0)
+		{
+		}
+
+		/// Returns position of the rectangle (without padding) in the page, or `false` if the page is full
+		bool TryAllocate(int32_t width, int32_t height, int32_t pageSize, int32_t padding, Vector2i& offset)
+		{
+			int32_t paddedWidth = width + padding * 2;
+			int32_t paddedHeight = height + padding * 2;
+			if (paddedWidth > pageSize) {
+				return false;
+			}
+
+			Vector2i pos = Cursor;
+			int32_t shelfHeight = ShelfHeight;
+			if (pos.X + paddedWidth > pageSize) {
+				// Doesn't fit to the current shelf, try to start a new one
+				pos.X = 0;
+				pos.Y += shelfHeight;
+				shelfHeight = 0;
+			}
+			if (pos.Y + paddedHeight > pageSize) {
+				return false;
+			}
+
+			Cursor = Vector2i(pos.X + paddedWidth, pos.Y);
+			ShelfHeight = std::max(shelfHeight, paddedHeight);
+			offset = Vector2i(pos.X + padding, pos.Y + padding);
+			return true;
+		}
+	};
+
 	class SoundResource
 	{
 	public:
@@ -112,8 +167,8 @@ namespace Jazz2
 	public:
 		MetadataFlags Flags;
 
-		HashMap<String, GraphicResource> Graphics;
-		HashMap<String, SoundResource> Sounds;
+		HashMap<Atom, GraphicResource> Graphics;
+		HashMap<Atom, SoundResource> Sounds;
 		Vector2i BoundingBox;
 
 		Metadata()
@@ -183,16 +238,30 @@ namespace Jazz2
 
 		Colorized,
 		BatchedColorized,
+		InstancedColorized,
+		MeshColorized,
+		BatchedMeshColorized,
 		Tinted,
 		BatchedTinted,
+		InstancedTinted,
+		Palette,
+		BatchedPalette,
+		InstancedPalette,
+		TintedPalette,
+		BatchedTintedPalette,
+		InstancedTintedPalette,
 		Outline,
 		BatchedOutline,
+		InstancedOutline,
 		WhiteMask,
 		BatchedWhiteMask,
+		InstancedWhiteMask,
 		PartialWhiteMask,
 		BatchedPartialWhiteMask,
+		InstancedPartialWhiteMask,
 		FrozenMask,
 		BatchedFrozenMask,
+		InstancedFrozenMask,
 
 #if defined(ALLOW_RESCALE_SHADERS)
 		ResizeHQ2x,
@@ -216,6 +285,12 @@ namespace Jazz2
 		static constexpr uint8_t EpisodeFile = 2;
 		static constexpr uint8_t CacheIndexFile = 3;
 		static constexpr uint8_t ConfigFile = 4;
+		static constexpr uint8_t CompiledMetadataFile = 5;
+		static constexpr uint8_t ScriptByteCodeFile = 6;
+
+		static constexpr uint16_t CompiledMetadataVersion = 1;
+		/// Size of the compiled metadata header (signature, file type, version and modification time of the source)
+		static constexpr int32_t CompiledMetadataHeaderSize = 19;
 
 		static constexpr int32_t PaletteCount = 256;
 		static constexpr int32_t ColorsPerPalette = 256;
@@ -290,7 +365,12 @@ namespace Jazz2
 		/// Deleted assignment operator
 		ContentResolver& operator=(const ContentResolver&) = delete;
 
+		bool CompileMetadata(const char* json, uint32_t length, IFileStream& so);
+		void ReadCompiledMetadata(IFileStream& s, Metadata* metadata);
+		static bool ValidateCompiledMetadata(const uint8_t* data, int32_t size);
 		GenericGraphicResource* RequestGraphicsAura(const StringView& path, uint16_t paletteOffset);
+		void CreateGraphicsTexture(GenericGraphicResource* graphics, const char* name, const uint32_t* pixels, int32_t width, int32_t height, bool linearSampling);
+		bool AllocateAtlasRegion(int32_t width, int32_t height, std::shared_ptr<Texture>& texture, Vector2i& offset);
 		static void ReadImageFromFile(std::unique_ptr<IFileStream>& s, uint8_t* data, int32_t width, int32_t height, int32_t channelCount);
 		
 		std::unique_ptr<Shader> CompileShader(const char* shaderName, Shader::DefaultVertex vertex, const char* fragment, Shader::Introspection introspection = Shader::Introspection::Enabled);
@@ -301,10 +381,21 @@ namespace Jazz2
 		void MigrateGraphics(const StringView& path);
 #endif
 
+		/// Shared texture page with sprite sheets packed in shelves
+		struct AtlasPage {
+			std::shared_ptr<Texture> Page;
+			AtlasShelfPacker Packer;
+		};
+
+		static constexpr int32_t AtlasPageSize = 2048;
+		static constexpr int32_t AtlasMaxSheetSize = 512;
+		static constexpr int32_t AtlasPadding = 1;
+
 		bool _isLoading;
 		uint32_t _palettes[PaletteCount * ColorsPerPalette];
 		HashMap<String, std::unique_ptr<Metadata>> _cachedMetadata;
 		HashMap<Pair<String, uint16_t>, std::unique_ptr<GenericGraphicResource>> _cachedGraphics;
+		SmallVector<AtlasPage, 0> _atlasPages;
 		std::unique_ptr<UI::Font> _fonts[(int32_t)FontType::Count];
 		std::unique_ptr<Shader> _precompiledShaders[(int32_t)PrecompiledShader::Count];
 
@@ -6,6 +6,7 @@
 #include "PlayerActions.h"
 
 #include "../nCine/Audio/AudioBufferPlayer.h"
+#include "../nCine/Base/FunctionRef.h"
 
 namespace Jazz2
 {
@@ -63,9 +64,9 @@ namespace Jazz2
 			return IsPositionEmpty(self, aabb, params, &collider);
 		}
 
-		virtual void FindCollisionActorsByAABB(Actors::ActorBase* self, const AABBf& aabb, const std::function<bool(Actors::ActorBase*)>& callback) = 0;
-		virtual void FindCollisionActorsByRadius(float x, float y, float radius, const std::function<bool(Actors::ActorBase*)>& callback) = 0;
-		virtual void GetCollidingPlayers(const AABBf& aabb, const std::function<bool(Actors::ActorBase*)> callback) = 0;
+		virtual void FindCollisionActorsByAABB(Actors::ActorBase* self, const AABBf& aabb, FunctionRef<bool(Actors::ActorBase*)> callback) = 0;
+		virtual void FindCollisionActorsByRadius(float x, float y, float radius, FunctionRef<bool(Actors::ActorBase*)> callback) = 0;
+		virtual void GetCollidingPlayers(const AABBf& aabb, FunctionRef<bool(Actors::ActorBase*)> callback) = 0;
 
 		virtual void BroadcastTriggeredEvent(Actors::ActorBase* initiator, EventType eventType, uint8_t* eventParams) = 0;
 		virtual void BeginLevelChange(ExitType exitType, const StringView& nextLevel) = 0;
@@ -31,7 +31,7 @@ namespace Jazz2
 		virtual Flags GetFlags() const = 0;
 		virtual const char* GetNewestVersion() const = 0;
 
-		virtual void RefreshCacheLevels() = 0;
+		virtual void RefreshCacheLevels(bool force) = 0;
 		
 	private:
 		/// Deleted copy constructor
@@ -2,6 +2,9 @@
 #include "PreferencesCache.h"
 #include "UI/ControlScheme.h"
 #include "UI/HUD.h"
+#if defined(NCINE_PROFILING)
+#	include "UI/ProfilerOverlay.h"
+#endif
 #include "../Common.h"
 
 #if defined(WITH_ANGELSCRIPT)
@@ -19,6 +22,7 @@
 #include "../nCine/Graphics/RenderQueue.h"
 #include "../nCine/Audio/AudioReaderMpt.h"
 #include "../nCine/Base/Random.h"
+#include "../nCine/Base/FrameProfiler.h"
 
 #include "Actors/Player.h"
 #include "Actors/SolidObjectBase.h"
@@ -119,6 +123,9 @@ namespace Jazz2
 		if ((levelInit.LastExitType & ExitType::FastTransition) != ExitType::FastTransition) {
 			_hud->BeginFadeIn();
 		}
+#if defined(NCINE_PROFILING)
+		_profilerOverlay = std::make_unique<UI::ProfilerOverlay>(this);
+#endif
 
 #if defined(WITH_ANGELSCRIPT)
 		if (_scripts != nullptr) {
@@ -138,6 +145,9 @@ namespace Jazz2
 		// Remove nodes from UpscaleRenderPass
 		_combineRenderer->setParent(nullptr);
 		_hud->setParent(nullptr);
+#if defined(NCINE_PROFILING)
+		_profilerOverlay->setParent(nullptr);
+#endif
 	}
 
 	Recti LevelHandler::LevelBounds() const
@@ -310,6 +320,8 @@ namespace Jazz2
 			}
 
 			if (_difficulty != GameDifficulty::Multiplayer) {
+				ProfilerZoneScopedN("Event Activation");
+
 				if (!_players.empty()) {
 					auto& pos = _players[0]->GetPos();
 					int32_t tx1 = (int32_t)pos.X / Tiles::TileSet::DefaultTileSize;
@@ -352,6 +364,8 @@ namespace Jazz2
 
 			// Weather
 			if (_weatherType != WeatherType::None) {
+				ProfilerZoneScopedN("Weather");
+
 				uint32_t weatherIntensity = std::max((uint32_t)(_weatherIntensity * timeMult), 1u);
 				for (int32_t i = 0; i < weatherIntensity; i++) {
 					TileMap::DebrisFlags debrisFlags;
@@ -369,7 +383,7 @@ namespace Jazz2
 
 					WeatherType realWeatherType = (_weatherType & ~WeatherType::OutdoorsOnly);
 					if (realWeatherType == WeatherType::Rain) {
-						auto it = _commonResources->Graphics.find(String::nullTerminatedView("Rain"_s));
+						auto it = _commonResources->Graphics.find("Rain"_atom);
 						if (it != _commonResources->Graphics.end()) {
 							auto& resBase = it->second.Base;
 							Vector2i texSize = resBase->TextureDiffuse->size();
@@ -397,9 +411,9 @@ namespace Jazz2
 							uint32_t col = curAnimFrame % resBase->FrameConfiguration.X;
 							uint32_t row = curAnimFrame / resBase->FrameConfiguration.X;
 							debris.TexScaleX = (float(resBase->FrameDimensions.X) / float(texSize.X));
-							debris.TexBiasX = (float(resBase->FrameDimensions.X * col) / float(texSize.X));
+							debris.TexBiasX = (float(resBase->TextureOffset.X + resBase->FrameDimensions.X * col) / float(texSize.X));
 							debris.TexScaleY = (float(resBase->FrameDimensions.Y) / float(texSize.Y));
-							debris.TexBiasY = (float(resBase->FrameDimensions.Y * row) / float(texSize.Y));
+							debris.TexBiasY = (float(resBase->TextureOffset.Y + resBase->FrameDimensions.Y * row) / float(texSize.Y));
 
 							debris.DiffuseTexture = resBase->TextureDiffuse.get();
 							debris.Flags = debrisFlags;
@@ -407,7 +421,7 @@ namespace Jazz2
 							_tileMap->CreateDebris(debris);
 						}
 					} else {
-						auto it = _commonResources->Graphics.find(String::nullTerminatedView("Snow"_s));
+						auto it = _commonResources->Graphics.find("Snow"_atom);
 						if (it != _commonResources->Graphics.end()) {
 							auto& resBase = it->second.Base;
 							Vector2i texSize = resBase->TextureDiffuse->size();
@@ -436,9 +450,9 @@ namespace Jazz2
 							uint32_t col = curAnimFrame % resBase->FrameConfiguration.X;
 							uint32_t row = curAnimFrame / resBase->FrameConfiguration.X;
 							debris.TexScaleX = (float(resBase->FrameDimensions.X) / float(texSize.X));
-							debris.TexBiasX = (float(resBase->FrameDimensions.X * col) / float(texSize.X));
+							debris.TexBiasX = (float(resBase->TextureOffset.X + resBase->FrameDimensions.X * col) / float(texSize.X));
 							debris.TexScaleY = (float(resBase->FrameDimensions.Y) / float(texSize.Y));
-							debris.TexBiasY = (float(resBase->FrameDimensions.Y * row) / float(texSize.Y));
+							debris.TexBiasY = (float(resBase->TextureOffset.Y + resBase->FrameDimensions.Y * row) / float(texSize.Y));
 
 							debris.DiffuseTexture = resBase->TextureDiffuse.get();
 							debris.Flags = debrisFlags;
@@ -457,6 +471,7 @@ namespace Jazz2
 
 #if defined(WITH_ANGELSCRIPT)
 			if (_scripts != nullptr) {
+				ProfilerZoneScopedN("Script Calls");
 				_scripts->OnLevelUpdate(timeMult);
 			}
 #endif
@@ -580,6 +595,11 @@ namespace Jazz2
 			if (_hud != nullptr) {
 				_hud->setParent(_upscalePass.GetNode());
 			}
+#if defined(NCINE_PROFILING)
+			if (_profilerOverlay != nullptr) {
+				_profilerOverlay->setParent(_upscalePass.GetNode());
+			}
+#endif
 		}
 
 		_combineRenderer->Initialize(w, h);
@@ -599,6 +619,15 @@ namespace Jazz2
 	{
 		_pressedKeys.Set((uint32_t)event.sym);
 
+#if defined(NCINE_PROFILING)
+		// Profiler overlay and export of recorded frames
+		if (event.sym == KeySym::F9) {
+			_profilerOverlay->setDrawEnabled(!_profilerOverlay->isDrawEnabled());
+		} else if (event.sym == KeySym::F10) {
+			_profilerOverlay->Export();
+		}
+#endif
+
 		// Cheats
 		if (PreferencesCache::AllowCheats && _difficulty != GameDifficulty::Multiplayer && !_players.empty()) {
 			if (event.sym >= KeySym::A && event.sym <= KeySym::Z) {
@@ -709,7 +738,7 @@ namespace Jazz2
 
 	std::shared_ptr<AudioBufferPlayer> LevelHandler::PlayCommonSfx(const StringView& identifier, const Vector3f& pos, float gain, float pitch)
 	{
-		auto it = _commonResources->Sounds.find(String::nullTerminatedView(identifier));
+		auto it = _commonResources->Sounds.find(Atom::find(identifier));
 		if (it != _commonResources->Sounds.end()) {
 			int32_t idx = (it->second.Buffers.size() > 1 ? Random().Next(0, (int32_t)it->second.Buffers.size()) : 0);
 			auto& player = _playingSounds.emplace_back(std::make_shared<AudioBufferPlayer>(it->second.Buffers[idx].get()));
@@ -813,13 +842,13 @@ namespace Jazz2
 		return (*collider == nullptr);
 	}
 
-	void LevelHandler::FindCollisionActorsByAABB(Actors::ActorBase* self, const AABBf& aabb, const std::function<bool(Actors::ActorBase*)>& callback)
+	void LevelHandler::FindCollisionActorsByAABB(Actors::ActorBase* self, const AABBf& aabb, FunctionRef<bool(Actors::ActorBase*)> callback)
 	{
 		struct QueryHelper {
 			const LevelHandler* Handler;
 			const Actors::ActorBase* Self;
 			const AABBf& AABB;
-			const std::function<bool(Actors::ActorBase*)>& Callback;
+			FunctionRef<bool(Actors::ActorBase*)> Callback;
 
 			bool OnCollisionQuery(int32_t nodeId) {
 				Actors::ActorBase* actor = (Actors::ActorBase*)Handler->_collisions.GetUserData(nodeId);
@@ -837,7 +866,7 @@ namespace Jazz2
 		_collisions.Query(&helper, aabb);
 	}
 
-	void LevelHandler::FindCollisionActorsByRadius(float x, float y, float radius, const std::function<bool(Actors::ActorBase*)>& callback)
+	void LevelHandler::FindCollisionActorsByRadius(float x, float y, float radius, FunctionRef<bool(Actors::ActorBase*)> callback)
 	{
 		AABBf aabb = AABBf(x - radius, y - radius, x + radius, y + radius);
 		float radiusSquared = (radius * radius);
@@ -846,7 +875,7 @@ namespace Jazz2
 			const LevelHandler* Handler;
 			const float x, y;
 			const float RadiusSquared;
-			const std::function<bool(Actors::ActorBase*)>& Callback;
+			FunctionRef<bool(Actors::ActorBase*)> Callback;
 
 			bool OnCollisionQuery(int32_t nodeId) {
 				Actors::ActorBase* actor = (Actors::ActorBase*)Handler->_collisions.GetUserData(nodeId);
@@ -876,7 +905,7 @@ namespace Jazz2
 		_collisions.Query(&helper, aabb);
 	}
 
-	void LevelHandler::GetCollidingPlayers(const AABBf& aabb, const std::function<bool(Actors::ActorBase*)> callback)
+	void LevelHandler::GetCollidingPlayers(const AABBf& aabb, FunctionRef<bool(Actors::ActorBase*)> callback)
 	{
 		for (auto& player : _players) {
 			if (aabb.Overlaps(player->AABB)) {
@@ -1053,7 +1082,7 @@ namespace Jazz2
 			return;
 		}
 
-		auto it = _commonResources->Sounds.find(String::nullTerminatedView("SugarRush"_s));
+		auto it = _commonResources->Sounds.find("SugarRush"_atom);
 		if (it != _commonResources->Sounds.end()) {
 			int32_t idx = (it->second.Buffers.size() > 1 ? Random().Next(0, (int32_t)it->second.Buffers.size()) : 0);
 			_sugarRushMusic = _playingSounds.emplace_back(std::make_shared<AudioBufferPlayer>(it->second.Buffers[idx].get()));
@@ -1220,6 +1249,8 @@ namespace Jazz2
 
 	void LevelHandler::ResolveCollisions(float timeMult)
 	{
+		ProfilerZoneScopedN("Collisions");
+
 		auto it = _actors.begin();
 		while (it != _actors.end()) {
 			Actors::ActorBase* actor = it->get();
@@ -1296,6 +1327,8 @@ namespace Jazz2
 
 	void LevelHandler::UpdateCamera(float timeMult)
 	{
+		ProfilerZoneScopedN("Camera");
+
 		if (_players.empty()) {
 			return;
 		}
@@ -1614,6 +1647,8 @@ namespace Jazz2
 
 	bool LevelHandler::LightingRenderer::OnDraw(RenderQueue& renderQueue)
 	{
+		ProfilerZoneScopedN("Lighting");
+
 		_renderCommandsCount = 0;
 		_emittedLightsCache.clear();
 
@@ -1624,10 +1659,9 @@ namespace Jazz2
 
 		for (auto& light : _emittedLightsCache) {
 			auto command = RentRenderCommand();
-			auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-			instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(light.Pos.X, light.Pos.Y, light.RadiusNear / light.RadiusFar, 0.0f);
-			instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(light.RadiusFar * 2.0f, light.RadiusFar * 2.0f);
-			instanceBlock->uniform(Material::ColorUniformName)->setFloatValue(light.Intensity, light.Brightness, 0.0f, 0.0f);
+			command->material().setInstanceTexRect(light.Pos.X, light.Pos.Y, light.RadiusNear / light.RadiusFar, 0.0f);
+			command->material().setInstanceSpriteSize(light.RadiusFar * 2.0f, light.RadiusFar * 2.0f);
+			command->material().setInstanceColor(light.Intensity, light.Brightness, 0.0f, 0.0f);
 			command->setTransformation(Matrix4x4f::Translation(light.Pos.X, light.Pos.Y, 0));
 
 			renderQueue.addCommand(command);
@@ -1706,10 +1740,9 @@ namespace Jazz2
 	{
 		Vector2i size = _target->size();
 
-		auto instanceBlock = _renderCommand.material().uniformBlock(Material::InstanceBlockName);
-		instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(1.0f, 0.0f, -1.0f, 1.0f);
-		instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(static_cast<float>(size.X), static_cast<float>(size.Y));
-		instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf::White.Data());
+		_renderCommand.material().setInstanceTexRect(1.0f, 0.0f, -1.0f, 1.0f);
+		_renderCommand.material().setInstanceSpriteSize(static_cast<float>(size.X), static_cast<float>(size.Y));
+		_renderCommand.material().setInstanceColor(Colorf::White.Data());
 
 		_renderCommand.material().uniform("uPixelOffset")->setFloatValue(1.0f / size.X, 1.0f / size.Y);
 		if (!_downsampleOnly) {
@@ -1793,10 +1826,9 @@ namespace Jazz2
 			command.material().setTexture(4, *_owner->_noiseTexture);
 		}
 
-		auto instanceBlock = command.material().uniformBlock(Material::InstanceBlockName);
-		instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(1.0f, 0.0f, 1.0f, 0.0f);
-		instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(_size.X, _size.Y);
-		instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf::White.Data());
+		command.material().setInstanceTexRect(1.0f, 0.0f, 1.0f, 0.0f);
+		command.material().setInstanceSpriteSize(_size.X, _size.Y);
+		command.material().setInstanceColor(Colorf::White.Data());
 
 		command.material().uniform("uAmbientColor")->setFloatVector(_owner->_ambientColor.Data());
 		command.material().uniform("uTime")->setFloatValue(_owner->_elapsedFrames * 0.0018f);
@@ -37,6 +37,9 @@ namespace Jazz2
 	namespace UI
 	{
 		class HUD;
+#if defined(NCINE_PROFILING)
+		class ProfilerOverlay;
+#endif
 	}
 
 	namespace UI::Menu
@@ -111,9 +114,9 @@ namespace Jazz2
 		std::shared_ptr<AudioBufferPlayer> PlayCommonSfx(const StringView& identifier, const Vector3f& pos, float gain = 1.0f, float pitch = 1.0f) override;
 		void WarpCameraToTarget(const std::shared_ptr<Actors::ActorBase>& actor, bool fast = false) override;
 		bool IsPositionEmpty(Actors::ActorBase* self, const AABBf& aabb, TileCollisionParams& params, Actors::ActorBase** collider) override;
-		void FindCollisionActorsByAABB(Actors::ActorBase* self, const AABBf& aabb, const std::function<bool(Actors::ActorBase*)>& callback) override;
-		void FindCollisionActorsByRadius(float x, float y, float radius, const std::function<bool(Actors::ActorBase*)>& callback) override;
-		void GetCollidingPlayers(const AABBf& aabb, const std::function<bool(Actors::ActorBase*)> callback) override;
+		void FindCollisionActorsByAABB(Actors::ActorBase* self, const AABBf& aabb, FunctionRef<bool(Actors::ActorBase*)> callback) override;
+		void FindCollisionActorsByRadius(float x, float y, float radius, FunctionRef<bool(Actors::ActorBase*)> callback) override;
+		void GetCollidingPlayers(const AABBf& aabb, FunctionRef<bool(Actors::ActorBase*)> callback) override;
 
 		void BroadcastTriggeredEvent(Actors::ActorBase* initiator, EventType eventType, uint8_t* eventParams) override;
 		void BeginLevelChange(ExitType exitType, const StringView& nextLevel) override;
@@ -288,6 +291,9 @@ namespace Jazz2
 		SmallVector<std::shared_ptr<AudioBufferPlayer>> _playingSounds;
 		Metadata* _commonResources;
 		std::unique_ptr<UI::HUD> _hud;
+#if defined(NCINE_PROFILING)
+		std::unique_ptr<UI::ProfilerOverlay> _profilerOverlay;
+#endif
 		std::shared_ptr<UI::Menu::InGameMenu> _pauseMenu;
 		std::shared_ptr<AudioBufferPlayer> _sugarRushMusic;
 		std::shared_ptr<Actors::Bosses::BossBase> _activeBoss;
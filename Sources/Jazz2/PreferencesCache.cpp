@@ -44,6 +44,7 @@ namespace Jazz2
 	Vector2f PreferencesCache::TouchRightPadding;
 	char PreferencesCache::Language[6] { };
 	bool PreferencesCache::BypassCache = false;
+	ScriptProfilingMode PreferencesCache::ScriptProfiling = ScriptProfilingMode::Disabled;
 	float PreferencesCache::MasterVolume = 0.8f;
 	float PreferencesCache::SfxVolume = 0.8f;
 	float PreferencesCache::MusicVolume = 0.4f;
@@ -275,6 +276,10 @@ namespace Jazz2
 				ActiveRescaleMode = RescaleMode::None;
 			} else if (arg == "/mute"_s) {
 				MasterVolume = 0.0f;
+			} else if (arg == "/profile-scripts"_s) {
+				ScriptProfiling = ScriptProfilingMode::Instrumented;
+			} else if (arg == "/profile-scripts-sampling"_s) {
+				ScriptProfiling = ScriptProfilingMode::Sampling;
 			}
 		}
 	}
@@ -45,6 +45,12 @@ namespace Jazz2
 
 	DEFINE_ENUM_OPERATORS(UnlockableEpisodes);
 
+	enum class ScriptProfilingMode {
+		Disabled,
+		Instrumented,
+		Sampling
+	};
+
 	enum class EpisodeContinuationFlags : uint8_t {
 		None = 0x00,
 
@@ -104,6 +110,7 @@ namespace Jazz2
 		static Vector2f TouchRightPadding;
 		static char Language[6];
 		static bool BypassCache;
+		static ScriptProfilingMode ScriptProfiling;
 
 		// Sounds
 		static float MasterVolume;
@@ -2206,6 +2206,11 @@ namespace Jazz2::Scripting
 			}
 		}
 
+		void SetPlayer(Actors::Player* player)
+		{
+			_player = player;
+		}
+
 		// Assignment operator
 		jjPLAYER& operator=(const jjPLAYER& o)
 		{
@@ -2806,15 +2811,11 @@ namespace Jazz2::Scripting
 	int32_t get_jjPlayerCount() {
 		auto ctx = asGetActiveContext();
 		auto owner = reinterpret_cast<LevelScriptLoader*>(ctx->GetEngine()->GetUserData(ScriptLoader::EngineToOwner));
-
-		void* mem = asAllocMem(sizeof(jjPLAYER));
 		return owner->GetPlayers().size();
 	}
 	int32_t get_jjLocalPlayerCount() {
 		auto ctx = asGetActiveContext();
 		auto owner = reinterpret_cast<LevelScriptLoader*>(ctx->GetEngine()->GetUserData(ScriptLoader::EngineToOwner));
-
-		void* mem = asAllocMem(sizeof(jjPLAYER));
 		return owner->GetPlayers().size();
 	}
 
@@ -2824,8 +2825,9 @@ namespace Jazz2::Scripting
 		auto ctx = asGetActiveContext();
 		auto owner = reinterpret_cast<LevelScriptLoader*>(ctx->GetEngine()->GetUserData(ScriptLoader::EngineToOwner));
 
-		void* mem = asAllocMem(sizeof(jjPLAYER));
-		return new(mem) jjPLAYER(owner, 0);
+		jjPLAYER* playerWrapper = owner->GetPlayerWrapper(0);
+		playerWrapper->AddRef();
+		return playerWrapper;
 	}
 	jjPLAYER* get_jjPlayers(uint8_t index) {
 		noop();
@@ -2833,8 +2835,9 @@ namespace Jazz2::Scripting
 		auto ctx = asGetActiveContext();
 		auto owner = reinterpret_cast<LevelScriptLoader*>(ctx->GetEngine()->GetUserData(ScriptLoader::EngineToOwner));
 
-		void* mem = asAllocMem(sizeof(jjPLAYER));
-		return new(mem) jjPLAYER(owner, index);
+		jjPLAYER* playerWrapper = owner->GetPlayerWrapper(index);
+		playerWrapper->AddRef();
+		return playerWrapper;
 	}
 	jjPLAYER* get_jjLocalPlayers(uint8_t index) {
 		noop();
@@ -2842,8 +2845,9 @@ namespace Jazz2::Scripting
 		auto ctx = asGetActiveContext();
 		auto owner = reinterpret_cast<LevelScriptLoader*>(ctx->GetEngine()->GetUserData(ScriptLoader::EngineToOwner));
 
-		void* mem = asAllocMem(sizeof(jjPLAYER));
-		return new(mem) jjPLAYER(owner, index);
+		jjPLAYER* playerWrapper = owner->GetPlayerWrapper(index);
+		playerWrapper->AddRef();
+		return playerWrapper;
 	}
 
 	class jjWEAPON
@@ -3831,9 +3835,15 @@ namespace Jazz2::Scripting
 	LevelScriptLoader::LevelScriptLoader(LevelHandler* levelHandler, const StringView& scriptPath)
 		:
 		_levelHandler(levelHandler),
+		_onLevelLoad(nullptr),
+		_onLevelBegin(nullptr),
+		_onLevelReload(nullptr),
 		_onLevelUpdate(nullptr),
+		_onPlayer(nullptr),
 		_onLevelUpdateLastFrame(-1)
 	{
+		std::memset(_onFunctions, 0, sizeof(_onFunctions));
+
 		// Try to load the script
 		HashMap<String, bool> DefinedSymbols = {
 #if defined(DEATH_TARGET_EMSCRIPTEN)
@@ -3894,15 +3904,22 @@ namespace Jazz2::Scripting
 				break;
 		}
 
+		if (PreferencesCache::ScriptProfiling != ScriptProfilingMode::Disabled) {
+			EnableProfiler(PreferencesCache::ScriptProfiling == ScriptProfilingMode::Sampling);
+		}
+
 		int r = Build(); RETURN_ASSERT_MSG(r >= 0, "Cannot compile the script. Please correct the code and try again.");
 
-		switch (_scriptContextType) {
-			case ScriptContextType::Legacy:
-				_onLevelUpdate = _module->GetFunctionByDecl("void onMain()");
-				break;
-			case ScriptContextType::Standard:
-				_onLevelUpdate = _module->GetFunctionByDecl("void onLevelUpdate(float)");
-				break;
+		ResolveEntryPoints();
+	}
+
+	LevelScriptLoader::~LevelScriptLoader()
+	{
+		// Scripts can still hold references to the wrappers, so they are released by the engine later
+		for (jjPLAYER* playerWrapper : _playerWrappers) {
+			if (playerWrapper != nullptr) {
+				playerWrapper->Release();
+			}
 		}
 	}
 
@@ -3930,14 +3947,13 @@ namespace Jazz2::Scripting
 
 	void LevelScriptLoader::OnLevelLoad()
 	{
-		asIScriptFunction* func = _module->GetFunctionByDecl("void onLevelLoad()");
-		if (func == nullptr) {
+		if (_onLevelLoad == nullptr) {
 			return;
 		}
 
 		asIScriptContext* ctx = _engine->RequestContext();
 
-		ctx->Prepare(func);
+		ctx->Prepare(_onLevelLoad);
 		int r = ctx->Execute();
 		if (r == asEXECUTION_EXCEPTION) {
 			OnException(ctx);
@@ -3948,14 +3964,13 @@ namespace Jazz2::Scripting
 
 	void LevelScriptLoader::OnLevelBegin()
 	{
-		asIScriptFunction* func = _module->GetFunctionByDecl("void onLevelBegin()");
-		if (func == nullptr) {
+		if (_onLevelBegin == nullptr) {
 			return;
 		}
 
 		asIScriptContext* ctx = _engine->RequestContext();
 
-		ctx->Prepare(func);
+		ctx->Prepare(_onLevelBegin);
 		int r = ctx->Execute();
 		if (r == asEXECUTION_EXCEPTION) {
 			OnException(ctx);
@@ -3966,14 +3981,13 @@ namespace Jazz2::Scripting
 
 	void LevelScriptLoader::OnLevelReload()
 	{
-		asIScriptFunction* func = _module->GetFunctionByDecl("void onLevelReload()");
-		if (func == nullptr) {
+		if (_onLevelReload == nullptr) {
 			return;
 		}
 
 		asIScriptContext* ctx = _engine->RequestContext();
 
-		ctx->Prepare(func);
+		ctx->Prepare(_onLevelReload);
 		int r = ctx->Execute();
 		if (r == asEXECUTION_EXCEPTION) {
 			OnException(ctx);
@@ -3986,9 +4000,7 @@ namespace Jazz2::Scripting
 	{
 		switch (_scriptContextType) {
 			case ScriptContextType::Legacy: {
-				asIScriptFunction* onPlayer = _module->GetFunctionByName("void onPlayer(jjPLAYER@)");
-
-				if (_onLevelUpdate == nullptr && onPlayer == nullptr) {
+				if (_onLevelUpdate == nullptr && _onPlayer == nullptr) {
 					_onLevelUpdateLastFrame = (int32_t)_levelHandler->_elapsedFrames;
 					return;
 				}
@@ -4008,22 +4020,18 @@ namespace Jazz2::Scripting
 							_onLevelUpdate = nullptr;
 						}
 					}
-					if (onPlayer != nullptr) {
-						for (auto player : _levelHandler->_players) {
-							ctx->Prepare(onPlayer);
-
-							void* mem = asAllocMem(sizeof(jjPLAYER));
-							jjPLAYER* playerWrapper = new(mem) jjPLAYER(this, player);
-							ctx->SetArgObject(0, playerWrapper);
+					if (_onPlayer != nullptr) {
+						for (uint32_t i = 0; i < _levelHandler->_players.size(); i++) {
+							ctx->Prepare(_onPlayer);
+							ctx->SetArgObject(0, GetPlayerWrapper(i));
 
 							int r = ctx->Execute();
 							if (r == asEXECUTION_EXCEPTION) {
 								OnException(ctx);
 								// Don't call the method again if an exception occurs
-								//_onLevelUpdate = nullptr;
+								_onPlayer = nullptr;
+								break;
 							}
-
-							playerWrapper->Release();
 						}
 					}
 					_onLevelUpdateLastFrame++;
@@ -4057,90 +4065,96 @@ namespace Jazz2::Scripting
 
 	void LevelScriptLoader::OnLevelCallback(Actors::ActorBase* initiator, uint8_t* eventParams)
 	{
-		char funcName[32];
-		formatString(funcName, sizeof(funcName), "onFunction%i", eventParams[0]);
-		asIScriptFunction* func = _module->GetFunctionByName(funcName);
-		if (func != nullptr) {
-			asIScriptContext* ctx = _engine->RequestContext();
-			ctx->Prepare(func);
-
-			jjPLAYER* playerWrapper = nullptr;
-			int paramIdx = 0;
-			int typeId = 0;
-			if (func->GetParam(paramIdx, &typeId) >= 0) {
-				if ((typeId & (asTYPEID_OBJHANDLE | asTYPEID_APPOBJECT)) == (asTYPEID_OBJHANDLE | asTYPEID_APPOBJECT)) {
-					asITypeInfo* typeInfo = _engine->GetTypeInfoById(typeId);
-					if (typeInfo->GetName() == "jjPLAYER"_s) {
-						void* mem = asAllocMem(sizeof(jjPLAYER));
-						playerWrapper = new(mem) jjPLAYER(this, _levelHandler->_players[0]);
-						ctx->SetArgObject(0, playerWrapper);
-					}
-					paramIdx++;
-				}
-			}
-			if (func->GetParam(paramIdx, &typeId) >= 0) {
-				if (typeId == asTYPEID_BOOL || typeId == asTYPEID_INT8 || typeId == asTYPEID_UINT8) {
-					ctx->SetArgByte(1, eventParams[1]);
-					paramIdx++;
-				}
-			}
-
-			int r = ctx->Execute();
-			if (r == asEXECUTION_EXCEPTION) {
-				LOGE_X("An exception \"%s\" occurred in \"%s\". Please correct the code and try again.", ctx->GetExceptionString(), ctx->GetExceptionFunction()->GetDeclaration());
-			}
+		const LevelCallback& callback = _onFunctions[eventParams[0]];
+		if (callback.Func == nullptr) {
+			LOGW_X("Callback function \"onFunction%i\" was not found in the script. Please correct the code and try again.", eventParams[0]);
+			return;
+		}
 
-			_engine->ReturnContext(ctx);
+		asIScriptContext* ctx = _engine->RequestContext();
+		ctx->Prepare(callback.Func);
 
-			if (playerWrapper != nullptr) {
-				playerWrapper->Release();
-			}
-			return;
+		if (callback.PlayerParamIdx >= 0) {
+			ctx->SetArgObject(callback.PlayerParamIdx, GetPlayerWrapper(0));
+		}
+		if (callback.ByteParamIdx >= 0) {
+			ctx->SetArgByte(callback.ByteParamIdx, eventParams[1]);
 		}
 
-		/*
-		// If known player is the initiator, try to call specific variant of the function
-		if (auto player = dynamic_cast<Actors::Player*>(initiator)) {
-			formatString(funcName, sizeof(funcName), "void onFunction%i(Player@, uint8)", eventParams[0]);
-			func = _module->GetFunctionByDecl(funcName);
-			if (func != nullptr) {
-				asIScriptContext* ctx = _engine->RequestContext();
+		int r = ctx->Execute();
+		if (r == asEXECUTION_EXCEPTION) {
+			LOGE_X("An exception \"%s\" occurred in \"%s\". Please correct the code and try again.", ctx->GetExceptionString(), ctx->GetExceptionFunction()->GetDeclaration());
+		}
 
-				void* mem = asAllocMem(sizeof(jjPLAYER));
-				jjPLAYER* playerWrapper = new(mem) jjPLAYER(this, player);
+		_engine->ReturnContext(ctx);
+	}
 
-				ctx->Prepare(func);
-				ctx->SetArgObject(0, playerWrapper);
-				ctx->SetArgByte(1, eventParams[1]);
-				int r = ctx->Execute();
-				if (r == asEXECUTION_EXCEPTION) {
-					LOGE_X("An exception \"%s\" occurred in \"%s\". Please correct the code and try again.", ctx->GetExceptionString(), ctx->GetExceptionFunction()->GetDeclaration());
-				}
+	jjPLAYER* LevelScriptLoader::GetPlayerWrapper(uint32_t playerIndex)
+	{
+		auto& players = _levelHandler->_players;
+		Actors::Player* player = (playerIndex < players.size() ? players[playerIndex] : nullptr);
 
-				_engine->ReturnContext(ctx);
+		while (_playerWrappers.size() <= playerIndex) {
+			_playerWrappers.push_back(nullptr);
+		}
 
-				playerWrapper->Release();
-				return;
-			}
+		// Wrappers are created only once and reused, scripts can also keep references to them
+		jjPLAYER*& playerWrapper = _playerWrappers[playerIndex];
+		if (playerWrapper == nullptr) {
+			void* mem = asAllocMem(sizeof(jjPLAYER));
+			playerWrapper = new(mem) jjPLAYER(this, player);
+		} else {
+			playerWrapper->SetPlayer(player);
 		}
+		return playerWrapper;
+	}
 
-		// Try to call parameter-less variant
-		formatString(funcName, sizeof(funcName), "void onFunction%i()", eventParams[0]);
-		func = _module->GetFunctionByDecl(funcName);
-		if (func != nullptr) {
-			asIScriptContext* ctx = _engine->RequestContext();
+	void LevelScriptLoader::ResolveEntryPoints()
+	{
+		// All entry points are resolved only once after the module is built
+		_onLevelLoad = _module->GetFunctionByDecl("void onLevelLoad()");
+		_onLevelBegin = _module->GetFunctionByDecl("void onLevelBegin()");
+		_onLevelReload = _module->GetFunctionByDecl("void onLevelReload()");
 
-			ctx->Prepare(func);
-			int r = ctx->Execute();
-			if (r == asEXECUTION_EXCEPTION) {
-				LOGE_X("An exception \"%s\" occurred in \"%s\". Please correct the code and try again.", ctx->GetExceptionString(), ctx->GetExceptionFunction()->GetDeclaration());
-			}
+		switch (_scriptContextType) {
+			case ScriptContextType::Legacy:
+				_onLevelUpdate = _module->GetFunctionByDecl("void onMain()");
+				_onPlayer = _module->GetFunctionByDecl("void onPlayer(jjPLAYER@)");
+				break;
+			case ScriptContextType::Standard:
+				_onLevelUpdate = _module->GetFunctionByDecl("void onLevelUpdate(float)");
+				break;
+		}
 
-			_engine->ReturnContext(ctx);
-			return;
-		}*/
+		char funcName[32];
+		for (int32_t i = 0; i < MaxLevelCallbacks; i++) {
+			LevelCallback& callback = _onFunctions[i];
+			formatString(funcName, sizeof(funcName), "onFunction%i", i);
+			callback.Func = _module->GetFunctionByName(funcName);
+			callback.PlayerParamIdx = -1;
+			callback.ByteParamIdx = -1;
+			if (callback.Func == nullptr) {
+				continue;
+			}
 
-		LOGW_X("Callback function \"%s\" was not found in the script. Please correct the code and try again.", funcName);
+			// Optional parameters are "jjPLAYER@" and "bool" or "uint8"
+			int32_t paramIdx = 0;
+			int typeId = 0;
+			if (callback.Func->GetParam(paramIdx, &typeId) >= 0) {
+				if ((typeId & (asTYPEID_OBJHANDLE | asTYPEID_APPOBJECT)) == (asTYPEID_OBJHANDLE | asTYPEID_APPOBJECT)) {
+					asITypeInfo* typeInfo = _engine->GetTypeInfoById(typeId);
+					if (typeInfo->GetName() == "jjPLAYER"_s) {
+						callback.PlayerParamIdx = paramIdx;
+					}
+					paramIdx++;
+				}
+			}
+			if (callback.Func->GetParam(paramIdx, &typeId) >= 0) {
+				if (typeId == asTYPEID_BOOL || typeId == asTYPEID_INT8 || typeId == asTYPEID_UINT8) {
+					callback.ByteParamIdx = paramIdx;
+				}
+			}
+		}
 	}
 
 	void LevelScriptLoader::RegisterBuiltInFunctions(asIScriptEngine* engine)
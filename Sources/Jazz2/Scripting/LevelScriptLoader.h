@@ -14,9 +14,15 @@ namespace Jazz2::Scripting
 		friend class jjPLAYER;
 
 	public:
+		/// Number of `onFunction` callbacks that can be called from events
+		static constexpr int32_t MaxLevelCallbacks = 256;
+
 		LevelScriptLoader(LevelHandler* levelHandler, const StringView& scriptPath);
+		~LevelScriptLoader() override;
 
 		const SmallVectorImpl<Actors::Player*>& GetPlayers() const;
+		/// Returns persistent script wrapper of the player, the reference is owned by the loader
+		jjPLAYER* GetPlayerWrapper(uint32_t playerIndex);
 
 		void OnLevelLoad();
 		void OnLevelBegin();
@@ -29,12 +35,26 @@ namespace Jazz2::Scripting
 		void OnProcessPragma(const StringView& content, ScriptContextType& contextType) override;
 
 	private:
+		/// Callback function resolved after the module is built
+		struct LevelCallback {
+			asIScriptFunction* Func;
+			int32_t PlayerParamIdx;
+			int32_t ByteParamIdx;
+		};
+
 		LevelHandler* _levelHandler;
+		asIScriptFunction* _onLevelLoad;
+		asIScriptFunction* _onLevelBegin;
+		asIScriptFunction* _onLevelReload;
 		asIScriptFunction* _onLevelUpdate;
+		asIScriptFunction* _onPlayer;
 		int32_t _onLevelUpdateLastFrame;
+		LevelCallback _onFunctions[MaxLevelCallbacks];
+		SmallVector<jjPLAYER*, 4> _playerWrappers;
 		HashMap<int, asITypeInfo*> _eventTypeToTypeInfo;
 
 		Actors::ActorBase* CreateActorInstance(const StringView& typeName);
+		void ResolveEntryPoints();
 
 		static void RegisterBuiltInFunctions(asIScriptEngine* engine);
 		void RegisterLegacyFunctions(asIScriptEngine* engine);
@@ -1,9 +1,14 @@
 ﻿#if defined(WITH_ANGELSCRIPT)
 
 #include "ScriptLoader.h"
+#include "ScriptProfiler.h"
 #include "../ContentResolver.h"
+#include "../../nCine/Base/Algorithms.h"
+#include "../../nCine/Base/HashFunctions.h"
 #include "../../nCine/IO/FileSystem.h"
 
+#include <cstring>
+
 #include <Containers/GrowableArray.h>
 
 #if defined(DEATH_TARGET_WINDOWS) && !defined(CMAKE_BUILD)
@@ -26,10 +31,36 @@
 
 namespace Jazz2::Scripting
 {
+	namespace
+	{
+		class FileBinaryStream : public asIBinaryStream
+		{
+		public:
+			FileBinaryStream(std::unique_ptr<IFileStream>& s)
+				: _s(s)
+			{
+			}
+
+			int Read(void* ptr, asUINT size) override
+			{
+				return (_s->Read(ptr, size) == size ? 0 : -1);
+			}
+
+			int Write(const void* ptr, asUINT size) override
+			{
+				return (_s->Write(ptr, size) == size ? 0 : -1);
+			}
+
+		private:
+			std::unique_ptr<IFileStream>& _s;
+		};
+	}
+
 	ScriptLoader::ScriptLoader()
 		:
 		_module(nullptr),
-		_scriptContextType(ScriptContextType::Unknown)
+		_scriptContextType(ScriptContextType::Unknown),
+		_sourceHash(0)
 	{
 		_engine = asCreateScriptEngine();
 		_engine->SetEngineProperty(asEP_PROPERTY_ACCESSOR_MODE, 2); // Required to allow chained assignment to properties
@@ -47,6 +78,13 @@ namespace Jazz2::Scripting
 
 	ScriptLoader::~ScriptLoader()
 	{
+		if (_profiler != nullptr) {
+			auto& resolver = ContentResolver::Get();
+			fs::CreateDirectories(resolver.GetCachePath());
+			_profiler->SaveReport(fs::JoinPath(resolver.GetCachePath(), "ScriptProfile.txt"_s));
+			_profiler->SaveCollapsedStacks(fs::JoinPath(resolver.GetCachePath(), "ScriptProfile.folded"_s));
+		}
+
 		for (auto ctx : _contextPool) {
 			ctx->Release();
 		}
@@ -312,9 +350,11 @@ namespace Jazz2::Scripting
 			}
 		}
 
-		// Append the actual script
+		// Append the actual script, preprocessed content is also used to identify cached bytecode
 		_engine->SetEngineProperty(asEP_COPY_SCRIPT_SECTIONS, true);
 		_module->AddScriptSection(path.data(), scriptContent.data(), scriptSize, 0);
+		_sourceHash = fasthash64(path.data(), path.size(), _sourceHash);
+		_sourceHash = fasthash64(scriptContent.data(), scriptSize, _sourceHash);
 
 		if (includes.size() > 0) {
 			// Load all included scripts
@@ -328,11 +368,26 @@ namespace Jazz2::Scripting
 		return contextType;
 	}
 
+	void ScriptLoader::EnableProfiler(bool useSampling)
+	{
+		LOGI_X("Script profiler is enabled in %s mode", useSampling ? "sampling" : "instrumented");
+		_profiler = std::make_unique<ScriptProfiler>(useSampling);
+#if !defined(NCINE_DEBUG)
+		_engine->SetEngineProperty(asEP_BUILD_WITHOUT_LINE_CUES, false);
+#endif
+	}
+
 	int ScriptLoader::Build()
 	{
-		int r = _module->Build();
-		if (r < 0) {
-			return r;
+		String cachePath = GetByteCodeCachePath();
+		if (cachePath.empty() || !LoadByteCodeFromCache(cachePath)) {
+			int r = _module->Build();
+			if (r < 0) {
+				return r;
+			}
+			if (!cachePath.empty()) {
+				SaveByteCodeToCache(cachePath);
+			}
 		}
 
 		// After the script has been built, the metadata strings should be stored for later lookup
@@ -490,6 +545,200 @@ namespace Jazz2::Scripting
 		return 0;
 	}
 
+	String ScriptLoader::GetByteCodeCachePath() const
+	{
+#if defined(DEATH_TARGET_EMSCRIPTEN)
+		return { };
+#else
+		// Sources are already preprocessed with all defined symbols, so only the engine has to be included
+		uint64_t hash = _sourceHash;
+		hash = fasthash64(NCINE_VERSION, sizeof(NCINE_VERSION) - 1, hash);
+		hash ^= GetRegisteredApiHash();
+		hash ^= ((uint64_t)ANGELSCRIPT_VERSION << 32) | ((uint64_t)ByteCodeCacheVersion << 8) | (uint64_t)_scriptContextType;
+#if defined(NCINE_DEBUG)
+		// Debug builds include line cues
+		hash = ~hash;
+#else
+		// Line cues are also included if the profiler is enabled
+		if (_profiler != nullptr) {
+			hash = ~hash;
+		}
+#endif
+
+		char filename[32];
+		formatString(filename, sizeof(filename), "%016llx.asbc", (unsigned long long)hash);
+		return fs::JoinPath({ ContentResolver::Get().GetCachePath(), "Scripts"_s, filename });
+#endif
+	}
+
+	uint64_t ScriptLoader::GetRegisteredApiHash() const
+	{
+		// Bytecode refers to registered functions, types and properties by their declarations and enum values are inlined,
+		// so any change of the registered API must invalidate cached bytecode even if the version is not increased
+		uint64_t hash = 0;
+		auto hashString = [&hash](const char* str) {
+			if (str != nullptr) {
+				hash = fasthash64(str, std::strlen(str) + 1, hash);
+			}
+		};
+		auto hashValue = [&hash](int64_t value) {
+			hash = fasthash64(&value, sizeof(value), hash);
+		};
+
+		for (asUINT i = 0; i < _engine->GetGlobalFunctionCount(); i++) {
+			hashString(_engine->GetGlobalFunctionByIndex(i)->GetDeclaration(true, true));
+		}
+		for (asUINT i = 0; i < _engine->GetGlobalPropertyCount(); i++) {
+			const char* name; const char* nameSpace; int typeId; bool isConst;
+			_engine->GetGlobalPropertyByIndex(i, &name, &nameSpace, &typeId, &isConst);
+			hashString(nameSpace);
+			hashString(name);
+			hashString(_engine->GetTypeDeclaration(typeId, true));
+			hashValue(isConst);
+		}
+		for (asUINT i = 0; i < _engine->GetObjectTypeCount(); i++) {
+			asITypeInfo* type = _engine->GetObjectTypeByIndex(i);
+			hashString(type->GetNamespace());
+			hashString(type->GetName());
+			hashValue((int64_t)type->GetFlags());
+			hashValue(type->GetSize());
+			for (asUINT j = 0; j < type->GetFactoryCount(); j++) {
+				hashString(type->GetFactoryByIndex(j)->GetDeclaration(true, true));
+			}
+			for (asUINT j = 0; j < type->GetBehaviourCount(); j++) {
+				asEBehaviours behaviour;
+				asIScriptFunction* func = type->GetBehaviourByIndex(j, &behaviour);
+				hashValue(behaviour);
+				hashString(func->GetDeclaration(true, true));
+			}
+			for (asUINT j = 0; j < type->GetMethodCount(); j++) {
+				hashString(type->GetMethodByIndex(j)->GetDeclaration(true, true));
+			}
+			for (asUINT j = 0; j < type->GetPropertyCount(); j++) {
+				hashString(type->GetPropertyDeclaration(j, true));
+			}
+		}
+		for (asUINT i = 0; i < _engine->GetEnumCount(); i++) {
+			asITypeInfo* type = _engine->GetEnumByIndex(i);
+			hashString(type->GetNamespace());
+			hashString(type->GetName());
+			for (asUINT j = 0; j < type->GetEnumValueCount(); j++) {
+				int value;
+				hashString(type->GetEnumValueByIndex(j, &value));
+				hashValue(value);
+			}
+		}
+		for (asUINT i = 0; i < _engine->GetFuncdefCount(); i++) {
+			hashString(_engine->GetFuncdefByIndex(i)->GetFuncdefSignature()->GetDeclaration(true, true));
+		}
+		for (asUINT i = 0; i < _engine->GetTypedefCount(); i++) {
+			asITypeInfo* type = _engine->GetTypedefByIndex(i);
+			hashString(type->GetNamespace());
+			hashString(type->GetName());
+			hashValue(type->GetTypedefTypeId());
+		}
+		return hash;
+	}
+
+	bool ScriptLoader::LoadByteCodeFromCache(const StringView& path)
+	{
+		auto s = fs::Open(path, FileAccessMode::Read);
+		if (s->GetSize() < 16) {
+			return false;
+		}
+
+		uint64_t signature = s->ReadValue<uint64_t>();
+		uint8_t fileType = s->ReadValue<uint8_t>();
+		uint16_t version = s->ReadValue<uint16_t>();
+		if (signature != 0x2095A59FF0BFBBEF || fileType != ContentResolver::ScriptByteCodeFile || version != ByteCodeCacheVersion) {
+			return false;
+		}
+
+		// Load into a separate module, so the module with script sections is still available if loading fails
+		asIScriptModule* cachedModule = _engine->GetModule("Main (cached)", asGM_ALWAYS_CREATE);
+		if (cachedModule == nullptr) {
+			return false;
+		}
+
+		FileBinaryStream stream(s);
+		if (cachedModule->LoadByteCode(&stream) < 0) {
+			LOGW_X("Cached bytecode \"%s\" cannot be loaded", String::nullTerminatedView(path).data());
+			cachedModule->Discard();
+			return false;
+		}
+
+		_module->Discard();
+		_module = cachedModule;
+		return true;
+	}
+
+	void ScriptLoader::SaveByteCodeToCache(const StringView& path)
+	{
+		fs::CreateDirectories(fs::GetDirectoryName(path));
+
+		// File is written under a temporary name first, so an interrupted write never leaves a truncated file in the cache
+		String tempPath = path + ".tmp"_s;
+		auto so = fs::Open(tempPath, FileAccessMode::Write);
+		if (!so->IsOpened()) {
+			return;
+		}
+
+		so->WriteValue<uint64_t>(0x2095A59FF0BFBBEF);	// Signature
+		so->WriteValue<uint8_t>(ContentResolver::ScriptByteCodeFile);
+		so->WriteValue<uint16_t>(ByteCodeCacheVersion);
+
+		FileBinaryStream stream(so);
+		if (_module->SaveByteCode(&stream, false) < 0) {
+			so->Close();
+			fs::RemoveFile(tempPath);
+			return;
+		}
+
+		so->Close();
+		if (!fs::Rename(tempPath, path)) {
+			fs::RemoveFile(tempPath);
+			return;
+		}
+		PruneByteCodeCache(fs::GetDirectoryName(path));
+	}
+
+	void ScriptLoader::PruneByteCodeCache(const StringView& directory)
+	{
+		// Every change of a script or the engine produces a file with a different name, so old files would be never removed
+		struct CachedFile {
+			String Path;
+			uint64_t LastUsed;
+		};
+
+		SmallVector<CachedFile, 0> files;
+		fs::Directory dir(directory, fs::EnumerationOptions::SkipDirectories);
+		while (true) {
+			StringView item = dir.GetNext();
+			if (item == nullptr) {
+				break;
+			}
+			if (fs::GetExtension(item) != "asbc"_s) {
+				continue;
+			}
+
+			// Access time may not be updated on every read, so the newer of both times is used
+			uint64_t lastUsed = std::max(fs::LastModificationTime(item).Ticks, fs::LastAccessTime(item).Ticks);
+			files.push_back(CachedFile { String(item), lastUsed });
+		}
+
+		if ((int32_t)files.size() <= MaxCachedByteCodeFiles) {
+			return;
+		}
+
+		std::sort(files.begin(), files.end(), [](const CachedFile& a, const CachedFile& b) {
+			return (a.LastUsed > b.LastUsed);
+		});
+		for (int32_t i = MaxCachedByteCodeFiles; i < (int32_t)files.size(); i++) {
+			fs::RemoveFile(files[i].Path);
+		}
+		LOGI_X("Removed %i unused cached scripts", (int32_t)files.size() - MaxCachedByteCodeFiles);
+	}
+
 	int ScriptLoader::ExcludeCode(String& scriptContent, int pos)
 	{
 		int scriptSize = (int)scriptContent.size();
@@ -919,23 +1168,33 @@ namespace Jazz2::Scripting
 	{
 		// Check if there is a free context available in the pool
 		auto _this = reinterpret_cast<ScriptLoader*>(param);
+		asIScriptContext* ctx;
 		if (!_this->_contextPool.empty()) {
-			return _this->_contextPool.pop_back_val();
+			ctx = _this->_contextPool.pop_back_val();
 		} else {
 			// No free context was available so we'll have to create a new one
-			return engine->CreateContext();
+			ctx = engine->CreateContext();
+		}
+
+		if (_this->_profiler != nullptr) {
+			_this->_profiler->OnContextRequested(ctx);
 		}
+		return ctx;
 	}
 
 	void ScriptLoader::ReturnContextCallback(asIScriptEngine* engine, asIScriptContext* ctx, void* param)
 	{
+		auto _this = reinterpret_cast<ScriptLoader*>(param);
+		if (_this->_profiler != nullptr) {
+			_this->_profiler->OnContextReturned(ctx);
+		}
+
 		// Unprepare the context to free any objects it may still hold (e.g. return value)
 		// This must be done before making the context available for re-use, as the clean
 		// up may trigger other script executions, e.g. if a destructor needs to call a function.
 		ctx->Unprepare();
 
 		// Place the context into the pool for when it will be needed again
-		auto _this = reinterpret_cast<ScriptLoader*>(param);
 		_this->_contextPool.push_back(ctx);
 	}
 
@@ -10,6 +10,8 @@
 #include <Containers/String.h>
 #include <Containers/StringView.h>
 
+#include <memory>
+
 using namespace Death::Containers;
 using namespace Death::Containers::Literals;
 using namespace nCine;
@@ -17,6 +19,7 @@ using namespace nCine;
 namespace Jazz2::Scripting
 {
 	class CScriptArray;
+	class ScriptProfiler;
 
 	enum class ScriptContextType {
 		Unknown,
@@ -29,6 +32,10 @@ namespace Jazz2::Scripting
 	{
 	public:
 		static constexpr asPWORD EngineToOwner = 0;
+		/// Should be increased if format of cached bytecode is changed, registered script API is already part of the cache key
+		static constexpr uint16_t ByteCodeCacheVersion = 1;
+		/// Maximum number of cached bytecode files, the least recently used ones are removed
+		static constexpr int32_t MaxCachedByteCodeFiles = 128;
 
 		ScriptLoader();
 		virtual ~ScriptLoader();
@@ -49,9 +56,13 @@ namespace Jazz2::Scripting
 		asIScriptEngine* _engine;
 		asIScriptModule* _module;
 		ScriptContextType _scriptContextType;
+		uint64_t _sourceHash;
+		std::unique_ptr<ScriptProfiler> _profiler;
 
 		ScriptContextType AddScriptFromFile(const StringView& path, const HashMap<String, bool>& definedSymbols);
 		int Build();
+		/// Attaches the profiler to all script contexts, it must be called before `Build()`, so line cues are included
+		void EnableProfiler(bool useSampling);
 
 		ArrayView<String> GetMetadataForType(int typeId);
 		ArrayView<String> GetMetadataForFunction(asIScriptFunction* func);
@@ -99,6 +110,12 @@ namespace Jazz2::Scripting
 		HashMap<int, Array<String>> _varMetadataMap;
 		HashMap<int, ClassMetadata> _classMetadataMap;
 
+		String GetByteCodeCachePath() const;
+		uint64_t GetRegisteredApiHash() const;
+		bool LoadByteCodeFromCache(const StringView& path);
+		void SaveByteCodeToCache(const StringView& path);
+		static void PruneByteCodeCache(const StringView& directory);
+
 		int ExcludeCode(String& scriptContent, int pos);
 		int SkipStatement(String& scriptContent, int pos);
 		int ExtractMetadata(MutableStringView scriptContent, int pos, SmallVectorImpl<String>& metadata);
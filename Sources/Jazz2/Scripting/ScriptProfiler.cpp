@@ -0,0 +1,358 @@
+﻿#if defined(WITH_ANGELSCRIPT)
+
+#include "ScriptProfiler.h"
+
+#include "../../nCine/Application.h"
+#include "../../nCine/Base/Algorithms.h"
+#include "../../nCine/Base/Clock.h"
+#include "../../nCine/Base/ScratchArena.h"
+#include "../../nCine/IO/FileSystem.h"
+
+#include <algorithm>
+
+namespace Jazz2::Scripting
+{
+	namespace
+	{
+		/// Returns number of characters that were actually written by `formatString()`
+		int32_t ClampLength(int32_t length, int32_t bufferSize)
+		{
+			return (bufferSize > 0 ? std::clamp(length, 0, bufferSize - 1) : 0);
+		}
+	}
+
+	ScriptProfiler::ScriptProfiler(bool useSampling)
+		: _useSampling(useSampling), _totalTicks(0)
+	{
+		_sampleIntervalTicks = (uint64_t)nCine::clock().frequency() * SampleIntervalUs / 1000000;
+
+		// Root of all call stacks
+		_stackNodes.push_back(StackNode { UINT32_MAX, nullptr, 0 });
+	}
+
+	void ScriptProfiler::OnContextRequested(asIScriptContext* ctx)
+	{
+		ctx->SetLineCallback(asMETHOD(ScriptProfiler, OnLineCallback), this, asCALL_THISCALL);
+
+		Session& session = _sessions.emplace_back();
+		session.Context = ctx;
+		session.LastTicks = nCine::clock().now();
+		session.LastLine = 0;
+		session.LineCounter = 0;
+	}
+
+	void ScriptProfiler::OnContextReturned(asIScriptContext* ctx)
+	{
+		// Sessions are usually returned in reverse order
+		for (int32_t i = (int32_t)_sessions.size() - 1; i >= 0; i--) {
+			Session& session = _sessions[i];
+			if (session.Context != ctx) {
+				continue;
+			}
+
+			if (!_useSampling) {
+				const uint64_t now = nCine::clock().now();
+				AddExclusiveTime(session, now - session.LastTicks);
+				while (!session.Frames.empty()) {
+					PopFrame(session, now);
+				}
+			}
+			_sessions.erase(&_sessions[i]);
+			break;
+		}
+	}
+
+	void ScriptProfiler::OnLineCallback(asIScriptContext* ctx)
+	{
+		Session* session = FindSession(ctx);
+		if (session == nullptr) {
+			return;
+		}
+
+		if (_useSampling) {
+			// Clock is read only once in a while, so the overhead stays low even for tight loops
+			if (++session->LineCounter < SampleCheckInterval) {
+				return;
+			}
+			session->LineCounter = 0;
+
+			const uint64_t now = nCine::clock().now();
+			if (now - session->LastTicks < _sampleIntervalTicks) {
+				return;
+			}
+			RecordSample(*session, ctx, now - session->LastTicks);
+			session->LastTicks = now;
+			return;
+		}
+
+		const uint64_t now = nCine::clock().now();
+		AddExclusiveTime(*session, now - session->LastTicks);
+		SyncFrames(*session, ctx, now);
+
+		int32_t line = ctx->GetLineNumber(0);
+		session->LastLine = line;
+		if (!session->Frames.empty()) {
+			GetLineStats(session->Frames.back().Func, line).Hits++;
+		}
+
+		// Time spent in the profiler itself is excluded from the current line
+		session->LastTicks = nCine::clock().now();
+	}
+
+	bool ScriptProfiler::SaveReport(const StringView& path)
+	{
+		auto so = fs::Open(path, FileAccessMode::Write);
+		if (!so->IsOpened()) {
+			LOGE_X("Cannot open file \"%s\" for writing", String::nullTerminatedView(path).data());
+			return false;
+		}
+
+		const double ticksToMs = 1000.0 / nCine::clock().frequency();
+
+		// Sorted lists are needed only while the report is written, so the arena is rewound right after
+		ScratchArena& arena = theApplication().scratchArena();
+		ScopedScratchMarker scratchMarker(arena);
+
+		ScratchVector<const FunctionStats*> functions(arena);
+		functions.reserve(_functions.size());
+		for (auto& pair : _functions) {
+			functions.push_back(&pair.second);
+		}
+		std::sort(functions.begin(), functions.end(), [](const FunctionStats* a, const FunctionStats* b) {
+			return (a->ExclusiveTicks > b->ExclusiveTicks);
+		});
+
+		ScratchVector<const LineStats*> lines(arena);
+		lines.reserve(_lines.size());
+		for (auto& pair : _lines) {
+			lines.push_back(&pair.second);
+		}
+		std::sort(lines.begin(), lines.end(), [](const LineStats* a, const LineStats* b) {
+			return (a->Ticks > b->Ticks);
+		});
+
+		char buffer[512];
+		char funcName[256];
+		int32_t length = ClampLength(formatString(buffer, sizeof(buffer), "Script profile (%s mode), %.3f ms in total\n\n%12s %12s %10s  %s\n",
+			_useSampling ? "sampling" : "instrumented", _totalTicks * ticksToMs, "Exclusive", "Inclusive", _useSampling ? "Samples" : "Calls", "Function"), sizeof(buffer));
+		so->Write(buffer, length);
+
+		for (const FunctionStats* stats : functions) {
+			FormatFunctionName(funcName, sizeof(funcName), stats->Func);
+			length = ClampLength(formatString(buffer, sizeof(buffer), "%9.3f ms %9.3f ms %10llu  %s\n",
+				stats->ExclusiveTicks * ticksToMs, stats->InclusiveTicks * ticksToMs, (unsigned long long)stats->Hits, funcName), sizeof(buffer));
+			so->Write(buffer, length);
+		}
+
+		length = ClampLength(formatString(buffer, sizeof(buffer), "\n%12s %10s  %s\n", "Time", _useSampling ? "Samples" : "Hits", "Line"), sizeof(buffer));
+		so->Write(buffer, length);
+
+		for (const LineStats* stats : lines) {
+			const char* sectionName = stats->Func->GetScriptSectionName();
+			FormatFunctionName(funcName, sizeof(funcName), stats->Func);
+			length = ClampLength(formatString(buffer, sizeof(buffer), "%9.3f ms %10llu  %s:%i (%s)\n",
+				stats->Ticks * ticksToMs, (unsigned long long)stats->Hits, sectionName != nullptr ? sectionName : "", stats->Line, funcName), sizeof(buffer));
+			so->Write(buffer, length);
+		}
+
+		LOGI_X("Script profile saved to \"%s\"", String::nullTerminatedView(path).data());
+		return true;
+	}
+
+	bool ScriptProfiler::SaveCollapsedStacks(const StringView& path)
+	{
+		auto so = fs::Open(path, FileAccessMode::Write);
+		if (!so->IsOpened()) {
+			LOGE_X("Cannot open file \"%s\" for writing", String::nullTerminatedView(path).data());
+			return false;
+		}
+
+		const double ticksToUs = 1000000.0 / nCine::clock().frequency();
+
+		// One line per call stack, e.g. "onMain;updatePlayer;move 1234", values are in microseconds
+		char buffer[2048];
+		SmallVector<uint32_t, 32> nodePath;
+		for (uint32_t i = 1; i < _stackNodes.size(); i++) {
+			const StackNode& node = _stackNodes[i];
+			uint64_t value = (uint64_t)(node.Ticks * ticksToUs);
+			if (value == 0) {
+				continue;
+			}
+
+			nodePath.clear();
+			for (uint32_t j = i; j != 0; j = _stackNodes[j].Parent) {
+				nodePath.push_back(j);
+			}
+
+			// The end of the buffer is reserved for the value, too deep stacks are truncated
+			constexpr int32_t MaxStackLength = (int32_t)sizeof(buffer) - 64;
+			int32_t length = 0;
+			for (int32_t j = (int32_t)nodePath.size() - 1; j >= 0; j--) {
+				// The separator and at least the null terminator must fit
+				if (MaxStackLength - length < 2) {
+					break;
+				}
+				if (j != (int32_t)nodePath.size() - 1) {
+					buffer[length++] = ';';
+				}
+				length += FormatFunctionName(buffer + length, MaxStackLength - length, _stackNodes[nodePath[j]].Func);
+			}
+			length += ClampLength(formatString(buffer + length, sizeof(buffer) - length, " %llu\n", (unsigned long long)value), (int32_t)sizeof(buffer) - length);
+			so->Write(buffer, length);
+		}
+
+		LOGI_X("Script call stacks saved to \"%s\"", String::nullTerminatedView(path).data());
+		return true;
+	}
+
+	ScriptProfiler::Session* ScriptProfiler::FindSession(asIScriptContext* ctx)
+	{
+		for (int32_t i = (int32_t)_sessions.size() - 1; i >= 0; i--) {
+			if (_sessions[i].Context == ctx) {
+				return &_sessions[i];
+			}
+		}
+		return nullptr;
+	}
+
+	void ScriptProfiler::AddExclusiveTime(Session& session, uint64_t ticks)
+	{
+		if (session.Frames.empty()) {
+			return;
+		}
+
+		const Frame& top = session.Frames.back();
+		GetFunctionStats(top.Func).ExclusiveTicks += ticks;
+		_stackNodes[top.StackNode].Ticks += ticks;
+		if (session.LastLine > 0) {
+			GetLineStats(top.Func, session.LastLine).Ticks += ticks;
+		}
+		_totalTicks += ticks;
+	}
+
+	void ScriptProfiler::SyncFrames(Session& session, asIScriptContext* ctx, uint64_t now)
+	{
+		// Frame at index i corresponds to the call stack level (depth - 1 - i)
+		const uint32_t depth = ctx->GetCallstackSize();
+		uint32_t matching = std::min((uint32_t)session.Frames.size(), depth);
+		while (matching > 0 && session.Frames[matching - 1].Func != ctx->GetFunction(depth - matching)) {
+			matching--;
+		}
+
+		while (session.Frames.size() > matching) {
+			PopFrame(session, now);
+		}
+		while (session.Frames.size() < depth) {
+			PushFrame(session, ctx->GetFunction(depth - 1 - (uint32_t)session.Frames.size()), now);
+		}
+	}
+
+	void ScriptProfiler::PushFrame(Session& session, asIScriptFunction* func, uint64_t now)
+	{
+		uint32_t parent = (session.Frames.empty() ? 0 : session.Frames.back().StackNode);
+		GetFunctionStats(func).Hits++;
+		session.Frames.push_back(Frame { func, now, GetStackNode(parent, func) });
+	}
+
+	void ScriptProfiler::PopFrame(Session& session, uint64_t now)
+	{
+		const Frame& frame = session.Frames.back();
+
+		// Recursive calls are counted only once in inclusive time
+		bool isRecursive = false;
+		for (uint32_t i = 0; i < session.Frames.size() - 1; i++) {
+			if (session.Frames[i].Func == frame.Func) {
+				isRecursive = true;
+				break;
+			}
+		}
+		if (!isRecursive) {
+			GetFunctionStats(frame.Func).InclusiveTicks += now - frame.EnterTicks;
+		}
+
+		session.Frames.pop_back();
+	}
+
+	void ScriptProfiler::RecordSample(Session& session, asIScriptContext* ctx, uint64_t ticks)
+	{
+		const uint32_t depth = ctx->GetCallstackSize();
+		if (depth == 0) {
+			return;
+		}
+
+		// Sampled call stack is kept in frames, so recursive functions can be detected in the same way
+		session.Frames.clear();
+		for (int32_t level = (int32_t)depth - 1; level >= 0; level--) {
+			asIScriptFunction* func = ctx->GetFunction(level);
+			uint32_t parent = (session.Frames.empty() ? 0 : session.Frames.back().StackNode);
+
+			bool isRecursive = false;
+			for (const Frame& frame : session.Frames) {
+				if (frame.Func == func) {
+					isRecursive = true;
+					break;
+				}
+			}
+			if (!isRecursive) {
+				GetFunctionStats(func).InclusiveTicks += ticks;
+			}
+
+			session.Frames.push_back(Frame { func, 0, GetStackNode(parent, func) });
+		}
+
+		const Frame& top = session.Frames.back();
+		FunctionStats& stats = GetFunctionStats(top.Func);
+		stats.Hits++;
+		stats.ExclusiveTicks += ticks;
+		_stackNodes[top.StackNode].Ticks += ticks;
+		_totalTicks += ticks;
+
+		LineStats& lineStats = GetLineStats(top.Func, ctx->GetLineNumber(0));
+		lineStats.Hits++;
+		lineStats.Ticks += ticks;
+	}
+
+	ScriptProfiler::FunctionStats& ScriptProfiler::GetFunctionStats(asIScriptFunction* func)
+	{
+		auto it = _functions.find(func);
+		if (it != _functions.end()) {
+			return it->second;
+		}
+		return _functions.emplace(func, FunctionStats { func, 0, 0, 0 }).first->second;
+	}
+
+	ScriptProfiler::LineStats& ScriptProfiler::GetLineStats(asIScriptFunction* func, int32_t line)
+	{
+		const uint64_t key = ((uint64_t)(uint32_t)func->GetId() << 32) | (uint32_t)line;
+		auto it = _lines.find(key);
+		if (it != _lines.end()) {
+			return it->second;
+		}
+		return _lines.emplace(key, LineStats { func, line, 0, 0 }).first->second;
+	}
+
+	uint32_t ScriptProfiler::GetStackNode(uint32_t parent, asIScriptFunction* func)
+	{
+		const uint64_t key = ((uint64_t)parent << 32) | (uint32_t)func->GetId();
+		auto it = _stackNodeLookup.find(key);
+		if (it != _stackNodeLookup.end()) {
+			return it->second;
+		}
+
+		uint32_t index = (uint32_t)_stackNodes.size();
+		_stackNodes.push_back(StackNode { parent, func, 0 });
+		_stackNodeLookup.emplace(key, index);
+		return index;
+	}
+
+	int32_t ScriptProfiler::FormatFunctionName(char* buffer, int32_t bufferSize, asIScriptFunction* func)
+	{
+		const char* objectName = func->GetObjectName();
+		int32_t length = (objectName != nullptr
+			? formatString(buffer, bufferSize, "%s::%s", objectName, func->GetName())
+			: formatString(buffer, bufferSize, "%s", func->GetName()));
+		return ClampLength(length, bufferSize);
+	}
+}
+
+#endif
@@ -0,0 +1,112 @@
+﻿#pragma once
+
+#if defined(WITH_ANGELSCRIPT)
+
+#include "FindAngelScript.h"
+
+#include "../../nCine/Base/HashMap.h"
+
+#include <Containers/SmallVector.h>
+#include <Containers/StringView.h>
+
+using namespace Death::Containers;
+using namespace nCine;
+
+namespace Jazz2::Scripting
+{
+	/// Attributes time spent in scripts to functions, lines and call stacks
+	/*! It's driven by the line callback of script contexts. In instrumented mode, every line callback is measured, so call
+		counts and exact times are available. In sampling mode, the call stack is captured only once per sample interval,
+		so the overhead stays bounded even for scripts with tight loops. */
+	class ScriptProfiler
+	{
+	public:
+		/// Number of line callbacks between two clock reads in sampling mode
+		static constexpr uint32_t SampleCheckInterval = 32;
+		/// Interval between two samples in microseconds
+		static constexpr uint32_t SampleIntervalUs = 1000;
+
+		explicit ScriptProfiler(bool useSampling);
+
+		bool IsSampling() const {
+			return _useSampling;
+		}
+
+		/// Called when a context is requested from the engine, before it's prepared
+		void OnContextRequested(asIScriptContext* ctx);
+		/// Called when a context is returned to the engine, after the execution
+		void OnContextReturned(asIScriptContext* ctx);
+		/// Called by the script engine before each executed line
+		void OnLineCallback(asIScriptContext* ctx);
+
+		/// Saves per-function and per-line statistics sorted by exclusive time
+		bool SaveReport(const StringView& path);
+		/// Saves call stacks in collapsed format that is accepted by flame graph tools
+		bool SaveCollapsedStacks(const StringView& path);
+
+	private:
+		struct FunctionStats {
+			asIScriptFunction* Func;
+			/// Number of calls in instrumented mode, number of samples at the top of the stack in sampling mode
+			uint64_t Hits;
+			uint64_t InclusiveTicks;
+			uint64_t ExclusiveTicks;
+		};
+
+		struct LineStats {
+			asIScriptFunction* Func;
+			int32_t Line;
+			uint64_t Hits;
+			uint64_t Ticks;
+		};
+
+		struct StackNode {
+			uint32_t Parent;
+			asIScriptFunction* Func;
+			uint64_t Ticks;
+		};
+
+		struct Frame {
+			asIScriptFunction* Func;
+			uint64_t EnterTicks;
+			uint32_t StackNode;
+		};
+
+		/// Execution of one context, contexts can be nested if a script calls the engine that executes another script
+		struct Session {
+			asIScriptContext* Context;
+			SmallVector<Frame, 16> Frames;
+			uint64_t LastTicks;
+			int32_t LastLine;
+			uint32_t LineCounter;
+		};
+
+		/// Deleted copy constructor
+		ScriptProfiler(const ScriptProfiler&) = delete;
+		/// Deleted assignment operator
+		ScriptProfiler& operator=(const ScriptProfiler&) = delete;
+
+		bool _useSampling;
+		uint64_t _sampleIntervalTicks;
+		uint64_t _totalTicks;
+		SmallVector<Session, 2> _sessions;
+		HashMap<asIScriptFunction*, FunctionStats> _functions;
+		HashMap<uint64_t, LineStats> _lines;
+		SmallVector<StackNode, 0> _stackNodes;
+		HashMap<uint64_t, uint32_t> _stackNodeLookup;
+
+		Session* FindSession(asIScriptContext* ctx);
+		void AddExclusiveTime(Session& session, uint64_t ticks);
+		void SyncFrames(Session& session, asIScriptContext* ctx, uint64_t now);
+		void PushFrame(Session& session, asIScriptFunction* func, uint64_t now);
+		void PopFrame(Session& session, uint64_t now);
+		void RecordSample(Session& session, asIScriptContext* ctx, uint64_t ticks);
+		FunctionStats& GetFunctionStats(asIScriptFunction* func);
+		LineStats& GetLineStats(asIScriptFunction* func, int32_t line);
+		uint32_t GetStackNode(uint32_t parent, asIScriptFunction* func);
+
+		static int32_t FormatFunctionName(char* buffer, int32_t bufferSize, asIScriptFunction* func);
+	};
+}
+
+#endif
@@ -4,14 +4,16 @@
 #include "../Actors/Environment/IceBlock.h"
 
 #include "../../nCine/Graphics/RenderQueue.h"
+#include "../../nCine/Graphics/RenderStatistics.h"
 #include "../../nCine/IO/IFileStream.h"
 #include "../../nCine/Base/Random.h"
+#include "../../nCine/Base/FrameProfiler.h"
 
 namespace Jazz2::Tiles
 {
 	TileMap::TileMap(LevelHandler* levelHandler, const StringView& tileSetPath, uint16_t captionTileId, PitType pitType, bool applyPalette)
 		: _levelHandler(levelHandler), _sprLayerIndex(-1), _pitType(pitType), _renderCommandsCount(0), _collapsingTimer(0.0f),
-			_triggerState(TriggerCount), _texturedBackgroundLayer(-1), _texturedBackgroundPass(this)
+			_triggerState(TriggerCount), _texturedBackgroundLayer(-1), _texturedBackgroundPass(this), _occlusionDepth(0)
 	{
 		auto& tileSetPart = _tileSets.emplace_back();
 		tileSetPart.Data = ContentResolver::Get().RequestTileSet(tileSetPath, captionTileId, applyPalette);
@@ -46,6 +48,8 @@ namespace Jazz2::Tiles
 
 	void TileMap::OnUpdate(float timeMult)
 	{
+		ProfilerZoneScopedN("Tile Update");
+
 		SceneNode::OnUpdate(timeMult);
 
 		// Update animated tiles
@@ -120,12 +124,21 @@ namespace Jazz2::Tiles
 
 	bool TileMap::OnDraw(RenderQueue& renderQueue)
 	{
+		ProfilerZoneScopedN("Tile Drawing");
+
 		SceneNode::OnDraw(renderQueue);
 
 		_renderCommandsCount = 0;
+		_occlusionSize = Vector2i::Zero;
 
-		for (auto& layer : _layers) {
-			DrawLayer(renderQueue, layer);
+		// Sprite layer is drawn first, so its opaque tiles can be used to cull tiles of layers behind it
+		if (_sprLayerIndex != -1) {
+			DrawLayer(renderQueue, _layers[_sprLayerIndex], true);
+		}
+		for (int i = 0; i < (int)_layers.size(); i++) {
+			if (i != _sprLayerIndex) {
+				DrawLayer(renderQueue, _layers[i], false);
+			}
 		}
 
 		DrawDebris(renderQueue);
@@ -559,7 +572,7 @@ namespace Jazz2::Tiles
 		}
 	}
 
-	void TileMap::DrawLayer(RenderQueue& renderQueue, TileMapLayer& layer)
+	void TileMap::DrawLayer(RenderQueue& renderQueue, TileMapLayer& layer, bool isOccluder)
 	{
 		if (!layer.Visible) {
 			return;
@@ -684,6 +697,23 @@ namespace Jazz2::Tiles
 			float x3 = x1 + (TileSet::DefaultTileSize * 2) + viewSize.X;
 			float y3 = y1 + (TileSet::DefaultTileSize * 2) + viewSize.Y;
 
+			// Tiles are always drawn at integer coordinates, so the occlusion grid can be aligned to the first visible tile
+			bool layerOpaque = (layer.Description.Color.W >= 1.0f);
+			bool canBeOccluded = (!isOccluder && _occlusionSize.X > 0 && layer.Description.Depth < _occlusionDepth);
+			if (isOccluder) {
+				Vector2i occlusionSize = Vector2i((int)std::ceil((x3 - x1) / TileSet::DefaultTileSize), (int)std::ceil((y3 - y1) / TileSet::DefaultTileSize));
+				const uint32_t occlusionCount = (uint32_t)(occlusionSize.X * occlusionSize.Y);
+				if (_occlusionMask.Size() != occlusionCount) {
+					_occlusionMask.SetSize(occlusionCount);
+				} else {
+					_occlusionMask.ClearAll();
+				}
+				_occlusionOrigin = Vector2i((int)std::floor(x1 + (TileSet::DefaultTileSize / 2)) - (TileSet::DefaultTileSize / 2),
+					(int)std::floor(y1 + (TileSet::DefaultTileSize / 2)) - (TileSet::DefaultTileSize / 2));
+				_occlusionSize = occlusionSize;
+				_occlusionDepth = layer.Description.Depth;
+			}
+
 			int tile_xo = -1;
 			for (float x2 = x1; x2 < x3; x2 += TileSet::DefaultTileSize) {
 				tileX = (tileX + 1) % tileCount.X;
@@ -718,7 +748,21 @@ namespace Jazz2::Tiles
 						continue;
 					}
 
-					auto command = RentRenderCommand(layer.Description.RendererType);
+					float tileCenterX = std::floor(x2 + (TileSet::DefaultTileSize / 2));
+					float tileCenterY = std::floor(y2 + (TileSet::DefaultTileSize / 2));
+
+					if (isOccluder) {
+						if (layerOpaque && tile.Alpha == 255 && tileSet->IsTileOpaque(tileId)) {
+							_occlusionMask.Set(tile_xo + tile_yo * _occlusionSize.X);
+						}
+					} else if (canBeOccluded && IsTileOccluded((int)tileCenterX - (TileSet::DefaultTileSize / 2), (int)tileCenterY - (TileSet::DefaultTileSize / 2))) {
+#if defined(NCINE_PROFILING)
+						RenderStatistics::addCulledTile();
+#endif
+						continue;
+					}
+
+					auto command = RentRenderCommand(layer.Description.RendererType, true);
 					command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 					Vector2i texSize = tileSet->TextureDiffuse->size();
@@ -744,17 +788,17 @@ namespace Jazz2::Tiles
 						texBiasY -= 0.5f / float(texSize.Y);
 					}
 
-					auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-					instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(texScaleX, texBiasX, texScaleY, texBiasY);
-					instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(TileSet::DefaultTileSize, TileSet::DefaultTileSize);
+					command->material().setInstanceTexRect(texScaleX, texBiasX, texScaleY, texBiasY);
+					command->material().setInstanceSpriteSize(TileSet::DefaultTileSize, TileSet::DefaultTileSize);
 
 					Vector4f color = layer.Description.Color;
 					color.W *= tile.Alpha / 255.0f;
-					instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(color.Data());
+					command->material().setInstanceColor(color.Data());
 
-					command->setTransformation(Matrix4x4f::Translation(std::floor(x2 + (TileSet::DefaultTileSize / 2)), std::floor(y2 + (TileSet::DefaultTileSize / 2)), 0.0f));
+					command->setTransformation(Matrix4x4f::Translation(tileCenterX, tileCenterY, 0.0f));
 					command->setLayer(layer.Description.Depth);
-					command->material().setTexture(*tileSet->TextureDiffuse);
+					command->material().setTexture(0, *tileSet->TextureDiffuse);
+					command->material().setTexture(1, *tileSet->TexturePalette);
 
 					renderQueue.addCommand(command);
 				}
@@ -762,6 +806,31 @@ namespace Jazz2::Tiles
 		}
 	}
 
+	bool TileMap::IsTileOccluded(int x, int y) const
+	{
+		// Tile can overlap up to 4 cells of the occlusion grid, all of them have to be opaque
+		int x1 = x - _occlusionOrigin.X;
+		int y1 = y - _occlusionOrigin.Y;
+		int x2 = x1 + TileSet::DefaultTileSize - 1;
+		int y2 = y1 + TileSet::DefaultTileSize - 1;
+		if (x1 < 0 || y1 < 0 || x2 >= _occlusionSize.X * TileSet::DefaultTileSize || y2 >= _occlusionSize.Y * TileSet::DefaultTileSize) {
+			return false;
+		}
+
+		x1 /= TileSet::DefaultTileSize;
+		y1 /= TileSet::DefaultTileSize;
+		x2 /= TileSet::DefaultTileSize;
+		y2 /= TileSet::DefaultTileSize;
+		for (int ty = y1; ty <= y2; ty++) {
+			for (int tx = x1; tx <= x2; tx++) {
+				if (!_occlusionMask[tx + ty * _occlusionSize.X]) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
 	float TileMap::TranslateCoordinate(float coordinate, float speed, float offset, int viewSize, bool isY)
 	{
 		// Coordinate: the "vanilla" coordinate of the tile on the layer if the layer was fixed to the sprite layer with same
@@ -776,7 +845,7 @@ namespace Jazz2::Tiles
 		return (coordinate * speed + offset + alignment * (speed - 1.0f));
 	}
 
-	RenderCommand* TileMap::RentRenderCommand(LayerRendererType type)
+	RenderCommand* TileMap::RentRenderCommand(LayerRendererType type, bool isIndexed)
 	{
 		RenderCommand* command;
 		if (_renderCommandsCount < _renderCommands.size()) {
@@ -788,9 +857,18 @@ namespace Jazz2::Tiles
 		}
 
 		bool shaderChanged;
-		switch (type) {
-			case LayerRendererType::Tinted: shaderChanged = command->material().setShader(ContentResolver::Get().GetShader(PrecompiledShader::Tinted)); break;
-			default: shaderChanged = command->material().setShaderProgramType(Material::ShaderProgramType::SPRITE); break;
+		if (isIndexed) {
+			switch (type) {
+				case LayerRendererType::Tinted: shaderChanged = command->material().setShader(ContentResolver::Get().GetShader(PrecompiledShader::TintedPalette)); break;
+				default: shaderChanged = command->material().setShader(ContentResolver::Get().GetShader(PrecompiledShader::Palette)); break;
+			}
+		} else {
+			switch (type) {
+				case LayerRendererType::Tinted: shaderChanged = command->material().setShader(ContentResolver::Get().GetShader(PrecompiledShader::Tinted)); break;
+				default: shaderChanged = command->material().setShaderProgramType(Material::ShaderProgramType::SPRITE); break;
+			}
+			// Commands are reused, so the palette of the previous tile set must not affect batching
+			command->material().setTexture(1, nullptr);
 		}
 		if (shaderChanged) {
 			command->material().reserveUniformsDataMemory();
@@ -800,6 +878,10 @@ namespace Jazz2::Tiles
 			if (textureUniform && textureUniform->intValue(0) != 0) {
 				textureUniform->setIntValue(0); // GL_TEXTURE0
 			}
+			GLUniformCache* paletteUniform = command->material().uniform(TileSet::PaletteUniformName);
+			if (paletteUniform && paletteUniform->intValue(0) != 1) {
+				paletteUniform->setIntValue(1); // GL_TEXTURE1
+			}
 		}
 
 		return command;
@@ -1078,6 +1160,7 @@ namespace Jazz2::Tiles
 			debris.TexBiasY = texBiasY + ((i / 2) * QuarterSize / float(texSize.Y));
 
 			debris.DiffuseTexture = tileSet->TextureDiffuse.get();
+			debris.PaletteTexture = tileSet->TexturePalette.get();
 			debris.Flags = DebrisFlags::None;
 		}
 	}
@@ -1089,6 +1172,7 @@ namespace Jazz2::Tiles
 		float x = pos.X - res->Base->Hotspot.X;
 		float y = pos.Y - res->Base->Hotspot.Y;
 		Vector2i texSize = res->Base->TextureDiffuse->size();
+		Recti frameRect = res->Base->GetFrameRect(currentFrame);
 
 		for (int fy = 0; fy < res->Base->FrameDimensions.Y; fy += DebrisSize + 1) {
 			for (int fx = 0; fx < res->Base->FrameDimensions.X; fx += DebrisSize + 1) {
@@ -1113,9 +1197,9 @@ namespace Jazz2::Tiles
 				debris.Time = 320.0f;
 
 				debris.TexScaleX = (currentSize / float(texSize.X));
-				debris.TexBiasX = (((float)(currentFrame % res->Base->FrameConfiguration.X) / res->Base->FrameConfiguration.X) + ((float)fx / float(texSize.X)));
+				debris.TexBiasX = (float(frameRect.X + fx) / float(texSize.X));
 				debris.TexScaleY = (currentSize / float(texSize.Y));
-				debris.TexBiasY = (((float)(currentFrame / res->Base->FrameConfiguration.X) / res->Base->FrameConfiguration.Y) + ((float)fy / float(texSize.Y)));
+				debris.TexBiasY = (float(frameRect.Y + fy) / float(texSize.Y));
 
 				debris.DiffuseTexture = res->Base->TextureDiffuse.get();
 				debris.Flags = DebrisFlags::Bounce;
@@ -1153,9 +1237,9 @@ namespace Jazz2::Tiles
 			int col = curAnimFrame % res->Base->FrameConfiguration.X;
 			int row = curAnimFrame / res->Base->FrameConfiguration.X;
 			debris.TexScaleX = (float(res->Base->FrameDimensions.X) / float(texSize.X));
-			debris.TexBiasX = (float(res->Base->FrameDimensions.X * col) / float(texSize.X));
+			debris.TexBiasX = (float(res->Base->TextureOffset.X + res->Base->FrameDimensions.X * col) / float(texSize.X));
 			debris.TexScaleY = (float(res->Base->FrameDimensions.Y) / float(texSize.Y));
-			debris.TexBiasY = (float(res->Base->FrameDimensions.Y * row) / float(texSize.Y));
+			debris.TexBiasY = (float(res->Base->TextureOffset.Y + res->Base->FrameDimensions.Y * row) / float(texSize.Y));
 
 			debris.DiffuseTexture = res->Base->TextureDiffuse.get();
 			debris.Flags = DebrisFlags::Bounce;
@@ -1241,7 +1325,7 @@ namespace Jazz2::Tiles
 	void TileMap::DrawDebris(RenderQueue& renderQueue)
 	{
 		for (auto& debris : _debrisList) {
-			auto command = RentRenderCommand(LayerRendererType::Default);
+			auto command = RentRenderCommand(LayerRendererType::Default, debris.PaletteTexture != nullptr);
 
 			if ((debris.Flags & DebrisFlags::AdditiveBlending) == DebrisFlags::AdditiveBlending) {
 				command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE);
@@ -1249,17 +1333,19 @@ namespace Jazz2::Tiles
 				command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 			}
 
-			auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-			instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(debris.TexScaleX, debris.TexBiasX, debris.TexScaleY, debris.TexBiasY);
-			instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(debris.Size.X, debris.Size.Y);
-			instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf(1.0f, 1.0f, 1.0f, debris.Alpha).Data());
+			command->material().setInstanceTexRect(debris.TexScaleX, debris.TexBiasX, debris.TexScaleY, debris.TexBiasY);
+			command->material().setInstanceSpriteSize(debris.Size.X, debris.Size.Y);
+			command->material().setInstanceColor(Colorf(1.0f, 1.0f, 1.0f, debris.Alpha).Data());
 
 			Matrix4x4f worldMatrix = Matrix4x4f::Translation(debris.Pos.X, debris.Pos.Y, 0.0f);
 			worldMatrix.RotateZ(debris.Angle);
 			worldMatrix.Scale(debris.Scale, debris.Scale, 1.0f);
 			command->setTransformation(worldMatrix);
 			command->setLayer(debris.Depth);
-			command->material().setTexture(*debris.DiffuseTexture);
+			command->material().setTexture(0, *debris.DiffuseTexture);
+			if (debris.PaletteTexture != nullptr) {
+				command->material().setTexture(1, *debris.PaletteTexture);
+			}
 
 			renderQueue.addCommand(command);
 		}
@@ -1304,10 +1390,9 @@ namespace Jazz2::Tiles
 
 		auto command = &_texturedBackgroundPass._outputRenderCommand;
 
-		auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-		instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(1.0f, 0.0f, 1.0f, 0.0f);
-		instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(viewSize.X, viewSize.Y);
-		instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf(1.0f, 1.0f, 1.0f, 1.0f).Data());
+		command->material().setInstanceTexRect(1.0f, 0.0f, 1.0f, 0.0f);
+		command->material().setInstanceSpriteSize(viewSize.X, viewSize.Y);
+		command->material().setInstanceColor(Colorf(1.0f, 1.0f, 1.0f, 1.0f).Data());
 
 		command->material().uniform("uViewSize")->setFloatValue(viewSize.X, viewSize.Y);
 		command->material().uniform("uCameraPos")->setFloatVector(viewCenter.Data());
@@ -1367,7 +1452,7 @@ namespace Jazz2::Tiles
 			_renderCommands.reserve(renderCommandCount);
 			for (int i = 0; i < renderCommandCount; i++) {
 				std::unique_ptr<RenderCommand>& command = _renderCommands.emplace_back(std::make_unique<RenderCommand>());
-				command->material().setShaderProgramType(Material::ShaderProgramType::SPRITE);
+				command->material().setShader(ContentResolver::Get().GetShader(PrecompiledShader::Palette));
 				command->material().reserveUniformsDataMemory();
 				command->geometry().setDrawParameters(GL_TRIANGLE_STRIP, 0, 4);
 
@@ -1375,6 +1460,10 @@ namespace Jazz2::Tiles
 				if (textureUniform && textureUniform->intValue(0) != 0) {
 					textureUniform->setIntValue(0); // GL_TEXTURE0
 				}
+				GLUniformCache* paletteUniform = command->material().uniform(TileSet::PaletteUniformName);
+				if (paletteUniform && paletteUniform->intValue(0) != 1) {
+					paletteUniform->setIntValue(1); // GL_TEXTURE1
+				}
 			}
 
 			// Prepare output render command
@@ -1440,13 +1529,13 @@ namespace Jazz2::Tiles
 					texBiasY -= 0.5f / float(texSize.Y);
 				}
 
-				auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-				instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(texScaleX, texBiasX, texScaleY, texBiasY);
-				instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(TileSet::DefaultTileSize, TileSet::DefaultTileSize);
-				instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf::White.Data());
+				command->material().setInstanceTexRect(texScaleX, texBiasX, texScaleY, texBiasY);
+				command->material().setInstanceSpriteSize(TileSet::DefaultTileSize, TileSet::DefaultTileSize);
+				command->material().setInstanceColor(Colorf::White.Data());
 
 				command->setTransformation(Matrix4x4f::Translation(x * TileSet::DefaultTileSize + (TileSet::DefaultTileSize / 2), y * TileSet::DefaultTileSize + (TileSet::DefaultTileSize / 2), 0.0f));
-				command->material().setTexture(*tileSet->TextureDiffuse);
+				command->material().setTexture(0, *tileSet->TextureDiffuse);
+				command->material().setTexture(1, *tileSet->TexturePalette);
 
 				renderQueue.addCommand(command);
 			}
@@ -136,6 +136,8 @@ namespace Jazz2::Tiles
 			float TexBiasY;
 
 			Texture* DiffuseTexture;
+			// Palette of indexed tile set textures, `nullptr` if `DiffuseTexture` contains colors
+			Texture* PaletteTexture;
 
 			DebrisFlags Flags;
 		};
@@ -229,9 +231,16 @@ namespace Jazz2::Tiles
 		int _texturedBackgroundLayer;
 		TexturedBackgroundPass _texturedBackgroundPass;
 
-		void DrawLayer(RenderQueue& renderQueue, TileMapLayer& layer);
+		// Opaque tiles of the sprite layer drawn in the current frame, used to cull hidden tiles of layers behind it
+		BitArray _occlusionMask;
+		Vector2i _occlusionOrigin;
+		Vector2i _occlusionSize;
+		uint16_t _occlusionDepth;
+
+		void DrawLayer(RenderQueue& renderQueue, TileMapLayer& layer, bool isOccluder);
+		bool IsTileOccluded(int x, int y) const;
 		static float TranslateCoordinate(float coordinate, float speed, float offset, int viewSize, bool isY);
-		RenderCommand* RentRenderCommand(LayerRendererType type);
+		RenderCommand* RentRenderCommand(LayerRendererType type, bool isIndexed);
 
 		bool AdvanceDestructibleTileAnimation(LayerTile& tile, int tx, int ty, int& amount, const StringView& soundName);
 		void AdvanceCollapsingTileTimers(float timeMult);
@@ -2,9 +2,9 @@
 
 namespace Jazz2::Tiles
 {
-	TileSet::TileSet(std::unique_ptr<Texture> textureDiffuse, std::unique_ptr<uint8_t[]> mask, uint32_t maskSize, std::unique_ptr<Color[]> captionTile)
-		: TextureDiffuse(std::move(textureDiffuse)), _mask(std::move(mask)), _captionTile(std::move(captionTile)),
-			_isMaskEmpty(), _isMaskFilled(), _isTileFilled()
+	TileSet::TileSet(std::unique_ptr<Texture> textureDiffuse, std::unique_ptr<Texture> texturePalette, std::unique_ptr<uint8_t[]> mask, uint32_t maskSize, std::unique_ptr<Color[]> captionTile, const uint32_t* pixels)
+		: TextureDiffuse(std::move(textureDiffuse)), TexturePalette(std::move(texturePalette)), _mask(std::move(mask)), _captionTile(std::move(captionTile)),
+			_isMaskEmpty(), _isMaskFilled(), _isTileFilled(), _isTileOpaque()
 	{
 		Vector2i texSize = TextureDiffuse->size();
 		int tw = (texSize.X / DefaultTileSize);
@@ -15,6 +15,7 @@ namespace Jazz2::Tiles
 		_isMaskEmpty.SetSize(TileCount);
 		_isMaskFilled.SetSize(TileCount);
 		_isTileFilled.SetSize(TileCount);
+		_isTileOpaque.SetSize(TileCount);
 
 		//_defaultLayerTiles.reserve(_tileCount);
 		uint32_t maskMaxTiles = maskSize / (DefaultTileSize * DefaultTileSize);
@@ -29,16 +30,13 @@ namespace Jazz2::Tiles
 
 				//auto pixelOffset = &pixels[(i * Tiles::TileSet::DefaultTileSize * w) + (j * Tiles::TileSet::DefaultTileSize)];
 				if (k < maskMaxTiles) {
-					auto maskOffset = &_mask[k * DefaultTileSize * DefaultTileSize];
-					for (int x = 0; x < DefaultTileSize * DefaultTileSize; x++) {
-						bool masked = (maskOffset[x] > 0);
-						maskEmpty &= !masked;
-						maskFilled &= masked;
+					MaskFlags maskFlags = CpuDispatch::ClassifyMask(&_mask[k * DefaultTileSize * DefaultTileSize], DefaultTileSize * DefaultTileSize);
+					maskEmpty = (maskFlags & MaskFlags::Empty) == MaskFlags::Empty;
+					maskFilled = (maskFlags & MaskFlags::Filled) == MaskFlags::Filled;
 
-						//ColorRgba pxTex = texture[j * DefaultTileSize + x, i * DefaultTileSize + y];
-						//masked = (pxTex.A > 20);
-						//tileFilled &= masked;
-					}
+					//ColorRgba pxTex = texture[j * DefaultTileSize + x, i * DefaultTileSize + y];
+					//masked = (pxTex.A > 20);
+					//tileFilled &= masked;
 				}
 
 				int idx = (j + tw * i);
@@ -60,6 +58,11 @@ namespace Jazz2::Tiles
 					MaterialAlpha = 255
 				});*/
 
+				// Fully opaque tiles are used to cull tiles of other layers hidden behind them
+				if (AreAllPixelsOpaque(&pixels[(i * DefaultTileSize * texSize.X) + (j * DefaultTileSize)], texSize.X)) {
+					_isTileOpaque.Set(idx);
+				}
+
 				k++;
 			}
 		}
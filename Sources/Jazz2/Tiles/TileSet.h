@@ -2,6 +2,7 @@
 
 #include "../ILevelHandler.h"
 #include "../../nCine/Base/BitArray.h"
+#include "../../nCine/Base/CpuDispatch.h"
 
 namespace Jazz2::Tiles
 {
@@ -9,10 +10,15 @@ namespace Jazz2::Tiles
 	{
 	public:
 		static constexpr int DefaultTileSize = 32;
+		/// Name of the sampler uniform that `PrecompiledShader::Palette` variants read the palette from, it's bound to texture unit 1
+		static constexpr char PaletteUniformName[] = "uTexturePalette";
 
-		TileSet(std::unique_ptr<Texture> textureDiffuse, std::unique_ptr<uint8_t[]> mask, uint32_t maskSize, std::unique_ptr<Color[]> captionTile);
+		TileSet(std::unique_ptr<Texture> textureDiffuse, std::unique_ptr<Texture> texturePalette, std::unique_ptr<uint8_t[]> mask, uint32_t maskSize, std::unique_ptr<Color[]> captionTile, const uint32_t* pixels);
 
+		/// Palette indices in red channel and alpha in green channel, it has to be drawn with `PrecompiledShader::Palette` variants
 		std::unique_ptr<Texture> TextureDiffuse;
+		/// Palette of the tile set with remapping already applied (256x1)
+		std::unique_ptr<Texture> TexturePalette;
 		int TileCount;
 		int TilesPerRow;
 
@@ -52,16 +58,38 @@ namespace Jazz2::Tiles
 			return _isTileFilled[tileId];
 		}
 
+		/// Returns `true` if all pixels of the tile are fully opaque, so it completely hides anything drawn behind it
+		bool IsTileOpaque(int tileId) const
+		{
+			if (tileId >= TileCount) {
+				return false;
+			}
+
+			return _isTileOpaque[tileId];
+		}
+
 		Color* GetCaptionTile() const
 		{
 			return _captionTile.get();
 		}
 
+		/// Returns `true` if all pixels of the tile are fully opaque, `stride` is width of the whole tile set in pixels
+		static bool AreAllPixelsOpaque(const uint32_t* tilePixels, int stride)
+		{
+			for (int y = 0; y < DefaultTileSize; y++) {
+				if (!CpuDispatch::IsOpaque(&tilePixels[y * stride], DefaultTileSize)) {
+					return false;
+				}
+			}
+			return true;
+		}
+
 	private:
 		std::unique_ptr<uint8_t[]> _mask;
 		std::unique_ptr<Color[]> _captionTile;
 		BitArray _isMaskEmpty;
 		BitArray _isMaskFilled;
 		BitArray _isTileFilled;
+		BitArray _isTileOpaque;
 	};
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 ﻿#include "Canvas.h"
 
+#include "../../nCine/Application.h"
+#include "../../nCine/Base/ScratchArena.h"
 #include "../../nCine/Graphics/RenderQueue.h"
 #include "../../nCine/IO/IFileStream.h"
 #include "../../nCine/Base/Random.h"
@@ -7,7 +9,7 @@
 namespace Jazz2::UI
 {
 	Canvas::Canvas()
-		: AnimTime(0.0f), _renderCommandsCount(0), _currentRenderQueue(nullptr)
+		: AnimTime(0.0f), _renderCommandsCount(0), _meshRenderCommandsCount(0), _currentRenderQueue(nullptr)
 	{
 		setVisitOrderState(SceneNode::VisitOrderState::Disabled);
 	}
@@ -24,6 +26,7 @@ namespace Jazz2::UI
 		SceneNode::OnDraw(renderQueue);
 
 		_renderCommandsCount = 0;
+		_meshRenderCommandsCount = 0;
 		_currentRenderQueue = &renderQueue;
 
 		return false;
@@ -55,10 +58,9 @@ namespace Jazz2::UI
 			command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 		}
 
-		auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-		instanceBlock->uniform(Material::TexRectUniformName)->setFloatVector(texCoords.Data());
-		instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatVector(size.Data());
-		instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(color.Data());
+		command->material().setInstanceTexRect(texCoords.X, texCoords.Y, texCoords.Z, texCoords.W);
+		command->material().setInstanceSpriteSize(size.X, size.Y);
+		command->material().setInstanceColor(color.Data());
 
 		command->setTransformation(Matrix4x4f::Translation(pos.X, pos.Y, 0.0f).RotateZ(angle));
 		command->setLayer(z);
@@ -83,9 +85,8 @@ namespace Jazz2::UI
 			command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 		}
 
-		auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-		instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatVector(size.Data());
-		instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(color.Data());
+		command->material().setInstanceSpriteSize(size.X, size.Y);
+		command->material().setInstanceColor(color.Data());
 
 		command->setTransformation(Matrix4x4f::Translation(pos.X, pos.Y, 0.0f));
 		command->setLayer(z);
@@ -122,4 +123,22 @@ namespace Jazz2::UI
 			return command.get();
 		}
 	}
+
+	RenderCommand* Canvas::RentMeshRenderCommand(int32_t floatCount, float*& vertices)
+	{
+		RenderCommand* command;
+		if (_meshRenderCommandsCount < (int32_t)_meshRenderCommands.size()) {
+			command = _meshRenderCommands[_meshRenderCommandsCount].get();
+		} else {
+			command = _meshRenderCommands.emplace_back(std::make_unique<RenderCommand>()).get();
+			command->material().setBlendingEnabled(true);
+		}
+		_meshRenderCommandsCount++;
+
+		// Vertices are copied to VBO only when the render queue is drawn later in the same frame,
+		// so they can live in the scratch arena, but the memory can't be shared between commands
+		vertices = theApplication().scratchArena().allocateArray<float>(floatCount);
+		command->geometry().setHostVertexPointer(vertices);
+		return command;
+	}
 }
\ No newline at end of file
@@ -26,11 +26,15 @@ namespace Jazz2::UI
 		static Vector2f ApplyAlignment(Alignment align, const Vector2f& vec, const Vector2f& size);
 
 		RenderCommand* RentRenderCommand();
+		/// Rents a render command with host memory for specified number of floats, the memory stays valid until the end of the frame
+		RenderCommand* RentMeshRenderCommand(int32_t floatCount, float*& vertices);
 		void DrawRenderCommand(RenderCommand* command);
 
 	private:
 		SmallVector<std::unique_ptr<RenderCommand>, 0> _renderCommands;
 		int32_t _renderCommandsCount;
+		SmallVector<std::unique_ptr<RenderCommand>, 0> _meshRenderCommands;
+		int32_t _meshRenderCommandsCount;
 		RenderQueue* _currentRenderQueue;
 	};
 }
\ No newline at end of file
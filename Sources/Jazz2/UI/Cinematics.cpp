@@ -14,8 +14,12 @@
 namespace Jazz2::UI
 {
 	Cinematics::Cinematics(IRootController* root, const String& path, const std::function<bool(IRootController*, bool)>& callback)
-		: _root(root), _callback(callback), _frameDelay(0.0f), _frameProgress(0.0f), _framesLeft(0),
-			_currentOffsets { }, _pressedKeys((uint32_t)KeySym::COUNT), _pressedActions(0)
+		: _root(root), _callback(callback), _frameDelay(0.0f), _frameProgress(0.0f), _framesLeft(0), _framesToDecode(0),
+			_frameQueueHead(0), _frameQueueCount(0), _decoderFinished(false),
+#if defined(WITH_THREADS)
+			_decoderShouldExit(false), _isDecoderRunning(false),
+#endif
+			_pressedKeys((uint32_t)KeySym::COUNT), _pressedActions(0)
 	{
 		theApplication().gfxDevice().setWindowTitle("Jazz² Resurrection"_s);
 
@@ -44,6 +48,16 @@ namespace Jazz2::UI
 
 	Cinematics::~Cinematics()
 	{
+#if defined(WITH_THREADS)
+		if (_isDecoderRunning) {
+			_frameQueueMutex.Lock();
+			_decoderShouldExit = true;
+			_frameQueueCV.Broadcast();
+			_frameQueueMutex.Unlock();
+			_decoderThread.Join();
+		}
+#endif
+
 		_canvas->setParent(nullptr);
 	}
 
@@ -155,48 +169,95 @@ namespace Jazz2::UI
 		_texture = std::make_unique<Texture>("Cinematics", Texture::Format::RGBA8, _width, _height);
 		_buffer = std::make_unique<uint8_t[]>(_width * _height);
 		_lastBuffer = std::make_unique<uint8_t[]>(_width * _height);
-		_currentFrame = std::make_unique<uint32_t[]>(_width * _height);
 
-		// Read all 4 compressed streams
-		SmallVector<uint8_t, 0> compressedStreams[countof(_decompressedStreams)];
-		uint32_t currentOffsets[countof(_decompressedStreams)] { };
+		// Read all 4 compressed streams, they are decompressed incrementally during playback
 		uint32_t totalOffset = s->GetPosition();
 
 		while (totalOffset < s->GetSize()) {
-			for (int32_t i = 0; i < countof(_decompressedStreams); i++) {
+			for (int32_t i = 0; i < countof(_streams); i++) {
+				auto& compressedData = _streams[i].CompressedData;
 				uint32_t bytesLeft = s->ReadValue<uint32_t>();
 				totalOffset += 4 + bytesLeft;
 
-				compressedStreams[i].resize_for_overwrite(currentOffsets[i] + bytesLeft);
+				uint32_t currentOffset = (uint32_t)compressedData.size();
+				compressedData.resize_for_overwrite(currentOffset + bytesLeft);
 
 				while (bytesLeft > 0) {
-					uint32_t bytesRead = s->Read(&compressedStreams[i][currentOffsets[i]], bytesLeft);
-					currentOffsets[i] += bytesRead;
+					uint32_t bytesRead = s->Read(&compressedData[currentOffset], bytesLeft);
+					if (bytesRead == 0) {
+						return false;
+					}
+					currentOffset += bytesRead;
 					bytesLeft -= bytesRead;
 				}
 			}
 		}
 
-		for (int32_t i = 0; i < countof(_decompressedStreams); i++) {
-			// Stream 3 contains pixel data and is probably compressed with higher ratio
-			_decompressedStreams[i].resize_for_overwrite(currentOffsets[i] * (i == 3 ? 8 : 3));
-
-		Retry:
-			int32_t compressedSize = currentOffsets[i] - 2;
-			int32_t decompressedSize = _decompressedStreams[i].size();
-			auto result = CompressionUtils::Inflate(compressedStreams[i].begin() + 2, compressedSize, _decompressedStreams[i].begin(), decompressedSize);
-			if (result == DecompressionResult::BufferTooSmall) {
-				_decompressedStreams[i].resize_for_overwrite(_decompressedStreams[i].size() * 2);
-				LOGI_X("Cinematics stream %i was larger than expected, resizing buffer to %i", i, _decompressedStreams[i].size());
-				goto Retry;
+		for (int32_t i = 0; i < countof(_streams); i++) {
+			auto& stream = _streams[i];
+			if (stream.CompressedData.size() < 2 || !stream.Inflater.Open(stream.CompressedData.data() + 2, (int32_t)stream.CompressedData.size() - 2)) {
+				return false;
 			}
+			stream.Buffer = std::make_unique<uint8_t[]>(StreamBufferSize);
+			stream.Offset = 0;
+			stream.Length = 0;
+		}
+
+		for (int32_t i = 0; i < FrameQueueSize; i++) {
+			_frameQueue[i] = std::make_unique<uint32_t[]>(_width * _height);
 		}
+		_framesToDecode = _framesLeft;
+
+#if defined(WITH_THREADS)
+		// Decode a few frames ahead on the background thread, so only texture upload is done on the main thread
+		_isDecoderRunning = true;
+		_decoderThread.Run(Cinematics::OnDecoderThread, this);
+#endif
 
 		return true;
 	}
 
 	void Cinematics::PrepareNextFrame()
 	{
+#if defined(WITH_THREADS)
+		_frameQueueMutex.Lock();
+		while (_frameQueueCount == 0 && !_decoderFinished) {
+			_frameQueueCV.Wait(_frameQueueMutex);
+		}
+		if (_frameQueueCount == 0) {
+			_frameQueueMutex.Unlock();
+			_framesLeft = 0;
+			return;
+		}
+		int32_t index = _frameQueueHead;
+		_frameQueueMutex.Unlock();
+
+		// Upload new texture to GPU, the slot is not touched by the decoder until it's released
+		_texture->loadFromTexels((unsigned char*)_frameQueue[index].get(), 0, 0, _width, _height);
+
+		_frameQueueMutex.Lock();
+		_frameQueueHead = (_frameQueueHead + 1) % FrameQueueSize;
+		_frameQueueCount--;
+		_frameQueueCV.Broadcast();
+		_frameQueueMutex.Unlock();
+#else
+		if (!DecodeNextFrame(_frameQueue[0].get())) {
+			_framesLeft = 0;
+			return;
+		}
+
+		// Upload new texture to GPU
+		_texture->loadFromTexels((unsigned char*)_frameQueue[0].get(), 0, 0, _width, _height);
+#endif
+	}
+
+	bool Cinematics::DecodeNextFrame(uint32_t* target)
+	{
+		if (_framesToDecode <= 0) {
+			return false;
+		}
+		_framesToDecode--;
+
 		// Check if palette was changed
 		if (ReadValue<uint8_t>(0) == 0x01) {
 			Read(3, _palette, sizeof(_palette));
@@ -216,10 +277,8 @@ namespace Jazz2::UI
 					}
 
 					// Read specified number of pixels in row
-					for (int32_t i = 0; i < u; i++) {
-						_buffer[y * _width + x] = ReadValue<uint8_t>(3);
-						x++;
-					}
+					Read(3, &_buffer[y * _width + x], u);
+					x += u;
 				} else {
 					int32_t u;
 					if (c == 0x81) {
@@ -240,15 +299,82 @@ namespace Jazz2::UI
 		}
 
 		// Apply current palette to indices
-		for (int32_t i = 0; i < _width * _height; i++) {
-			_currentFrame[i] = _palette[_buffer[i]];
+		const uint8_t* src = _buffer.get();
+		int32_t size = _width * _height;
+		int32_t i = 0;
+		for (; i + 4 <= size; i += 4) {
+			target[i] = _palette[src[i]];
+			target[i + 1] = _palette[src[i + 1]];
+			target[i + 2] = _palette[src[i + 2]];
+			target[i + 3] = _palette[src[i + 3]];
+		}
+		for (; i < size; i++) {
+			target[i] = _palette[src[i]];
 		}
-
-		// Upload new texture to GPU
-		_texture->loadFromTexels((unsigned char*)_currentFrame.get(), 0, 0, _width, _height);
 
 		// Create copy of the buffer
 		memcpy(_lastBuffer.get(), _buffer.get(), _width * _height);
+		return true;
+	}
+
+#if defined(WITH_THREADS)
+	void Cinematics::OnDecoderThread(void* arg)
+	{
+#	if !defined(DEATH_TARGET_EMSCRIPTEN)
+		Thread::SetSelfName("Video Decoder");
+#	endif
+		Cinematics* _this = static_cast<Cinematics*>(arg);
+
+		while (true) {
+			_this->_frameQueueMutex.Lock();
+			while (_this->_frameQueueCount >= FrameQueueSize && !_this->_decoderShouldExit) {
+				_this->_frameQueueCV.Wait(_this->_frameQueueMutex);
+			}
+			if (_this->_decoderShouldExit) {
+				_this->_frameQueueMutex.Unlock();
+				break;
+			}
+			int32_t index = (_this->_frameQueueHead + _this->_frameQueueCount) % FrameQueueSize;
+			_this->_frameQueueMutex.Unlock();
+
+			bool hasFrame = _this->DecodeNextFrame(_this->_frameQueue[index].get());
+
+			_this->_frameQueueMutex.Lock();
+			if (hasFrame) {
+				_this->_frameQueueCount++;
+			} else {
+				_this->_decoderFinished = true;
+			}
+			_this->_frameQueueCV.Broadcast();
+			_this->_frameQueueMutex.Unlock();
+
+			if (!hasFrame) {
+				break;
+			}
+		}
+	}
+#endif
+
+	void Cinematics::ReadFromInflater(DecompressedStream& stream, uint8_t* buffer, uint32_t bytes)
+	{
+		while (bytes > 0) {
+			if (stream.Offset >= stream.Length) {
+				stream.Offset = 0;
+				stream.Length = (stream.Buffer != nullptr ? stream.Inflater.Read(stream.Buffer.get(), StreamBufferSize) : 0);
+				if (stream.Length <= 0) {
+					// End of stream was reached, the rest is filled with zeros
+					stream.Length = 0;
+					memset(buffer, 0, bytes);
+					return;
+				}
+			}
+
+			uint32_t bytesToCopy = std::min(bytes, (uint32_t)(stream.Length - stream.Offset));
+			memcpy(buffer, &stream.Buffer[stream.Offset], bytesToCopy);
+			stream.Offset += bytesToCopy;
+			buffer += bytesToCopy;
+			bytes -= bytesToCopy;
+		}
 	}
 
 	void Cinematics::UpdatePressedActions()
@@ -318,10 +444,9 @@ namespace Jazz2::UI
 			frameSize = Vector2f(viewSize.X, viewSize.X * ratio);
 		}
 
-		auto instanceBlock = _renderCommand.material().uniformBlock(Material::InstanceBlockName);
-		instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(1.0f, 0.0f, -1.0f, 1.0f);
-		instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatVector(frameSize.Data());
-		instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf::White.Data());
+		_renderCommand.material().setInstanceTexRect(1.0f, 0.0f, -1.0f, 1.0f);
+		_renderCommand.material().setInstanceSpriteSize(frameSize.X, frameSize.Y);
+		_renderCommand.material().setInstanceColor(Colorf::White.Data());
 
 		_renderCommand.setTransformation(Matrix4x4f::Translation(0.0f, 0.0f, 0.0f));
 		_renderCommand.material().setTexture(*_owner->_texture);
@@ -10,6 +10,12 @@
 #include "../../nCine/Graphics/Shader.h"
 #include "../../nCine/Input/InputEvents.h"
 #include "../../nCine/Audio/AudioStreamPlayer.h"
+#include "../../nCine/IO/CompressionUtils.h"
+
+#if defined(WITH_THREADS)
+#	include "../../nCine/Threading/Thread.h"
+#	include "../../nCine/Threading/ThreadSync.h"
+#endif
 
 #include <functional>
 
@@ -32,6 +38,11 @@ namespace Jazz2::UI
 		void OnTouchEvent(const TouchEvent& event) override;
 
 	private:
+		/// Size of decompression window of each stream
+		static constexpr int32_t StreamBufferSize = 16384;
+		/// Number of frames that can be decoded ahead
+		static constexpr int32_t FrameQueueSize = 4;
+
 		IRootController* _root;
 
 		class CinematicsCanvas : public SceneNode
@@ -60,27 +71,56 @@ namespace Jazz2::UI
 		float _frameDelay, _frameProgress;
 		int _framesLeft;
 		std::unique_ptr<Texture> _texture;
+
+		struct DecompressedStream {
+			SmallVector<uint8_t, 0> CompressedData;
+			InflateStream Inflater;
+			std::unique_ptr<uint8_t[]> Buffer;
+			int32_t Offset;
+			int32_t Length;
+		};
+
+		// Decoder state, it's accessed only by the decoder thread after loading
 		std::unique_ptr<uint8_t[]> _buffer;
 		std::unique_ptr<uint8_t[]> _lastBuffer;
-		std::unique_ptr<uint32_t[]> _currentFrame;
 		uint32_t _palette[256];
-		SmallVector<uint8_t, 0> _decompressedStreams[4];
-		uint32_t _currentOffsets[countof(_decompressedStreams)];
+		DecompressedStream _streams[4];
+		int32_t _framesToDecode;
+
+		// Ring of decoded frames that are ready to upload
+		std::unique_ptr<uint32_t[]> _frameQueue[FrameQueueSize];
+		int32_t _frameQueueHead;
+		int32_t _frameQueueCount;
+		bool _decoderFinished;
+#if defined(WITH_THREADS)
+		bool _decoderShouldExit;
+		bool _isDecoderRunning;
+		Thread _decoderThread;
+		Mutex _frameQueueMutex;
+		CondVariable _frameQueueCV;
+#endif
 
 		BitArray _pressedKeys;
 		uint32_t _pressedActions;
 
 		bool LoadFromFile(const String& path);
 		void PrepareNextFrame();
+		bool DecodeNextFrame(uint32_t* target);
 		void UpdatePressedActions();
+		void ReadFromInflater(DecompressedStream& stream, uint8_t* buffer, uint32_t bytes);
+
+#if defined(WITH_THREADS)
+		static void OnDecoderThread(void* arg);
+#endif
 
 		inline void Read(int streamIndex, void* buffer, uint32_t bytes) {
-			if (_currentOffsets[streamIndex] + bytes > _decompressedStreams[streamIndex].size()) {
-				memset(buffer, 0, bytes);
+			auto& stream = _streams[streamIndex];
+			if (stream.Offset + (int32_t)bytes <= stream.Length) {
+				memcpy(buffer, &stream.Buffer[stream.Offset], bytes);
+				stream.Offset += bytes;
 			} else {
-				memcpy(buffer, &_decompressedStreams[streamIndex][_currentOffsets[streamIndex]], bytes);
+				ReadFromInflater(stream, (uint8_t*)buffer, bytes);
 			}
-			_currentOffsets[streamIndex] += bytes;
 		}
 
 		template<typename T>
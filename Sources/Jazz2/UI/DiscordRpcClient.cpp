@@ -259,6 +259,7 @@ namespace Jazz2::UI
 
 	void DiscordRpcClient::OnBackgroundThread(void* args)
 	{
+		Thread::SetSelfName("Discord RPC");
 		DiscordRpcClient* client = reinterpret_cast<DiscordRpcClient*>(args);
 
 		// Handshake
@@ -2,11 +2,14 @@
 
 #include "../ContentResolver.h"
 
+#include "../../nCine/Application.h"
 #include "../../nCine/Graphics/ITextureLoader.h"
 #include "../../nCine/Graphics/RenderQueue.h"
 #include "../../nCine/IO/IFileStream.h"
+#include "../../nCine/Base/HashFunctions.h"
 #include "../../nCine/Base/Random.h"
 
+#include <cstring>
 #include <Utf8.h>
 
 using namespace Death;
@@ -168,8 +171,221 @@ namespace Jazz2::UI
 			return;
 		}
 
+		bool isDefaultColor, useRandomColor, isShadow;
+		float alpha;
+		if (color.R() == DefaultColor.R() && color.G() == DefaultColor.G() && color.B() == DefaultColor.B()) {
+			isDefaultColor = true;
+			useRandomColor = false;
+			isShadow = false;
+			alpha = color.A();
+			color = Colorf(1.0f, 1.0f, 1.0f, alpha);
+		} else {
+			isDefaultColor = false;
+			useRandomColor = (color.R() == RandomColor.R() && color.G() == RandomColor.G() && color.B() == RandomColor.B());
+			isShadow = (color.R() == 0.0f && color.G() == 0.0f && color.B() == 0.0f);
+			alpha = std::min(color.A() * 2.0f, 1.0f);
+		}
+
+		// Formatting is ignored for random colors and shadows, so it affects the layout too
+		const TextLayout& layout = GetLayout(text, align, scale, charSpacing, lineSpacing, useRandomColor || isShadow);
+		int32_t glyphCount = (int32_t)layout.Glyphs.size();
+
+		auto resolveColor = [&](int32_t i, bool& colorized) -> Colorf {
+			const GlyphQuad& glyph = layout.Glyphs[i];
+			if (useRandomColor) {
+				const Colorf& newColor = RandomColors[(charOffset + i) % countof(RandomColors)];
+				colorized = true;
+				return Colorf(newColor.R(), newColor.G(), newColor.B(), color.A());
+			}
+			switch (glyph.Color) {
+				default:
+				case GlyphColor::Inherit: {
+					colorized = !isDefaultColor;
+					return color;
+				}
+				case GlyphColor::Custom: {
+					Colorf customColor = Colorf(Color(glyph.CustomColor));
+					customColor.SetAlpha(0.5f * alpha);
+					colorized = true;
+					return customColor;
+				}
+				case GlyphColor::Reset: {
+					colorized = false;
+					return Colorf(1.0f, 1.0f, 1.0f, alpha);
+				}
+			}
+		};
+
 		// TODO: Revise this
 		float phase = canvas->AnimTime * speed * 16.0f;
+		Vector2f originPos = Vector2f(x - canvas->ViewSize.X * 0.5f, canvas->ViewSize.Y * 0.5f - y);
+
+		// Consecutive glyphs with the same color are submitted as one triangle strip
+		int32_t runStart = 0;
+		while (runStart < glyphCount) {
+			bool runColorized;
+			Colorf runColor = resolveColor(runStart, runColorized);
+			int32_t runEnd = runStart + 1;
+			while (runEnd < glyphCount) {
+				bool colorized;
+				Colorf glyphColor = resolveColor(runEnd, colorized);
+				if (colorized != runColorized || glyphColor != runColor) {
+					break;
+				}
+				runEnd++;
+			}
+
+			// Neighbouring glyphs can overlap, so every other glyph is drawn one layer below, like when each glyph had its own command
+			for (int32_t parity = 0; parity < 2; parity++) {
+				int32_t glyphsInCommand = 0;
+				for (int32_t i = runStart; i < runEnd; i++) {
+					if (((charOffset + i) & 1) == parity) {
+						glyphsInCommand++;
+					}
+				}
+				if (glyphsInCommand == 0) {
+					continue;
+				}
+
+				// Each glyph has 4 vertices, glyphs are joined by 2 degenerate vertices
+				int32_t vertexCount = glyphsInCommand * 6 - 2;
+				float* vertices;
+				auto command = canvas->RentMeshRenderCommand(vertexCount * VertexFloats, vertices);
+				bool shaderChanged = (runColorized
+					? command->material().setShader(ContentResolver::Get().GetShader(PrecompiledShader::MeshColorized))
+					: command->material().setShaderProgramType(Material::ShaderProgramType::MESH_SPRITE));
+				if (shaderChanged) {
+					command->material().reserveUniformsDataMemory();
+					command->geometry().setNumElementsPerVertex(VertexFloats);
+					// Required to reset render command properly
+					command->setTransformation(command->transformation());
+
+					GLUniformCache* textureUniform = command->material().uniform(Material::TextureUniformName);
+					if (textureUniform && textureUniform->intValue(0) != 0) {
+						textureUniform->setIntValue(0); // GL_TEXTURE0
+					}
+				}
+
+				command->geometry().setDrawParameters(GL_TRIANGLE_STRIP, 0, vertexCount);
+				command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+				command->material().setInstanceTexRect(1.0f, 0.0f, 1.0f, 0.0f);
+				command->material().setInstanceSpriteSize(1.0f, 1.0f);
+				command->material().setInstanceColor(runColor.Data());
+
+				float* vertex = vertices;
+				int32_t glyphIndex = 0;
+				for (int32_t i = runStart; i < runEnd; i++) {
+					if (((charOffset + i) & 1) != parity) {
+						continue;
+					}
+
+					const GlyphQuad& glyph = layout.Glyphs[i];
+					Vector2f pos = originPos + glyph.Pos;
+
+					if (angleOffset > 0.0f) {
+						int32_t glyphOffset = charOffset + i;
+						float currentPhase = (phase + glyphOffset) * angleOffset * fPi;
+						if (speed > 0.0f && (glyphOffset % 2) == 1) {
+							currentPhase = -currentPhase;
+						}
+
+						pos.X += cosf(currentPhase) * varianceX * scale;
+						pos.Y -= sinf(currentPhase) * varianceY * scale;
+					}
+
+					// TODO: It looks better with the "0.5f" offset
+					float centerX = std::round(pos.X + glyph.HalfCell.X) - glyph.ShiftX;
+					float centerY = std::round(pos.Y - glyph.HalfCell.Y) + 0.5f;
+					float left = centerX - glyph.Size.X * 0.5f;
+					float right = centerX + glyph.Size.X * 0.5f;
+					float top = centerY + glyph.Size.Y * 0.5f;
+					float bottom = centerY - glyph.Size.Y * 0.5f;
+
+					// Same vertex order as the sprite shader uses
+					const float quad[4][VertexFloats] = {
+						{ right, top, glyph.TexRight, glyph.TexTop },
+						{ right, bottom, glyph.TexRight, glyph.TexBottom },
+						{ left, top, glyph.TexLeft, glyph.TexTop },
+						{ left, bottom, glyph.TexLeft, glyph.TexBottom }
+					};
+
+					if (glyphIndex > 0) {
+						std::memcpy(vertex, quad[0], sizeof(quad[0]));
+						vertex += VertexFloats;
+					}
+					std::memcpy(vertex, quad, sizeof(quad));
+					vertex += countof(quad) * VertexFloats;
+					if (glyphIndex < glyphsInCommand - 1) {
+						std::memcpy(vertex, quad[3], sizeof(quad[3]));
+						vertex += VertexFloats;
+					}
+					glyphIndex++;
+				}
+
+				command->setTransformation(Matrix4x4f::Identity);
+				command->setLayer(z - parity);
+				command->material().setTexture(*_texture.get());
+
+				canvas->_currentRenderQueue->addCommand(command);
+
+			}
+
+			runStart = runEnd;
+		}
+
+		charOffset += glyphCount + 1;
+	}
+
+	const Font::TextLayout& Font::GetLayout(const StringView& text, Alignment align, float scale, float charSpacing, float lineSpacing, bool ignoreFormatting)
+	{
+		struct {
+			float Scale;
+			float CharSpacing;
+			float LineSpacing;
+			uint32_t Flags;
+		} params = { scale, charSpacing, lineSpacing, (uint32_t)align | (ignoreFormatting ? 0x80000000u : 0u) };
+
+		uint64_t key = fasthash64(text.data(), text.size(), 0);
+		key = fasthash64(&params, sizeof(params), key);
+
+		unsigned long currentFrame = theApplication().numFrames();
+		auto it = _layoutCache.find(key);
+		if (it != _layoutCache.end() && it->second.Text == text) {
+			it->second.LastUsedFrame = currentFrame;
+			return it->second;
+		}
+
+		if (it == _layoutCache.end()) {
+			if (_layoutCache.size() >= MaxCachedLayouts) {
+				// Drop layouts that weren't drawn in the last frame, e.g. changing counters
+				for (auto it2 = _layoutCache.begin(); it2 != _layoutCache.end(); ) {
+					if (it2->second.LastUsedFrame + 1 < currentFrame) {
+						it2 = _layoutCache.erase(it2);
+					} else {
+						++it2;
+					}
+				}
+				// Too many strings are drawn every frame, so it's cheaper to start over than to keep the cache growing
+				if (_layoutCache.size() >= MaxCachedLayouts) {
+					_layoutCache.clear();
+				}
+			}
+			it = _layoutCache.emplace(key, TextLayout()).first;
+		}
+
+		TextLayout& layout = it->second;
+		layout.Text = text;
+		layout.LastUsedFrame = currentFrame;
+		BuildLayout(layout, text, align, scale, charSpacing, lineSpacing, ignoreFormatting);
+		return layout;
+	}
+
+	void Font::BuildLayout(TextLayout& layout, const StringView& text, Alignment align, float scale, float charSpacing, float lineSpacing, bool ignoreFormatting)
+	{
+		layout.Glyphs.clear();
+
+		size_t textLength = text.size();
 
 		// Maximum number of lines - center and right alignment starts to glitch if text has more lines, but it should be enough in most cases
 		constexpr int32_t MaxLines = 16;
@@ -234,8 +450,8 @@ namespace Jazz2::UI
 		lineWidths[line & (MaxLines - 1)] = lastWidth;
 		totalHeight += (_charSize.Y * scale * lineSpacing);
 
-		// Rendering
-		Vector2f originPos = Vector2f(x - canvas->ViewSize.X * 0.5f, canvas->ViewSize.Y * 0.5f - y);
+		// Layout relative to the string origin
+		Vector2f originPos = Vector2f::Zero;
 		switch (align & Alignment::HorizontalMask) {
 			case Alignment::Center: originPos.X -= totalWidth * 0.5f; break;
 			case Alignment::Right: originPos.X -= totalWidth; break;
@@ -253,21 +469,8 @@ namespace Jazz2::UI
 		}
 
 		Vector2i texSize = _texture->size();
-		Shader* colorizeShader;
-		bool useRandomColor, isShadow;
-		float alpha;
-		if (color.R() == DefaultColor.R() && color.G() == DefaultColor.G() && color.B() == DefaultColor.B()) {
-			colorizeShader = nullptr;
-			useRandomColor = false;
-			isShadow = false;
-			alpha = color.A();
-			color = Colorf(1.0f, 1.0f, 1.0f, alpha);
-		} else {
-			colorizeShader = ContentResolver::Get().GetShader(PrecompiledShader::Colorized);
-			useRandomColor = (color.R() == RandomColor.R() && color.G() == RandomColor.G() && color.B() == RandomColor.B());
-			isShadow = (color.R() == 0.0f && color.G() == 0.0f && color.B() == 0.0f);
-			alpha = std::min(color.A() * 2.0f, 1.0f);
-		}
+		GlyphColor glyphColor = GlyphColor::Inherit;
+		uint32_t customColor = 0;
 
 		idx = 0;
 		line = 0;
@@ -314,25 +517,21 @@ namespace Jazz2::UI
 										idx = cursor.second;
 									} while (idx < textLength);
 
-									if (paramLength > 0 && !useRandomColor && !isShadow) {
+									if (paramLength > 0 && !ignoreFormatting) {
 										param[paramLength] = '\0';
 										char* end = &param[paramLength];
 										unsigned long paramValue = strtoul(param, &end, 16);
 										if (param != end) {
-											color = Color(paramValue);
-											color.SetAlpha(0.5f * alpha);
-											if (colorizeShader == nullptr) {
-												colorizeShader = ContentResolver::Get().GetShader(PrecompiledShader::Colorized);
-											}
+											glyphColor = GlyphColor::Custom;
+											customColor = (uint32_t)paramValue;
 										}
 									}
 								}
 							}
 						} else if (cursor.first == ']') {
 							// Reset color
-							if (!useRandomColor && !isShadow) {
-								color = Colorf(1.0f, 1.0f, 1.0f, alpha);
-								colorizeShader = nullptr;
+							if (!ignoreFormatting) {
+								glyphColor = GlyphColor::Reset;
 							}
 						}
 					} else if (cursor.first == 'w') {
@@ -353,7 +552,7 @@ namespace Jazz2::UI
 								idx = cursor.second;
 							} while (idx < textLength);
 
-							if (paramLength > 0 && !useRandomColor && !isShadow) {
+							if (paramLength > 0 && !ignoreFormatting) {
 								param[paramLength] = '\0';
 								char* end = &param[paramLength];
 								unsigned long paramValue = strtoul(param, &end, 10);
@@ -381,78 +580,28 @@ namespace Jazz2::UI
 				}
 
 				if (uvRect.W > 0 && uvRect.H > 0) {
-					if (useRandomColor) {
-						const Colorf& newColor = RandomColors[charOffset % countof(RandomColors)];
-						color = Colorf(newColor.R(), newColor.G(), newColor.B(), color.A());
-					}
-
-					Vector2f pos = Vector2f(originPos);
-
-					if (angleOffset > 0.0f) {
-						float currentPhase = (phase + charOffset) * angleOffset * fPi;
-						if (speed > 0.0f && (charOffset % 2) == 1) {
-							currentPhase = -currentPhase;
-						}
-
-						pos.X += cosf(currentPhase) * varianceX * scale;
-						pos.Y -= sinf(currentPhase) * varianceY * scale;
-					}
-
-					pos.X = std::round(pos.X + uvRect.W * scale * 0.5f);
-					pos.Y = std::round(pos.Y - uvRect.H * scale * 0.5f);
-
 					int32_t charWidth = _charSize.X;
 					if (charWidth > uvRect.W) {
 						charWidth--;
 					}
 
-					Vector4f texCoords = Vector4f(
-						charWidth / float(texSize.X),
-						uvRect.X,
-						uvRect.H / float(texSize.Y),
-						uvRect.Y
-					);
-
-					texCoords.W += texCoords.Z;
-					texCoords.Z *= -1;
-
-					auto command = canvas->RentRenderCommand();
-					bool shaderChanged = (colorizeShader
-						? command->material().setShader(colorizeShader)
-						: command->material().setShaderProgramType(Material::ShaderProgramType::SPRITE));
-					if (shaderChanged) {
-						command->material().reserveUniformsDataMemory();
-						command->geometry().setDrawParameters(GL_TRIANGLE_STRIP, 0, 4);
-						// Required to reset render command properly
-						command->setTransformation(command->transformation());
-
-						GLUniformCache* textureUniform = command->material().uniform(Material::TextureUniformName);
-						if (textureUniform && textureUniform->intValue(0) != 0) {
-							textureUniform->setIntValue(0); // GL_TEXTURE0
-						}
-					}
-
-					command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-					auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-					instanceBlock->uniform(Material::TexRectUniformName)->setFloatVector(texCoords.Data());
-					instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(charWidth * scale, uvRect.H * scale);
-					instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(color.Data());
-
-					// TODO: It looks better with the "0.5f" offset
-					command->setTransformation(Matrix4x4f::Translation(pos.X - (uvRect.W - charWidth) * 0.5f * scale, pos.Y + 0.5f, 0.0f));
-					command->setLayer(z - (charOffset & 1));
-					command->material().setTexture(*_texture.get());
-
-					canvas->_currentRenderQueue->addCommand(command);
+					GlyphQuad& glyph = layout.Glyphs.emplace_back();
+					glyph.Pos = originPos;
+					glyph.HalfCell = Vector2f(uvRect.W * scale * 0.5f, uvRect.H * scale * 0.5f);
+					glyph.Size = Vector2f(charWidth * scale, uvRect.H * scale);
+					glyph.ShiftX = (uvRect.W - charWidth) * 0.5f * scale;
+					glyph.TexLeft = uvRect.X;
+					glyph.TexRight = uvRect.X + charWidth / float(texSize.X);
+					glyph.TexTop = uvRect.Y;
+					glyph.TexBottom = uvRect.Y + uvRect.H / float(texSize.Y);
+					glyph.CustomColor = customColor;
+					glyph.Color = glyphColor;
 
 					originPos.X += ((uvRect.W + _baseSpacing) * scale * charSpacing);
-					charOffset++;
 				}
 			}
 
 			idx = cursor.second;
 		} while (idx < textLength);
-		charOffset++;
 	}
 }
\ No newline at end of file
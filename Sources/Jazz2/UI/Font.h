@@ -6,6 +6,9 @@
 #include "../../nCine/Base/HashMap.h"
 #include "../../nCine/Graphics/Texture.h"
 
+#include <Containers/SmallVector.h>
+#include <Containers/String.h>
+
 using namespace nCine;
 
 namespace Jazz2::UI
@@ -35,10 +38,45 @@ namespace Jazz2::UI
 			Colorf(0.56f, 0.50f, 0.42f, 0.5f),
 		};
 
+		/// Color of a glyph as specified by formatting in the text
+		enum class GlyphColor : uint8_t {
+			/// Color specified by the caller
+			Inherit,
+			/// Custom color specified by `\f[c:0x...]`
+			Custom,
+			/// Color reset by `\f[c]`
+			Reset
+		};
+
+		/// Precomputed glyph quad relative to the string origin
+		struct GlyphQuad {
+			Vector2f Pos;
+			Vector2f HalfCell;
+			Vector2f Size;
+			float ShiftX;
+			float TexLeft, TexRight, TexTop, TexBottom;
+			uint32_t CustomColor;
+			GlyphColor Color;
+		};
+
+		/// Cached layout of a string, reused until the string or any layout parameter changes
+		struct TextLayout {
+			String Text;
+			SmallVector<GlyphQuad, 0> Glyphs;
+			unsigned long LastUsedFrame;
+		};
+
+		static constexpr int32_t MaxCachedLayouts = 256;
+		static constexpr int32_t VertexFloats = 4;
+
 		Rectf _asciiChars[128];
 		HashMap<uint32_t, Rectf> _unicodeChars;
 		Vector2i _charSize;
 		int32_t _baseSpacing;
 		std::unique_ptr<Texture> _texture;
+		HashMap<uint64_t, TextLayout> _layoutCache;
+
+		const TextLayout& GetLayout(const StringView& text, Alignment align, float scale, float charSpacing, float lineSpacing, bool ignoreFormatting);
+		void BuildLayout(TextLayout& layout, const StringView& text, Alignment align, float scale, float charSpacing, float lineSpacing, bool ignoreFormatting);
 	};
 }
\ No newline at end of file
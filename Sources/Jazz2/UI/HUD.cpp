@@ -8,6 +8,10 @@
 #include "../../nCine/IO/IFileStream.h"
 #include "../../nCine/Base/Random.h"
 #include "../../nCine/Application.h"
+#include "../../nCine/Base/ScratchArena.h"
+#if defined(WITH_ALLOCATORS)
+#	include "../../nCine/Base/AllocManager.h"
+#endif
 
 // Position of key in 22x6 grid
 static constexpr uint8_t KeyLayout[] = {
@@ -24,7 +28,7 @@ namespace Jazz2::UI
 	HUD::HUD(LevelHandler* levelHandler)
 		: _levelHandler(levelHandler), _graphics(nullptr), _levelTextTime(-1.0f), _coins(0), _gems(0), _coinsTime(-1.0f), _gemsTime(-1.0f),
 			_activeBossTime(0.0f), _touchButtonsTimer(0.0f), _rgbAmbientLight(0.0f), _rgbHealthLast(0.0f), _weaponWheelAnim(0.0f),
-			_weaponWheelShown(false), _lastWeaponWheelIndex(-1), _rgbLightsTime(0.0f), _transitionState(TransitionState::None),
+			_weaponWheelShown(false), _weaponWheelVertices(nullptr), _lastWeaponWheelIndex(-1), _rgbLightsTime(0.0f), _transitionState(TransitionState::None),
 			_transitionTime(0.0f)
 	{
 		auto& resolver = ContentResolver::Get();
@@ -34,6 +38,36 @@ namespace Jazz2::UI
 			_graphics = &metadata->Graphics;
 		}
 
+		_characterIcons[0] = ResolveElement("CharacterJazz"_s);
+		_characterIcons[1] = ResolveElement("CharacterSpaz"_s);
+		_characterIcons[2] = ResolveElement("CharacterLori"_s);
+		_characterIcons[3] = ResolveElement("CharacterFrog"_s);
+		_foodIcon = ResolveElement("PickupFood"_s);
+		_heartIcon = ResolveElement("Heart"_s);
+		_coinIcon = ResolveElement("PickupCoin"_s);
+		_gemIcon = ResolveElement("PickupGem"_s);
+		_bossHealthBar = ResolveElement("BossHealthBar"_s);
+		_weaponWheel = ResolveElement("WeaponWheel"_s);
+		_weaponWheelInner = ResolveElement("WeaponWheelInner"_s);
+		_weaponWheelDim = ResolveElement("WeaponWheelDim"_s);
+
+		static const StringView WeaponNames[] = {
+			"Blaster"_s, "Bouncer"_s, "Freezer"_s, "Seeker"_s, "RF"_s, "Toaster"_s, "TNT"_s, "Pepper"_s, "Electro"_s, "Thunderbolt"_s
+		};
+		static_assert(countof(WeaponNames) == (int32_t)WeaponType::Count, "WeaponNames must match WeaponType");
+		static const StringView BlasterSuffixes[] = { "Jazz"_s, "Spaz"_s, "Lori"_s };
+
+		for (int32_t i = 0; i < 2; i++) {
+			StringView prefix = (i == 0 ? "Weapon"_s : "WeaponPowerUp"_s);
+			for (int32_t j = 0; j < (int32_t)WeaponType::Count; j++) {
+				_weaponIcons[i][j] = ResolveElement(prefix + WeaponNames[j]);
+			}
+			for (int32_t j = 0; j < (int32_t)countof(BlasterSuffixes); j++) {
+				_blasterIcons[i][j] = ResolveElement(prefix + "Blaster"_s + BlasterSuffixes[j]);
+			}
+		}
+		_toasterDisabledIcon = ResolveElement("WeaponToasterDisabled"_s);
+
 		_smallFont = resolver.GetFont(FontType::Small);
 
 		_touchButtons[0] = CreateTouchButton(PlayerActions::None, "TouchDpad"_s, Alignment::BottomLeft, DpadLeft, DpadBottom, DpadSize, DpadSize);
@@ -169,13 +203,13 @@ namespace Jazz2::UI
 			PlayerType playerType = player->_playerType;
 
 			// Bottom left
-			StringView playerIcon;
+			GraphicResource* playerIcon;
 			switch (playerType) {
 				default:
-				case PlayerType::Jazz: playerIcon = "CharacterJazz"_s; break;
-				case PlayerType::Spaz: playerIcon = "CharacterSpaz"_s; break;
-				case PlayerType::Lori: playerIcon = "CharacterLori"_s; break;
-				case PlayerType::Frog: playerIcon = "CharacterFrog"_s; break;
+				case PlayerType::Jazz: playerIcon = _characterIcons[0]; break;
+				case PlayerType::Spaz: playerIcon = _characterIcons[1]; break;
+				case PlayerType::Lori: playerIcon = _characterIcons[2]; break;
+				case PlayerType::Frog: playerIcon = _characterIcons[3]; break;
 			}
 
 			DrawElement(playerIcon, -1, adjustedView.X + 38.0f, bottom - 1.0f + 1.6f, ShadowLayer, Alignment::BottomRight, Colorf(0.0f, 0.0f, 0.0f, 0.4f));
@@ -211,8 +245,8 @@ namespace Jazz2::UI
 				}
 
 				// Top left
-				DrawElement("PickupFood"_s, -1, view.X + 3.0f, view.Y + 3.0f + 1.6f, ShadowLayer, Alignment::TopLeft, Colorf(0.0f, 0.0f, 0.0f, 0.4f));
-				DrawElement("PickupFood"_s, -1, view.X + 3.0f, view.Y + 3.0f, MainLayer, Alignment::TopLeft, Colorf::White);
+				DrawElement(_foodIcon, -1, view.X + 3.0f, view.Y + 3.0f + 1.6f, ShadowLayer, Alignment::TopLeft, Colorf(0.0f, 0.0f, 0.0f, 0.4f));
+				DrawElement(_foodIcon, -1, view.X + 3.0f, view.Y + 3.0f, MainLayer, Alignment::TopLeft, Colorf::White);
 
 				snprintf(stringBuffer, countof(stringBuffer), "%08i", player->_score);
 				_smallFont->DrawString(this, stringBuffer, charOffsetShadow, view.X + 14.0f, view.Y + 5.0f + 1.0f, FontShadowLayer,
@@ -221,7 +255,7 @@ namespace Jazz2::UI
 					Alignment::TopLeft, Font::DefaultColor, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.88f);
 			} else {
 				for (int32_t i = 0; i < player->_health; i++) {
-					DrawElement("Heart"_s, -1, view.X + view.W - 4.0f - (i * 16.0f), view.Y + 4.0f, MainLayer, Alignment::TopRight, Colorf::White);
+					DrawElement(_heartIcon, -1, view.X + view.W - 4.0f - (i * 16.0f), view.Y + 4.0f, MainLayer, Alignment::TopRight, Colorf::White);
 				}
 
 				if (player->_lives > 0) {
@@ -244,7 +278,7 @@ namespace Jazz2::UI
 			if (player->_weaponAllowed && playerType != PlayerType::Frog) {
 				WeaponType weapon = player->_currentWeapon;
 				Vector2f pos = Vector2f(right - 40.0f, bottom - 2.0f);
-				StringView currentWeaponString = GetCurrentWeapon(player, weapon, pos);
+				GraphicResource* currentWeapon = GetCurrentWeapon(player, weapon, pos);
 
 				StringView ammoCount;
 				if (player->_weaponAmmo[(int32_t)weapon] == UINT16_MAX) {
@@ -259,14 +293,13 @@ namespace Jazz2::UI
 				_smallFont->DrawString(this, ammoCount, charOffset, right - 40.0f, bottom - 2.0f, FontLayer,
 					Alignment::BottomLeft, Font::DefaultColor, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.96f);
 
-				auto it = _graphics->find(String::nullTerminatedView(currentWeaponString));
-				if (it != _graphics->end()) {
-					if (it->second.Base->FrameDimensions.Y < 20) {
-						pos.Y -= std::round((20 - it->second.Base->FrameDimensions.Y) * 0.5f);
+				if (currentWeapon != nullptr) {
+					if (currentWeapon->Base->FrameDimensions.Y < 20) {
+						pos.Y -= std::round((20 - currentWeapon->Base->FrameDimensions.Y) * 0.5f);
 					}
 
-					DrawElement(currentWeaponString, -1, pos.X, pos.Y + 1.6f, ShadowLayer, Alignment::BottomRight, Colorf(0.0f, 0.0f, 0.0f, 0.4f));
-					DrawElement(currentWeaponString, -1, pos.X, pos.Y, MainLayer, Alignment::BottomRight, Colorf::White);
+					DrawElement(currentWeapon, -1, pos.X, pos.Y + 1.6f, ShadowLayer, Alignment::BottomRight, Colorf(0.0f, 0.0f, 0.0f, 0.4f));
+					DrawElement(currentWeapon, -1, pos.X, pos.Y, MainLayer, Alignment::BottomRight, Colorf::White);
 				}
 			}
 
@@ -285,11 +318,11 @@ namespace Jazz2::UI
 
 				float perc = 0.08f + 0.84f * _levelHandler->_activeBoss->GetHealth() / _levelHandler->_activeBoss->GetMaxHealth();
 
-				DrawElement("BossHealthBar"_s, 0, ViewSize.X * 0.5f, y + 2.0f, ShadowLayer, Alignment::Center, Colorf(0.0f, 0.0f, 0.0f, 0.1f * alpha));
-				DrawElement("BossHealthBar"_s, 0, ViewSize.X * 0.5f, y + 1.0f, ShadowLayer, Alignment::Center, Colorf(0.0f, 0.0f, 0.0f, 0.2f * alpha));
+				DrawElement(_bossHealthBar, 0, ViewSize.X * 0.5f, y + 2.0f, ShadowLayer, Alignment::Center, Colorf(0.0f, 0.0f, 0.0f, 0.1f * alpha));
+				DrawElement(_bossHealthBar, 0, ViewSize.X * 0.5f, y + 1.0f, ShadowLayer, Alignment::Center, Colorf(0.0f, 0.0f, 0.0f, 0.2f * alpha));
 
-				DrawElement("BossHealthBar"_s, 0, ViewSize.X * 0.5f, y, MainLayer, Alignment::Center, Colorf(1.0f, 1.0f, 1.0f, alpha));
-				DrawElementClipped("BossHealthBar"_s, 1, ViewSize.X * 0.5f, y, MainLayer + 2, Alignment::Center, Colorf(1.0f, 1.0f, 1.0f, alpha), perc, 1.0f);
+				DrawElement(_bossHealthBar, 0, ViewSize.X * 0.5f, y, MainLayer, Alignment::Center, Colorf(1.0f, 1.0f, 1.0f, alpha));
+				DrawElementClipped(_bossHealthBar, 1, ViewSize.X * 0.5f, y, MainLayer + 2, Alignment::Center, Colorf(1.0f, 1.0f, 1.0f, alpha), perc, 1.0f);
 			}
 
 			// Misc
@@ -304,6 +337,12 @@ namespace Jazz2::UI
 				i32tos((int32_t)std::round(theApplication().averageFps()), stringBuffer);
 				_smallFont->DrawString(this, stringBuffer, charOffset, view.W - 4.0f, view.Y + 2.0f, FontLayer,
 					Alignment::TopRight, Font::DefaultColor, 0.8f, 0.0f, 0.0f, 0.0f, 0.0f, 0.96f);
+#if defined(WITH_ALLOCATORS)
+				// Memory that is tracked by subsystem allocators
+				snprintf(stringBuffer, countof(stringBuffer), "%.1f MB", AllocManager::usedMemory() / (1024.0f * 1024.0f));
+				_smallFont->DrawString(this, stringBuffer, charOffset, view.W - 4.0f, view.Y + 12.0f, FontLayer,
+					Alignment::TopRight, Font::DefaultColor, 0.7f, 0.0f, 0.0f, 0.0f, 0.0f, 0.96f);
+#endif
 			}
 
 			// Touch Controls
@@ -337,7 +376,17 @@ namespace Jazz2::UI
 					x = x - ViewSize.X * 0.5f;
 					y = ViewSize.Y * 0.5f - y;
 
-					DrawTexture(*button.Graphics->Base->TextureDiffuse, Vector2f(x, y), TouchButtonsLayer, Vector2f(button.Width, button.Height), Vector4f(1.0f, 0.0f, -1.0f, 1.0f), Colorf::White);
+					GenericGraphicResource* base = button.Graphics->Base;
+					Vector2i texSize = base->TextureDiffuse->size();
+					Vector2i sheetSize = base->FrameDimensions * base->FrameConfiguration;
+					Vector4f texCoords = Vector4f(
+						float(sheetSize.X) / float(texSize.X),
+						float(base->TextureOffset.X) / float(texSize.X),
+						float(-sheetSize.Y) / float(texSize.Y),
+						float(base->TextureOffset.Y + sheetSize.Y) / float(texSize.Y)
+					);
+
+					DrawTexture(*base->TextureDiffuse, Vector2f(x, y), TouchButtonsLayer, Vector2f(button.Width, button.Height), texCoords, Colorf::White);
 				}
 			}
 		}
@@ -351,10 +400,9 @@ namespace Jazz2::UI
 
 			command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-			auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-			instanceBlock->uniform(Material::TexRectUniformName)->setFloatVector(Vector4f(1.0f, 0.0f, 1.0f, 0.0f).Data());
-			instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatVector(Vector2f(static_cast<float>(ViewSize.X), static_cast<float>(ViewSize.Y)).Data());
-			instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf(0.0f, 0.0f, 0.0f, _transitionTime).Data());
+			command->material().setInstanceTexRect(1.0f, 0.0f, 1.0f, 0.0f);
+			command->material().setInstanceSpriteSize(static_cast<float>(ViewSize.X), static_cast<float>(ViewSize.Y));
+			command->material().setInstanceColor(Colorf(0.0f, 0.0f, 0.0f, _transitionTime).Data());
 
 			command->setTransformation(Matrix4x4f::Identity);
 			command->setLayer(999);
@@ -566,9 +614,9 @@ namespace Jazz2::UI
 			alpha = 1.0f;
 		}
 
-		DrawElement("PickupCoin"_s, -1, ViewSize.X * 0.5f, ViewSize.Y * 0.92f + 2.5f + offset, ShadowLayer,
+		DrawElement(_coinIcon, -1, ViewSize.X * 0.5f, ViewSize.Y * 0.92f + 2.5f + offset, ShadowLayer,
 			Alignment::Right, Colorf(0.0f, 0.0f, 0.0f, 0.2f * alpha), 0.8f, 0.8f);
-		DrawElement("PickupCoin"_s, -1, ViewSize.X * 0.5f, ViewSize.Y * 0.92f + offset, MainLayer,
+		DrawElement(_coinIcon, -1, ViewSize.X * 0.5f, ViewSize.Y * 0.92f + offset, MainLayer,
 			Alignment::Right, Colorf(1.0f, 1.0f, 1.0f, alpha * alpha), 0.8f, 0.8f);
 
 		char stringBuffer[32];
@@ -613,9 +661,9 @@ namespace Jazz2::UI
 		}
 
 		float animAlpha = alpha * alpha;
-		DrawElement("PickupGem"_s, -1, ViewSize.X * 0.5f, ViewSize.Y * 0.92f + 2.5f + offset, ShadowLayer, Alignment::Right,
+		DrawElement(_gemIcon, -1, ViewSize.X * 0.5f, ViewSize.Y * 0.92f + 2.5f + offset, ShadowLayer, Alignment::Right,
 			Colorf(0.0f, 0.0f, 0.0f, 0.4f * animAlpha), 0.8f, 0.8f);
-		DrawElement("PickupGem"_s, -1, ViewSize.X * 0.5f, ViewSize.Y * 0.92f + offset, MainLayer, Alignment::Right,
+		DrawElement(_gemIcon, -1, ViewSize.X * 0.5f, ViewSize.Y * 0.92f + offset, MainLayer, Alignment::Right,
 			Colorf(1.0f, 1.0f, 1.0f, 0.8f * animAlpha), 0.8f, 0.8f);
 
 		char stringBuffer[32];
@@ -635,18 +683,27 @@ namespace Jazz2::UI
 		}
 	}
 
-	void HUD::DrawElement(const StringView& name, int32_t frame, float x, float y, uint16_t z, Alignment align, const Colorf& color, float scaleX, float scaleY, bool additiveBlending, float angle)
+	GraphicResource* HUD::ResolveElement(const StringView& name)
 	{
-		auto it = _graphics->find(String::nullTerminatedView(name));
-		if (it == _graphics->end()) {
+		if (_graphics == nullptr) {
+			return nullptr;
+		}
+
+		auto it = _graphics->find(Atom::find(name));
+		return (it != _graphics->end() ? &it->second : nullptr);
+	}
+
+	void HUD::DrawElement(GraphicResource* element, int32_t frame, float x, float y, uint16_t z, Alignment align, const Colorf& color, float scaleX, float scaleY, bool additiveBlending, float angle)
+	{
+		if (element == nullptr) {
 			return;
 		}
 
 		if (frame < 0) {
-			frame = it->second.FrameOffset + ((int32_t)(AnimTime * it->second.FrameCount / it->second.AnimDuration) % it->second.FrameCount);
+			frame = element->FrameOffset + ((int32_t)(AnimTime * element->FrameCount / element->AnimDuration) % element->FrameCount);
 		}
 
-		GenericGraphicResource* base = it->second.Base;
+		GenericGraphicResource* base = element->Base;
 		Vector2f size = Vector2f(base->FrameDimensions.X * scaleX, base->FrameDimensions.Y * scaleY);
 		Vector2f adjustedPos = ApplyAlignment(align, Vector2f(x - ViewSize.X * 0.5f, ViewSize.Y * 0.5f - y), size);
 
@@ -655,9 +712,9 @@ namespace Jazz2::UI
 		int32_t row = frame / base->FrameConfiguration.X;
 		Vector4f texCoords = Vector4f(
 			float(base->FrameDimensions.X) / float(texSize.X),
-			float(base->FrameDimensions.X * col) / float(texSize.X),
+			float(base->TextureOffset.X + base->FrameDimensions.X * col) / float(texSize.X),
 			float(base->FrameDimensions.Y) / float(texSize.Y),
-			float(base->FrameDimensions.Y * row) / float(texSize.Y)
+			float(base->TextureOffset.Y + base->FrameDimensions.Y * row) / float(texSize.Y)
 		);
 
 		texCoords.W += texCoords.Z;
@@ -666,18 +723,17 @@ namespace Jazz2::UI
 		DrawTexture(*base->TextureDiffuse.get(), adjustedPos, z, size, texCoords, color, additiveBlending, angle);
 	}
 
-	void HUD::DrawElementClipped(const StringView& name, int32_t frame, float x, float y, uint16_t z, Alignment align, const Colorf& color, float clipX, float clipY)
+	void HUD::DrawElementClipped(GraphicResource* element, int32_t frame, float x, float y, uint16_t z, Alignment align, const Colorf& color, float clipX, float clipY)
 	{
-		auto it = _graphics->find(String::nullTerminatedView(name));
-		if (it == _graphics->end()) {
+		if (element == nullptr) {
 			return;
 		}
 
 		if (frame < 0) {
-			frame = it->second.FrameOffset + ((int32_t)(AnimTime * it->second.FrameCount / it->second.AnimDuration) % it->second.FrameCount);
+			frame = element->FrameOffset + ((int32_t)(AnimTime * element->FrameCount / element->AnimDuration) % element->FrameCount);
 		}
 
-		GenericGraphicResource* base = it->second.Base;
+		GenericGraphicResource* base = element->Base;
 		Vector2f size = Vector2f(base->FrameDimensions.X * clipX, base->FrameDimensions.Y * clipY);
 		Vector2f adjustedPos = ApplyAlignment(align, Vector2f(x - ViewSize.X * 0.5f - (1.0f - clipX) * 0.5f * base->FrameDimensions.X,
 			ViewSize.Y * 0.5f - y - (1.0f - clipY) * 0.5f * base->FrameDimensions.Y), size);
@@ -687,9 +743,9 @@ namespace Jazz2::UI
 		int32_t row = frame / base->FrameConfiguration.X;
 		Vector4f texCoords = Vector4f(
 			float(base->FrameDimensions.X) / float(texSize.X),
-			float(base->FrameDimensions.X * col) / float(texSize.X),
+			float(base->TextureOffset.X + base->FrameDimensions.X * col) / float(texSize.X),
 			float(base->FrameDimensions.Y) / float(texSize.Y),
-			float(base->FrameDimensions.Y * row) / float(texSize.Y)
+			float(base->TextureOffset.Y + base->FrameDimensions.Y * row) / float(texSize.Y)
 		);
 
 		texCoords.X *= clipX;
@@ -701,12 +757,12 @@ namespace Jazz2::UI
 		DrawTexture(*base->TextureDiffuse.get(), adjustedPos, z, size, texCoords, color);
 	}
 
-	StringView HUD::GetCurrentWeapon(Actors::Player* player, WeaponType weapon, Vector2f& offset)
+	GraphicResource* HUD::GetCurrentWeapon(Actors::Player* player, WeaponType weapon, Vector2f& offset)
 	{
 		if (weapon == WeaponType::Toaster && player->_inWater) {
 			offset.X += 1;
 			offset.Y += 2;
-			return "WeaponToasterDisabled"_s;
+			return _toasterDisabledIcon;
 		} else if (weapon == WeaponType::Seeker) {
 			offset.X += 2;
 		} else if (weapon == WeaponType::TNT) {
@@ -715,51 +771,16 @@ namespace Jazz2::UI
 			offset.X += 6;
 		}
 
-		if ((player->_weaponUpgrades[(int32_t)weapon] & 0x01) != 0) {
-			switch (weapon) {
-				default:
-				case WeaponType::Blaster:
-					if (player->_playerType == PlayerType::Spaz) {
-						return "WeaponPowerUpBlasterSpaz"_s;
-					} else if (player->_playerType == PlayerType::Lori) {
-						return "WeaponPowerUpBlasterLori"_s;
-					} else {
-						return "WeaponPowerUpBlasterJazz"_s;
-					}
-
-				case WeaponType::Bouncer: return "WeaponPowerUpBouncer"_s;
-				case WeaponType::Freezer: return "WeaponPowerUpFreezer"_s;
-				case WeaponType::Seeker: return "WeaponPowerUpSeeker"_s;
-				case WeaponType::RF: return "WeaponPowerUpRF"_s;
-				case WeaponType::Toaster: return "WeaponPowerUpToaster"_s;
-				case WeaponType::TNT: return "WeaponPowerUpTNT"_s;
-				case WeaponType::Pepper: return "WeaponPowerUpPepper"_s;
-				case WeaponType::Electro: return "WeaponPowerUpElectro"_s;
-				case WeaponType::Thunderbolt: return "WeaponPowerUpThunderbolt"_s;
-			}
-		} else {
-			switch (weapon) {
-				default:
-				case WeaponType::Blaster:
-					if (player->_playerType == PlayerType::Spaz) {
-						return "WeaponBlasterSpaz"_s;
-					} else if (player->_playerType == PlayerType::Lori) {
-						return "WeaponBlasterLori"_s;
-					} else {
-						return "WeaponBlasterJazz"_s;
-					}
-
-				case WeaponType::Bouncer: return "WeaponBouncer"_s;
-				case WeaponType::Freezer: return "WeaponFreezer"_s;
-				case WeaponType::Seeker: return "WeaponSeeker"_s;
-				case WeaponType::RF: return "WeaponRF"_s;
-				case WeaponType::Toaster: return "WeaponToaster"_s;
-				case WeaponType::TNT: return "WeaponTNT"_s;
-				case WeaponType::Pepper: return "WeaponPepper"_s;
-				case WeaponType::Electro: return "WeaponElectro"_s;
-				case WeaponType::Thunderbolt: return "WeaponThunderbolt"_s;
+		int32_t poweredUp = ((player->_weaponUpgrades[(int32_t)weapon] & 0x01) != 0 ? 1 : 0);
+		if (weapon == WeaponType::Blaster || weapon >= WeaponType::Count) {
+			switch (player->_playerType) {
+				default: return _blasterIcons[poweredUp][0];
+				case PlayerType::Spaz: return _blasterIcons[poweredUp][1];
+				case PlayerType::Lori: return _blasterIcons[poweredUp][2];
 			}
 		}
+
+		return _weaponIcons[poweredUp][(int32_t)weapon];
 	}
 
 	void HUD::DrawWeaponWheel(Actors::Player* player)
@@ -768,12 +789,11 @@ namespace Jazz2::UI
 			return;
 		}
 
-		auto it = _graphics->find(String::nullTerminatedView("WeaponWheel"_s));
-		if (it == _graphics->end()) {
+		if (_weaponWheel == nullptr) {
 			return;
 		}
 
-		Texture& lineTexture = *it->second.Base->TextureDiffuse.get();
+		GenericGraphicResource* lineTexture = _weaponWheel->Base;
 
 		if (!_levelHandler->_playerFrozenEnabled) {
 			_levelHandler->_playerFrozenEnabled = true;
@@ -794,9 +814,8 @@ namespace Jazz2::UI
 			v = 0.0f;
 		}
 
-		if (_weaponWheelVertices == nullptr) {
-			_weaponWheelVertices = std::make_unique<Vertex[]>(WeaponWheelMaxVertices);
-		}
+		// Vertices are needed only until the render queue is drawn, so they are allocated in the scratch arena every frame
+		_weaponWheelVertices = theApplication().scratchArena().allocateArray<Vertex>(WeaponWheelMaxVertices);
 		_weaponWheelVerticesCount = 0;
 		_weaponWheelRenderCommandsCount = 0;
 
@@ -827,7 +846,7 @@ namespace Jazz2::UI
 
 		float alphaInner = std::min(Vector2f(h, v).Length() * easing * 1.5f - 0.6f, 1.0f);
 		if (alphaInner > 0.0f) {
-			DrawElement("WeaponWheelInner"_s, -1, center.X, center.Y, MainLayer + 5, Alignment::Center, Colorf(1.0f, 1.0f, 1.0f, alphaInner), easing, easing, true, -requestedAngle);
+			DrawElement(_weaponWheelInner, -1, center.X, center.Y, MainLayer + 5, Alignment::Center, Colorf(1.0f, 1.0f, 1.0f, alphaInner), easing, easing, true, -requestedAngle);
 		}
 
 		float angle = -fPiOver2;
@@ -837,7 +856,7 @@ namespace Jazz2::UI
 				float y = sinf(angle) * distance;
 
 				Vector2f pos = Vector2f(center.X + x, center.Y + y);
-				StringView weapon = GetCurrentWeapon(player, (WeaponType)i, pos);
+				GraphicResource* weapon = GetCurrentWeapon(player, (WeaponType)i, pos);
 				Colorf color2;
 				float scale;
 				bool isSelected = (j == requestedIndex);
@@ -850,7 +869,7 @@ namespace Jazz2::UI
 					scale = 0.9f;
 				}
 
-				DrawElement("WeaponWheelDim"_s, -1, pos.X, pos.Y, ShadowLayer - 10, Alignment::Center, Colorf(0.0f, 0.0f, 0.0f, alpha * 0.6f), 5.0f, 5.0f);
+				DrawElement(_weaponWheelDim, -1, pos.X, pos.Y, ShadowLayer - 10, Alignment::Center, Colorf(0.0f, 0.0f, 0.0f, alpha * 0.6f), 5.0f, 5.0f);
 				DrawElement(weapon, -1, pos.X, pos.Y, MainLayer + 10, Alignment::Center, Colorf(1.0f, 1.0f, 1.0f, isSelected ? alpha : alpha * 0.7f), scale, scale);
 
 				if (PreferencesCache::WeaponWheel == WeaponWheelStyle::EnabledWithAmmoCount) {
@@ -943,7 +962,7 @@ namespace Jazz2::UI
 		return weaponCount;
 	}
 
-	void HUD::DrawWeaponWheelSegment(float x, float y, float width, float height, uint16_t z, float minAngle, float maxAngle, const Texture& texture, const Colorf& color)
+	void HUD::DrawWeaponWheelSegment(float x, float y, float width, float height, uint16_t z, float minAngle, float maxAngle, const GenericGraphicResource* texture, const Colorf& color)
 	{
 		width *= 0.5f; x += width;
 		height *= 0.5f; y += height;
@@ -1020,14 +1039,16 @@ namespace Jazz2::UI
 
 		command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-		auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-		instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(1.0f, 0.0f, 1.0f, 0.0f);
-		instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(1.0f, 1.0f);
-		instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(color.Data());
+		Vector2i texSize = texture->TextureDiffuse->size();
+		Vector2i sheetSize = texture->FrameDimensions * texture->FrameConfiguration;
+		command->material().setInstanceTexRect(float(sheetSize.X) / float(texSize.X), float(texture->TextureOffset.X) / float(texSize.X),
+			float(sheetSize.Y) / float(texSize.Y), float(texture->TextureOffset.Y) / float(texSize.Y));
+		command->material().setInstanceSpriteSize(1.0f, 1.0f);
+		command->material().setInstanceColor(color.Data());
 
 		command->setTransformation(Matrix4x4f::Identity);
 		command->setLayer(z);
-		command->material().setTexture(texture);
+		command->material().setTexture(*texture->TextureDiffuse);
 
 		DrawRenderCommand(command);
 	}
@@ -1041,12 +1062,7 @@ namespace Jazz2::UI
 		info.Width = w * LevelHandler::DefaultWidth * 0.5f;
 		info.Height = h * LevelHandler::DefaultWidth * 0.5f;
 
-		if (!identifier.empty()) {
-			auto it = _graphics->find(String::nullTerminatedView(identifier));
-			info.Graphics = (it != _graphics->end() ? &it->second : nullptr);
-		} else {
-			info.Graphics = nullptr;
-		}
+		info.Graphics = (!identifier.empty() ? ResolveElement(identifier) : nullptr);
 
 		info.CurrentPointerId = -1;
 		info.Align = align;
@@ -82,7 +82,19 @@ namespace Jazz2::UI
 		static constexpr int32_t WeaponWheelMaxVertices = 512;
 		
 		LevelHandler* _levelHandler;
-		HashMap<String, GraphicResource>* _graphics;
+		HashMap<Atom, GraphicResource>* _graphics;
+		GraphicResource* _characterIcons[4];
+		GraphicResource* _foodIcon;
+		GraphicResource* _heartIcon;
+		GraphicResource* _coinIcon;
+		GraphicResource* _gemIcon;
+		GraphicResource* _bossHealthBar;
+		GraphicResource* _weaponWheel;
+		GraphicResource* _weaponWheelInner;
+		GraphicResource* _weaponWheelDim;
+		GraphicResource* _weaponIcons[2][(int32_t)WeaponType::Count];
+		GraphicResource* _blasterIcons[2][3];
+		GraphicResource* _toasterDisabledIcon;
 		std::shared_ptr<Actors::Player> _attachedPlayer;
 		Font* _smallFont;
 
@@ -101,7 +113,7 @@ namespace Jazz2::UI
 		bool _weaponWheelShown;
 		SmallVector<std::unique_ptr<RenderCommand>, 0> _weaponWheelRenderCommands;
 		int32_t  _weaponWheelRenderCommandsCount;
-		std::unique_ptr<Vertex[]> _weaponWheelVertices;
+		Vertex* _weaponWheelVertices;
 		int32_t _weaponWheelVerticesCount;
 		int32_t _lastWeaponWheelIndex;
 		float _rgbLightsTime;
@@ -115,14 +127,16 @@ namespace Jazz2::UI
 		void DrawCoins(int32_t& charOffset);
 		void DrawGems(int32_t& charOffset);
 
-		void DrawElement(const StringView& name, int32_t frame, float x, float y, uint16_t z, Alignment align, const Colorf& color, float scaleX = 1.0f, float scaleY = 1.0f, bool additiveBlending = false, float angle = 0.0f);
-		void DrawElementClipped(const StringView& name, int32_t frame, float x, float y, uint16_t z, Alignment align, const Colorf& color, float clipX, float clipY);
-		StringView GetCurrentWeapon(Actors::Player* player, WeaponType weapon, Vector2f& offset);
+		/// Resolves graphics of the element, so it doesn't have to be looked up by name every frame
+		GraphicResource* ResolveElement(const StringView& name);
+		void DrawElement(GraphicResource* element, int32_t frame, float x, float y, uint16_t z, Alignment align, const Colorf& color, float scaleX = 1.0f, float scaleY = 1.0f, bool additiveBlending = false, float angle = 0.0f);
+		void DrawElementClipped(GraphicResource* element, int32_t frame, float x, float y, uint16_t z, Alignment align, const Colorf& color, float clipX, float clipY);
+		GraphicResource* GetCurrentWeapon(Actors::Player* player, WeaponType weapon, Vector2f& offset);
 
 		void DrawWeaponWheel(Actors::Player* player);
 		bool PrepareWeaponWheel(Actors::Player* player, int& weaponCount);
 		static int32_t GetWeaponCount(Actors::Player* player);
-		void DrawWeaponWheelSegment(float x, float y, float width, float height, uint16_t z, float minAngle, float maxAngle, const Texture& texture, const Colorf& color);
+		void DrawWeaponWheelSegment(float x, float y, float width, float height, uint16_t z, float minAngle, float maxAngle, const GenericGraphicResource* texture, const Colorf& color);
 
 		TouchButtonInfo CreateTouchButton(PlayerActions action, const StringView& identifier, Alignment align, float x, float y, float w, float h);
 		bool IsOnButton(const TouchButtonInfo& button, float x, float y);
@@ -109,7 +109,7 @@ namespace Jazz2::UI::Menu
 		Vector2f pos = Vector2f(viewSize.X * 0.5f, viewSize.Y * 0.5f);
 		pos.Y = std::round(std::max(150.0f, pos.Y * 0.86f));
 
-		_root->DrawElement("MenuDim"_s, pos.X, pos.Y + 24.0f - 2.0f, IMenuContainer::BackgroundLayer,
+		_root->DrawElement(MenuElement::Dim, pos.X, pos.Y + 24.0f - 2.0f, IMenuContainer::BackgroundLayer,
 			Alignment::Top, Colorf::Black, Vector2f(680.0f, 200.0f), Vector4f(1.0f, 0.0f, 0.7f, 0.0f));
 
 		pos.X = std::round(pos.X * 0.35f);
@@ -135,7 +135,7 @@ namespace Jazz2::UI::Menu
 		_root->DrawStringShadow(_f("This project uses modified \f[c:0x9e7056]nCine\f[c] game engine and following libraries:\n%s", ADDITIONAL_INFO), charOffset, viewSize.X * 0.5f, pos.Y + 54.0f + pos.Y * 0.4f, IMenuContainer::FontLayer,
 			Alignment::Top, Font::DefaultColor, 0.76f, 0.4f, 0.6f, 0.6f, 0.6f, 0.9f, 1.2f);
 
-		_root->DrawElement("MenuLine"_s, 0, viewSize.X * 0.5f, pos.Y + 24.0f, IMenuContainer::MainLayer, Alignment::Center, Colorf::White, 1.6f);
+		_root->DrawElement(MenuElement::Line, 0, viewSize.X * 0.5f, pos.Y + 24.0f, IMenuContainer::MainLayer, Alignment::Center, Colorf::White, 1.6f);
 
 		pos.Y = viewSize.Y - 100.0f;
 	}
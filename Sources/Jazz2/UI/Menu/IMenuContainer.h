@@ -21,6 +21,17 @@ namespace Jazz2::UI::Menu
 
 	DEFINE_ENUM_OPERATORS(ChangedPreferencesType);
 
+	/// Frequently drawn menu elements, resolved only once when the menu metadata is loaded
+	enum class MenuElement {
+		Line,
+		LineArrow,
+		Glow,
+		Dim,
+		Carrot,
+
+		Count
+	};
+
 	class IMenuContainer
 	{
 	public:
@@ -50,6 +61,10 @@ namespace Jazz2::UI::Menu
 			const Colorf& color, float scaleX = 1.0f, float scaleY = 1.0f, bool additiveBlending = false) = 0;
 		virtual void DrawElement(const StringView& name, float x, float y, uint16_t z, Alignment align,
 			const Colorf& color, const Vector2f& size, const Vector4f& texCoords) = 0;
+		virtual void DrawElement(MenuElement element, int32_t frame, float x, float y, uint16_t z, Alignment align,
+			const Colorf& color, float scaleX = 1.0f, float scaleY = 1.0f, bool additiveBlending = false) = 0;
+		virtual void DrawElement(MenuElement element, float x, float y, uint16_t z, Alignment align,
+			const Colorf& color, const Vector2f& size, const Vector4f& texCoords) = 0;
 		virtual void DrawSolid(float x, float y, uint16_t z, Alignment align, const Vector2f& size, const Colorf& color, bool additiveBlending = false) = 0;
 		virtual Vector2f MeasureString(const StringView& text, float scale = 1.0f, float charSpacing = 1.0f, float lineSpacing = 1.0f) = 0;
 		virtual void DrawStringShadow(const StringView& text, int32_t& charOffset, float x, float y, uint16_t z, Alignment align,
@@ -14,7 +14,7 @@
 namespace Jazz2::UI::Menu
 {
 	InGameMenu::InGameMenu(LevelHandler* root)
-		: _root(root), _pressedActions(0), _touchButtonsTimer(0.0f)
+		: _root(root), _graphics(nullptr), _pressedActions(0), _touchButtonsTimer(0.0f)
 	{
 		_canvasBackground = std::make_unique<MenuBackgroundCanvas>(this);
 		_canvasClipped = std::make_unique<MenuClippedCanvas>(this);
@@ -32,6 +32,8 @@ namespace Jazz2::UI::Menu
 			_sounds = &metadata->Sounds;
 		}
 
+		ResolveElements();
+
 		_smallFont = resolver.GetFont(FontType::Small);
 		_mediumFont = resolver.GetFont(FontType::Medium);
 
@@ -121,12 +123,12 @@ namespace Jazz2::UI::Menu
 		}
 
 		if (_owner->_touchButtonsTimer > 0.0f && _owner->_sections.size() >= 2) {
-			_owner->DrawElement("MenuLineArrow"_s, -1, static_cast<float>(center.X), 40.0f, ShadowLayer, Alignment::Center, Colorf::White);
+			_owner->DrawElement(MenuElement::LineArrow, -1, static_cast<float>(center.X), 40.0f, ShadowLayer, Alignment::Center, Colorf::White);
 		}
 
 		// Title
-		_owner->DrawElement("MenuCarrot"_s, -1, center.X - 76.0f * logoTranslateX, 64.0f + logoTranslateY + 2.0f, ShadowLayer + 200, Alignment::Center, Colorf(0.0f, 0.0f, 0.0f, 0.3f), 0.8f * logoScale, 0.8f * logoScale);
-		_owner->DrawElement("MenuCarrot"_s, -1, center.X - 76.0f * logoTranslateX, 64.0f + logoTranslateY, MainLayer + 200, Alignment::Center, Colorf::White, 0.8f * logoScale, 0.8f * logoScale);
+		_owner->DrawElement(MenuElement::Carrot, -1, center.X - 76.0f * logoTranslateX, 64.0f + logoTranslateY + 2.0f, ShadowLayer + 200, Alignment::Center, Colorf(0.0f, 0.0f, 0.0f, 0.3f), 0.8f * logoScale, 0.8f * logoScale);
+		_owner->DrawElement(MenuElement::Carrot, -1, center.X - 76.0f * logoTranslateX, 64.0f + logoTranslateY, MainLayer + 200, Alignment::Center, Colorf::White, 0.8f * logoScale, 0.8f * logoScale);
 
 		_owner->_mediumFont->DrawString(this, "Jazz"_s, charOffsetShadow, center.X - 63.0f, 70.0f + logoTranslateY + 2.0f, FontShadowLayer + 200,
 			Alignment::Left, Colorf(0.0f, 0.0f, 0.0f, 0.32f), 0.75f * logoTextScale, 1.65f, 3.0f, 3.0f, 0.0f, 0.92f);
@@ -262,17 +264,62 @@ namespace Jazz2::UI::Menu
 
 	void InGameMenu::DrawElement(const StringView& name, int32_t frame, float x, float y, uint16_t z, Alignment align, const Colorf& color, float scaleX, float scaleY, bool additiveBlending)
 	{
-		auto it = _graphics->find(String::nullTerminatedView(name));
-		if (it == _graphics->end()) {
-			return;
+		auto it = _graphics->find(Atom::find(name));
+		if (it != _graphics->end()) {
+			DrawElement(&it->second, frame, x, y, z, align, color, scaleX, scaleY, additiveBlending);
+		}
+	}
+
+	void InGameMenu::DrawElement(const StringView& name, float x, float y, uint16_t z, Alignment align, const Colorf& color, const Vector2f& size, const Vector4f& texCoords)
+	{
+		auto it = _graphics->find(Atom::find(name));
+		if (it != _graphics->end()) {
+			DrawElement(&it->second, x, y, z, align, color, size, texCoords);
+		}
+	}
+
+	void InGameMenu::DrawElement(MenuElement element, int32_t frame, float x, float y, uint16_t z, Alignment align, const Colorf& color, float scaleX, float scaleY, bool additiveBlending)
+	{
+		GraphicResource* res = _elements[(int32_t)element];
+		if (res != nullptr) {
+			DrawElement(res, frame, x, y, z, align, color, scaleX, scaleY, additiveBlending);
+		}
+	}
+
+	void InGameMenu::DrawElement(MenuElement element, float x, float y, uint16_t z, Alignment align, const Colorf& color, const Vector2f& size, const Vector4f& texCoords)
+	{
+		GraphicResource* res = _elements[(int32_t)element];
+		if (res != nullptr) {
+			DrawElement(res, x, y, z, align, color, size, texCoords);
 		}
+	}
 
+	void InGameMenu::ResolveElements()
+	{
+		static const StringView ElementNames[] = {
+			"MenuLine"_s, "MenuLineArrow"_s, "MenuGlow"_s, "MenuDim"_s, "MenuCarrot"_s
+		};
+		static_assert(countof(ElementNames) == (int32_t)MenuElement::Count, "ElementNames must match MenuElement");
+
+		for (int32_t i = 0; i < (int32_t)MenuElement::Count; i++) {
+			_elements[i] = nullptr;
+			if (_graphics != nullptr) {
+				auto it = _graphics->find(Atom::find(ElementNames[i]));
+				if (it != _graphics->end()) {
+					_elements[i] = &it->second;
+				}
+			}
+		}
+	}
+
+	void InGameMenu::DrawElement(GraphicResource* res, int32_t frame, float x, float y, uint16_t z, Alignment align, const Colorf& color, float scaleX, float scaleY, bool additiveBlending)
+	{
 		if (frame < 0) {
-			frame = it->second.FrameOffset + ((int32_t)(_canvasBackground->AnimTime * it->second.FrameCount / it->second.AnimDuration) % it->second.FrameCount);
+			frame = res->FrameOffset + ((int32_t)(_canvasBackground->AnimTime * res->FrameCount / res->AnimDuration) % res->FrameCount);
 		}
 
 		Canvas* currentCanvas = GetActiveCanvas();
-		GenericGraphicResource* base = it->second.Base;
+		GenericGraphicResource* base = res->Base;
 		Vector2f size = Vector2f(base->FrameDimensions.X * scaleX, base->FrameDimensions.Y * scaleY);
 		Vector2f adjustedPos = Canvas::ApplyAlignment(align, Vector2f(x - currentCanvas->ViewSize.X * 0.5f, currentCanvas->ViewSize.Y * 0.5f - y), size);
 
@@ -281,9 +328,9 @@ namespace Jazz2::UI::Menu
 		int32_t row = frame / base->FrameConfiguration.X;
 		Vector4f texCoords = Vector4f(
 			float(base->FrameDimensions.X) / float(texSize.X),
-			float(base->FrameDimensions.X * col) / float(texSize.X),
+			float(base->TextureOffset.X + base->FrameDimensions.X * col) / float(texSize.X),
 			float(base->FrameDimensions.Y) / float(texSize.Y),
-			float(base->FrameDimensions.Y * row) / float(texSize.Y)
+			float(base->TextureOffset.Y + base->FrameDimensions.Y * row) / float(texSize.Y)
 		);
 
 		texCoords.W += texCoords.Z;
@@ -292,15 +339,10 @@ namespace Jazz2::UI::Menu
 		currentCanvas->DrawTexture(*base->TextureDiffuse.get(), adjustedPos, z, size, texCoords, color, additiveBlending);
 	}
 
-	void InGameMenu::DrawElement(const StringView& name, float x, float y, uint16_t z, Alignment align, const Colorf& color, const Vector2f& size, const Vector4f& texCoords)
+	void InGameMenu::DrawElement(GraphicResource* res, float x, float y, uint16_t z, Alignment align, const Colorf& color, const Vector2f& size, const Vector4f& texCoords)
 	{
-		auto it = _graphics->find(String::nullTerminatedView(name));
-		if (it == _graphics->end()) {
-			return;
-		}
-
 		Canvas* currentCanvas = GetActiveCanvas();
-		GenericGraphicResource* base = it->second.Base;
+		GenericGraphicResource* base = res->Base;
 		Vector2f adjustedPos = Canvas::ApplyAlignment(align, Vector2f(x - currentCanvas->ViewSize.X * 0.5f, currentCanvas->ViewSize.Y * 0.5f - y), size);
 
 		currentCanvas->DrawTexture(*base->TextureDiffuse.get(), adjustedPos, z, size, texCoords, color, false);
@@ -332,7 +374,7 @@ namespace Jazz2::UI::Menu
 
 	void InGameMenu::PlaySfx(const StringView& identifier, float gain)
 	{
-		auto it = _sounds->find(String::nullTerminatedView(identifier));
+		auto it = _sounds->find(Atom::find(identifier));
 		if (it != _sounds->end()) {
 			int32_t idx = (it->second.Buffers.size() > 1 ? Random().Next(0, (int32_t)it->second.Buffers.size()) : 0);
 			auto& player = _playingSounds.emplace_back(std::make_shared<AudioBufferPlayer>(it->second.Buffers[idx].get()));
@@ -42,6 +42,10 @@ namespace Jazz2::UI::Menu
 			float scaleX = 1.0f, float scaleY = 1.0f, bool additiveBlending = false) override;
 		void DrawElement(const StringView& name, float x, float y, uint16_t z, Alignment align, const Colorf& color,
 			const Vector2f& size, const Vector4f& texCoords) override;
+		void DrawElement(MenuElement element, int32_t frame, float x, float y, uint16_t z, Alignment align, const Colorf& color,
+			float scaleX = 1.0f, float scaleY = 1.0f, bool additiveBlending = false) override;
+		void DrawElement(MenuElement element, float x, float y, uint16_t z, Alignment align, const Colorf& color,
+			const Vector2f& size, const Vector4f& texCoords) override;
 		void DrawSolid(float x, float y, uint16_t z, Alignment align, const Vector2f& size, const Colorf& color, bool additiveBlending = false) override;
 		Vector2f MeasureString(const StringView& text, float scale = 1.0f, float charSpacing = 1.0f, float lineSpacing = 1.0f) override;
 		void DrawStringShadow(const StringView& text, int32_t& charOffset, float x, float y, uint16_t z, Alignment align, const Colorf& color,
@@ -99,11 +103,12 @@ namespace Jazz2::UI::Menu
 		std::unique_ptr<MenuClippedCanvas> _canvasClipped;
 		std::unique_ptr<MenuOverlayCanvas> _canvasOverlay;
 		ActiveCanvas _activeCanvas;
-		HashMap<String, GraphicResource>* _graphics;
+		HashMap<Atom, GraphicResource>* _graphics;
+		GraphicResource* _elements[(int32_t)MenuElement::Count];
 		Font* _smallFont;
 		Font* _mediumFont;
 
-		HashMap<String, SoundResource>* _sounds;
+		HashMap<Atom, SoundResource>* _sounds;
 		SmallVector<std::shared_ptr<AudioBufferPlayer>> _playingSounds;
 
 		SmallVector<std::unique_ptr<MenuSection>, 8> _sections;
@@ -111,6 +116,11 @@ namespace Jazz2::UI::Menu
 		float _touchButtonsTimer;
 
 		void UpdatePressedActions();
+		void ResolveElements();
+		void DrawElement(GraphicResource* res, int32_t frame, float x, float y, uint16_t z, Alignment align, const Colorf& color,
+			float scaleX, float scaleY, bool additiveBlending);
+		void DrawElement(GraphicResource* res, float x, float y, uint16_t z, Alignment align, const Colorf& color,
+			const Vector2f& size, const Vector4f& texCoords);
 
 		inline Canvas* GetActiveCanvas()
 		{
@@ -9,11 +9,12 @@
 #include "../../../nCine/Input/IInputManager.h"
 #include "../../../nCine/Audio/AudioReaderMpt.h"
 #include "../../../nCine/Base/Random.h"
+#include "../../../nCine/Base/ScratchArena.h"
 
 namespace Jazz2::UI::Menu
 {
 	MainMenu::MainMenu(IRootController* root, bool afterIntro)
-		: _root(root), _activeCanvas(ActiveCanvas::Background), _transitionWhite(afterIntro ? 1.0f : 0.0f),
+		: _root(root), _activeCanvas(ActiveCanvas::Background), _graphics(nullptr), _transitionWhite(afterIntro ? 1.0f : 0.0f),
 			_logoTransition(0.0f), _texturedBackgroundPass(this), _texturedBackgroundPhase(0.0f),
 			_pressedKeys((uint32_t)KeySym::COUNT), _pressedActions(0), _touchButtonsTimer(0.0f)
 	{
@@ -36,6 +37,8 @@ namespace Jazz2::UI::Menu
 			_sounds = &metadata->Sounds;
 		}
 
+		ResolveElements();
+
 		_smallFont = resolver.GetFont(FontType::Small);
 		_mediumFont = resolver.GetFont(FontType::Medium);
 
@@ -187,12 +190,12 @@ namespace Jazz2::UI::Menu
 		float logoTextTranslate = (1.0f - _owner->_logoTransition) * 60.0f;
 
 		if (_owner->_touchButtonsTimer > 0.0f && _owner->_sections.size() >= 2) {
-			_owner->DrawElement("MenuLineArrow"_s, -1, static_cast<float>(center.X), 40.0f, ShadowLayer, Alignment::Center, Colorf::White);
+			_owner->DrawElement(MenuElement::LineArrow, -1, static_cast<float>(center.X), 40.0f, ShadowLayer, Alignment::Center, Colorf::White);
 		}
 
 		// Title
-		_owner->DrawElement("MenuCarrot"_s, -1, center.X - 76.0f * logoTranslateX, 64.0f + logoTranslateY + 2.0f, ShadowLayer + 200, Alignment::Center, Colorf(0.0f, 0.0f, 0.0f, 0.3f), 0.8f * logoScale, 0.8f * logoScale);
-		_owner->DrawElement("MenuCarrot"_s, -1, center.X - 76.0f * logoTranslateX, 64.0f + logoTranslateY, MainLayer + 200, Alignment::Center, Colorf::White, 0.8f * logoScale, 0.8f * logoScale);
+		_owner->DrawElement(MenuElement::Carrot, -1, center.X - 76.0f * logoTranslateX, 64.0f + logoTranslateY + 2.0f, ShadowLayer + 200, Alignment::Center, Colorf(0.0f, 0.0f, 0.0f, 0.3f), 0.8f * logoScale, 0.8f * logoScale);
+		_owner->DrawElement(MenuElement::Carrot, -1, center.X - 76.0f * logoTranslateX, 64.0f + logoTranslateY, MainLayer + 200, Alignment::Center, Colorf::White, 0.8f * logoScale, 0.8f * logoScale);
 
 		_owner->_mediumFont->DrawString(this, "Jazz"_s, charOffsetShadow, center.X - 63.0f, 70.0f + logoTranslateY + 2.0f, FontShadowLayer + 200,
 			Alignment::Left, Colorf(0.0f, 0.0f, 0.0f, 0.32f), 0.75f * logoTextScale, 1.65f, 3.0f, 3.0f, 0.0f, 0.92f);
@@ -215,7 +218,10 @@ namespace Jazz2::UI::Menu
 
 		const char* newestVersion = _owner->_root->GetNewestVersion();
 		if (newestVersion != nullptr && std::strcmp(newestVersion, NCINE_VERSION) != 0) {
-			String newerVersion = StringView("v" NCINE_VERSION "  › \f[c:0x9e7056]v") + newestVersion;
+			// It's drawn every frame and it's too long to fit into a small string, so it's built in the scratch arena
+			ScratchString newerVersion(theApplication().scratchArena());
+			newerVersion += StringView("v" NCINE_VERSION "  › \f[c:0x9e7056]v");
+			newerVersion += newestVersion;
 			_owner->DrawStringShadow(newerVersion, charOffset, bottomRight.X, bottomRight.Y, IMenuContainer::FontLayer,
 				Alignment::BottomRight, Font::DefaultColor, 0.7f, 0.4f, 1.2f, 1.2f, 0.46f, 0.8f);
 		} else {
@@ -351,17 +357,62 @@ namespace Jazz2::UI::Menu
 
 	void MainMenu::DrawElement(const StringView& name, int32_t frame, float x, float y, uint16_t z, Alignment align, const Colorf& color, float scaleX, float scaleY, bool additiveBlending)
 	{
-		auto it = _graphics->find(String::nullTerminatedView(name));
-		if (it == _graphics->end()) {
-			return;
+		auto it = _graphics->find(Atom::find(name));
+		if (it != _graphics->end()) {
+			DrawElement(&it->second, frame, x, y, z, align, color, scaleX, scaleY, additiveBlending);
+		}
+	}
+
+	void MainMenu::DrawElement(const StringView& name, float x, float y, uint16_t z, Alignment align, const Colorf& color, const Vector2f& size, const Vector4f& texCoords)
+	{
+		auto it = _graphics->find(Atom::find(name));
+		if (it != _graphics->end()) {
+			DrawElement(&it->second, x, y, z, align, color, size, texCoords);
 		}
+	}
 
+	void MainMenu::DrawElement(MenuElement element, int32_t frame, float x, float y, uint16_t z, Alignment align, const Colorf& color, float scaleX, float scaleY, bool additiveBlending)
+	{
+		GraphicResource* res = _elements[(int32_t)element];
+		if (res != nullptr) {
+			DrawElement(res, frame, x, y, z, align, color, scaleX, scaleY, additiveBlending);
+		}
+	}
+
+	void MainMenu::DrawElement(MenuElement element, float x, float y, uint16_t z, Alignment align, const Colorf& color, const Vector2f& size, const Vector4f& texCoords)
+	{
+		GraphicResource* res = _elements[(int32_t)element];
+		if (res != nullptr) {
+			DrawElement(res, x, y, z, align, color, size, texCoords);
+		}
+	}
+
+	void MainMenu::ResolveElements()
+	{
+		static const StringView ElementNames[] = {
+			"MenuLine"_s, "MenuLineArrow"_s, "MenuGlow"_s, "MenuDim"_s, "MenuCarrot"_s
+		};
+		static_assert(countof(ElementNames) == (int32_t)MenuElement::Count, "ElementNames must match MenuElement");
+
+		for (int32_t i = 0; i < (int32_t)MenuElement::Count; i++) {
+			_elements[i] = nullptr;
+			if (_graphics != nullptr) {
+				auto it = _graphics->find(Atom::find(ElementNames[i]));
+				if (it != _graphics->end()) {
+					_elements[i] = &it->second;
+				}
+			}
+		}
+	}
+
+	void MainMenu::DrawElement(GraphicResource* res, int32_t frame, float x, float y, uint16_t z, Alignment align, const Colorf& color, float scaleX, float scaleY, bool additiveBlending)
+	{
 		if (frame < 0) {
-			frame = it->second.FrameOffset + ((int32_t)(_canvasBackground->AnimTime * it->second.FrameCount / it->second.AnimDuration) % it->second.FrameCount);
+			frame = res->FrameOffset + ((int32_t)(_canvasBackground->AnimTime * res->FrameCount / res->AnimDuration) % res->FrameCount);
 		}
 
 		Canvas* currentCanvas = GetActiveCanvas();
-		GenericGraphicResource* base = it->second.Base;
+		GenericGraphicResource* base = res->Base;
 		Vector2f size = Vector2f(base->FrameDimensions.X * scaleX, base->FrameDimensions.Y * scaleY);
 		Vector2f adjustedPos = Canvas::ApplyAlignment(align, Vector2f(x - currentCanvas->ViewSize.X * 0.5f, currentCanvas->ViewSize.Y * 0.5f - y), size);
 
@@ -370,9 +421,9 @@ namespace Jazz2::UI::Menu
 		int32_t row = frame / base->FrameConfiguration.X;
 		Vector4f texCoords = Vector4f(
 			float(base->FrameDimensions.X) / float(texSize.X),
-			float(base->FrameDimensions.X * col) / float(texSize.X),
+			float(base->TextureOffset.X + base->FrameDimensions.X * col) / float(texSize.X),
 			float(base->FrameDimensions.Y) / float(texSize.Y),
-			float(base->FrameDimensions.Y * row) / float(texSize.Y)
+			float(base->TextureOffset.Y + base->FrameDimensions.Y * row) / float(texSize.Y)
 		);
 
 		texCoords.W += texCoords.Z;
@@ -381,15 +432,10 @@ namespace Jazz2::UI::Menu
 		currentCanvas->DrawTexture(*base->TextureDiffuse.get(), adjustedPos, z, size, texCoords, color, additiveBlending);
 	}
 
-	void MainMenu::DrawElement(const StringView& name, float x, float y, uint16_t z, Alignment align, const Colorf& color, const Vector2f& size, const Vector4f& texCoords)
+	void MainMenu::DrawElement(GraphicResource* res, float x, float y, uint16_t z, Alignment align, const Colorf& color, const Vector2f& size, const Vector4f& texCoords)
 	{
-		auto it = _graphics->find(String::nullTerminatedView(name));
-		if (it == _graphics->end()) {
-			return;
-		}
-
 		Canvas* currentCanvas = GetActiveCanvas();
-		GenericGraphicResource* base = it->second.Base;
+		GenericGraphicResource* base = res->Base;
 		Vector2f adjustedPos = Canvas::ApplyAlignment(align, Vector2f(x - currentCanvas->ViewSize.X * 0.5f, currentCanvas->ViewSize.Y * 0.5f - y), size);
 
 		currentCanvas->DrawTexture(*base->TextureDiffuse.get(), adjustedPos, z, size, texCoords, color, false);
@@ -429,7 +475,7 @@ namespace Jazz2::UI::Menu
 
 	void MainMenu::PlaySfx(const StringView& identifier, float gain)
 	{
-		auto it = _sounds->find(String::nullTerminatedView(identifier));
+		auto it = _sounds->find(Atom::find(identifier));
 		if (it != _sounds->end()) {
 			int32_t idx = (it->second.Buffers.size() > 1 ? Random().Next(0, (int32_t)it->second.Buffers.size()) : 0);
 			auto& player = _playingSounds.emplace_back(std::make_shared<AudioBufferPlayer>(it->second.Buffers[idx].get()));
@@ -558,7 +604,7 @@ namespace Jazz2::UI::Menu
 				Vector2f debrisPos = Vector2f(Random().FastFloat(viewSize.X * -0.8f, viewSize.X * 0.8f),
 					Random().NextFloat(viewSize.Y * 0.5f, viewSize.Y * 1.0f));
 
-				auto it = _graphics->find(String::nullTerminatedView("Snow"_s));
+				auto it = _graphics->find("Snow"_atom);
 				if (it != _graphics->end()) {
 					auto& resBase = it->second.Base;
 					Vector2i texSize = resBase->TextureDiffuse->size();
@@ -587,9 +633,9 @@ namespace Jazz2::UI::Menu
 					int32_t col = curAnimFrame % resBase->FrameConfiguration.X;
 					int32_t row = curAnimFrame / resBase->FrameConfiguration.X;
 					debris.TexScaleX = (float(resBase->FrameDimensions.X) / float(texSize.X));
-					debris.TexBiasX = (float(resBase->FrameDimensions.X * col) / float(texSize.X));
+					debris.TexBiasX = (float(resBase->TextureOffset.X + resBase->FrameDimensions.X * col) / float(texSize.X));
 					debris.TexScaleY = (float(resBase->FrameDimensions.Y) / float(texSize.Y));
-					debris.TexBiasY = (float(resBase->FrameDimensions.Y * row) / float(texSize.Y));
+					debris.TexBiasY = (float(resBase->TextureOffset.Y + resBase->FrameDimensions.Y * row) / float(texSize.Y));
 
 					debris.DiffuseTexture = resBase->TextureDiffuse.get();
 
@@ -649,10 +695,9 @@ namespace Jazz2::UI::Menu
 
 			command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-			auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-			instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(debris.TexScaleX, debris.TexBiasX, debris.TexScaleY, debris.TexBiasY);
-			instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(debris.Size.X, debris.Size.Y);
-			instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf(1.0f, 1.0f, 1.0f, debris.Alpha).Data());
+			command->material().setInstanceTexRect(debris.TexScaleX, debris.TexBiasX, debris.TexScaleY, debris.TexBiasY);
+			command->material().setInstanceSpriteSize(debris.Size.X, debris.Size.Y);
+			command->material().setInstanceColor(Colorf(1.0f, 1.0f, 1.0f, debris.Alpha).Data());
 
 			Matrix4x4f worldMatrix = Matrix4x4f::Translation(debris.Pos.X, debris.Pos.Y, 0.0f);
 			worldMatrix.RotateZ(debris.Angle);
@@ -763,10 +808,9 @@ namespace Jazz2::UI::Menu
 		Vector2i viewSize = _canvasBackground->ViewSize;
 		auto command = &_texturedBackgroundPass._outputRenderCommand;
 
-		auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-		instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(1.0f, 0.0f, 1.0f, 0.0f);
-		instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(static_cast<float>(viewSize.X), static_cast<float>(viewSize.Y));
-		instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf(1.0f, 1.0f, 1.0f, 1.0f).Data());
+		command->material().setInstanceTexRect(1.0f, 0.0f, 1.0f, 0.0f);
+		command->material().setInstanceSpriteSize(static_cast<float>(viewSize.X), static_cast<float>(viewSize.Y));
+		command->material().setInstanceColor(Colorf(1.0f, 1.0f, 1.0f, 1.0f).Data());
 
 		command->material().uniform("uViewSize")->setFloatValue(static_cast<float>(viewSize.X), static_cast<float>(viewSize.Y));
 		command->material().uniform("uShift")->setFloatVector(_texturedBackgroundPos.Data());
@@ -803,7 +847,7 @@ namespace Jazz2::UI::Menu
 			_renderCommands.reserve(renderCommandCount);
 			for (int32_t i = 0; i < renderCommandCount; i++) {
 				std::unique_ptr<RenderCommand>& command = _renderCommands.emplace_back(std::make_unique<RenderCommand>());
-				command->material().setShaderProgramType(Material::ShaderProgramType::SPRITE);
+				command->material().setShader(ContentResolver::Get().GetShader(PrecompiledShader::Palette));
 				command->material().reserveUniformsDataMemory();
 				command->geometry().setDrawParameters(GL_TRIANGLE_STRIP, 0, 4);
 
@@ -811,6 +855,10 @@ namespace Jazz2::UI::Menu
 				if (textureUniform && textureUniform->intValue(0) != 0) {
 					textureUniform->setIntValue(0); // GL_TEXTURE0
 				}
+				GLUniformCache* paletteUniform = command->material().uniform(TileSet::PaletteUniformName);
+				if (paletteUniform && paletteUniform->intValue(0) != 1) {
+					paletteUniform->setIntValue(1); // GL_TEXTURE1
+				}
 			}
 
 			// Prepare output render command
@@ -855,13 +903,13 @@ namespace Jazz2::UI::Menu
 					texBiasY -= 0.5f / float(texSize.Y);
 				}
 
-				auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-				instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(texScaleX, texBiasX, texScaleY, texBiasY);
-				instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(TileSet::DefaultTileSize, TileSet::DefaultTileSize);
-				instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf::White.Data());
+				command->material().setInstanceTexRect(texScaleX, texBiasX, texScaleY, texBiasY);
+				command->material().setInstanceSpriteSize(TileSet::DefaultTileSize, TileSet::DefaultTileSize);
+				command->material().setInstanceColor(Colorf::White.Data());
 
 				command->setTransformation(Matrix4x4f::Translation(x * TileSet::DefaultTileSize + (TileSet::DefaultTileSize / 2), y * TileSet::DefaultTileSize + (TileSet::DefaultTileSize / 2), 0.0f));
-				command->material().setTexture(*_owner->_tileSet->TextureDiffuse);
+				command->material().setTexture(0, *_owner->_tileSet->TextureDiffuse);
+				command->material().setTexture(1, *_owner->_tileSet->TexturePalette);
 
 				renderQueue.addCommand(command);
 			}
@@ -20,15 +20,18 @@ namespace Jazz2::UI::Menu
 
 #if defined(WITH_THREADS)
 		_thread.Run([](void* arg) {
+#	if !defined(DEATH_TARGET_EMSCRIPTEN)
+			Thread::SetSelfName("Cache Refresh");
+#	endif
 			auto _this = reinterpret_cast<RefreshCacheSection*>(arg);
 			if (auto mainMenu = dynamic_cast<MainMenu*>(_this->_root)) {
-				mainMenu->_root->RefreshCacheLevels();
+				mainMenu->_root->RefreshCacheLevels(true);
 			}
 			_this->_done = true;
 		}, this);
 #else
 		if (auto mainMenu = dynamic_cast<MainMenu*>(_root)) {
-			mainMenu->_root->RefreshCacheLevels();
+			mainMenu->_root->RefreshCacheLevels(true);
 		}
 		_done = true;
 #endif
@@ -52,10 +55,10 @@ namespace Jazz2::UI::Menu
 
 		constexpr float topLine = 131.0f;
 		float bottomLine = viewSize.Y - 42.0f;
-		_root->DrawElement("MenuDim"_s, center.X, (topLine + bottomLine) * 0.5f, IMenuContainer::BackgroundLayer,
+		_root->DrawElement(MenuElement::Dim, center.X, (topLine + bottomLine) * 0.5f, IMenuContainer::BackgroundLayer,
 			Alignment::Center, Colorf::Black, Vector2f(680.0f, bottomLine - topLine + 2), Vector4f(1.0f, 0.0f, 0.4f, 0.3f));
-		_root->DrawElement("MenuLine"_s, 0, center.X, topLine, IMenuContainer::MainLayer, Alignment::Center, Colorf::White, 1.6f);
-		_root->DrawElement("MenuLine"_s, 1, center.X, bottomLine, IMenuContainer::MainLayer, Alignment::Center, Colorf::White, 1.6f);
+		_root->DrawElement(MenuElement::Line, 0, center.X, topLine, IMenuContainer::MainLayer, Alignment::Center, Colorf::White, 1.6f);
+		_root->DrawElement(MenuElement::Line, 1, center.X, bottomLine, IMenuContainer::MainLayer, Alignment::Center, Colorf::White, 1.6f);
 
 		center.Y = topLine + (bottomLine - topLine) * 0.4f;
 		int32_t charOffset = 0;
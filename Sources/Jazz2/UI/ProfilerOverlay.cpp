@@ -0,0 +1,143 @@
+﻿#if defined(NCINE_PROFILING)
+
+#include "ProfilerOverlay.h"
+#include "../LevelHandler.h"
+#include "../ContentResolver.h"
+
+#include "../../nCine/Application.h"
+#include "../../nCine/Base/FrameProfiler.h"
+#include "../../nCine/Base/ScratchArena.h"
+#include "../../nCine/IO/FileSystem.h"
+#if defined(WITH_ALLOCATORS)
+#	include "../../nCine/Base/AllocManager.h"
+#endif
+
+#include <cstdio> // for snprintf()
+
+namespace Jazz2::UI
+{
+	ProfilerOverlay::ProfilerOverlay(LevelHandler* levelHandler)
+		: _levelHandler(levelHandler)
+	{
+		_smallFont = ContentResolver::Get().GetFont(FontType::Small);
+		setDrawEnabled(false);
+	}
+
+	bool ProfilerOverlay::OnDraw(RenderQueue& renderQueue)
+	{
+		Canvas::OnDraw(renderQueue);
+
+		if (_smallFont == nullptr) {
+			return false;
+		}
+
+		constexpr float TargetFrameTime = 1000.0f / 60.0f;
+		constexpr float PanelWidth = 220.0f;
+		constexpr float LineHeight = 11.0f;
+		constexpr float HistogramHeight = 40.0f;
+		constexpr float BarWidth = PanelWidth / HistogramFrames;
+
+		ViewSize = _levelHandler->GetViewSize();
+
+		const uint32_t zoneCount = FrameProfiler::zoneCount();
+		const float left = 6.0f;
+		const float top = 20.0f;
+#if defined(WITH_ALLOCATORS)
+		const uint32_t allocatorRows = (uint32_t)AllocTag::Count + 1;
+#else
+		const uint32_t allocatorRows = 0;
+#endif
+		const float panelHeight = HistogramHeight + (zoneCount + allocatorRows + 3) * LineHeight + 10.0f;
+		DrawSolidTopLeft(left - 4.0f, top - 4.0f, MainLayer, Vector2f(PanelWidth + 8.0f, panelHeight), Colorf(0.0f, 0.0f, 0.0f, 0.6f));
+
+		// Frame time histogram, the line marks 60 FPS and bars are scaled so 2x target frame time fills the height
+		const float histogramBottom = top + HistogramHeight;
+		const uint32_t frameCount = std::min((uint32_t)HistogramFrames, FrameProfiler::frameCount());
+		for (uint32_t i = 0; i < frameCount; i++) {
+			float frameTime = FrameProfiler::frameTime(i);
+			float height = std::min(frameTime / (TargetFrameTime * 2.0f), 1.0f) * HistogramHeight;
+			Colorf color = (frameTime <= TargetFrameTime * 1.05f ? Colorf(0.3f, 0.9f, 0.3f, 0.9f)
+				: (frameTime <= TargetFrameTime * 2.0f ? Colorf(0.95f, 0.8f, 0.2f, 0.9f) : Colorf(0.95f, 0.3f, 0.2f, 0.9f)));
+			DrawSolidTopLeft(left + PanelWidth - (i + 1) * BarWidth, histogramBottom - height, MainLayer + 1, Vector2f(BarWidth, height), color);
+		}
+		DrawSolidTopLeft(left, histogramBottom - HistogramHeight * 0.5f, MainLayer + 2, Vector2f(PanelWidth, 1.0f), Colorf(1.0f, 1.0f, 1.0f, 0.5f));
+
+		int32_t charOffset = 0;
+		char stringBuffer[64];
+		float y = histogramBottom + 4.0f;
+
+		FrameProfiler::Percentiles percentiles = FrameProfiler::frameTimePercentiles();
+		snprintf(stringBuffer, sizeof(stringBuffer), "Frame %.2f ms", FrameProfiler::frameTime(0));
+		_smallFont->DrawString(this, stringBuffer, charOffset, left, y, FontLayer,
+			Alignment::TopLeft, Font::DefaultColor, 0.7f, 0.0f, 0.0f, 0.0f, 0.0f, 0.9f);
+		snprintf(stringBuffer, sizeof(stringBuffer), "%.1f / %.1f / %.1f", percentiles.p50, percentiles.p95, percentiles.p99);
+		_smallFont->DrawString(this, stringBuffer, charOffset, left + PanelWidth, y, FontLayer,
+			Alignment::TopRight, Font::DefaultColor, 0.7f, 0.0f, 0.0f, 0.0f, 0.0f, 0.9f);
+		y += LineHeight;
+		_smallFont->DrawString(this, "Zone"_s, charOffset, left, y, FontLayer,
+			Alignment::TopLeft, Colorf(0.46f, 0.46f, 0.4f, 0.5f), 0.7f, 0.0f, 0.0f, 0.0f, 0.0f, 0.9f);
+		_smallFont->DrawString(this, "Last / Avg"_s, charOffset, left + PanelWidth, y, FontLayer,
+			Alignment::TopRight, Colorf(0.46f, 0.46f, 0.4f, 0.5f), 0.7f, 0.0f, 0.0f, 0.0f, 0.0f, 0.9f);
+		y += LineHeight;
+
+		for (uint32_t i = 0; i < zoneCount; i++) {
+			float zoneTime = FrameProfiler::zoneTime(i, 0);
+			// Share of the target frame time
+			float barWidth = std::min(zoneTime / TargetFrameTime, 1.0f) * PanelWidth;
+			DrawSolidTopLeft(left, y + 1.0f, MainLayer + 1, Vector2f(barWidth, LineHeight - 2.0f), Colorf(0.3f, 0.5f, 0.9f, 0.35f));
+
+			_smallFont->DrawString(this, FrameProfiler::zoneName(i), charOffset, left, y, FontLayer,
+				Alignment::TopLeft, Font::DefaultColor, 0.7f, 0.0f, 0.0f, 0.0f, 0.0f, 0.9f);
+			snprintf(stringBuffer, sizeof(stringBuffer), "%.2f / %.2f", zoneTime, FrameProfiler::averageZoneTime(i));
+			_smallFont->DrawString(this, stringBuffer, charOffset, left + PanelWidth, y, FontLayer,
+				Alignment::TopRight, Font::DefaultColor, 0.7f, 0.0f, 0.0f, 0.0f, 0.0f, 0.9f);
+			y += LineHeight;
+		}
+
+		// Transient allocations of the last frame, overflows went to the heap
+		const ScratchArena::Statistics& scratchStats = theApplication().scratchArena().lastFrameStatistics();
+		_smallFont->DrawString(this, "Scratch"_s, charOffset, left, y, FontLayer,
+			Alignment::TopLeft, Font::DefaultColor, 0.7f, 0.0f, 0.0f, 0.0f, 0.0f, 0.9f);
+		snprintf(stringBuffer, sizeof(stringBuffer), "%zu / %zu KB / %zu", scratchStats.numAllocations, scratchStats.usedMemory / 1024, scratchStats.numOverflows);
+		_smallFont->DrawString(this, stringBuffer, charOffset, left + PanelWidth, y, FontLayer,
+			Alignment::TopRight, Font::DefaultColor, 0.7f, 0.0f, 0.0f, 0.0f, 0.0f, 0.9f);
+		y += LineHeight;
+
+#if defined(WITH_ALLOCATORS)
+		_smallFont->DrawString(this, "Allocator"_s, charOffset, left, y, FontLayer,
+			Alignment::TopLeft, Colorf(0.46f, 0.46f, 0.4f, 0.5f), 0.7f, 0.0f, 0.0f, 0.0f, 0.0f, 0.9f);
+		_smallFont->DrawString(this, "KB / Peak / Count"_s, charOffset, left + PanelWidth, y, FontLayer,
+			Alignment::TopRight, Colorf(0.46f, 0.46f, 0.4f, 0.5f), 0.7f, 0.0f, 0.0f, 0.0f, 0.0f, 0.9f);
+		y += LineHeight;
+
+		for (uint32_t i = 0; i < (uint32_t)AllocTag::Count; i++) {
+			const ProxyAllocator& allocator = AllocManager::proxy(AllocTag(i));
+			const ProxyAllocator::Statistics stats = allocator.statistics();
+			_smallFont->DrawString(this, allocator.name(), charOffset, left, y, FontLayer,
+				Alignment::TopLeft, Font::DefaultColor, 0.7f, 0.0f, 0.0f, 0.0f, 0.0f, 0.9f);
+			snprintf(stringBuffer, sizeof(stringBuffer), "%zu / %zu / %zu", stats.usedMemory / 1024, stats.peakMemory / 1024, stats.numAllocations);
+			_smallFont->DrawString(this, stringBuffer, charOffset, left + PanelWidth, y, FontLayer,
+				Alignment::TopRight, Font::DefaultColor, 0.7f, 0.0f, 0.0f, 0.0f, 0.0f, 0.9f);
+			y += LineHeight;
+		}
+#endif
+
+		return true;
+	}
+
+	void ProfilerOverlay::Export()
+	{
+		auto& resolver = ContentResolver::Get();
+		fs::CreateDirectories(resolver.GetCachePath());
+		FrameProfiler::exportCsv(fs::JoinPath(resolver.GetCachePath(), "Profiler.csv"_s));
+		FrameProfiler::exportJson(fs::JoinPath(resolver.GetCachePath(), "Profiler.json"_s));
+	}
+
+	void ProfilerOverlay::DrawSolidTopLeft(float x, float y, uint16_t z, const Vector2f& size, const Colorf& color)
+	{
+		Vector2f pos = ApplyAlignment(Alignment::TopLeft, Vector2f(x - ViewSize.X * 0.5f, ViewSize.Y * 0.5f - y), size);
+		DrawSolid(pos, z, size, color);
+	}
+}
+
+#endif
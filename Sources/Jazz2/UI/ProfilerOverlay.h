@@ -0,0 +1,38 @@
+﻿#pragma once
+
+#if defined(NCINE_PROFILING)
+
+#include "Canvas.h"
+#include "Font.h"
+
+namespace Jazz2
+{
+	class LevelHandler;
+}
+
+namespace Jazz2::UI
+{
+	/// Shows frame time histogram, percentiles and zones recorded by `FrameProfiler`
+	class ProfilerOverlay : public Canvas
+	{
+	public:
+		ProfilerOverlay(LevelHandler* levelHandler);
+
+		bool OnDraw(RenderQueue& renderQueue) override;
+
+		/// Saves recorded frames as CSV and JSON files to the cache directory
+		void Export();
+
+	private:
+		static constexpr uint16_t MainLayer = 600;
+		static constexpr uint16_t FontLayer = 700;
+		static constexpr int32_t HistogramFrames = 120;
+
+		LevelHandler* _levelHandler;
+		Font* _smallFont;
+
+		void DrawSolidTopLeft(float x, float y, uint16_t z, const Vector2f& size, const Colorf& color);
+	};
+}
+
+#endif
@@ -18,6 +18,7 @@
 #include "nCine/Input/IInputEventHandler.h"
 #include "nCine/IO/FileSystem.h"
 #include "nCine/Threading/Thread.h"
+#include "nCine/tracy.h"
 
 #include "Jazz2/IRootController.h"
 #include "Jazz2/ContentResolver.h"
@@ -28,6 +29,7 @@
 #include "Jazz2/UI/Menu/MainMenu.h"
 #include "Jazz2/UI/Menu/SimpleMessageSection.h"
 
+#include "Jazz2/Compatibility/CacheManifest.h"
 #include "Jazz2/Compatibility/JJ2Anims.h"
 #include "Jazz2/Compatibility/JJ2Episode.h"
 #include "Jazz2/Compatibility/JJ2Level.h"
@@ -93,9 +95,9 @@ public:
 	}
 
 #if !defined(DEATH_TARGET_EMSCRIPTEN)
-	void RefreshCacheLevels() override;
+	void RefreshCacheLevels(bool force) override;
 #else
-	void RefreshCacheLevels() override { }
+	void RefreshCacheLevels(bool force) override { }
 #endif
 
 private:
@@ -106,12 +108,20 @@ private:
 	char _newestVersion[20];
 
 #if !defined(DEATH_TARGET_EMSCRIPTEN)
+	/// Version of level scripts copied to the cache, it has to be increased if they need to be copied again
+	static constexpr uint32_t ScriptCacheVersion = 1;
+
 	void RefreshCache();
+	void RefreshCacheLevels(Compatibility::CacheManifest& manifest);
+	static void RefreshCacheLevelScript(Compatibility::CacheManifest& manifest, const StringView& levelPath, const StringView& targetLevelPath);
 	void CheckUpdates();
 #endif
 	static void SaveEpisodeEnd(const std::unique_ptr<LevelInitialization>& pendingLevelChange);
 	static void SaveEpisodeContinue(const std::unique_ptr<LevelInitialization>& pendingLevelChange);
 	static void UpdateRichPresence(const std::unique_ptr<LevelInitialization>& levelInit);
+#if defined(WITH_TRACE_EXPORT)
+	static void SaveTrace();
+#endif
 };
 
 void GameEventHandler::OnPreInit(AppConfiguration& config)
@@ -165,6 +175,7 @@ void GameEventHandler::OnInit()
 #if defined(WITH_THREADS) && !defined(DEATH_TARGET_EMSCRIPTEN)
 	// If threading support is enabled, refresh cache during intro cinematics and don't allow skip until it's completed
 	Thread thread([](void* arg) {
+		Thread::SetSelfName("Loading");
 		auto handler = reinterpret_cast<GameEventHandler*>(arg);
 #	if (defined(DEATH_TARGET_WINDOWS) && !defined(DEATH_TARGET_WINDOWS_RT)) || defined(DEATH_TARGET_UNIX)
 		if (PreferencesCache::EnableDiscordIntegration) {
@@ -346,6 +357,9 @@ void GameEventHandler::OnResizeWindow(int width, int height)
 
 void GameEventHandler::OnShutdown()
 {
+#if defined(WITH_TRACE_EXPORT)
+	SaveTrace();
+#endif
 	_currentHandler = nullptr;
 
 	ContentResolver::Get().Release();
@@ -390,6 +404,14 @@ void GameEventHandler::OnKeyPressed(const KeyboardEvent& event)
 	}
 #endif
 
+#if defined(WITH_TRACE_EXPORT)
+	// Save recorded trace events on request, the file can be opened in Perfetto or chrome://tracing
+	if (event.sym == KeySym::F11) {
+		SaveTrace();
+		return;
+	}
+#endif
+
 	_currentHandler->OnKeyPressed(event);
 }
 
@@ -418,6 +440,7 @@ void GameEventHandler::ChangeLevel(LevelInitialization&& levelInit)
 #if !defined(DEATH_TARGET_EMSCRIPTEN)
 void GameEventHandler::RefreshCache()
 {
+	ZoneScoped;
 	if (PreferencesCache::BypassCache) {
 		LOGI("Cache is bypassed by command-line parameter");
 		_flags |= Flags::IsVerified | Flags::IsPlayable;
@@ -426,51 +449,22 @@ void GameEventHandler::RefreshCache()
 
 	auto& resolver = ContentResolver::Get();
 
-	// Check cache state
-	{
-		auto s = fs::Open(fs::JoinPath({ resolver.GetCachePath(), "Animations"_s, "cache.index"_s }), FileAccessMode::Read);
-		if (s->GetSize() < 16) {
-			goto RecreateCache;
-		}
-
-		uint64_t signature = s->ReadValue<uint64_t>();
-		uint8_t fileType = s->ReadValue<uint8_t>();
-		uint16_t version = s->ReadValue<uint16_t>();
-		if (signature != 0x2095A59FF0BFBBEF || fileType != ContentResolver::CacheIndexFile || version != Compatibility::JJ2Anims::CacheVersion) {
-			goto RecreateCache;
-		}
-
-		uint8_t flags = s->ReadValue<uint8_t>();
-		if ((flags & 0x01) == 0x01) {
-			// Don't overwrite cache
-			LOGI("Cache is protected");
-			_flags |= Flags::IsVerified | Flags::IsPlayable;
-			return;
-		}
-
-		String animsPath = fs::FindPathCaseInsensitive(fs::JoinPath(resolver.GetSourcePath(), "Anims.j2a"_s));
-		if (!fs::IsReadableFile(animsPath)) {
-			animsPath = fs::FindPathCaseInsensitive(fs::JoinPath(resolver.GetSourcePath(), "AnimsSw.j2a"_s));
-		}
-		uint64_t animsCached = s->ReadValue<uint64_t>();
-		uint64_t animsModified = fs::LastModificationTime(animsPath).Ticks;
-		if (animsModified != 0 && animsCached != animsModified) {
-			goto RecreateCache;
-		}
+	String indexPath = fs::JoinPath(resolver.GetCachePath(), "cache.index"_s);
+	String legacyIndexPath = fs::JoinPath({ resolver.GetCachePath(), "Animations"_s, "cache.index"_s });
 
-		// If some events were added, recreate cache
-		uint16_t eventTypeCount = s->ReadValue<uint16_t>();
-		if (eventTypeCount != (uint16_t)EventType::Count) {
-			goto RecreateCache;
-		}
+	Compatibility::CacheManifest manifest(resolver.GetCachePath());
+	if (!manifest.Load(indexPath)) {
+		// Older versions stored the index in "Animations" directory, only the protection flag is used from it
+		manifest.Load(legacyIndexPath);
+	}
 
-		// Cache is up-to-date
-		LOGI("Cache is already up-to-date");
+	if (manifest.IsProtected()) {
+		// Don't overwrite cache
+		LOGI("Cache is protected");
 		_flags |= Flags::IsVerified | Flags::IsPlayable;
 		return;
 	}
 
-RecreateCache:
 	// "Source" directory must be case in-sensitive
 	String animsPath = fs::FindPathCaseInsensitive(fs::JoinPath(resolver.GetSourcePath(), "Anims.j2a"_s));
 	if (!fs::IsReadableFile(animsPath)) {
@@ -482,37 +476,61 @@ RecreateCache:
 		}
 	}
 
-	String animationsPath = fs::JoinPath(resolver.GetCachePath(), "Animations"_s);
-	fs::RemoveDirectoryRecursive(animationsPath);
-	if (!Compatibility::JJ2Anims::Convert(animsPath, animationsPath, false)) {
-		LOGE_X("Provided Jazz Jackrabbit 2 version is not supported. Make sure supported Jazz Jackrabbit 2 version is present in \"%s\" directory.", resolver.GetSourcePath().data());
-		_flags |= Flags::IsVerified;
-		return;
-	}
+	// Individual sets are checked only if the whole file was changed, otherwise all of them are kept
+	if (manifest.NeedsConversion("Anims"_s, animsPath, Compatibility::JJ2Anims::CacheVersion)) {
+		String animationsPath = fs::JoinPath(resolver.GetCachePath(), "Animations"_s);
+		if (!Compatibility::JJ2Anims::Convert(animsPath, animationsPath, false, &manifest)) {
+			LOGE_X("Provided Jazz Jackrabbit 2 version is not supported. Make sure supported Jazz Jackrabbit 2 version is present in \"%s\" directory.", resolver.GetSourcePath().data());
+			manifest.Invalidate("Anims"_s);
+			manifest.Save(indexPath);
+			_flags |= Flags::IsVerified;
+			return;
+		}
+		manifest.RemoveUnvisited("Animations:"_s);
 
-	RefreshCacheLevels();
+		// Compiled metadata are refreshed automatically, but they can reference assets that no longer exist
+		fs::RemoveDirectoryRecursive(fs::JoinPath(resolver.GetCachePath(), "Metadata"_s));
+	}
 
-	// Create cache index
-	auto so = fs::Open(fs::JoinPath({ resolver.GetCachePath(), "Animations"_s, "cache.index"_s }), FileAccessMode::Write);
+	RefreshCacheLevels(manifest);
 
-	so->WriteValue<uint64_t>(0x2095A59FF0BFBBEF);	// Signature
-	so->WriteValue<uint8_t>(ContentResolver::CacheIndexFile);
-	so->WriteValue<uint16_t>(Compatibility::JJ2Anims::CacheVersion);
-	so->WriteValue<uint8_t>(0x00);					// Flags
-	uint64_t animsModified = fs::LastModificationTime(animsPath).Ticks;
-	so->WriteValue<uint64_t>(animsModified);
-	so->WriteValue<uint16_t>((uint16_t)EventType::Count);
+	manifest.Save(indexPath);
+	fs::RemoveFile(legacyIndexPath);
 
 	RenderResources::binaryShaderCache().prune();
 
-	LOGI("Cache was recreated");
+	LOGI("Cache was refreshed");
 	_flags |= Flags::IsVerified | Flags::IsPlayable;
 }
 
-void GameEventHandler::RefreshCacheLevels()
+void GameEventHandler::RefreshCacheLevels(bool force)
 {
 	auto& resolver = ContentResolver::Get();
 
+	String indexPath = fs::JoinPath(resolver.GetCachePath(), "cache.index"_s);
+	Compatibility::CacheManifest manifest(resolver.GetCachePath());
+	manifest.Load(indexPath);
+	if (manifest.IsProtected()) {
+		return;
+	}
+
+	if (force) {
+		// All levels are converted again even if their sources weren't changed, e.g. when requested from the menu
+		manifest.InvalidateAll("Episodes:"_s);
+		manifest.InvalidateAll("Levels:"_s);
+		manifest.InvalidateAll("Scripts:"_s);
+		manifest.InvalidateAll("Tilesets:"_s);
+	}
+
+	RefreshCacheLevels(manifest);
+	manifest.Save(indexPath);
+}
+
+void GameEventHandler::RefreshCacheLevels(Compatibility::CacheManifest& manifest)
+{
+	ZoneScoped;
+	auto& resolver = ContentResolver::Get();
+
 	Compatibility::EventConverter eventConverter;
 
 	bool hasChristmasChronicles = fs::IsReadableFile(fs::FindPathCaseInsensitive(fs::JoinPath(resolver.GetSourcePath(), "xmas99.j2e"_s)));
@@ -656,9 +674,11 @@ void GameEventHandler::RefreshCacheLevels()
 	};
 
 	String episodesPath = fs::JoinPath(resolver.GetCachePath(), "Episodes"_s);
-	fs::RemoveDirectoryRecursive(episodesPath);
 	fs::CreateDirectories(episodesPath);
 
+	uint32_t episodeConverterVersion = ((uint32_t)Compatibility::JJ2Episode::CacheVersion << 1) | (hasChristmasChronicles ? 1 : 0);
+	uint32_t levelConverterVersion = ((uint32_t)Compatibility::JJ2Level::CacheVersion << 16) | (uint16_t)EventType::Count;
+
 	HashMap<String, bool> usedTilesets;
 
 	fs::Directory dir(fs::FindPathCaseInsensitive(resolver.GetSourcePath()), fs::EnumerationOptions::SkipDirectories);
@@ -671,6 +691,11 @@ void GameEventHandler::RefreshCacheLevels()
 		auto extension = fs::GetExtension(item);
 		if (extension == "j2e"_s || extension == "j2pe"_s) {
 			// Episode
+			String key = "Episodes:"_s + fs::GetFileName(item);
+			if (!manifest.NeedsConversion(key, item, episodeConverterVersion)) {
+				continue;
+			}
+
 			Compatibility::JJ2Episode episode;
 			if (episode.Open(item)) {
 				if (episode.Name == "home"_s || (hasChristmasChronicles && episode.Name == "xmas98"_s)) {
@@ -679,11 +704,27 @@ void GameEventHandler::RefreshCacheLevels()
 
 				String fullPath = fs::JoinPath(episodesPath, (episode.Name == "xmas98"_s ? "xmas99"_s : StringView(episode.Name)) + ".j2e"_s);
 				episode.Convert(fullPath, LevelTokenConversion, EpisodeNameConversion, EpisodePrevNext);
+				manifest.AddOutput(key, fullPath);
+			} else {
+				manifest.Invalidate(key);
 			}
 		} else if (extension == "j2l"_s) {
 			// Level
 			String levelName = fs::GetFileName(item);
 			if (levelName.find("-MLLE-Data-"_s) == nullptr) {
+				String key = "Levels:"_s + levelName;
+				if (!manifest.NeedsConversion(key, item, levelConverterVersion)) {
+					// Level is up-to-date, but its tilesets and script still have to be checked
+					for (auto& tileset : manifest.GetDependencies(key)) {
+						usedTilesets.emplace(tileset, true);
+					}
+					auto outputs = manifest.GetOutputs(key);
+					if (!outputs.empty()) {
+						RefreshCacheLevelScript(manifest, item, outputs[0]);
+					}
+					continue;
+				}
+
 				Compatibility::JJ2Level level;
 				if (level.Open(item, false)) {
 					String fullPath;
@@ -700,20 +741,19 @@ void GameEventHandler::RefreshCacheLevels()
 
 					fs::CreateDirectories(fs::GetDirectoryName(fullPath));
 					level.Convert(fullPath, eventConverter, LevelTokenConversion);
+					manifest.AddOutput(key, fullPath);
 
 					usedTilesets.emplace(level.Tileset, true);
+					manifest.AddDependency(key, level.Tileset);
 					for (auto& extraTileset : level.ExtraTilesets) {
 						usedTilesets.emplace(extraTileset.Name, true);
+						manifest.AddDependency(key, extraTileset.Name);
 					}
 
 					// Also copy level script file if exists
-					StringView foundDot = item.findLastOr('.', item.end());
-					String scriptPath = item.prefix(foundDot.begin()) + ".j2as"_s;
-					auto adjustedPath = fs::FindPathCaseInsensitive(scriptPath);
-					if (fs::IsReadableFile(adjustedPath)) {
-						foundDot = fullPath.findLastOr('.', fullPath.end());
-						fs::Copy(adjustedPath, fullPath.prefix(foundDot.begin()) + ".j2as"_s);
-					}
+					RefreshCacheLevelScript(manifest, item, fullPath);
+				} else {
+					manifest.Invalidate(key);
 				}
 			}
 		}
@@ -732,19 +772,61 @@ void GameEventHandler::RefreshCacheLevels()
 
 	// Convert only used tilesets
 	String tilesetsPath = fs::JoinPath(resolver.GetCachePath(), "Tilesets"_s);
-	fs::RemoveDirectoryRecursive(tilesetsPath);
 	fs::CreateDirectories(tilesetsPath);
 
 	for (auto& pair : usedTilesets) {
 		String tilesetPath = fs::JoinPath(resolver.GetSourcePath(), pair.first + ".j2t"_s);
 		auto adjustedPath = fs::FindPathCaseInsensitive(tilesetPath);
 		if (fs::IsReadableFile(adjustedPath)) {
+			String key = "Tilesets:"_s + pair.first;
+			if (!manifest.NeedsConversion(key, adjustedPath, Compatibility::JJ2Tileset::CacheVersion)) {
+				continue;
+			}
+
 			Compatibility::JJ2Tileset tileset;
 			if (tileset.Open(adjustedPath, false)) {
-				tileset.Convert(fs::JoinPath({ tilesetsPath, pair.first + ".j2t"_s }));
+				String fullPath = fs::JoinPath({ tilesetsPath, pair.first + ".j2t"_s });
+				tileset.Convert(fullPath);
+				manifest.AddOutput(key, fullPath);
+			} else {
+				manifest.Invalidate(key);
 			}
 		}
 	}
+
+	// Remove artifacts whose sources no longer exist or are no longer used
+	manifest.RemoveUnvisited("Episodes:"_s);
+	manifest.RemoveUnvisited("Levels:"_s);
+	manifest.RemoveUnvisited("Scripts:"_s);
+	manifest.RemoveUnvisited("Tilesets:"_s);
+}
+
+void GameEventHandler::RefreshCacheLevelScript(Compatibility::CacheManifest& manifest, const StringView& levelPath, const StringView& targetLevelPath)
+{
+	StringView foundDot = levelPath.findLastOr('.', levelPath.end());
+	String scriptPath = levelPath.prefix(foundDot.begin()) + ".j2as"_s;
+	auto adjustedPath = fs::FindPathCaseInsensitive(scriptPath);
+	if (!fs::IsReadableFile(adjustedPath)) {
+		return;
+	}
+
+	String key = "Scripts:"_s + fs::GetFileName(adjustedPath);
+	foundDot = targetLevelPath.findLastOr('.', targetLevelPath.end());
+	String targetPath = targetLevelPath.prefix(foundDot.begin()) + ".j2as"_s;
+	if (!manifest.NeedsConversion(key, adjustedPath, ScriptCacheVersion)) {
+		auto outputs = manifest.GetOutputs(key);
+		if (!outputs.empty() && outputs[0] == targetPath) {
+			return;
+		}
+		// Level was converted to a different path, so the script has to be copied again
+		manifest.Reset(key, adjustedPath, ScriptCacheVersion);
+	}
+
+	if (fs::Copy(adjustedPath, targetPath)) {
+		manifest.AddOutput(key, targetPath);
+	} else {
+		manifest.Invalidate(key);
+	}
 }
 
 void GameEventHandler::CheckUpdates()
@@ -1029,6 +1111,15 @@ void GameEventHandler::UpdateRichPresence(const std::unique_ptr<LevelInitializat
 #endif
 }
 
+#if defined(WITH_TRACE_EXPORT)
+void GameEventHandler::SaveTrace()
+{
+	auto& resolver = ContentResolver::Get();
+	fs::CreateDirectories(resolver.GetCachePath());
+	TraceExporter::flush(fs::JoinPath(resolver.GetCachePath(), "Trace.json"_s));
+}
+#endif
+
 #if defined(DEATH_TARGET_ANDROID)
 std::unique_ptr<IAppEventHandler> CreateAppEventHandler()
 {
@@ -15,6 +15,7 @@ namespace nCine
 		windowScaling(true),
 		frameLimit(0),
 		useBufferMapping(false),
+		usePersistentBufferMapping(false),
 #if defined(WITH_FIXED_BATCH_SIZE) && WITH_FIXED_BATCH_SIZE > 0
 		fixedBatchSize(WITH_FIXED_BATCH_SIZE),
 #elif defined(DEATH_TARGET_WINDOWS_RT)
@@ -33,6 +34,7 @@ namespace nCine
 #endif
 		vaoPoolSize(16),
 		renderCommandPoolSize(32),
+		scratchArenaSize(512 * 1024),
 		withAudio(true),
 		withThreads(false),
 		withScenegraph(true),
@@ -58,6 +60,7 @@ namespace nCine
 		dataPath() = fs::PathSeparator;
 		// Always disable mapping on Emscripten as it is not supported by WebGL 2
 		useBufferMapping = false;
+		usePersistentBufferMapping = false;
 #else
 		dataPath() = "Content"_s + fs::PathSeparator;
 #endif
@@ -45,6 +45,10 @@ namespace nCine
 
 		/// The flag is `true` if mapping is used to update OpenGL buffers
 		bool useBufferMapping;
+		/// The flag is `true` if OpenGL buffers are persistently mapped and used as ring buffers synchronized with fences
+		/*! \note It requires `GL_ARB_buffer_storage` or OpenGL 4.4, otherwise the other update strategies are used.
+		It can be also enabled by `/persistent-mapping` command-line argument. */
+		bool usePersistentBufferMapping;
 		/// Fixed size of render commands to be collected for batching on Emscripten and ANGLE
 		/*! \note Increasing this value too much might negatively affect batching shaders compilation time.
 		A value of zero restores the default behavior of non fixed size for batches. */
@@ -61,6 +65,8 @@ namespace nCine
 		unsigned int vaoPoolSize;
 		/// The initial size for the pool of render commands
 		unsigned int renderCommandPoolSize;
+		/// The size in bytes of the per-frame scratch arena, larger requests fall back to the heap
+		unsigned long scratchArenaSize;
 
 		/// The flag is `true` if the audio subsystem is enabled
 		bool withAudio;
@@ -44,6 +44,7 @@ extern "C"
 
 #include "Application.h"
 #include "Base/Random.h"
+#include "Base/CpuDispatch.h"
 #include "IAppEventHandler.h"
 #include "IO/FileSystem.h"
 #include "ArrayIndexer.h"
@@ -54,6 +55,8 @@ extern "C"
 #include "Graphics/GL/GLDebug.h"
 #include "Base/Timer.h" // for `sleep()`
 #include "Base/FrameTimer.h"
+#include "Base/FrameProfiler.h"
+#include "Base/ScratchArena.h"
 #include "Graphics/SceneNode.h"
 #include "Input/IInputManager.h"
 #include "Input/JoyMapping.h"
@@ -77,6 +80,10 @@ extern "C"
 #	include "Graphics/RenderDocCapture.h"
 #endif
 
+#if defined(WITH_ALLOCATORS)
+#	include "Base/AllocManager.h"
+#endif
+
 #if defined(NCINE_LOG)
 
 #if defined(DEATH_TARGET_WINDOWS)
@@ -369,6 +376,9 @@ namespace nCine
 	{
 		TracyGpuContext;
 		ZoneScoped;
+#if defined(WITH_TRACE_EXPORT)
+		TraceExporter::setThreadName("Main");
+#endif
 		// This timestamp is needed to initialize random number generator
 		profileStartTime_ = TimeStamp::now();
 
@@ -376,7 +386,41 @@ namespace nCine
 #if defined(WITH_TRACY)
 		TracyAppInfo(NCINE_APP, sizeof(NCINE_APP) - 1);
 		LOGW("Tracy integration is enabled");
+#elif defined(WITH_TRACE_EXPORT)
+		LOGW("Trace export is enabled");
+#endif
+
+		// Engine options that are available only as command-line arguments
+		bool runCpuSelfTest = false;
+		for (int i = 0; i < appCfg_.argc(); i++) {
+			auto arg = appCfg_.argv(i);
+			if (arg == "/cpu-features"_s) {
+				// Dispatched kernels can be restricted to a subset of CPU features to test the fallback implementations
+				if (i + 1 < appCfg_.argc()) {
+					Cpu::Features features;
+					if (CpuDispatch::ParseFeatures(appCfg_.argv(i + 1), features)) {
+						CpuDispatch::OverrideFeatures(features);
+					} else {
+						LOGW("Invalid value for \"/cpu-features\" argument");
+					}
+					i++;
+				}
+			} else if (arg == "/cpu-self-test"_s) {
+				runCpuSelfTest = true;
+			} else if (arg == "/instanced-batching"_s) {
+				// Batching with per-instance attributes is used only if it's supported by the device
+				renderingSettings_.batchingWithInstanceAttributes = true;
+			} else if (arg == "/persistent-mapping"_s) {
+#if !defined(DEATH_TARGET_EMSCRIPTEN)
+				// Persistently mapped buffers are used only if `GL_ARB_buffer_storage` is supported by the device
+				appCfg_.usePersistentBufferMapping = true;
 #endif
+			}
+		}
+		if (runCpuSelfTest) {
+			CpuDispatch::RunSelfTest();
+		}
+		LOGI_X("Using %s kernels", CpuDispatch::GetFeatureName(CpuDispatch::GetFeatures()));
 
 		theServiceLocator().registerIndexer(std::make_unique<ArrayIndexer>());
 #if defined(WITH_AUDIO)
@@ -418,6 +462,7 @@ namespace nCine
 		TracyGpuCollect;
 
 		frameTimer_ = std::make_unique<FrameTimer>(appCfg_.frameTimerLogInterval, 0.2f);
+		scratchArena_ = std::make_unique<ScratchArena>(appCfg_.scratchArenaSize);
 
 		LOGI("Creating rendering resources...");
 
@@ -460,13 +505,16 @@ namespace nCine
 	void Application::step()
 	{
 		frameTimer_->addFrame();
+#if defined(NCINE_PROFILING)
+		FrameProfiler::beginFrame();
+#endif
 
 #if defined(WITH_LUA)
 		LuaStatistics::update();
 #endif
 
 		{
-			ZoneScopedN("OnFrameStart");
+			ProfilerZoneScopedN("OnFrameStart");
 #if defined(NCINE_PROFILING)
 			profileStartTime_ = TimeStamp::now();
 #endif
@@ -479,7 +527,7 @@ namespace nCine
 		if (appCfg_.withScenegraph) {
 			ZoneScopedN("SceneGraph");
 			{
-				ZoneScopedN("Update");
+				ProfilerZoneScopedN("Update");
 #if defined(NCINE_PROFILING)
 				profileStartTime_ = TimeStamp::now();
 #endif
@@ -490,7 +538,7 @@ namespace nCine
 			}
 
 			{
-				ZoneScopedN("OnPostUpdate");
+				ProfilerZoneScopedN("OnPostUpdate");
 #if defined(NCINE_PROFILING)
 				profileStartTime_ = TimeStamp::now();
 #endif
@@ -501,7 +549,7 @@ namespace nCine
 			}
 
 			{
-				ZoneScopedN("Visit");
+				ProfilerZoneScopedN("Visit");
 #if defined(NCINE_PROFILING)
 				profileStartTime_ = TimeStamp::now();
 #endif
@@ -512,7 +560,7 @@ namespace nCine
 			}
 
 			{
-				ZoneScopedN("Draw");
+				ProfilerZoneScopedN("Draw");
 #if defined(NCINE_PROFILING)
 				profileStartTime_ = TimeStamp::now();
 #endif
@@ -525,11 +573,12 @@ namespace nCine
 		}
 
 		{
+			ZoneScopedN("Audio");
 			theServiceLocator().audioDevice().updatePlayers();
 		}
 
 		{
-			ZoneScopedN("OnFrameEnd");
+			ProfilerZoneScopedN("OnFrameEnd");
 #if defined(NCINE_PROFILING)
 			profileStartTime_ = TimeStamp::now();
 #endif
@@ -539,9 +588,15 @@ namespace nCine
 #endif
 		}
 
+		// The render queue was already drawn, so nothing references transient memory of this frame anymore
+		scratchArena_->reset();
+
 		gfxDevice_->update();
 		FrameMark;
 		TracyGpuCollect;
+#if defined(NCINE_PROFILING)
+		FrameProfiler::endFrame();
+#endif
 
 		if (appCfg_.frameLimit > 0) {
 			const float frameTimeDuration = 1.0f / static_cast<float>(appCfg_.frameLimit);
@@ -565,6 +620,7 @@ namespace nCine
 		rootNode_.reset(nullptr);
 		RenderResources::dispose();
 		frameTimer_.reset(nullptr);
+		scratchArena_.reset(nullptr);
 		inputManager_.reset(nullptr);
 		gfxDevice_.reset(nullptr);
 
@@ -573,6 +629,10 @@ namespace nCine
 			//theServiceLocator().indexer().logReport();
 		}
 
+#if defined(WITH_ALLOCATORS)
+		AllocManager::logStatistics();
+#endif
+
 		LOGI("Application shut down");
 
 		theServiceLocator().unregisterAll();
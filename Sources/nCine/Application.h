@@ -14,6 +14,7 @@ namespace nCine
 	class ScreenViewport;
 	class IInputManager;
 	class IAppEventHandler;
+	class ScratchArena;
 
 	/// Main entry point and handler for nCine applications
 	class Application
@@ -23,18 +24,24 @@ namespace nCine
 		struct RenderingSettings
 		{
 			RenderingSettings()
-				: batchingEnabled(true), batchingWithIndices(false), cullingEnabled(true), minBatchSize(4), maxBatchSize(585) { }
+				: batchingEnabled(true), batchingWithIndices(false), batchingWithInstanceAttributes(false), cullingEnabled(true),
+					minBatchSize(4), maxBatchSize(585), maxInstancedBatchSize(4096) { }
 
 			/// True if batching is enabled
 			bool batchingEnabled;
 			/// True if using indices for vertex batching
 			bool batchingWithIndices;
+			/// True if sprites are batched with per-instance attributes instead of uniform buffer arrays when possible
+			/*! \note It's ignored if the device doesn't support per-instance attributes */
+			bool batchingWithInstanceAttributes;
 			/// True if node culling is enabled
 			bool cullingEnabled;
 			/// Minimum size for a batch to be collected
 			unsigned int minBatchSize;
 			/// Maximum size for a batch before a forced split
 			unsigned int maxBatchSize;
+			/// Maximum size for a batch with per-instance attributes before a forced split
+			unsigned int maxInstancedBatchSize;
 		};
 
 		enum class Timings
@@ -82,6 +89,10 @@ namespace nCine
 		inline IInputManager& inputManager() {
 			return *inputManager_;
 		}
+		/// Returns the arena for transient allocations of the main thread, it's reset at the end of every frame
+		inline ScratchArena& scratchArena() {
+			return *scratchArena_;
+		}
 
 		/// Returns the total number of frames already rendered
 		unsigned long int numFrames() const;
@@ -147,6 +158,7 @@ namespace nCine
 
 		TimeStamp profileStartTime_;
 		std::unique_ptr<FrameTimer> frameTimer_;
+		std::unique_ptr<ScratchArena> scratchArena_;
 		std::unique_ptr<IGfxDevice> gfxDevice_;
 		std::unique_ptr<SceneNode> rootNode_;
 		std::unique_ptr<ScreenViewport> screenViewport_;
@@ -0,0 +1,50 @@
+#if defined(WITH_ALLOCATORS)
+
+#include "AllocManager.h"
+#include "MallocAllocator.h"
+#include "../../Common.h"
+
+namespace nCine
+{
+	IAllocator& AllocManager::defaultAllocator()
+	{
+		// Function-local statics are constructed on first use, so allocators are available even during static initialization
+		static MallocAllocator allocator("Malloc");
+		return allocator;
+	}
+
+	ProxyAllocator& AllocManager::proxy(AllocTag tag)
+	{
+		static ProxyAllocator proxies[] = {
+			ProxyAllocator("General", defaultAllocator()),
+			ProxyAllocator("Graphics", defaultAllocator()),
+			ProxyAllocator("Audio", defaultAllocator()),
+			ProxyAllocator("Resources", defaultAllocator()),
+			ProxyAllocator("Scripting", defaultAllocator())
+		};
+		static_assert(sizeof(proxies) / sizeof(proxies[0]) == std::size_t(AllocTag::Count), "Every tag must have its allocator");
+
+		return proxies[std::size_t(tag) < std::size_t(AllocTag::Count) ? std::size_t(tag) : 0];
+	}
+
+	std::size_t AllocManager::usedMemory()
+	{
+		std::size_t usedMemory = 0;
+		for (std::size_t i = 0; i < std::size_t(AllocTag::Count); i++) {
+			usedMemory += proxy(AllocTag(i)).statistics().usedMemory;
+		}
+		return usedMemory;
+	}
+
+	void AllocManager::logStatistics()
+	{
+		for (std::size_t i = 0; i < std::size_t(AllocTag::Count); i++) {
+			const ProxyAllocator& allocator = proxy(AllocTag(i));
+			DEATH_UNUSED const ProxyAllocator::Statistics stats = allocator.statistics();
+			LOGI_X("Allocator \"%s\": %zu bytes in %zu allocation(s), peak %zu bytes, %zu allocation(s) in total",
+				allocator.name(), stats.usedMemory, stats.numAllocations, stats.peakMemory, stats.totalAllocations);
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,43 @@
+#pragma once
+
+#if defined(WITH_ALLOCATORS)
+
+#include "ProxyAllocator.h"
+
+#include <cstdint>
+
+namespace nCine
+{
+	/// Subsystems that memory allocations are attributed to
+	enum class AllocTag : std::uint8_t
+	{
+		General,
+		Graphics,
+		Audio,
+		Resources,
+		Scripting,
+
+		Count
+	};
+
+	/// The class that provides access to the default allocator and to tracked allocators of subsystems
+	class AllocManager
+	{
+	public:
+		/// Returns the allocator that is used when no other allocator is specified
+		static IAllocator& defaultAllocator();
+		/// Returns the tracking allocator of the subsystem, it forwards requests to the default allocator
+		static ProxyAllocator& proxy(AllocTag tag);
+
+		/// Returns the number of bytes currently allocated through all subsystem allocators
+		static std::size_t usedMemory();
+		/// Writes statistics of all subsystem allocators to the log
+		static void logStatistics();
+
+	private:
+		AllocManager() = delete;
+		~AllocManager() = delete;
+	};
+}
+
+#endif
@@ -0,0 +1,202 @@
+#include "Atom.h"
+#include "../../Common.h"
+
+#if defined(WITH_THREADS)
+#	include "../Threading/ThreadSync.h"
+#endif
+
+#include <atomic>
+#include <memory>
+
+#include <Containers/SmallVector.h>
+#include <Containers/String.h>
+
+namespace nCine
+{
+	namespace
+	{
+		/// Interned string, it's never modified or released after it's published, so it can be read without locking
+		struct AtomEntry
+		{
+			/// Hash of the atom, it differs from the string hash only if another string had the same hash
+			hash_t hash;
+			/// FNV-1a hash of the string
+			hash_t stringHash;
+			String str;
+		};
+
+		/// Open addressing table with linear probing, it's filled at most to a half, so probing always ends on an empty slot
+		/*! Each entry is stored at the position of its string hash and also at the position of its atom hash if it's different. */
+		struct AtomSlots
+		{
+			explicit AtomSlots(std::size_t capacity)
+				: mask(capacity - 1), used(0), slots(std::make_unique<std::atomic<const AtomEntry*>[]>(capacity)) {}
+
+			std::size_t mask;
+			std::size_t used;
+			std::unique_ptr<std::atomic<const AtomEntry*>[]> slots;
+		};
+
+		struct AtomTable
+		{
+			static constexpr std::size_t InitialCapacity = 1024;
+
+			/// Slots that are currently used for lookups
+			std::atomic<AtomSlots*> current { nullptr };
+			/// All slots ever created, replaced slots are kept, because lookups in other threads can still read them
+			SmallVector<std::unique_ptr<AtomSlots>, 0> allSlots;
+			SmallVector<std::unique_ptr<AtomEntry>, 0> entries;
+#if defined(WITH_THREADS)
+			/// Only insertions are serialized, lookups never take the lock
+			Mutex mutex;
+#endif
+		};
+
+		AtomTable& atomTable()
+		{
+			static AtomTable table;
+			return table;
+		}
+
+		const AtomEntry* findEntryByString(const AtomSlots* slots, hash_t stringHash, StringView str)
+		{
+			if (slots == nullptr) {
+				return nullptr;
+			}
+
+			for (std::size_t i = stringHash & slots->mask; ; i = (i + 1) & slots->mask) {
+				const AtomEntry* entry = slots->slots[i].load(std::memory_order_acquire);
+				if (entry == nullptr) {
+					return nullptr;
+				}
+				if (entry->stringHash == stringHash && entry->str == str) {
+					return entry;
+				}
+			}
+		}
+
+		const AtomEntry* findEntryByHash(const AtomSlots* slots, hash_t hash)
+		{
+			if (slots == nullptr) {
+				return nullptr;
+			}
+
+			for (std::size_t i = hash & slots->mask; ; i = (i + 1) & slots->mask) {
+				const AtomEntry* entry = slots->slots[i].load(std::memory_order_acquire);
+				if (entry == nullptr || entry->hash == hash) {
+					return entry;
+				}
+			}
+		}
+
+		void storeEntry(AtomSlots& slots, hash_t position, const AtomEntry* entry)
+		{
+			std::size_t i = position & slots.mask;
+			while (slots.slots[i].load(std::memory_order_relaxed) != nullptr) {
+				i = (i + 1) & slots.mask;
+			}
+			// The entry is fully constructed before it's visible to lookups
+			slots.slots[i].store(entry, std::memory_order_release);
+			slots.used++;
+		}
+
+		void storeEntry(AtomSlots& slots, const AtomEntry* entry)
+		{
+			storeEntry(slots, entry->stringHash, entry);
+			if (entry->hash != entry->stringHash) {
+				storeEntry(slots, entry->hash, entry);
+			}
+		}
+
+		/// Adds the entry to the table, it must be called with the lock held
+		void insertEntry(AtomTable& table, std::unique_ptr<AtomEntry> entry)
+		{
+			const AtomEntry* newEntry = table.entries.emplace_back(std::move(entry)).get();
+
+			AtomSlots* slots = table.current.load(std::memory_order_relaxed);
+			if (slots != nullptr && (slots->used + 2) * 2 <= slots->mask + 1) {
+				storeEntry(*slots, newEntry);
+				return;
+			}
+
+			// Current slots can be read by other threads, so larger slots are filled first and then published at once
+			std::size_t capacity = (slots != nullptr ? (slots->mask + 1) * 2 : AtomTable::InitialCapacity);
+			std::unique_ptr<AtomSlots> newSlots = std::make_unique<AtomSlots>(capacity);
+			for (const std::unique_ptr<AtomEntry>& e : table.entries) {
+				storeEntry(*newSlots, e.get());
+			}
+			table.current.store(newSlots.get(), std::memory_order_release);
+			table.allSlots.push_back(std::move(newSlots));
+		}
+	}
+
+	Atom Atom::intern(StringView str)
+	{
+		Atom atom(str);
+		if (atom.empty()) {
+			return atom;
+		}
+
+		// Most strings are already interned, so the lock is needed only if the string is not found
+		AtomTable& table = atomTable();
+		const AtomEntry* entry = findEntryByString(table.current.load(std::memory_order_acquire), atom.hash_, str);
+		if (entry != nullptr) {
+			atom.hash_ = entry->hash;
+			return atom;
+		}
+
+#if defined(WITH_THREADS)
+		table.mutex.Lock();
+#endif
+		// Another thread could intern the same string in the meantime
+		AtomSlots* slots = table.current.load(std::memory_order_relaxed);
+		entry = findEntryByString(slots, atom.hash_, str);
+		if (entry == nullptr) {
+			hash_t hash = atom.hash_;
+			const AtomEntry* collidingEntry = findEntryByHash(slots, hash);
+			if (collidingEntry != nullptr) {
+				// The string gets the next unused hash, so it can still be interned and found, but not created from a literal
+				do {
+					hash = hash * Prime + 1;
+				} while (hash == Seed || findEntryByHash(slots, hash) != nullptr);
+				LOGE_X("Atom \"%s\" has the same hash 0x%08x as \"%s\", it was assigned 0x%08x instead", String::nullTerminatedView(str).data(),
+					atom.hash_, collidingEntry->str.data(), hash);
+			}
+
+			std::unique_ptr<AtomEntry> newEntry = std::make_unique<AtomEntry>();
+			newEntry->hash = hash;
+			newEntry->stringHash = atom.hash_;
+			newEntry->str = String(str);
+			entry = newEntry.get();
+			insertEntry(table, std::move(newEntry));
+		}
+#if defined(WITH_THREADS)
+		table.mutex.Unlock();
+#endif
+
+		atom.hash_ = entry->hash;
+		return atom;
+	}
+
+	Atom Atom::find(StringView str)
+	{
+		Atom atom(str);
+		if (atom.empty()) {
+			return atom;
+		}
+
+		const AtomEntry* entry = findEntryByString(atomTable().current.load(std::memory_order_acquire), atom.hash_, str);
+		atom.hash_ = (entry != nullptr ? entry->hash : Seed);
+		return atom;
+	}
+
+	StringView Atom::str() const
+	{
+		if (empty()) {
+			return { };
+		}
+
+		const AtomEntry* entry = findEntryByHash(atomTable().current.load(std::memory_order_acquire), hash_);
+		return (entry != nullptr ? StringView(entry->str) : StringView());
+	}
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "HashFunctions.h"
+
+#include <Containers/StringView.h>
+
+using namespace Death::Containers;
+
+namespace nCine
+{
+	/// A string identifier represented by its precomputed 32-bit hash
+	/*! Atoms are compared as integers and can be used as keys of `HashMap` without rehashing the string.
+		The string itself is stored in a global table only when it's interned, which also detects hash collisions.
+		Keys of containers should always be interned, literal atoms (`"Name"_atom`) are hashed at compile-time
+		and run-time strings should be converted by `find()`, which compares the interned string.
+		Lookups never lock the table, so they can be used every frame even if other threads intern new strings. */
+	class Atom
+	{
+	public:
+		/// Creates the atom of an empty string
+		constexpr Atom() noexcept
+			: hash_(Seed) {}
+		/// Creates the atom of a string without storing it in the global table
+		explicit constexpr Atom(StringView str) noexcept
+			: hash_(computeHash(str.data(), str.size())) {}
+
+		/// Creates the atom and stores the string in the global table, so it can be retrieved by `str()`
+		/*! If the hash is already used by a different string, an error is logged and the string is assigned another unused hash.
+			Such an atom can still be found by `find()`, but the literal atom or the constructor of the same string returns the other atom. */
+		static Atom intern(StringView str);
+		/// Returns the atom of an interned string, or an empty atom if the string was never interned
+		/*! Unlike the constructor, a different string with the same hash never matches. */
+		static Atom find(StringView str);
+
+		/// Returns the string of the atom, or an empty view if it was never interned
+		StringView str() const;
+
+		/// Returns the precomputed hash of the string
+		constexpr hash_t hash() const noexcept {
+			return hash_;
+		}
+		/// Returns `true` if it's the atom of an empty string
+		constexpr bool empty() const noexcept {
+			return (hash_ == Seed);
+		}
+
+		constexpr bool operator==(Atom other) const noexcept {
+			return (hash_ == other.hash_);
+		}
+		constexpr bool operator!=(Atom other) const noexcept {
+			return (hash_ != other.hash_);
+		}
+
+		/// Computes the FNV-1a hash of the string, the same function is used at compile-time and at run-time
+		static constexpr hash_t computeHash(const char* data, std::size_t size) noexcept
+		{
+			hash_t hash = Seed;
+			for (std::size_t i = 0; i < size; i++) {
+				hash = (static_cast<unsigned char>(data[i]) ^ hash) * Prime;
+			}
+			return hash;
+		}
+
+	private:
+		static constexpr hash_t Prime = 0x01000193; //  16777619
+		static constexpr hash_t Seed = 0x811C9DC5; // 2166136261
+
+		hash_t hash_;
+	};
+
+	/// Creates the atom of a string literal at compile-time
+	constexpr Atom operator"" _atom(const char* data, std::size_t size) noexcept
+	{
+		return Atom(StringView(data, size, StringViewFlags::Global | StringViewFlags::NullTerminated));
+	}
+
+	/// Hash function of atoms, it returns the precomputed hash
+	template <>
+	class FNV1aHashFunc<Atom>
+	{
+	public:
+		hash_t operator()(const Atom& atom) const {
+			return atom.hash();
+		}
+	};
+}
@@ -0,0 +1,671 @@
+#include "CpuDispatch.h"
+#include "../Primitives/SimdMath.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <type_traits>
+
+#include <Containers/Array.h>
+
+#if defined(DEATH_ENABLE_SSE2)
+#	include <IntrinsicsSse2.h>
+#endif
+#if defined(DEATH_ENABLE_AVX2)
+#	include <IntrinsicsAvx.h>
+#endif
+#if defined(DEATH_ENABLE_NEON) && !defined(DEATH_TARGET_32BIT)
+#	include <arm_neon.h>
+#endif
+
+namespace nCine
+{
+	namespace
+	{
+		using ExpandPaletteInPlaceFn = decltype(CpuDispatch::Kernels::ExpandPaletteInPlace);
+		using UnpackBitsFn = decltype(CpuDispatch::Kernels::UnpackBits);
+		using ClassifyMaskFn = decltype(CpuDispatch::Kernels::ClassifyMask);
+		using IsOpaqueFn = decltype(CpuDispatch::Kernels::IsOpaque);
+		using ConvertS8ToU8Fn = decltype(CpuDispatch::Kernels::ConvertS8ToU8);
+
+		/*
+			Each kernel has an overload taking a CPU tag for every implemented instruction set, `DEATH_CPU_DISPATCHER_BASE()`
+			then creates a function that picks the best overload for runtime features. Instruction sets without their own
+			overload fall back to the closest lower one, e.g. AVX uses the SSE2 implementation.
+		*/
+
+		DEATH_ALWAYS_INLINE uint32_t multiplyAlpha(uint32_t color, uint32_t alpha)
+		{
+			return (color & 0xffffff) | ((((color >> 24) & 0xff) * alpha / 255) << 24);
+		}
+
+		ExpandPaletteInPlaceFn expandPaletteInPlaceImplementation(Cpu::ScalarT)
+		{
+			return [](uint32_t* pixels, int32_t count, const uint32_t* palette) {
+				for (int32_t i = 0; i < count; i++) {
+					pixels[i] = multiplyAlpha(palette[pixels[i] & 0xff], pixels[i] >> 24);
+				}
+			};
+		}
+
+		UnpackBitsFn unpackBitsImplementation(Cpu::ScalarT)
+		{
+			return [](uint8_t* dest, const uint8_t* src, int32_t srcSize) {
+				for (int32_t i = 0; i < srcSize; i++) {
+					for (int32_t k = 0; k < 8; k++) {
+						dest[i * 8 + k] = ((src[i] >> k) & 0x01);
+					}
+				}
+			};
+		}
+
+		ClassifyMaskFn classifyMaskImplementation(Cpu::ScalarT)
+		{
+			return [](const uint8_t* mask, int32_t size) {
+				bool empty = true;
+				bool filled = true;
+				for (int32_t i = 0; i < size; i++) {
+					bool masked = (mask[i] != 0);
+					empty &= !masked;
+					filled &= masked;
+				}
+				return (empty ? MaskFlags::Empty : MaskFlags::None) | (filled ? MaskFlags::Filled : MaskFlags::None);
+			};
+		}
+
+		IsOpaqueFn isOpaqueImplementation(Cpu::ScalarT)
+		{
+			return [](const uint32_t* pixels, int32_t count) {
+				for (int32_t i = 0; i < count; i++) {
+					if ((pixels[i] >> 24) != 0xff) {
+						return false;
+					}
+				}
+				return true;
+			};
+		}
+
+		ConvertS8ToU8Fn convertS8ToU8Implementation(Cpu::ScalarT)
+		{
+			return [](uint8_t* dest, const uint8_t* src, int32_t count) {
+				for (int32_t i = 0; i < count; i++) {
+					dest[i] = (src[i] ^ 0x80);
+				}
+			};
+		}
+
+#if defined(DEATH_ENABLE_SSE2)
+		DEATH_ENABLE_SSE2 DEATH_ALWAYS_INLINE __m128i multiplyAlpha(Cpu::Sse2T, __m128i colors, __m128i alpha)
+		{
+			// Both factors are at most 255 and upper halves of all lanes are zero, so 16-bit multiplication is enough
+			const __m128i product = _mm_mullo_epi16(_mm_srli_epi32(colors, 24), alpha);
+			// (x + 1 + (x >> 8)) >> 8 is equal to x / 255 for all x <= 255 * 255
+			const __m128i quotient = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(product, _mm_set1_epi32(1)), _mm_srli_epi32(product, 8)), 8);
+			return _mm_or_si128(_mm_and_si128(colors, _mm_set1_epi32(0x00ffffff)), _mm_slli_epi32(quotient, 24));
+		}
+
+		DEATH_ENABLE_SSE2 ExpandPaletteInPlaceFn expandPaletteInPlaceImplementation(Cpu::Sse2T)
+		{
+			return [](uint32_t* pixels, int32_t count, const uint32_t* palette) DEATH_ENABLE_SSE2 {
+				int32_t i = 0;
+				for (; i + 4 <= count; i += 4) {
+					const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i));
+					const __m128i colors = _mm_setr_epi32((int)palette[pixels[i] & 0xff], (int)palette[pixels[i + 1] & 0xff],
+						(int)palette[pixels[i + 2] & 0xff], (int)palette[pixels[i + 3] & 0xff]);
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + i), multiplyAlpha(Cpu::Sse2, colors, _mm_srli_epi32(values, 24)));
+				}
+				for (; i < count; i++) {
+					pixels[i] = multiplyAlpha(palette[pixels[i] & 0xff], pixels[i] >> 24);
+				}
+			};
+		}
+
+		DEATH_ENABLE_SSE2 UnpackBitsFn unpackBitsImplementation(Cpu::Sse2T)
+		{
+			return [](uint8_t* dest, const uint8_t* src, int32_t srcSize) DEATH_ENABLE_SSE2 {
+				const __m128i bits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+				const __m128i one = _mm_set1_epi8(1);
+				int32_t i = 0;
+				// Two source bytes are broadcast to two halves of the vector and each lane tests one bit
+				for (; i + 2 <= srcSize; i += 2) {
+					const __m128i bytes = _mm_unpacklo_epi64(_mm_set1_epi8((char)src[i]), _mm_set1_epi8((char)src[i + 1]));
+					const __m128i set = _mm_cmpeq_epi8(_mm_and_si128(bytes, bits), bits);
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i * 8), _mm_and_si128(set, one));
+				}
+				for (; i < srcSize; i++) {
+					for (int32_t k = 0; k < 8; k++) {
+						dest[i * 8 + k] = ((src[i] >> k) & 0x01);
+					}
+				}
+			};
+		}
+
+		DEATH_ENABLE_SSE2 ClassifyMaskFn classifyMaskImplementation(Cpu::Sse2T)
+		{
+			return [](const uint8_t* mask, int32_t size) DEATH_ENABLE_SSE2 {
+				const __m128i zero = _mm_setzero_si128();
+				__m128i anyZero = zero;
+				__m128i allZero = _mm_set1_epi8(-1);
+				int32_t i = 0;
+				for (; i + 16 <= size; i += 16) {
+					const __m128i isZero = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(mask + i)), zero);
+					anyZero = _mm_or_si128(anyZero, isZero);
+					allZero = _mm_and_si128(allZero, isZero);
+				}
+				bool empty = (_mm_movemask_epi8(allZero) == 0xffff);
+				bool filled = (_mm_movemask_epi8(anyZero) == 0);
+				for (; i < size; i++) {
+					bool masked = (mask[i] != 0);
+					empty &= !masked;
+					filled &= masked;
+				}
+				return (empty ? MaskFlags::Empty : MaskFlags::None) | (filled ? MaskFlags::Filled : MaskFlags::None);
+			};
+		}
+
+		DEATH_ENABLE_SSE2 IsOpaqueFn isOpaqueImplementation(Cpu::Sse2T)
+		{
+			return [](const uint32_t* pixels, int32_t count) DEATH_ENABLE_SSE2 {
+				const __m128i alphaMask = _mm_set1_epi32((int)0xff000000);
+				__m128i all = alphaMask;
+				int32_t i = 0;
+				for (; i + 4 <= count; i += 4) {
+					all = _mm_and_si128(all, _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i)));
+				}
+				if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(all, alphaMask), alphaMask)) != 0xffff) {
+					return false;
+				}
+				for (; i < count; i++) {
+					if ((pixels[i] >> 24) != 0xff) {
+						return false;
+					}
+				}
+				return true;
+			};
+		}
+
+		DEATH_ENABLE_SSE2 ConvertS8ToU8Fn convertS8ToU8Implementation(Cpu::Sse2T)
+		{
+			return [](uint8_t* dest, const uint8_t* src, int32_t count) DEATH_ENABLE_SSE2 {
+				const __m128i signBits = _mm_set1_epi8(-128);
+				int32_t i = 0;
+				for (; i + 16 <= count; i += 16) {
+					const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), _mm_xor_si128(samples, signBits));
+				}
+				for (; i < count; i++) {
+					dest[i] = (src[i] ^ 0x80);
+				}
+			};
+		}
+#endif
+
+#if defined(DEATH_ENABLE_AVX2)
+		DEATH_ENABLE_AVX2 DEATH_ALWAYS_INLINE __m256i multiplyAlpha(Cpu::Avx2T, __m256i colors, __m256i alpha)
+		{
+			const __m256i product = _mm256_mullo_epi16(_mm256_srli_epi32(colors, 24), alpha);
+			const __m256i quotient = _mm256_srli_epi32(_mm256_add_epi32(_mm256_add_epi32(product, _mm256_set1_epi32(1)), _mm256_srli_epi32(product, 8)), 8);
+			return _mm256_or_si256(_mm256_and_si256(colors, _mm256_set1_epi32(0x00ffffff)), _mm256_slli_epi32(quotient, 24));
+		}
+
+		// Only palette expansion benefits from AVX2, because gather replaces scalar lookups of palette colors
+		DEATH_ENABLE_AVX2 ExpandPaletteInPlaceFn expandPaletteInPlaceImplementation(Cpu::Avx2T)
+		{
+			return [](uint32_t* pixels, int32_t count, const uint32_t* palette) DEATH_ENABLE_AVX2 {
+				const __m256i indexMask = _mm256_set1_epi32(0xff);
+				int32_t i = 0;
+				for (; i + 8 <= count; i += 8) {
+					const __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pixels + i));
+					const __m256i colors = _mm256_i32gather_epi32(reinterpret_cast<const int*>(palette), _mm256_and_si256(values, indexMask), 4);
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(pixels + i), multiplyAlpha(Cpu::Avx2, colors, _mm256_srli_epi32(values, 24)));
+				}
+				for (; i < count; i++) {
+					pixels[i] = multiplyAlpha(palette[pixels[i] & 0xff], pixels[i] >> 24);
+				}
+			};
+		}
+#endif
+
+#if defined(DEATH_ENABLE_NEON) && !defined(DEATH_TARGET_32BIT)
+		DEATH_ENABLE_NEON DEATH_ALWAYS_INLINE uint32x4_t multiplyAlpha(Cpu::NeonT, uint32x4_t colors, uint32x4_t alpha)
+		{
+			const uint32x4_t product = vmulq_u32(vshrq_n_u32(colors, 24), alpha);
+			// (x + 1 + (x >> 8)) >> 8 is equal to x / 255 for all x <= 255 * 255
+			const uint32x4_t quotient = vshrq_n_u32(vaddq_u32(vaddq_u32(product, vdupq_n_u32(1)), vshrq_n_u32(product, 8)), 8);
+			return vorrq_u32(vandq_u32(colors, vdupq_n_u32(0x00ffffff)), vshlq_n_u32(quotient, 24));
+		}
+
+		DEATH_ENABLE_NEON ExpandPaletteInPlaceFn expandPaletteInPlaceImplementation(Cpu::NeonT)
+		{
+			return [](uint32_t* pixels, int32_t count, const uint32_t* palette) DEATH_ENABLE_NEON {
+				int32_t i = 0;
+				for (; i + 4 <= count; i += 4) {
+					const uint32x4_t values = vld1q_u32(pixels + i);
+					const uint32_t colorsArray[4] = { palette[pixels[i] & 0xff], palette[pixels[i + 1] & 0xff],
+						palette[pixels[i + 2] & 0xff], palette[pixels[i + 3] & 0xff] };
+					vst1q_u32(pixels + i, multiplyAlpha(Cpu::Neon, vld1q_u32(colorsArray), vshrq_n_u32(values, 24)));
+				}
+				for (; i < count; i++) {
+					pixels[i] = multiplyAlpha(palette[pixels[i] & 0xff], pixels[i] >> 24);
+				}
+			};
+		}
+
+		DEATH_ENABLE_NEON UnpackBitsFn unpackBitsImplementation(Cpu::NeonT)
+		{
+			return [](uint8_t* dest, const uint8_t* src, int32_t srcSize) DEATH_ENABLE_NEON {
+				static const uint8_t BitsArray[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+				const uint8x16_t bits = vld1q_u8(BitsArray);
+				const uint8x16_t one = vdupq_n_u8(1);
+				int32_t i = 0;
+				for (; i + 2 <= srcSize; i += 2) {
+					const uint8x16_t bytes = vcombine_u8(vdup_n_u8(src[i]), vdup_n_u8(src[i + 1]));
+					vst1q_u8(dest + i * 8, vandq_u8(vtstq_u8(bytes, bits), one));
+				}
+				for (; i < srcSize; i++) {
+					for (int32_t k = 0; k < 8; k++) {
+						dest[i * 8 + k] = ((src[i] >> k) & 0x01);
+					}
+				}
+			};
+		}
+
+		DEATH_ENABLE_NEON ClassifyMaskFn classifyMaskImplementation(Cpu::NeonT)
+		{
+			return [](const uint8_t* mask, int32_t size) DEATH_ENABLE_NEON {
+				uint8x16_t anyZero = vdupq_n_u8(0);
+				uint8x16_t allZero = vdupq_n_u8(0xff);
+				int32_t i = 0;
+				for (; i + 16 <= size; i += 16) {
+					const uint8x16_t isZero = vceqq_u8(vld1q_u8(mask + i), vdupq_n_u8(0));
+					anyZero = vorrq_u8(anyZero, isZero);
+					allZero = vandq_u8(allZero, isZero);
+				}
+				bool empty = (vminvq_u8(allZero) == 0xff);
+				bool filled = (vmaxvq_u8(anyZero) == 0);
+				for (; i < size; i++) {
+					bool masked = (mask[i] != 0);
+					empty &= !masked;
+					filled &= masked;
+				}
+				return (empty ? MaskFlags::Empty : MaskFlags::None) | (filled ? MaskFlags::Filled : MaskFlags::None);
+			};
+		}
+
+		DEATH_ENABLE_NEON IsOpaqueFn isOpaqueImplementation(Cpu::NeonT)
+		{
+			return [](const uint32_t* pixels, int32_t count) DEATH_ENABLE_NEON {
+				uint32x4_t all = vdupq_n_u32(0xff000000);
+				int32_t i = 0;
+				for (; i + 4 <= count; i += 4) {
+					all = vandq_u32(all, vld1q_u32(pixels + i));
+				}
+				if (vminvq_u32(vshrq_n_u32(all, 24)) != 0xff) {
+					return false;
+				}
+				for (; i < count; i++) {
+					if ((pixels[i] >> 24) != 0xff) {
+						return false;
+					}
+				}
+				return true;
+			};
+		}
+
+		DEATH_ENABLE_NEON ConvertS8ToU8Fn convertS8ToU8Implementation(Cpu::NeonT)
+		{
+			return [](uint8_t* dest, const uint8_t* src, int32_t count) DEATH_ENABLE_NEON {
+				const uint8x16_t signBits = vdupq_n_u8(0x80);
+				int32_t i = 0;
+				for (; i + 16 <= count; i += 16) {
+					vst1q_u8(dest + i, veorq_u8(vld1q_u8(src + i), signBits));
+				}
+				for (; i < count; i++) {
+					dest[i] = (src[i] ^ 0x80);
+				}
+			};
+		}
+#endif
+
+		DEATH_CPU_DISPATCHER_BASE(expandPaletteInPlaceImplementation)
+		DEATH_CPU_DISPATCHER_BASE(unpackBitsImplementation)
+		DEATH_CPU_DISPATCHER_BASE(classifyMaskImplementation)
+		DEATH_CPU_DISPATCHER_BASE(isOpaqueImplementation)
+		DEATH_CPU_DISPATCHER_BASE(convertS8ToU8Implementation)
+
+		struct FeatureName {
+			const char* Name;
+			Cpu::Features Value;
+		};
+
+		// Base instruction sets in ascending order of priority, the scalar one is always the first
+		constexpr FeatureName BaseFeatures[] = {
+			{ "scalar", Cpu::Scalar },
+#if defined(DEATH_TARGET_X86)
+			{ "sse2", Cpu::Sse2 },
+			{ "sse3", Cpu::Sse3 },
+			{ "ssse3", Cpu::Ssse3 },
+			{ "sse41", Cpu::Sse41 },
+			{ "sse42", Cpu::Sse42 },
+			{ "avx", Cpu::Avx },
+			{ "avx2", Cpu::Avx2 },
+			{ "avx512f", Cpu::Avx512f },
+#elif defined(DEATH_TARGET_ARM)
+			{ "neon", Cpu::Neon },
+			{ "neonfma", Cpu::NeonFma },
+			{ "neonfp16", Cpu::NeonFp16 },
+#elif defined(DEATH_TARGET_WASM)
+			{ "simd128", Cpu::Simd128 },
+#endif
+		};
+
+		constexpr int32_t SelfTestSizes[] = { 0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33, 64, 1000, 1031 };
+		constexpr int32_t SelfTestMaxSize = 1031;
+		constexpr int32_t SelfTestPatternCount = 4;
+
+		struct SelfTestData {
+			uint32_t Palette[256];
+			// One more item than needed, so unaligned access can be tested too
+			uint32_t Pixels[SelfTestMaxSize + 1];
+			uint8_t Bytes[SelfTestMaxSize + 1];
+			uint32_t ExpectedPixels[SelfTestMaxSize + 1];
+			uint32_t ActualPixels[SelfTestMaxSize + 1];
+			uint8_t ExpectedBytes[(SelfTestMaxSize + 1) * 8];
+			uint8_t ActualBytes[(SelfTestMaxSize + 1) * 8];
+		};
+
+		uint32_t nextRandom(uint32_t& state)
+		{
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+			return state;
+		}
+
+		void fillSelfTestData(SelfTestData& data, int32_t pattern, uint32_t& state)
+		{
+			// Patterns cover random data and edge cases of the mask and opacity tests
+			for (int32_t i = 0; i < 256; i++) {
+				data.Palette[i] = nextRandom(state);
+			}
+			for (int32_t i = 0; i < SelfTestMaxSize + 1; i++) {
+				uint32_t value = nextRandom(state);
+				switch (pattern) {
+					default:
+						data.Pixels[i] = value;
+						data.Bytes[i] = ((value & 0x100) != 0 ? (uint8_t)value : 0);
+						break;
+					case 1:
+						data.Pixels[i] = value | 0xff000000;
+						data.Bytes[i] = 0;
+						break;
+					case 2:
+					case 3:
+						data.Pixels[i] = value | 0xff000000;
+						data.Bytes[i] = (uint8_t)(value | 0x01);
+						break;
+				}
+			}
+		}
+
+		bool testKernel(const char* kernelName, const char* featureName, int32_t size, bool matches)
+		{
+			if (!matches) {
+				LOGE_X("Kernel \"%s\" (%s) doesn't match the scalar implementation for %i items", kernelName, featureName, size);
+			}
+			return matches;
+		}
+
+		bool testKernels(SelfTestData& data, const CpuDispatch::Kernels& reference, const CpuDispatch::Kernels& previous,
+			const CpuDispatch::Kernels& tested, const char* featureName, int32_t& testedCount)
+		{
+			// Only implementations that weren't tested yet are compared with the scalar implementation
+			const bool testExpandPaletteInPlace = (tested.ExpandPaletteInPlace != reference.ExpandPaletteInPlace && tested.ExpandPaletteInPlace != previous.ExpandPaletteInPlace);
+			const bool testUnpackBits = (tested.UnpackBits != reference.UnpackBits && tested.UnpackBits != previous.UnpackBits);
+			const bool testClassifyMask = (tested.ClassifyMask != reference.ClassifyMask && tested.ClassifyMask != previous.ClassifyMask);
+			const bool testIsOpaque = (tested.IsOpaque != reference.IsOpaque && tested.IsOpaque != previous.IsOpaque);
+			const bool testConvertS8ToU8 = (tested.ConvertS8ToU8 != reference.ConvertS8ToU8 && tested.ConvertS8ToU8 != previous.ConvertS8ToU8);
+			testedCount += (int32_t)testExpandPaletteInPlace + (int32_t)testUnpackBits +
+				(int32_t)testClassifyMask + (int32_t)testIsOpaque + (int32_t)testConvertS8ToU8;
+
+			bool success = true;
+			uint32_t state = 0x2545F491;
+			for (int32_t pattern = 0; pattern < SelfTestPatternCount; pattern++) {
+				fillSelfTestData(data, pattern, state);
+
+				for (int32_t size : SelfTestSizes) {
+					for (int32_t offset = 0; offset < 2; offset++) {
+						if (size + offset > SelfTestMaxSize + 1) {
+							continue;
+						}
+						if (pattern == 3 && size > 0) {
+							// The last item breaks the otherwise filled mask and opaque pixels
+							data.Bytes[offset + size - 1] = 0;
+							data.Pixels[offset + size - 1] &= 0x00ffffff;
+						}
+
+						const uint32_t* pixels = data.Pixels + offset;
+						const uint8_t* bytes = data.Bytes + offset;
+
+						if (testExpandPaletteInPlace) {
+							std::memcpy(data.ExpectedPixels + offset, pixels, size * sizeof(uint32_t));
+							std::memcpy(data.ActualPixels + offset, pixels, size * sizeof(uint32_t));
+							reference.ExpandPaletteInPlace(data.ExpectedPixels + offset, size, data.Palette);
+							tested.ExpandPaletteInPlace(data.ActualPixels + offset, size, data.Palette);
+							success &= testKernel("ExpandPaletteInPlace", featureName, size,
+								std::memcmp(data.ExpectedPixels + offset, data.ActualPixels + offset, size * sizeof(uint32_t)) == 0);
+						}
+						if (testUnpackBits) {
+							reference.UnpackBits(data.ExpectedBytes + offset, bytes, size);
+							tested.UnpackBits(data.ActualBytes + offset, bytes, size);
+							success &= testKernel("UnpackBits", featureName, size,
+								std::memcmp(data.ExpectedBytes + offset, data.ActualBytes + offset, size * 8) == 0);
+						}
+						if (testClassifyMask) {
+							success &= testKernel("ClassifyMask", featureName, size,
+								reference.ClassifyMask(bytes, size) == tested.ClassifyMask(bytes, size));
+						}
+						if (testIsOpaque) {
+							success &= testKernel("IsOpaque", featureName, size,
+								reference.IsOpaque(pixels, size) == tested.IsOpaque(pixels, size));
+						}
+						if (testConvertS8ToU8) {
+							reference.ConvertS8ToU8(data.ExpectedBytes + offset, bytes, size);
+							tested.ConvertS8ToU8(data.ActualBytes + offset, bytes, size);
+							success &= testKernel("ConvertS8ToU8", featureName, size,
+								std::memcmp(data.ExpectedBytes + offset, data.ActualBytes + offset, size) == 0);
+						}
+
+						if (pattern == 3 && size > 0) {
+							data.Bytes[offset + size - 1] = 0x01;
+							data.Pixels[offset + size - 1] |= 0xff000000;
+						}
+					}
+				}
+			}
+			return success;
+		}
+
+		/// Compares results of a kernel, each result can differ by a few rounding errors of the sum of absolute values of its terms
+		/*! Fast-math may contract or reorder operations of any implementation, so results are not bit-exact. The error of a sum is
+			bounded relative to magnitudes of its terms, not to the result itself, which can be close to zero after cancellation.
+			If `magnitudes` is `nullptr`, results must match exactly. */
+		bool testMatrixKernel(const char* kernelName, const float* expected, const float* actual, const float* magnitudes, int32_t count)
+		{
+			// Each result has at most 4 rounding errors (a multiplication and 3 additions), so two results differ by at most 8
+			constexpr float MaxRoundingErrors = 8.0f;
+			for (int32_t i = 0; i < count; i++) {
+				float tolerance = (magnitudes != nullptr ? MaxRoundingErrors * std::numeric_limits<float>::epsilon() * magnitudes[i] : 0.0f);
+				if (!(std::abs(expected[i] - actual[i]) <= tolerance)) {
+					LOGE_X("Matrix kernel \"%s\" (%s) returned %f instead of %f", kernelName, CpuDispatch::GetFeatureName(Cpu::DefaultBase), actual[i], expected[i]);
+					return false;
+				}
+			}
+			return true;
+		}
+
+		bool testMatrixKernels(int32_t& testedCount)
+		{
+			// Matrix kernels are selected at compile-time, so only the default implementation can be compared to the scalar one
+			constexpr bool IsScalar = std::is_same<typename std::decay<decltype(Cpu::DefaultBase)>::type, Cpu::ScalarT>::value;
+
+			constexpr int32_t Iterations = 64;
+			testedCount += (IsScalar ? 1 : 5);
+
+			bool success = true;
+			uint32_t state = 0x2545F491;
+			for (int32_t i = 0; i < Iterations && success; i++) {
+				float a[16], b[16], absA[16], absB[16], expected[16], actual[16], magnitudes[16];
+				for (int32_t j = 0; j < 16; j++) {
+					// Values in range [-64, 64) with a fractional part, like coordinates of a transformation
+					a[j] = (float)(int32_t)(nextRandom(state) & 0xffff) / 512.0f - 64.0f;
+					b[j] = (float)(int32_t)(nextRandom(state) & 0xffff) / 512.0f - 64.0f;
+				}
+				// The matrix must not be symmetric, otherwise `v * m` and `m * v` would be the same
+				a[1] = a[4] + 1.0f;
+				for (int32_t j = 0; j < 16; j++) {
+					absA[j] = std::abs(a[j]);
+					absB[j] = std::abs(b[j]);
+				}
+
+				if constexpr (!IsScalar) {
+					SimdMath::MultiplyMatrices(Cpu::Scalar, a, b, expected);
+					SimdMath::MultiplyMatrices(Cpu::DefaultBase, a, b, actual);
+					SimdMath::MultiplyMatrices(Cpu::Scalar, absA, absB, magnitudes);
+					success &= testMatrixKernel("MultiplyMatrices", expected, actual, magnitudes, 16);
+
+					SimdMath::MultiplyMatrixVector(Cpu::Scalar, a, b, expected);
+					SimdMath::MultiplyMatrixVector(Cpu::DefaultBase, a, b, actual);
+					SimdMath::MultiplyMatrixVector(Cpu::Scalar, absA, absB, magnitudes);
+					success &= testMatrixKernel("MultiplyMatrixVector", expected, actual, magnitudes, 4);
+
+					SimdMath::MultiplyVectorMatrix(Cpu::Scalar, b, a, expected);
+					SimdMath::MultiplyVectorMatrix(Cpu::DefaultBase, b, a, actual);
+					SimdMath::MultiplyVectorMatrix(Cpu::Scalar, absB, absA, magnitudes);
+					success &= testMatrixKernel("MultiplyVectorMatrix", expected, actual, magnitudes, 4);
+
+					SimdMath::Transpose(Cpu::Scalar, a, expected);
+					SimdMath::Transpose(Cpu::DefaultBase, a, actual);
+					success &= testMatrixKernel("Transpose", expected, actual, nullptr, 16);
+				}
+
+				// `v * m` must be the same as `transpose(m) * v`, so a kernel that uses columns instead of rows is detected
+				float transposed[16];
+				SimdMath::Transpose(Cpu::DefaultBase, a, transposed);
+				SimdMath::MultiplyMatrixVector(Cpu::DefaultBase, transposed, b, expected);
+				SimdMath::MultiplyVectorMatrix(Cpu::DefaultBase, b, a, actual);
+				SimdMath::MultiplyVectorMatrix(Cpu::Scalar, absB, absA, magnitudes);
+				success &= testMatrixKernel("MultiplyVectorMatrix (transposed)", expected, actual, magnitudes, 4);
+			}
+			return success;
+		}
+	}
+
+	Cpu::Features CpuDispatch::_features = Cpu::runtimeFeatures();
+	CpuDispatch::Kernels CpuDispatch::_kernels = CpuDispatch::ResolveKernels(Cpu::runtimeFeatures());
+
+	Cpu::Features CpuDispatch::GetFeatures()
+	{
+		return _features;
+	}
+
+	const char* CpuDispatch::GetFeatureName(Cpu::Features features)
+	{
+		for (int32_t i = (int32_t)countof(BaseFeatures) - 1; i > 0; i--) {
+			if (features & BaseFeatures[i].Value) {
+				return BaseFeatures[i].Name;
+			}
+		}
+		return BaseFeatures[0].Name;
+	}
+
+	bool CpuDispatch::ParseFeatures(StringView value, Cpu::Features& features)
+	{
+		Cpu::Features result;
+		bool isEmpty = true;
+		for (StringView name : value.splitWithoutEmptyParts(',')) {
+			name = name.trimmed();
+			isEmpty = false;
+
+			bool found = false;
+			for (const auto& feature : BaseFeatures) {
+				if (name == feature.Name) {
+					result |= feature.Value;
+					found = true;
+					break;
+				}
+			}
+			if (!found) {
+				return false;
+			}
+		}
+		if (isEmpty) {
+			// Use "scalar" explicitly to disable all instruction sets
+			return false;
+		}
+
+		features = result;
+		return true;
+	}
+
+	void CpuDispatch::OverrideFeatures(Cpu::Features features)
+	{
+		const Cpu::Features supportedFeatures = Cpu::runtimeFeatures();
+		if (!(supportedFeatures >= features)) {
+			LOGW("Some of requested CPU features are not supported and will be ignored");
+		}
+
+		_features = features & supportedFeatures;
+		_kernels = ResolveKernels(_features);
+	}
+
+	CpuDispatch::Kernels CpuDispatch::ResolveKernels(Cpu::Features features)
+	{
+		Kernels kernels;
+		kernels.ExpandPaletteInPlace = expandPaletteInPlaceImplementation(features);
+		kernels.UnpackBits = unpackBitsImplementation(features);
+		kernels.ClassifyMask = classifyMaskImplementation(features);
+		kernels.IsOpaque = isOpaqueImplementation(features);
+		kernels.ConvertS8ToU8 = convertS8ToU8Implementation(features);
+		return kernels;
+	}
+
+	bool CpuDispatch::RunSelfTest()
+	{
+		LOGI("Testing dispatched kernels...");
+
+		const Cpu::Features supportedFeatures = Cpu::runtimeFeatures();
+		const Kernels reference = ResolveKernels(Cpu::Scalar);
+		Kernels previous = reference;
+		std::unique_ptr<SelfTestData> data = std::make_unique<SelfTestData>();
+
+		bool success = true;
+		int32_t testedCount = 0;
+		for (const auto& feature : BaseFeatures) {
+			if (!(supportedFeatures >= feature.Value)) {
+				continue;
+			}
+
+			Kernels kernels = ResolveKernels(feature.Value);
+			success &= testKernels(*data, reference, previous, kernels, feature.Name, testedCount);
+			previous = kernels;
+		}
+
+		// Matrix kernels can't be replaced at runtime, so a mismatch is only reported
+		const bool matricesMatch = testMatrixKernels(testedCount);
+
+		if (!success) {
+			// Results would differ between machines, so it's safer to use the reference implementation everywhere
+			LOGE("Some dispatched kernels don't match the scalar implementation, falling back to scalar kernels");
+			OverrideFeatures(Cpu::Scalar);
+			return false;
+		}
+		if (!matricesMatch) {
+			return false;
+		}
+
+		LOGI_X("All %i dispatched kernel implementations match the scalar implementation", testedCount);
+		return true;
+	}
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "../../Common.h"
+
+#include <Cpu.h>
+#include <Containers/StringView.h>
+
+using namespace Death;
+using namespace Death::Containers;
+
+namespace nCine
+{
+	/// Result of the `CpuDispatch::ClassifyMask()` kernel
+	enum class MaskFlags {
+		None = 0x00,
+		/// All bytes of the mask are zero
+		Empty = 0x01,
+		/// All bytes of the mask are non-zero
+		Filled = 0x02
+	};
+
+	DEFINE_ENUM_OPERATORS(MaskFlags);
+
+	/// Hot kernels with multiple implementations that are selected at runtime by features of the current CPU
+	/*! Function pointers of all kernels are resolved once at startup from `Cpu::runtimeFeatures()`. The scalar implementation
+		of each kernel is the reference, all other implementations must produce exactly the same results.
+		Features used for the selection can be restricted by `OverrideFeatures()` to test the fallback paths. */
+	class CpuDispatch
+	{
+	public:
+		/// Function pointers of all dispatched kernels
+		struct Kernels {
+			void(*ExpandPaletteInPlace)(uint32_t* pixels, int32_t count, const uint32_t* palette);
+			void(*UnpackBits)(uint8_t* dest, const uint8_t* src, int32_t srcSize);
+			MaskFlags(*ClassifyMask)(const uint8_t* mask, int32_t size);
+			bool(*IsOpaque)(const uint32_t* pixels, int32_t count);
+			void(*ConvertS8ToU8)(uint8_t* dest, const uint8_t* src, int32_t count);
+		};
+
+		CpuDispatch() = delete;
+		~CpuDispatch() = delete;
+
+		/// Returns features that were used to select the current kernels
+		static Cpu::Features GetFeatures();
+		/// Returns name of the best base instruction set of the specified features
+		static const char* GetFeatureName(Cpu::Features features);
+		/// Parses a comma-separated list of instruction set names (e.g. `sse2,avx2` or `scalar`), an empty list is not valid
+		static bool ParseFeatures(StringView value, Cpu::Features& features);
+		/// Selects kernels using only the specified features, unsupported features are ignored
+		static void OverrideFeatures(Cpu::Features features);
+		/// Returns kernels that would be selected for the specified features
+		static Kernels ResolveKernels(Cpu::Features features);
+		/// Runs all implementations supported by the current CPU and compares results with the scalar implementation
+		static bool RunSelfTest();
+
+		/// Replaces RGBA pixels with 8-bit palette index in the red channel by the palette color, alpha of the color is multiplied
+		static void ExpandPaletteInPlace(uint32_t* pixels, int32_t count, const uint32_t* palette) {
+			_kernels.ExpandPaletteInPlace(pixels, count, palette);
+		}
+		/// Expands each bit (the lowest first) to a byte with value 0 or 1, the destination must have `srcSize * 8` bytes
+		static void UnpackBits(uint8_t* dest, const uint8_t* src, int32_t srcSize) {
+			_kernels.UnpackBits(dest, src, srcSize);
+		}
+		/// Returns whether all bytes of the mask are zero or non-zero
+		static MaskFlags ClassifyMask(const uint8_t* mask, int32_t size) {
+			return _kernels.ClassifyMask(mask, size);
+		}
+		/// Returns `true` if all RGBA pixels are fully opaque
+		static bool IsOpaque(const uint32_t* pixels, int32_t count) {
+			return _kernels.IsOpaque(pixels, count);
+		}
+		/// Converts signed 8-bit PCM samples to unsigned, the destination can be the same as the source
+		static void ConvertS8ToU8(uint8_t* dest, const uint8_t* src, int32_t count) {
+			_kernels.ConvertS8ToU8(dest, src, count);
+		}
+
+	private:
+		static Cpu::Features _features;
+		static Kernels _kernels;
+	};
+}
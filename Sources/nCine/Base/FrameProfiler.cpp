@@ -0,0 +1,204 @@
+#if defined(NCINE_PROFILING)
+
+#include "FrameProfiler.h"
+#include "../IO/FileSystem.h"
+#include "../../Common.h"
+
+#include <algorithm>
+#include <cstdio> // for snprintf()
+#include <cstring> // for strcmp()
+
+namespace nCine
+{
+	namespace
+	{
+		/// Returns the number of characters actually written by `snprintf()` to a buffer of the specified size
+		int clampLength(int length, int bufferSize)
+		{
+			return (bufferSize > 0 ? std::clamp(length, 0, bufferSize - 1) : 0);
+		}
+	}
+
+	const char* FrameProfiler::zoneNames_[MaxZones];
+	unsigned int FrameProfiler::zoneCount_ = 0;
+	float FrameProfiler::currentZoneTimes_[MaxZones];
+	TimeStamp FrameProfiler::frameStartTime_;
+	unsigned long FrameProfiler::frameIndex_ = 0;
+
+	FrameProfiler::Frame FrameProfiler::frames_[MaxFrames];
+	unsigned int FrameProfiler::nextFrame_ = 0;
+	unsigned int FrameProfiler::frameCount_ = 0;
+
+	unsigned int FrameProfiler::registerZone(const char* name)
+	{
+		for (unsigned int i = 0; i < zoneCount_; i++) {
+			if (zoneNames_[i] == name || strcmp(zoneNames_[i], name) == 0) {
+				return i;
+			}
+		}
+
+		if (zoneCount_ >= MaxZones) {
+			LOGW_X("Cannot register profiler zone \"%s\", the maximum of %u zones has been reached", name, MaxZones);
+			return MaxZones;
+		}
+
+		zoneNames_[zoneCount_] = name;
+		currentZoneTimes_[zoneCount_] = 0.0f;
+		return zoneCount_++;
+	}
+
+	void FrameProfiler::addZoneTime(unsigned int zoneIndex, float milliseconds)
+	{
+		if (zoneIndex < zoneCount_) {
+			currentZoneTimes_[zoneIndex] += milliseconds;
+		}
+	}
+
+	void FrameProfiler::beginFrame()
+	{
+		frameStartTime_ = TimeStamp::now();
+	}
+
+	void FrameProfiler::endFrame()
+	{
+		Frame& frame = frames_[nextFrame_];
+		frame.index = frameIndex_++;
+		frame.frameTime = frameStartTime_.millisecondsSince();
+		for (unsigned int i = 0; i < zoneCount_; i++) {
+			frame.zoneTimes[i] = currentZoneTimes_[i];
+			currentZoneTimes_[i] = 0.0f;
+		}
+		// Zones registered later have no data in older frames
+		for (unsigned int i = zoneCount_; i < MaxZones; i++) {
+			frame.zoneTimes[i] = 0.0f;
+		}
+
+		nextFrame_ = (nextFrame_ + 1) % MaxFrames;
+		if (frameCount_ < MaxFrames) {
+			frameCount_++;
+		}
+	}
+
+	float FrameProfiler::frameTime(unsigned int framesAgo)
+	{
+		return (framesAgo < frameCount_ ? frame(framesAgo).frameTime : 0.0f);
+	}
+
+	float FrameProfiler::zoneTime(unsigned int zoneIndex, unsigned int framesAgo)
+	{
+		return (zoneIndex < zoneCount_ && framesAgo < frameCount_ ? frame(framesAgo).zoneTimes[zoneIndex] : 0.0f);
+	}
+
+	float FrameProfiler::averageZoneTime(unsigned int zoneIndex)
+	{
+		if (zoneIndex >= zoneCount_ || frameCount_ == 0) {
+			return 0.0f;
+		}
+
+		float sum = 0.0f;
+		for (unsigned int i = 0; i < frameCount_; i++) {
+			sum += frames_[i].zoneTimes[zoneIndex];
+		}
+		return sum / frameCount_;
+	}
+
+	FrameProfiler::Percentiles FrameProfiler::frameTimePercentiles()
+	{
+		Percentiles result = { 0.0f, 0.0f, 0.0f };
+		if (frameCount_ == 0) {
+			return result;
+		}
+
+		float sortedTimes[MaxFrames];
+		for (unsigned int i = 0; i < frameCount_; i++) {
+			sortedTimes[i] = frames_[i].frameTime;
+		}
+		std::sort(sortedTimes, sortedTimes + frameCount_);
+
+		// Nearest-rank method
+		const unsigned int last = frameCount_ - 1;
+		result.p50 = sortedTimes[(last * 50 + 50) / 100];
+		result.p95 = sortedTimes[(last * 95 + 50) / 100];
+		result.p99 = sortedTimes[(last * 99 + 50) / 100];
+		return result;
+	}
+
+	bool FrameProfiler::exportCsv(const StringView& path)
+	{
+		auto so = fs::Open(path, FileAccessMode::Write);
+		if (!so->IsOpened()) {
+			LOGE_X("Cannot open file \"%s\" for writing", String::nullTerminatedView(path).data());
+			return false;
+		}
+
+		char buffer[128];
+		int length = clampLength(snprintf(buffer, sizeof(buffer), "Frame,Frame Time"), sizeof(buffer));
+		so->Write(buffer, length);
+		for (unsigned int i = 0; i < zoneCount_; i++) {
+			length = clampLength(snprintf(buffer, sizeof(buffer), ",%s", zoneNames_[i]), sizeof(buffer));
+			so->Write(buffer, length);
+		}
+		so->Write("\n", 1);
+
+		// From the oldest to the newest frame
+		for (int i = frameCount_ - 1; i >= 0; i--) {
+			const Frame& f = frame(i);
+			length = clampLength(snprintf(buffer, sizeof(buffer), "%lu,%.3f", f.index, f.frameTime), sizeof(buffer));
+			so->Write(buffer, length);
+			for (unsigned int j = 0; j < zoneCount_; j++) {
+				length = clampLength(snprintf(buffer, sizeof(buffer), ",%.3f", f.zoneTimes[j]), sizeof(buffer));
+				so->Write(buffer, length);
+			}
+			so->Write("\n", 1);
+		}
+
+		LOGI_X("Profiler data of %u frames saved to \"%s\"", frameCount_, String::nullTerminatedView(path).data());
+		return true;
+	}
+
+	bool FrameProfiler::exportJson(const StringView& path)
+	{
+		auto so = fs::Open(path, FileAccessMode::Write);
+		if (!so->IsOpened()) {
+			LOGE_X("Cannot open file \"%s\" for writing", String::nullTerminatedView(path).data());
+			return false;
+		}
+
+		char buffer[128];
+		const Percentiles percentiles = frameTimePercentiles();
+		int length = clampLength(snprintf(buffer, sizeof(buffer), "{\n\t\"percentiles\": { \"p50\": %.3f, \"p95\": %.3f, \"p99\": %.3f },\n\t\"zones\": [",
+			percentiles.p50, percentiles.p95, percentiles.p99), sizeof(buffer));
+		so->Write(buffer, length);
+		for (unsigned int i = 0; i < zoneCount_; i++) {
+			length = clampLength(snprintf(buffer, sizeof(buffer), i == 0 ? "\"%s\"" : ", \"%s\"", zoneNames_[i]), sizeof(buffer));
+			so->Write(buffer, length);
+		}
+		length = clampLength(snprintf(buffer, sizeof(buffer), "],\n\t\"frames\": [\n"), sizeof(buffer));
+		so->Write(buffer, length);
+
+		// From the oldest to the newest frame, zone times are in the same order as zone names
+		for (int i = frameCount_ - 1; i >= 0; i--) {
+			const Frame& f = frame(i);
+			length = clampLength(snprintf(buffer, sizeof(buffer), "\t\t{ \"frame\": %lu, \"frameTime\": %.3f, \"zoneTimes\": [", f.index, f.frameTime), sizeof(buffer));
+			so->Write(buffer, length);
+			for (unsigned int j = 0; j < zoneCount_; j++) {
+				length = clampLength(snprintf(buffer, sizeof(buffer), j == 0 ? "%.3f" : ", %.3f", f.zoneTimes[j]), sizeof(buffer));
+				so->Write(buffer, length);
+			}
+			length = clampLength(snprintf(buffer, sizeof(buffer), i > 0 ? "] },\n" : "] }\n"), sizeof(buffer));
+			so->Write(buffer, length);
+		}
+		length = clampLength(snprintf(buffer, sizeof(buffer), "\t]\n}\n"), sizeof(buffer));
+		so->Write(buffer, length);
+
+		LOGI_X("Profiler data of %u frames saved to \"%s\"", frameCount_, String::nullTerminatedView(path).data());
+		return true;
+	}
+
+	const FrameProfiler::Frame& FrameProfiler::frame(unsigned int framesAgo)
+	{
+		return frames_[(nextFrame_ + MaxFrames - 1 - framesAgo) % MaxFrames];
+	}
+}
+
+#endif
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "../tracy.h"
+
+#if defined(NCINE_PROFILING)
+
+#include "TimeStamp.h"
+
+#include <Containers/StringView.h>
+
+using namespace Death::Containers;
+
+namespace nCine
+{
+	/// A class recording named zones of the last frames for the in-game profiler
+	/*! Zones with the same name are accumulated, nested zones are inclusive. */
+	class FrameProfiler
+	{
+	public:
+		static constexpr unsigned int MaxZones = 32;
+		static constexpr unsigned int MaxFrames = 512;
+
+		struct Percentiles
+		{
+			float p50;
+			float p95;
+			float p99;
+		};
+
+		/// Measures the time spent in a scope and adds it to the specified zone
+		class ScopedZone
+		{
+		public:
+			explicit ScopedZone(unsigned int zoneIndex)
+				: zoneIndex_(zoneIndex), startTime_(TimeStamp::now()) {}
+			~ScopedZone() {
+				addZoneTime(zoneIndex_, startTime_.millisecondsSince());
+			}
+
+		private:
+			unsigned int zoneIndex_;
+			TimeStamp startTime_;
+
+			ScopedZone(const ScopedZone&) = delete;
+			ScopedZone& operator=(const ScopedZone&) = delete;
+		};
+
+		/// Returns the index of the zone with the specified name, the zone is created if it doesn't exist
+		/*! The name must stay valid for the whole lifetime of the application, usually a string literal. */
+		static unsigned int registerZone(const char* name);
+		/// Adds time in milliseconds to the specified zone in the current frame
+		static void addZoneTime(unsigned int zoneIndex, float milliseconds);
+
+		/// Starts recording a new frame
+		static void beginFrame();
+		/// Stores the current frame into the history
+		static void endFrame();
+
+		/// Returns the number of registered zones
+		static inline unsigned int zoneCount() {
+			return zoneCount_;
+		}
+		/// Returns the name of the specified zone
+		static inline const char* zoneName(unsigned int zoneIndex) {
+			return (zoneIndex < zoneCount_ ? zoneNames_[zoneIndex] : "");
+		}
+		/// Returns the number of frames in the history
+		static inline unsigned int frameCount() {
+			return frameCount_;
+		}
+
+		/// Returns the duration of a frame in milliseconds, `0` is the last completed frame
+		static float frameTime(unsigned int framesAgo);
+		/// Returns the time spent in the zone in milliseconds, `0` is the last completed frame
+		static float zoneTime(unsigned int zoneIndex, unsigned int framesAgo);
+		/// Returns the average time spent in the zone over all frames in the history
+		static float averageZoneTime(unsigned int zoneIndex);
+		/// Returns 50th, 95th and 99th percentiles of frame durations in the history
+		static Percentiles frameTimePercentiles();
+
+		/// Saves all frames in the history as a CSV file with one row per frame
+		static bool exportCsv(const StringView& path);
+		/// Saves all frames in the history as a JSON file
+		static bool exportJson(const StringView& path);
+
+	private:
+		struct Frame
+		{
+			unsigned long index;
+			float frameTime;
+			float zoneTimes[MaxZones];
+		};
+
+		static const char* zoneNames_[MaxZones];
+		static unsigned int zoneCount_;
+		static float currentZoneTimes_[MaxZones];
+		static TimeStamp frameStartTime_;
+		static unsigned long frameIndex_;
+
+		static Frame frames_[MaxFrames];
+		static unsigned int nextFrame_;
+		static unsigned int frameCount_;
+
+		static const Frame& frame(unsigned int framesAgo);
+	};
+}
+
+/// Marks a zone both for Tracy and for the in-game frame profiler, only one zone can be used in a scope
+#	define ProfilerZoneScopedN(name) \
+		ZoneScopedN(name); \
+		static const unsigned int nCineFrameProfilerZoneIndex = nCine::FrameProfiler::registerZone(name); \
+		nCine::FrameProfiler::ScopedZone nCineFrameProfilerZone(nCineFrameProfilerZoneIndex)
+
+#else
+
+#	define ProfilerZoneScopedN(name) ZoneScopedN(name)
+
+#endif
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+namespace nCine
+{
+	template<class Signature>
+	class FunctionRef;
+
+	/// A non-owning reference to a callable object
+	/*! Unlike `std::function`, it never allocates, so it's suitable for callbacks invoked many times per frame.
+		The referenced object must outlive the reference, it's usually a lambda passed as a function argument. */
+	template<class R, class... Args>
+	class FunctionRef<R(Args...)>
+	{
+	public:
+		template<class F, class = typename std::enable_if<!std::is_same<typename std::decay<F>::type, FunctionRef>::value &&
+			std::is_invocable_r<R, F&, Args...>::value>::type>
+		FunctionRef(F&& function) noexcept
+			: object_(const_cast<void*>(static_cast<const void*>(std::addressof(function)))), callback_(invoke<typename std::remove_reference<F>::type>) {}
+
+		inline R operator()(Args... args) const {
+			return callback_(object_, std::forward<Args>(args)...);
+		}
+
+	private:
+		void* object_;
+		R(*callback_)(void*, Args...);
+
+		template<class F>
+		static R invoke(void* object, Args... args) {
+			return (*static_cast<F*>(object))(std::forward<Args>(args)...);
+		}
+	};
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace nCine
+{
+	/// The interface class for custom memory allocators
+	/*! Deallocation is sized, the same size and alignment that were passed to `allocate()` must be passed back. */
+	class IAllocator
+	{
+	public:
+		static constexpr std::size_t DefaultAlignment = alignof(std::max_align_t);
+
+		explicit IAllocator(const char* name)
+			: name_(name) {}
+		virtual ~IAllocator() = default;
+
+		/// Allocates a block of memory, returns `nullptr` if the request cannot be satisfied
+		virtual void* allocate(std::size_t bytes, std::size_t alignment = DefaultAlignment) = 0;
+		/// Releases a block of memory that was returned by `allocate()`
+		virtual void deallocate(void* ptr, std::size_t bytes, std::size_t alignment = DefaultAlignment) = 0;
+
+		/// Returns the name of the allocator
+		inline const char* name() const {
+			return name_;
+		}
+
+		/// Allocates memory for an object and constructs it, returns `nullptr` if the allocation fails
+		template<class T, typename... Args>
+		T* newObject(Args&&... args)
+		{
+			void* ptr = allocate(sizeof(T), alignof(T));
+			return (ptr != nullptr ? new(ptr) T(std::forward<Args>(args)...) : nullptr);
+		}
+
+		/// Destructs an object created with `newObject()` and releases its memory
+		template<class T>
+		void deleteObject(T* ptr)
+		{
+			if (ptr != nullptr) {
+				ptr->~T();
+				deallocate(ptr, sizeof(T), alignof(T));
+			}
+		}
+
+	protected:
+		const char* name_;
+
+	private:
+		/// Deleted copy constructor
+		IAllocator(const IAllocator&) = delete;
+		/// Deleted assignment operator
+		IAllocator& operator=(const IAllocator&) = delete;
+	};
+}
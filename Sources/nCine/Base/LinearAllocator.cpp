@@ -0,0 +1,68 @@
+#include "LinearAllocator.h"
+#include "../../Common.h"
+
+#include <cstdint>
+
+namespace nCine
+{
+	LinearAllocator::LinearAllocator(const char* name, std::size_t capacity, IAllocator& parent)
+		: IAllocator(name), parent_(parent), capacity_(capacity), offset_(0), lastOffset_(0),
+			peakOffset_(0), numAllocations_(0), numFailures_(0)
+	{
+		buffer_ = static_cast<unsigned char*>(parent_.allocate(capacity_));
+		FATAL_ASSERT_MSG_X(buffer_ != nullptr, "Cannot allocate %zu bytes for linear allocator \"%s\"", capacity_, name_);
+	}
+
+	LinearAllocator::~LinearAllocator()
+	{
+		parent_.deallocate(buffer_, capacity_);
+	}
+
+	void* LinearAllocator::allocate(std::size_t bytes, std::size_t alignment)
+	{
+		const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(buffer_) + offset_;
+		const std::size_t padding = (alignment - (address & (alignment - 1))) & (alignment - 1);
+		if (bytes > capacity_ - offset_ || padding > capacity_ - offset_ - bytes) {
+			numFailures_++;
+			return nullptr;
+		}
+
+		lastOffset_ = offset_;
+		offset_ += padding;
+		void* ptr = buffer_ + offset_;
+		offset_ += bytes;
+		if (peakOffset_ < offset_) {
+			peakOffset_ = offset_;
+		}
+		numAllocations_++;
+		return ptr;
+	}
+
+	void LinearAllocator::deallocate(void* ptr, std::size_t bytes, std::size_t alignment)
+	{
+		// Only the most recent allocation can be given back, everything else is reclaimed by reset()
+		if (ptr != nullptr && static_cast<unsigned char*>(ptr) + bytes == buffer_ + offset_) {
+			offset_ = lastOffset_;
+		}
+	}
+
+	void LinearAllocator::reset()
+	{
+		offset_ = 0;
+		lastOffset_ = 0;
+		numAllocations_ = 0;
+	}
+
+	void LinearAllocator::rewind(std::size_t marker)
+	{
+		if (marker < offset_) {
+			offset_ = marker;
+			lastOffset_ = marker;
+		}
+	}
+
+	bool LinearAllocator::owns(const void* ptr) const
+	{
+		return (ptr >= buffer_ && ptr < buffer_ + capacity_);
+	}
+}
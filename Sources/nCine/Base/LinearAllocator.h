@@ -0,0 +1,63 @@
+#pragma once
+
+#include "IAllocator.h"
+
+namespace nCine
+{
+	/// An allocator that hands out memory from a fixed buffer by advancing an offset
+	/*! Individual blocks are not released, only the most recent allocation can be rolled back.
+		The whole buffer is reclaimed at once by calling `reset()`, usually at the end of a frame.
+		The allocator is not thread-safe. */
+	class LinearAllocator : public IAllocator
+	{
+	public:
+		/// Creates the allocator with a buffer of the specified capacity that is obtained from the parent allocator
+		LinearAllocator(const char* name, std::size_t capacity, IAllocator& parent);
+		~LinearAllocator() override;
+
+		void* allocate(std::size_t bytes, std::size_t alignment = DefaultAlignment) override;
+		void deallocate(void* ptr, std::size_t bytes, std::size_t alignment = DefaultAlignment) override;
+
+		/// Releases all allocations at once
+		void reset();
+		/// Returns the current position in the buffer that can be later passed to `rewind()`
+		inline std::size_t marker() const {
+			return offset_;
+		}
+		/// Releases all allocations made after the marker was obtained
+		void rewind(std::size_t marker);
+		/// Returns `true` if the pointer points inside the buffer of the allocator
+		bool owns(const void* ptr) const;
+
+		/// Returns the size of the buffer in bytes
+		inline std::size_t capacity() const {
+			return capacity_;
+		}
+		/// Returns the number of bytes used since the last reset, including alignment padding
+		inline std::size_t usedMemory() const {
+			return offset_;
+		}
+		/// Returns the highest number of bytes used since the allocator was created
+		inline std::size_t peakMemory() const {
+			return peakOffset_;
+		}
+		/// Returns the number of allocations since the last reset
+		inline std::size_t numAllocations() const {
+			return numAllocations_;
+		}
+		/// Returns the number of allocations that didn't fit into the buffer since the allocator was created
+		inline std::size_t numFailures() const {
+			return numFailures_;
+		}
+
+	private:
+		IAllocator& parent_;
+		unsigned char* buffer_;
+		std::size_t capacity_;
+		std::size_t offset_;
+		std::size_t lastOffset_;
+		std::size_t peakOffset_;
+		std::size_t numAllocations_;
+		std::size_t numFailures_;
+	};
+}
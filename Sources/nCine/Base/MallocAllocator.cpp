@@ -0,0 +1,24 @@
+#include "MallocAllocator.h"
+
+#include <cstdlib> // for malloc()
+
+namespace nCine
+{
+	void* MallocAllocator::allocate(std::size_t bytes, std::size_t alignment)
+	{
+		// malloc() doesn't support over-aligned blocks, aligned operator new has a portable counterpart for deallocation
+		if (alignment > DefaultAlignment) {
+			return ::operator new(bytes, std::align_val_t(alignment), std::nothrow);
+		}
+		return std::malloc(bytes);
+	}
+
+	void MallocAllocator::deallocate(void* ptr, std::size_t bytes, std::size_t alignment)
+	{
+		if (alignment > DefaultAlignment) {
+			::operator delete(ptr, std::align_val_t(alignment), std::nothrow);
+		} else {
+			std::free(ptr);
+		}
+	}
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "IAllocator.h"
+
+namespace nCine
+{
+	/// An allocator that forwards requests to the system heap
+	class MallocAllocator : public IAllocator
+	{
+	public:
+		explicit MallocAllocator(const char* name)
+			: IAllocator(name) {}
+
+		void* allocate(std::size_t bytes, std::size_t alignment = DefaultAlignment) override;
+		void deallocate(void* ptr, std::size_t bytes, std::size_t alignment = DefaultAlignment) override;
+	};
+}
@@ -0,0 +1,74 @@
+#if defined(WITH_ALLOCATORS)
+
+#include "PoolAllocator.h"
+#include "../../Common.h"
+
+namespace nCine
+{
+	PoolAllocator::PoolAllocator(const char* name, std::size_t blockSize, std::size_t blockAlignment, std::size_t blocksPerPage, IAllocator& parent)
+		: IAllocator(name), parent_(parent), blockAlignment_(blockAlignment < alignof(FreeBlock) ? alignof(FreeBlock) : blockAlignment),
+			blocksPerPage_(blocksPerPage > 0 ? blocksPerPage : 1), usedBlocks_(0), freeList_(nullptr)
+	{
+		// Every block has to be able to hold the link to the next free block and to keep the alignment of the following one
+		blockSize_ = (blockSize < sizeof(FreeBlock) ? sizeof(FreeBlock) : blockSize);
+		blockSize_ = (blockSize_ + blockAlignment_ - 1) & ~(blockAlignment_ - 1);
+	}
+
+	PoolAllocator::~PoolAllocator()
+	{
+		if (usedBlocks_ > 0) {
+			LOGW_X("Pool allocator \"%s\" is destroyed with %zu block(s) still in use", name_, usedBlocks_);
+		}
+		for (void* page : pages_) {
+			parent_.deallocate(page, blockSize_ * blocksPerPage_, blockAlignment_);
+		}
+	}
+
+	void* PoolAllocator::allocate(std::size_t bytes, std::size_t alignment)
+	{
+		if (bytes > blockSize_ || alignment > blockAlignment_) {
+			LOGE_X("Pool allocator \"%s\" cannot serve %zu bytes aligned to %zu", name_, bytes, alignment);
+			return nullptr;
+		}
+		if (freeList_ == nullptr && !allocatePage()) {
+			return nullptr;
+		}
+
+		FreeBlock* block = freeList_;
+		freeList_ = block->next;
+		usedBlocks_++;
+		return block;
+	}
+
+	void PoolAllocator::deallocate(void* ptr, std::size_t bytes, std::size_t alignment)
+	{
+		if (ptr == nullptr) {
+			return;
+		}
+
+		FreeBlock* block = static_cast<FreeBlock*>(ptr);
+		block->next = freeList_;
+		freeList_ = block;
+		usedBlocks_--;
+	}
+
+	bool PoolAllocator::allocatePage()
+	{
+		unsigned char* page = static_cast<unsigned char*>(parent_.allocate(blockSize_ * blocksPerPage_, blockAlignment_));
+		if (page == nullptr) {
+			LOGE_X("Cannot allocate a new page for pool allocator \"%s\"", name_);
+			return false;
+		}
+		pages_.push_back(page);
+
+		// Blocks are linked in address order, so consecutive allocations are contiguous
+		for (std::size_t i = blocksPerPage_; i > 0; i--) {
+			FreeBlock* block = reinterpret_cast<FreeBlock*>(page + (i - 1) * blockSize_);
+			block->next = freeList_;
+			freeList_ = block;
+		}
+		return true;
+	}
+}
+
+#endif
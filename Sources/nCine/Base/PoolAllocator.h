@@ -0,0 +1,60 @@
+#pragma once
+
+#if defined(WITH_ALLOCATORS)
+
+#include "IAllocator.h"
+
+#include <Containers/SmallVector.h>
+
+using namespace Death::Containers;
+
+namespace nCine
+{
+	/// An allocator of fixed-size blocks
+	/*! Memory is obtained from the parent allocator in pages of blocks, free blocks are linked in an intrusive list.
+		Pages are kept until the allocator is destroyed. The allocator is not thread-safe. */
+	class PoolAllocator : public IAllocator
+	{
+	public:
+		/// Creates the allocator of blocks with the specified size and alignment, memory is obtained from the parent allocator
+		PoolAllocator(const char* name, std::size_t blockSize, std::size_t blockAlignment, std::size_t blocksPerPage, IAllocator& parent);
+		~PoolAllocator() override;
+
+		void* allocate(std::size_t bytes, std::size_t alignment = DefaultAlignment) override;
+		void deallocate(void* ptr, std::size_t bytes, std::size_t alignment = DefaultAlignment) override;
+
+		/// Returns the size of a block in bytes
+		inline std::size_t blockSize() const {
+			return blockSize_;
+		}
+		/// Returns the number of blocks in use
+		inline std::size_t usedBlocks() const {
+			return usedBlocks_;
+		}
+		/// Returns the number of blocks in all allocated pages
+		inline std::size_t capacity() const {
+			return pages_.size() * blocksPerPage_;
+		}
+		/// Returns the number of pages obtained from the parent allocator
+		inline std::size_t numPages() const {
+			return pages_.size();
+		}
+
+	private:
+		struct FreeBlock {
+			FreeBlock* next;
+		};
+
+		IAllocator& parent_;
+		std::size_t blockSize_;
+		std::size_t blockAlignment_;
+		std::size_t blocksPerPage_;
+		std::size_t usedBlocks_;
+		FreeBlock* freeList_;
+		SmallVector<void*, 0> pages_;
+
+		bool allocatePage();
+	};
+}
+
+#endif
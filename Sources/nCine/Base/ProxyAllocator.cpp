@@ -0,0 +1,44 @@
+#if defined(WITH_ALLOCATORS)
+
+#include "ProxyAllocator.h"
+
+namespace nCine
+{
+	void* ProxyAllocator::allocate(std::size_t bytes, std::size_t alignment)
+	{
+		void* ptr = target_.allocate(bytes, alignment);
+		if (ptr != nullptr) {
+			const std::size_t usedMemory = usedMemory_.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+			std::size_t peakMemory = peakMemory_.load(std::memory_order_relaxed);
+			while (peakMemory < usedMemory && !peakMemory_.compare_exchange_weak(peakMemory, usedMemory, std::memory_order_relaxed)) {
+				// Retry until the peak is updated or another thread stored a higher value
+			}
+			numAllocations_.fetch_add(1, std::memory_order_relaxed);
+			totalAllocations_.fetch_add(1, std::memory_order_relaxed);
+		}
+		return ptr;
+	}
+
+	void ProxyAllocator::deallocate(void* ptr, std::size_t bytes, std::size_t alignment)
+	{
+		if (ptr == nullptr) {
+			return;
+		}
+
+		target_.deallocate(ptr, bytes, alignment);
+		usedMemory_.fetch_sub(bytes, std::memory_order_relaxed);
+		numAllocations_.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	ProxyAllocator::Statistics ProxyAllocator::statistics() const
+	{
+		Statistics stats;
+		stats.usedMemory = usedMemory_.load(std::memory_order_relaxed);
+		stats.peakMemory = peakMemory_.load(std::memory_order_relaxed);
+		stats.numAllocations = numAllocations_.load(std::memory_order_relaxed);
+		stats.totalAllocations = totalAllocations_.load(std::memory_order_relaxed);
+		return stats;
+	}
+}
+
+#endif
@@ -0,0 +1,51 @@
+#pragma once
+
+#if defined(WITH_ALLOCATORS)
+
+#include "IAllocator.h"
+
+#include <atomic>
+
+namespace nCine
+{
+	/// An allocator that forwards requests to another allocator and keeps track of them
+	/*! It's used to attribute memory to a subsystem, counters are updated atomically. */
+	class ProxyAllocator : public IAllocator
+	{
+	public:
+		/// Snapshot of the allocator counters
+		struct Statistics {
+			/// Number of bytes currently allocated
+			std::size_t usedMemory;
+			/// Highest number of bytes allocated at the same time
+			std::size_t peakMemory;
+			/// Number of allocations that haven't been released yet
+			std::size_t numAllocations;
+			/// Number of all allocations since the allocator was created
+			std::size_t totalAllocations;
+		};
+
+		ProxyAllocator(const char* name, IAllocator& target)
+			: IAllocator(name), target_(target), usedMemory_(0), peakMemory_(0), numAllocations_(0), totalAllocations_(0) {}
+
+		void* allocate(std::size_t bytes, std::size_t alignment = DefaultAlignment) override;
+		void deallocate(void* ptr, std::size_t bytes, std::size_t alignment = DefaultAlignment) override;
+
+		/// Returns the allocator that requests are forwarded to
+		inline IAllocator& target() const {
+			return target_;
+		}
+
+		/// Returns current values of all counters
+		Statistics statistics() const;
+
+	private:
+		IAllocator& target_;
+		std::atomic<std::size_t> usedMemory_;
+		std::atomic<std::size_t> peakMemory_;
+		std::atomic<std::size_t> numAllocations_;
+		std::atomic<std::size_t> totalAllocations_;
+	};
+}
+
+#endif
@@ -0,0 +1,173 @@
+#include "ScratchArena.h"
+#include "../../Common.h"
+
+#if defined(WITH_ALLOCATORS)
+#	include "AllocManager.h"
+#else
+#	include "MallocAllocator.h"
+#endif
+
+#include <cstdarg>
+#include <cstdio> // for vsnprintf()
+#include <cstring> // for memcpy()
+
+namespace nCine
+{
+	namespace
+	{
+		IAllocator& defaultParentAllocator()
+		{
+#if defined(WITH_ALLOCATORS)
+			return AllocManager::proxy(AllocTag::General);
+#else
+			static MallocAllocator allocator("Malloc");
+			return allocator;
+#endif
+		}
+
+		void noOpDeleter(char*, std::size_t) {}
+	}
+
+	ScratchArena::ScratchArena(std::size_t capacity, IAllocator& parent)
+		: IAllocator("Scratch"), parent_(parent), linear_("Scratch", capacity, parent), current_{}, lastFrame_{}
+	{
+	}
+
+	ScratchArena::ScratchArena(std::size_t capacity)
+		: ScratchArena(capacity, defaultParentAllocator())
+	{
+	}
+
+	ScratchArena::~ScratchArena()
+	{
+		releaseOverflowBlocks(0);
+	}
+
+	void* ScratchArena::allocate(std::size_t bytes, std::size_t alignment)
+	{
+		current_.numAllocations++;
+		void* ptr = linear_.allocate(bytes, alignment);
+		if (ptr != nullptr) {
+			if (current_.usedMemory < linear_.usedMemory()) {
+				current_.usedMemory = linear_.usedMemory();
+			}
+			return ptr;
+		}
+
+		// The buffer is full, the block is kept until the arena is rewound or reset, so the lifetime is the same
+		ptr = parent_.allocate(bytes, alignment);
+		if (ptr != nullptr) {
+			overflowBlocks_.push_back({ ptr, bytes, alignment });
+			current_.numOverflows++;
+		}
+		return ptr;
+	}
+
+	void ScratchArena::deallocate(void* ptr, std::size_t bytes, std::size_t alignment)
+	{
+		// Only the most recent allocation in the buffer is actually released, anything else waits for reset
+		if (linear_.owns(ptr)) {
+			linear_.deallocate(ptr, bytes, alignment);
+		}
+	}
+
+	String ScratchArena::nullTerminatedView(StringView view)
+	{
+		if ((view.flags() & StringViewFlags::NullTerminated) == StringViewFlags::NullTerminated) {
+			return String::nullTerminatedView(view);
+		}
+
+		char* data = allocateArray<char>(view.size() + 1);
+		std::memcpy(data, view.data(), view.size());
+		data[view.size()] = '\0';
+		return String(data, view.size(), noOpDeleter);
+	}
+
+	ScratchArena::Marker ScratchArena::marker() const
+	{
+		return { linear_.marker(), overflowBlocks_.size() };
+	}
+
+	void ScratchArena::rewind(const Marker& marker)
+	{
+		linear_.rewind(marker.offset);
+		releaseOverflowBlocks(marker.overflowCount);
+	}
+
+	void ScratchArena::reset()
+	{
+		lastFrame_ = current_;
+		current_ = {};
+		linear_.reset();
+		releaseOverflowBlocks(0);
+	}
+
+	void ScratchArena::releaseOverflowBlocks(std::size_t count)
+	{
+		while (overflowBlocks_.size() > count) {
+			const OverflowBlock& block = overflowBlocks_.back();
+			parent_.deallocate(block.ptr, block.bytes, block.alignment);
+			overflowBlocks_.pop_back();
+		}
+	}
+
+	ScratchString::ScratchString(ScratchArena& arena, std::size_t capacity)
+		: arena_(&arena), data_(nullptr), size_(0), capacity_(0)
+	{
+		if (capacity > 0) {
+			reserve(capacity);
+		}
+	}
+
+	ScratchString& ScratchString::append(StringView value)
+	{
+		if (value.empty()) {
+			return *this;
+		}
+		if (size_ + value.size() > capacity_) {
+			reserve(size_ + value.size());
+		}
+		std::memcpy(data_ + size_, value.data(), value.size());
+		size_ += value.size();
+		data_[size_] = '\0';
+		return *this;
+	}
+
+	ScratchString& ScratchString::appendFormat(const char* format, ...)
+	{
+		va_list args;
+		va_start(args, format);
+		va_list argsCopy;
+		va_copy(argsCopy, args);
+		const int length = vsnprintf(data_ != nullptr ? data_ + size_ : nullptr, data_ != nullptr ? capacity_ - size_ + 1 : 0, format, args);
+		va_end(args);
+
+		if (length > 0) {
+			if (size_ + length > capacity_) {
+				reserve(size_ + length);
+				vsnprintf(data_ + size_, capacity_ - size_ + 1, format, argsCopy);
+			}
+			size_ += length;
+		}
+		va_end(argsCopy);
+		return *this;
+	}
+
+	void ScratchString::reserve(std::size_t capacity)
+	{
+		if (capacity <= capacity_) {
+			return;
+		}
+
+		// Grow geometrically, the previous block stays in the arena until it's reset
+		std::size_t newCapacity = (capacity_ * 2 > capacity ? capacity_ * 2 : capacity);
+		char* newData = arena_->allocateArray<char>(newCapacity + 1);
+		FATAL_ASSERT_MSG_X(newData != nullptr, "Cannot allocate %zu bytes in the scratch arena", newCapacity + 1);
+		if (size_ > 0) {
+			std::memcpy(newData, data_, size_);
+		}
+		newData[size_] = '\0';
+		data_ = newData;
+		capacity_ = newCapacity;
+	}
+}
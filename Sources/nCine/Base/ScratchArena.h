@@ -0,0 +1,155 @@
+#pragma once
+
+#include "LinearAllocator.h"
+#include "StlAllocator.h"
+
+#include <vector>
+
+#include <Containers/SmallVector.h>
+#include <Containers/String.h>
+#include <Containers/StringView.h>
+
+using namespace Death::Containers;
+
+namespace nCine
+{
+	/// A linear arena for transient allocations that live at most until the end of the current frame
+	/*! The arena is reset by the application once per frame, so memory must not be referenced after that.
+		Requests that don't fit into the buffer are served by the parent allocator and released on reset too.
+		The arena is not thread-safe, it should be used only from the main thread. */
+	class ScratchArena : public IAllocator
+	{
+	public:
+		/// Allocation statistics of one frame
+		struct Statistics {
+			/// Number of allocations served by the arena
+			std::size_t numAllocations;
+			/// Highest number of bytes used in the buffer, including alignment padding
+			std::size_t usedMemory;
+			/// Number of allocations that didn't fit into the buffer and were served by the parent allocator
+			std::size_t numOverflows;
+		};
+
+		/// A position in the arena that can be rewound to
+		struct Marker {
+			std::size_t offset;
+			std::size_t overflowCount;
+		};
+
+		/// Creates the arena with a buffer of the specified capacity, memory is obtained from the parent allocator
+		ScratchArena(std::size_t capacity, IAllocator& parent);
+		/// Creates the arena with a buffer of the specified capacity, memory is obtained from the default allocator
+		explicit ScratchArena(std::size_t capacity);
+		~ScratchArena() override;
+
+		void* allocate(std::size_t bytes, std::size_t alignment = DefaultAlignment) override;
+		void deallocate(void* ptr, std::size_t bytes, std::size_t alignment = DefaultAlignment) override;
+
+		/// Allocates uninitialized memory for an array of trivially destructible objects
+		template<class T>
+		T* allocateArray(std::size_t count)
+		{
+			static_assert(std::is_trivially_destructible<T>::value, "Destructors of objects in the arena are never called");
+			return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+		}
+
+		/// Returns a null-terminated string, the view is copied to the arena only if it's not null-terminated already
+		String nullTerminatedView(StringView view);
+
+		/// Returns the current position in the arena
+		Marker marker() const;
+		/// Releases all allocations made after the marker was obtained
+		void rewind(const Marker& marker);
+		/// Releases all allocations and starts collecting statistics of a new frame
+		void reset();
+
+		/// Returns the size of the buffer in bytes
+		inline std::size_t capacity() const {
+			return linear_.capacity();
+		}
+		/// Returns statistics of the current frame
+		inline const Statistics& statistics() const {
+			return current_;
+		}
+		/// Returns statistics of the last finished frame
+		inline const Statistics& lastFrameStatistics() const {
+			return lastFrame_;
+		}
+
+	private:
+		struct OverflowBlock {
+			void* ptr;
+			std::size_t bytes;
+			std::size_t alignment;
+		};
+
+		IAllocator& parent_;
+		LinearAllocator linear_;
+		SmallVector<OverflowBlock, 0> overflowBlocks_;
+		Statistics current_;
+		Statistics lastFrame_;
+
+		void releaseOverflowBlocks(std::size_t count);
+	};
+
+	/// Rewinds the arena to the position it had when the object was created
+	class ScopedScratchMarker
+	{
+	public:
+		explicit ScopedScratchMarker(ScratchArena& arena)
+			: arena_(arena), marker_(arena.marker()) {}
+		~ScopedScratchMarker() {
+			arena_.rewind(marker_);
+		}
+
+	private:
+		ScratchArena& arena_;
+		ScratchArena::Marker marker_;
+
+		ScopedScratchMarker(const ScopedScratchMarker&) = delete;
+		ScopedScratchMarker& operator=(const ScopedScratchMarker&) = delete;
+	};
+
+	/// A vector that stores its elements in the scratch arena, it must not outlive the current frame
+	template<class T>
+	using ScratchVector = std::vector<T, StlAllocator<T>>;
+
+	/// A null-terminated string builder that stores its contents in the scratch arena, it must not outlive the current frame
+	class ScratchString
+	{
+	public:
+		explicit ScratchString(ScratchArena& arena, std::size_t capacity = 0);
+
+		ScratchString& append(StringView value);
+		ScratchString& appendFormat(const char* format, ...);
+
+		inline ScratchString& operator+=(StringView value) {
+			return append(value);
+		}
+
+		inline const char* data() const {
+			return (data_ != nullptr ? data_ : "");
+		}
+		inline std::size_t size() const {
+			return size_;
+		}
+		inline bool empty() const {
+			return (size_ == 0);
+		}
+
+		inline StringView view() const {
+			return StringView(data(), size_, StringViewFlags::NullTerminated);
+		}
+		inline operator StringView() const {
+			return view();
+		}
+
+	private:
+		ScratchArena* arena_;
+		char* data_;
+		std::size_t size_;
+		std::size_t capacity_;
+
+		void reserve(std::size_t capacity);
+	};
+}
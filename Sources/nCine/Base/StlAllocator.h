@@ -0,0 +1,87 @@
+#pragma once
+
+#include "IAllocator.h"
+#include "../../Common.h"
+
+#include <memory>
+
+namespace nCine
+{
+	/// An adapter that allows standard containers and smart pointers to use a custom allocator
+	template<class T>
+	class StlAllocator
+	{
+		template<class U>
+		friend class StlAllocator;
+
+	public:
+		using value_type = T;
+
+		StlAllocator(IAllocator& allocator) noexcept
+			: allocator_(&allocator) {}
+		template<class U>
+		StlAllocator(const StlAllocator<U>& other) noexcept
+			: allocator_(other.allocator_) {}
+
+		T* allocate(std::size_t n)
+		{
+			void* ptr = allocator_->allocate(n * sizeof(T), alignof(T));
+			// Exceptions are disabled, so a failed allocation cannot be reported to the container
+			FATAL_ASSERT_MSG_X(ptr != nullptr, "Allocator \"%s\" cannot allocate %zu bytes", allocator_->name(), n * sizeof(T));
+			return static_cast<T*>(ptr);
+		}
+
+		void deallocate(T* ptr, std::size_t n) noexcept
+		{
+			allocator_->deallocate(ptr, n * sizeof(T), alignof(T));
+		}
+
+		/// Returns the underlying allocator
+		inline IAllocator& allocator() const {
+			return *allocator_;
+		}
+
+		template<class U>
+		bool operator==(const StlAllocator<U>& other) const noexcept {
+			return allocator_ == other.allocator_;
+		}
+		template<class U>
+		bool operator!=(const StlAllocator<U>& other) const noexcept {
+			return allocator_ != other.allocator_;
+		}
+
+	private:
+		IAllocator* allocator_;
+	};
+
+	/// A deleter for `std::unique_ptr` of objects that were created with `IAllocator::newObject()`
+	template<class T>
+	struct AllocatorDeleter
+	{
+		IAllocator* allocator;
+
+		void operator()(T* ptr) const {
+			allocator->deleteObject(ptr);
+		}
+	};
+
+	/// A unique pointer to an object that was created by a custom allocator
+	template<class T>
+	using AllocatorUniquePtr = std::unique_ptr<T, AllocatorDeleter<T>>;
+
+	/// Creates an object using the specified allocator and wraps it in `std::unique_ptr`
+	template<class T, typename... Args>
+	AllocatorUniquePtr<T> allocateUnique(IAllocator& allocator, Args&&... args)
+	{
+		T* ptr = allocator.newObject<T>(std::forward<Args>(args)...);
+		FATAL_ASSERT_MSG_X(ptr != nullptr, "Allocator \"%s\" cannot allocate %zu bytes", allocator.name(), sizeof(T));
+		return AllocatorUniquePtr<T>(ptr, AllocatorDeleter<T>{&allocator});
+	}
+
+	/// Creates an object and its control block using the specified allocator and wraps it in `std::shared_ptr`
+	template<class T, typename... Args>
+	std::shared_ptr<T> allocateShared(IAllocator& allocator, Args&&... args)
+	{
+		return std::allocate_shared<T>(StlAllocator<T>(allocator), std::forward<Args>(args)...);
+	}
+}
@@ -0,0 +1,286 @@
+#if defined(WITH_TRACE_EXPORT)
+
+#include "TraceExporter.h"
+#include "../IO/FileSystem.h"
+#include "../../Common.h"
+
+#include <algorithm>
+#include <cstdio> // for snprintf()
+#include <cstring> // for memcpy()
+#include <memory>
+
+namespace nCine
+{
+	namespace
+	{
+		thread_local bool threadBufferFailed = false;
+
+		/// Escaped names are limited, so a whole event always fits into one line of the writer
+		constexpr std::size_t MaxEscapedNameLength = 128;
+
+		/// Copies the string with characters escaped as required by JSON
+		void escapeJson(const char* src, char* dst, std::size_t dstSize)
+		{
+			std::size_t length = 0;
+			for (; *src != '\0'; src++) {
+				const unsigned char c = static_cast<unsigned char>(*src);
+				char escaped[7];
+				int escapedLength;
+				if (c == '"' || c == '\\') {
+					escaped[0] = '\\';
+					escaped[1] = static_cast<char>(c);
+					escapedLength = 2;
+				} else if (c < 0x20) {
+					escapedLength = snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+				} else {
+					escaped[0] = static_cast<char>(c);
+					escapedLength = 1;
+				}
+
+				// Truncated names are still valid strings, an escape sequence is never split
+				if (length + escapedLength >= dstSize) {
+					break;
+				}
+				memcpy(dst + length, escaped, escapedLength);
+				length += escapedLength;
+			}
+			dst[length] = '\0';
+		}
+
+		/// Collects small writes before passing them to the stream
+		class BufferedWriter
+		{
+		public:
+			explicit BufferedWriter(IFileStream* stream)
+				: stream_(stream), length_(0) {}
+			~BufferedWriter() {
+				flush();
+			}
+
+			template<typename... Args>
+			void append(const char* format, Args... args)
+			{
+				if (length_ + MaxLineLength > BufferSize) {
+					flush();
+				}
+				const int length = snprintf(buffer_ + length_, MaxLineLength, format, args...);
+				if (length > 0) {
+					length_ += (length < MaxLineLength ? length : MaxLineLength - 1);
+				}
+			}
+
+			void flush()
+			{
+				if (length_ > 0) {
+					stream_->Write(buffer_, length_);
+					length_ = 0;
+				}
+			}
+
+		private:
+			static constexpr int MaxLineLength = 256;
+			static constexpr int BufferSize = 16384;
+
+			IFileStream* stream_;
+			int length_;
+			char buffer_[BufferSize];
+		};
+	}
+
+	std::atomic<unsigned int> TraceExporter::threadCount_(0);
+	std::atomic<TraceExporter::ThreadBuffer*> TraceExporter::threads_[MaxThreads];
+	std::atomic<unsigned int> TraceExporter::droppedThreadCount_(0);
+
+	void TraceExporter::zone(const char* name, std::uint64_t startTicks, std::uint64_t endTicks)
+	{
+		Event event;
+		event.name = name;
+		event.startTicks = startTicks;
+		event.durationTicks = endTicks - startTicks;
+		event.type = EventType::Zone;
+		write(event);
+	}
+
+	void TraceExporter::counter(const char* name, double value)
+	{
+		Event event;
+		event.name = name;
+		event.startTicks = clock().now();
+		event.value = value;
+		event.type = EventType::Counter;
+		write(event);
+	}
+
+	void TraceExporter::setThreadName(const char* name)
+	{
+		ThreadBuffer* buffer = threadBuffer();
+		if (buffer == nullptr) {
+			return;
+		}
+
+		const auto nameLength = strnlen(name, MaxThreadNameLength - 1);
+		memcpy(buffer->name, name, nameLength);
+		buffer->name[nameLength] = '\0';
+		buffer->nameLength.store(static_cast<unsigned int>(nameLength), std::memory_order_release);
+	}
+
+	bool TraceExporter::flush(const StringView& path)
+	{
+		auto so = fs::Open(path, FileAccessMode::Write);
+		if (!so->IsOpened()) {
+			LOGE_X("Cannot open file \"%s\" for writing", String::nullTerminatedView(path).data());
+			return false;
+		}
+
+		const double ticksToMicroseconds = 1000000.0 / clock().frequency();
+		std::unique_ptr<Event[]> snapshot = std::make_unique<Event[]>(EventsPerThread);
+		unsigned long eventCount = 0;
+		bool isFirst = true;
+		char threadName[MaxThreadNameLength];
+		char escapedName[MaxEscapedNameLength];
+
+		BufferedWriter writer(so.get());
+		writer.append("{\"traceEvents\":[\n");
+
+		const unsigned int threadCount = std::min(threadCount_.load(std::memory_order_acquire), MaxThreads);
+		for (unsigned int i = 0; i < threadCount; i++) {
+			ThreadBuffer* buffer = threads_[i].load(std::memory_order_acquire);
+			if (buffer == nullptr) {
+				continue;
+			}
+
+			const unsigned int tid = buffer->threadIndex + 1;
+			const unsigned int nameLength = std::min(buffer->nameLength.load(std::memory_order_acquire), MaxThreadNameLength - 1);
+			if (nameLength > 0) {
+				memcpy(threadName, buffer->name, nameLength);
+				threadName[nameLength] = '\0';
+				escapeJson(threadName, escapedName, sizeof(escapedName));
+				writer.append("%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+					isFirst ? "" : ",\n", tid, escapedName);
+			} else {
+				writer.append("%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"Thread %u\"}}",
+					isFirst ? "" : ",\n", tid, tid);
+			}
+			isFirst = false;
+
+			// The owning thread keeps writing, so events are copied first and then validated like with a sequence lock,
+			// the acquire load pairs with the release store in write(), so all events before the index are visible
+			const std::uint64_t endIndex = buffer->writeIndex.load(std::memory_order_acquire);
+			std::uint64_t startIndex = (endIndex > EventsPerThread ? endIndex - EventsPerThread : 0);
+			for (std::uint64_t j = startIndex; j < endIndex; j++) {
+				const EventSlot& slot = buffer->events[j % EventsPerThread];
+				Event& event = snapshot[j % EventsPerThread];
+				event.name = slot.name.load(std::memory_order_relaxed);
+				event.startTicks = slot.startTicks.load(std::memory_order_relaxed);
+				const std::uint64_t data = slot.data.load(std::memory_order_relaxed);
+				memcpy(&event.durationTicks, &data, sizeof(data));
+				event.type = slot.type.load(std::memory_order_relaxed);
+			}
+
+			// Events that could have been overwritten during the copy are dropped, the fence keeps the copy above before the load
+			std::atomic_thread_fence(std::memory_order_acquire);
+			const std::uint64_t lastIndex = buffer->writeIndex.load(std::memory_order_relaxed);
+			if (lastIndex >= EventsPerThread && lastIndex - EventsPerThread + 1 > startIndex) {
+				startIndex = lastIndex - EventsPerThread + 1;
+			}
+
+			for (std::uint64_t j = startIndex; j < endIndex; j++) {
+				const Event& event = snapshot[j % EventsPerThread];
+				escapeJson(event.name, escapedName, sizeof(escapedName));
+				switch (event.type) {
+					case EventType::Zone:
+						writer.append(",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+							escapedName, tid, event.startTicks * ticksToMicroseconds, event.durationTicks * ticksToMicroseconds);
+						break;
+					case EventType::Counter:
+						writer.append(",\n{\"name\":\"%s\",\"ph\":\"C\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"args\":{\"value\":%g}}",
+							escapedName, tid, event.startTicks * ticksToMicroseconds, event.value);
+						break;
+				}
+				eventCount++;
+			}
+		}
+
+		writer.append("\n]}\n");
+		writer.flush();
+
+		LOGI_X("Trace of %lu events from %u threads saved to \"%s\"", eventCount, threadCount, String::nullTerminatedView(path).data());
+		const unsigned int droppedThreadCount = droppedThreadCount_.load(std::memory_order_relaxed);
+		if (droppedThreadCount > 0) {
+			LOGW_X("Events of %u threads were dropped, because more than %u threads were running at once", droppedThreadCount, MaxThreads);
+		}
+		return true;
+	}
+
+	TraceExporter::ThreadBuffer* TraceExporter::threadBuffer()
+	{
+		// Releases the buffer when the thread exits, so short-lived threads (e.g. of ParallelFor) don't exhaust all buffers
+		struct BufferOwner {
+			ThreadBuffer* buffer = nullptr;
+
+			~BufferOwner() {
+				if (buffer != nullptr) {
+					buffer->isUsed.store(false, std::memory_order_release);
+				}
+			}
+		};
+
+		thread_local BufferOwner owner;
+		if (owner.buffer != nullptr || threadBufferFailed) {
+			return owner.buffer;
+		}
+
+		// Buffers are never freed, a buffer of a finished thread is reused and its events are kept until they are overwritten,
+		// the write index continues from the previous owner, so the flush can still detect overwritten events
+		const unsigned int threadCount = std::min(threadCount_.load(std::memory_order_acquire), MaxThreads);
+		for (unsigned int i = 0; i < threadCount; i++) {
+			ThreadBuffer* buffer = threads_[i].load(std::memory_order_acquire);
+			bool isUsed = false;
+			if (buffer != nullptr && buffer->isUsed.compare_exchange_strong(isUsed, true, std::memory_order_acq_rel)) {
+				buffer->nameLength.store(0, std::memory_order_release);
+				owner.buffer = buffer;
+				return buffer;
+			}
+		}
+
+		const unsigned int threadIndex = threadCount_.fetch_add(1, std::memory_order_acq_rel);
+		if (threadIndex >= MaxThreads) {
+			threadBufferFailed = true;
+			droppedThreadCount_.fetch_add(1, std::memory_order_relaxed);
+			LOGW("Too many threads are running at once, events of this thread are not traced");
+			return nullptr;
+		}
+
+		ThreadBuffer* buffer = new ThreadBuffer();
+		buffer->writeIndex.store(0, std::memory_order_relaxed);
+		buffer->nameLength.store(0, std::memory_order_relaxed);
+		buffer->isUsed.store(true, std::memory_order_relaxed);
+		buffer->threadIndex = threadIndex;
+		buffer->name[0] = '\0';
+		threads_[threadIndex].store(buffer, std::memory_order_release);
+		owner.buffer = buffer;
+		return buffer;
+	}
+
+	void TraceExporter::write(const Event& event)
+	{
+		ThreadBuffer* buffer = threadBuffer();
+		if (buffer == nullptr) {
+			return;
+		}
+
+		// Only the owning thread writes to the buffer, so a relaxed load of its own index is enough,
+		// relaxed stores of the fields are published by the release store of the index
+		const std::uint64_t index = buffer->writeIndex.load(std::memory_order_relaxed);
+		EventSlot& slot = buffer->events[index % EventsPerThread];
+		std::uint64_t data;
+		memcpy(&data, &event.durationTicks, sizeof(data));
+		slot.name.store(event.name, std::memory_order_relaxed);
+		slot.startTicks.store(event.startTicks, std::memory_order_relaxed);
+		slot.data.store(data, std::memory_order_relaxed);
+		slot.type.store(event.type, std::memory_order_relaxed);
+		buffer->writeIndex.store(index + 1, std::memory_order_release);
+	}
+}
+
+#endif
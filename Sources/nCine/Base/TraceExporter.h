@@ -0,0 +1,103 @@
+#pragma once
+
+#if defined(WITH_TRACE_EXPORT)
+
+#include "Clock.h"
+
+#include <atomic>
+
+#include <Containers/StringView.h>
+
+using namespace Death::Containers;
+
+namespace nCine
+{
+	/// A lightweight tracer that records zones and counters and saves them in Chrome trace event format
+	/*! Every thread writes to its own ring buffer without locking, only the most recent events are kept.
+		Buffers of finished threads are reused by new threads, events of threads over the limit are dropped.
+		Names must stay valid for the whole lifetime of the application, usually string literals. */
+	class TraceExporter
+	{
+	public:
+		static constexpr unsigned int MaxThreads = 64;
+		static constexpr unsigned int EventsPerThread = 65536;
+		static constexpr unsigned int MaxThreadNameLength = 32;
+
+		/// Records a completed zone of the calling thread
+		static void zone(const char* name, std::uint64_t startTicks, std::uint64_t endTicks);
+		/// Records a value of the counter
+		static void counter(const char* name, double value);
+		/// Sets the name of the calling thread that is shown in the trace
+		static void setThreadName(const char* name);
+
+		/// Saves all recorded events of all threads as a JSON file that can be opened in `chrome://tracing` or Perfetto
+		static bool flush(const StringView& path);
+
+	private:
+		enum class EventType : std::uint8_t
+		{
+			Zone,
+			Counter
+		};
+
+		struct Event
+		{
+			const char* name;
+			std::uint64_t startTicks;
+			union {
+				std::uint64_t durationTicks;
+				double value;
+			};
+			EventType type;
+		};
+
+		/// Slot of the ring buffer, the flush can read a slot while it's being overwritten, so all fields are atomic
+		struct EventSlot
+		{
+			std::atomic<const char*> name;
+			std::atomic<std::uint64_t> startTicks;
+			/// Duration or bits of the value
+			std::atomic<std::uint64_t> data;
+			std::atomic<EventType> type;
+		};
+
+		struct ThreadBuffer
+		{
+			std::atomic<std::uint64_t> writeIndex;
+			std::atomic<unsigned int> nameLength;
+			/// Whether the buffer is owned by a running thread
+			std::atomic<bool> isUsed;
+			unsigned int threadIndex;
+			char name[MaxThreadNameLength];
+			EventSlot events[EventsPerThread];
+		};
+
+		static std::atomic<unsigned int> threadCount_;
+		static std::atomic<ThreadBuffer*> threads_[MaxThreads];
+		static std::atomic<unsigned int> droppedThreadCount_;
+
+		/// Returns the buffer of the calling thread, it's created on first use
+		static ThreadBuffer* threadBuffer();
+		static void write(const Event& event);
+	};
+
+	/// Measures the time spent in a scope and records it as a trace zone
+	class TraceZone
+	{
+	public:
+		explicit TraceZone(const char* name)
+			: name_(name), startTicks_(clock().now()) {}
+		~TraceZone() {
+			TraceExporter::zone(name_, startTicks_, clock().now());
+		}
+
+	private:
+		const char* name_;
+		std::uint64_t startTicks_;
+
+		TraceZone(const TraceZone&) = delete;
+		TraceZone& operator=(const TraceZone&) = delete;
+	};
+}
+
+#endif
@@ -5,7 +5,7 @@
 namespace nCine
 {
 	BaseSprite::BaseSprite(SceneNode* parent, Texture* texture, float xx, float yy)
-		: DrawableNode(parent, xx, yy), texture_(texture), texRect_(0, 0, 0, 0), flippedX_(false), flippedY_(false), instanceBlock_(nullptr)
+		: DrawableNode(parent, xx, yy), texture_(texture), texRect_(0, 0, 0, 0), flippedX_(false), flippedY_(false)
 	{
 		renderCommand_.material().setBlendingEnabled(true);
 	}
@@ -89,14 +89,13 @@ namespace nCine
 
 	BaseSprite::BaseSprite(const BaseSprite& other)
 		: DrawableNode(other), texture_(other.texture_), texRect_(other.texRect_),
-		flippedX_(other.flippedX_), flippedY_(other.flippedY_), instanceBlock_(nullptr)
+		flippedX_(other.flippedX_), flippedY_(other.flippedY_)
 	{
 	}
 
 	void BaseSprite::shaderHasChanged()
 	{
 		renderCommand_.material().reserveUniformsDataMemory();
-		instanceBlock_ = renderCommand_.material().uniformBlock(Material::InstanceBlockName);
 		GLUniformCache* textureUniform = renderCommand_.material().uniform(Material::TextureUniformName);
 		if (textureUniform != nullptr && textureUniform->intValue(0) != 0) {
 			textureUniform->setIntValue(0); // GL_TEXTURE0
@@ -117,17 +116,11 @@ namespace nCine
 			dirtyBits_.reset(DirtyBitPositions::TransformationBit);
 		}
 		if (dirtyBits_.test(DirtyBitPositions::ColorBit)) {
-			GLUniformCache* colorUniform = instanceBlock_->uniform(Material::ColorUniformName);
-			if (colorUniform != nullptr) {
-				colorUniform->setFloatVector(absColor().Data());
-			}
+			renderCommand_.material().setInstanceColor(absColor().Data());
 			dirtyBits_.reset(DirtyBitPositions::ColorBit);
 		}
 		if (dirtyBits_.test(DirtyBitPositions::SizeBit)) {
-			GLUniformCache* spriteSizeUniform = instanceBlock_->uniform(Material::SpriteSizeUniformName);
-			if (spriteSizeUniform != nullptr) {
-				spriteSizeUniform->setFloatValue(width_, height_);
-			}
+			renderCommand_.material().setInstanceSpriteSize(width_, height_);
 			dirtyBits_.reset(DirtyBitPositions::SizeBit);
 		}
 
@@ -135,16 +128,13 @@ namespace nCine
 			if (texture_ != nullptr) {
 				renderCommand_.material().setTexture(*texture_);
 
-				GLUniformCache* texRectUniform = instanceBlock_->uniform(Material::TexRectUniformName);
-				if (texRectUniform != nullptr) {
-					const Vector2i texSize = texture_->size();
-					const float texScaleX = texRect_.W / float(texSize.X);
-					const float texBiasX = texRect_.X / float(texSize.X);
-					const float texScaleY = texRect_.H / float(texSize.Y);
-					const float texBiasY = texRect_.Y / float(texSize.Y);
+				const Vector2i texSize = texture_->size();
+				const float texScaleX = texRect_.W / float(texSize.X);
+				const float texBiasX = texRect_.X / float(texSize.X);
+				const float texScaleY = texRect_.H / float(texSize.Y);
+				const float texBiasY = texRect_.Y / float(texSize.Y);
 
-					texRectUniform->setFloatValue(texScaleX, texBiasX, texScaleY, texBiasY);
-				}
+				renderCommand_.material().setInstanceTexRect(texScaleX, texBiasX, texScaleY, texBiasY);
 			} else {
 				renderCommand_.material().setTexture(nullptr);
 			}
@@ -202,6 +202,16 @@ namespace nCine
 		return true;
 	}
 
+	GLfloat* GLUniformCache::floatDataPointer(unsigned int requiredComponents)
+	{
+		if (uniform_ == nullptr || dataPointer_ == nullptr || !checkFloat() || !checkComponents(requiredComponents)) {
+			return nullptr;
+		}
+
+		isDirty_ = true;
+		return reinterpret_cast<GLfloat*>(dataPointer_);
+	}
+
 	bool GLUniformCache::commitValue()
 	{
 		ASSERT(uniform_ == nullptr || dataPointer_ != nullptr);
@@ -40,6 +40,10 @@ namespace nCine
 		bool setIntValue(GLint v0, GLint v1, GLint v2);
 		bool setIntValue(GLint v0, GLint v1, GLint v2, GLint v3);
 
+		/// Returns a pointer to write floating point values directly, or `nullptr` if the uniform doesn't match
+		/*! The type and components are checked only once here, so the pointer can be used for per-draw updates */
+		GLfloat* floatDataPointer(unsigned int requiredComponents);
+
 		inline bool isDirty() const {
 			return isDirty_;
 		}
@@ -7,7 +7,7 @@
 namespace nCine
 {
 	GLVertexFormat::Attribute::Attribute()
-		: enabled_(false), vbo_(nullptr), index_(0), size_(-1), type_(GL_FLOAT), stride_(0), pointer_(nullptr), baseOffset_(0)
+		: enabled_(false), vbo_(nullptr), index_(0), size_(-1), type_(GL_FLOAT), stride_(0), pointer_(nullptr), baseOffset_(0), divisor_(0)
 	{
 	}
 
@@ -27,7 +27,8 @@ namespace nCine
 					other.normalized_ == normalized_ &&
 					other.stride_ == stride_ &&
 					other.pointer_ == pointer_ &&
-					other.baseOffset_ == baseOffset_));
+					other.baseOffset_ == baseOffset_ &&
+					other.divisor_ == divisor_));
 	}
 
 	bool GLVertexFormat::Attribute::operator!=(const Attribute& other) const
@@ -46,6 +47,7 @@ namespace nCine
 		stride_ = 0;
 		pointer_ = nullptr;
 		baseOffset_ = 0;
+		divisor_ = 0;
 	}
 
 	void GLVertexFormat::Attribute::setVboParameters(GLsizei stride, const GLvoid* pointer)
@@ -74,7 +76,11 @@ namespace nCine
 				const GLubyte* initialPointer = reinterpret_cast<const GLubyte*>(attributes_[i].pointer_);
 				const GLvoid* pointer = reinterpret_cast<const GLvoid*>(initialPointer + attributes_[i].baseOffset_);
 #else
-				const GLvoid* pointer = attributes_[i].pointer_;
+				// Per-instance attributes are not affected by the first vertex or the base vertex, so they are always offset
+				const GLubyte* initialPointer = reinterpret_cast<const GLubyte*>(attributes_[i].pointer_);
+				const GLvoid* pointer = (attributes_[i].divisor_ > 0
+					? reinterpret_cast<const GLvoid*>(initialPointer + attributes_[i].baseOffset_)
+					: attributes_[i].pointer_);
 #endif
 
 				switch (attributes_[i].type_) {
@@ -94,6 +100,9 @@ namespace nCine
 						glVertexAttribPointer(attributes_[i].index_, attributes_[i].size_, attributes_[i].type_, attributes_[i].normalized_, attributes_[i].stride_, pointer);
 						break;
 				}
+
+				// The divisor is always set, because the VAO could have been defined with per-instance attributes before
+				glVertexAttribDivisor(attributes_[i].index_, attributes_[i].divisor_);
 			}
 		}
 
@@ -54,6 +54,10 @@ namespace nCine
 			inline unsigned int baseOffset() const {
 				return baseOffset_;
 			}
+			/// Returns the number of instances that share the same attribute value, zero for per-vertex attributes
+			inline GLuint divisor() const {
+				return divisor_;
+			}
 
 			void setVboParameters(GLsizei stride, const GLvoid* pointer);
 			inline void setVbo(const GLBufferObject* vbo) {
@@ -62,6 +66,10 @@ namespace nCine
 			inline void setBaseOffset(unsigned int baseOffset) {
 				baseOffset_ = baseOffset;
 			}
+			/// Sets the number of instances that share the same attribute value, zero for per-vertex attributes
+			inline void setDivisor(GLuint divisor) {
+				divisor_ = divisor;
+			}
 
 			inline void setSize(GLint size) {
 				size_ = size;
@@ -82,8 +90,9 @@ namespace nCine
 			GLboolean normalized_;
 			GLsizei stride_;
 			const GLvoid* pointer_;
-			/// Used to simulate missing `glDrawElementsBaseVertex()` on OpenGL ES 3.0
+			/// Used to simulate missing `glDrawElementsBaseVertex()` on OpenGL ES 3.0 and to offset per-instance attributes
 			unsigned int baseOffset_;
+			GLuint divisor_;
 
 			friend class GLVertexFormat;
 		};
@@ -9,7 +9,7 @@ namespace nCine
 	Geometry::Geometry()
 		: primitiveType_(GL_TRIANGLES), firstVertex_(0), numVertices_(0), numElementsPerVertex_(2), firstIndex_(0), numIndices_(0),
 			hostVertexPointer_(nullptr), hostIndexPointer_(nullptr), vboUsageFlags_(0), sharedVboParams_(nullptr), iboUsageFlags_(0),
-			sharedIboParams_(nullptr), hasDirtyVertices_(true), hasDirtyIndices_(true)
+			sharedIboParams_(nullptr), hasDirtyVertices_(true), hasDirtyIndices_(true), hasInstanceAttributes_(false)
 	{
 	}
 
@@ -189,7 +189,10 @@ namespace nCine
 
 	void Geometry::draw(GLsizei numInstances)
 	{
-		const GLint vboOffset = static_cast<GLint>(vboParams().offset / numElementsPerVertex_ / sizeof(GLfloat)) + firstVertex_;
+		// Per-instance attributes are offset in the vertex format instead
+		const GLint vboOffset = (hasInstanceAttributes_
+			? firstVertex_
+			: static_cast<GLint>(vboParams().offset / numElementsPerVertex_ / sizeof(GLfloat)) + firstVertex_);
 
 		void* iboOffsetPtr = nullptr;
 		if (numIndices_ > 0) {
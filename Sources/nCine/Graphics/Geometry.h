@@ -50,6 +50,15 @@ namespace nCine
 		inline void setNumElementsPerVertex(unsigned int numElements) {
 			numElementsPerVertex_ = numElements;
 		}
+		/// Returns true if the VBO contains per-instance attributes instead of per-vertex ones
+		inline bool hasInstanceAttributes() const {
+			return hasInstanceAttributes_;
+		}
+		/// Sets whether the VBO contains per-instance attributes instead of per-vertex ones
+		/*! \note Per-instance attributes are read from the start of the VBO range, the first vertex only affects `gl_VertexID` */
+		inline void setInstanceAttributes(bool instanceAttributes) {
+			hasInstanceAttributes_ = instanceAttributes;
+		}
 		/// Creates a custom VBO that is unique to this `Geometry` object
 		void createCustomVbo(unsigned int numFloats, GLenum usage);
 		/// Retrieves a pointer that can be used to write vertex data from a custom VBO owned by this object
@@ -127,6 +136,7 @@ namespace nCine
 
 		bool hasDirtyVertices_;
 		bool hasDirtyIndices_;
+		bool hasInstanceAttributes_;
 
 		void bind();
 		void draw(GLsizei numInstances);
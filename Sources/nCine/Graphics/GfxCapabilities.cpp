@@ -99,17 +99,17 @@ namespace nCine
 
 #if defined(DEATH_TARGET_EMSCRIPTEN)
 		const char* ExtensionNames[(int)GLExtensions::Count] = {
-			"GL_KHR_debug", "GL_ARB_texture_storage", "GL_ARB_get_program_binary", "WEBGL_compressed_texture_s3tc", "WEBGL_compressed_texture_etc1",
+			"GL_KHR_debug", "GL_ARB_texture_storage", "GL_ARB_get_program_binary", "GL_ARB_buffer_storage", "WEBGL_compressed_texture_s3tc", "WEBGL_compressed_texture_etc1",
 			"WEBGL_compressed_texture_atc", "WEBGL_compressed_texture_pvrtc", "WEBGL_compressed_texture_astc"
 		};
 #elif defined(WITH_OPENGLES) && !defined(DEATH_TARGET_EMSCRIPTEN) && !defined(DEATH_TARGET_UNIX)
 		const char* ExtensionNames[(int)GLExtensions::Count] = {
-			"GL_KHR_debug", "GL_ARB_texture_storage", "GL_ARB_get_program_binary", "GL_OES_get_program_binary", "GL_EXT_texture_compression_s3tc", "GL_OES_compressed_ETC1_RGB8_texture",
+			"GL_KHR_debug", "GL_ARB_texture_storage", "GL_ARB_get_program_binary", "GL_ARB_buffer_storage", "GL_OES_get_program_binary", "GL_EXT_texture_compression_s3tc", "GL_OES_compressed_ETC1_RGB8_texture",
 			"GL_AMD_compressed_ATC_texture", "GL_IMG_texture_compression_pvrtc", "GL_KHR_texture_compression_astc_ldr"
 		};
 #else
 		const char* ExtensionNames[(int)GLExtensions::Count] = {
-			"GL_KHR_debug", "GL_ARB_texture_storage", "GL_ARB_get_program_binary", "GL_EXT_texture_compression_s3tc",
+			"GL_KHR_debug", "GL_ARB_texture_storage", "GL_ARB_get_program_binary", "GL_ARB_buffer_storage", "GL_EXT_texture_compression_s3tc",
 			"GL_AMD_compressed_ATC_texture", "GL_IMG_texture_compression_pvrtc", "GL_KHR_texture_compression_astc_ldr"
 		};
 #endif
@@ -176,6 +176,7 @@ namespace nCine
 		LOGI_X("GL_KHR_debug: %d", glExtensions_[(int)GLExtensions::KHR_DEBUG]);
 		LOGI_X("GL_ARB_texture_storage: %d", glExtensions_[(int)GLExtensions::ARB_TEXTURE_STORAGE]);
 		LOGI_X("GL_ARB_get_program_binary: %d", glExtensions_[(int)GLExtensions::ARB_GET_PROGRAM_BINARY]);
+		LOGI_X("GL_ARB_buffer_storage: %d", glExtensions_[(int)GLExtensions::ARB_BUFFER_STORAGE]);
 #if defined(WITH_OPENGLES) && !defined(DEATH_TARGET_EMSCRIPTEN) && !defined(DEATH_TARGET_UNIX)
 		LOGI_X("GL_OES_get_program_binary: %d", glExtensions_[(int)GLExtensions::OES_GET_PROGRAM_BINARY]);
 #endif
@@ -16,7 +16,8 @@ namespace nCine
 
 	Material::Material(GLShaderProgram* program, GLTexture* texture)
 		: isBlendingEnabled_(false), srcBlendingFactor_(GL_SRC_ALPHA), destBlendingFactor_(GL_ONE_MINUS_SRC_ALPHA),
-			shaderProgramType_(ShaderProgramType::CUSTOM), shaderProgram_(program), uniformsHostBufferSize_(0)
+			shaderProgramType_(ShaderProgramType::CUSTOM), shaderProgram_(program), uniformsHostBufferSize_(0),
+			instanceTexRect_(nullptr), instanceSpriteSize_(nullptr), instanceColor_(nullptr), modelMatrixUniform_(nullptr)
 	{
 		for (unsigned int i = 0; i < GLTexture::MaxTextureUnits; i++) {
 			textures_[i] = nullptr;
@@ -57,6 +58,11 @@ namespace nCine
 		// The camera uniforms are handled separately as they have a different update frequency
 		shaderUniforms_.setProgram(shaderProgram_, nullptr, ProjectionViewMatrixExcludeString);
 		shaderUniformBlocks_.setProgram(shaderProgram_);
+		// Uniform data pointers are not valid until `reserveUniformsDataMemory()` or `setUniformsDataPointer()` is called
+		instanceTexRect_ = nullptr;
+		instanceSpriteSize_ = nullptr;
+		instanceColor_ = nullptr;
+		modelMatrixUniform_ = nullptr;
 
 		RenderResources::setDefaultAttributesParameters(*shaderProgram_);
 	}
@@ -90,6 +96,7 @@ namespace nCine
 		GLubyte* dataPointer = uniformsHostBuffer_.get();
 		shaderUniforms_.setUniformsDataPointer(dataPointer);
 		shaderUniformBlocks_.setUniformsDataPointer(&dataPointer[shaderProgram_->uniformsSize()]);
+		resolveInstanceUniforms();
 	}
 
 	void Material::setUniformsDataPointer(GLubyte* dataPointer)
@@ -101,6 +108,7 @@ namespace nCine
 		uniformsHostBufferSize_ = 0;
 		shaderUniforms_.setUniformsDataPointer(dataPointer);
 		shaderUniformBlocks_.setUniformsDataPointer(&dataPointer[shaderProgram_->uniformsSize()]);
+		resolveInstanceUniforms();
 	}
 
 	const GLTexture* Material::texture(unsigned int unit) const
@@ -181,6 +189,37 @@ namespace nCine
 		};
 	}
 
+	void Material::resolveInstanceUniforms()
+	{
+		instanceTexRect_ = nullptr;
+		instanceSpriteSize_ = nullptr;
+		instanceColor_ = nullptr;
+		modelMatrixUniform_ = nullptr;
+
+		if (shaderProgram_->status() != GLShaderProgram::Status::LinkedWithIntrospection) {
+			return;
+		}
+
+		GLUniformBlockCache* instanceBlock = shaderUniformBlocks_.uniformBlock(InstanceBlockName);
+		if (instanceBlock == nullptr) {
+			modelMatrixUniform_ = shaderUniforms_.uniform(ModelMatrixUniformName);
+			return;
+		}
+
+		modelMatrixUniform_ = instanceBlock->uniform(ModelMatrixUniformName);
+
+		// Sprites without texture have no `texRect` uniform, so only check presence of each one
+		if (GLUniformCache* texRect = instanceBlock->uniform(TexRectUniformName)) {
+			instanceTexRect_ = texRect->floatDataPointer(4);
+		}
+		if (GLUniformCache* spriteSize = instanceBlock->uniform(SpriteSizeUniformName)) {
+			instanceSpriteSize_ = spriteSize->floatDataPointer(2);
+		}
+		if (GLUniformCache* color = instanceBlock->uniform(ColorUniformName)) {
+			instanceColor_ = color->floatDataPointer(4);
+		}
+	}
+
 	uint32_t Material::sortKey()
 	{
 		constexpr uint32_t Seed = 1697381921;
@@ -52,6 +52,10 @@ namespace nCine
 			//BATCHED_TEXTNODES_ALPHA,
 			/// Shader program for a batch of TextNode classes with grayscale font texture
 			//BATCHED_TEXTNODES_RED,
+			/// Shader program for a batch of Sprite classes with per-instance attributes
+			INSTANCED_SPRITES,
+			/// Shader program for a batch of Sprite classes with solid colors, no texture and per-instance attributes
+			INSTANCED_SPRITES_NO_TEXTURE,
 			/// A custom shader program
 			CUSTOM
 		};
@@ -78,6 +82,11 @@ namespace nCine
 		static constexpr char MeshIndexAttributeName[] = "aMeshIndex";
 		static constexpr char ColorAttributeName[] = "aColor";
 
+		// Per-instance attribute names for instanced shaders
+		static constexpr char ModelMatrixAttributeNames[4][14] = { "aModelMatrix0", "aModelMatrix1", "aModelMatrix2", "aModelMatrix3" };
+		static constexpr char TexRectAttributeName[] = "aTexRect";
+		static constexpr char SpriteSizeAttributeName[] = "aSpriteSize";
+
 		/// Default constructor
 		Material();
 		Material(GLShaderProgram* program, GLTexture* texture);
@@ -129,6 +138,40 @@ namespace nCine
 			return shaderUniformBlocks_.uniformBlock(name);
 		}
 
+		/// Returns `true` if the well-known uniforms of the instance block have been resolved
+		inline bool hasInstanceUniforms() const {
+			return (instanceTexRect_ != nullptr && instanceSpriteSize_ != nullptr && instanceColor_ != nullptr);
+		}
+		/// Sets the `texRect` uniform of the instance block directly, without any lookup
+		inline void setInstanceTexRect(float scaleX, float biasX, float scaleY, float biasY) {
+			if (instanceTexRect_ != nullptr) {
+				instanceTexRect_[0] = scaleX;
+				instanceTexRect_[1] = biasX;
+				instanceTexRect_[2] = scaleY;
+				instanceTexRect_[3] = biasY;
+			}
+		}
+		/// Sets the `spriteSize` uniform of the instance block directly, without any lookup
+		inline void setInstanceSpriteSize(float width, float height) {
+			if (instanceSpriteSize_ != nullptr) {
+				instanceSpriteSize_[0] = width;
+				instanceSpriteSize_[1] = height;
+			}
+		}
+		/// Sets the `color` uniform of the instance block directly, without any lookup
+		inline void setInstanceColor(float r, float g, float b, float a) {
+			if (instanceColor_ != nullptr) {
+				instanceColor_[0] = r;
+				instanceColor_[1] = g;
+				instanceColor_[2] = b;
+				instanceColor_[3] = a;
+			}
+		}
+		/// Sets the `color` uniform of the instance block directly from an array of four floats
+		inline void setInstanceColor(const float* color) {
+			setInstanceColor(color[0], color[1], color[2], color[3]);
+		}
+
 		/// Wrapper around `GLShaderUniforms::allUniforms()`
 		inline const GLShaderUniforms::UniformHashMapType allUniforms() const {
 			return shaderUniforms_.allUniforms();
@@ -168,7 +211,16 @@ namespace nCine
 		/// Memory buffer with uniform values to be sent to the GPU
 		std::unique_ptr<GLubyte[]> uniformsHostBuffer_;
 
+		/// Cached pointers to the well-known uniforms of the instance block, resolved once per shader program and data pointer
+		GLfloat* instanceTexRect_;
+		GLfloat* instanceSpriteSize_;
+		GLfloat* instanceColor_;
+		/// Cached model matrix uniform, either from the instance block or a standalone one
+		GLUniformCache* modelMatrixUniform_;
+
 		void bind();
+		/// Resolves pointers to the model matrix and the well-known uniforms of the instance block, if any
+		void resolveInstanceUniforms();
 		/// Wrapper around `GLShaderUniforms::commitUniforms()`
 		inline void commitUniforms() {
 			shaderUniforms_.commitUniforms();
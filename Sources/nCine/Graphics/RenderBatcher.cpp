@@ -7,6 +7,7 @@
 #include "../ServiceLocator.h"
 #include "../Base/StaticHashMapIterator.h"
 
+#include <algorithm>
 #include <cstring> // for memcpy()
 
 namespace nCine
@@ -21,6 +22,20 @@ namespace nCine
 		// Clamping the value as some drivers report a maximum size similar to SSBO one
 		UboMaxSize = (maxUniformBlockSize <= 64 * 1024 ? maxUniformBlockSize : 64 * 1024);
 
+		// Instanced shaders need attribute divisors and `gl_VertexID`, the stride limit is reported only since OpenGL 4.4 and ES 3.1
+#if defined(WITH_OPENGLES) || defined(DEATH_TARGET_EMSCRIPTEN)
+		constexpr int MinInstancingVersion = 30;
+#else
+		constexpr int MinInstancingVersion = 33;
+#endif
+		const int glVersion = gfxCaps.glVersion(IGfxCapabilities::GLVersion::Major) * 10 + gfxCaps.glVersion(IGfxCapabilities::GLVersion::Minor);
+		const int maxVertexAttribStride = gfxCaps.value(IGfxCapabilities::GLIntValues::MAX_VERTEX_ATTRIB_STRIDE);
+		instancingSupported_ = (glVersion >= MinInstancingVersion &&
+			(maxVertexAttribStride <= 0 || maxVertexAttribStride >= static_cast<int>(sizeof(RenderResources::InstanceFormatSprite))));
+		if (theApplication().renderingSettings().batchingWithInstanceAttributes && !instancingSupported_) {
+			LOGW("Batching with per-instance attributes is not supported by the device, uniform buffers will be used instead");
+		}
+
 		// Create the first buffer right away
 		createBuffer(UboMaxSize);
 	}
@@ -41,6 +56,10 @@ namespace nCine
 		ASSERT(minBatchSize > 1);
 		ASSERT(maxBatchSize >= minBatchSize);
 
+		// Batches with per-instance attributes are only bound by the size of the common VBO, not by UBO limits
+		const bool withInstanceAttributes = (instancingSupported_ && theApplication().renderingSettings().batchingWithInstanceAttributes);
+		const unsigned int maxInstancedBatchSize = (fixedBatchSize > 0 ? fixedBatchSize : theApplication().renderingSettings().maxInstancedBatchSize);
+
 		unsigned int lastSplit = 0;
 
 		for (unsigned int i = 1; i < srcQueue.size(); i++) {
@@ -59,14 +78,19 @@ namespace nCine
 
 			// Split point if last command or split condition
 			if (i == srcQueue.size() - 1 || shouldSplit) {
-				const GLShaderProgram* batchedShader = RenderResources::batchedShader(prevCommand->material().shaderProgram());
-				if (batchedShader && (endSplit - lastSplit) >= minBatchSize) {
+				const GLShaderProgram* instancedShader = (withInstanceAttributes ? RenderResources::instancedShader(prevCommand->material().shaderProgram()) : nullptr);
+				const GLShaderProgram* batchedShader = (instancedShader == nullptr ? RenderResources::batchedShader(prevCommand->material().shaderProgram()) : nullptr);
+				if ((instancedShader || batchedShader) && (endSplit - lastSplit) >= minBatchSize) {
 					// Split point for the maximum batch size
 					while (lastSplit < endSplit) {
 						unsigned int currentMaxBatchSize = maxBatchSize;
-						const int shaderBatchSize = batchedShader->batchSize();
-						if (shaderBatchSize > 0 && currentMaxBatchSize > shaderBatchSize) {
-							currentMaxBatchSize = shaderBatchSize;
+						if (instancedShader != nullptr) {
+							currentMaxBatchSize = maxInstancedBatchSize;
+						} else {
+							const int shaderBatchSize = batchedShader->batchSize();
+							if (shaderBatchSize > 0 && currentMaxBatchSize > shaderBatchSize) {
+								currentMaxBatchSize = shaderBatchSize;
+							}
 						}
 
 						const unsigned int batchSize = endSplit - lastSplit;
@@ -80,8 +104,10 @@ namespace nCine
 						SmallVectorImpl<RenderCommand*>::const_iterator start = srcQueue.begin() + lastSplit;
 						SmallVectorImpl<RenderCommand*>::const_iterator end = srcQueue.begin() + nextSplit;
 
-						// Handling early splits while collecting (not enough UBO free space)
-						RenderCommand* batchCommand = collectCommands(start, end, start);
+						// Handling early splits while collecting (not enough UBO or VBO free space)
+						RenderCommand* batchCommand = (instancedShader != nullptr
+							? collectInstancedCommands(start, end, start)
+							: collectCommands(start, end, start));
 						destQueue.push_back(batchCommand);
 						lastSplit = start - srcQueue.begin();
 					}
@@ -149,20 +175,7 @@ namespace nCine
 
 		const unsigned long nonBlockUniformsSize = batchCommand->material().shaderProgram()->uniformsSize();
 		// Determine how much memory is needed by uniform blocks that are not for instances
-		unsigned long nonInstancesBlocksSize = 0;
-		const GLShaderUniformBlocks::UniformHashMapType allUniformBlocks = refCommand->material().allUniformBlocks();
-		for (const GLUniformBlockCache& uniformBlockCache : allUniformBlocks) {
-			const char* uniformBlockName = uniformBlockCache.uniformBlock()->name();
-			if (strcmp(uniformBlockName, Material::InstanceBlockName) == 0) {
-				continue;
-			}
-
-			GLUniformBlockCache* batchBlock = batchCommand->material().uniformBlock(uniformBlockName);
-			ASSERT(batchBlock);
-			if (batchBlock) {
-				nonInstancesBlocksSize += uniformBlockCache.size() - uniformBlockCache.alignAmount();
-			}
-		}
+		const unsigned long nonInstancesBlocksSize = RenderBatcher::nonInstancesBlocksSize(*refCommand, *batchCommand);
 
 		// Set to true if at least one command in the batch has indices or forced by a rendering settings
 		bool batchingWithIndices = theApplication().renderingSettings().batchingWithIndices;
@@ -185,33 +198,7 @@ namespace nCine
 		nextStart = it;
 
 		batchCommand->material().setUniformsDataPointer(acquireMemory(nonBlockUniformsSize + nonInstancesBlocksSize + instancesBlockSize));
-		// Copying data for non-instances uniform blocks from the first command in the batch
-		for (const GLUniformBlockCache& uniformBlockCache : allUniformBlocks) {
-			const char* uniformBlockName = uniformBlockCache.uniformBlock()->name();
-			if (strcmp(uniformBlockName, Material::InstanceBlockName) == 0) {
-				continue;
-			}
-
-			GLUniformBlockCache* batchBlock = batchCommand->material().uniformBlock(uniformBlockName);
-			const bool dataCopied = batchBlock->copyData(uniformBlockCache.dataPointer());
-			ASSERT(dataCopied);
-			batchBlock->setUsedSize(uniformBlockCache.usedSize());
-		}
-
-		// Setting sampler uniforms for GL_TEXTURE* units
-		const GLShaderUniforms::UniformHashMapType allUniforms = refCommand->material().allUniforms();
-		for (const GLUniformCache& uniformCache : allUniforms) {
-			if (uniformCache.uniform()->type() == GL_SAMPLER_2D) {
-				GLUniformCache* batchUniformCache = batchCommand->material().uniform(uniformCache.uniform()->name());
-				const int refValue = uniformCache.intValue(0);
-				const int batchValue = batchUniformCache->intValue(0);
-				// Also checking if the command has just been added, as the memory at the
-				// uniforms data pointer is not cleared and might contain the reference value
-				if (batchValue != refValue || commandAdded) {
-					batchUniformCache->setIntValue(refValue);
-				}
-			}
-		}
+		copyNonInstancesUniforms(*refCommand, *batchCommand, commandAdded);
 
 		const unsigned long maxVertexDataSize = RenderResources::buffersManager().specs(RenderBuffersManager::BufferTypes::Array).maxSize;
 		const unsigned long maxIndexDataSize = RenderResources::buffersManager().specs(RenderBuffersManager::BufferTypes::ElementArray).maxSize;
@@ -353,15 +340,9 @@ namespace nCine
 			}
 		}
 
-		for (unsigned int i = 0; i < GLTexture::MaxTextureUnits; i++) {
-			batchCommand->material().setTexture(i, refCommand->material().texture(i));
-		}
-		batchCommand->material().setBlendingEnabled(refCommand->material().isBlendingEnabled());
-		batchCommand->material().setBlendingFactors(refCommand->material().srcBlendingFactor(), refCommand->material().destBlendingFactor());
+		copyMaterialState(*refCommand, *batchCommand);
 		batchCommand->setBatchSize(nextStart - start);
 		batchCommand->material().uniformBlock(Material::InstancesBlockName)->setUsedSize(instancesBlockOffset);
-		batchCommand->setLayer(refCommand->layer());
-		batchCommand->setVisitOrder(refCommand->visitOrder());
 
 		if (batchedShaderHasAttributes) {
 			const unsigned int totalVertices = instancesVertexDataSize / SizeVertexFormatAndIndex;
@@ -375,6 +356,129 @@ namespace nCine
 		return batchCommand;
 	}
 
+	RenderCommand* RenderBatcher::collectInstancedCommands(
+		SmallVectorImpl<RenderCommand*>::const_iterator start,
+		SmallVectorImpl<RenderCommand*>::const_iterator end,
+		SmallVectorImpl<RenderCommand*>::const_iterator& nextStart)
+	{
+		ASSERT(end > start);
+
+		const RenderCommand* refCommand = *start;
+		GLShaderProgram* instancedShader = RenderResources::instancedShader(refCommand->material().shaderProgram());
+		// The following check should never fail as it is already checked by the calling function
+		FATAL_ASSERT_MSG(instancedShader != nullptr, "Unsupported shader for instanced batch element");
+		bool commandAdded = false;
+		RenderCommand* batchCommand = RenderResources::renderCommandPool().retrieveOrAdd(instancedShader, commandAdded);
+		if (commandAdded) {
+			batchCommand->setType(refCommand->type());
+		}
+
+		// Per-instance attributes have the same layout as the instance uniform block without the `std140` trailing padding
+		const GLVertexFormat::Attribute* modelMatrixAttribute = instancedShader->attribute(Material::ModelMatrixAttributeNames[0]);
+		FATAL_ASSERT_MSG_X(modelMatrixAttribute != nullptr && modelMatrixAttribute->divisor() > 0, "Instanced shader does not have an %s attribute", Material::ModelMatrixAttributeNames[0]);
+		const unsigned int instanceStride = modelMatrixAttribute->stride();
+		const unsigned int numFloatsPerInstance = instanceStride / sizeof(GLfloat);
+		const GLUniformBlockCache* singleInstanceBlock = (*start)->material().uniformBlock(Material::InstanceBlockName);
+		const unsigned int singleInstanceBlockSizePacked = singleInstanceBlock->size() - singleInstanceBlock->alignAmount();
+		const unsigned int instanceDataSize = std::min(singleInstanceBlockSizePacked, instanceStride);
+
+		const unsigned long nonBlockUniformsSize = instancedShader->uniformsSize();
+		const unsigned long nonInstancesBlocksSize = RenderBatcher::nonInstancesBlocksSize(*refCommand, *batchCommand);
+		batchCommand->material().setUniformsDataPointer(acquireMemory(nonBlockUniformsSize + nonInstancesBlocksSize));
+		copyNonInstancesUniforms(*refCommand, *batchCommand, commandAdded);
+
+		// Don't request more bytes than a common VBO can hold
+		const unsigned long maxVertexDataSize = RenderResources::buffersManager().specs(RenderBuffersManager::BufferTypes::Array).maxSize;
+		const unsigned long maxInstances = maxVertexDataSize / instanceStride;
+		nextStart = (static_cast<unsigned long>(end - start) > maxInstances ? start + maxInstances : end);
+		const unsigned int numInstances = static_cast<unsigned int>(nextStart - start);
+
+		GLfloat* destInstance = batchCommand->geometry().acquireVertexPointer(numInstances * numFloatsPerInstance, numFloatsPerInstance);
+		for (SmallVectorImpl<RenderCommand*>::const_iterator it = start; it != nextStart; ++it) {
+			RenderCommand* command = *it;
+			command->commitNodeTransformation();
+
+			const GLUniformBlockCache* instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
+			memcpy(destInstance, instanceBlock->dataPointer(), instanceDataSize);
+			destInstance += numFloatsPerInstance;
+		}
+		batchCommand->geometry().releaseVertexPointer();
+
+		copyMaterialState(*refCommand, *batchCommand);
+		batchCommand->setBatchSize(numInstances);
+		batchCommand->setNumInstances(numInstances);
+
+		// Every instance is a quad, its vertices are generated from `gl_VertexID` in the shader
+		batchCommand->geometry().setDrawParameters(GL_TRIANGLE_STRIP, 0, 4);
+		batchCommand->geometry().setNumElementsPerVertex(numFloatsPerInstance);
+		batchCommand->geometry().setNumIndices(0);
+		batchCommand->geometry().setInstanceAttributes(true);
+
+		return batchCommand;
+	}
+
+	unsigned long RenderBatcher::nonInstancesBlocksSize(const RenderCommand& refCommand, RenderCommand& batchCommand)
+	{
+		unsigned long nonInstancesBlocksSize = 0;
+		const GLShaderUniformBlocks::UniformHashMapType allUniformBlocks = refCommand.material().allUniformBlocks();
+		for (const GLUniformBlockCache& uniformBlockCache : allUniformBlocks) {
+			const char* uniformBlockName = uniformBlockCache.uniformBlock()->name();
+			if (strcmp(uniformBlockName, Material::InstanceBlockName) == 0) {
+				continue;
+			}
+
+			GLUniformBlockCache* batchBlock = batchCommand.material().uniformBlock(uniformBlockName);
+			ASSERT(batchBlock);
+			if (batchBlock) {
+				nonInstancesBlocksSize += uniformBlockCache.size() - uniformBlockCache.alignAmount();
+			}
+		}
+		return nonInstancesBlocksSize;
+	}
+
+	void RenderBatcher::copyNonInstancesUniforms(const RenderCommand& refCommand, RenderCommand& batchCommand, bool commandAdded)
+	{
+		// Copying data for non-instances uniform blocks from the first command in the batch
+		const GLShaderUniformBlocks::UniformHashMapType allUniformBlocks = refCommand.material().allUniformBlocks();
+		for (const GLUniformBlockCache& uniformBlockCache : allUniformBlocks) {
+			const char* uniformBlockName = uniformBlockCache.uniformBlock()->name();
+			if (strcmp(uniformBlockName, Material::InstanceBlockName) == 0) {
+				continue;
+			}
+
+			GLUniformBlockCache* batchBlock = batchCommand.material().uniformBlock(uniformBlockName);
+			const bool dataCopied = batchBlock->copyData(uniformBlockCache.dataPointer());
+			ASSERT(dataCopied);
+			batchBlock->setUsedSize(uniformBlockCache.usedSize());
+		}
+
+		// Setting sampler uniforms for GL_TEXTURE* units
+		const GLShaderUniforms::UniformHashMapType allUniforms = refCommand.material().allUniforms();
+		for (const GLUniformCache& uniformCache : allUniforms) {
+			if (uniformCache.uniform()->type() == GL_SAMPLER_2D) {
+				GLUniformCache* batchUniformCache = batchCommand.material().uniform(uniformCache.uniform()->name());
+				const int refValue = uniformCache.intValue(0);
+				const int batchValue = batchUniformCache->intValue(0);
+				// Also checking if the command has just been added, as the memory at the
+				// uniforms data pointer is not cleared and might contain the reference value
+				if (batchValue != refValue || commandAdded) {
+					batchUniformCache->setIntValue(refValue);
+				}
+			}
+		}
+	}
+
+	void RenderBatcher::copyMaterialState(const RenderCommand& refCommand, RenderCommand& batchCommand)
+	{
+		for (unsigned int i = 0; i < GLTexture::MaxTextureUnits; i++) {
+			batchCommand.material().setTexture(i, refCommand.material().texture(i));
+		}
+		batchCommand.material().setBlendingEnabled(refCommand.material().isBlendingEnabled());
+		batchCommand.material().setBlendingFactors(refCommand.material().srcBlendingFactor(), refCommand.material().destBlendingFactor());
+		batchCommand.setLayer(refCommand.layer());
+		batchCommand.setVisitOrder(refCommand.visitOrder());
+	}
+
 	unsigned char* RenderBatcher::acquireMemory(unsigned int bytes)
 	{
 		FATAL_ASSERT(bytes <= UboMaxSize);
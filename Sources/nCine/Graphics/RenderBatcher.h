@@ -20,9 +20,16 @@ namespace nCine
 		void createBatches(const SmallVectorImpl<RenderCommand*>& srcQueue, SmallVectorImpl<RenderCommand*>& destQueue);
 		void reset();
 
+		/// Returns true if the device supports batching with per-instance attributes
+		inline bool isInstancingSupported() const {
+			return instancingSupported_;
+		}
+
 	private:
 		static unsigned int UboMaxSize;
 
+		bool instancingSupported_;
+
 		struct ManagedBuffer
 		{
 			ManagedBuffer()
@@ -38,6 +45,15 @@ namespace nCine
 		SmallVector<ManagedBuffer, 0> buffers_;
 
 		RenderCommand* collectCommands(SmallVectorImpl<RenderCommand*>::const_iterator start, SmallVectorImpl<RenderCommand*>::const_iterator end, SmallVectorImpl<RenderCommand*>::const_iterator& nextStart);
+		/// Collects commands into a batch that streams their instance data as per-instance vertex attributes
+		RenderCommand* collectInstancedCommands(SmallVectorImpl<RenderCommand*>::const_iterator start, SmallVectorImpl<RenderCommand*>::const_iterator end, SmallVectorImpl<RenderCommand*>::const_iterator& nextStart);
+
+		/// Returns the memory needed by uniform blocks of the reference command that are not for instances
+		static unsigned long nonInstancesBlocksSize(const RenderCommand& refCommand, RenderCommand& batchCommand);
+		/// Copies uniform blocks that are not for instances and sampler uniforms from the reference command
+		static void copyNonInstancesUniforms(const RenderCommand& refCommand, RenderCommand& batchCommand, bool commandAdded);
+		/// Copies textures, blending and sorting state from the reference command
+		static void copyMaterialState(const RenderCommand& refCommand, RenderCommand& batchCommand);
 
 		unsigned char* acquireMemory(unsigned int bytes);
 		void createBuffer(unsigned int size);
@@ -6,11 +6,19 @@
 #include "../../Common.h"
 #include "../tracy.h"
 
+#if defined(NCINE_PROFILING)
+#	include "../Base/TimeStamp.h"
+#endif
+
 namespace nCine
 {
-	RenderBuffersManager::RenderBuffersManager(bool useBufferMapping, unsigned long vboMaxSize, unsigned long iboMaxSize)
+	RenderBuffersManager::RenderBuffersManager(bool useBufferMapping, bool usePersistentMapping, unsigned long vboMaxSize, unsigned long iboMaxSize)
+		: persistentMapping_(false), currentRegion_(0)
 	{
 		buffers_.reserve(4);
+		for (unsigned int i = 0; i < NumPersistentRegions; i++) {
+			regionFences_[i] = nullptr;
+		}
 
 		BufferSpecifications& vboSpecs = specs_[(int)BufferTypes::Array];
 		vboSpecs.type = BufferTypes::Array;
@@ -29,6 +37,19 @@ namespace nCine
 		iboSpecs.alignment = sizeof(GLushort);
 
 		const IGfxCapabilities& gfxCaps = theServiceLocator().gfxCapabilities();
+#if !defined(WITH_OPENGLES) && !(defined(DEATH_TARGET_APPLE) && defined(DEATH_TARGET_ARM))
+		if (usePersistentMapping) {
+			const int glVersion = gfxCaps.glVersion(IGfxCapabilities::GLVersion::Major) * 100 + gfxCaps.glVersion(IGfxCapabilities::GLVersion::Minor);
+			persistentMapping_ = (glVersion >= 404 || gfxCaps.hasExtension(IGfxCapabilities::GLExtensions::ARB_BUFFER_STORAGE));
+			if (!persistentMapping_) {
+				LOGW("Persistent mapping of buffers is not supported, falling back to the default strategy");
+			}
+		}
+#else
+		if (usePersistentMapping) {
+			LOGW("Persistent mapping of buffers is not supported on this platform, falling back to the default strategy");
+		}
+#endif
 		const int maxUniformBlockSize = gfxCaps.value(IGfxCapabilities::GLIntValues::MAX_UNIFORM_BLOCK_SIZE);
 		const int offsetAlignment = gfxCaps.value(IGfxCapabilities::GLIntValues::UNIFORM_BUFFER_OFFSET_ALIGNMENT);
 
@@ -49,8 +70,24 @@ namespace nCine
 		}
 	}
 
+	RenderBuffersManager::~RenderBuffersManager()
+	{
+		for (unsigned int i = 0; i < NumPersistentRegions; i++) {
+			if (regionFences_[i] != nullptr) {
+				glDeleteSync(regionFences_[i]);
+				regionFences_[i] = nullptr;
+			}
+		}
+	}
+
 	namespace
 	{
+#if !defined(WITH_OPENGLES) && !(defined(DEATH_TARGET_APPLE) && defined(DEATH_TARGET_ARM))
+		// Writes are flushed explicitly, so the mapping doesn't need to be coherent
+		constexpr GLbitfield PersistentStorageFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT;
+		constexpr GLbitfield PersistentMapFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_FLUSH_EXPLICIT_BIT;
+#endif
+
 		const char* bufferTypeToString(RenderBuffersManager::BufferTypes type)
 		{
 			switch (type) {
@@ -75,33 +112,39 @@ namespace nCine
 		Parameters params;
 
 		for (ManagedBuffer& buffer : buffers_) {
-			if (buffer.type == type) {
-				const unsigned long offset = buffer.size - buffer.freeSpace;
-				const unsigned int alignAmount = (alignment - offset % alignment) % alignment;
-
-				if (buffer.freeSpace >= bytes + alignAmount) {
-					params.object = buffer.object.get();
-					params.offset = offset + alignAmount;
-					params.size = bytes;
-					buffer.freeSpace -= bytes + alignAmount;
-					params.mapBase = buffer.mapBase;
-					break;
-				}
+			if (buffer.type == type && tryAcquire(buffer, bytes, alignment, params)) {
+				break;
 			}
 		}
 
 		if (params.object == nullptr) {
 			createBuffer(specs_[(int)type]);
-			params.object = buffers_.back().object.get();
-			params.offset = 0;
-			params.size = bytes;
-			buffers_.back().freeSpace -= bytes;
-			params.mapBase = buffers_.back().mapBase;
+			const bool acquired = tryAcquire(buffers_.back(), bytes, alignment, params);
+			FATAL_ASSERT(acquired);
 		}
 
 		return params;
 	}
 
+	bool RenderBuffersManager::tryAcquire(ManagedBuffer& buffer, unsigned long bytes, unsigned int alignment, Parameters& params)
+	{
+		// Offsets of persistently mapped buffers are relative to the whole buffer, so the alignment is computed on the final offset
+		const unsigned long regionOffset = currentRegion_ * buffer.regionStride;
+		const unsigned long offset = regionOffset + buffer.size - buffer.freeSpace;
+		const unsigned int alignAmount = (alignment - offset % alignment) % alignment;
+
+		if (buffer.freeSpace < bytes + alignAmount) {
+			return false;
+		}
+
+		params.object = buffer.object.get();
+		params.offset = offset + alignAmount;
+		params.size = bytes;
+		buffer.freeSpace -= bytes + alignAmount;
+		params.mapBase = buffer.mapBase;
+		return true;
+	}
+
 	void RenderBuffersManager::flushUnmap()
 	{
 		ZoneScoped;
@@ -115,6 +158,14 @@ namespace nCine
 			FATAL_ASSERT(usedSize <= specs_[(int)buffer.type].maxSize);
 			buffer.freeSpace = buffer.size;
 
+			if (persistentMapping_) {
+				// The buffer stays mapped, only the range written by this frame is flushed
+				if (usedSize > 0) {
+					buffer.object->flushMappedBufferRange(currentRegion_ * buffer.regionStride, usedSize);
+				}
+				continue;
+			}
+
 			if (specs_[(int)buffer.type].mapFlags == 0) {
 				if (usedSize > 0) {
 					buffer.object->bufferSubData(0, usedSize, buffer.hostBuffer.get());
@@ -135,6 +186,17 @@ namespace nCine
 		ZoneScoped;
 		GLDebug::ScopedGroup scoped("RenderBuffersManager::remap()");
 
+		if (persistentMapping_) {
+			// All commands reading from the region of this frame have been issued, the next frame moves to the next region
+			if (regionFences_[currentRegion_] != nullptr) {
+				glDeleteSync(regionFences_[currentRegion_]);
+			}
+			regionFences_[currentRegion_] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+			currentRegion_ = (currentRegion_ + 1) % NumPersistentRegions;
+			waitForRegion();
+			return;
+		}
+
 		for (ManagedBuffer& buffer : buffers_) {
 			ASSERT(buffer.freeSpace == buffer.size);
 			ASSERT(buffer.mapBase == nullptr);
@@ -156,8 +218,18 @@ namespace nCine
 		managedBuffer.type = specs.type;
 		managedBuffer.size = specs.maxSize;
 		managedBuffer.object = std::make_unique<GLBufferObject>(specs.target);
-		managedBuffer.object->bufferData(managedBuffer.size, nullptr, specs.usageFlags);
 		managedBuffer.freeSpace = managedBuffer.size;
+#if !defined(WITH_OPENGLES) && !(defined(DEATH_TARGET_APPLE) && defined(DEATH_TARGET_ARM))
+		if (persistentMapping_) {
+			// Every region starts at an offset aligned to the buffer specifications
+			managedBuffer.regionStride = managedBuffer.size + (specs.alignment - managedBuffer.size % specs.alignment) % specs.alignment;
+			const GLsizeiptr storageSize = static_cast<GLsizeiptr>(managedBuffer.regionStride * NumPersistentRegions);
+			managedBuffer.object->bufferStorage(storageSize, nullptr, PersistentStorageFlags);
+		} else
+#endif
+		{
+			managedBuffer.object->bufferData(managedBuffer.size, nullptr, specs.usageFlags);
+		}
 
 		switch (managedBuffer.type) {
 			default:
@@ -172,6 +244,11 @@ namespace nCine
 				break;
 		}
 
+#if !defined(WITH_OPENGLES) && !(defined(DEATH_TARGET_APPLE) && defined(DEATH_TARGET_ARM))
+		if (persistentMapping_) {
+			managedBuffer.mapBase = static_cast<GLubyte*>(managedBuffer.object->mapBufferRange(0, managedBuffer.regionStride * NumPersistentRegions, PersistentMapFlags));
+		} else
+#endif
 		if (specs.mapFlags == 0) {
 			managedBuffer.hostBuffer = std::make_unique<GLubyte[]>(specs.maxSize);
 			managedBuffer.mapBase = managedBuffer.hostBuffer.get();
@@ -185,4 +262,37 @@ namespace nCine
 		//debugString.format("Create %s buffer 0x%lx", bufferTypeToString(specs.type), uintptr_t(buffers_.back().object.get()));
 		//GLDebug::messageInsert(debugString.data());
 	}
+
+	void RenderBuffersManager::waitForRegion()
+	{
+		ZoneScoped;
+
+		GLsync fence = regionFences_[currentRegion_];
+		if (fence == nullptr) {
+			return;
+		}
+
+		// Checking without a timeout first, the GPU should usually be done with a region written two frames ago
+		GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+		if (result == GL_TIMEOUT_EXPIRED) {
+#if defined(NCINE_PROFILING)
+			const TimeStamp waitStart = TimeStamp::now();
+#endif
+			// Waiting one millisecond at a time
+			constexpr GLuint64 WaitTimeout = 1000000;
+			do {
+				result = glClientWaitSync(fence, 0, WaitTimeout);
+			} while (result == GL_TIMEOUT_EXPIRED);
+#if defined(NCINE_PROFILING)
+			RenderStatistics::addBufferSyncWait(waitStart.millisecondsSince());
+#endif
+		}
+
+		if (result == GL_WAIT_FAILED) {
+			LOGW("Failed to wait for a buffer region fence");
+		}
+
+		glDeleteSync(fence);
+		regionFences_[currentRegion_] = nullptr;
+	}
 }
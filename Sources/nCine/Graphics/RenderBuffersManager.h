@@ -44,7 +44,11 @@ namespace nCine
 			GLubyte* mapBase;
 		};
 
-		RenderBuffersManager(bool useBufferMapping, unsigned long vboMaxSize, unsigned long iboMaxSize);
+		/// Number of regions of a persistently mapped buffer, one frame writes to one of them while the others are used by the GPU
+		static constexpr unsigned int NumPersistentRegions = 3;
+
+		RenderBuffersManager(bool useBufferMapping, bool usePersistentMapping, unsigned long vboMaxSize, unsigned long iboMaxSize);
+		~RenderBuffersManager();
 
 		/// Returns the specifications for a buffer of the specified type
 		inline const BufferSpecifications& specs(BufferTypes type) const {
@@ -57,27 +61,45 @@ namespace nCine
 		/// Requests an amount of bytes from the specified buffer type with a custom alignment requirement
 		Parameters acquireMemory(BufferTypes type, unsigned long bytes, unsigned int alignment);
 
+		/// Returns `true` if buffers are persistently mapped and used as ring buffers
+		inline bool isPersistentlyMapped() const {
+			return persistentMapping_;
+		}
+
 	private:
 		BufferSpecifications specs_[(int)BufferTypes::Count];
 
 		struct ManagedBuffer
 		{
 			ManagedBuffer()
-				: type(BufferTypes::Array), size(0), freeSpace(0), object(nullptr), mapBase(nullptr), hostBuffer(nullptr) {}
+				: type(BufferTypes::Array), size(0), freeSpace(0), regionStride(0), object(nullptr), mapBase(nullptr), hostBuffer(nullptr) {}
 
 			BufferTypes type;
 			std::unique_ptr<GLBufferObject> object;
 			unsigned long size;
 			unsigned long freeSpace;
+			/// Distance in bytes between two regions of a persistently mapped buffer
+			unsigned long regionStride;
 			GLubyte* mapBase;
 			std::unique_ptr<GLubyte[]> hostBuffer;
 		};
 
 		SmallVector<ManagedBuffer, 0> buffers_;
 
+		/// The flag is `true` if buffers are persistently mapped and used as ring buffers
+		bool persistentMapping_;
+		/// Index of the persistently mapped region used by the current frame
+		unsigned int currentRegion_;
+		/// Fences signaled when the GPU has finished reading from a region
+		GLsync regionFences_[NumPersistentRegions];
+
 		void flushUnmap();
 		void remap();
 		void createBuffer(const BufferSpecifications& specs);
+		/// Acquires memory from the specified buffer if it has enough free space left
+		bool tryAcquire(ManagedBuffer& buffer, unsigned long bytes, unsigned int alignment, Parameters& params);
+		/// Waits until the GPU has finished reading from the current region
+		void waitForRegion();
 
 		friend class ScreenViewport;
 #if defined(NCINE_PROFILING)
@@ -49,6 +49,9 @@ namespace nCine
 			offset = geometry_.vboParams().offset + (geometry_.firstVertex_ * geometry_.numElementsPerVertex_ * sizeof(GLfloat));
 		}
 #endif
+		if (geometry_.hasInstanceAttributes_) {
+			offset = geometry_.vboParams().offset;
+		}
 		material_.defineVertexFormat(geometry_.vboParams().object, geometry_.iboParams().object, offset);
 		geometry_.bind();
 		geometry_.draw(numInstances_);
@@ -79,10 +82,7 @@ namespace nCine
 		modelMatrix_[3][2] = calculateDepth(layer_, cameraValues.near, cameraValues.far);
 
 		if (material_.shaderProgram_ && material_.shaderProgram_->status() == GLShaderProgram::Status::LinkedWithIntrospection) {
-			GLUniformBlockCache* instanceBlock = material_.uniformBlock(Material::InstanceBlockName);
-			GLUniformCache* matrixUniform = instanceBlock
-				? instanceBlock->uniform(Material::ModelMatrixUniformName)
-				: material_.uniform(Material::ModelMatrixUniformName);
+			GLUniformCache* matrixUniform = material_.modelMatrixUniform_;
 			if (matrixUniform) {
 				ZoneScopedN("Set model matrix");
 				matrixUniform->setFloatVector(modelMatrix_.Data());
@@ -1,10 +1,16 @@
 #include "RenderCommandPool.h"
 #include "RenderCommand.h"
 #include "RenderStatistics.h"
+#if defined(WITH_ALLOCATORS)
+#	include "../Base/AllocManager.h"
+#endif
 
 namespace nCine
 {
 	RenderCommandPool::RenderCommandPool(unsigned int poolSize)
+#if defined(WITH_ALLOCATORS)
+		: commandAllocator_("RenderCommands", sizeof(RenderCommand), alignof(RenderCommand), poolSize > 0 ? poolSize : 1, AllocManager::proxy(AllocTag::Graphics))
+#endif
 	{
 		freeCommandsPool_.reserve(poolSize);
 		usedCommandsPool_.reserve(poolSize);
@@ -14,7 +20,11 @@ namespace nCine
 
 	RenderCommand* RenderCommandPool::add()
 	{
-		std::unique_ptr<RenderCommand>& player = usedCommandsPool_.emplace_back(std::make_unique<RenderCommand>());
+#if defined(WITH_ALLOCATORS)
+		CommandPtr& player = usedCommandsPool_.emplace_back(allocateUnique<RenderCommand>(commandAllocator_));
+#else
+		CommandPtr& player = usedCommandsPool_.emplace_back(std::make_unique<RenderCommand>());
+#endif
 		return player.get();
 	}
 
@@ -32,7 +42,7 @@ namespace nCine
 
 		for (unsigned int i = 0; i < freeCommandsPool_.size(); i++) {
 			const unsigned int poolSize = (unsigned int)freeCommandsPool_.size();
-			std::unique_ptr<RenderCommand>& command = freeCommandsPool_[i];
+			CommandPtr& command = freeCommandsPool_[i];
 			if (command && command->material().shaderProgram() == shaderProgram) {
 				retrievedCommand = command.get();
 				usedCommandsPool_.push_back(std::move(command));
@@ -68,7 +78,7 @@ namespace nCine
 #if defined(NCINE_PROFILING)
 		RenderStatistics::gatherCommandPoolStatistics((unsigned int)usedCommandsPool_.size(), (unsigned int)freeCommandsPool_.size());
 #endif
-		for (std::unique_ptr<RenderCommand>& command : usedCommandsPool_) {
+		for (CommandPtr& command : usedCommandsPool_) {
 			freeCommandsPool_.push_back(std::move(command));
 		}
 		usedCommandsPool_.clear();
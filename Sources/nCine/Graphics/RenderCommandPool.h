@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Material.h"
+#include "../Base/PoolAllocator.h"
+#include "../Base/StlAllocator.h"
 
 #include <memory>
 
@@ -36,8 +38,17 @@ namespace nCine
 		void reset();
 
 	private:
-		SmallVector<std::unique_ptr<RenderCommand>, 0> freeCommandsPool_;
-		SmallVector<std::unique_ptr<RenderCommand>, 0> usedCommandsPool_;
+#if defined(WITH_ALLOCATORS)
+		using CommandPtr = AllocatorUniquePtr<RenderCommand>;
+
+		/// Commands are allocated from pages of fixed-size blocks, it has to be destroyed after the commands
+		PoolAllocator commandAllocator_;
+#else
+		using CommandPtr = std::unique_ptr<RenderCommand>;
+#endif
+
+		SmallVector<CommandPtr, 0> freeCommandsPool_;
+		SmallVector<CommandPtr, 0> usedCommandsPool_;
 	};
 
 }
@@ -43,6 +43,7 @@ namespace nCine
 
 	std::unique_ptr<GLShaderProgram> RenderResources::defaultShaderPrograms_[DefaultShaderProgramsCount];
 	HashMap<const GLShaderProgram*, GLShaderProgram*> RenderResources::batchedShaders_(32);
+	HashMap<const GLShaderProgram*, GLShaderProgram*> RenderResources::instancedShaders_(32);
 
 	unsigned char RenderResources::cameraUniformsBuffer_[UniformsBufferSize];
 	HashMap<GLShaderProgram*, RenderResources::CameraUniformData> RenderResources::cameraUniformDataMap_(32);
@@ -77,6 +78,27 @@ namespace nCine
 		return (batchedShaders_.erase(shader) > 0);
 	}
 
+	GLShaderProgram* RenderResources::instancedShader(const GLShaderProgram* shader)
+	{
+		auto it = instancedShaders_.find(shader);
+		return (it != instancedShaders_.end() ? it->second : nullptr);
+	}
+
+	bool RenderResources::registerInstancedShader(const GLShaderProgram* shader, GLShaderProgram* instancedShader)
+	{
+		FATAL_ASSERT(shader != nullptr);
+		FATAL_ASSERT(instancedShader != nullptr);
+		FATAL_ASSERT(shader != instancedShader);
+
+		return instancedShaders_.emplace(shader, instancedShader).second;
+	}
+
+	bool RenderResources::unregisterInstancedShader(const GLShaderProgram* shader)
+	{
+		ASSERT(shader != nullptr);
+		return (instancedShaders_.erase(shader) > 0);
+	}
+
 	RenderResources::CameraUniformData* RenderResources::findCameraUniformData(GLShaderProgram* shaderProgram)
 	{
 		auto it = cameraUniformDataMap_.find(shaderProgram);
@@ -104,6 +126,36 @@ namespace nCine
 			return;
 		}
 
+		// Per-instance attributes of instanced shaders are stored in the same layout as the `InstanceBlock` of the non-instanced ones
+		if (shaderProgram.attribute(Material::ModelMatrixAttributeNames[0]) != nullptr) {
+			GLVertexFormat::Attribute* colorAttribute = shaderProgram.attribute(Material::ColorAttributeName);
+			GLVertexFormat::Attribute* texRectAttribute = shaderProgram.attribute(Material::TexRectAttributeName);
+			GLVertexFormat::Attribute* spriteSizeAttribute = shaderProgram.attribute(Material::SpriteSizeAttributeName);
+			const GLsizei stride = (texRectAttribute != nullptr ? sizeof(InstanceFormatSprite) : sizeof(InstanceFormatSpriteNoTexture));
+
+			for (unsigned int i = 0; i < countof(Material::ModelMatrixAttributeNames); i++) {
+				GLVertexFormat::Attribute* modelMatrixAttribute = shaderProgram.attribute(Material::ModelMatrixAttributeNames[i]);
+				if (modelMatrixAttribute != nullptr && modelMatrixAttribute->stride() == 0) {
+					modelMatrixAttribute->setVboParameters(stride, reinterpret_cast<void*>(offsetof(InstanceFormatSprite, modelMatrix) + i * 4 * sizeof(GLfloat)));
+					modelMatrixAttribute->setDivisor(1);
+				}
+			}
+			if (colorAttribute != nullptr && colorAttribute->stride() == 0) {
+				colorAttribute->setVboParameters(stride, reinterpret_cast<void*>(offsetof(InstanceFormatSprite, color)));
+				colorAttribute->setDivisor(1);
+			}
+			if (texRectAttribute != nullptr && texRectAttribute->stride() == 0) {
+				texRectAttribute->setVboParameters(stride, reinterpret_cast<void*>(offsetof(InstanceFormatSprite, texRect)));
+				texRectAttribute->setDivisor(1);
+			}
+			if (spriteSizeAttribute != nullptr && spriteSizeAttribute->stride() == 0) {
+				const size_t spriteSizeOffset = (texRectAttribute != nullptr ? offsetof(InstanceFormatSprite, spriteSize) : offsetof(InstanceFormatSpriteNoTexture, spriteSize));
+				spriteSizeAttribute->setVboParameters(stride, reinterpret_cast<void*>(spriteSizeOffset));
+				spriteSizeAttribute->setDivisor(1);
+			}
+			return;
+		}
+
 		GLVertexFormat::Attribute* positionAttribute = shaderProgram.attribute(Material::PositionAttributeName);
 		GLVertexFormat::Attribute* texCoordsAttribute = shaderProgram.attribute(Material::TexCoordsAttributeName);
 		GLVertexFormat::Attribute* meshIndexAttribute = shaderProgram.attribute(Material::MeshIndexAttributeName);
@@ -185,7 +237,7 @@ namespace nCine
 	
 		const AppConfiguration& appCfg = theApplication().appConfiguration();
 		binaryShaderCache_ = std::make_unique<BinaryShaderCache>(appCfg.shaderCachePath);
-		buffersManager_ = std::make_unique<RenderBuffersManager>(appCfg.useBufferMapping, appCfg.vboSize, appCfg.iboSize);
+		buffersManager_ = std::make_unique<RenderBuffersManager>(appCfg.useBufferMapping, appCfg.usePersistentBufferMapping, appCfg.vboSize, appCfg.iboSize);
 		vaoPool_ = std::make_unique<RenderVaoPool>(appCfg.vaoPoolSize);
 	}
 	
@@ -198,7 +250,7 @@ namespace nCine
 			binaryShaderCache_ = std::make_unique<BinaryShaderCache>(appCfg.shaderCachePath);
 		}
 		if (buffersManager_ == nullptr) {
-			buffersManager_ = std::make_unique<RenderBuffersManager>(appCfg.useBufferMapping, appCfg.vboSize, appCfg.iboSize);
+			buffersManager_ = std::make_unique<RenderBuffersManager>(appCfg.useBufferMapping, appCfg.usePersistentBufferMapping, appCfg.vboSize, appCfg.iboSize);
 		}
 		if (vaoPool_ == nullptr) {
 			vaoPool_ = std::make_unique<RenderVaoPool>(appCfg.vaoPoolSize);
@@ -226,7 +278,9 @@ namespace nCine
 			//{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_MESH_SPRITES_GRAY)], ShaderStrings::batched_meshsprites_vs + 1, ShaderStrings::sprite_gray_fs + 1, GLShaderProgram::Introspection::NoUniformsInBlocks, "Batched_MeshSprites_Gray" },
 			{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_MESH_SPRITES_NO_TEXTURE)], ShaderStrings::batched_meshsprites_notexture_vs + 1, ShaderStrings::sprite_notexture_fs + 1, GLShaderProgram::Introspection::NoUniformsInBlocks, "Batched_MeshSprites_NoTexture" },
 			//{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_TEXTNODES_ALPHA)], ShaderStrings::batched_textnodes_vs + 1, ShaderStrings::textnode_alpha_fs + 1, GLShaderProgram::Introspection::NoUniformsInBlocks, "Batched_TextNodes_Alpha" },
-			//{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_TEXTNODES_RED)], ShaderStrings::batched_textnodes_vs + 1, ShaderStrings::textnode_red_fs + 1, GLShaderProgram::Introspection::NoUniformsInBlocks, "Batched_TextNodes_Red" }
+			//{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_TEXTNODES_RED)], ShaderStrings::batched_textnodes_vs + 1, ShaderStrings::textnode_red_fs + 1, GLShaderProgram::Introspection::NoUniformsInBlocks, "Batched_TextNodes_Red" },
+			{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::INSTANCED_SPRITES)], ShaderStrings::instanced_sprites_vs + 1, ShaderStrings::sprite_fs + 1, GLShaderProgram::Introspection::Enabled, "Instanced_Sprites" },
+			{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::INSTANCED_SPRITES_NO_TEXTURE)], ShaderStrings::instanced_sprites_notexture_vs + 1, ShaderStrings::sprite_notexture_fs + 1, GLShaderProgram::Introspection::Enabled, "Instanced_Sprites_NoTexture" }
 #else
 			{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::SPRITE)], "sprite_vs.glsl", "sprite_fs.glsl", GLShaderProgram::Introspection::Enabled, "Sprite" },
 			//{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::SPRITE_GRAY)], "sprite_vs.glsl", "sprite_gray_fs.glsl", GLShaderProgram::Introspection::Enabled, "Sprite_Gray" },
@@ -243,7 +297,9 @@ namespace nCine
 			//{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_MESH_SPRITES_GRAY)], "batched_meshsprites_vs.glsl", "sprite_gray_fs.glsl", GLShaderProgram::Introspection::NoUniformsInBlocks, "Batched_MeshSprites_Gray" },
 			{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_MESH_SPRITES_NO_TEXTURE)], "batched_meshsprites_notexture_vs.glsl", "sprite_notexture_fs.glsl", GLShaderProgram::Introspection::NoUniformsInBlocks, "Batched_MeshSprites_NoTexture" },
 			//{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_TEXTNODES_ALPHA)], "batched_textnodes_vs.glsl", "textnode_alpha_fs.glsl", GLShaderProgram::Introspection::NoUniformsInBlocks, "Batched_TextNodes_Alpha" },
-			//{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_TEXTNODES_RED)], "batched_textnodes_vs.glsl", "textnode_red_fs.glsl", GLShaderProgram::Introspection::NoUniformsInBlocks, "Batched_TextNodes_Red" }
+			//{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_TEXTNODES_RED)], "batched_textnodes_vs.glsl", "textnode_red_fs.glsl", GLShaderProgram::Introspection::NoUniformsInBlocks, "Batched_TextNodes_Red" },
+			{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::INSTANCED_SPRITES)], "instanced_sprites_vs.glsl", "sprite_fs.glsl", GLShaderProgram::Introspection::Enabled, "Instanced_Sprites" },
+			{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::INSTANCED_SPRITES_NO_TEXTURE)], "instanced_sprites_notexture_vs.glsl", "sprite_notexture_fs.glsl", GLShaderProgram::Introspection::Enabled, "Instanced_Sprites_NoTexture" }
 #endif
 		};
 
@@ -392,5 +448,8 @@ namespace nCine
 		batchedShaders_.emplace(defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::MESH_SPRITE_NO_TEXTURE)].get(), defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_MESH_SPRITES_NO_TEXTURE)].get());
 		//batchedShaders_.emplace(defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::TEXTNODE_ALPHA)].get(), defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_TEXTNODES_ALPHA)].get());
 		//batchedShaders_.emplace(defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::TEXTNODE_RED)].get(), defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_TEXTNODES_RED)].get());
+
+		instancedShaders_.emplace(defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::SPRITE)].get(), defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::INSTANCED_SPRITES)].get());
+		instancedShaders_.emplace(defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::SPRITE_NO_TEXTURE)].get(), defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::INSTANCED_SPRITES_NO_TEXTURE)].get());
 	}
 }
@@ -53,6 +53,23 @@ namespace nCine
 			int drawindex;
 		};
 
+		/// A per-instance attribute format structure for sprites, it matches the packed `std140` layout of their `InstanceBlock`
+		struct InstanceFormatSprite
+		{
+			GLfloat modelMatrix[16];
+			GLfloat color[4];
+			GLfloat texRect[4];
+			GLfloat spriteSize[2];
+		};
+
+		/// A per-instance attribute format structure for sprites with no texture, it matches the packed `std140` layout of their `InstanceBlock`
+		struct InstanceFormatSpriteNoTexture
+		{
+			GLfloat modelMatrix[16];
+			GLfloat color[4];
+			GLfloat spriteSize[2];
+		};
+
 		struct CameraUniformData
 		{
 			CameraUniformData()
@@ -86,6 +103,10 @@ namespace nCine
 		static bool registerBatchedShader(const GLShaderProgram* shader, GLShaderProgram* batchedShader);
 		static bool unregisterBatchedShader(const GLShaderProgram* shader);
 
+		static GLShaderProgram* instancedShader(const GLShaderProgram* shader);
+		static bool registerInstancedShader(const GLShaderProgram* shader, GLShaderProgram* instancedShader);
+		static bool unregisterInstancedShader(const GLShaderProgram* shader);
+
 		static inline unsigned char* cameraUniformsBuffer() {
 			return cameraUniformsBuffer_;
 		}
@@ -116,6 +137,7 @@ namespace nCine
 		static constexpr unsigned int DefaultShaderProgramsCount = static_cast<unsigned int>(Material::ShaderProgramType::CUSTOM);
 		static std::unique_ptr<GLShaderProgram> defaultShaderPrograms_[DefaultShaderProgramsCount];
 		static HashMap<const GLShaderProgram*, GLShaderProgram*> batchedShaders_;
+		static HashMap<const GLShaderProgram*, GLShaderProgram*> instancedShaders_;
 
 		static constexpr unsigned int UniformsBufferSize = 128; // two 4x4 float matrices
 		static unsigned char cameraUniformsBuffer_[UniformsBufferSize];
@@ -8,11 +8,13 @@ namespace nCine
 	RenderStatistics::Commands RenderStatistics::allCommands_;
 	RenderStatistics::Commands RenderStatistics::typedCommands_[(int)RenderCommand::CommandTypes::Count];
 	RenderStatistics::Buffers RenderStatistics::typedBuffers_[(int)RenderBuffersManager::BufferTypes::Count];
+	RenderStatistics::BufferUploads RenderStatistics::bufferUploads_[2];
 	RenderStatistics::Textures RenderStatistics::textures_;
 	RenderStatistics::CustomBuffers RenderStatistics::customVbos_;
 	RenderStatistics::CustomBuffers RenderStatistics::customIbos_;
 	unsigned int RenderStatistics::index_ = 0;
 	unsigned int RenderStatistics::culledNodes_[2] = { 0, 0 };
+	unsigned int RenderStatistics::culledTiles_[2] = { 0, 0 };
 	RenderStatistics::VaoPool RenderStatistics::vaoPool_;
 	RenderStatistics::CommandPool RenderStatistics::commandPool_;
 
@@ -20,6 +22,9 @@ namespace nCine
 	{
 		TracyPlot("Vertices", static_cast<int64_t>(allCommands_.vertices));
 		TracyPlot("Render Commands", static_cast<int64_t>(allCommands_.commands));
+		TracyPlot("Culled Tiles", static_cast<int64_t>(culledTiles_[index_]));
+		TracyPlot("Buffer Uploads", static_cast<int64_t>(bufferUploads_[index_].bytes));
+		TracyPlot("Buffer Sync Wait", bufferUploads_[index_].syncWaitTime);
 
 		for (unsigned int i = 0; i < (unsigned int)RenderCommand::CommandTypes::Count; i++) {
 			typedCommands_[i].reset();
@@ -33,6 +38,8 @@ namespace nCine
 		// Ping pong index for last and current frame
 		index_ = (index_ + 1) % 2;
 		culledNodes_[index_] = 0;
+		culledTiles_[index_] = 0;
+		bufferUploads_[index_].reset();
 
 		vaoPool_.reset();
 		commandPool_.reset();
@@ -74,6 +81,8 @@ namespace nCine
 		typedBuffers_[typeIndex].count++;
 		typedBuffers_[typeIndex].size += buffer.size;
 		typedBuffers_[typeIndex].usedSpace += buffer.size - buffer.freeSpace;
+		// Everything written to a managed buffer in a frame is uploaded or flushed at once
+		bufferUploads_[index_].bytes += buffer.size - buffer.freeSpace;
 	}
 }
 
@@ -54,6 +54,29 @@ namespace nCine
 			friend RenderStatistics;
 		};
 
+		class BufferUploads
+		{
+		public:
+			/// Number of bytes uploaded to managed buffers
+			unsigned long bytes;
+			/// Number of times the CPU had to wait for the GPU before writing to a persistently mapped region
+			unsigned int syncWaits;
+			/// Time spent waiting for the GPU, in milliseconds
+			float syncWaitTime;
+
+			BufferUploads()
+				: bytes(0), syncWaits(0), syncWaitTime(0.0f) {}
+
+		private:
+			void reset()
+			{
+				bytes = 0;
+				syncWaits = 0;
+				syncWaitTime = 0.0f;
+			}
+			friend RenderStatistics;
+		};
+
 		class Textures
 		{
 		public:
@@ -146,6 +169,11 @@ namespace nCine
 			return typedBuffers_[(int)type];
 		}
 
+		/// Returns upload and synchronization statistics of managed buffers for the last frame
+		static inline const BufferUploads& bufferUploads() {
+			return bufferUploads_[(index_ + 1) % 2];
+		}
+
 		/// Returns aggregated texture statistics
 		static inline const Textures& textures() {
 			return textures_;
@@ -166,6 +194,16 @@ namespace nCine
 			return culledNodes_[(index_ + 1) % 2];
 		}
 
+		/// Returns the number of tiles culled because hidden behind opaque tiles of another layer
+		static inline unsigned int culledTiles() {
+			return culledTiles_[(index_ + 1) % 2];
+		}
+
+		/// Increases the number of tiles culled in the current frame
+		static inline void addCulledTile() {
+			culledTiles_[index_]++;
+		}
+
 		/// Returns statistics about the VAO pool
 		static inline const VaoPool& vaoPool() {
 			return vaoPool_;
@@ -180,11 +218,13 @@ namespace nCine
 		static Commands allCommands_;
 		static Commands typedCommands_[(int)RenderCommand::CommandTypes::Count];
 		static Buffers typedBuffers_[(int)RenderBuffersManager::BufferTypes::Count];
+		static BufferUploads bufferUploads_[2];
 		static Textures textures_;
 		static CustomBuffers customVbos_;
 		static CustomBuffers customIbos_;
 		static unsigned int index_;
 		static unsigned int culledNodes_[2];
+		static unsigned int culledTiles_[2];
 		static VaoPool vaoPool_;
 		static CommandPool commandPool_;
 
@@ -231,6 +271,11 @@ namespace nCine
 			customIbos_.count--;
 			customIbos_.dataSize -= datasize;
 		}
+		static inline void addBufferSyncWait(float milliseconds)
+		{
+			bufferUploads_[index_].syncWaits++;
+			bufferUploads_[index_].syncWaitTime += milliseconds;
+		}
 		static inline void addCulledNode() {
 			culledNodes_[index_]++;
 		}
@@ -34,6 +34,8 @@ namespace nCine
 			BATCHED_MESHSPRITES,
 			BATCHED_MESHSPRITES_NOTEXTURE,
 			//BATCHED_TEXTNODES
+			INSTANCED_SPRITES,
+			INSTANCED_SPRITES_NOTEXTURE
 		};
 
 		enum class DefaultFragment {
@@ -107,6 +109,8 @@ namespace nCine
 
 		/// Registers a shaders to be used for batches of render commands
 		void registerBatchedShader(Shader& batchedShader);
+		/// Registers a shaders to be used for batches of render commands with per-instance attributes
+		void registerInstancedShader(Shader& instancedShader);
 
 		GLShaderProgram* getHandle() {
 			return glShaderProgram_.get();
@@ -502,7 +502,7 @@ namespace nCine
 	}
 
 	I18n::I18n()
-		: _fileSize(0), _stringCount(0), _origTable(nullptr), _transTable(nullptr), _hashSize(0), _hashTable(nullptr), _pluralExp(nullptr), _pluralCount(0)
+		: _fileSize(0), _catalogMask(0), _pluralExp(nullptr), _pluralCount(0)
 	{
 	}
 
@@ -518,11 +518,9 @@ namespace nCine
 	{
 		_file = nullptr;
 		_fileSize = 0;
-		_stringCount = 0;
-		_origTable = nullptr;
-		_transTable = nullptr;
-		_hashSize = 0;
-		_hashTable = nullptr;
+		_catalog = nullptr;
+		_catalogMask = 0;
+		_forms = nullptr;
 
 		if (_pluralExp != nullptr) {
 			delete _pluralExp;
@@ -550,122 +548,174 @@ namespace nCine
 		constexpr uint32_t SignatureLE = 0x950412de;
 		constexpr uint32_t SignatureBE = 0xde120495;
 		MoFileHeader* data = (MoFileHeader*)_file.get();
+		// All entries are read when the catalog is compiled, so both tables must fit in the file
+		const uint64_t tableSize = (uint64_t)data->StringCount * sizeof(StringDesc);
 		if (!(data->Signature == SignatureLE || data->Signature == SignatureBE) || data->StringCount <= 0 ||
-			data->OrigTableOffset + data->StringCount > fileSize || data->TransTableOffset + data->StringCount > fileSize ||
-			data->HashTableOffset + data->HashTableSize > fileSize) {
+			data->OrigTableOffset + tableSize > fileSize || data->TransTableOffset + tableSize > fileSize) {
 			LOGE("Invalid \".mo\" file");
 			Unload();
 			return false;
 		}
 
-		_stringCount = data->StringCount;
-		_origTable = (const StringDesc*)((char*)data + data->OrigTableOffset);
-		_transTable = (const StringDesc*)((char*)data + data->TransTableOffset);
-		_hashSize = data->HashTableSize;
-		_hashTable = (_hashSize > 2 ? (const uint32_t*)((char*)data + data->HashTableOffset) : nullptr);
+		const StringDesc* origTable = (const StringDesc*)((char*)data + data->OrigTableOffset);
+		const StringDesc* transTable = (const StringDesc*)((char*)data + data->TransTableOffset);
+		if (!CompileCatalog(origTable, transTable, data->StringCount)) {
+			LOGE("Invalid \".mo\" file");
+			Unload();
+			return false;
+		}
 
-		uint32_t entryLength;
-		const char* nullEntry = LookupTranslation("", &entryLength);
-		ExtractPluralExpression(nullEntry, &_pluralExp, &_pluralCount);
+		StringView nullEntry = LookupTranslation("");
+		ExtractPluralExpression(nullEntry.data(), &_pluralExp, &_pluralCount);
+		CompilePluralExpression();
 
 		return true;
 	}
 
-	const char* I18n::LookupTranslation(const char* msgid, uint32_t* resultLength)
-	{
-		if (_hashTable != nullptr) {
-			// Use the hashing table
-			constexpr uint32_t HashWordBits = 32;
-
-			const char* str = msgid;
-			uint32_t hashValue = 0;
-			uint32_t len = 0;
-			while (*str != '\0') {
-				hashValue <<= 4;
-				hashValue += (uint8_t)*str++;
-				uint32_t g = hashValue & ((uint32_t) 0xf << (HashWordBits - 4));
-				if (g != 0) {
-					hashValue ^= g >> (HashWordBits - 8);
-					hashValue ^= g;
-				}
-				len++;
-			}
+	bool I18n::CompileCatalog(const StringDesc* origTable, const StringDesc* transTable, uint32_t stringCount)
+	{
+		// The hash table of the file uses different hash function, so a new one with at most 50% load is created
+		uint32_t catalogSize = 16;
+		while (catalogSize < stringCount * 2) {
+			catalogSize <<= 1;
+		}
 
-			uint32_t idx = hashValue % _hashSize;
-			uint32_t incr = 1 + (hashValue % (_hashSize - 2));
+		_catalog = std::make_unique<CatalogEntry[]>(catalogSize);
+		_catalogMask = catalogSize - 1;
+		for (uint32_t i = 0; i < catalogSize; i++) {
+			_catalog[i].IdOffset = 0;
+		}
 
-			while (true) {
-				uint32_t nstr = _hashTable[idx];
-				if (nstr == 0) {
-					// Hash table entry is empty
-					return nullptr;
+		// Translated forms of all messages are split only once, so plural lookups don't have to search for separators
+		uint32_t formCount = 0;
+		for (uint32_t i = 0; i < stringCount; i++) {
+			const StringDesc& trans = transTable[i];
+			if (trans.Offset >= _fileSize || trans.Length >= _fileSize - trans.Offset) {
+				return false;
+			}
+			formCount++;
+			for (uint32_t j = 0; j < trans.Length; j++) {
+				if (_file[trans.Offset + j] == '\0') {
+					formCount++;
 				}
-				nstr--;
+			}
+		}
+		_forms = std::make_unique<StringDesc[]>(formCount);
 
-				// Compare `msgid` with the original string at index `nstr`. We compare the lengths with `>=`, not `==`,
-				// because plural entries are represented by strings with an embedded NULL.
-				if (nstr < _stringCount && _origTable[nstr].Length >= len && (std::strcmp(msgid, _file.get() + _origTable[nstr].Offset) == 0)) {
-					if (_transTable[nstr].Offset >= _fileSize) {
-						return nullptr;
-					}
-					*resultLength = _transTable[nstr].Length;
-					return (char*)(_file.get() + _transTable[nstr].Offset);
-				}
+		uint32_t formIndex = 0;
+		for (uint32_t i = 0; i < stringCount; i++) {
+			const StringDesc& orig = origTable[i];
+			const StringDesc& trans = transTable[i];
+			// Offset 0 contains the file header, so it's used to mark empty slots
+			if (orig.Offset == 0 || orig.Offset >= _fileSize || orig.Length >= _fileSize - orig.Offset) {
+				return false;
+			}
 
-				if (idx >= _hashSize - incr) {
-					idx -= _hashSize - incr;
-				} else {
-					idx += incr;
-				}
+			// Plural entries are represented by strings with an embedded NULL, only the singular form is the identifier
+			const char* id = _file.get() + orig.Offset;
+			const uint32_t idLength = (uint32_t)strnlen(id, orig.Length);
+			const hash_t hash = Atom::computeHash(id, idLength);
+
+			uint32_t slot = hash & _catalogMask;
+			while (_catalog[slot].IdOffset != 0) {
+				slot = (slot + 1) & _catalogMask;
 			}
-		} else {
-			// Binary search in the sorted array of messages
-			size_t bottom = 0;
-			size_t top = _stringCount;
-			while (bottom < top) {
-				size_t idx = (bottom + top) / 2;
-				if (_origTable[idx].Offset >= _fileSize) {
-					return nullptr;
-				}
-				int cmpVal = std::strcmp(msgid, (_file.get() + _origTable[idx].Offset));
-				if (cmpVal < 0) {
-					top = idx;
-				} else if (cmpVal > 0) {
-					bottom = idx + 1;
-				} else {
-					if (_transTable[idx].Offset >= _fileSize) {
-						return nullptr;
-					}
-					*resultLength = _transTable[idx].Length;
-					return (char*)(_file.get() + _transTable[idx].Offset);
+
+			CatalogEntry& entry = _catalog[slot];
+			entry.Hash = hash;
+			entry.IdOffset = orig.Offset;
+			entry.IdLength = idLength;
+			entry.FirstForm = formIndex;
+
+			uint32_t formStart = trans.Offset;
+			const uint32_t transEnd = trans.Offset + trans.Length;
+			for (uint32_t j = trans.Offset; j < transEnd; j++) {
+				if (_file[j] == '\0') {
+					_forms[formIndex].Offset = formStart;
+					_forms[formIndex].Length = j - formStart;
+					formIndex++;
+					formStart = j + 1;
 				}
 			}
+			_forms[formIndex].Offset = formStart;
+			_forms[formIndex].Length = transEnd - formStart;
+			formIndex++;
+			entry.FormCount = formIndex - entry.FirstForm;
 		}
 
-		return nullptr;
+		return true;
 	}
 
-	const char* I18n::LookupPlural(int n, const char* translation, uint32_t translationLength)
+	const I18n::CatalogEntry* I18n::FindEntry(const MessageId& msgid) const
 	{
-		int index = (*_pluralExp)(n);
+		if (_catalog == nullptr) {
+			return nullptr;
+		}
 
-		const char* p = translation;
-		while (index-- > 0) {
-			p = strchr(p, '\0');
-			p++;
-			if (p >= translation + translationLength) {
-				return translation;
+		uint32_t slot = msgid.Hash & _catalogMask;
+		while (true) {
+			const CatalogEntry& entry = _catalog[slot];
+			if (entry.IdOffset == 0) {
+				return nullptr;
+			}
+			// Strings are compared only if hashes match to rule out collisions
+			if (entry.Hash == msgid.Hash && entry.IdLength == msgid.Length &&
+				std::memcmp(_file.get() + entry.IdOffset, msgid.Text, msgid.Length) == 0) {
+				return &entry;
 			}
+			slot = (slot + 1) & _catalogMask;
 		}
-		return p;
+	}
+
+	StringView I18n::LookupTranslation(const MessageId& msgid)
+	{
+		const CatalogEntry* entry = FindEntry(msgid);
+		if (entry == nullptr) {
+			return nullptr;
+		}
+
+		const StringDesc& form = _forms[entry->FirstForm];
+		return StringView(_file.get() + form.Offset, form.Length, StringViewFlags::NullTerminated);
+	}
+
+	StringView I18n::LookupPlural(const MessageId& singular, int n)
+	{
+		const CatalogEntry* entry = FindEntry(singular);
+		if (entry == nullptr) {
+			return nullptr;
+		}
+
+		uint32_t index = GetPluralForm(n);
+		if (index >= entry->FormCount) {
+			index = 0;
+		}
+
+		const StringDesc& form = _forms[entry->FirstForm + index];
+		return StringView(_file.get() + form.Offset, form.Length, StringViewFlags::NullTerminated);
+	}
+
+	void I18n::CompilePluralExpression()
+	{
+		// Small counts are the most common, so the expression is evaluated only once for them
+		for (uint32_t i = 0; i < PluralLookupSize; i++) {
+			const int index = (*_pluralExp)((int)i);
+			_pluralLookup[i] = (uint8_t)(index < 0 ? 0 : (index > UINT8_MAX ? UINT8_MAX : index));
+		}
+	}
+
+	uint32_t I18n::GetPluralForm(int n) const
+	{
+		if ((uint32_t)n < PluralLookupSize) {
+			return _pluralLookup[n];
+		}
+		const int index = (*_pluralExp)(n);
+		return (index < 0 ? 0 : (uint32_t)index);
 	}
 
 	StringView I18n::GetTranslationDescription()
 	{
-		uint32_t entryLength;
-		const char* nullEntry = LookupTranslation("", &entryLength);
-		if (nullEntry != nullptr) {
-			StringView translationInfo = StringView(nullEntry, entryLength);
+		StringView translationInfo = LookupTranslation("");
+		if (translationInfo != nullptr) {
 			StringView languageTeamBegin = translationInfo.find("Language-Team:"_s);
 			if (languageTeamBegin != nullptr) {
 				languageTeamBegin = translationInfo.suffix(languageTeamBegin.end());
@@ -819,46 +869,10 @@ namespace nCine
 		*pluralCount = 2;
 	}
 
-	String _f(const char* text, ...)
+	String FormatTranslation(const char* format, ...)
 	{
-		uint32_t resultLength;
-		const char* translated = I18n::Get().LookupTranslation(text, &resultLength);
-		const char* format = (translated != nullptr ? translated : text);
-
-		va_list args;
-		va_start(args, text);
-#if defined(DEATH_TARGET_WINDOWS) && !defined(DEATH_TARGET_MINGW)
-		const int totalChars = _vscprintf(format, args);
-		String result(NoInit, totalChars);
-		vsnprintf_s(result.data(), totalChars + 1, totalChars, format, args);
-		va_end(args);
-		return result;
-#else
-		// TODO: Quickfix strange bug on Linux
-		//const int totalChars = ::vsnprintf(nullptr, 0, format, args);
-		//String result(NoInit, totalChars);
-		//::vsnprintf(result.data(), totalChars + 1, format, args);
-
-		char buffer[2048];
-		::vsnprintf(buffer, sizeof(buffer), format, args);
-		va_end(args);
-		return buffer;
-#endif
-	}
-
-	String _fn(const char* singular, const char* plural, int n, ...)
-	{
-		uint32_t resultLength;
-		const char* translated = I18n::Get().LookupTranslation(singular, &resultLength);
-		const char* format;
-		if (translated != nullptr) {
-			format = I18n::Get().LookupPlural(n, translated, resultLength);
-		} else {
-			format = (n == 1 ? singular : plural);
-		}
-
 		va_list args;
-		va_start(args, n);
+		va_start(args, format);
 #if defined(DEATH_TARGET_WINDOWS) && !defined(DEATH_TARGET_MINGW)
 		const int totalChars = _vscprintf(format, args);
 		String result(NoInit, totalChars);
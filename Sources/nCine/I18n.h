@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Base/Atom.h"
 #include "Base/HashMap.h"
 #include "IO/IFileStream.h"
 
@@ -15,10 +16,32 @@ using namespace Death::Containers::Literals;
 
 namespace nCine
 {
+	/// Identifier of a translatable message
+	/*! The hash of string literals is computed at compile-time, so a lookup only probes the compiled catalog. */
+	struct MessageId
+	{
+		template<std::size_t N>
+		consteval MessageId(const char (&text)[N]) noexcept
+			: Text(text), Length(N - 1), Hash(Atom::computeHash(text, N - 1)) {}
+
+		/// Creates the identifier of a string that is not known at compile-time
+		explicit MessageId(const char* text) noexcept
+			: MessageId(StringView(text)) {}
+		/// Creates the identifier of a string that is not known at compile-time
+		explicit MessageId(const StringView& text) noexcept
+			: Text(text.data()), Length(std::uint32_t(text.size())), Hash(Atom::computeHash(text.data(), text.size())) {}
+
+		const char* Text;
+		std::uint32_t Length;
+		hash_t Hash;
+	};
+
 	class I18n
 	{
 	public:
 		static constexpr char ContextSeparator = 0x04;
+		/// Plural forms of counts from `0` to `PluralLookupSize - 1` are evaluated when the catalog is loaded
+		static constexpr std::uint32_t PluralLookupSize = 256;
 
 		struct ExpressionToken
 		{
@@ -54,8 +77,10 @@ namespace nCine
 		bool LoadFromFile(const StringView& path);
 		bool LoadFromFile(const std::unique_ptr<IFileStream>& fileHandle);
 
-		const char* LookupTranslation(const char* msgid, uint32_t* resultLength);
-		const char* LookupPlural(int n, const char* translation, uint32_t translationLength);
+		/// Returns translated message, or `nullptr` view if the message is not translated
+		StringView LookupTranslation(const MessageId& msgid);
+		/// Returns translated plural form for the specified count, or `nullptr` view if the message is not translated
+		StringView LookupPlural(const MessageId& singular, int n);
 
 		StringView GetTranslationDescription();
 
@@ -96,53 +121,82 @@ namespace nCine
 			uint32_t Offset;
 		};
 
+		/// Slot of the compiled catalog, messages are addressed by hash of their original string
+		struct CatalogEntry
+		{
+			hash_t Hash;
+			// Offset of original string in file, zero if the slot is empty
+			uint32_t IdOffset;
+			// Length of original string, without plural form
+			uint32_t IdLength;
+			// Index of the first translated form in `_forms`
+			uint32_t FirstForm;
+			uint32_t FormCount;
+		};
+
 		std::unique_ptr<char[]> _file;
 		uint32_t _fileSize;
-		uint32_t _stringCount;
-		const StringDesc* _origTable;
-		const StringDesc* _transTable;
-		uint32_t _hashSize;
-		const uint32_t* _hashTable;
+		std::unique_ptr<CatalogEntry[]> _catalog;
+		uint32_t _catalogMask;
+		std::unique_ptr<StringDesc[]> _forms;
 		const ExpressionToken* _pluralExp;
 		uint32_t _pluralCount;
+		uint8_t _pluralLookup[PluralLookupSize];
+
+		bool CompileCatalog(const StringDesc* origTable, const StringDesc* transTable, uint32_t stringCount);
+		const CatalogEntry* FindEntry(const MessageId& msgid) const;
+		void CompilePluralExpression();
+		uint32_t GetPluralForm(int n) const;
 
 		static void ExtractPluralExpression(const char* nullEntry, const ExpressionToken** pluralExp, uint32_t* pluralCount);
 	};
 
-	inline StringView _(const char* text)
+	inline StringView _(const MessageId& text)
 	{
-		uint32_t resultLength;
-		const char* result = I18n::Get().LookupTranslation(text, &resultLength);
-		return StringView(result != nullptr ? result : text);
+		StringView result = I18n::Get().LookupTranslation(text);
+		return (result.data() != nullptr ? result : StringView(text.Text, text.Length, StringViewFlags::NullTerminated));
 	}
 	
 	inline StringView _x(const StringView& context, const char* text)
 	{
-		uint32_t resultLength;
-		const char* result = I18n::Get().LookupTranslation(String(&I18n::ContextSeparator, 1).join({ context, StringView(text) }).data(), &resultLength);
-		return (result != nullptr ? result : text);
+		String key = String(&I18n::ContextSeparator, 1).join({ context, StringView(text) });
+		StringView result = I18n::Get().LookupTranslation(MessageId(StringView(key)));
+		return (result.data() != nullptr ? result : text);
 	}
 
-	inline StringView _n(const char* singular, const char* plural, int n)
+	inline StringView _n(const MessageId& singular, const char* plural, int n)
 	{
-		uint32_t resultLength;
-		const char* result = I18n::Get().LookupTranslation(singular, &resultLength);
-		if (result != nullptr) {
-			return I18n::Get().LookupPlural(n, result, resultLength);
+		StringView result = I18n::Get().LookupPlural(singular, n);
+		if (result.data() != nullptr) {
+			return result;
 		}
-		return (n == 1 ? singular : plural);
+		return (n == 1 ? StringView(singular.Text, singular.Length, StringViewFlags::NullTerminated) : plural);
 	}
 
 	inline StringView _nx(const StringView& context, const char* singular, const char* plural, int n)
 	{
-		uint32_t resultLength;
-		const char* result = I18n::Get().LookupTranslation(String(&I18n::ContextSeparator, 1).join({ context, StringView(singular) }).data(), &resultLength);
-		if (result != nullptr) {
-			return I18n::Get().LookupPlural(n, result, resultLength);
+		String key = String(&I18n::ContextSeparator, 1).join({ context, StringView(singular) });
+		StringView result = I18n::Get().LookupPlural(MessageId(StringView(key)), n);
+		if (result.data() != nullptr) {
+			return result;
 		}
 		return (n == 1 ? singular : plural);
 	}
 
-	String _f(const char* text, ...);
-	String _fn(const char* singular, const char* plural, int n, ...);
+	/// Formats translated string, arguments are passed to `vsnprintf()`
+	String FormatTranslation(const char* format, ...);
+
+	template<typename... Args>
+	inline String _f(const MessageId& text, Args... args)
+	{
+		StringView translated = I18n::Get().LookupTranslation(text);
+		return FormatTranslation(translated.data() != nullptr ? translated.data() : text.Text, args...);
+	}
+
+	template<typename... Args>
+	inline String _fn(const MessageId& singular, const char* plural, int n, Args... args)
+	{
+		StringView translated = I18n::Get().LookupPlural(singular, n);
+		return FormatTranslation(translated.data() != nullptr ? translated.data() : (n == 1 ? singular.Text : plural), args...);
+	}
 }
@@ -1,6 +1,7 @@
 #include "CompressionUtils.h"
 
 #include <algorithm>
+#include <cstring>
 
 namespace nCine
 {
@@ -85,6 +86,386 @@ namespace nCine
 		return uncompressedSize + 5 * max_blocks + 1 + 8;
 	}
 
+	InflateStream::InflateStream()
+#if defined(WITH_ZLIB)
+		: _strm { }, _state(0)
+#else
+		: _input(nullptr), _inputSize(0), _inputOffset(0), _bitBuffer(0), _bitCount(0), _windowOffset(0), _windowFilled(0),
+			_state(State::Closed), _lastBlock(false), _storedLeft(0), _matchLength(0), _matchDistance(0)
+#endif
+	{
+	}
+
+	InflateStream::~InflateStream()
+	{
+		Close();
+	}
+
+	bool InflateStream::Open(const uint8_t* compressedBuffer, int32_t compressedSize)
+	{
+		Close();
+
+#if defined(WITH_ZLIB)
+		_strm.zalloc = Z_NULL;
+		_strm.zfree = Z_NULL;
+		_strm.opaque = Z_NULL;
+		_strm.avail_in = compressedSize;
+		_strm.next_in = (unsigned char*)compressedBuffer;
+		if (inflateInit2(&_strm, -15) != Z_OK) {
+			return false;
+		}
+		_state = 1;
+#else
+		if (compressedBuffer == nullptr || compressedSize < 0) {
+			return false;
+		}
+		if (_window == nullptr) {
+			_window = std::make_unique<uint8_t[]>(WindowSize);
+		}
+		_input = compressedBuffer;
+		_inputSize = compressedSize;
+		_state = State::BlockHeader;
+#endif
+		return true;
+	}
+
+	void InflateStream::Close()
+	{
+#if defined(WITH_ZLIB)
+		if (_state != 0) {
+			inflateEnd(&_strm);
+			_state = 0;
+		}
+#else
+		// The window is kept, so it can be reused by the next stream
+		_input = nullptr;
+		_inputSize = 0;
+		_inputOffset = 0;
+		_bitBuffer = 0;
+		_bitCount = 0;
+		_windowOffset = 0;
+		_windowFilled = 0;
+		_state = State::Closed;
+		_lastBlock = false;
+		_storedLeft = 0;
+		_matchLength = 0;
+		_matchDistance = 0;
+#endif
+	}
+
+	int32_t InflateStream::Read(uint8_t* destBuffer, int32_t bytes)
+	{
+#if defined(WITH_ZLIB)
+		// State 2 means the end of stream was already reached
+		if (_state != 1) {
+			return 0;
+		}
+
+		_strm.avail_out = bytes;
+		_strm.next_out = (unsigned char*)destBuffer;
+		int result = inflate(&_strm, Z_NO_FLUSH);
+		if (result != Z_OK) {
+			_state = 2;
+		}
+		return bytes - (int32_t)_strm.avail_out;
+#else
+		// libdeflate can't decompress incrementally, so the stream is decoded here, it stops when the output is full
+		// and continues on the next call, any error in the stream is handled like the end of the stream
+		int32_t bytesWritten = 0;
+		while (bytesWritten < bytes) {
+			switch (_state) {
+				case State::BlockHeader: {
+					if (!ReadBlockHeader()) {
+						_state = State::Finished;
+					}
+					break;
+				}
+				case State::StoredBlock: {
+					if (_storedLeft <= 0) {
+						_state = (_lastBlock ? State::Finished : State::BlockHeader);
+						break;
+					}
+					int32_t length = std::min(std::min(_storedLeft, bytes - bytesWritten), _inputSize - _inputOffset);
+					if (length <= 0) {
+						_state = State::Finished;
+						break;
+					}
+					for (int32_t i = 0; i < length; i++) {
+						PutByte(_input[_inputOffset + i], destBuffer, bytesWritten);
+					}
+					_inputOffset += length;
+					_storedLeft -= length;
+					break;
+				}
+				case State::HuffmanBlock: {
+					if (_matchLength > 0) {
+						while (_matchLength > 0 && bytesWritten < bytes) {
+							PutByte(_window[(_windowOffset - _matchDistance) & (WindowSize - 1)], destBuffer, bytesWritten);
+							_matchLength--;
+						}
+						break;
+					}
+
+					int32_t symbol = DecodeSymbol(_literalCode);
+					if (symbol < 256) {
+						if (symbol < 0) {
+							_state = State::Finished;
+							break;
+						}
+						PutByte((uint8_t)symbol, destBuffer, bytesWritten);
+						break;
+					}
+					if (symbol == 256) {
+						_state = (_lastBlock ? State::Finished : State::BlockHeader);
+						break;
+					}
+
+					static const int16_t LengthBase[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+					static const uint8_t LengthExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+					static const int16_t DistanceBase[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+					static const uint8_t DistanceExtra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+					symbol -= 257;
+					if (symbol >= 29) {
+						_state = State::Finished;
+						break;
+					}
+					int32_t lengthExtra = ReadBits(LengthExtra[symbol]);
+					int32_t distanceSymbol = (lengthExtra >= 0 ? DecodeSymbol(_distanceCode) : -1);
+					if (distanceSymbol < 0 || distanceSymbol >= 30) {
+						_state = State::Finished;
+						break;
+					}
+					int32_t distanceExtra = ReadBits(DistanceExtra[distanceSymbol]);
+					int32_t distance = DistanceBase[distanceSymbol] + distanceExtra;
+					if (distanceExtra < 0 || distance > _windowFilled) {
+						_state = State::Finished;
+						break;
+					}
+					_matchLength = LengthBase[symbol] + lengthExtra;
+					_matchDistance = distance;
+					break;
+				}
+				default: {
+					// Stream is closed or the end of stream was already reached
+					return bytesWritten;
+				}
+			}
+		}
+		return bytesWritten;
+#endif
+	}
+
+#if !defined(WITH_ZLIB)
+	int32_t InflateStream::ReadBits(int32_t count)
+	{
+		// Returns -1 if the end of input was reached
+		while (_bitCount < count) {
+			if (_inputOffset >= _inputSize) {
+				return -1;
+			}
+			_bitBuffer |= (uint32_t)_input[_inputOffset++] << _bitCount;
+			_bitCount += 8;
+		}
+
+		int32_t value = (int32_t)(_bitBuffer & ((1u << count) - 1));
+		_bitBuffer >>= count;
+		_bitCount -= count;
+		return value;
+	}
+
+	int32_t InflateStream::DecodeSymbol(const HuffmanCode& code)
+	{
+		// Codes are stored bit-reversed, so they are read one bit at a time, returns -1 on an invalid code
+		int32_t value = 0;
+		int32_t first = 0;
+		int32_t index = 0;
+		for (int32_t length = 1; length < 16; length++) {
+			int32_t bit = ReadBits(1);
+			if (bit < 0) {
+				return -1;
+			}
+			value |= bit;
+			int32_t count = code.Counts[length];
+			if (value - count < first) {
+				return code.Symbols[index + (value - first)];
+			}
+			index += count;
+			first += count;
+			first <<= 1;
+			value <<= 1;
+		}
+		return -1;
+	}
+
+	bool InflateStream::ReadBlockHeader()
+	{
+		if (_lastBlock) {
+			return false;
+		}
+
+		int32_t lastBlock = ReadBits(1);
+		int32_t type = ReadBits(2);
+		if (lastBlock < 0 || type < 0) {
+			return false;
+		}
+		_lastBlock = (lastBlock != 0);
+
+		switch (type) {
+			case 0: {
+				// Stored block starts at the byte boundary, remaining bits are always less than one byte
+				_bitBuffer = 0;
+				_bitCount = 0;
+				if (_inputSize - _inputOffset < 4) {
+					return false;
+				}
+				int32_t length = _input[_inputOffset] | (_input[_inputOffset + 1] << 8);
+				int32_t lengthComplement = _input[_inputOffset + 2] | (_input[_inputOffset + 3] << 8);
+				if (length != (~lengthComplement & 0xFFFF)) {
+					return false;
+				}
+				_inputOffset += 4;
+				_storedLeft = length;
+				_state = State::StoredBlock;
+				return true;
+			}
+			case 1: {
+				uint8_t lengths[288 + 30];
+				std::memset(lengths, 8, 144);
+				std::memset(lengths + 144, 9, 256 - 144);
+				std::memset(lengths + 256, 7, 280 - 256);
+				std::memset(lengths + 280, 8, 288 - 280);
+				std::memset(lengths + 288, 5, 30);
+				BuildHuffmanCode(_literalCode, lengths, 288);
+				BuildHuffmanCode(_distanceCode, lengths + 288, 30);
+				_state = State::HuffmanBlock;
+				return true;
+			}
+			case 2: {
+				if (!ReadDynamicCodes()) {
+					return false;
+				}
+				_state = State::HuffmanBlock;
+				return true;
+			}
+			default: {
+				return false;
+			}
+		}
+	}
+
+	bool InflateStream::ReadDynamicCodes()
+	{
+		static const uint8_t CodeLengthOrder[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+		int32_t literalCount = ReadBits(5);
+		int32_t distanceCount = ReadBits(5);
+		int32_t codeLengthCount = ReadBits(4);
+		if (literalCount < 0 || distanceCount < 0 || codeLengthCount < 0) {
+			return false;
+		}
+		literalCount += 257;
+		distanceCount += 1;
+		codeLengthCount += 4;
+		if (literalCount > 286 || distanceCount > 30) {
+			return false;
+		}
+
+		uint8_t lengths[288 + 30] = { };
+		for (int32_t i = 0; i < codeLengthCount; i++) {
+			int32_t length = ReadBits(3);
+			if (length < 0) {
+				return false;
+			}
+			lengths[CodeLengthOrder[i]] = (uint8_t)length;
+		}
+		// Literal code is used temporarily for code lengths, it's replaced below
+		if (!BuildHuffmanCode(_literalCode, lengths, 19)) {
+			return false;
+		}
+
+		int32_t totalCount = literalCount + distanceCount;
+		int32_t index = 0;
+		while (index < totalCount) {
+			int32_t symbol = DecodeSymbol(_literalCode);
+			if (symbol < 0) {
+				return false;
+			}
+			if (symbol < 16) {
+				lengths[index++] = (uint8_t)symbol;
+				continue;
+			}
+
+			uint8_t length = 0;
+			int32_t repeat;
+			if (symbol == 16) {
+				if (index == 0) {
+					return false;
+				}
+				length = lengths[index - 1];
+				repeat = ReadBits(2);
+				repeat = (repeat >= 0 ? repeat + 3 : -1);
+			} else if (symbol == 17) {
+				repeat = ReadBits(3);
+				repeat = (repeat >= 0 ? repeat + 3 : -1);
+			} else {
+				repeat = ReadBits(7);
+				repeat = (repeat >= 0 ? repeat + 11 : -1);
+			}
+			if (repeat < 0 || index + repeat > totalCount) {
+				return false;
+			}
+			std::memset(lengths + index, length, repeat);
+			index += repeat;
+		}
+
+		// End-of-block code is required
+		return (lengths[256] != 0 && BuildHuffmanCode(_literalCode, lengths, literalCount) &&
+				BuildHuffmanCode(_distanceCode, lengths + literalCount, distanceCount));
+	}
+
+	void InflateStream::PutByte(uint8_t value, uint8_t* destBuffer, int32_t& bytesWritten)
+	{
+		destBuffer[bytesWritten++] = value;
+		_window[_windowOffset] = value;
+		_windowOffset = (_windowOffset + 1) & (WindowSize - 1);
+		if (_windowFilled < WindowSize) {
+			_windowFilled++;
+		}
+	}
+
+	bool InflateStream::BuildHuffmanCode(HuffmanCode& code, const uint8_t* lengths, int32_t count)
+	{
+		std::memset(code.Counts, 0, sizeof(code.Counts));
+		for (int32_t i = 0; i < count; i++) {
+			code.Counts[lengths[i]]++;
+		}
+		code.Counts[0] = 0;
+
+		// Over-subscribed set of lengths is invalid, incomplete one is allowed (e.g. a single distance code)
+		int32_t left = 1;
+		for (int32_t length = 1; length < 16; length++) {
+			left <<= 1;
+			left -= code.Counts[length];
+			if (left < 0) {
+				return false;
+			}
+		}
+
+		int16_t offsets[16];
+		offsets[1] = 0;
+		for (int32_t length = 1; length < 15; length++) {
+			offsets[length + 1] = offsets[length] + code.Counts[length];
+		}
+		for (int32_t i = 0; i < count; i++) {
+			if (lengths[i] != 0) {
+				code.Symbols[offsets[lengths[i]]++] = (int16_t)i;
+			}
+		}
+		return true;
+	}
+#endif
+
 #if !defined(WITH_ZLIB)
 	CompressionUtils::LibdeflateStaticDecompressor::LibdeflateStaticDecompressor()
 	{
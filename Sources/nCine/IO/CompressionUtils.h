@@ -2,6 +2,8 @@
 
 #include "../../Common.h"
 
+#include <memory>
+
 #if defined(WITH_ZLIB)
 #	include <zlib.h>
 #else
@@ -50,6 +52,73 @@ namespace nCine
 		};
 
 		static DEATH_THREAD_LOCAL LibdeflateStaticDecompressor _staticDecompressor;
+#endif
+	};
+
+	/// Decompresses raw deflate stream incrementally
+	/*! If the library doesn't support streaming (libdeflate), a built-in decoder is used, so only a 32 KB window is kept in memory */
+	class InflateStream
+	{
+	public:
+		InflateStream();
+		~InflateStream();
+
+		/// Prepares decompression of specified buffer, it must stay valid until the stream is closed
+		bool Open(const uint8_t* compressedBuffer, int32_t compressedSize);
+		void Close();
+
+		/// Decompresses up to specified number of bytes, returns number of bytes actually decompressed
+		int32_t Read(uint8_t* destBuffer, int32_t bytes);
+
+	private:
+		/// Deleted copy constructor
+		InflateStream(const InflateStream&) = delete;
+		/// Deleted assignment operator
+		InflateStream& operator=(const InflateStream&) = delete;
+
+#if defined(WITH_ZLIB)
+		z_stream _strm;
+		int32_t _state;
+#else
+		enum class State : uint8_t {
+			Closed,
+			BlockHeader,
+			StoredBlock,
+			HuffmanBlock,
+			Finished
+		};
+
+		/// Canonical Huffman code, number of codes of each length and symbols ordered by their codes
+		struct HuffmanCode {
+			int16_t Counts[16];
+			int16_t Symbols[288];
+		};
+
+		static constexpr int32_t WindowSize = 32768;
+
+		const uint8_t* _input;
+		int32_t _inputSize;
+		int32_t _inputOffset;
+		uint32_t _bitBuffer;
+		int32_t _bitCount;
+		std::unique_ptr<uint8_t[]> _window;
+		int32_t _windowOffset;
+		int32_t _windowFilled;
+		State _state;
+		bool _lastBlock;
+		int32_t _storedLeft;
+		int32_t _matchLength;
+		int32_t _matchDistance;
+		HuffmanCode _literalCode;
+		HuffmanCode _distanceCode;
+
+		int32_t ReadBits(int32_t count);
+		int32_t DecodeSymbol(const HuffmanCode& code);
+		bool ReadBlockHeader();
+		bool ReadDynamicCodes();
+		void PutByte(uint8_t value, uint8_t* destBuffer, int32_t& bytesWritten);
+
+		static bool BuildHuffmanCode(HuffmanCode& code, const uint8_t* lengths, int32_t count);
 #endif
 	};
 }
\ No newline at end of file
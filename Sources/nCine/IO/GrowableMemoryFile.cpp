@@ -7,13 +7,21 @@ namespace nCine
 	GrowableMemoryFile::GrowableMemoryFile()
 		: IFileStream(nullptr), _seekOffset(0)
 	{
+		type_ = FileType::Memory;
+
+		// The memory file appears to be already opened when first created
+		fileDescriptor_ = 0;
 	}
 
 	GrowableMemoryFile::GrowableMemoryFile(int32_t initialCapacity)
 		: IFileStream(nullptr), _seekOffset(0)
 	{
 		ASSERT(initialCapacity > 0);
+		type_ = FileType::Memory;
 		_buffer.reserve(initialCapacity);
+
+		// The memory file appears to be already opened when first created
+		fileDescriptor_ = 0;
 	}
 
 	void GrowableMemoryFile::Open(FileAccessMode mode)
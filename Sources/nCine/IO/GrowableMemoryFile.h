@@ -23,7 +23,7 @@ namespace nCine
 		uint32_t Write(const void* buffer, uint32_t bytes) override;
 
 		const uint8_t* GetBuffer() {
-			return &_buffer[0];
+			return _buffer.data();
 		}
 
 	private:
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "SimdMath.h"
 #include "Vector3.h"
 #include "Vector4.h"
 #include "../CommonConstants.h"
@@ -711,6 +712,40 @@ namespace nCine
 		return frustum(xMin, xMax, yMin, yMax, near, far);
 	}
 
+	// Specializations for floats use vector instructions of the target, if available
+
+	template <>
+	inline Vector4<float> Matrix4x4<float>::operator*(const Vector4<float>& v) const
+	{
+		Vector4<float> result;
+		SimdMath::MultiplyMatrixVector(Death::Cpu::DefaultBase, Data(), v.Data(), result.Data());
+		return result;
+	}
+
+	template <>
+	inline Vector4<float> operator*(const Vector4<float>& v, const Matrix4x4<float>& m)
+	{
+		Vector4<float> result;
+		SimdMath::MultiplyVectorMatrix(Death::Cpu::DefaultBase, v.Data(), m.Data(), result.Data());
+		return result;
+	}
+
+	template <>
+	inline Matrix4x4<float> Matrix4x4<float>::operator*(const Matrix4x4<float>& m2) const
+	{
+		Matrix4x4<float> result;
+		SimdMath::MultiplyMatrices(Death::Cpu::DefaultBase, Data(), m2.Data(), result.Data());
+		return result;
+	}
+
+	template <>
+	inline Matrix4x4<float> Matrix4x4<float>::Transposed() const
+	{
+		Matrix4x4<float> result;
+		SimdMath::Transpose(Death::Cpu::DefaultBase, Data(), result.Data());
+		return result;
+	}
+
 	template <class T>
 	const Matrix4x4<T> Matrix4x4<T>::Zero(Vector4<T>(0, 0, 0, 0), Vector4<T>(0, 0, 0, 0), Vector4<T>(0, 0, 0, 0), Vector4<T>(0, 0, 0, 0));
 	template <class T>
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <Cpu.h>
+
+#if defined(DEATH_TARGET_SSE2)
+#	include <IntrinsicsSse2.h>
+#endif
+#if defined(DEATH_TARGET_NEON)
+#	include <arm_neon.h>
+#endif
+
+namespace nCine::SimdMath
+{
+	/*! Kernels for the most frequent operations of `Matrix4x4f`, matrices are stored as four consecutive vectors of four floats.
+		The best implementation is selected at compile-time by passing `Cpu::DefaultBase`, the scalar one is the reference.
+		All implementations perform additions in the same order, so results don't depend on the selected instruction set.
+		The result must not alias any of the inputs. */
+
+	/// Computes `a * b` as defined by `Matrix4x4::operator*()`
+	inline void MultiplyMatrices(Death::Cpu::ScalarT, const float* a, const float* b, float* result)
+	{
+		for (unsigned int i = 0; i < 4; i++) {
+			const float* bi = b + i * 4;
+			for (unsigned int j = 0; j < 4; j++) {
+				result[i * 4 + j] = a[j] * bi[0] + a[4 + j] * bi[1] + a[8 + j] * bi[2] + a[12 + j] * bi[3];
+			}
+		}
+	}
+
+	/// Computes `m * v`, the vector is multiplied by rows of the matrix
+	inline void MultiplyMatrixVector(Death::Cpu::ScalarT, const float* m, const float* v, float* result)
+	{
+		for (unsigned int i = 0; i < 4; i++) {
+			const float* mi = m + i * 4;
+			result[i] = mi[0] * v[0] + mi[1] * v[1] + mi[2] * v[2] + mi[3] * v[3];
+		}
+	}
+
+	/// Computes `v * m`, the result is a linear combination of rows of the matrix
+	inline void MultiplyVectorMatrix(Death::Cpu::ScalarT, const float* v, const float* m, float* result)
+	{
+		for (unsigned int j = 0; j < 4; j++) {
+			result[j] = m[j] * v[0] + m[4 + j] * v[1] + m[8 + j] * v[2] + m[12 + j] * v[3];
+		}
+	}
+
+	inline void Transpose(Death::Cpu::ScalarT, const float* m, float* result)
+	{
+		for (unsigned int i = 0; i < 4; i++) {
+			for (unsigned int j = 0; j < 4; j++) {
+				result[j * 4 + i] = m[i * 4 + j];
+			}
+		}
+	}
+
+#if defined(DEATH_TARGET_SSE2)
+	namespace Implementation
+	{
+		DEATH_ALWAYS_INLINE __m128 LinearCombination(__m128 v, __m128 r0, __m128 r1, __m128 r2, __m128 r3)
+		{
+			__m128 result = _mm_mul_ps(r0, _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)));
+			result = _mm_add_ps(result, _mm_mul_ps(r1, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1))));
+			result = _mm_add_ps(result, _mm_mul_ps(r2, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2))));
+			result = _mm_add_ps(result, _mm_mul_ps(r3, _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3))));
+			return result;
+		}
+	}
+
+	inline void MultiplyMatrices(Death::Cpu::Sse2T, const float* a, const float* b, float* result)
+	{
+		const __m128 a0 = _mm_loadu_ps(a);
+		const __m128 a1 = _mm_loadu_ps(a + 4);
+		const __m128 a2 = _mm_loadu_ps(a + 8);
+		const __m128 a3 = _mm_loadu_ps(a + 12);
+
+		const __m128 b0 = _mm_loadu_ps(b);
+		const __m128 b1 = _mm_loadu_ps(b + 4);
+		const __m128 b2 = _mm_loadu_ps(b + 8);
+		const __m128 b3 = _mm_loadu_ps(b + 12);
+
+		_mm_storeu_ps(result, Implementation::LinearCombination(b0, a0, a1, a2, a3));
+		_mm_storeu_ps(result + 4, Implementation::LinearCombination(b1, a0, a1, a2, a3));
+		_mm_storeu_ps(result + 8, Implementation::LinearCombination(b2, a0, a1, a2, a3));
+		_mm_storeu_ps(result + 12, Implementation::LinearCombination(b3, a0, a1, a2, a3));
+	}
+
+	inline void MultiplyMatrixVector(Death::Cpu::Sse2T, const float* m, const float* v, float* result)
+	{
+		__m128 c0 = _mm_loadu_ps(m);
+		__m128 c1 = _mm_loadu_ps(m + 4);
+		__m128 c2 = _mm_loadu_ps(m + 8);
+		__m128 c3 = _mm_loadu_ps(m + 12);
+		_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+		_mm_storeu_ps(result, Implementation::LinearCombination(_mm_loadu_ps(v), c0, c1, c2, c3));
+	}
+
+	inline void MultiplyVectorMatrix(Death::Cpu::Sse2T, const float* v, const float* m, float* result)
+	{
+		_mm_storeu_ps(result, Implementation::LinearCombination(_mm_loadu_ps(v),
+			_mm_loadu_ps(m), _mm_loadu_ps(m + 4), _mm_loadu_ps(m + 8), _mm_loadu_ps(m + 12)));
+	}
+
+	inline void Transpose(Death::Cpu::Sse2T, const float* m, float* result)
+	{
+		__m128 r0 = _mm_loadu_ps(m);
+		__m128 r1 = _mm_loadu_ps(m + 4);
+		__m128 r2 = _mm_loadu_ps(m + 8);
+		__m128 r3 = _mm_loadu_ps(m + 12);
+		_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+		_mm_storeu_ps(result, r0);
+		_mm_storeu_ps(result + 4, r1);
+		_mm_storeu_ps(result + 8, r2);
+		_mm_storeu_ps(result + 12, r3);
+	}
+#endif
+
+#if defined(DEATH_TARGET_NEON)
+	namespace Implementation
+	{
+		// Separate multiplication and addition is used instead of `vmlaq_f32()`, which can be fused on some targets
+		DEATH_ALWAYS_INLINE float32x4_t LinearCombination(float32x4_t v, float32x4_t r0, float32x4_t r1, float32x4_t r2, float32x4_t r3)
+		{
+			float32x4_t result = vmulq_n_f32(r0, vgetq_lane_f32(v, 0));
+			result = vaddq_f32(result, vmulq_n_f32(r1, vgetq_lane_f32(v, 1)));
+			result = vaddq_f32(result, vmulq_n_f32(r2, vgetq_lane_f32(v, 2)));
+			result = vaddq_f32(result, vmulq_n_f32(r3, vgetq_lane_f32(v, 3)));
+			return result;
+		}
+	}
+
+	inline void MultiplyMatrices(Death::Cpu::NeonT, const float* a, const float* b, float* result)
+	{
+		const float32x4_t a0 = vld1q_f32(a);
+		const float32x4_t a1 = vld1q_f32(a + 4);
+		const float32x4_t a2 = vld1q_f32(a + 8);
+		const float32x4_t a3 = vld1q_f32(a + 12);
+
+		const float32x4_t b0 = vld1q_f32(b);
+		const float32x4_t b1 = vld1q_f32(b + 4);
+		const float32x4_t b2 = vld1q_f32(b + 8);
+		const float32x4_t b3 = vld1q_f32(b + 12);
+
+		vst1q_f32(result, Implementation::LinearCombination(b0, a0, a1, a2, a3));
+		vst1q_f32(result + 4, Implementation::LinearCombination(b1, a0, a1, a2, a3));
+		vst1q_f32(result + 8, Implementation::LinearCombination(b2, a0, a1, a2, a3));
+		vst1q_f32(result + 12, Implementation::LinearCombination(b3, a0, a1, a2, a3));
+	}
+
+	inline void MultiplyMatrixVector(Death::Cpu::NeonT, const float* m, const float* v, float* result)
+	{
+		// De-interleaving load returns columns of the matrix
+		const float32x4x4_t c = vld4q_f32(m);
+		vst1q_f32(result, Implementation::LinearCombination(vld1q_f32(v), c.val[0], c.val[1], c.val[2], c.val[3]));
+	}
+
+	inline void MultiplyVectorMatrix(Death::Cpu::NeonT, const float* v, const float* m, float* result)
+	{
+		vst1q_f32(result, Implementation::LinearCombination(vld1q_f32(v),
+			vld1q_f32(m), vld1q_f32(m + 4), vld1q_f32(m + 8), vld1q_f32(m + 12)));
+	}
+
+	inline void Transpose(Death::Cpu::NeonT, const float* m, float* result)
+	{
+		const float32x4x4_t c = vld4q_f32(m);
+		vst1q_f32(result, c.val[0]);
+		vst1q_f32(result + 4, c.val[1]);
+		vst1q_f32(result + 8, c.val[2]);
+		vst1q_f32(result + 12, c.val[3]);
+	}
+#endif
+}
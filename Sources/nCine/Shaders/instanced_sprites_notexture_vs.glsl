@@ -0,0 +1,22 @@
+uniform mat4 uProjectionMatrix;
+uniform mat4 uViewMatrix;
+
+// Per-instance attributes with the same layout as the `InstanceBlock` of sprites with no texture
+in vec4 aModelMatrix0;
+in vec4 aModelMatrix1;
+in vec4 aModelMatrix2;
+in vec4 aModelMatrix3;
+in vec4 aColor;
+in vec2 aSpriteSize;
+
+out vec4 vColor;
+
+void main()
+{
+	mat4 modelMatrix = mat4(aModelMatrix0, aModelMatrix1, aModelMatrix2, aModelMatrix3);
+	vec2 aPosition = vec2(0.5 - float(gl_VertexID >> 1), 0.5 - float(gl_VertexID % 2));
+	vec4 position = vec4(aPosition.x * aSpriteSize.x, aPosition.y * aSpriteSize.y, 0.0, 1.0);
+
+	gl_Position = uProjectionMatrix * uViewMatrix * modelMatrix * position;
+	vColor = aColor;
+}
@@ -18,6 +18,8 @@
 
 #if defined(WITH_TRACY)
 #	include "common/TracySystem.hpp"
+#elif defined(WITH_TRACE_EXPORT)
+#	include "../Base/TraceExporter.h"
 #endif
 
 namespace nCine
@@ -142,6 +144,9 @@ namespace nCine
 #if defined(WITH_TRACY)
 		tracy::SetThreadName(name);
 #else
+#	if defined(WITH_TRACE_EXPORT)
+		TraceExporter::setThreadName(name);
+#	endif
 		const auto nameLength = strnlen(name, MaxThreadNameLength);
 		if (nameLength <= MaxThreadNameLength - 1) {
 #if !defined(DEATH_TARGET_APPLE)
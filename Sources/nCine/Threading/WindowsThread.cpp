@@ -6,6 +6,10 @@
 
 #include "../../Common.h"
 
+#if defined(WITH_TRACE_EXPORT)
+#	include "../Base/TraceExporter.h"
+#endif
+
 #include <utility>
 
 namespace nCine
@@ -125,6 +129,9 @@ namespace nCine
 #if defined(WITH_TRACY)
 		tracy::SetThreadName(name);
 #else
+#	if defined(WITH_TRACE_EXPORT)
+		TraceExporter::setThreadName(name);
+#	endif
 		SetThreadName(reinterpret_cast<HANDLE>(-1), name);
 #endif
 	}
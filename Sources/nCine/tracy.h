@@ -5,6 +5,10 @@
 
 #else
 
+#ifdef WITH_TRACE_EXPORT
+	#include "Base/TraceExporter.h"
+#endif
+
 	// From Tracy.hpp
 	#define ZoneNamed(x, y)
 	#define ZoneNamedN(x, y, z)
@@ -14,10 +18,18 @@
 	#define ZoneTransient(x, y)
 	#define ZoneTransientN(x, y, z)
 
+#ifdef WITH_TRACE_EXPORT
+	// Zones and plots are recorded by the built-in trace exporter instead
+	#define ZoneScoped nCine::TraceZone ___tracy_scoped_zone(__func__)
+	#define ZoneScopedN(x) nCine::TraceZone ___tracy_scoped_zone(x)
+	#define ZoneScopedC(x) nCine::TraceZone ___tracy_scoped_zone(__func__)
+	#define ZoneScopedNC(x, y) nCine::TraceZone ___tracy_scoped_zone(x)
+#else
 	#define ZoneScoped
 	#define ZoneScopedN(x)
 	#define ZoneScopedC(x)
 	#define ZoneScopedNC(x, y)
+#endif
 
 	#define ZoneText(x, y)
 	#define ZoneTextV(x, y, z)
@@ -46,7 +58,11 @@
 	#define LockMark(x) (void)x;
 	#define LockableName(x, y, z);
 
+#ifdef WITH_TRACE_EXPORT
+	#define TracyPlot(x, y) nCine::TraceExporter::counter(x, static_cast<double>(y))
+#else
 	#define TracyPlot(x, y)
+#endif
 	#define TracyPlotConfig(x, y)
 
 	#define TracyMessage(x, y)
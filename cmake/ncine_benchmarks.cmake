@@ -0,0 +1,141 @@
+if(NCINE_BUILD_BENCHMARKS AND NOT NCINE_BUILD_ANDROID AND NOT EMSCRIPTEN AND NOT WINDOWS_PHONE AND NOT WINDOWS_STORE)
+	# Standalone executable, it includes only sources of the measured primitives, so it doesn't need any backend
+	set(NCINE_BENCHMARKS "${NCINE_APP}_benchmarks")
+	message(STATUS "Building microbenchmarks: ${NCINE_BENCHMARKS}")
+
+	add_executable(${NCINE_BENCHMARKS}
+		${NCINE_SOURCE_DIR}/Benchmarks/BenchmarkHarness.h
+		${NCINE_SOURCE_DIR}/Benchmarks/BenchmarkHarness.cpp
+		${NCINE_SOURCE_DIR}/Benchmarks/AtlasBenchmarks.cpp
+		${NCINE_SOURCE_DIR}/Benchmarks/AtomBenchmarks.cpp
+		${NCINE_SOURCE_DIR}/Benchmarks/CacheBenchmarks.cpp
+		${NCINE_SOURCE_DIR}/Benchmarks/ContainerBenchmarks.cpp
+		${NCINE_SOURCE_DIR}/Benchmarks/ConverterBenchmarks.cpp
+		${NCINE_SOURCE_DIR}/Benchmarks/DynamicTreeBenchmarks.cpp
+		${NCINE_SOURCE_DIR}/Benchmarks/HashMapBenchmarks.cpp
+		${NCINE_SOURCE_DIR}/Benchmarks/HudBenchmarks.cpp
+		${NCINE_SOURCE_DIR}/Benchmarks/I18nBenchmarks.cpp
+		${NCINE_SOURCE_DIR}/Benchmarks/IOBenchmarks.cpp
+		${NCINE_SOURCE_DIR}/Benchmarks/KernelBenchmarks.cpp
+		${NCINE_SOURCE_DIR}/Benchmarks/Main.cpp
+		${NCINE_SOURCE_DIR}/Benchmarks/MatrixBenchmarks.cpp
+		${NCINE_SOURCE_DIR}/Benchmarks/ScratchBenchmarks.cpp
+		${NCINE_SOURCE_DIR}/Benchmarks/TileSetBenchmarks.cpp
+
+		${NCINE_SOURCE_DIR}/Shared/Cpu.cpp
+		${NCINE_SOURCE_DIR}/Shared/Utf8.cpp
+		${NCINE_SOURCE_DIR}/Shared/Containers/SmallVector.cpp
+		${NCINE_SOURCE_DIR}/Shared/Containers/String.cpp
+		${NCINE_SOURCE_DIR}/Shared/Containers/StringView.cpp
+		${NCINE_SOURCE_DIR}/nCine/Base/Algorithms.cpp
+		${NCINE_SOURCE_DIR}/nCine/Base/Atom.cpp
+		${NCINE_SOURCE_DIR}/nCine/Base/BitArray.cpp
+		${NCINE_SOURCE_DIR}/nCine/Base/CpuDispatch.cpp
+		${NCINE_SOURCE_DIR}/nCine/Base/HashFunctions.cpp
+		${NCINE_SOURCE_DIR}/nCine/Base/LinearAllocator.cpp
+		${NCINE_SOURCE_DIR}/nCine/Base/MallocAllocator.cpp
+		${NCINE_SOURCE_DIR}/nCine/Base/ScratchArena.cpp
+		${NCINE_SOURCE_DIR}/nCine/I18n.cpp
+		${NCINE_SOURCE_DIR}/nCine/IO/CompressionUtils.cpp
+		${NCINE_SOURCE_DIR}/nCine/IO/FileSystem.cpp
+		${NCINE_SOURCE_DIR}/nCine/IO/GrowableMemoryFile.cpp
+		${NCINE_SOURCE_DIR}/nCine/IO/IFileStream.cpp
+		${NCINE_SOURCE_DIR}/nCine/IO/MemoryFile.cpp
+		${NCINE_SOURCE_DIR}/nCine/IO/StandardFile.cpp
+		${NCINE_SOURCE_DIR}/Jazz2/Collisions/DynamicTree.cpp
+		${NCINE_SOURCE_DIR}/Jazz2/Compatibility/AnimSetMapping.cpp
+		${NCINE_SOURCE_DIR}/Jazz2/Compatibility/CacheManifest.cpp
+		${NCINE_SOURCE_DIR}/Jazz2/Compatibility/JJ2Anims.cpp
+		${NCINE_SOURCE_DIR}/Jazz2/Compatibility/JJ2Block.cpp)
+
+	target_compile_features(${NCINE_BENCHMARKS} PRIVATE cxx_std_20)
+	set_target_properties(${NCINE_BENCHMARKS} PROPERTIES CXX_EXTENSIONS OFF)
+	target_include_directories(${NCINE_BENCHMARKS} PRIVATE "${NCINE_SOURCE_DIR}/Shared")
+
+	# Logging is not enabled, so messages of the measured code don't affect results
+	target_compile_definitions(${NCINE_BENCHMARKS} PRIVATE "CMAKE_BUILD")
+	if(DEATH_CPU_USE_RUNTIME_DISPATCH)
+		target_compile_definitions(${NCINE_BENCHMARKS} PRIVATE "DEATH_CPU_USE_RUNTIME_DISPATCH")
+	endif()
+	if(DEATH_CPU_USE_IFUNC)
+		target_compile_definitions(${NCINE_BENCHMARKS} PRIVATE "DEATH_CPU_USE_IFUNC")
+	endif()
+
+	# Animation import is split to multiple threads, so the same atomics and threads as in the game are needed
+	if(WIN32 AND NOT MINGW)
+		target_sources(${NCINE_BENCHMARKS} PRIVATE ${NCINE_SOURCE_DIR}/nCine/Threading/WindowsAtomic.cpp)
+	elseif(APPLE)
+		target_sources(${NCINE_BENCHMARKS} PRIVATE ${NCINE_SOURCE_DIR}/nCine/Threading/StdAtomic.cpp)
+	else()
+		if(ATOMIC_FOUND)
+			target_link_libraries(${NCINE_BENCHMARKS} PRIVATE Atomic::Atomic)
+		endif()
+		target_sources(${NCINE_BENCHMARKS} PRIVATE ${NCINE_SOURCE_DIR}/nCine/Threading/GccAtomic.cpp)
+	endif()
+	if(Threads_FOUND)
+		target_compile_definitions(${NCINE_BENCHMARKS} PRIVATE "WITH_THREADS")
+		target_link_libraries(${NCINE_BENCHMARKS} PRIVATE Threads::Threads)
+		if(WIN32)
+			target_sources(${NCINE_BENCHMARKS} PRIVATE
+				${NCINE_SOURCE_DIR}/nCine/Threading/WindowsThread.cpp
+				${NCINE_SOURCE_DIR}/nCine/Threading/WindowsThreadSync.cpp)
+		else()
+			target_sources(${NCINE_BENCHMARKS} PRIVATE
+				${NCINE_SOURCE_DIR}/nCine/Threading/PosixThread.cpp
+				${NCINE_SOURCE_DIR}/nCine/Threading/PosixThreadSync.cpp)
+		endif()
+	endif()
+
+	if(NCINE_WITH_ALLOCATORS)
+		# Tracked allocators report their statistics after all benchmarks
+		target_sources(${NCINE_BENCHMARKS} PRIVATE
+			${NCINE_SOURCE_DIR}/Benchmarks/AllocatorBenchmarks.cpp
+			${NCINE_SOURCE_DIR}/nCine/Base/AllocManager.cpp
+			${NCINE_SOURCE_DIR}/nCine/Base/PoolAllocator.cpp
+			${NCINE_SOURCE_DIR}/nCine/Base/ProxyAllocator.cpp)
+		target_compile_definitions(${NCINE_BENCHMARKS} PRIVATE "WITH_ALLOCATORS")
+	endif()
+
+	if(ANGELSCRIPT_FOUND)
+		# Scripting benchmarks measure compilation and loading of bytecode by AngelScript itself
+		target_sources(${NCINE_BENCHMARKS} PRIVATE
+			${NCINE_SOURCE_DIR}/Benchmarks/ScriptBenchmarks.cpp)
+		target_compile_definitions(${NCINE_BENCHMARKS} PRIVATE "WITH_ANGELSCRIPT")
+		target_link_libraries(${NCINE_BENCHMARKS} PRIVATE AngelScript::AngelScript)
+	endif()
+
+	if(LIBDEFLATE_FOUND)
+		target_compile_definitions(${NCINE_BENCHMARKS} PRIVATE "WITH_LIBDEFLATE")
+		target_link_libraries(${NCINE_BENCHMARKS} PRIVATE libdeflate::libdeflate)
+	elseif(ZLIB_FOUND)
+		target_compile_definitions(${NCINE_BENCHMARKS} PRIVATE "WITH_ZLIB")
+		target_link_libraries(${NCINE_BENCHMARKS} PRIVATE ZLIB::ZLIB)
+	else()
+		message(WARNING "Microbenchmarks require either libdeflate or zlib")
+	endif()
+
+	# Code generation options should match the game, so results are representative
+	if(MSVC)
+		target_compile_options(${NCINE_BENCHMARKS} PRIVATE /MP /utf-8)
+		target_compile_definitions(${NCINE_BENCHMARKS} PRIVATE "_HAS_EXCEPTIONS=0")
+		target_compile_options(${NCINE_BENCHMARKS} PRIVATE /EHsc)
+		target_compile_options(${NCINE_BENCHMARKS} PRIVATE $<$<CONFIG:Release>:/fp:fast /O2 /Oi /Gy>)
+		if(NCINE_ARCH_EXTENSIONS)
+			target_compile_options(${NCINE_BENCHMARKS} PRIVATE /arch:${NCINE_ARCH_EXTENSIONS})
+		endif()
+		target_compile_options(${NCINE_BENCHMARKS} PRIVATE "/wd4244" "/wd4267")
+	else()
+		target_compile_options(${NCINE_BENCHMARKS} PRIVATE -fno-exceptions)
+		target_compile_options(${NCINE_BENCHMARKS} PRIVATE $<$<CONFIG:Release>:-ffast-math>)
+		if("${CMAKE_CXX_COMPILER_ID}" STREQUAL "GNU")
+			target_compile_options(${NCINE_BENCHMARKS} PRIVATE -Wall -Wno-unused-parameter -Wno-multichar -Wno-switch -Wno-unknown-pragmas -Wno-reorder)
+			target_compile_options(${NCINE_BENCHMARKS} PRIVATE $<$<CONFIG:Release>:-Ofast>)
+			target_link_options(${NCINE_BENCHMARKS} PRIVATE -Wno-free-nonheap-object)
+		elseif("${CMAKE_CXX_COMPILER_ID}" MATCHES "Clang")
+			target_compile_options(${NCINE_BENCHMARKS} PRIVATE -Wall -Wno-unused-parameter -Wno-multichar -Wno-switch -Wno-unknown-pragmas -Wno-reorder-ctor -Wno-braced-scalar-init)
+			target_compile_options(${NCINE_BENCHMARKS} PRIVATE $<$<CONFIG:Release>:-O3>)
+		endif()
+	endif()
+
+	set_target_properties(${NCINE_BENCHMARKS} PROPERTIES FOLDER "Benchmarks")
+endif()
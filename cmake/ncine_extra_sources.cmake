@@ -328,31 +328,9 @@ endif()
 #	endif()
 #endif()
 
-#if(NCINE_WITH_ALLOCATORS)
-#	target_compile_definitions(${NCINE_APP} PRIVATE "WITH_ALLOCATORS")
-#
-#	list(APPEND HEADERS
-#		${NCINE_ROOT}/include/nctl/AllocManager.h
-#		${NCINE_ROOT}/include/nctl/IAllocator.h
-#		${NCINE_ROOT}/include/nctl/MallocAllocator.h
-#		${NCINE_ROOT}/include/nctl/LinearAllocator.h
-#		${NCINE_ROOT}/include/nctl/StackAllocator.h
-#		${NCINE_ROOT}/include/nctl/PoolAllocator.h
-#		${NCINE_ROOT}/include/nctl/FreeListAllocator.h
-#		${NCINE_ROOT}/include/nctl/ProxyAllocator.h
-#	)
-#
-#	list(APPEND SOURCES
-#		${NCINE_ROOT}/src/base/AllocManager.cpp
-#		${NCINE_ROOT}/src/base/IAllocator.cpp
-#		${NCINE_ROOT}/src/base/MallocAllocator.cpp
-#		${NCINE_ROOT}/src/base/LinearAllocator.cpp
-#		${NCINE_ROOT}/src/base/StackAllocator.cpp
-#		${NCINE_ROOT}/src/base/PoolAllocator.cpp
-#		${NCINE_ROOT}/src/base/FreeListAllocator.cpp
-#		${NCINE_ROOT}/src/base/ProxyAllocator.cpp
-#	)
-#endif()
+if(NCINE_WITH_ALLOCATORS)
+	target_compile_definitions(${NCINE_APP} PRIVATE "WITH_ALLOCATORS")
+endif()
 
 #if(NCINE_WITH_IMGUI)
 #	target_compile_definitions(${NCINE_APP} PRIVATE "WITH_IMGUI")
@@ -477,6 +455,9 @@ if(NCINE_WITH_TRACY)
 		${NCINE_SOURCE_DIR}/nCine/tracy_memory.cpp
 		${TRACY_SOURCE_DIR}/public/TracyClient.cpp
 	)
+elseif(NCINE_WITH_TRACE_EXPORT)
+	# Built-in tracer reuses Tracy zone macros, so it cannot be enabled together with Tracy
+	target_compile_definitions(${NCINE_APP} PRIVATE "WITH_TRACE_EXPORT")
 endif()
 
 #if(NCINE_WITH_RENDERDOC AND NOT APPLE)
@@ -37,18 +37,31 @@ list(APPEND HEADERS
 	${NCINE_SOURCE_DIR}/nCine/Audio/IAudioPlayer.h
 	${NCINE_SOURCE_DIR}/nCine/Audio/IAudioReader.h
 	${NCINE_SOURCE_DIR}/nCine/Base/Algorithms.h
+	${NCINE_SOURCE_DIR}/nCine/Base/AllocManager.h
+	${NCINE_SOURCE_DIR}/nCine/Base/Atom.h
 	${NCINE_SOURCE_DIR}/nCine/Base/BitArray.h
 	${NCINE_SOURCE_DIR}/nCine/Base/BitSet.h
 	${NCINE_SOURCE_DIR}/nCine/Base/Clock.h
+	${NCINE_SOURCE_DIR}/nCine/Base/CpuDispatch.h
 	${NCINE_SOURCE_DIR}/nCine/Base/FrameTimer.h
+	${NCINE_SOURCE_DIR}/nCine/Base/FrameProfiler.h
+	${NCINE_SOURCE_DIR}/nCine/Base/FunctionRef.h
+	${NCINE_SOURCE_DIR}/nCine/Base/TraceExporter.h
 	${NCINE_SOURCE_DIR}/nCine/Base/HashFunctions.h
 	${NCINE_SOURCE_DIR}/nCine/Base/HashMap.h
+	${NCINE_SOURCE_DIR}/nCine/Base/IAllocator.h
 	${NCINE_SOURCE_DIR}/nCine/Base/Iterator.h
+	${NCINE_SOURCE_DIR}/nCine/Base/LinearAllocator.h
+	${NCINE_SOURCE_DIR}/nCine/Base/MallocAllocator.h
 	${NCINE_SOURCE_DIR}/nCine/Base/Object.h
+	${NCINE_SOURCE_DIR}/nCine/Base/PoolAllocator.h
+	${NCINE_SOURCE_DIR}/nCine/Base/ProxyAllocator.h
 	${NCINE_SOURCE_DIR}/nCine/Base/Random.h
+	${NCINE_SOURCE_DIR}/nCine/Base/ScratchArena.h
 	${NCINE_SOURCE_DIR}/nCine/Base/ReverseIterator.h
 	${NCINE_SOURCE_DIR}/nCine/Base/StaticHashMap.h
 	${NCINE_SOURCE_DIR}/nCine/Base/StaticHashMapIterator.h
+	${NCINE_SOURCE_DIR}/nCine/Base/StlAllocator.h
 	${NCINE_SOURCE_DIR}/nCine/Base/Task.h
 	${NCINE_SOURCE_DIR}/nCine/Base/Timer.h
 	${NCINE_SOURCE_DIR}/nCine/Base/TimeStamp.h
@@ -135,6 +148,7 @@ list(APPEND HEADERS
 	${NCINE_SOURCE_DIR}/nCine/Primitives/Matrix4x4.h
 	${NCINE_SOURCE_DIR}/nCine/Primitives/Quaternion.h
 	${NCINE_SOURCE_DIR}/nCine/Primitives/Rect.h
+	${NCINE_SOURCE_DIR}/nCine/Primitives/SimdMath.h
 	${NCINE_SOURCE_DIR}/nCine/Primitives/Vector2.h
 	${NCINE_SOURCE_DIR}/nCine/Primitives/Vector3.h
 	${NCINE_SOURCE_DIR}/nCine/Primitives/Vector4.h
@@ -278,6 +292,7 @@ list(APPEND HEADERS
 	${NCINE_SOURCE_DIR}/Jazz2/Collisions/DynamicTree.h
 	${NCINE_SOURCE_DIR}/Jazz2/Collisions/DynamicTreeBroadPhase.h
 	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/AnimSetMapping.h
+	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/CacheManifest.h
 	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/EventConverter.h
 	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/JJ2Anims.h
 	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/JJ2Anims.Palettes.h
@@ -298,6 +313,7 @@ list(APPEND HEADERS
 	${NCINE_SOURCE_DIR}/Jazz2/Scripting/ScriptActorWrapper.h
 	${NCINE_SOURCE_DIR}/Jazz2/Scripting/ScriptLoader.h
 	${NCINE_SOURCE_DIR}/Jazz2/Scripting/ScriptPlayerWrapper.h
+	${NCINE_SOURCE_DIR}/Jazz2/Scripting/ScriptProfiler.h
 	${NCINE_SOURCE_DIR}/Jazz2/Tiles/TileMap.h
 	${NCINE_SOURCE_DIR}/Jazz2/Tiles/TileSet.h
 	${NCINE_SOURCE_DIR}/Jazz2/UI/Canvas.h
@@ -306,6 +322,7 @@ list(APPEND HEADERS
 	${NCINE_SOURCE_DIR}/Jazz2/UI/DiscordRpcClient.h
 	${NCINE_SOURCE_DIR}/Jazz2/UI/Font.h
 	${NCINE_SOURCE_DIR}/Jazz2/UI/HUD.h
+	${NCINE_SOURCE_DIR}/Jazz2/UI/ProfilerOverlay.h
 	${NCINE_SOURCE_DIR}/Jazz2/UI/RgbLights.h
 	${NCINE_SOURCE_DIR}/Jazz2/UI/UpscaleRenderPass.h
 	${NCINE_SOURCE_DIR}/Jazz2/UI/Menu/AboutSection.h
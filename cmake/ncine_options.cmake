@@ -14,6 +14,7 @@ option(NCINE_EMBED_SHADERS "Export shader files to C strings to be included in e
 option(NCINE_BUILD_ANDROID "Build Android version of the game" OFF)
 option(NCINE_STRIP_BINARIES "Enable symbols stripping from libraries and executables when in release" OFF)
 option(NCINE_VERSION_FROM_GIT "Try to set current game version from GIT repository" ON)
+option(NCINE_BUILD_BENCHMARKS "Build microbenchmarks of core containers, hashing and I/O primitives" OFF)
 
 set(NCINE_PREFERRED_BACKEND "GLFW" CACHE STRING "Specify preferred backend on desktop")
 #set_property(CACHE NCINE_PREFERRED_BACKEND PROPERTY STRINGS "GLFW;SDL2;QT5")
@@ -62,10 +63,11 @@ option(NCINE_WITH_OPENMPT "Enable module (libopenmpt) audio file support" ON)
 #endif()
 option(NCINE_WITH_ANGELSCRIPT "Enable AngelScript scripting support" OFF)
 
-#option(NCINE_WITH_ALLOCATORS "Enable the custom memory allocators" OFF)
+option(NCINE_WITH_ALLOCATORS "Enable custom memory allocators and per-subsystem allocation tracking" OFF)
 #option(NCINE_WITH_IMGUI "Enable the integration with Dear ImGui" OFF)
 #option(NCINE_WITH_NUKLEAR "Enable the integration with Nuklear" OFF)
 option(NCINE_WITH_TRACY "Enable integration with Tracy frame profiler" OFF)
+option(NCINE_WITH_TRACE_EXPORT "Enable built-in tracer with export to Chrome trace event format" OFF)
 option(NCINE_WITH_RENDERDOC "Enable integration with RenderDoc" OFF)
 
 set(NCINE_DATA_DIR "${CMAKE_SOURCE_DIR}/Content" CACHE PATH "Set path to the game data directory")
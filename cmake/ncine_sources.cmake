@@ -14,12 +14,22 @@ list(APPEND SOURCES
 	${NCINE_SOURCE_DIR}/nCine/I18n.cpp
 	${NCINE_SOURCE_DIR}/nCine/ServiceLocator.cpp
 	${NCINE_SOURCE_DIR}/nCine/Base/Algorithms.cpp
+	${NCINE_SOURCE_DIR}/nCine/Base/AllocManager.cpp
+	${NCINE_SOURCE_DIR}/nCine/Base/Atom.cpp
 	${NCINE_SOURCE_DIR}/nCine/Base/BitArray.cpp
 	${NCINE_SOURCE_DIR}/nCine/Base/Clock.cpp
+	${NCINE_SOURCE_DIR}/nCine/Base/CpuDispatch.cpp
 	${NCINE_SOURCE_DIR}/nCine/Base/FrameTimer.cpp
+	${NCINE_SOURCE_DIR}/nCine/Base/FrameProfiler.cpp
+	${NCINE_SOURCE_DIR}/nCine/Base/TraceExporter.cpp
 	${NCINE_SOURCE_DIR}/nCine/Base/HashFunctions.cpp
+	${NCINE_SOURCE_DIR}/nCine/Base/LinearAllocator.cpp
+	${NCINE_SOURCE_DIR}/nCine/Base/MallocAllocator.cpp
 	${NCINE_SOURCE_DIR}/nCine/Base/Object.cpp
+	${NCINE_SOURCE_DIR}/nCine/Base/PoolAllocator.cpp
+	${NCINE_SOURCE_DIR}/nCine/Base/ProxyAllocator.cpp
 	${NCINE_SOURCE_DIR}/nCine/Base/Random.cpp
+	${NCINE_SOURCE_DIR}/nCine/Base/ScratchArena.cpp
 	${NCINE_SOURCE_DIR}/nCine/Base/Timer.cpp
 	${NCINE_SOURCE_DIR}/nCine/Base/TimeStamp.cpp
 	${NCINE_SOURCE_DIR}/nCine/Graphics/AnimatedSprite.cpp
@@ -213,6 +223,7 @@ list(APPEND SOURCES
 	${NCINE_SOURCE_DIR}/Jazz2/Collisions/DynamicTree.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Collisions/DynamicTreeBroadPhase.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/AnimSetMapping.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/CacheManifest.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/EventConverter.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/JJ2Anims.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/JJ2Block.cpp
@@ -229,6 +240,7 @@ list(APPEND SOURCES
 	${NCINE_SOURCE_DIR}/Jazz2/Scripting/ScriptActorWrapper.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Scripting/ScriptLoader.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Scripting/ScriptPlayerWrapper.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/Scripting/ScriptProfiler.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Tiles/TileMap.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Tiles/TileSet.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/UI/Canvas.cpp
@@ -237,6 +249,7 @@ list(APPEND SOURCES
 	${NCINE_SOURCE_DIR}/Jazz2/UI/DiscordRpcClient.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/UI/Font.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/UI/HUD.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/UI/ProfilerOverlay.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/UI/RgbLights.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/UI/UpscaleRenderPass.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/UI/Menu/AboutSection.cpp